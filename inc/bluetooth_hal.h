@@ -8,6 +8,8 @@
  * PUBLIC FUNCTIONS:
  *      void        BT_HAL_init()
  *      void        BT_HAL_sendMessage(const char* format, ...)
+ *      bool        BT_HAL_canSend()
+ *      uint16_t    BT_HAL_getDroppedMessages()
  *      void        BT_HAL_registerMessageCallback(BTCallback callback)
  *
  * NOTES:
@@ -20,11 +22,14 @@
  * DATE         AUTHOR          DETAIL
  * 04 Feb 2024  Andrea Piccin   Refactoring
  * 09 Feb 2024  Andrea Piccin   Introduced callback mechanism
+ * 18 Oct 2026  Maintainers     Added canSend()
+ * 18 Oct 2026  Maintainers     Added the count of the dropped messages
  */
 
 #ifndef BLUETOOTH_HAL_H
 #define BLUETOOTH_HAL_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -87,6 +92,57 @@ void BT_HAL_init();
  */
 void BT_HAL_sendMessage(const char *format, ...);
 
+/*F************************************************************************************************
+ * NAME: bool BT_HAL_canSend()
+ *
+ * DESCRIPTION:
+ *      Tells whether a new message would be accepted by BT_HAL_sendMessage().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the outgoing ring is full
+ *
+ *  NOTE:
+ */
+bool BT_HAL_canSend();
+
+/*F************************************************************************************************
+ * NAME: uint16_t BT_HAL_getDroppedMessages()
+ *
+ * DESCRIPTION:
+ *      Returns the number of messages dropped by BT_HAL_sendMessage() because the outgoing ring
+ *      was full.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Dropped messages since the init, it stops at UINT16_MAX
+ *
+ *  NOTE:
+ */
+uint16_t BT_HAL_getDroppedMessages();
+
 /*F************************************************************************************************
  * NAME:  void BT_HAL_registerMessageCallback(BTCallback callback)
  *
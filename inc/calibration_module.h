@@ -0,0 +1,222 @@
+/*H************************************************************************************************
+ * FILENAME:        calibration_module.h
+ *
+ * DESCRIPTION:
+ *      This header provides the calibration of the speed curves of the motors: a sweep of the
+ *      duty cycle measures the speed of the car against a wall in front of it, the curves that
+ *      make the speed proportional to the requested one are solved from the measurements and
+ *      stored in flash, then applied at every boot.
+ *      It also provides the calibration of the left/right trim of the straight movements, from
+ *      the drift of the car along a wall at its side.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    Calibration_Module_init()
+ *      void    Calibration_Module_startSweep()
+ *      void    Calibration_Module_startTrim()
+ *      void    Calibration_Module_abort()
+ *      bool    Calibration_Module_isRunning()
+ *      void    Calibration_Module_clear()
+ *
+ * NOTES:
+ *      The record is kept in sector CALIBRATION_FLASH_START of bank 1, dumped with openocd
+ *      "dump_image cal.bin 0x3A000 0x1000". The test build keeps it in RAM, where it survives
+ *      the reinitialisation of the modules.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Added the left/right trim
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef TEST
+#include "../tests/motor_hal.h"
+#else
+#include "motor_hal.h"
+#endif
+
+#ifndef CALIBRATION_MODULE_H
+#define CALIBRATION_MODULE_H
+
+#define CALIBRATION_MAGIC 0xCA11B0A8     /* First word of a valid record                       */
+#define CALIBRATION_FLASH_START 0x3A000  /* Record (bank 1, sector 26), before the crash log   */
+#define CALIBRATION_FLASH_SIZE 0x1000    /* One sector                                         */
+#define CALIBRATION_CURVES 0x1           /* Flag of a record with the speed curves             */
+#define CALIBRATION_TRIM 0x2             /* Flag of a record with the trim                     */
+
+/*T************************************************************************************************
+ * NAME: CalibrationRecord
+ *
+ * DESCRIPTION:
+ *      Represent the calibration of the motors, 56 bytes in flash.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t        magic       CALIBRATION_MAGIC if the record is valid
+ *              MotorCurve[]    curves      Speed curves of the left and right motors
+ *              uint16_t        flags       CALIBRATION_CURVES and CALIBRATION_TRIM, if calibrated
+ *              int16_t         trim        Trim of the straight movements (‰)
+ *              uint32_t        checksum    Complement of the sum of the previous words
+ */
+typedef struct {
+    uint32_t magic;
+    MotorCurve curves[2];
+    uint16_t flags;
+    int16_t trim;
+    uint32_t checksum;
+} CalibrationRecord;
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_init()
+ *
+ * DESCRIPTION:
+ *      Loads the stored calibration, if valid, and applies its curves and its trim to the motors.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Must be called after Powertrain_Module_init() and Sensing_Module_init().
+ */
+void Calibration_Module_init();
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_startSweep()
+ *
+ * DESCRIPTION:
+ *      Starts the calibration sweep: at every duty cycle from 10% to 100% the car runs forward
+ *      and back for a fixed time, the distance of the wall in front is measured before and after
+ *      each run. At the end the curves are solved, applied and stored. The progress and the
+ *      result are notified via telemetry.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The car needs a wall in front, at least 1m away and in the range of the ultrasonic
+ *      sensor. The sweep takes about 30s and owns the shared timer and the motors while running.
+ */
+void Calibration_Module_startSweep();
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_startTrim()
+ *
+ * DESCRIPTION:
+ *      Starts the calibration of the trim: the car runs forward along the closer of the walls at
+ *      its sides, the servo at 90 degrees samples the lateral distance and the curvature of the
+ *      path is fitted from the samples. The car then runs back to its start. Three passes at
+ *      different trims solve the trim that runs straight, which is applied and stored. The drift
+ *      of each pass and the result are notified via telemetry.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The car needs a wall at one side, closer than 1m, and about 1m of free way in front. The
+ *      calibration takes about 35s and owns the shared timer and the motors while running.
+ */
+void Calibration_Module_startTrim();
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_abort()
+ *
+ * DESCRIPTION:
+ *      Stops a running calibration and the motors, the curves and the trim in use before it are
+ *      restored.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Calibration_Module_abort();
+
+/*F************************************************************************************************
+ * NAME: bool Calibration_Module_isRunning()
+ *
+ * DESCRIPTION:
+ *      Tells whether a sweep or a calibration of the trim is running.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True while a calibration owns the motors
+ *
+ *  NOTE:
+ */
+bool Calibration_Module_isRunning();
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_clear()
+ *
+ * DESCRIPTION:
+ *      Erases the stored calibration, the motors go back to the linear mapping of the speed and
+ *      to no trim.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Calibration_Module_clear();
+
+#endif // CALIBRATION_MODULE_H
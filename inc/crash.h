@@ -0,0 +1,154 @@
+/*H************************************************************************************************
+ * FILENAME:        crash.h
+ *
+ * DESCRIPTION:
+ *      This header provides the capture of the faults and of the fatal errors: the state of the
+ *      car at the crash is saved in RAM that survives the reset, then reported via Bluetooth and
+ *      appended to a log in flash after the reboot.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        CRASH_init()
+ *      void        CRASH_flush()
+ *      void        CRASH_halt(uint32_t code)
+ *
+ * NOTES:
+ *      NMI, HardFault, MemManage, BusFault and UsageFault save a CrashRecord in the .noinit
+ *      section, which the startup code neither loads nor clears, and reset the device. The SRAM
+ *      keeps its content through the reset but not through a power cycle, so CRASH_init() moves
+ *      the record to the flash log at the next boot: sector CRASH_FLASH_START of bank 1, dumped
+ *      with openocd "dump_image crash.bin 0x3B000 0x1000". When the log is full it is erased.
+ *      The report is sent from the main loop as lines starting with CRASH_STREAM_PREFIX.
+ *      A fault raised while the stack pointer is corrupted cannot run the capture: the core locks
+ *      up and only the watchdog or a manual reset recovers it.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef CRASH_H
+#define CRASH_H
+
+#define CRASH_MAGIC 0xC4A5D00D       /* First word of a valid record                        */
+#define CRASH_FRAME_WORDS 8          /* Registers stacked by the exception entry            */
+#define CRASH_STACK_WORDS 16         /* Words of the stack saved above the exception frame  */
+#define CRASH_STREAM_PREFIX '!'      /* First char of a line of the report via Bluetooth    */
+#define CRASH_FLASH_START 0x3B000    /* Flash log (bank 1, sector 27), before the recorder  */
+#define CRASH_FLASH_SIZE 0x1000      /* One sector                                          */
+#define CRASH_HALT 0                 /* Exception of a record saved by CRASH_halt()         */
+
+/*T************************************************************************************************
+ * NAME: CrashRecord
+ *
+ * DESCRIPTION:
+ *      Represent the state of the car at a crash, 140 bytes in RAM and in the flash log.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    magic       CRASH_MAGIC if the record is valid
+ *              uint32_t    exception   Exception number (3 HardFault...), CRASH_HALT if software
+ *              uint32_t    code        Argument of CRASH_halt() or EXC_RETURN of the fault
+ *              uint32_t    tick        Timer32 ticks since the start of the periodic timer
+ *              uint32_t    state       FSM_currentState, the breadcrumb of the application
+ *              uint32_t[]  registers   r0, r1, r2, r3, r12, lr, pc and xpsr of the faulting code
+ *              uint32_t    sp          Stack pointer of the faulting code, above its frame
+ *              uint32_t    cfsr        Configurable Fault Status Register
+ *              uint32_t    hfsr        HardFault Status Register
+ *              uint32_t    mmfar       MemManage Fault Address Register
+ *              uint32_t    bfar        BusFault Address Register
+ *              uint32_t[]  stack       Words from sp, 0 if outside the SRAM
+ *              uint32_t    checksum    Complement of the sum of the previous words
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t exception;
+    uint32_t code;
+    uint32_t tick;
+    uint32_t state;
+    uint32_t registers[CRASH_FRAME_WORDS];
+    uint32_t sp;
+    uint32_t cfsr;
+    uint32_t hfsr;
+    uint32_t mmfar;
+    uint32_t bfar;
+    uint32_t stack[CRASH_STACK_WORDS];
+    uint32_t checksum;
+} CrashRecord;
+
+/*F************************************************************************************************
+ * NAME: void CRASH_init()
+ *
+ * DESCRIPTION:
+ *      Checks whether the previous run left a crash record, appends it to the flash log and
+ *      prepares its report.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called once at boot, before anything can crash again.
+ */
+void CRASH_init();
+
+/*F************************************************************************************************
+ * NAME: void CRASH_flush()
+ *
+ * DESCRIPTION:
+ *      Sends the report of the crash found at boot, if any, as much as the Bluetooth outgoing
+ *      queue accepts.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called from the main loop, never from an interrupt service routine.
+ */
+void CRASH_flush();
+
+/*F************************************************************************************************
+ * NAME: void CRASH_halt(uint32_t code)
+ *
+ * DESCRIPTION:
+ *      Saves a crash record for a fatal error detected by the software and resets the device.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    code        Cause of the error, reported with the record
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It does not return.
+ */
+void CRASH_halt(uint32_t code) __attribute__((noreturn));
+
+#endif // CRASH_H
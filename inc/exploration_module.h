@@ -0,0 +1,197 @@
+/*H************************************************************************************************
+ * FILENAME:        exploration_module.h
+ *
+ * DESCRIPTION:
+ *      This header provides the frontier based exploration of an unknown room: the car scans its
+ *      surroundings with the ultrasonic sensor into an occupancy grid, drives towards the nearest
+ *      reachable frontier between the known free space and the unknown one, and scans again,
+ *      until no frontier is left. The coverage of the map is notified via telemetry after every
+ *      movement. The same cycle drives the car to a goal, along the shortest path on the map that
+ *      keeps away from the known obstacles.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    Exploration_Module_init()
+ *      void    Exploration_Module_start()
+ *      void    Exploration_Module_goTo(int32_t x, int32_t y)
+ *      void    Exploration_Module_abort()
+ *      void    Exploration_Module_forgetMap()
+ *      bool    Exploration_Module_isRunning()
+ *
+ * NOTES:
+ *      The pose of the car is kept by dead reckoning (see odometry_module.h): the rotations are
+ *      the commanded ones, corrected by matching the scans taken before and after each turn,
+ *      the straight movements are measured by the ultrasonic sensor against the obstacle in
+ *      front, when there is one in range.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 19 Oct 2026  Maintainers     Added the driving to a goal
+ * 19 Oct 2026  Maintainers     Added the correction of the heading after turns
+ * 19 Oct 2026  Maintainers     Map forgotten when the car is moved by other commands
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef EXPLORATION_MODULE_H
+#define EXPLORATION_MODULE_H
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_init()
+ *
+ * DESCRIPTION:
+ *      Initializes the module, no exploration is running.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Must be called after Powertrain_Module_init() and Sensing_Module_init().
+ */
+void Exploration_Module_init();
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_start()
+ *
+ * DESCRIPTION:
+ *      Starts the exploration from the current pose of the car, that becomes the origin of the
+ *      map. Each cycle scans the surroundings with a sweep of the sensor, plans the shortest path
+ *      to the nearest reachable frontier and drives along its first straight stretch. The
+ *      exploration ends when no frontier is left, the coverage is notified via telemetry after
+ *      every movement and at the end.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The exploration owns the shared timer, the motors and the ultrasonic sensor while
+ *      running. Nothing is done if it is already running.
+ */
+void Exploration_Module_start();
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_goTo(int32_t x, int32_t y)
+ *
+ * DESCRIPTION:
+ *      Drives the car to a goal on the map of the last exploration, or on a new map with the
+ *      current pose as origin if there was none. Each cycle scans the surroundings, plans the
+ *      shortest path to the goal with A*, across the unknown cells as well, and drives towards
+ *      its first waypoint, at most half a metre. The run ends within a cell from the goal, or
+ *      when the goal is not reachable, the pose is notified via telemetry after every movement
+ *      and at the end.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     x           Goal in the coordinates of the map (mm)
+ *          int32_t     y
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The map of the last exploration is kept until it is aborted or the car is moved by other
+ *      commands (see Exploration_Module_forgetMap()). Nothing is done if a run is in progress or
+ *      the goal is outside the grid.
+ */
+void Exploration_Module_goTo(int32_t x, int32_t y);
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_abort()
+ *
+ * DESCRIPTION:
+ *      Stops a running exploration, or the driving to a goal, and the motors, the coverage
+ *      reached is notified.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Exploration_Module_abort();
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_forgetMap()
+ *
+ * DESCRIPTION:
+ *      Forgets the map and the pose of the last run, the next drive to a goal starts a new map
+ *      from the pose of the car.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      To call whenever the motors are driven by another module or command, the dead reckoning
+ *      does not account their movements.
+ */
+void Exploration_Module_forgetMap();
+
+/*F************************************************************************************************
+ * NAME: bool Exploration_Module_isRunning()
+ *
+ * DESCRIPTION:
+ *      Tells whether an exploration, or the driving to a goal, is running.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True while the exploration owns the motors
+ *
+ *  NOTE:
+ */
+bool Exploration_Module_isRunning();
+
+#endif // EXPLORATION_MODULE_H
@@ -0,0 +1,323 @@
+/*H************************************************************************************************
+ * FILENAME:        grid.h
+ *
+ * DESCRIPTION:
+ *      This header provides a coarse occupancy grid of the surroundings of the car, built from
+ *      the echoes of the ultrasonic sensor: every echo clears the cells crossed by the sound and
+ *      marks the cell where it was reflected.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        GRID_clear()
+ *      void        GRID_markRay(int32_t x0, int32_t y0, int32_t x1, int32_t y1, bool isHit)
+ *      bool        GRID_toCell(int32_t x, int32_t y, int16_t *cx, int16_t *cy)
+ *      void        GRID_toPoint(int16_t cx, int16_t cy, int32_t *x, int32_t *y)
+ *      GridCell    GRID_getCell(int16_t cx, int16_t cy)
+ *      bool        GRID_isFrontier(int16_t cx, int16_t cy)
+ *      bool        GRID_isVisible(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+ *                                 GridPassable isPassable)
+ *      uint16_t    GRID_countFree()
+ *      uint8_t     GRID_getCoverage()
+ *
+ * NOTES:
+ *      The grid covers GRID_SIZE x GRID_SIZE cells of GRID_CELL mm, in the coordinates of the
+ *      odometry (see odometry_module.h): the origin is at the centre of the middle cell.
+ *      Every cell holds a saturated count, decreased by the sound that crosses it and increased
+ *      more by the echoes reflected in it, so that a few clear readings do not erase a wall but
+ *      a spurious echo is cleared by the next readings. A cell never reached is unknown.
+ *      The coverage is the share of the free cells among the free cells and the unknown cells
+ *      next to them: it reaches 100% when the known free space is closed by walls.
+ *      The searches over the grid step in the GRID_DIRECTIONS directions of gridDx and gridDy,
+ *      and check the straight lines with GRID_isVisible() against their own passable cells.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 19 Oct 2026  Maintainers     Directions and line of sight shared by the searches
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef GRID_H
+#define GRID_H
+
+#define GRID_SIZE 64        /* Cells per side, 6.4m                                            */
+#define GRID_CELL 100       /* Side of a cell (mm)                                             */
+#define GRID_FREE_STEP 1    /* Decrease of a cell crossed by the sound                         */
+#define GRID_HIT_STEP 3     /* Increase of a cell that reflected the sound                     */
+#define GRID_LIMIT 24       /* Saturation of the counts                                        */
+#define GRID_DIRECTIONS 8   /* Neighbours of a cell, the orthogonal ones first                 */
+
+/*T************************************************************************************************
+ * NAME: GridCell
+ *
+ * DESCRIPTION:
+ *      Represent the knowledge of a cell.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: GRID_UNKNOWN        Never reached by the sound
+ *              GRID_FREE           Crossed by the sound more than reflecting it
+ *              GRID_OCCUPIED       Reflecting the sound, or outside the grid
+ */
+typedef enum {
+    GRID_UNKNOWN,
+    GRID_FREE,
+    GRID_OCCUPIED,
+} GridCell;
+
+/*T************************************************************************************************
+ * NAME: GridPassable
+ *
+ * DESCRIPTION:
+ *      Represent the test of the cells that a path can cross.
+ *
+ * SPECIFICATIONS:
+ *      Type:   bool (*)(int16_t cx, int16_t cy)
+ *      Params: int16_t     cx          Column of the cell
+ *              int16_t     cy          Row of the cell
+ *      Return: True if the path can cross the cell
+ */
+typedef bool (*GridPassable)(int16_t cx, int16_t cy);
+
+extern const int8_t gridDx[GRID_DIRECTIONS]; /* Column offsets of the directions            */
+extern const int8_t gridDy[GRID_DIRECTIONS]; /* Row offsets of the directions               */
+
+/*F************************************************************************************************
+ * NAME: void GRID_clear()
+ *
+ * DESCRIPTION:
+ *      Makes every cell unknown.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void GRID_clear();
+
+/*F************************************************************************************************
+ * NAME: void GRID_markRay(int32_t x0, int32_t y0, int32_t x1, int32_t y1, bool isHit)
+ *
+ * DESCRIPTION:
+ *      Accounts a reading of the ultrasonic sensor: the cells from the sensor to the end of the
+ *      ray are free, the cell at the end is occupied if the sound was reflected there.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     x0          Position of the sensor (mm)
+ *          int32_t     y0
+ *          int32_t     x1          End of the ray (mm)
+ *          int32_t     y1
+ *          bool        isHit       True if the sound was reflected at the end of the ray
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Every cell is accounted once per ray, the parts of the ray outside the grid are ignored.
+ */
+void GRID_markRay(int32_t x0, int32_t y0, int32_t x1, int32_t y1, bool isHit);
+
+/*F************************************************************************************************
+ * NAME: bool GRID_toCell(int32_t x, int32_t y, int16_t *cx, int16_t *cy)
+ *
+ * DESCRIPTION:
+ *      Finds the cell that contains a point.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     x           Point (mm)
+ *          int32_t     y
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          int16_t*    cx          Column of the cell
+ *          int16_t*    cy          Row of the cell
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the point is outside the grid
+ *
+ *  NOTE:
+ */
+bool GRID_toCell(int32_t x, int32_t y, int16_t *cx, int16_t *cy);
+
+/*F************************************************************************************************
+ * NAME: void GRID_toPoint(int16_t cx, int16_t cy, int32_t *x, int32_t *y)
+ *
+ * DESCRIPTION:
+ *      Finds the centre of a cell.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     cx          Column of the cell
+ *          int16_t     cy          Row of the cell
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          int32_t*    x           Centre of the cell (mm)
+ *          int32_t*    y
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void GRID_toPoint(int16_t cx, int16_t cy, int32_t *x, int32_t *y);
+
+/*F************************************************************************************************
+ * NAME: GridCell GRID_getCell(int16_t cx, int16_t cy)
+ *
+ * DESCRIPTION:
+ *      Returns the knowledge of a cell.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     cx          Column of the cell
+ *          int16_t     cy          Row of the cell
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   GridCell
+ *          Value:  Knowledge of the cell, GRID_OCCUPIED outside the grid
+ *
+ *  NOTE:
+ */
+GridCell GRID_getCell(int16_t cx, int16_t cy);
+
+/*F************************************************************************************************
+ * NAME: bool GRID_isFrontier(int16_t cx, int16_t cy)
+ *
+ * DESCRIPTION:
+ *      Tells whether a cell is on the frontier between the known free space and the unknown one.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     cx          Column of the cell
+ *          int16_t     cy          Row of the cell
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the cell is free and one of its four neighbours is unknown
+ *
+ *  NOTE:
+ */
+bool GRID_isFrontier(int16_t cx, int16_t cy);
+
+/*F************************************************************************************************
+ * NAME: bool GRID_isVisible(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+ *                           GridPassable isPassable)
+ *
+ * DESCRIPTION:
+ *      Tells whether the straight line between the centres of two cells crosses passable cells
+ *      only, walking it in steps of half a cell. The first cell is not checked.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t         x0          Cell of departure
+ *          int16_t         y0
+ *          int16_t         x1          Cell to reach
+ *          int16_t         y1
+ *          GridPassable    isPassable  Test of the cells crossed
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the car can drive straight from one cell to the other
+ *
+ *  NOTE:
+ */
+bool GRID_isVisible(int16_t x0, int16_t y0, int16_t x1, int16_t y1, GridPassable isPassable);
+
+/*F************************************************************************************************
+ * NAME: uint16_t GRID_countFree()
+ *
+ * DESCRIPTION:
+ *      Returns the number of free cells.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Free cells, each of GRID_CELL x GRID_CELL mm
+ *
+ *  NOTE:
+ */
+uint16_t GRID_countFree();
+
+/*F************************************************************************************************
+ * NAME: uint8_t GRID_getCoverage()
+ *
+ * DESCRIPTION:
+ *      Returns the share of the free cells among the free cells and the unknown cells next to
+ *      them.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint8_t
+ *          Value:  Coverage (%), 0 for an empty grid
+ *
+ *  NOTE:
+ */
+uint8_t GRID_getCoverage();
+
+#endif // GRID_H
@@ -0,0 +1,223 @@
+/*H************************************************************************************************
+ * FILENAME:        odometry_module.h
+ *
+ * DESCRIPTION:
+ *      This header provides the pose of the car estimated by dead reckoning: the modules that
+ *      move the car report the rotations and the straight movements they command, or measure,
+ *      and the pose accumulates them from the origin set by the last reset.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void            Odometry_Module_reset()
+ *      void            Odometry_Module_rotate(int16_t angle)
+ *      void            Odometry_Module_advance(int32_t distance)
+ *      OdometryPose    Odometry_Module_getPose()
+ *      int16_t         Odometry_Module_sin(int16_t angle)
+ *      int16_t         Odometry_Module_cos(int16_t angle)
+ *      int16_t         Odometry_Module_bearing(int32_t dx, int32_t dy)
+ *
+ * NOTES:
+ *      The x axis is the heading of the car at the reset, the y axis is at its left. Angles are
+ *      counterclockwise, as the positions of the servo: left turns increase the heading.
+ *      The trigonometry is in fixed point (ODOMETRY_ONE is 1), from a table of the sine at every
+ *      degree, so that the firmware does not need the floating point library.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdint.h>
+
+#ifndef ODOMETRY_MODULE_H
+#define ODOMETRY_MODULE_H
+
+#define ODOMETRY_ONE 16384 /* Fixed point 1 of the sines and cosines (Q14)                       */
+
+/*T************************************************************************************************
+ * NAME: OdometryPose
+ *
+ * DESCRIPTION:
+ *      Represent the position and orientation of the car.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   int32_t     x           Position along the heading at the reset (mm)
+ *              int32_t     y           Position at the left of the heading at the reset (mm)
+ *              int16_t     heading     Counterclockwise from the heading at the reset (0-359 deg)
+ */
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int16_t heading;
+} OdometryPose;
+
+/*F************************************************************************************************
+ * NAME: void Odometry_Module_reset()
+ *
+ * DESCRIPTION:
+ *      Moves the origin to the current pose of the car.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Odometry_Module_reset();
+
+/*F************************************************************************************************
+ * NAME: void Odometry_Module_rotate(int16_t angle)
+ *
+ * DESCRIPTION:
+ *      Accounts a rotation of the car on the spot.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     angle       Rotation, positive to the left (deg)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Odometry_Module_rotate(int16_t angle);
+
+/*F************************************************************************************************
+ * NAME: void Odometry_Module_advance(int32_t distance)
+ *
+ * DESCRIPTION:
+ *      Accounts a straight movement of the car along its heading.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     distance    Movement, negative backward (mm)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Odometry_Module_advance(int32_t distance);
+
+/*F************************************************************************************************
+ * NAME: OdometryPose Odometry_Module_getPose()
+ *
+ * DESCRIPTION:
+ *      Returns the estimated pose of the car.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   OdometryPose
+ *          Value:  Pose since the last reset
+ *
+ *  NOTE:
+ */
+OdometryPose Odometry_Module_getPose();
+
+/*F************************************************************************************************
+ * NAME: int16_t Odometry_Module_sin(int16_t angle)
+ *
+ * DESCRIPTION:
+ *      Returns the sine of an angle in fixed point.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     angle       Any angle (deg)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int16_t
+ *          Value:  Sine, ODOMETRY_ONE is 1
+ *
+ *  NOTE:
+ */
+int16_t Odometry_Module_sin(int16_t angle);
+
+/*F************************************************************************************************
+ * NAME: int16_t Odometry_Module_cos(int16_t angle)
+ *
+ * DESCRIPTION:
+ *      Returns the cosine of an angle in fixed point.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     angle       Any angle (deg)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int16_t
+ *          Value:  Cosine, ODOMETRY_ONE is 1
+ *
+ *  NOTE:
+ */
+int16_t Odometry_Module_cos(int16_t angle);
+
+/*F************************************************************************************************
+ * NAME: int16_t Odometry_Module_bearing(int32_t dx, int32_t dy)
+ *
+ * DESCRIPTION:
+ *      Returns the direction of a displacement, to the nearest degree.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     dx          Displacement along the x axis
+ *          int32_t     dy          Displacement along the y axis
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int16_t
+ *          Value:  Counterclockwise from the x axis (0-359 deg), 0 for no displacement
+ *
+ *  NOTE:
+ */
+int16_t Odometry_Module_bearing(int32_t dx, int32_t dy);
+
+#endif // ODOMETRY_MODULE_H
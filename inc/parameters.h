@@ -0,0 +1,69 @@
+/*H************************************************************************************************
+ * FILENAME:        parameters.h
+ *
+ * DESCRIPTION:
+ *      This header collects the tunable constants of the obstacle avoidance, they are kept in a
+ *      global struct so that the host tools can change them at runtime without recompiling.
+ *
+ * PUBLIC FUNCTIONS:
+ *
+ * NOTES:
+ *      Every default can be overridden at build time, e.g. with the parameter set produced by the
+ *      tuner: make PARAMS=build/tuned_parameters.h
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdint.h>
+
+#ifndef PARAMETERS_H_
+#define PARAMETERS_H_
+
+#ifndef SENSING_FREE_THRESHOLD
+#define SENSING_FREE_THRESHOLD 20 /* Minimum allowed clearance in cm                          */
+#endif
+
+#ifndef POWERTRAIN_FWD_SPEED
+#define POWERTRAIN_FWD_SPEED 30   /* Default speed for forward movements                      */
+#endif
+
+#ifndef POWERTRAIN_TURN_SPEED
+#define POWERTRAIN_TURN_SPEED 50  /* Default speed for turns                                  */
+#endif
+
+#ifndef SENSING_TIMER_COUNT
+#define SENSING_TIMER_COUNT 31250 /* 24MHz / 256 / 31250 = 3Hz = 0.33s between front checks  */
+#endif
+
+/*T************************************************************************************************
+ * NAME: Parameters
+ *
+ * DESCRIPTION:
+ *      Represent the tunable constants of the obstacle avoidance.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint16_t    freeThreshold       Minimum clearance for a direction to be free (cm)
+ *              uint8_t     forwardSpeed        Speed for forward movements (%)
+ *              uint8_t     turnSpeed           Speed for turns (%)
+ *              uint32_t    sensingTimerCount   Timer32 ticks between two front checks
+ */
+typedef struct {
+    uint16_t freeThreshold;
+    uint8_t forwardSpeed;
+    uint8_t turnSpeed;
+    uint32_t sensingTimerCount;
+} Parameters;
+
+/* Initializer with the build time defaults */
+#define PARAMETERS_DEFAULT                                                                         \
+    {SENSING_FREE_THRESHOLD, POWERTRAIN_FWD_SPEED, POWERTRAIN_TURN_SPEED, SENSING_TIMER_COUNT}
+
+// Global variables definition
+extern Parameters parameters; /* Parameters in use */
+
+#endif // PARAMETERS_H_
@@ -0,0 +1,221 @@
+/*H************************************************************************************************
+ * FILENAME:        planner.h
+ *
+ * DESCRIPTION:
+ *      This header provides an A* path planner over the occupancy grid (see grid.h): it finds the
+ *      shortest path between two cells that keeps away from the occupied cells, and reduces it to
+ *      the waypoints that the car can drive to in straight lines.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void            PLANNER_start(int16_t startX, int16_t startY, int16_t goalX,
+ *                                    int16_t goalY, uint8_t clearance)
+ *      PlannerStatus   PLANNER_step(uint16_t budget)
+ *      PlannerStatus   PLANNER_getStatus()
+ *      uint8_t         PLANNER_getWaypoints(int16_t *xs, int16_t *ys, uint8_t max)
+ *      PlannerStats    PLANNER_getStats()
+ *
+ * NOTES:
+ *      The search is incremental: every call of PLANNER_step() expands a bounded number of cells,
+ *      so that a query can be spread over several control ticks without missing their deadline.
+ *      The open list is a binary heap of PLANNER_HEAP entries, a cell is pushed again when a
+ *      shorter path to it is found and the stale entries are skipped when popped.
+ *      The unknown cells are passable: the path crosses the unexplored space optimistically and
+ *      is planned again once the scans have revealed it.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef PLANNER_H
+#define PLANNER_H
+
+#define PLANNER_HEAP 512       /* Entries of the open list                                        */
+#define PLANNER_PATH 128       /* Cells of the path kept from the start for the waypoints         */
+#define PLANNER_STRAIGHT 10    /* Cost of an orthogonal step                                      */
+#define PLANNER_DIAGONAL 14    /* Cost of a diagonal step                                         */
+
+/*T************************************************************************************************
+ * NAME: PlannerStatus
+ *
+ * DESCRIPTION:
+ *      Represent the progress of a query.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: PLANNER_IDLE            No query started
+ *              PLANNER_SEARCHING       Cells left to expand
+ *              PLANNER_FOUND           Path to the goal found
+ *              PLANNER_FAILED          The goal is not reachable
+ */
+typedef enum {
+    PLANNER_IDLE,
+    PLANNER_SEARCHING,
+    PLANNER_FOUND,
+    PLANNER_FAILED,
+} PlannerStatus;
+
+/*T************************************************************************************************
+ * NAME: PlannerStats
+ *
+ * DESCRIPTION:
+ *      Represent the work done by the last query.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Fields: uint16_t    expanded    Cells expanded
+ *              uint16_t    pushed      Entries pushed in the open list
+ *              uint16_t    dropped     Entries dropped because the open list was full
+ *              uint16_t    peak        Most entries in the open list at once
+ *              uint16_t    cost        Cost of the path, PLANNER_STRAIGHT per cell
+ */
+typedef struct {
+    uint16_t expanded;
+    uint16_t pushed;
+    uint16_t dropped;
+    uint16_t peak;
+    uint16_t cost;
+} PlannerStats;
+
+/*F************************************************************************************************
+ * NAME: void PLANNER_start(int16_t startX, int16_t startY, int16_t goalX, int16_t goalY,
+ *                          uint8_t clearance)
+ *
+ * DESCRIPTION:
+ *      Starts a query between two cells, no cell is expanded yet.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     startX      Cell of the car
+ *          int16_t     startY
+ *          int16_t     goalX       Cell to reach
+ *          int16_t     goalY
+ *          uint8_t     clearance   Cells kept between the path and the occupied ones
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The cell of the car is passable even if close to an obstacle, and so is the goal unless
+ *      occupied. The query fails at once if either cell is outside the grid.
+ */
+void PLANNER_start(int16_t startX, int16_t startY, int16_t goalX, int16_t goalY,
+                   uint8_t clearance);
+
+/*F************************************************************************************************
+ * NAME: PlannerStatus PLANNER_step(uint16_t budget)
+ *
+ * DESCRIPTION:
+ *      Goes on with the query in progress, expanding at most the given number of cells.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    budget      Cells that can be expanded by this call
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   PlannerStatus
+ *          Value:  PLANNER_SEARCHING if the budget ran out before the end of the query
+ *
+ *  NOTE:
+ *      The grid must not change until the query is over.
+ */
+PlannerStatus PLANNER_step(uint16_t budget);
+
+/*F************************************************************************************************
+ * NAME: PlannerStatus PLANNER_getStatus()
+ *
+ * DESCRIPTION:
+ *      Returns the progress of the last query.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   PlannerStatus
+ *          Value:  Progress of the last query
+ *
+ *  NOTE:
+ */
+PlannerStatus PLANNER_getStatus();
+
+/*F************************************************************************************************
+ * NAME: uint8_t PLANNER_getWaypoints(int16_t *xs, int16_t *ys, uint8_t max)
+ *
+ * DESCRIPTION:
+ *      Reduces the path found to the cells where it changes direction: each waypoint is the
+ *      farthest cell of the path seen in a straight line from the previous one, the first from
+ *      the cell of the car.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     max         Waypoints that fit in the arrays
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          int16_t*    xs          Columns of the waypoints, from the car to the goal
+ *          int16_t*    ys          Rows of the waypoints
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint8_t
+ *          Value:  Waypoints written, 0 if no path was found or the car is on the goal
+ *
+ *  NOTE:
+ *      Only the first PLANNER_PATH cells of a longer path are reduced, its last waypoint is not
+ *      the goal then.
+ */
+uint8_t PLANNER_getWaypoints(int16_t *xs, int16_t *ys, uint8_t max);
+
+/*F************************************************************************************************
+ * NAME: PlannerStats PLANNER_getStats()
+ *
+ * DESCRIPTION:
+ *      Returns the work done by the last query, for the benchmarks.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   PlannerStats
+ *          Value:  Counters of the last query
+ *
+ *  NOTE:
+ */
+PlannerStats PLANNER_getStats();
+
+#endif // PLANNER_H
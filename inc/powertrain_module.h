@@ -14,7 +14,12 @@
  *      void    Powertrain_Module_decreaseSpeed()
  *      void    Powertrain_Module_turnLeft(int8_t angle)
  *      void    Powertrain_Module_turnRight(int8_t angle)
+ *      void    Powertrain_Module_backOff()
  *      void    Powertrain_Module_registerTurnCompletedCallback(PowertrainCallback callback)
+ *      void    Powertrain_Module_setTrim(int16_t trim)
+ *      int16_t Powertrain_Module_getTrim()
+ *      uint32_t Powertrain_Module_getTurnTime(uint8_t angle)
+ *      void    Powertrain_Module_steer(int8_t left, int8_t right)
  *
  * NOTES:
  *
@@ -25,6 +30,10 @@
  * CHANGES:
  * DATE         AUTHOR          DETAIL
  * 19 Feb 2024  Andrea Piccin   Refactoring, removed move by distance, add speed management
+ * 18 Oct 2026  Maintainers     Added the timed back off
+ * 18 Oct 2026  Maintainers     Added the left/right trim
+ * 18 Oct 2026  Maintainers     Added the duration of the turns
+ * 19 Oct 2026  Maintainers     Added the independent speeds of the motors
  */
 #include <stdint.h>
 
@@ -37,6 +46,8 @@
 #ifndef POWERTRAIN_MODULE_H_
 #define POWERTRAIN_MODULE_H_
 
+#define POWERTRAIN_MAX_TRIM 200 /* Largest trim of the straight movements (‰) */
+
 /*T************************************************************************************************
  * NAME: Powertrain
  *
@@ -181,7 +192,7 @@ void Powertrain_Module_increaseSpeed();
  * NAME: void Powertrain_Module_decreaseSpeed();
  *
  * DESCRIPTION:
- *      Decreases the speed of the motors by 10% (min 20%);
+ *      Decreases the speed of the motors by 10% (min 20%, 10% with a speed curve);
  *
  * INPUTS:
  *      PARAMETERS:
@@ -243,6 +254,29 @@ void Powertrain_Module_turnLeft(uint8_t angle);
  */
 void Powertrain_Module_turnRight(uint8_t angle);
 
+/*F************************************************************************************************
+ * NAME: void Powertrain_Module_backOff();
+ *
+ * DESCRIPTION:
+ *      Make the robot move backward for a short time, then stop it and call the turn completed
+ *      callback
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Powertrain_Module_backOff();
+
 /*F************************************************************************************************
  * NAME: void Powertrain_Module_registerTurnCompletedCallback(PowertrainCallback callback);
  *
@@ -266,4 +300,105 @@ void Powertrain_Module_turnRight(uint8_t angle);
  */
 void Powertrain_Module_registerTurnCompletedCallback(PowertrainCallback callback);
 
-#endif /* POWERTRAIN_MODULE_H_ */
\ No newline at end of file
+/*F************************************************************************************************
+ * NAME: void Powertrain_Module_setTrim(int16_t trim)
+ *
+ * DESCRIPTION:
+ *      Sets the trim of the forward and backward movements: the duty cycle of the faster motor is
+ *      reduced by the given fraction so that the car runs straight. Applied from the next
+ *      movement.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     trim        Trim (‰), positive slows down the left motor, negative the right
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The trim is limited to +-POWERTRAIN_MAX_TRIM.
+ */
+void Powertrain_Module_setTrim(int16_t trim);
+
+/*F************************************************************************************************
+ * NAME: int16_t Powertrain_Module_getTrim()
+ *
+ * DESCRIPTION:
+ *      Returns the trim of the forward and backward movements.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int16_t
+ *          Value:  Trim (‰), positive slows down the left motor
+ *
+ *  NOTE:
+ */
+int16_t Powertrain_Module_getTrim();
+
+/*F************************************************************************************************
+ * NAME: uint32_t Powertrain_Module_getTurnTime(uint8_t angle)
+ *
+ * DESCRIPTION:
+ *      Returns the time taken by Powertrain_Module_turnLeft() and Powertrain_Module_turnRight()
+ *      to turn by the given angle, for the modules that drive the motors themselves.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     angle       Specifies the angle to turn.
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Ticks of the shared timer at parameters.turnSpeed
+ *
+ *  NOTE:
+ */
+uint32_t Powertrain_Module_getTurnTime(uint8_t angle);
+
+/*F************************************************************************************************
+ * NAME: void Powertrain_Module_steer(int8_t left, int8_t right)
+ *
+ * DESCRIPTION:
+ *      Drives each motor at its own speed until the next command, opposite signs turn the car in
+ *      place.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t      left        Speed of the left motor (%), negative backward, 0 stopped
+ *          int8_t      right       Speed of the right motor (%), negative backward, 0 stopped
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The trim is not applied, the caller balances the motors itself.
+ */
+void Powertrain_Module_steer(int8_t left, int8_t right);
+
+#endif /* POWERTRAIN_MODULE_H_ */
@@ -0,0 +1,162 @@
+/*H************************************************************************************************
+ * FILENAME:        profiler.h
+ *
+ * DESCRIPTION:
+ *      This header provides a statistical profiler: the SysTick interrupt samples the program
+ *      counter of the interrupted code, with its link register and execution context, and the
+ *      samples are sent in bulk via Bluetooth to be symbolised on the host (tools/profiler).
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        PROFILER_init()
+ *      void        PROFILER_flush()
+ *      void        PROFILER_encode(const ProfilerSample *sample, char *text)
+ *      bool        PROFILER_decode(const char *text, ProfilerSample *sample)
+ *
+ * NOTES:
+ *      The sampling is compiled in only when PROFILER_ENABLED is defined (make PROFILER=1), the
+ *      encoding is always available for the host tools.
+ *      The samples fill a window of PROFILER_BUFFER_SIZE samples at PROFILER_RATE Hz, then the
+ *      sampling pauses while PROFILER_flush() sends the window from the main loop, one sample per
+ *      line made of PROFILER_STREAM_PREFIX and the encoded sample, and starts the next window.
+ *      SysTick gets the highest priority and every device interrupt is lowered by one level, so
+ *      the interrupt service routines are sampled as well. The code that runs with the interrupts
+ *      disabled is not sampled: its samples fall on the instruction that enables them again.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#ifndef PROFILER_RATE
+#define PROFILER_RATE 1000             /* Samples per second                                  */
+#endif
+#ifndef PROFILER_BUFFER_SIZE
+#define PROFILER_BUFFER_SIZE 1024      /* Samples of a window, 12 bytes each in RAM           */
+#endif
+#define PROFILER_STREAM_PREFIX '%'     /* First char of a line of samples sent via Bluetooth  */
+#define PROFILER_SAMPLE_TEXT_LENGTH 18 /* Hex digits of an encoded sample                     */
+#define PROFILER_THREAD 0              /* Exception number of the main code                   */
+
+/*T************************************************************************************************
+ * NAME: ProfilerSample
+ *
+ * DESCRIPTION:
+ *      Represent the state of the interrupted code at a sample, as stacked by the exception entry.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    pc          Address of the next instruction to execute
+ *              uint32_t    lr          Link register, the caller of a leaf function
+ *              uint8_t     exception   Exception being served, PROFILER_THREAD for the main code
+ */
+typedef struct {
+    uint32_t pc;
+    uint32_t lr;
+    uint8_t exception;
+} ProfilerSample;
+
+/*F************************************************************************************************
+ * NAME: void PROFILER_init()
+ *
+ * DESCRIPTION:
+ *      Sets the priorities of SysTick and of the device interrupts and starts the sampling.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called after the clock system has been configured, the period of SysTick is
+ *      derived from MCLK.
+ */
+void PROFILER_init();
+
+/*F************************************************************************************************
+ * NAME: void PROFILER_flush()
+ *
+ * DESCRIPTION:
+ *      Sends the samples of a full window via Bluetooth, as much as the outgoing queue accepts,
+ *      and restarts the sampling when the whole window has been sent.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called from the main loop, never from an interrupt service routine.
+ */
+void PROFILER_flush();
+
+/*F************************************************************************************************
+ * NAME: void PROFILER_encode(const ProfilerSample *sample, char *text)
+ *
+ * DESCRIPTION:
+ *      Writes a sample as PROFILER_SAMPLE_TEXT_LENGTH hex digits: pc, lr and exception.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const ProfilerSample*   sample      Sample to encode
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          char*                   text        At least PROFILER_SAMPLE_TEXT_LENGTH chars
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The text is not terminated.
+ */
+void PROFILER_encode(const ProfilerSample *sample, char *text);
+
+/*F************************************************************************************************
+ * NAME: bool PROFILER_decode(const char *text, ProfilerSample *sample)
+ *
+ * DESCRIPTION:
+ *      Parses a sample written by PROFILER_encode().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*         text        PROFILER_SAMPLE_TEXT_LENGTH hex digits
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          ProfilerSample*     sample      Decoded sample
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the text is not a valid sample
+ *
+ *  NOTE:
+ */
+bool PROFILER_decode(const char *text, ProfilerSample *sample);
+
+#endif // PROFILER_H
@@ -0,0 +1,310 @@
+/*H************************************************************************************************
+ * FILENAME:        recorder.h
+ *
+ * DESCRIPTION:
+ *      This header provides the recording of the events crossing the HAL callback boundary: the
+ *      inputs delivered to the application (timer expirations, echoes, IR frames, Bluetooth
+ *      messages, battery readings) and the outputs it produces (motors, servo, telemetry).
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        RECORDER_init()
+ *      void        RECORDER_record(RecorderChannel channel, uint16_t value)
+ *      void        RECORDER_recordString(RecorderChannel channel, const char *string)
+ *      bool        RECORDER_read(RecorderEvent *event)
+ *      void        RECORDER_flush()
+ *      uint16_t    RECORDER_hash(const char *string, uint16_t seed)
+ *      void        RECORDER_encode(const RecorderEvent *event, char *text)
+ *      bool        RECORDER_decode(const char *text, RecorderEvent *event)
+ *
+ * NOTES:
+ *      The recording is compiled in only when RECORDER_ENABLED is defined (make RECORDER=bt or
+ *      make RECORDER=flash), otherwise the RECORDER_RECORD macros expand to nothing.
+ *      The events are stored in a RAM ring and moved by RECORDER_flush() from the main loop to:
+ *      - Bluetooth (default): lines made of RECORDER_STREAM_PREFIX and up to two encoded events
+ *      - Flash (RECORDER_SINK_FLASH): the last RECORDER_FLASH_SECTORS sectors of bank 1, that can
+ *        be dumped with openocd "dump_image rec.bin 0x3C000 0x4000"
+ *      If the ring is full the events are dropped and a RECORDER_CHANNEL_OVERFLOW event with the
+ *      number of lost events is stored as soon as there is space again.
+ *      The timestamps are Timer32 ticks (93750Hz) since the start of the periodic timer.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Channel of the detected motor stalls
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#define RECORDER_RING_SIZE 256         /* Events kept in RAM, must be a power of two          */
+#define RECORDER_STREAM_PREFIX '#'     /* First char of a line of events sent via Bluetooth   */
+#define RECORDER_EVENT_TEXT_LENGTH 14  /* Hex digits of an encoded event                      */
+#define RECORDER_FLASH_START 0x3C000   /* First byte of the flash log (bank 1, sector 28)     */
+#define RECORDER_FLASH_SECTORS 4       /* Sectors of 4KB reserved for the flash log           */
+#define RECORDER_FLASH_BLOCK 32        /* Events written to the flash log at once             */
+
+#ifdef RECORDER_ENABLED
+#define RECORDER_RECORD(channel, value) RECORDER_record((channel), (value))
+#define RECORDER_RECORD_STRING(channel, string) RECORDER_recordString((channel), (string))
+#else
+#define RECORDER_RECORD(channel, value) ((void)0)
+#define RECORDER_RECORD_STRING(channel, string) ((void)0)
+#endif
+
+/*T************************************************************************************************
+ * NAME: RecorderChannel
+ *
+ * DESCRIPTION:
+ *      Represent the source of an event and the meaning of its value.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: RECORDER_CHANNEL_PERIODIC_TIMER     Input, expiration of the periodic timer
+ *              RECORDER_CHANNEL_SHARED_TIMER       Input, expiration of the shared timer
+ *              RECORDER_CHANNEL_US_ECHO            Input, measured distance (cm)
+ *              RECORDER_CHANNEL_IR_FRAME           Input, command | isValid << 8
+ *              RECORDER_CHANNEL_BT_RX              Input, two chars of a message, '\0' ends it
+ *              RECORDER_CHANNEL_BATTERY            Input, voltage read by the application (mV)
+ *              RECORDER_CHANNEL_MOTOR_SPEED        Output, speed | isRight << 8
+ *              RECORDER_CHANNEL_MOTOR_DIRECTION    Output, direction | isRight << 8
+ *              RECORDER_CHANNEL_SERVO              Output, commanded position (int8_t)
+ *              RECORDER_CHANNEL_TELEMETRY          Output, hash of the message
+ *              RECORDER_CHANNEL_OVERFLOW           Number of events lost before this one
+ *              RECORDER_CHANNEL_MOTOR_STALL        Input, current (mA) | isRight << 13 |
+ *                                                  isOvercurrent << 14, detected stall
+ */
+typedef enum {
+    RECORDER_CHANNEL_PERIODIC_TIMER,
+    RECORDER_CHANNEL_SHARED_TIMER,
+    RECORDER_CHANNEL_US_ECHO,
+    RECORDER_CHANNEL_IR_FRAME,
+    RECORDER_CHANNEL_BT_RX,
+    RECORDER_CHANNEL_BATTERY,
+    RECORDER_CHANNEL_MOTOR_SPEED,
+    RECORDER_CHANNEL_MOTOR_DIRECTION,
+    RECORDER_CHANNEL_SERVO,
+    RECORDER_CHANNEL_TELEMETRY,
+    RECORDER_CHANNEL_OVERFLOW,
+    RECORDER_CHANNEL_MOTOR_STALL,
+    RECORDER_NUM_CHANNELS
+} RecorderChannel;
+
+/*T************************************************************************************************
+ * NAME: RecorderEvent
+ *
+ * DESCRIPTION:
+ *      Represent a recorded event, 8 bytes in RAM and in the flash log.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    tick        Timer32 ticks at the time of the event
+ *              uint16_t    value       Payload, see RecorderChannel
+ *              uint8_t     channel     RecorderChannel of the event
+ */
+typedef struct {
+    uint32_t tick;
+    uint16_t value;
+    uint8_t channel;
+} RecorderEvent;
+
+/*F************************************************************************************************
+ * NAME: void RECORDER_init()
+ *
+ * DESCRIPTION:
+ *      Empties the ring and, with the flash sink, erases the flash log.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called before the initialisation of the HALs in order to catch all the events.
+ */
+void RECORDER_init();
+
+/*F************************************************************************************************
+ * NAME: void RECORDER_record(RecorderChannel channel, uint16_t value)
+ *
+ * DESCRIPTION:
+ *      Appends a timestamped event to the ring.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          RecorderChannel     channel     Source of the event
+ *          uint16_t            value       Payload
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It can be called from the interrupt service routines, use the RECORDER_RECORD macro.
+ */
+void RECORDER_record(RecorderChannel channel, uint16_t value);
+
+/*F************************************************************************************************
+ * NAME: void RECORDER_recordString(RecorderChannel channel, const char *string)
+ *
+ * DESCRIPTION:
+ *      Appends a string as a sequence of events with two chars each, the last event contains the
+ *      string terminator.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          RecorderChannel     channel     Source of the event
+ *          const char*         string      String to record
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Use the RECORDER_RECORD_STRING macro.
+ */
+void RECORDER_recordString(RecorderChannel channel, const char *string);
+
+/*F************************************************************************************************
+ * NAME: bool RECORDER_read(RecorderEvent *event)
+ *
+ * DESCRIPTION:
+ *      Removes the oldest event from the ring.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          RecorderEvent*  event       Oldest event
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the ring is empty
+ *
+ *  NOTE:
+ */
+bool RECORDER_read(RecorderEvent *event);
+
+/*F************************************************************************************************
+ * NAME: void RECORDER_flush()
+ *
+ * DESCRIPTION:
+ *      Moves the recorded events to the configured sink, as much as the sink accepts without
+ *      blocking.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called from the main loop, never from an interrupt service routine.
+ */
+void RECORDER_flush();
+
+/*F************************************************************************************************
+ * NAME: uint16_t RECORDER_hash(const char *string, uint16_t seed)
+ *
+ * DESCRIPTION:
+ *      Computes the CRC-16/CCITT of a string, used to record long outputs in a single event.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*     string      String to hash
+ *          uint16_t        seed        Initial value of the CRC
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  CRC of the string
+ *
+ *  NOTE:
+ */
+uint16_t RECORDER_hash(const char *string, uint16_t seed);
+
+/*F************************************************************************************************
+ * NAME: void RECORDER_encode(const RecorderEvent *event, char *text)
+ *
+ * DESCRIPTION:
+ *      Writes an event as RECORDER_EVENT_TEXT_LENGTH hex digits: tick, channel and value.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const RecorderEvent*    event       Event to encode
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          char*                   text        At least RECORDER_EVENT_TEXT_LENGTH chars
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The text is not terminated.
+ */
+void RECORDER_encode(const RecorderEvent *event, char *text);
+
+/*F************************************************************************************************
+ * NAME: bool RECORDER_decode(const char *text, RecorderEvent *event)
+ *
+ * DESCRIPTION:
+ *      Parses an event written by RECORDER_encode().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*     text        RECORDER_EVENT_TEXT_LENGTH hex digits
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          RecorderEvent*  event       Decoded event
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the text is not a valid event
+ *
+ *  NOTE:
+ */
+bool RECORDER_decode(const char *text, RecorderEvent *event);
+
+#endif // RECORDER_H
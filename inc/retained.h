@@ -0,0 +1,185 @@
+/*H************************************************************************************************
+ * FILENAME:        retained.h
+ *
+ * DESCRIPTION:
+ *      This header provides the warm restart: the state of the car is kept in RAM that survives
+ *      the reset, so that after a watchdog or brown-out reset the system resumes it instead of
+ *      booting from scratch.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void                    RETAINED_init()
+ *      const RetainedState*    RETAINED_getRestored()
+ *      void                    RETAINED_update()
+ *      uint32_t                RETAINED_crc(const void *data, uint32_t size)
+ *
+ * NOTES:
+ *      The RetainedState lives in the .noinit section, which the startup code neither loads nor
+ *      clears, as the crash record. The cause of the reset is read from the reset controller:
+ *      - warm: time-out or password violation of the watchdog, supply supervisor or band gap
+ *        reference of the power supply system (brown-out)
+ *      - cold: power on, reset pin, reboot, software reset (SYSRESETREQ, used after a crash)
+ *      The state is restored only after a warm reset and if its magic and CRC are valid, a block
+ *      that did not survive the reset is rejected by its CRC.
+ *      The test build keeps the state in plain RAM and takes the cause of the reset from
+ *      retainedResetCause.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "parameters.h"
+
+#ifndef RETAINED_H
+#define RETAINED_H
+
+#define RETAINED_MAGIC 0x5741524D /* First word of a valid state ("WARM")                    */
+
+/*T************************************************************************************************
+ * NAME: RetainedReset
+ *
+ * DESCRIPTION:
+ *      Represent the cause of the last reset.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: RETAINED_RESET_COLD     The state is lost, or must not be resumed
+ *              RETAINED_RESET_WARM     The RAM survived a watchdog or brown-out reset
+ */
+typedef enum { RETAINED_RESET_COLD, RETAINED_RESET_WARM } RetainedReset;
+
+/*T************************************************************************************************
+ * NAME: RetainedState
+ *
+ * DESCRIPTION:
+ *      Represent the state of the car resumed by a warm restart, 20 bytes in RAM.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    magic           RETAINED_MAGIC if the state is valid
+ *              bool        isAutonomous    True in the autonomous mode, false in the remote one
+ *              int8_t      servoPosition   Last commanded position of the servo (deg)
+ *              Parameters  parameters      Tunable parameters in use
+ *              uint32_t    crc             CRC-32 of the previous fields, padding excluded
+ */
+typedef struct {
+    uint32_t magic;
+    bool isAutonomous;
+    int8_t servoPosition;
+    Parameters parameters;
+    uint32_t crc;
+} RetainedState;
+
+#ifdef TEST
+extern RetainedState retainedState;      /* State kept through the reset                      */
+extern RetainedReset retainedResetCause; /* Cause of the next boot in the test build          */
+#endif
+
+/*F************************************************************************************************
+ * NAME: void RETAINED_init()
+ *
+ * DESCRIPTION:
+ *      Reads and clears the cause of the reset, then validates the retained state: after a warm
+ *      reset with a valid state the tunable parameters are restored at once, the rest is
+ *      available to the modules through RETAINED_getRestored().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Parameters  parameters      Restored after a warm reset
+ *
+ *  NOTE:
+ *      It must be called once at boot, before the modules are initialised.
+ */
+void RETAINED_init();
+
+/*F************************************************************************************************
+ * NAME: const RetainedState* RETAINED_getRestored()
+ *
+ * DESCRIPTION:
+ *      Returns the state found at boot, if it is resumed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   const RetainedState*
+ *          Value:  State before the reset, NULL after a cold boot
+ *
+ *  NOTE:
+ */
+const RetainedState *RETAINED_getRestored();
+
+/*F************************************************************************************************
+ * NAME: void RETAINED_update()
+ *
+ * DESCRIPTION:
+ *      Copies the current mode, the servo position and the parameters to the retained state,
+ *      the CRC is computed again only if they changed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          FSM_State   FSM_currentState
+ *          Parameters  parameters
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called from the main loop, so that the state is never retained half written
+ *      by an interrupt service routine.
+ */
+void RETAINED_update();
+
+/*F************************************************************************************************
+ * NAME: uint32_t RETAINED_crc(const void *data, uint32_t size)
+ *
+ * DESCRIPTION:
+ *      Computes the CRC-32 (IEEE 802.3, reflected) of a block of memory.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const void*     data        First byte of the block
+ *          uint32_t        size        Bytes of the block
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  CRC of the block
+ *
+ *  NOTE:
+ */
+uint32_t RETAINED_crc(const void *data, uint32_t size);
+
+#endif // RETAINED_H
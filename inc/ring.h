@@ -0,0 +1,242 @@
+/*H************************************************************************************************
+ * FILENAME:        ring.h
+ *
+ * DESCRIPTION:
+ *      This header provides a lock-free ring of strings with many producers and one consumer:
+ *      the messages can be pushed from interrupt service routines of any priority, preempting
+ *      each other in the middle of a push, and are popped in order by the transmission.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        RING_init(StringRing *ring)
+ *      bool        RING_push(StringRing *ring, const char *string)
+ *      const char* RING_front(StringRing *ring)
+ *      void        RING_pop(StringRing *ring)
+ *      bool        RING_isEmpty(StringRing *ring)
+ *      bool        RING_isFull(StringRing *ring)
+ *
+ * NOTES:
+ *      Every slot has a sequence number, that tells whose turn it is: the producer of the
+ *      position i finds i, publishes the string with i + 1, and the consumer gives the slot
+ *      back to the producer of the position i + RING_SIZE. A producer reserves a position by
+ *      advancing the head with a compare and swap, fills the slot and publishes it: a producer
+ *      preempted before publishing does not block the others, only the consumer waits for it.
+ *      On the Cortex-M4 the compare and swap is made of the exclusive load and store
+ *      (LDREX/STREX), the exception entry and return clear the exclusive monitor so that the
+ *      store fails if an interrupt ran in between. On the host (tests, emulation and tools)
+ *      the counters are C11 atomics, the producers can be threads.
+ *      The positions wrap at 2^32, RING_SIZE must be a power of two.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef __arm__
+#include <stdatomic.h>
+#endif
+
+#ifndef RING_H
+#define RING_H
+
+#define RING_SIZE 16             /* Slots of the ring, a power of two                           */
+#define RING_ELEMENT_SIZE 30     /* Chars of a slot, terminator included                        */
+
+#ifdef __arm__
+typedef volatile uint32_t RingCounter;
+#else
+typedef _Atomic uint32_t RingCounter;
+#endif
+
+/*T************************************************************************************************
+ * NAME: RingSlot
+ *
+ * DESCRIPTION:
+ *      Represent a slot of the ring.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   RingCounter     sequence    Position of the ring that can use the slot, plus 1 once
+ *                                          the string is published
+ *              char[]          data        String of the slot
+ */
+typedef struct {
+    RingCounter sequence;
+    char data[RING_ELEMENT_SIZE];
+} RingSlot;
+
+/*T************************************************************************************************
+ * NAME: StringRing
+ *
+ * DESCRIPTION:
+ *      Represent a ring of strings, 584 bytes in RAM.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   RingSlot[]      slots       Slots, the position i in slots[i % RING_SIZE]
+ *              RingCounter     head        Next position reserved by a producer
+ *              uint32_t        tail        Next position popped, owned by the consumer
+ */
+typedef struct {
+    RingSlot slots[RING_SIZE];
+    RingCounter head;
+    uint32_t tail;
+} StringRing;
+
+/*F************************************************************************************************
+ * NAME: void RING_init(StringRing *ring)
+ *
+ * DESCRIPTION:
+ *      Empties the ring.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StringRing*     ring        Ring to empty
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Must not run concurrently with the other functions.
+ */
+void RING_init(StringRing *ring);
+
+/*F************************************************************************************************
+ * NAME: bool RING_push(StringRing *ring, const char *string)
+ *
+ * DESCRIPTION:
+ *      Copies a string at the end of the ring, from any context.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StringRing*     ring        Ring of the messages
+ *          const char*     string      String to push, shorter than RING_ELEMENT_SIZE
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the ring is full or the string too long, nothing is pushed
+ *
+ *  NOTE:
+ *      Never waits for another producer, it retries only when another push reserved the same
+ *      position first.
+ */
+bool RING_push(StringRing *ring, const char *string);
+
+/*F************************************************************************************************
+ * NAME: const char* RING_front(StringRing *ring)
+ *
+ * DESCRIPTION:
+ *      Returns the oldest string of the ring, without removing it.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StringRing*     ring        Ring of the messages
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   const char*
+ *          Value:  String, valid until RING_pop(), NULL if the oldest position is not published
+ *
+ *  NOTE:
+ *      Consumer only.
+ */
+const char *RING_front(StringRing *ring);
+
+/*F************************************************************************************************
+ * NAME: void RING_pop(StringRing *ring)
+ *
+ * DESCRIPTION:
+ *      Removes the oldest string of the ring, its slot is given back to the producers.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StringRing*     ring        Ring of the messages
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Consumer only, nothing is done if RING_front() would return NULL.
+ */
+void RING_pop(StringRing *ring);
+
+/*F************************************************************************************************
+ * NAME: bool RING_isEmpty(StringRing *ring)
+ *
+ * DESCRIPTION:
+ *      Tells whether the consumer has nothing to pop.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StringRing*     ring        Ring of the messages
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the oldest position is not published, even if a later one is
+ *
+ *  NOTE:
+ *      Consumer only.
+ */
+bool RING_isEmpty(StringRing *ring);
+
+/*F************************************************************************************************
+ * NAME: bool RING_isFull(StringRing *ring)
+ *
+ * DESCRIPTION:
+ *      Tells whether a push would fail for lack of slots.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StringRing*     ring        Ring of the messages
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the next position is still owned by the consumer
+ *
+ *  NOTE:
+ *      A hint only: a concurrent push or pop can change it right after.
+ */
+bool RING_isFull(StringRing *ring);
+
+#endif // RING_H
@@ -0,0 +1,264 @@
+/*H************************************************************************************************
+ * FILENAME:        route_module.h
+ *
+ * DESCRIPTION:
+ *      This header provides the teach and repeat of a route: the path of the car driven with the
+ *      manual commands is recorded as a list of points, stored in flash, and replayed by the car
+ *      on its own with a pure pursuit follower that stops in front of the obstacles.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    Route_Module_init()
+ *      void    Route_Module_startRecording()
+ *      void    Route_Module_update(int16_t turn)
+ *      void    Route_Module_stopRecording()
+ *      void    Route_Module_startReplay()
+ *      void    Route_Module_abort()
+ *      bool    Route_Module_isRecording()
+ *      bool    Route_Module_isReplaying()
+ *
+ * NOTES:
+ *      The car has no wheel encoders: the pose is dead-reckoned from the speeds of the motors
+ *      and the time they were applied, with the same wheel model as the timing of the turns of
+ *      the powertrain. The route is relative to the pose of the car at the start of the
+ *      recording, the replay starts with the car placed there, facing the same way.
+ *      The record is kept in sector ROUTE_FLASH_START of bank 1, dumped with openocd
+ *      "dump_image route.bin 0x39000 0x1000". The test build keeps it in RAM, where it survives
+ *      the reinitialisation of the modules.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef ROUTE_MODULE_H
+#define ROUTE_MODULE_H
+
+#define ROUTE_MAGIC 0x80E7E5A1           /* First word of a valid record                       */
+#define ROUTE_FLASH_START 0x39000        /* Record (bank 1, sector 25), before the calibration */
+#define ROUTE_FLASH_SIZE 0x1000          /* One sector                                         */
+#define ROUTE_POINTS 512                 /* Points of the longest route                        */
+#define ROUTE_UNIT 5                     /* Resolution of the points (mm)                      */
+#define ROUTE_SPACING 50                 /* Distance between the recorded points (mm)          */
+
+/*T************************************************************************************************
+ * NAME: RouteRecord
+ *
+ * DESCRIPTION:
+ *      Represent a recorded route, 1036 bytes in flash. Every point is the displacement from the
+ *      previous one, the first from the start of the route.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t        magic       ROUTE_MAGIC if the record is valid
+ *              uint16_t        count       Points of the route
+ *              uint16_t        unit        Resolution of the displacements (mm)
+ *              int8_t[][]      deltas      Displacement of each point along x and y (units)
+ *              uint32_t        checksum    Complement of the sum of the previous words
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t count;
+    uint16_t unit;
+    int8_t deltas[ROUTE_POINTS][2];
+    uint32_t checksum;
+} RouteRecord;
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_init()
+ *
+ * DESCRIPTION:
+ *      Loads the stored route, if valid, nothing is recorded or replayed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Must be called after Powertrain_Module_init() and Sensing_Module_init().
+ */
+void Route_Module_init();
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_startRecording()
+ *
+ * DESCRIPTION:
+ *      Starts a new route from the pose of the car, the manual commands that follow are recorded
+ *      until Route_Module_stopRecording().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Nothing is done if a route is being recorded or replayed. The stored route is kept until
+ *      the new one is stopped.
+ */
+void Route_Module_startRecording();
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_update(int16_t turn)
+ *
+ * DESCRIPTION:
+ *      Accounts a manual command while recording: the movement since the previous command is
+ *      added to the route, then the turn, then the speeds set by the command are kept for the
+ *      next movement.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     turn        Counterclockwise turn of the command (deg), 0 if none
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Must be called after the command is applied to the motors. Nothing is done if no route
+ *      is being recorded.
+ */
+void Route_Module_update(int16_t turn);
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_stopRecording()
+ *
+ * DESCRIPTION:
+ *      Ends the recording: the car is stopped and the route replaces the stored one.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      A route without points is not stored, the previous one is loaded back.
+ */
+void Route_Module_stopRecording();
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_startReplay()
+ *
+ * DESCRIPTION:
+ *      Drives the car along the stored route, from its start. The car stops in front of an
+ *      obstacle and goes on once it is gone.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Nothing is done if a route is being recorded or replayed, or if none is stored.
+ */
+void Route_Module_startReplay();
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_abort()
+ *
+ * DESCRIPTION:
+ *      Ends the replay in progress, if any, and stops the car.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Route_Module_abort();
+
+/*F************************************************************************************************
+ * NAME: bool Route_Module_isRecording()
+ *
+ * DESCRIPTION:
+ *      Tells whether a route is being recorded.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True from Route_Module_startRecording() to Route_Module_stopRecording()
+ *
+ *  NOTE:
+ */
+bool Route_Module_isRecording();
+
+/*F************************************************************************************************
+ * NAME: bool Route_Module_isReplaying()
+ *
+ * DESCRIPTION:
+ *      Tells whether the route is being replayed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True until the end of the route is reached or the replay is aborted
+ *
+ *  NOTE:
+ */
+bool Route_Module_isReplaying();
+
+#endif // ROUTE_MODULE_H
@@ -0,0 +1,134 @@
+/*H************************************************************************************************
+ * FILENAME:        scanmatch.h
+ *
+ * DESCRIPTION:
+ *      This header provides the estimate of a rotation of the car in place from two scans of the
+ *      ultrasonic sensor, one before and one after it: the range profiles over the angle of the
+ *      servo are the same, shifted by the rotation.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    SCANMATCH_clear(ScanProfile *profile)
+ *      void    SCANMATCH_add(ScanProfile *profile, int8_t angle, uint16_t distance)
+ *      bool    SCANMATCH_match(const ScanProfile *before, const ScanProfile *after,
+ *                              int16_t expected, uint8_t window, int16_t *rotation)
+ *
+ * NOTES:
+ *      The car turns in place, so that the ranges of the two scans are the same, only shifted: the
+ *      profiles are compared by the mean absolute difference of their ranges, in fixed point, at
+ *      every rotation within the window around the expected one, interpolating the first profile
+ *      between its bins. Only the bins with an echo in both profiles are compared.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SCANMATCH_H
+#define SCANMATCH_H
+
+#define SCANMATCH_STEP 5              /* Degrees of the servo per bin                          */
+#define SCANMATCH_BINS 37             /* Bins of a profile, from -90 to 90 degrees             */
+#define SCANMATCH_MAX_RANGE 200       /* Longer ranges and missing echoes are clamped (cm)     */
+#define SCANMATCH_MIN_PAIRS 12        /* Bins with an echo in both profiles for a match        */
+#define SCANMATCH_MAX_ERROR 15        /* Largest mean difference of a match (cm)               */
+
+/*T************************************************************************************************
+ * NAME: ScanProfile
+ *
+ * DESCRIPTION:
+ *      Represent the ranges measured by a scan, by angle of the servo.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint16_t[]  ranges      Range of each bin (cm), 0 without an echo; bin i is at
+ *                                      i * SCANMATCH_STEP - 90 degrees
+ */
+typedef struct {
+    uint16_t ranges[SCANMATCH_BINS];
+} ScanProfile;
+
+/*F************************************************************************************************
+ * NAME: void SCANMATCH_clear(ScanProfile *profile)
+ *
+ * DESCRIPTION:
+ *      Empties a profile, no bin has an echo.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          ScanProfile*    profile     Profile to empty
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SCANMATCH_clear(ScanProfile *profile);
+
+/*F************************************************************************************************
+ * NAME: void SCANMATCH_add(ScanProfile *profile, int8_t angle, uint16_t distance)
+ *
+ * DESCRIPTION:
+ *      Accounts an echo in the bin of its angle, replacing the previous one.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          ScanProfile*    profile     Profile of the scan
+ *          int8_t          angle       Position of the servo (deg), counterclockwise
+ *          uint16_t        distance    Distance of the echo (cm), above SCANMATCH_MAX_RANGE if
+ *                                      nothing was hit
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SCANMATCH_add(ScanProfile *profile, int8_t angle, uint16_t distance);
+
+/*F************************************************************************************************
+ * NAME: bool SCANMATCH_match(const ScanProfile *before, const ScanProfile *after,
+ *                            int16_t expected, uint8_t window, int16_t *rotation)
+ *
+ * DESCRIPTION:
+ *      Estimates the rotation of the car between two scans taken from the same position.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const ScanProfile*  before      Scan before the rotation
+ *          const ScanProfile*  after       Scan after the rotation
+ *          int16_t             expected    Commanded rotation (deg), counterclockwise
+ *          uint8_t             window      Largest error of the commanded rotation (deg)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          int16_t*            rotation    Estimated rotation (deg), counterclockwise, if matched
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the scans overlap by less than SCANMATCH_MIN_PAIRS bins or differ
+ *                  by more than SCANMATCH_MAX_ERROR at every rotation
+ *
+ *  NOTE:
+ *      A rotation counterclockwise moves the echoes clockwise, towards the negative angles.
+ */
+bool SCANMATCH_match(const ScanProfile *before, const ScanProfile *after, int16_t expected,
+                     uint8_t window, int16_t *rotation);
+
+#endif // SCANMATCH_H
@@ -8,12 +8,21 @@
  *
  * PUBLIC FUNCTIONS:
  *      void    Sensing_Module_init()
+ *      void    Sensing_Module_resume(int8_t servoPosition)
  *      void    Sensing_Module_checkSingleClearance(int8_t deg)
  *      void    Sensing_Module_checkDoubleClearance(int8_t deg1, int8t deg2)
  *      void    Sensing_Module_checkFrontClearance()
+ *      void    Sensing_Module_trackFrontClearance(uint8_t speed)
+ *      void    Sensing_Module_stopTracking()
  *      void    Sensing_Module_checkLateralClearance()
  *      void    Sensing_Module_registerSingleMeasurementReadyCallback(SensingSingleCallback call)
  *      void    Sensing_Module_registerDoubleMeasurementReadyCallback(SensingDoubleCallback call)
+ *      void    Sensing_Module_measureDistance(int8_t deg)
+ *      void    Sensing_Module_registerDistanceCallback(SensingDistanceCallback call)
+ *      int8_t  Sensing_Module_getServoPosition()
+ *      void    Sensing_Module_startSweep(uint8_t step, SensingSweepCallback callback)
+ *      void    Sensing_Module_stopSweep()
+ *      bool    Sensing_Module_isSweeping()
  *
  * NOTES:
  *
@@ -25,6 +34,10 @@
  * DATE         AUTHOR              DETAIL
  * 16 Feb 2024  Andrea Piccin       Refactoring
  * 19 Feb 2024  Andrea Piccin       Single (front) and Double (lateral) measurements callbacks
+ * 18 Oct 2026  Maintainers         Raw distance measurements
+ * 18 Oct 2026  Maintainers         Resume after a warm reset
+ * 18 Oct 2026  Maintainers         Continuous sweep
+ * 19 Oct 2026  Maintainers         Early front pings predicted from the speed
  */
 #include <stdbool.h>
 #include <stdint.h>
@@ -57,6 +70,31 @@ typedef void (*SensingSingleCallback)(bool isFree);
  */
 typedef void (*SensingDoubleCallback)(bool isDir1Free, bool isDir2Free);
 
+/*T************************************************************************************************
+ * NAME: SensingDistanceCallback
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that executes when a distance measurement is ready
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Args:   uint16_t    distance    Distance of the closest object (cm)
+ */
+typedef void (*SensingDistanceCallback)(uint16_t distance);
+
+/*T************************************************************************************************
+ * NAME: SensingSweepCallback
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that executes when an echo of the sweep is ready
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Args:   int8_t      angle       Angle of the servo when the sound was reflected (deg)
+ *              uint16_t    distance    Distance of the closest object (cm)
+ */
+typedef void (*SensingSweepCallback)(int8_t angle, uint16_t distance);
+
 /*F************************************************************************************************
  * NAME: void Sensing_Module_init()
  *
@@ -80,6 +118,29 @@ typedef void (*SensingDoubleCallback)(bool isDir1Free, bool isDir2Free);
  */
 void Sensing_Module_init();
 
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_resume(int8_t servoPosition)
+ *
+ * DESCRIPTION:
+ *      Initializes the hardware as Sensing_Module_init() after a warm reset, the servo is known to
+ *      be at the given position and is not moved.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t      servoPosition       Position of the servo before the reset
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Sensing_Module_resume(int8_t servoPosition);
+
 /*F************************************************************************************************
  * NAME: void Sensing_Module_checkSingleClearance(int8_t deg)
  *
@@ -173,6 +234,58 @@ void Sensing_Module_checkLateralClearance();
  */
 void Sensing_Module_checkFrontClearance();
 
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_trackFrontClearance(uint8_t speed)
+ *
+ * DESCRIPTION:
+ *      Checks if there is an object in front of the robot, which moves forward at the given speed
+ *      until the next check, one period of the periodic timer later. If the distance predicted
+ *      from the echo crosses the free threshold before then, the sensor pings again as soon as
+ *      the echo ends, or halfway to the crossing when it is farther: every echo is forwarded to
+ *      the single measurement callback.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     speed       Commanded forward speed (%)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Any other measurement stops the early pings.
+ */
+void Sensing_Module_trackFrontClearance(uint8_t speed);
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_stopTracking()
+ *
+ * DESCRIPTION:
+ *      Stops the early front pings of Sensing_Module_trackFrontClearance(), when the car stops
+ *      moving forward.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      An early ping waits on the shared timer: it must be stopped before another module
+ *      acquires the timer.
+ */
+void Sensing_Module_stopTracking();
+
 /*F************************************************************************************************
  * NAME: void Sensing_Module_registerSingleMeasurementReadyCallback(SensingSingleCallback callback)
  *
@@ -219,4 +332,151 @@ void Sensing_Module_registerSingleMeasurementReadyCallback(SensingSingleCallback
  */
 void Sensing_Module_registerDoubleMeasurementReadyCallback(SensingDoubleCallback callback);
 
-#endif // SENSING_MODULE_H
\ No newline at end of file
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_measureDistance(int8_t deg)
+ *
+ * DESCRIPTION:
+ *      Moves motor to specified direction (from left -90 deg to right 90 deg) then measures the
+ *      distance of the closest object in that direction, that is passed to the distance callback.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t      deg     Direction of the measurement
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      No object detection is notified to the telemetry.
+ */
+void Sensing_Module_measureDistance(int8_t deg);
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_registerDistanceCallback(SensingDistanceCallback callback)
+ *
+ * DESCRIPTION:
+ *      Registers the SensingDistanceCallback as the function to call when a distance measurement
+ *      is ready.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SensingDistanceCallback     callback        The function to register as callback
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Sensing_Module_registerDistanceCallback(SensingDistanceCallback callback);
+
+/*F************************************************************************************************
+ * NAME: int8_t Sensing_Module_getServoPosition()
+ *
+ * DESCRIPTION:
+ *      Returns the last position commanded to the servo.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int8_t
+ *          Value:  Position of the servo (deg)
+ *
+ *  NOTE:
+ */
+int8_t Sensing_Module_getServoPosition();
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_startSweep(uint8_t step, SensingSweepCallback callback)
+ *
+ * DESCRIPTION:
+ *      Starts sweeping the servo between the extremes while the ultrasonic sensor pings back to
+ *      back, every echo is notified with the angle of the servo when the sound was reflected.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t                 step        Degrees the servo is let travel per echo, from 1
+ *                                              to 180
+ *          SensingSweepCallback    callback    The function to call for every echo
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The step trades the angular accuracy for the refresh rate: an echo averages the angles
+ *      travelled while the sound flies, up to the step. With 180 the servo never waits for the
+ *      sensor and a full sweep takes 0.66s.
+ */
+void Sensing_Module_startSweep(uint8_t step, SensingSweepCallback callback);
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_stopSweep()
+ *
+ * DESCRIPTION:
+ *      Stops the sweep, the servo goes back to the front and the pending echo is discarded.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Sensing_Module_stopSweep();
+
+/*F************************************************************************************************
+ * NAME: bool Sensing_Module_isSweeping()
+ *
+ * DESCRIPTION:
+ *      Returns true while a sweep is running.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True while sweeping
+ *
+ *  NOTE:
+ */
+bool Sensing_Module_isSweeping();
+
+#endif // SENSING_MODULE_H
@@ -6,8 +6,11 @@
  *
  * PUBLIC FUNCTIONS:
  *      void    SERVO_HAL_init(Servo* servo);
+ *      void    SERVO_HAL_resume(Servo* servo, int8_t position);
  *      void    SERVO_HAL_setPosition(Servo* servo, int8_t position);
  *      void    SERVO_HAL_registerPositionReachedCallback(ServoCallback callback);
+ *      void    SERVO_HAL_sweepTo(Servo* servo, int8_t position);
+ *      int8_t  SERVO_HAL_getAngle(const Servo* servo, uint32_t ticks);
  *
  * NOTES:
  *
@@ -21,6 +24,8 @@
  * 15 Feb 2024  Matteo Frizzera     Added functions to wait for servo to finish moving
  * 16 Feb 2024  Andrea Piccin       Refactoring, MIN and MAX position moved to header file
  * 21 Feb 2024  Andrea Piccin       Introduced resetPosition() function
+ * 18 Oct 2026  Maintainers         Resume without homing after a warm reset
+ * 18 Oct 2026  Maintainers         Continuous sweep and motion model
  */
 #include <stdint.h>
 
@@ -51,9 +56,13 @@ typedef void (*ServoCallback)();
  * SPECIFICATIONS:
  *      Type:   struct
  *      Vars:   uint8_t         position    Current position of the servo
+ *              int8_t          origin      Position of the servo when the position was commanded
+ *              uint32_t        startTicks  Ticks of the timer HAL when the position was commanded
  */
 typedef struct {
     int8_t position;
+    int8_t origin;
+    uint32_t startTicks;
 } ServoState;
 
 /*T************************************************************************************************
@@ -95,6 +104,30 @@ typedef struct {
  */
 void SERVO_HAL_init(Servo *servo);
 
+/*F************************************************************************************************
+ * NAME: void SERVO_HAL_resume(Servo* servo, int8_t position);
+ *
+ * DESCRIPTION:
+ *      Initialises a Servo motor instance that is already at the given position, after a warm
+ *      reset, without waiting for it to travel.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Servo*              servo           Motor that has to be initialised
+ *          int8_t              position        Position commanded before the reset
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          Servo*              servo           All the fields of the struct are set
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SERVO_HAL_resume(Servo *servo, int8_t position);
+
 /*F************************************************************************************************
  * NAME: void SERVO_HAL_setPosition(Servo* servo, int8_t position);
  *
@@ -140,6 +173,57 @@ void SERVO_HAL_setPosition(Servo *servo, int8_t position);
  */
 void SERVO_HAL_resetPosition(Servo *servo);
 
+/*F************************************************************************************************
+ * NAME: void SERVO_HAL_sweepTo(Servo* servo, int8_t position);
+ *
+ * DESCRIPTION:
+ *      Set the position of a servo without notifying when it is reached, the servo keeps moving
+ *      while the next position is commanded.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Servo*      servo                   Target servo
+ *          int8_t      position                Specifies the position to which rotate.
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          ServoState  servo->state            Set on the new motion
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SERVO_HAL_sweepTo(Servo *servo, int8_t position);
+
+/*F************************************************************************************************
+ * NAME: int8_t SERVO_HAL_getAngle(const Servo* servo, uint32_t ticks);
+ *
+ * DESCRIPTION:
+ *      Returns the angle of a servo at a given time, interpolated by the motion model: the servo
+ *      turns at constant speed from the origin to the commanded position.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const Servo*    servo               Target servo
+ *          uint32_t        ticks               Time, in ticks of the timer HAL
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int8_t
+ *          Value:  Angle of the servo (deg), the origin before the command
+ *
+ *  NOTE:
+ */
+int8_t SERVO_HAL_getAngle(const Servo *servo, uint32_t ticks);
+
 /*F************************************************************************************************
  * NAME: void SERVO_HAL_registerPositionReachedCallback(ServoCallback callback)
  *
@@ -0,0 +1,164 @@
+/*H************************************************************************************************
+ * FILENAME:        stall_module.h
+ *
+ * DESCRIPTION:
+ *      This header file contains the definitions of the functions that detect a stall or an
+ *      overcurrent of the motors from the current measured on the sense resistors of the L298N.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        Stall_Module_init()
+ *      void        Stall_Module_updateVoltage()
+ *      void        Stall_Module_raise(StallEvent event, MotorInitTemplate motor, uint16_t current)
+ *      void        Stall_Module_registerStallCallback(StallCallback callback)
+ *
+ * NOTES:
+ *      The current is sampled in the middle of the on-time of the PWM, where it only depends on
+ *      the back electromotive force of the motor: a free motor at the fraction m of its top speed
+ *      draws about (1 - m) of the stall current, a blocked one the whole stall current. A stall is
+ *      detected when the filtered current stays above the middle of the two for some periods.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdint.h>
+
+#ifdef TEST
+#include "../tests/motor_hal.h"
+#else
+#include "motor_hal.h"
+#endif
+
+#ifndef STALL_MODULE_H
+#define STALL_MODULE_H
+
+/*T************************************************************************************************
+ * NAME: StallEvent
+ *
+ * DESCRIPTION:
+ *      Represent the outcome of the check of a current sample
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: STALL_EVENT_NONE            The motor draws the expected current
+ *              STALL_EVENT_STALL           The motor is blocked while it should be turning
+ *              STALL_EVENT_OVERCURRENT     The current exceeds the limit of the driver
+ */
+typedef enum {
+    STALL_EVENT_NONE,
+    STALL_EVENT_STALL,
+    STALL_EVENT_OVERCURRENT,
+} StallEvent;
+
+/*T************************************************************************************************
+ * NAME: StallCallback
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that executes when a stall or an overcurrent is detected.
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Args:   StallEvent      event       Detected event
+ */
+typedef void (*StallCallback)(StallEvent event);
+
+/*F************************************************************************************************
+ * NAME: void Stall_Module_init()
+ *
+ * DESCRIPTION:
+ *      Resets the detectors, reads the supply voltage and starts the current sense of both
+ *      channels of the powertrain.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Powertrain      powertrain      Motors to supervise
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called after Powertrain_Module_init() and Telemetry_Module_init(), the latter
+ *      initialises the ADC.
+ */
+void Stall_Module_init();
+
+/*F************************************************************************************************
+ * NAME: void Stall_Module_updateVoltage()
+ *
+ * DESCRIPTION:
+ *      Reads the battery voltage, the stall current of the motors is proportional to it.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Stall_Module_updateVoltage();
+
+/*F************************************************************************************************
+ * NAME: void Stall_Module_raise(StallEvent event, MotorInitTemplate motor, uint16_t current)
+ *
+ * DESCRIPTION:
+ *      Reports a detected event: records it, sends the telemetry message and calls the
+ *      registered callback.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StallEvent          event       Detected event, not STALL_EVENT_NONE
+ *          MotorInitTemplate   motor       Channel of the event
+ *          uint16_t            current     Current that caused the event (mA)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It is called by the detectors, the replay uses it to inject the recorded events since the
+ *      current samples are not recorded.
+ */
+void Stall_Module_raise(StallEvent event, MotorInitTemplate motor, uint16_t current);
+
+/*F************************************************************************************************
+ * NAME: void Stall_Module_registerStallCallback(StallCallback callback)
+ *
+ * DESCRIPTION:
+ *      Registers a given function as the callback function for the detected events.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StallCallback       callback    Function to register as callback
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Stall_Module_registerStallCallback(StallCallback callback);
+
+#endif // STALL_MODULE_H
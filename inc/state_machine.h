@@ -11,6 +11,7 @@
  *      void        FSM_sensing()
  *      void        FSM_turning()
  *      void        FSM_remote()
+ *      void        FSM_recovering()
  *
  * NOTES:
  *
@@ -19,6 +20,7 @@
  * START DATE: 19 Feb 2024
  *
  * CHANGES:
+ * 18 Oct 2026  Maintainers     Added the recovery from a motor stall
  */
 #ifndef STATE_MACHINE_H_
 #define STATE_MACHINE_H_
@@ -36,6 +38,7 @@
  *                  STATE_SENSING       Indicates the sensing state
  *                  STATE TURNING       Indicates the turning state
  *                  STATE_REMOTE        Indicates the remote state
+ *                  STATE_RECOVERING    Indicates the back off after a motor stall
  *                  NUM_STATES          Indicates the number of states
  */
 typedef enum {
@@ -44,6 +47,7 @@ typedef enum {
     STATE_SENSING,
     STATE_TURNING,
     STATE_REMOTE,
+    STATE_RECOVERING,
     NUM_STATES,
 } FSM_State;
 
@@ -64,11 +68,12 @@ typedef struct {
 } FSM_StateMachine;
 
 // Functions declaration
-void FSM_init();    /* Handle the STATE_INIT state    */
-void FSM_running(); /* Handle the STATE_RUNNING state */
-void FSM_sensing(); /* Handle the STATE_SENSING state */
-void FSM_turning(); /* Handle the STATE_TURNING state */
-void FSM_remote();  /* Handle the STATE_REMOTE state  */
+void FSM_init();       /* Handle the STATE_INIT state       */
+void FSM_running();    /* Handle the STATE_RUNNING state    */
+void FSM_sensing();    /* Handle the STATE_SENSING state    */
+void FSM_turning();    /* Handle the STATE_TURNING state    */
+void FSM_remote();     /* Handle the STATE_REMOTE state     */
+void FSM_recovering(); /* Handle the STATE_RECOVERING state */
 
 // Global variables definition
 extern FSM_State FSM_currentState;              /* Current FSM state    */
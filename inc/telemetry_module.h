@@ -17,6 +17,14 @@
  *      void Telemetry_Module_notifyLeftMotorDirChange(Motor *motor, MotorDirection direction)
  *      void Telemetry_Module_notifyRightMotorDirChange(Motor *motor, MotorDirection direction)
  *      void Telemetry_Module_notifyObjectDetected(uint8_t servoDirection, uint16_t objectDistance)
+ *      void Telemetry_Module_notifyMotorStall(bool isRight, uint16_t current, bool isOvercurrent)
+ *      void Telemetry_Module_notifyCalibrationPoint(uint16_t duty, uint16_t speed)
+ *      void Telemetry_Module_notifyCalibrationResult(bool isSaved)
+ *      void Telemetry_Module_notifyTrimPass(int16_t trim, int16_t drift)
+ *      void Telemetry_Module_notifySweepPoint(int8_t angle, uint16_t distance)
+ *      void Telemetry_Module_notifyExploration(uint8_t coverage, const OdometryPose *pose,
+ *                                              bool isDone)
+ *      void Telemetry_Module_notifyRoute(uint16_t points, const OdometryPose *pose, bool isDone)
  *
  * NOTES:
  *
@@ -29,10 +37,18 @@
  * 20 Feb 2024     Matteo Frizzera     Add function to notify mode switch
  * 20 Feb 2024     Andrea Piccin       Refactor, removed utility functions from header
  *                                     Fixed structures declaration
+ * 18 Oct 2026     Maintainers         Add function to notify a motor stall
+ * 18 Oct 2026     Maintainers         Add functions to notify the calibration of the motors
+ * 18 Oct 2026     Maintainers         Add function to notify a pass of the trim calibration
+ * 18 Oct 2026     Maintainers         Add function to notify an echo of the sweep
+ * 18 Oct 2026     Maintainers         Add function to notify the progress of the exploration
+ * 19 Oct 2026     Maintainers         Add function to notify the recording and replay of a route
  */
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "odometry_module.h"
+
 #ifdef TEST
 #include "../tests/motor_hal.h"
 #else
@@ -70,6 +86,14 @@ typedef enum { MSG_LOW_SEVERITY, MSG_MEDIUM_SEVERITY, MSG_HIGH_SEVERITY } Messag
  *              MSG_SPEED_UPDATE                    speed of motor has changed
  *              MSG_MOTOR_DIR_UPDATE                direction of motor has changed
  *              MSG_MODE_SWITCH                     control mode becomes manual or auto
+ *              MSG_MOTOR_STALL                     a motor is blocked while it should turn
+ *              MSG_MOTOR_OVERCURRENT               a motor exceeds the current of the driver
+ *              MSG_CALIBRATION_POINT               speed measured at a duty cycle of the sweep
+ *              MSG_CALIBRATION_RESULT              the calibration sweep has ended
+ *              MSG_TRIM_PASS                       drift measured at a trim along a wall
+ *              MSG_SWEEP_POINT                     echo of the sweep of the ultrasonic sensor
+ *              MSG_EXPLORATION                     coverage and position of the exploration
+ *              MSG_ROUTE                           points and position of a recorded route
  *
  */
 typedef enum {
@@ -80,6 +104,14 @@ typedef enum {
     MSG_L_MOTOR_DIR_UPDATE,
     MSG_R_MOTOR_DIR_UPDATE,
     MSG_MODE_SWITCH,
+    MSG_MOTOR_STALL,
+    MSG_MOTOR_OVERCURRENT,
+    MSG_CALIBRATION_POINT,
+    MSG_CALIBRATION_RESULT,
+    MSG_TRIM_PASS,
+    MSG_SWEEP_POINT,
+    MSG_EXPLORATION,
+    MSG_ROUTE,
 } MessageType;
 
 /*F************************************************************************************************
@@ -307,4 +339,189 @@ void Telemetry_Module_notifyObjectDetected(uint8_t servoDirection, uint16_t obje
  */
 void Telemetry_Module_notifyModeSwitch(bool controlled);
 
-#endif // TELEMETRY_MODULE_H
\ No newline at end of file
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyMotorStall(bool isRight, uint16_t current, bool isOvercurrent)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the channel and the current of a detected
+ *      stall or overcurrent.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          bool        isRight         Whether the event concerns the right motors
+ *          uint16_t    current         Current that caused the event (mA)
+ *          bool        isOvercurrent   Whether the event is an overcurrent rather than a stall
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ *      this function is called in the interrupt of the ADC.
+ */
+void Telemetry_Module_notifyMotorStall(bool isRight, uint16_t current, bool isOvercurrent);
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyCalibrationPoint(uint16_t duty, uint16_t speed)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the speed measured at a duty cycle of the
+ *      calibration sweep.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    duty            Duty cycle of the motors (‰)
+ *          uint16_t    speed           Measured speed of the car (mm/s)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifyCalibrationPoint(uint16_t duty, uint16_t speed);
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyCalibrationResult(bool isSaved)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the result of the calibration sweep, or of
+ *      the calibration of the trim.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          bool        isSaved         Whether new curves, or a new trim, have been stored
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifyCalibrationResult(bool isSaved);
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyTrimPass(int16_t trim, int16_t drift)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the drift measured by a pass of the
+ *      calibration of the trim.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     trim            Trim of the pass (‰)
+ *          int16_t     drift           Drift to the right of the car (mm)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifyTrimPass(int16_t trim, int16_t drift);
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifySweepPoint(int8_t angle, uint16_t distance)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with an echo of the sweep of the ultrasonic sensor.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t      angle           Angle of the servo when the sound was reflected (deg)
+ *          uint16_t    distance        Distance of the closest object (cm)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifySweepPoint(int8_t angle, uint16_t distance);
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyExploration(uint8_t coverage, const OdometryPose *pose,
+ *                                          bool isDone)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the coverage of the map and the position of
+ *      the car, after every scan of the exploration and at its end.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t             coverage        Coverage of the map (%)
+ *          const OdometryPose* pose            Estimated pose of the car
+ *          bool                isDone          True if no frontier is left to reach
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifyExploration(uint8_t coverage, const OdometryPose *pose, bool isDone);
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyRoute(uint16_t points, const OdometryPose *pose, bool isDone)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the points of a route and the position of
+ *      the car on it, while the route is recorded or replayed and at the end.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t            points          Points recorded, or reached by the replay
+ *          const OdometryPose* pose            Estimated pose of the car from the start
+ *          bool                isDone          True at the end of the recording or the replay
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifyRoute(uint16_t points, const OdometryPose *pose, bool isDone);
+
+#endif // TELEMETRY_MODULE_H
@@ -13,6 +13,7 @@
  *      void    TIMER_HAL_registerPeriodicTimerCallback(TimerCallback callback);
  *      void    TIMER_HAL_acquireSharedTimer(uint32_t count, TimerCallback callback);
  *      void    TIMER_HAL_releaseSharedTimer();
+ *      uint32_t TIMER_HAL_getTicks();
  *
  * NOTES:
  *
@@ -21,6 +22,8 @@
  * START DATE: 20 Feb 2024
  *
  * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Added the elapsed time for the recorder
  */
 #include <stdint.h>
 
@@ -155,4 +158,30 @@ void TIMER_HAL_acquireSharedTimer(uint32_t count, TimerCallback callback);
  */
 void TIMER_HAL_releaseSharedTimer();
 
+/*F************************************************************************************************
+ * NAME: uint32_t TIMER_HAL_getTicks()
+ *
+ * DESCRIPTION:
+ *      Returns the time elapsed since the start of the periodic timer.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Ticks at 93750Hz, 0 if the periodic timer has not been started
+ *
+ *  NOTE:
+ *      It wraps around after about 12.7 hours.
+ */
+uint32_t TIMER_HAL_getTicks();
+
 #endif // TIMER_HAL_H
\ No newline at end of file
@@ -0,0 +1,427 @@
+/*H************************************************************************************************
+ * FILENAME:        trace.h
+ *
+ * DESCRIPTION:
+ *      This header provides the execution trace: begin, end and instant events of the callbacks
+ *      run by the interrupt service routines, of the changes of state and of the outputs they
+ *      produce, dumped in bulk via Bluetooth and converted on the host into the Chrome trace
+ *      event format (tools/tracer), viewable in chrome://tracing or Perfetto.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        TRACE_init()
+ *      void        TRACE_start()
+ *      void        TRACE_stop()
+ *      void        TRACE_event(TraceId id, TracePhase phase, uint16_t arg)
+ *      uint16_t    TRACE_getEvents(const TraceEvent **events)
+ *      uint32_t    TRACE_getClockRate()
+ *      void        TRACE_flush()
+ *      void        TRACE_encode(const TraceEvent *event, char *text)
+ *      bool        TRACE_decode(const char *text, TraceEvent *event)
+ *      TraceLine   TRACE_decodeLine(const char *line, uint32_t *rate, TraceEvent *event)
+ *      uint64_t    TRACE_unwrap(uint64_t previous, uint32_t time)
+ *
+ * NOTES:
+ *      The events are compiled in only when TRACE_ENABLED is defined (make TRACE=1), otherwise
+ *      the TRACE macros expand to nothing; the encoding is always available for the host tools.
+ *      A capture starts with TRACE_start(), e.g. the Bluetooth command "TRC", and ends with
+ *      TRACE_stop() ("TRD") or when TRACE_BUFFER_SIZE events have been stored. Then
+ *      TRACE_flush() sends from the main loop a line made of TRACE_STREAM_PREFIX and
+ *      TRACE_CLOCK_TAG with the rate of the timestamps, followed by one line per event.
+ *      The timestamps are the cycles of the DWT counter (MCLK), which wraps every 179s at 24MHz:
+ *      the converter unwraps them as long as two consecutive events are closer than that.
+ *      On the host (TEST) they are the ticks of the mocked timer.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE 512          /* Events of a capture, 8 bytes each in RAM            */
+#endif
+#define TRACE_STREAM_PREFIX '&'        /* First char of a line of the dump via Bluetooth      */
+#define TRACE_CLOCK_TAG "CLOCK "       /* Starts a capture, followed by the rate in Hz        */
+#define TRACE_EVENT_TEXT_LENGTH 15     /* Chars of an encoded event                           */
+
+#ifdef TRACE_ENABLED
+#define TRACE_BEGIN(id, arg) TRACE_event((id), TRACE_PHASE_BEGIN, (arg))
+#define TRACE_END(id) TRACE_event((id), TRACE_PHASE_END, 0)
+#define TRACE_INSTANT(id, arg) TRACE_event((id), TRACE_PHASE_INSTANT, (arg))
+#else
+#define TRACE_BEGIN(id, arg) ((void)0)
+#define TRACE_END(id) ((void)0)
+#define TRACE_INSTANT(id, arg) ((void)0)
+#endif
+
+/*T************************************************************************************************
+ * NAME: TraceId
+ *
+ * DESCRIPTION:
+ *      Represent what an event refers to and the meaning of its argument.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: TRACE_ID_STATE              Instant, state entered or current at the start of a
+ *                                          capture (FSM_State)
+ *              TRACE_ID_PERIODIC_TIMER     Slice, callback of the periodic timer
+ *              TRACE_ID_SHARED_TIMER       Slice, callback of the shared timer
+ *              TRACE_ID_US_ECHO            Slice, callback of an echo (distance in cm)
+ *              TRACE_ID_IR_FRAME           Slice, callback of an IR frame (command)
+ *              TRACE_ID_BT_RX              Slice, callback of a Bluetooth message (first char)
+ *              TRACE_ID_TELEMETRY          Slice, formatting and queueing of a message (type)
+ *              TRACE_ID_MOTOR_SPEED        Instant, speed | isRight << 8
+ *              TRACE_ID_MOTOR_DIRECTION    Instant, direction | isRight << 8
+ *              TRACE_ID_SERVO              Instant, commanded position (int8_t)
+ *              TRACE_ID_BATTERY            Instant, voltage read by the application (mV)
+ */
+typedef enum {
+    TRACE_ID_STATE,
+    TRACE_ID_PERIODIC_TIMER,
+    TRACE_ID_SHARED_TIMER,
+    TRACE_ID_US_ECHO,
+    TRACE_ID_IR_FRAME,
+    TRACE_ID_BT_RX,
+    TRACE_ID_TELEMETRY,
+    TRACE_ID_MOTOR_SPEED,
+    TRACE_ID_MOTOR_DIRECTION,
+    TRACE_ID_SERVO,
+    TRACE_ID_BATTERY,
+    TRACE_NUM_IDS
+} TraceId;
+
+/*T************************************************************************************************
+ * NAME: TracePhase
+ *
+ * DESCRIPTION:
+ *      Represent the kind of an event, the values are the phases of the Chrome trace format.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: TRACE_PHASE_BEGIN       Start of a slice
+ *              TRACE_PHASE_END         End of the innermost slice with the same id
+ *              TRACE_PHASE_INSTANT     Event without duration
+ */
+typedef enum {
+    TRACE_PHASE_BEGIN = 'B',
+    TRACE_PHASE_END = 'E',
+    TRACE_PHASE_INSTANT = 'i'
+} TracePhase;
+
+/*T************************************************************************************************
+ * NAME: TraceEvent
+ *
+ * DESCRIPTION:
+ *      Represent a traced event, 8 bytes in RAM.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    time        Timestamp, see TRACE_getClockRate()
+ *              uint16_t    arg         Argument, see TraceId
+ *              uint8_t     id          TraceId of the event
+ *              uint8_t     phase       TracePhase of the event
+ */
+typedef struct {
+    uint32_t time;
+    uint16_t arg;
+    uint8_t id;
+    uint8_t phase;
+} TraceEvent;
+
+/*T************************************************************************************************
+ * NAME: TraceLine
+ *
+ * DESCRIPTION:
+ *      Represent the content of a line of a dump.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: TRACE_LINE_OTHER        Without TRACE_STREAM_PREFIX, not part of a dump
+ *              TRACE_LINE_CLOCK        Start of a capture with the rate of the timestamps
+ *              TRACE_LINE_EVENT        Event of the current capture
+ *              TRACE_LINE_INVALID      With TRACE_STREAM_PREFIX but neither of the above
+ */
+typedef enum {
+    TRACE_LINE_OTHER,
+    TRACE_LINE_CLOCK,
+    TRACE_LINE_EVENT,
+    TRACE_LINE_INVALID
+} TraceLine;
+
+/*F************************************************************************************************
+ * NAME: void TRACE_init()
+ *
+ * DESCRIPTION:
+ *      Starts the timestamp counter, empties the buffer and leaves the capture stopped.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called after the clock system has been configured, the rate is MCLK.
+ */
+void TRACE_init();
+
+/*F************************************************************************************************
+ * NAME: void TRACE_start()
+ *
+ * DESCRIPTION:
+ *      Empties the buffer, dropping a dump in progress, and starts a capture.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void TRACE_start();
+
+/*F************************************************************************************************
+ * NAME: void TRACE_stop()
+ *
+ * DESCRIPTION:
+ *      Ends the capture, TRACE_flush() dumps the stored events.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void TRACE_stop();
+
+/*F************************************************************************************************
+ * NAME: void TRACE_event(TraceId id, TracePhase phase, uint16_t arg)
+ *
+ * DESCRIPTION:
+ *      Appends a timestamped event to the buffer while a capture is running, the capture ends
+ *      when the buffer is full.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          TraceId     id          What the event refers to
+ *          TracePhase  phase       Begin, end or instant
+ *          uint16_t    arg         Argument, see TraceId
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It can be called from the interrupt service routines, use the TRACE macros.
+ */
+void TRACE_event(TraceId id, TracePhase phase, uint16_t arg);
+
+/*F************************************************************************************************
+ * NAME: uint16_t TRACE_getEvents(const TraceEvent **events)
+ *
+ * DESCRIPTION:
+ *      Gives access to the events stored by the current or by the last capture.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          const TraceEvent**  events      Set to the first event
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Number of stored events, TRACE_BUFFER_SIZE if the capture ended because full
+ *
+ *  NOTE:
+ *      Used by the simulator, which dumps the events to a file instead of TRACE_flush().
+ */
+uint16_t TRACE_getEvents(const TraceEvent **events);
+
+/*F************************************************************************************************
+ * NAME: uint32_t TRACE_getClockRate()
+ *
+ * DESCRIPTION:
+ *      Returns the rate of the timestamps.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Timestamps per second
+ *
+ *  NOTE:
+ */
+uint32_t TRACE_getClockRate();
+
+/*F************************************************************************************************
+ * NAME: void TRACE_flush()
+ *
+ * DESCRIPTION:
+ *      Dumps the events of an ended capture via Bluetooth, as much as the outgoing queue accepts.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It must be called from the main loop, never from an interrupt service routine.
+ */
+void TRACE_flush();
+
+/*F************************************************************************************************
+ * NAME: void TRACE_encode(const TraceEvent *event, char *text)
+ *
+ * DESCRIPTION:
+ *      Writes an event as TRACE_EVENT_TEXT_LENGTH chars: time, id and arg in hex digits, with the
+ *      phase char between id and arg.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const TraceEvent*   event       Event to encode
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          char*               text        At least TRACE_EVENT_TEXT_LENGTH chars
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The text is not terminated.
+ */
+void TRACE_encode(const TraceEvent *event, char *text);
+
+/*F************************************************************************************************
+ * NAME: bool TRACE_decode(const char *text, TraceEvent *event)
+ *
+ * DESCRIPTION:
+ *      Parses an event written by TRACE_encode().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*     text        TRACE_EVENT_TEXT_LENGTH chars
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          TraceEvent*     event       Decoded event
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the text is not a valid event
+ *
+ *  NOTE:
+ */
+bool TRACE_decode(const char *text, TraceEvent *event);
+
+/*F************************************************************************************************
+ * NAME: TraceLine TRACE_decodeLine(const char *line, uint32_t *rate, TraceEvent *event)
+ *
+ * DESCRIPTION:
+ *      Parses a line sent by TRACE_flush(), found anywhere in a line of the Bluetooth log.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*     line        Terminated line
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          uint32_t*       rate        Rate of the timestamps, for TRACE_LINE_CLOCK
+ *          TraceEvent*     event       Decoded event, for TRACE_LINE_EVENT
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   TraceLine
+ *          Value:  Content of the line
+ *
+ *  NOTE:
+ */
+TraceLine TRACE_decodeLine(const char *line, uint32_t *rate, TraceEvent *event);
+
+/*F************************************************************************************************
+ * NAME: uint64_t TRACE_unwrap(uint64_t previous, uint32_t time)
+ *
+ * DESCRIPTION:
+ *      Extends the 32 bit timestamp of an event to 64 bits, after the previous event.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t        previous    Unwrapped timestamp of the previous event
+ *          uint32_t        time        Timestamp of the event
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint64_t
+ *          Value:  Unwrapped timestamp of the event
+ *
+ *  NOTE:
+ *      The two events must be closer than a wrap of the counter.
+ */
+uint64_t TRACE_unwrap(uint64_t previous, uint32_t time);
+
+#endif // TRACE_H
@@ -9,6 +9,7 @@
  *      void        US_HAL_init()
  *      void        US_HAL_triggerMeasurement()
  *      void        US_HAL_registerMeasurementCallback(USCallback callback);
+ *      uint32_t    US_HAL_getEchoTicks();
  *
  * NOTES:
  *
@@ -19,6 +20,7 @@
  * CHANGES:
  * DATE         AUTHOR          DETAIL
  * 10 Feb 2024  Andrea Piccin   Introduced callback mechanism
+ * 18 Oct 2026  Maintainers     Time of the echo
  */
 #include <stdint.h>
 
@@ -105,4 +107,30 @@ void US_HAL_triggerMeasurement();
  */
 void US_HAL_registerMeasurementCallback(USCallback callback);
 
+/*F************************************************************************************************
+ * NAME: uint32_t US_HAL_getEchoTicks()
+ *
+ * DESCRIPTION:
+ *      Returns the time of the midpoint of the last echo pulse, when the sound was reflected.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Ticks of the timer HAL
+ *
+ *  NOTE:
+ *      It is valid inside the measurement callback.
+ */
+uint32_t US_HAL_getEchoTicks();
+
 #endif // ULTRASONIC_HAL_H
\ No newline at end of file
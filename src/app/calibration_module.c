@@ -0,0 +1,849 @@
+/*H************************************************************************************************
+ * FILENAME:        calibration_module.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the calibration of the speed curves of the motors, from a sweep
+ *      of the duty cycle measured with the ultrasonic sensor, the calibration of their left/right
+ *      trim, from the drift along a wall, and their persistence in flash.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    Calibration_Module_init()
+ *      void    Calibration_Module_startSweep()
+ *      void    Calibration_Module_startTrim()
+ *      void    Calibration_Module_abort()
+ *      bool    Calibration_Module_isRunning()
+ *      void    Calibration_Module_clear()
+ *
+ * NOTES:
+ *      The sweep is driven by the shared timer and by the distance measurements, as a sequence
+ *      of steps: every run is timed, then the car settles before the distance is measured. Each
+ *      duty cycle is run forward and back, so that the car ends where it started and the two
+ *      runs average out the noise of the sensor.
+ *      The ultrasonic sensor sees the car as a whole, so both motors get the same curve, the
+ *      difference between the sides is left to their trim.
+ *      The trim is solved by the secant method on the curvature of the path, that is linear in the
+ *      trim: the first pass measures the trim in use, the second one a probe next to it towards
+ *      the drift, then each pass is at the zero of the line fitted through the previous ones, so
+ *      that the last passes, close to each other, do not amplify the noise. The curvature is the
+ *      quadratic term of the least squares fit of the lateral distance against time, the samples
+ *      are taken at a fixed period so that the fit is a dot product with constant weights.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Calibration of the left/right trim
+ * 18 Oct 2026  Maintainers     Distance callback registered by every calibration
+ */
+#include <stddef.h>
+#include <string.h>
+
+#include "../../inc/calibration_module.h"
+#include "../../inc/parameters.h"
+#include "../../inc/powertrain_module.h"
+#include "../../inc/sensing_module.h"
+#include "../../inc/telemetry_module.h"
+
+#ifdef TEST
+#include "../../tests/motor_hal.h"
+#include "../../tests/timer_hal.h"
+#else
+#include "../../inc/driverlib/driverlib.h"
+#include "../../inc/motor_hal.h"
+#include "../../inc/timer_hal.h"
+#endif
+
+#define CALIBRATION_STEPS 10          /* Duty cycles of the sweep, every 10%                   */
+#define CALIBRATION_RUN 100000        /* Duration of each run in ticks (1s)                    */
+#define CALIBRATION_SETTLE 30000      /* Wait before each measurement in ticks (0.3s)          */
+#define CALIBRATION_MIN_DISTANCE 100  /* Clearance in front needed by a run at full speed (cm) */
+#define CALIBRATION_DIRECTION 0       /* Direction of the measurements, in front               */
+#define CALIBRATION_LEFT 90           /* Direction of the measurements at the left             */
+#define CALIBRATION_RIGHT -90         /* Direction of the measurements at the right            */
+#define CALIBRATION_TRIM_PASSES 3     /* Passes along the wall                                 */
+#define CALIBRATION_TRIM_SAMPLES 25   /* Lateral samples of a pass, odd for a centred fit      */
+#define CALIBRATION_TRIM_HALF ((CALIBRATION_TRIM_SAMPLES - 1) / 2) /* Samples at each side     */
+#define CALIBRATION_TRIM_PERIOD 20000 /* Period of the lateral samples in ticks (0.2s)         */
+#define CALIBRATION_TRIM_PROBE 40     /* Trim of the second pass, away from the first (‰)      */
+#define CALIBRATION_TRIM_MIN_DISTANCE 15  /* Closest approach to the wall (cm)                 */
+#define CALIBRATION_TRIM_MAX_DISTANCE 100 /* Farthest wall that can be followed (cm)           */
+#define CALIBRATION_TRIM_LOST 200     /* Distance at which the wall is lost (cm)               */
+
+/*T************************************************************************************************
+ * NAME: CalibrationStep
+ *
+ * DESCRIPTION:
+ *      Represent the step of the sweep in progress.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: CALIBRATION_IDLE            No sweep in progress
+ *              CALIBRATION_MEASURE_START   Measuring the distance before the first run
+ *              CALIBRATION_RUN_FORWARD     Running forward
+ *              CALIBRATION_SETTLE_FORWARD  Waiting for the car to stop after the forward run
+ *              CALIBRATION_MEASURE_FORWARD Measuring the distance after the forward run
+ *              CALIBRATION_RUN_REVERSE     Running backward
+ *              CALIBRATION_SETTLE_REVERSE  Waiting for the car to stop after the backward run
+ *              CALIBRATION_MEASURE_REVERSE Measuring the distance after the backward run
+ *              CALIBRATION_TRIM_LEFT       Measuring the distance of the wall at the left
+ *              CALIBRATION_TRIM_RIGHT      Measuring the distance of the wall at the right
+ *              CALIBRATION_TRIM_RUN        Running along the wall, between two samples
+ *              CALIBRATION_TRIM_SAMPLE     Running along the wall, measuring its distance
+ *              CALIBRATION_TRIM_SETTLE     Waiting for the car to stop after the pass
+ *              CALIBRATION_TRIM_RETURN     Running back to the start of the pass
+ *              CALIBRATION_TRIM_REST       Waiting for the car to stop after the return
+ */
+typedef enum {
+    CALIBRATION_IDLE,
+    CALIBRATION_MEASURE_START,
+    CALIBRATION_RUN_FORWARD,
+    CALIBRATION_SETTLE_FORWARD,
+    CALIBRATION_MEASURE_FORWARD,
+    CALIBRATION_RUN_REVERSE,
+    CALIBRATION_SETTLE_REVERSE,
+    CALIBRATION_MEASURE_REVERSE,
+    CALIBRATION_TRIM_LEFT,
+    CALIBRATION_TRIM_RIGHT,
+    CALIBRATION_TRIM_RUN,
+    CALIBRATION_TRIM_SAMPLE,
+    CALIBRATION_TRIM_SETTLE,
+    CALIBRATION_TRIM_RETURN,
+    CALIBRATION_TRIM_REST,
+} CalibrationStep;
+
+#ifdef TEST
+CalibrationRecord calibrationStore; /* Stand-in for the flash sector in the test build        */
+#define CALIBRATION_STORED (&calibrationStore)
+#else
+#define CALIBRATION_STORED ((const CalibrationRecord *)CALIBRATION_FLASH_START)
+#endif
+
+CalibrationRecord calibration;             /* Curves in use, valid if its magic is set          */
+volatile CalibrationStep calibrationStep;  /* Step of the sweep in progress                     */
+uint8_t calibrationIndex;                  /* Duty cycle being measured, from 0                 */
+uint16_t calibrationStart;                 /* Distance before the forward run (cm)              */
+uint16_t calibrationMiddle;                /* Distance after the forward run (cm)               */
+uint16_t calibrationSpeeds[CALIBRATION_STEPS]; /* Measured speed of each duty cycle (mm/s)      */
+int8_t trimSide;                           /* Direction of the wall followed, 90 or -90         */
+uint8_t trimPass;                          /* Pass in progress, from 0                          */
+uint8_t trimSample;                        /* Lateral samples taken in the pass                 */
+int32_t trimFit;                           /* Weighted sum of the lateral samples of the pass   */
+uint32_t trimStart;                        /* Start of the pass (ticks)                         */
+uint32_t trimDuration;                     /* Duration of the pass (ticks)                      */
+int16_t trimProbes[CALIBRATION_TRIM_PASSES]; /* Trim of each pass (‰)                           */
+int16_t trimDrifts[CALIBRATION_TRIM_PASSES]; /* Drift to the right of each pass (mm)            */
+
+/* Utility function declaration */
+static void Calibration_Module_onTimerEnded();
+static void Calibration_Module_onDistance(uint16_t distance);
+
+static uint32_t Calibration_Module_checksum(const CalibrationRecord *record) {
+    const uint32_t *words = (const uint32_t *)record;
+    uint32_t sum = 0;
+    for (size_t i = 0; i < offsetof(CalibrationRecord, checksum) / sizeof(uint32_t); i++)
+        sum += words[i];
+    return ~sum;
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_apply()
+ *
+ * DESCRIPTION:
+ *      Applies the curves and the trim of the calibration in use to the motors, the linear mapping
+ *      and no trim if there are none.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationRecord   calibration
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void Calibration_Module_apply() {
+    uint16_t flags = calibration.magic == CALIBRATION_MAGIC ? calibration.flags : 0;
+    bool hasCurves = flags & CALIBRATION_CURVES;
+    MOTOR_HAL_setCurve((Motor *)&powertrain.left_motor,
+                       hasCurves ? &calibration.curves[MOTOR_INIT_LEFT] : NULL);
+    MOTOR_HAL_setCurve((Motor *)&powertrain.right_motor,
+                       hasCurves ? &calibration.curves[MOTOR_INIT_RIGHT] : NULL);
+    Powertrain_Module_setTrim(flags & CALIBRATION_TRIM ? calibration.trim : 0);
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_store()
+ *
+ * DESCRIPTION:
+ *      Replaces the stored record with the calibration in use: the sector is erased, then
+ *      programmed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationRecord   calibration
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Erasing the sector stalls the CPU for some milliseconds, it is done with the car stopped.
+ */
+static void Calibration_Module_store() {
+#ifdef TEST
+    calibrationStore = calibration;
+#else
+    uint32_t sector = 1 << ((CALIBRATION_FLASH_START - 0x20000) / CALIBRATION_FLASH_SIZE);
+    FlashCtl_unprotectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, sector);
+    FlashCtl_eraseSector(CALIBRATION_FLASH_START);
+    if (calibration.magic == CALIBRATION_MAGIC)
+        FlashCtl_programMemory(&calibration, (void *)CALIBRATION_FLASH_START,
+                               sizeof(CalibrationRecord));
+    FlashCtl_protectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, sector);
+#endif
+}
+
+/*F************************************************************************************************
+ * NAME: bool Calibration_Module_solve(MotorCurve *curve)
+ *
+ * DESCRIPTION:
+ *      Solves the curve that makes the speed proportional to the requested one, in integer
+ *      arithmetic:
+ *      [1] Make the measured speeds non decreasing, the point k is at duty cycle k * 10%
+ *      [2] The first point of the curve is the largest duty cycle that does not move the car
+ *      [3] Every other point j is the duty cycle of j * 10% of the top speed, interpolated
+ *          between the two measurements around it
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t[]      calibrationSpeeds
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          MotorCurve*     curve       Solved curve
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the car never moved
+ *
+ *  NOTE:
+ */
+static bool Calibration_Module_solve(MotorCurve *curve) {
+    // [1] Measurements, with the car at rest at 0%
+    uint32_t speeds[CALIBRATION_STEPS + 1];
+    speeds[0] = 0;
+    for (uint8_t k = 1; k <= CALIBRATION_STEPS; k++)
+        speeds[k] = calibrationSpeeds[k - 1] > speeds[k - 1] ? calibrationSpeeds[k - 1]
+                                                              : speeds[k - 1];
+    uint32_t topSpeed = speeds[CALIBRATION_STEPS];
+    if (topSpeed == 0)
+        return false;
+
+    // [2] Duty cycle at which the car starts to move
+    uint8_t k = 0;
+    while (speeds[k + 1] == 0)
+        k++;
+    curve->duty[0] = k * 1000 / CALIBRATION_STEPS;
+
+    // [3] Duty cycles of the fractions of the top speed
+    for (uint8_t j = 1; j < MOTOR_CURVE_POINTS; j++) {
+        uint32_t target = topSpeed * j / (MOTOR_CURVE_POINTS - 1);
+        while (speeds[k] < target)
+            k++;
+        uint32_t base = (k - 1) * 1000 / CALIBRATION_STEPS;
+        curve->duty[j] = base + 1000 / CALIBRATION_STEPS * (target - speeds[k - 1]) /
+                                    (speeds[k] - speeds[k - 1]);
+    }
+    return true;
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_finish(bool isSolved)
+ *
+ * DESCRIPTION:
+ *      Ends the sweep or the calibration of the trim:
+ *      [1] Stop the car and release the shared timer, the servo goes back in front
+ *      [2] Store the calibration, if solved
+ *      [3] Apply the calibration in use and notify the result
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          bool    isSolved        True if the calibration has been updated with the result
+ *      GLOBALS:
+ *          CalibrationRecord   calibration
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationRecord   calibration         Validated, if solved
+ *          CalibrationStep     calibrationStep     Set to CALIBRATION_IDLE
+ *
+ *  NOTE:
+ *      The measurement that moves the servo back is ignored.
+ */
+static void Calibration_Module_finish(bool isSolved) {
+    // [1] Car
+    bool isTrim = calibrationStep >= CALIBRATION_TRIM_LEFT;
+    calibrationStep = CALIBRATION_IDLE;
+    Powertrain_Module_stop();
+    TIMER_HAL_releaseSharedTimer();
+    if (isTrim)
+        Sensing_Module_measureDistance(CALIBRATION_DIRECTION);
+
+    // [2] Record
+    if (isSolved) {
+        calibration.magic = CALIBRATION_MAGIC;
+        calibration.checksum = Calibration_Module_checksum(&calibration);
+        Calibration_Module_store();
+    }
+
+    // [3] Result
+    Calibration_Module_apply();
+    Telemetry_Module_notifyCalibrationResult(isSolved);
+}
+
+/*F************************************************************************************************
+ * NAME: bool Calibration_Module_solveCurves()
+ *
+ * DESCRIPTION:
+ *      Solves the curve of the sweep and gives it to both motors.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationRecord   calibration     Curves replaced by the solved one, if any
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the car never moved
+ *
+ *  NOTE:
+ */
+static bool Calibration_Module_solveCurves() {
+    MotorCurve curve;
+    if (!Calibration_Module_solve(&curve))
+        return false;
+    calibration.curves[MOTOR_INIT_LEFT] = curve;
+    calibration.curves[MOTOR_INIT_RIGHT] = curve;
+    calibration.flags |= CALIBRATION_CURVES;
+    return true;
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_run(MotorDirection direction)
+ *
+ * DESCRIPTION:
+ *      Starts a timed run at the duty cycle being measured.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          MotorDirection  direction   Direction of the run
+ *      GLOBALS:
+ *          uint8_t         calibrationIndex
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationStep calibrationStep     Set to the run
+ *
+ *  NOTE:
+ *      Without curve the speed is the duty cycle.
+ */
+static void Calibration_Module_run(MotorDirection direction) {
+    uint8_t speed = (calibrationIndex + 1) * 100 / CALIBRATION_STEPS;
+    calibrationStep =
+        direction == MOTOR_DIR_FORWARD ? CALIBRATION_RUN_FORWARD : CALIBRATION_RUN_REVERSE;
+    MOTOR_HAL_setDirection((Motor *)&powertrain.left_motor, direction);
+    MOTOR_HAL_setDirection((Motor *)&powertrain.right_motor, direction);
+    MOTOR_HAL_setSpeed((Motor *)&powertrain.left_motor, speed);
+    MOTOR_HAL_setSpeed((Motor *)&powertrain.right_motor, speed);
+    TIMER_HAL_acquireSharedTimer(CALIBRATION_RUN, Calibration_Module_onTimerEnded);
+}
+
+/*F************************************************************************************************
+ * NAME: int32_t Calibration_Module_trimWeight(int32_t i)
+ *
+ * DESCRIPTION:
+ *      Returns the weight of a lateral sample in the quadratic term of the least squares fit,
+ *      that is the square of its centred index minus the mean of the squares, scaled by the
+ *      number of samples to stay integer.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     i           Index of the sample, centred in the pass
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int32_t
+ *          Value:  Weight of the sample
+ *
+ *  NOTE:
+ */
+static int32_t Calibration_Module_trimWeight(int32_t i) {
+    const int32_t h = CALIBRATION_TRIM_HALF;
+    return CALIBRATION_TRIM_SAMPLES * i * i - h * (h + 1) * (2 * h + 1) / 3;
+}
+
+/*F************************************************************************************************
+ * NAME: int16_t Calibration_Module_fitDrift()
+ *
+ * DESCRIPTION:
+ *      Solves the drift of the pass from the weighted sum of its samples: the quadratic term of
+ *      the fit is the weighted sum over the sum of the squared weights, times the number of
+ *      samples that scales the weights, the drift is its value at the ends of the pass, signed as
+ *      a curve to the right.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int32_t     trimFit
+ *          int8_t      trimSide
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int16_t
+ *          Value:  Drift to the right (mm), negative to the left
+ *
+ *  NOTE:
+ *      A curve to the right moves the car away from a wall at the left and towards one at the
+ *      right.
+ */
+static int16_t Calibration_Module_fitDrift() {
+    int64_t norm = 0;
+    for (int32_t i = -CALIBRATION_TRIM_HALF; i <= CALIBRATION_TRIM_HALF; i++)
+        norm += (int64_t)Calibration_Module_trimWeight(i) * Calibration_Module_trimWeight(i);
+    int64_t ends = (int64_t)CALIBRATION_TRIM_HALF * CALIBRATION_TRIM_HALF;
+    int16_t drift = (int64_t)trimFit * CALIBRATION_TRIM_SAMPLES * 10 * ends / norm;
+    return trimSide == CALIBRATION_LEFT ? drift : -drift;
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_startPass()
+ *
+ * DESCRIPTION:
+ *      Starts a pass along the wall at the trim to be measured, with its first lateral sample.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint8_t     trimPass
+ *          int16_t[]   trimProbes
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint32_t        trimStart           Set to the current time
+ *          CalibrationStep calibrationStep     Set to CALIBRATION_TRIM_SAMPLE
+ *
+ *  NOTE:
+ */
+static void Calibration_Module_startPass() {
+    Powertrain_Module_setTrim(trimProbes[trimPass]);
+    trimSample = 0;
+    trimFit = 0;
+    Powertrain_Module_moveForward();
+    trimStart = TIMER_HAL_getTicks();
+    calibrationStep = CALIBRATION_TRIM_SAMPLE;
+    Sensing_Module_measureDistance(trimSide);
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_nextPass()
+ *
+ * DESCRIPTION:
+ *      Solves the trim of the next pass from the drifts measured so far:
+ *      [1] After the first pass, the probe is next to it towards the drift
+ *      [2] Then the trim is the zero of the least squares line through the passes, the secant
+ *          after the second one
+ *      [3] After the last pass the trim is stored, otherwise the next pass starts
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint8_t     trimPass
+ *          int16_t[]   trimProbes
+ *          int16_t[]   trimDrifts
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationRecord   calibration     Trim set to the solved one, after the last pass
+ *
+ *  NOTE:
+ *      Passes with the same drift do not give a line, the calibration fails.
+ */
+static void Calibration_Module_nextPass() {
+    int32_t trim = trimProbes[trimPass];
+    int32_t drift = trimDrifts[trimPass];
+    if (trimPass == 0) {
+        // [1] Probe, a drift to the right slows down the left motor
+        trim += drift > 0 ? CALIBRATION_TRIM_PROBE : -CALIBRATION_TRIM_PROBE;
+    } else {
+        // [2] Line, sums scaled by the number of passes to stay integer
+        int32_t n = trimPass + 1, sumTrims = 0, sumDrifts = 0, sumSquares = 0, sumProducts = 0;
+        for (uint8_t i = 0; i <= trimPass; i++) {
+            sumTrims += trimProbes[i];
+            sumDrifts += trimDrifts[i];
+            sumSquares += (int32_t)trimProbes[i] * trimProbes[i];
+            sumProducts += (int32_t)trimProbes[i] * trimDrifts[i];
+        }
+        int32_t covariance = n * sumProducts - sumTrims * sumDrifts;
+        int32_t variance = n * sumSquares - sumTrims * sumTrims;
+        if (covariance == 0) {
+            Calibration_Module_finish(false);
+            return;
+        }
+        trim = (sumTrims - (int64_t)sumDrifts * variance / covariance) / n;
+    }
+    if (trim > POWERTRAIN_MAX_TRIM)
+        trim = POWERTRAIN_MAX_TRIM;
+    else if (trim < -POWERTRAIN_MAX_TRIM)
+        trim = -POWERTRAIN_MAX_TRIM;
+
+    // [3] Result or next pass
+    if (++trimPass == CALIBRATION_TRIM_PASSES) {
+        calibration.trim = trim;
+        calibration.flags |= CALIBRATION_TRIM;
+        Calibration_Module_finish(true);
+    } else {
+        trimProbes[trimPass] = trim;
+        Calibration_Module_startPass();
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_onTimerEnded()
+ *
+ * DESCRIPTION:
+ *      Callback of the shared timer:
+ *      - at the end of a run the car is stopped and left to settle
+ *      - at the end of the settling the distance is measured
+ *      - along the wall, the next lateral sample is taken at the end of the period
+ *      - at the end of the settling after a pass the car runs back for the duration of the pass
+ *      - at the end of the return the car is stopped and left to settle, then the next pass starts
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationStep calibrationStep
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationStep calibrationStep     Set to the next step
+ *
+ *  NOTE:
+ */
+static void Calibration_Module_onTimerEnded() {
+    TIMER_HAL_releaseSharedTimer();
+    switch (calibrationStep) {
+    case CALIBRATION_RUN_FORWARD:
+    case CALIBRATION_RUN_REVERSE:
+        Powertrain_Module_stop();
+        calibrationStep++;
+        TIMER_HAL_acquireSharedTimer(CALIBRATION_SETTLE, Calibration_Module_onTimerEnded);
+        break;
+    case CALIBRATION_SETTLE_FORWARD:
+    case CALIBRATION_SETTLE_REVERSE:
+        calibrationStep++;
+        Sensing_Module_measureDistance(CALIBRATION_DIRECTION);
+        break;
+    case CALIBRATION_TRIM_RUN:
+        calibrationStep = CALIBRATION_TRIM_SAMPLE;
+        Sensing_Module_measureDistance(trimSide);
+        break;
+    case CALIBRATION_TRIM_SETTLE:
+        calibrationStep = CALIBRATION_TRIM_RETURN;
+        MOTOR_HAL_setDirection((Motor *)&powertrain.left_motor, MOTOR_DIR_REVERSE);
+        MOTOR_HAL_setDirection((Motor *)&powertrain.right_motor, MOTOR_DIR_REVERSE);
+        MOTOR_HAL_setSpeed((Motor *)&powertrain.left_motor, parameters.forwardSpeed);
+        MOTOR_HAL_setSpeed((Motor *)&powertrain.right_motor, parameters.forwardSpeed);
+        TIMER_HAL_acquireSharedTimer(trimDuration, Calibration_Module_onTimerEnded);
+        break;
+    case CALIBRATION_TRIM_RETURN:
+        Powertrain_Module_stop();
+        calibrationStep = CALIBRATION_TRIM_REST;
+        TIMER_HAL_acquireSharedTimer(CALIBRATION_SETTLE, Calibration_Module_onTimerEnded);
+        break;
+    case CALIBRATION_TRIM_REST:
+        Calibration_Module_nextPass();
+        break;
+    default:
+        break;
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_onDistance(uint16_t distance)
+ *
+ * DESCRIPTION:
+ *      Callback of the distance measurements:
+ *      [1] Before the first run, the clearance is checked
+ *      [2] After the forward run, the car runs back
+ *      [3] After the backward run, the speed is the distance covered by the two runs over their
+ *          duration, then the next duty cycle is run or the sweep ends
+ *      [4] Before the trim, the closer wall at the sides is followed, if in range
+ *      [5] Along the wall, the sample is added to the fit and the next one is timed, after the
+ *          last one the car is stopped and the drift of the pass is solved
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    distance    Distance of the wall in front, or at the side (cm)
+ *      GLOBALS:
+ *          CalibrationStep calibrationStep
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t[]  calibrationSpeeds   Set to the speed of the measured duty cycle
+ *          int16_t[]   trimDrifts          Set to the drift of the pass
+ *
+ *  NOTE:
+ *      The clearance is checked again before each forward run, a sweep that drifted towards the
+ *      wall is aborted. A pass that gets too close to the wall, or loses it, is aborted.
+ */
+static void Calibration_Module_onDistance(uint16_t distance) {
+    switch (calibrationStep) {
+    case CALIBRATION_MEASURE_START:
+        // [1] Clearance
+        calibrationStart = distance;
+        if (distance < CALIBRATION_MIN_DISTANCE)
+            Calibration_Module_finish(false);
+        else
+            Calibration_Module_run(MOTOR_DIR_FORWARD);
+        break;
+    case CALIBRATION_MEASURE_FORWARD:
+        // [2] Back
+        calibrationMiddle = distance;
+        Calibration_Module_run(MOTOR_DIR_REVERSE);
+        break;
+    case CALIBRATION_MEASURE_REVERSE: {
+        // [3] Speed, mm over 2 runs of CALIBRATION_RUN ticks
+        int32_t travel = (int32_t)calibrationStart - calibrationMiddle;
+        travel += (int32_t)distance - calibrationMiddle;
+        if (travel < 0)
+            travel = 0;
+        uint16_t speed = travel * 10 * 100000 / (2 * CALIBRATION_RUN);
+        calibrationSpeeds[calibrationIndex] = speed;
+        Telemetry_Module_notifyCalibrationPoint((calibrationIndex + 1) * 1000 / CALIBRATION_STEPS,
+                                                speed);
+
+        calibrationStart = distance;
+        if (++calibrationIndex == CALIBRATION_STEPS)
+            Calibration_Module_finish(Calibration_Module_solveCurves());
+        else if (distance < CALIBRATION_MIN_DISTANCE)
+            Calibration_Module_finish(false);
+        else
+            Calibration_Module_run(MOTOR_DIR_FORWARD);
+        break;
+    }
+    case CALIBRATION_TRIM_LEFT:
+        // [4] Wall
+        calibrationStart = distance;
+        calibrationStep = CALIBRATION_TRIM_RIGHT;
+        Sensing_Module_measureDistance(CALIBRATION_RIGHT);
+        break;
+    case CALIBRATION_TRIM_RIGHT:
+        trimSide = distance < calibrationStart ? CALIBRATION_RIGHT : CALIBRATION_LEFT;
+        if (distance > calibrationStart)
+            distance = calibrationStart;
+        if (distance < CALIBRATION_TRIM_MIN_DISTANCE || distance > CALIBRATION_TRIM_MAX_DISTANCE) {
+            Calibration_Module_finish(false);
+            break;
+        }
+        trimPass = 0;
+        trimProbes[0] = Powertrain_Module_getTrim();
+        Calibration_Module_startPass();
+        break;
+    case CALIBRATION_TRIM_SAMPLE:
+        // [5] Fit
+        if (distance < CALIBRATION_TRIM_MIN_DISTANCE || distance > CALIBRATION_TRIM_LOST) {
+            Calibration_Module_finish(false);
+            break;
+        }
+        trimFit += Calibration_Module_trimWeight(trimSample - CALIBRATION_TRIM_HALF) * distance;
+        if (++trimSample < CALIBRATION_TRIM_SAMPLES) {
+            calibrationStep = CALIBRATION_TRIM_RUN;
+            TIMER_HAL_acquireSharedTimer(CALIBRATION_TRIM_PERIOD, Calibration_Module_onTimerEnded);
+            break;
+        }
+        trimDuration = TIMER_HAL_getTicks() - trimStart;
+        Powertrain_Module_stop();
+        trimDrifts[trimPass] = Calibration_Module_fitDrift();
+        Telemetry_Module_notifyTrimPass(trimProbes[trimPass], trimDrifts[trimPass]);
+        calibrationStep = CALIBRATION_TRIM_SETTLE;
+        TIMER_HAL_acquireSharedTimer(CALIBRATION_SETTLE, Calibration_Module_onTimerEnded);
+        break;
+    default:
+        break;
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_init()
+ *
+ * DESCRIPTION:
+ *      [1] Loads the stored record, if its magic and checksum are valid
+ *      [2] Applies its curves and its trim to the motors
+ *      [3] No calibration is running
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationRecord   calibration         Set to the stored record, invalid if none
+ *          CalibrationStep     calibrationStep     Set to CALIBRATION_IDLE
+ *
+ *  NOTE:
+ */
+void Calibration_Module_init() {
+    // [1] Stored record
+    calibration = *CALIBRATION_STORED;
+    if (calibration.magic != CALIBRATION_MAGIC ||
+        calibration.checksum != Calibration_Module_checksum(&calibration))
+        memset(&calibration, 0, sizeof(calibration));
+
+    // [2] Curves and trim
+    Calibration_Module_apply();
+
+    // [3] Idle
+    calibrationStep = CALIBRATION_IDLE;
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_startSweep()
+ *
+ * DESCRIPTION:
+ *      [1] Stops the car and removes the curves and the trim, the sweep measures the raw duty
+ *          cycles
+ *      [2] Measures the distance before the first run, the measurements are taken over from the
+ *          other modules
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationStep     calibrationStep     Set to CALIBRATION_MEASURE_START
+ *
+ *  NOTE:
+ *      Nothing is done if a sweep is already running.
+ */
+void Calibration_Module_startSweep() {
+    if (calibrationStep != CALIBRATION_IDLE)
+        return;
+
+    // [1] Raw duty cycles
+    Powertrain_Module_stop();
+    MOTOR_HAL_setCurve((Motor *)&powertrain.left_motor, NULL);
+    MOTOR_HAL_setCurve((Motor *)&powertrain.right_motor, NULL);
+    MOTOR_HAL_setTrim((Motor *)&powertrain.left_motor, MOTOR_TRIM_NONE);
+    MOTOR_HAL_setTrim((Motor *)&powertrain.right_motor, MOTOR_TRIM_NONE);
+
+    // [2] First measurement
+    calibrationIndex = 0;
+    calibrationStep = CALIBRATION_MEASURE_START;
+    Sensing_Module_registerDistanceCallback(Calibration_Module_onDistance);
+    Sensing_Module_measureDistance(CALIBRATION_DIRECTION);
+}
+
+/*F************************************************************************************************
+ * NAME: void Calibration_Module_startTrim()
+ *
+ * DESCRIPTION:
+ *      [1] Stops the car, the passes start from the trim in use
+ *      [2] Measures the distance of the walls at the sides, left first, the measurements are
+ *          taken over from the other modules
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CalibrationStep     calibrationStep     Set to CALIBRATION_TRIM_LEFT
+ *
+ *  NOTE:
+ *      Nothing is done if a calibration is already running.
+ */
+void Calibration_Module_startTrim() {
+    if (calibrationStep != CALIBRATION_IDLE)
+        return;
+
+    // [1] Car
+    Powertrain_Module_stop();
+
+    // [2] Walls
+    calibrationStep = CALIBRATION_TRIM_LEFT;
+    Sensing_Module_registerDistanceCallback(Calibration_Module_onDistance);
+    Sensing_Module_measureDistance(CALIBRATION_LEFT);
+}
+
+void Calibration_Module_abort() {
+    if (calibrationStep != CALIBRATION_IDLE)
+        Calibration_Module_finish(false);
+}
+
+bool Calibration_Module_isRunning() { return calibrationStep != CALIBRATION_IDLE; }
+
+void Calibration_Module_clear() {
+    Calibration_Module_abort();
+    memset(&calibration, 0, sizeof(calibration));
+    Calibration_Module_store();
+    Calibration_Module_apply();
+}
@@ -0,0 +1,1018 @@
+/*H************************************************************************************************
+ * FILENAME:        exploration_module.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the frontier based exploration: the scans of the surroundings
+ *      into the occupancy grid, the search of the nearest reachable frontier and the movements
+ *      towards it, and the driving to a goal along the paths planned on the same grid.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    Exploration_Module_init()
+ *      void    Exploration_Module_start()
+ *      void    Exploration_Module_goTo(int32_t x, int32_t y)
+ *      void    Exploration_Module_abort()
+ *      void    Exploration_Module_forgetMap()
+ *      bool    Exploration_Module_isRunning()
+ *
+ * NOTES:
+ *      The exploration is driven by the shared timer, the echoes of the sweep and the distance
+ *      measurements, as a sequence of steps like the calibration: scan, turn, move, each followed
+ *      by a settling of the car or of the servo.
+ *      The path is searched breadth first over the free cells, in the eight directions, away
+ *      from the occupied cells by EXPLORATION_CLEARANCE cells. The car drives to the farthest of
+ *      the next EXPLORATION_LOOKAHEAD cells of the path that it sees in a straight line, then
+ *      scans again: the map ahead is refined before the car gets there.
+ *      A frontier that is still there once reached, e.g. an unknown cell behind a thin obstacle,
+ *      is ignored by the next searches, so that the car does not go back and forth.
+ *      Driving to a goal runs the same cycle, the path is planned by A* (see planner.h).
+ *      Both the searches run in slices of EXPLORATION_PLAN_BUDGET cells per tick of the shared
+ *      timer, and work out the clearance of a cell the first time they reach it: the callbacks
+ *      run in interrupt context and a whole search over the grid would hold the other
+ *      interrupts back.
+ *      The turns are timed without feedback: every turn is followed by a scan, matched with the
+ *      one taken before it (see scanmatch.h) to correct the heading by the rotation actually
+ *      made, and by up to EXPLORATION_PIVOTS corrective turns towards the point to reach. The
+ *      longer turns are split, so that the two scans share most of their field of view.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 19 Oct 2026  Maintainers     Added the driving to a goal along the paths planned by A*
+ * 19 Oct 2026  Maintainers     Added the correction of the heading by scan matching after turns
+ * 19 Oct 2026  Maintainers     Directions and line of sight taken from the grid
+ * 19 Oct 2026  Maintainers     Search of the frontier in slices, clearance of the cells on demand
+ * 19 Oct 2026  Maintainers     Map forgotten on abort, the pose may be out of date
+ */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../inc/exploration_module.h"
+#include "../../inc/grid.h"
+#include "../../inc/odometry_module.h"
+#include "../../inc/parameters.h"
+#include "../../inc/planner.h"
+#include "../../inc/powertrain_module.h"
+#include "../../inc/scanmatch.h"
+#include "../../inc/sensing_module.h"
+#include "../../inc/telemetry_module.h"
+
+#ifdef TEST
+#include "../../tests/timer_hal.h"
+#include "../../tests/ultrasonic_hal.h"
+#else
+#include "../../inc/timer_hal.h"
+#include "../../inc/ultrasonic_hal.h"
+#endif
+
+#define EXPLORATION_SCAN_STEP 5       /* Degrees travelled by the servo per echo of a scan     */
+#define EXPLORATION_SETTLE 40000      /* Wait for the car or the servo to stop in ticks (0.4s) */
+#define EXPLORATION_MAX_RANGE 1500    /* Farthest echo accounted in the grid (mm)              */
+#define EXPLORATION_SENSOR_OFFSET 80  /* Distance of the sensor in front of the centre (mm)    */
+#define EXPLORATION_BEAM 10           /* Half angle of the cone cleared by an echo (deg)       */
+#define EXPLORATION_BEAM_STEP 5       /* Angle between the rays across the cone (deg)          */
+#define EXPLORATION_CLEARANCE 2       /* Cells kept between the path and the occupied ones     */
+#define EXPLORATION_LOOKAHEAD 5       /* Cells of the path considered for a straight movement  */
+#define EXPLORATION_MIN_TURN 5        /* Smallest rotation worth a turn (deg)                  */
+#define EXPLORATION_MIN_MOVE 50       /* Shortest movement worth a run (mm)                    */
+#define EXPLORATION_SPEED 150         /* Initial estimate of the speed (mm per 100000 ticks)   */
+#define EXPLORATION_MAX_CYCLES 200    /* Scans after which the exploration gives up            */
+#define EXPLORATION_IGNORED 16        /* Frontiers that can be ignored                         */
+#define EXPLORATION_QUEUE 1024        /* Cells waiting in the breadth first search             */
+#define EXPLORATION_PLAN_TICK 100     /* Period of the slices of the planning in ticks (1ms)   */
+#define EXPLORATION_PLAN_BUDGET 32    /* Cells expanded by the searches per slice              */
+#define EXPLORATION_MAX_TURN 45       /* Longest turn, the scans around it overlap by 3/4      */
+#define EXPLORATION_MATCH_WINDOW 10   /* Error of a turn searched by the scans (deg), plus...  */
+#define EXPLORATION_MATCH_SLIP 3      /* ...the turn over this                                 */
+#define EXPLORATION_MATCH_NOISE 2     /* Error of the scans (deg), plus...                     */
+#define EXPLORATION_MATCH_SCALE 10    /* ...the turn over this                                 */
+#define EXPLORATION_PIVOTS 1          /* Corrective turns after a turn, 0 for none             */
+#define EXPLORATION_BLOCKED 0x80      /* Mark of a cell too close to an occupied one           */
+#define EXPLORATION_VISITED 0x40      /* Mark of a cell reached by the search                  */
+#define EXPLORATION_CHECKED 0x20      /* Mark of a cell whose clearance has been worked out    */
+#define EXPLORATION_PARENT 0x07       /* Direction of the previous cell of the path            */
+
+/*T************************************************************************************************
+ * NAME: ExplorationStep
+ *
+ * DESCRIPTION:
+ *      Represent the step of the exploration in progress.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: EXPLORATION_IDLE            No exploration in progress
+ *              EXPLORATION_SCAN            Sweeping the sensor into the grid
+ *              EXPLORATION_SETTLE_SCAN     Waiting for the servo to get back in front
+ *              EXPLORATION_PLAN            Searching the frontier or planning the path to the
+ *                                          goal, a slice per tick
+ *              EXPLORATION_TURN            Turning towards the next cell of the path
+ *              EXPLORATION_SETTLE_TURN     Waiting for the car to stop after the turn
+ *              EXPLORATION_CHECK           Sweeping the sensor to match the scan before the turn
+ *              EXPLORATION_SETTLE_CHECK    Waiting for the servo to get back in front
+ *              EXPLORATION_MEASURE_START   Measuring the distance in front before the movement
+ *              EXPLORATION_MOVE            Running forward
+ *              EXPLORATION_SETTLE_MOVE     Waiting for the car to stop after the movement
+ *              EXPLORATION_MEASURE_END     Measuring the distance in front after the movement
+ */
+typedef enum {
+    EXPLORATION_IDLE,
+    EXPLORATION_SCAN,
+    EXPLORATION_SETTLE_SCAN,
+    EXPLORATION_PLAN,
+    EXPLORATION_TURN,
+    EXPLORATION_SETTLE_TURN,
+    EXPLORATION_CHECK,
+    EXPLORATION_SETTLE_CHECK,
+    EXPLORATION_MEASURE_START,
+    EXPLORATION_MOVE,
+    EXPLORATION_SETTLE_MOVE,
+    EXPLORATION_MEASURE_END,
+} ExplorationStep;
+
+volatile ExplorationStep explorationStep; /* Step of the exploration in progress               */
+uint8_t explorationCycles;                /* Scans since the start                             */
+bool isScanLeftSeen;                      /* The scan reached the left extreme                 */
+bool isScanRightSeen;                     /* The scan reached the right extreme                */
+int16_t explorationTargetX;               /* Cell of the frontier being reached                */
+int16_t explorationTargetY;
+bool isTargetFinal;                       /* The movement in progress ends on the frontier     */
+uint8_t explorationIgnored;               /* Frontiers ignored so far                          */
+int16_t ignoredX[EXPLORATION_IGNORED];    /* Cells of the ignored frontiers                    */
+int16_t ignoredY[EXPLORATION_IGNORED];
+int32_t explorationMove;                  /* Planned length of the movement (mm)               */
+uint32_t explorationRun;                  /* Duration of the movement (ticks)                  */
+uint16_t explorationStart;                /* Distance in front before the movement (cm)        */
+uint32_t explorationSpeed;                /* Estimated speed (mm per 100000 ticks)             */
+bool isMapped;                            /* The grid and the pose come from a previous run    */
+bool isGoal;                              /* Driving to a goal instead of exploring            */
+int32_t goalX;                            /* Goal (mm)                                         */
+int32_t goalY;
+int16_t goalCellX;                        /* Cell of the goal                                  */
+int16_t goalCellY;
+uint8_t pathClearance;                    /* Clearance of the path being searched (cells)      */
+int32_t driveX;                           /* Point being reached (mm)                          */
+int32_t driveY;
+int32_t driveLimit;                       /* Longest movement towards it (mm)                  */
+int16_t driveTurn;                        /* Commanded turn towards it (deg)                   */
+uint8_t drivePivots;                      /* Corrective turns made towards it                  */
+bool isTurnSplit;                         /* The turn stops short of the bearing of the point  */
+ScanProfile explorationProfile;           /* Scan at the position of the car, before the turn  */
+ScanProfile checkProfile;                 /* Scan after the turn                               */
+static uint8_t explorationMarks[GRID_SIZE][GRID_SIZE]; /* Marks of the search, by row and column */
+static uint16_t explorationQueue[EXPLORATION_QUEUE];   /* Ring of the cells to expand, y * 64 + x */
+static uint16_t explorationHead;                       /* Next cell of the ring to expand        */
+static uint16_t explorationTail;                       /* Next free entry of the ring            */
+static int16_t searchStartX;                           /* Cell of the car at the search start    */
+static int16_t searchStartY;
+
+/* Utility function declaration */
+static void Exploration_Module_onTimerEnded();
+static void Exploration_Module_onDistance(uint16_t distance);
+static void Exploration_Module_onSweepEcho(int8_t angle, uint16_t distance);
+
+static int16_t Exploration_Module_wrap(int16_t angle) {
+    angle %= 360;
+    if (angle > 180)
+        angle -= 360;
+    if (angle <= -180)
+        angle += 360;
+    return angle;
+}
+
+static void Exploration_Module_project(int32_t *x, int32_t *y, int32_t distance,
+                                       int16_t direction) {
+    *x += distance * Odometry_Module_cos(direction) / ODOMETRY_ONE;
+    *y += distance * Odometry_Module_sin(direction) / ODOMETRY_ONE;
+}
+
+static bool Exploration_Module_isClear(int16_t cx, int16_t cy, int16_t clearance) {
+    for (int16_t dy = -clearance; dy <= clearance; dy++)
+        for (int16_t dx = -clearance; dx <= clearance; dx++)
+            if (GRID_getCell(cx + dx, cy + dy) == GRID_OCCUPIED)
+                return false;
+    return true;
+}
+
+static bool Exploration_Module_isPassable(int16_t cx, int16_t cy) {
+    if (GRID_getCell(cx, cy) != GRID_FREE)
+        return false;
+    uint8_t *marks = &explorationMarks[cy][cx];
+    if (!(*marks & EXPLORATION_CHECKED)) {
+        *marks |= EXPLORATION_CHECKED;
+        if (!Exploration_Module_isClear(cx, cy, pathClearance))
+            *marks |= EXPLORATION_BLOCKED;
+    }
+    return !(*marks & EXPLORATION_BLOCKED);
+}
+
+static bool Exploration_Module_isIgnored(int16_t cx, int16_t cy) {
+    for (uint8_t i = 0; i < explorationIgnored; i++)
+        if (ignoredX[i] == cx && ignoredY[i] == cy)
+            return true;
+    return false;
+}
+
+static void Exploration_Module_ignore(int16_t cx, int16_t cy) {
+    if (explorationIgnored < EXPLORATION_IGNORED && !Exploration_Module_isIgnored(cx, cy)) {
+        ignoredX[explorationIgnored] = cx;
+        ignoredY[explorationIgnored] = cy;
+        explorationIgnored++;
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_markEcho(int8_t angle, uint16_t distance)
+ *
+ * DESCRIPTION:
+ *      Accounts an echo in the grid, from the position of the sensor in front of the car:
+ *      [1] Nothing in the cone of the sensor is closer than the echo, the rays across the cone
+ *          clear the cells up to half a cell before it
+ *      [2] The cell of the echo is on the axis of the cone, an echo out of range clears the
+ *          cells up to the range
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t      angle       Position of the servo (deg)
+ *          uint16_t    distance    Distance of the echo (cm), US_RESULT_NO_OBJECT if none
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The sound is reflected anywhere in the cone, so that an obstacle at its edge leaves an
+ *      occupied cell on its axis: the rays across the cone of the next echoes, that miss the
+ *      obstacle, clear it.
+ */
+static void Exploration_Module_markEcho(int8_t angle, uint16_t distance) {
+    OdometryPose pose = Odometry_Module_getPose();
+    int32_t x = pose.x;
+    int32_t y = pose.y;
+    Exploration_Module_project(&x, &y, EXPLORATION_SENSOR_OFFSET, pose.heading);
+    bool isHit = distance != US_RESULT_NO_OBJECT && distance * 10 <= EXPLORATION_MAX_RANGE;
+    int32_t range = isHit ? distance * 10 : EXPLORATION_MAX_RANGE;
+
+    // [1] Cone
+    int32_t clear = isHit ? range - GRID_CELL / 2 : range;
+    for (int16_t side = -EXPLORATION_BEAM; side <= EXPLORATION_BEAM && clear > 0;
+         side += EXPLORATION_BEAM_STEP) {
+        int32_t endX = x;
+        int32_t endY = y;
+        Exploration_Module_project(&endX, &endY, clear, pose.heading + angle + side);
+        if (side != 0)
+            GRID_markRay(x, y, endX, endY, false);
+    }
+
+    // [2] Axis
+    int32_t endX = x;
+    int32_t endY = y;
+    Exploration_Module_project(&endX, &endY, range, pose.heading + angle);
+    GRID_markRay(x, y, endX, endY, isHit);
+}
+
+static void Exploration_Module_addEcho(ScanProfile *profile, int8_t angle, uint16_t distance) {
+    // Echo from the centre of the car, the missing ones out of the range of the profile
+    int32_t range = distance > SCANMATCH_MAX_RANGE ? SCANMATCH_MAX_RANGE * 10 : distance * 10;
+    int32_t x = EXPLORATION_SENSOR_OFFSET + range * Odometry_Module_cos(angle) / ODOMETRY_ONE;
+    int32_t y = range * Odometry_Module_sin(angle) / ODOMETRY_ONE;
+    int16_t bearing = Exploration_Module_wrap(Odometry_Module_bearing(x, y));
+    range = (x * Odometry_Module_cos(bearing) + y * Odometry_Module_sin(bearing)) / ODOMETRY_ONE;
+    SCANMATCH_add(profile, bearing, (range + 5) / 10);
+}
+
+static void Exploration_Module_startSearch(int16_t startX, int16_t startY) {
+    // The cell of the car is passable even if blocked or unknown
+    memset(explorationMarks, 0, sizeof(explorationMarks));
+    searchStartX = startX;
+    searchStartY = startY;
+    explorationHead = 0;
+    explorationTail = 0;
+    explorationMarks[startY][startX] |= EXPLORATION_VISITED;
+    explorationQueue[explorationTail++ % EXPLORATION_QUEUE] = startY * GRID_SIZE + startX;
+}
+
+/*F************************************************************************************************
+ * NAME: PlannerStatus Exploration_Module_search(uint16_t budget)
+ *
+ * DESCRIPTION:
+ *      Goes on with the breadth first search of the nearest frontier reachable from the cell of
+ *      the car, until the budget runs out:
+ *      [1] The search fails once the queue is empty
+ *      [2] Stop at the first frontier that is not the cell of the car and is not ignored
+ *      [3] Expand the cells in the eight directions, a diagonal step needs both the orthogonal
+ *          cells passable so that the path does not cut the corners of the obstacles
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    budget      Cells that can be expanded by this call
+ *      GLOBALS:
+ *          uint16_t[]  explorationQueue    Cells to expand
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint8_t[][] explorationMarks    Visited cells, with the direction of their parent
+ *          int16_t     explorationTargetX  Cell of the frontier, if found
+ *          int16_t     explorationTargetY
+ *      RETURN:
+ *          Type:   PlannerStatus
+ *          Value:  PLANNER_SEARCHING if the budget ran out, PLANNER_FOUND if a frontier is
+ *                  reachable, PLANNER_FAILED otherwise
+ *
+ *  NOTE:
+ *      A cell that does not fit in the queue is left unvisited, the search is shorter but still
+ *      consistent.
+ */
+static PlannerStatus Exploration_Module_search(uint16_t budget) {
+    for (; budget > 0; budget--) {
+        // [1] Queue
+        if (explorationHead == explorationTail)
+            return PLANNER_FAILED;
+        uint16_t cell = explorationQueue[explorationHead++ % EXPLORATION_QUEUE];
+        int16_t cx = cell % GRID_SIZE;
+        int16_t cy = cell / GRID_SIZE;
+
+        // [2] Frontier
+        if ((cx != searchStartX || cy != searchStartY) && GRID_isFrontier(cx, cy) &&
+            !Exploration_Module_isIgnored(cx, cy)) {
+            explorationTargetX = cx;
+            explorationTargetY = cy;
+            return PLANNER_FOUND;
+        }
+
+        // [3] Neighbours
+        for (uint8_t d = 0; d < GRID_DIRECTIONS; d++) {
+            int16_t nx = cx + gridDx[d];
+            int16_t ny = cy + gridDy[d];
+            if (!Exploration_Module_isPassable(nx, ny) ||
+                explorationMarks[ny][nx] & EXPLORATION_VISITED)
+                continue;
+            if (d >= 4 && (!Exploration_Module_isPassable(nx, cy) ||
+                           !Exploration_Module_isPassable(cx, ny)))
+                continue;
+            if ((uint16_t)(explorationTail - explorationHead) >= EXPLORATION_QUEUE)
+                continue;
+            explorationMarks[ny][nx] |= EXPLORATION_VISITED | d;
+            explorationQueue[explorationTail++ % EXPLORATION_QUEUE] = ny * GRID_SIZE + nx;
+        }
+    }
+    return PLANNER_SEARCHING;
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_finish()
+ *
+ * DESCRIPTION:
+ *      Ends the exploration: the sweep is stopped, the car is stopped, the shared timer is
+ *      released and the coverage reached is notified.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          ExplorationStep explorationStep     Set to EXPLORATION_IDLE
+ *
+ *  NOTE:
+ */
+static void Exploration_Module_finish() {
+    explorationStep = EXPLORATION_IDLE;
+    Sensing_Module_stopSweep();
+    Powertrain_Module_stop();
+    TIMER_HAL_releaseSharedTimer();
+    OdometryPose pose = Odometry_Module_getPose();
+    Telemetry_Module_notifyExploration(GRID_getCoverage(), &pose, true);
+}
+
+static void Exploration_Module_scan() {
+    // The cells under the car are free, from its back to the sensor
+    OdometryPose pose = Odometry_Module_getPose();
+    int32_t backX = pose.x;
+    int32_t backY = pose.y;
+    int32_t frontX = pose.x;
+    int32_t frontY = pose.y;
+    Exploration_Module_project(&backX, &backY, -EXPLORATION_SENSOR_OFFSET, pose.heading);
+    Exploration_Module_project(&frontX, &frontY, EXPLORATION_SENSOR_OFFSET, pose.heading);
+    GRID_markRay(backX, backY, frontX, frontY, false);
+
+    explorationStep = EXPLORATION_SCAN;
+    isScanLeftSeen = false;
+    isScanRightSeen = false;
+    SCANMATCH_clear(&explorationProfile);
+    Sensing_Module_startSweep(EXPLORATION_SCAN_STEP, Exploration_Module_onSweepEcho);
+}
+
+static void Exploration_Module_check() {
+    explorationStep = EXPLORATION_CHECK;
+    isScanLeftSeen = false;
+    isScanRightSeen = false;
+    SCANMATCH_clear(&checkProfile);
+    Sensing_Module_startSweep(EXPLORATION_SCAN_STEP, Exploration_Module_onSweepEcho);
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_drive(int32_t x, int32_t y, int32_t limit)
+ *
+ * DESCRIPTION:
+ *      Starts the movement to a point:
+ *      [1] The movement is the projection of the point on its bearing, at most the limit
+ *      [2] Turn towards it, at most EXPLORATION_MAX_TURN at once, or measure the distance in
+ *          front if already aligned
+ *
+ *      The point is kept for the rest of a split turn and for the corrective turns.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     x           Point to reach (mm)
+ *          int32_t     y
+ *          int32_t     limit       Longest movement (mm)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int32_t         explorationMove     Set to the length of the movement
+ *          ExplorationStep explorationStep     Set to the next step
+ *          int16_t         driveTurn           Set to the turn, if any
+ *          bool            isTurnSplit         Set if the turn stops short of the bearing
+ *
+ *  NOTE:
+ */
+static void Exploration_Module_drive(int32_t x, int32_t y, int32_t limit) {
+    // [1] Movement
+    driveX = x;
+    driveY = y;
+    driveLimit = limit;
+    OdometryPose pose = Odometry_Module_getPose();
+    int16_t bearing = Odometry_Module_bearing(x - pose.x, y - pose.y);
+    explorationMove = ((x - pose.x) * Odometry_Module_cos(bearing) +
+                       (y - pose.y) * Odometry_Module_sin(bearing)) /
+                      ODOMETRY_ONE;
+    if (explorationMove > limit)
+        explorationMove = limit;
+
+    // [2] Turn, timed by this module in place of the powertrain, short enough to be matched
+    int16_t turn = Exploration_Module_wrap(bearing - pose.heading);
+    if (abs(turn) < EXPLORATION_MIN_TURN) {
+        explorationStep = EXPLORATION_MEASURE_START;
+        Sensing_Module_measureDistance(0);
+        return;
+    }
+    isTurnSplit = abs(turn) > EXPLORATION_MAX_TURN;
+    if (isTurnSplit)
+        turn = turn > 0 ? EXPLORATION_MAX_TURN : -EXPLORATION_MAX_TURN;
+    explorationStep = EXPLORATION_TURN;
+    driveTurn = turn;
+    if (turn > 0)
+        Powertrain_Module_turnLeft(turn);
+    else
+        Powertrain_Module_turnRight(-turn);
+    TIMER_HAL_acquireSharedTimer(Powertrain_Module_getTurnTime(abs(turn)),
+                                 Exploration_Module_onTimerEnded);
+    Odometry_Module_rotate(turn);
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_plan()
+ *
+ * DESCRIPTION:
+ *      Starts the search of the next movement after a scan:
+ *      [1] Give up after EXPLORATION_MAX_CYCLES scans, ignore the frontier reached if still there
+ *      [2] Driving to a goal, the run ends within a cell from it
+ *      [3] The path keeps away from the obstacles, less if the car is among them
+ *      [4] Start the planning of the path to the goal, or the search of the nearest frontier,
+ *          the first slice at the next tick of the shared timer
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint8_t         pathClearance       Clearance of the search
+ *          ExplorationStep explorationStep     Set to EXPLORATION_PLAN
+ *
+ *  NOTE:
+ */
+static void Exploration_Module_plan() {
+    // [1] Progress
+    if (++explorationCycles > EXPLORATION_MAX_CYCLES) {
+        Exploration_Module_finish();
+        return;
+    }
+    if (isTargetFinal && GRID_isFrontier(explorationTargetX, explorationTargetY))
+        Exploration_Module_ignore(explorationTargetX, explorationTargetY);
+    isTargetFinal = false;
+
+    OdometryPose pose = Odometry_Module_getPose();
+    int16_t startX, startY;
+    if (!GRID_toCell(pose.x, pose.y, &startX, &startY)) {
+        Exploration_Module_finish();
+        return;
+    }
+
+    // [2] Goal
+    if (isGoal && abs(goalX - pose.x) <= GRID_CELL && abs(goalY - pose.y) <= GRID_CELL) {
+        Exploration_Module_finish();
+        return;
+    }
+
+    // [3] Clearance
+    pathClearance = Exploration_Module_isClear(startX, startY, EXPLORATION_CLEARANCE)
+                        ? EXPLORATION_CLEARANCE
+                        : EXPLORATION_CLEARANCE - 1;
+
+    // [4] Search
+    if (isGoal)
+        PLANNER_start(startX, startY, goalCellX, goalCellY, pathClearance);
+    else
+        Exploration_Module_startSearch(startX, startY);
+    explorationStep = EXPLORATION_PLAN;
+    TIMER_HAL_acquireSharedTimer(EXPLORATION_PLAN_TICK, Exploration_Module_onTimerEnded);
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_approach()
+ *
+ * DESCRIPTION:
+ *      Goes on with the search of the nearest frontier, at every tick of the shared timer:
+ *      [1] Expand a slice of cells, the next one at the next tick
+ *      [2] The exploration ends if no frontier is reachable
+ *      [3] Walk the path back from the frontier, keeping its first EXPLORATION_LOOKAHEAD cells
+ *      [4] Drive to the farthest of them seen in a straight line from the car
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int16_t     explorationTargetX  Cell of the frontier found
+ *          int16_t     explorationTargetY
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          ExplorationStep explorationStep     Set to the next step
+ *
+ *  NOTE:
+ *      The first cell of the path is the cell of the car, that is at least one cell away from
+ *      the frontier.
+ */
+static void Exploration_Module_approach() {
+    // [1] Slice
+    PlannerStatus status = Exploration_Module_search(EXPLORATION_PLAN_BUDGET);
+    if (status == PLANNER_SEARCHING) {
+        TIMER_HAL_acquireSharedTimer(EXPLORATION_PLAN_TICK, Exploration_Module_onTimerEnded);
+        return;
+    }
+
+    // [2] No frontier
+    if (status != PLANNER_FOUND) {
+        Exploration_Module_finish();
+        return;
+    }
+
+    // [3] First cells of the path, window[0] is the closest to the car
+    int16_t windowX[EXPLORATION_LOOKAHEAD];
+    int16_t windowY[EXPLORATION_LOOKAHEAD];
+    uint8_t length = 0;
+    int16_t cx = explorationTargetX;
+    int16_t cy = explorationTargetY;
+    while (cx != searchStartX || cy != searchStartY) {
+        if (length < EXPLORATION_LOOKAHEAD)
+            length++;
+        memmove(&windowX[1], &windowX[0], (length - 1) * sizeof(windowX[0]));
+        memmove(&windowY[1], &windowY[0], (length - 1) * sizeof(windowY[0]));
+        windowX[0] = cx;
+        windowY[0] = cy;
+        uint8_t d = explorationMarks[cy][cx] & EXPLORATION_PARENT;
+        cx -= gridDx[d];
+        cy -= gridDy[d];
+    }
+
+    // [4] Farthest cell in sight, the next one of the path at least
+    uint8_t k = length - 1;
+    while (k > 0 && !GRID_isVisible(searchStartX, searchStartY, windowX[k], windowY[k],
+                                    Exploration_Module_isPassable))
+        k--;
+    isTargetFinal = windowX[k] == explorationTargetX && windowY[k] == explorationTargetY;
+    int32_t x, y;
+    GRID_toPoint(windowX[k], windowY[k], &x, &y);
+    drivePivots = 0;
+    Exploration_Module_drive(x, y, INT32_MAX);
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_follow()
+ *
+ * DESCRIPTION:
+ *      Goes on with the planning of the path to the goal, at every tick of the shared timer:
+ *      [1] Expand a slice of cells, the next one at the next tick
+ *      [2] A goal not reachable with the clearance is planned again closer to the obstacles,
+ *          the run ends if it is not reachable at all
+ *      [3] Drive towards the first waypoint, at most EXPLORATION_LOOKAHEAD cells before the next
+ *          scan, and to the goal itself once it is in sight
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint8_t     pathClearance       Clearance of the query in progress
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          ExplorationStep explorationStep     Set to the next step
+ *
+ *  NOTE:
+ */
+static void Exploration_Module_follow() {
+    // [1] Slice
+    PlannerStatus status = PLANNER_step(EXPLORATION_PLAN_BUDGET);
+    if (status == PLANNER_SEARCHING) {
+        TIMER_HAL_acquireSharedTimer(EXPLORATION_PLAN_TICK, Exploration_Module_onTimerEnded);
+        return;
+    }
+
+    // [2] Unreachable
+    if (status != PLANNER_FOUND) {
+        OdometryPose pose = Odometry_Module_getPose();
+        int16_t startX, startY;
+        if (pathClearance == 0 || !GRID_toCell(pose.x, pose.y, &startX, &startY)) {
+            Exploration_Module_finish();
+            return;
+        }
+        PLANNER_start(startX, startY, goalCellX, goalCellY, --pathClearance);
+        TIMER_HAL_acquireSharedTimer(EXPLORATION_PLAN_TICK, Exploration_Module_onTimerEnded);
+        return;
+    }
+
+    // [3] Waypoint
+    int16_t wx, wy;
+    int32_t x = goalX;
+    int32_t y = goalY;
+    if (PLANNER_getWaypoints(&wx, &wy, 1) > 0 && (wx != goalCellX || wy != goalCellY))
+        GRID_toPoint(wx, wy, &x, &y);
+    drivePivots = 0;
+    Exploration_Module_drive(x, y, EXPLORATION_LOOKAHEAD * GRID_CELL);
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_correct()
+ *
+ * DESCRIPTION:
+ *      Corrects the turn after the scan that follows it:
+ *      [1] The heading is corrected by the rotation estimated from the scans before and after
+ *          the turn, if they match and it differs from the commanded one by more than the error
+ *          of the scans
+ *      [2] The scan after the turn is the reference of the next turn from the same position
+ *      [3] Go on with a split turn, or turn again towards the point to reach up to
+ *          EXPLORATION_PIVOTS times, otherwise measure the distance in front
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int16_t     driveTurn           Commanded turn
+ *          ScanProfile checkProfile        Scan after the turn
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          ScanProfile     explorationProfile  Set to the scan after the turn
+ *          ExplorationStep explorationStep     Set to the next step
+ *
+ *  NOTE:
+ *      A corrective turn shorter than EXPLORATION_MIN_TURN is not made.
+ */
+static void Exploration_Module_correct() {
+    // [1] Heading
+    int16_t rotation;
+    uint8_t window = EXPLORATION_MATCH_WINDOW + abs(driveTurn) / EXPLORATION_MATCH_SLIP;
+    uint8_t noise = EXPLORATION_MATCH_NOISE + abs(driveTurn) / EXPLORATION_MATCH_SCALE;
+    if (SCANMATCH_match(&explorationProfile, &checkProfile, driveTurn, window, &rotation) &&
+        abs(rotation - driveTurn) > noise)
+        Odometry_Module_rotate(rotation - driveTurn);
+
+    // [2] Reference
+    explorationProfile = checkProfile;
+
+    // [3] Next turn
+    if (isTurnSplit || drivePivots < EXPLORATION_PIVOTS) {
+        if (!isTurnSplit)
+            drivePivots++;
+        Exploration_Module_drive(driveX, driveY, driveLimit);
+        return;
+    }
+    explorationStep = EXPLORATION_MEASURE_START;
+    Sensing_Module_measureDistance(0);
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_onSweepEcho(int8_t angle, uint16_t distance)
+ *
+ * DESCRIPTION:
+ *      Callback of the echoes of the scans: the echo is accounted in the profile of the scan,
+ *      and in the grid before a turn, once both the extremes have been reached the sweep is
+ *      stopped and the servo is left to get back in front.
+ *      The profiles are seen from the centre of the car, about which it turns: from the sensor
+ *      in front of it, the echoes of a rotation would shift by up to EXPLORATION_SENSOR_OFFSET
+ *      over their distance more than the rotation itself.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t      angle       Position of the servo (deg)
+ *          uint16_t    distance    Distance of the echo (cm)
+ *      GLOBALS:
+ *          ExplorationStep explorationStep
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          ExplorationStep explorationStep     Set to the settling of the servo at the end
+ *
+ *  NOTE:
+ *      The scan after a turn is left out of the grid, the heading is corrected after it.
+ */
+static void Exploration_Module_onSweepEcho(int8_t angle, uint16_t distance) {
+    if (explorationStep == EXPLORATION_SCAN) {
+        Exploration_Module_markEcho(angle, distance);
+        Exploration_Module_addEcho(&explorationProfile, angle, distance);
+    } else if (explorationStep == EXPLORATION_CHECK) {
+        Exploration_Module_addEcho(&checkProfile, angle, distance);
+    } else {
+        return;
+    }
+    if (angle >= 90 - EXPLORATION_SCAN_STEP)
+        isScanLeftSeen = true;
+    if (angle <= -90 + EXPLORATION_SCAN_STEP)
+        isScanRightSeen = true;
+    if (isScanLeftSeen && isScanRightSeen) {
+        Sensing_Module_stopSweep();
+        explorationStep++;
+        TIMER_HAL_acquireSharedTimer(EXPLORATION_SETTLE, Exploration_Module_onTimerEnded);
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_onTimerEnded()
+ *
+ * DESCRIPTION:
+ *      Callback of the shared timer:
+ *      - at the end of the settling of the servo the next movement is planned
+ *      - while searching the frontier or planning the path to a goal the next slice is expanded
+ *      - at the end of a turn or a movement the car is stopped and left to settle
+ *      - at the end of the settling of the car after a turn the scan that checks it starts, and
+ *        the turn is corrected once the servo is back in front
+ *      - at the end of the settling of the car after a movement the distance in front is measured
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          ExplorationStep explorationStep
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          ExplorationStep explorationStep     Set to the next step
+ *
+ *  NOTE:
+ */
+static void Exploration_Module_onTimerEnded() {
+    TIMER_HAL_releaseSharedTimer();
+    switch (explorationStep) {
+    case EXPLORATION_SETTLE_SCAN:
+        Exploration_Module_plan();
+        break;
+    case EXPLORATION_PLAN:
+        if (isGoal)
+            Exploration_Module_follow();
+        else
+            Exploration_Module_approach();
+        break;
+    case EXPLORATION_TURN:
+    case EXPLORATION_MOVE:
+        Powertrain_Module_stop();
+        explorationStep++;
+        TIMER_HAL_acquireSharedTimer(EXPLORATION_SETTLE, Exploration_Module_onTimerEnded);
+        break;
+    case EXPLORATION_SETTLE_TURN:
+        Exploration_Module_check();
+        break;
+    case EXPLORATION_SETTLE_CHECK:
+        Exploration_Module_correct();
+        break;
+    case EXPLORATION_SETTLE_MOVE:
+        explorationStep++;
+        Sensing_Module_measureDistance(0);
+        break;
+    default:
+        break;
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_onDistance(uint16_t distance)
+ *
+ * DESCRIPTION:
+ *      Callback of the distance measurements:
+ *      [1] Before the movement, it is shortened to keep the free threshold from the obstacle in
+ *          front, a movement too short ignores the frontier, if exploring, and plans again
+ *      [2] After the movement, the travel is the change of the distance if it is within a quarter
+ *          of the planned one, and updates the estimate of the speed, otherwise the planned one:
+ *          the echoes before and after likely came from different obstacles
+ *      [3] The pose is advanced, the coverage notified and the next scan starts
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    distance    Distance of the obstacle in front (cm)
+ *      GLOBALS:
+ *          ExplorationStep explorationStep
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint32_t    explorationSpeed    Averaged with the measured speed
+ *
+ *  NOTE:
+ *      The echoes are accounted in the grid as well.
+ */
+static void Exploration_Module_onDistance(uint16_t distance) {
+    switch (explorationStep) {
+    case EXPLORATION_MEASURE_START: {
+        // [1] Clearance
+        Exploration_Module_markEcho(0, distance);
+        explorationStart = distance;
+        if (distance != US_RESULT_NO_OBJECT) {
+            int32_t clearance = ((int32_t)distance - parameters.freeThreshold) * 10;
+            if (explorationMove > clearance)
+                explorationMove = clearance;
+        }
+        if (explorationMove < EXPLORATION_MIN_MOVE) {
+            if (!isGoal)
+                Exploration_Module_ignore(explorationTargetX, explorationTargetY);
+            isTargetFinal = false;
+            Exploration_Module_plan();
+            break;
+        }
+        explorationStep = EXPLORATION_MOVE;
+        explorationRun = explorationMove * 100000 / explorationSpeed;
+        Powertrain_Module_moveForward();
+        TIMER_HAL_acquireSharedTimer(explorationRun, Exploration_Module_onTimerEnded);
+        break;
+    }
+    case EXPLORATION_MEASURE_END: {
+        // [2] Travel
+        int32_t travel = explorationMove;
+        if (explorationStart * 10 <= EXPLORATION_MAX_RANGE &&
+            distance * 10 <= EXPLORATION_MAX_RANGE) {
+            int32_t measured = ((int32_t)explorationStart - distance) * 10;
+            if (4 * measured >= 3 * explorationMove && 4 * measured <= 5 * explorationMove) {
+                travel = measured;
+                explorationSpeed =
+                    (3 * explorationSpeed + (uint32_t)measured * 100000 / explorationRun) / 4;
+            }
+        }
+
+        // [3] Pose and next scan
+        Odometry_Module_advance(travel);
+        Exploration_Module_markEcho(0, distance);
+        OdometryPose pose = Odometry_Module_getPose();
+        Telemetry_Module_notifyExploration(GRID_getCoverage(), &pose, false);
+        Exploration_Module_scan();
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void Exploration_Module_init() {
+    explorationStep = EXPLORATION_IDLE;
+    isMapped = false;
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_start()
+ *
+ * DESCRIPTION:
+ *      [1] Stops the car, its pose is the origin of an empty map
+ *      [2] Starts the first scan, the measurements are taken over from the other modules
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          ExplorationStep explorationStep     Set to EXPLORATION_SCAN
+ *
+ *  NOTE:
+ *      Nothing is done if an exploration is already running.
+ */
+void Exploration_Module_start() {
+    if (explorationStep != EXPLORATION_IDLE)
+        return;
+
+    // [1] Map
+    Powertrain_Module_stop();
+    GRID_clear();
+    Odometry_Module_reset();
+    explorationCycles = 0;
+    explorationIgnored = 0;
+    isTargetFinal = false;
+    explorationSpeed = EXPLORATION_SPEED;
+    isMapped = true;
+    isGoal = false;
+
+    // [2] First scan
+    Sensing_Module_registerDistanceCallback(Exploration_Module_onDistance);
+    Exploration_Module_scan();
+}
+
+/*F************************************************************************************************
+ * NAME: void Exploration_Module_goTo(int32_t x, int32_t y)
+ *
+ * DESCRIPTION:
+ *      [1] Keeps the map and the pose of the previous exploration, or starts an empty map with
+ *          the pose of the car as origin
+ *      [2] Starts the first scan, the measurements are taken over from the other modules
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     x           Goal (mm)
+ *          int32_t     y
+ *      GLOBALS:
+ *          bool        isMapped            A map is kept
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          ExplorationStep explorationStep     Set to EXPLORATION_SCAN
+ *
+ *  NOTE:
+ *      Nothing is done if a run is in progress or the goal is outside the grid.
+ */
+void Exploration_Module_goTo(int32_t x, int32_t y) {
+    if (explorationStep != EXPLORATION_IDLE || !GRID_toCell(x, y, &goalCellX, &goalCellY))
+        return;
+
+    // [1] Map
+    Powertrain_Module_stop();
+    if (!isMapped) {
+        GRID_clear();
+        Odometry_Module_reset();
+        explorationSpeed = EXPLORATION_SPEED;
+        isMapped = true;
+    }
+    goalX = x;
+    goalY = y;
+    isGoal = true;
+    explorationCycles = 0;
+    isTargetFinal = false;
+
+    // [2] First scan
+    Sensing_Module_registerDistanceCallback(Exploration_Module_onDistance);
+    Exploration_Module_scan();
+}
+
+void Exploration_Module_abort() {
+    if (explorationStep == EXPLORATION_IDLE)
+        return;
+    Exploration_Module_finish();
+    isMapped = false; /* Stopped mid-movement, the pose may be off */
+}
+
+void Exploration_Module_forgetMap() { isMapped = false; }
+
+bool Exploration_Module_isRunning() { return explorationStep != EXPLORATION_IDLE; }
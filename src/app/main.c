@@ -15,18 +15,31 @@
  * START DATE: 19 Feb 2024
  *
  * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     The recorded events are flushed from the main loop
+ * 18 Oct 2026  Maintainers     The profiler samples are flushed from the main loop
+ * 18 Oct 2026  Maintainers     Crash report and crash record of an unknown state
+ * 18 Oct 2026  Maintainers     Trace dump and tracing of the changes of state
+ * 18 Oct 2026  Maintainers     State retained for a warm restart updated from the main loop
  */
 #include <stdbool.h>
 
+#include "../../inc/crash.h"
+#include "../../inc/profiler.h"
+#include "../../inc/recorder.h"
+#include "../../inc/retained.h"
 #include "../../inc/state_machine.h"
 #include "../../inc/system.h"
+#include "../../inc/trace.h"
 
 /*F************************************************************************************************
  * NAME: void main()
  *
  * DESCRIPTION:
  *      [1] Initialize the system
- *      [2] Start the finite state machine
+ *      [2] Start the finite state machine, moving the crash report, the recorded events, the
+ *          profiler samples and the trace to their sink between the executions of the states, and
+ *          trace the changes of state and keep the state retained for a warm restart up to date
  *
  * INPUTS:
  *      PARAMETERS:
@@ -47,12 +60,27 @@ int main(void) {
     System_init();
 
     // [2] Start the finite state machine
+    FSM_State tracedState = FSM_currentState;
     while (true) {
+        CRASH_flush();
+#ifdef RECORDER_ENABLED
+        RECORDER_flush();
+#endif
+#ifdef PROFILER_ENABLED
+        PROFILER_flush();
+#endif
+#ifdef TRACE_ENABLED
+        TRACE_flush();
+#endif
+        RETAINED_update();
+        if (FSM_currentState != tracedState) {
+            TRACE_INSTANT(TRACE_ID_STATE, FSM_currentState);
+            tracedState = FSM_currentState;
+        }
         if (FSM_currentState < NUM_STATES) {
             (*FSM_stateMachine[FSM_currentState].function)();
         } else {
-            while (true) {
-            } // Error: unknown state, halting the system
+            CRASH_halt(FSM_currentState); // Error: unknown state, resetting the system
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,185 @@
+/*H************************************************************************************************
+ * FILENAME:        odometry_module.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the dead reckoning of the pose of the car and the fixed point
+ *      trigonometry it needs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void            Odometry_Module_reset()
+ *      void            Odometry_Module_rotate(int16_t angle)
+ *      void            Odometry_Module_advance(int32_t distance)
+ *      OdometryPose    Odometry_Module_getPose()
+ *      int16_t         Odometry_Module_sin(int16_t angle)
+ *      int16_t         Odometry_Module_cos(int16_t angle)
+ *      int16_t         Odometry_Module_bearing(int32_t dx, int32_t dy)
+ *
+ * NOTES:
+ *      The bearing is reduced to the first octant, where the angle whose tangent is the ratio of
+ *      the two components is searched by bisection in the table of the sine.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+
+#include "../../inc/odometry_module.h"
+
+/* Sine of every degree from 0 to 90, ODOMETRY_ONE is 1 */
+static const int16_t odometrySine[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+static OdometryPose odometryPose; /* Pose since the last reset */
+
+static int16_t Odometry_Module_normalize(int32_t angle) {
+    angle %= 360;
+    return angle < 0 ? angle + 360 : angle;
+}
+
+static int32_t Odometry_Module_scale(int32_t value, int16_t factor) {
+    int64_t product = (int64_t)value * factor;
+    return (product + (product < 0 ? -ODOMETRY_ONE / 2 : ODOMETRY_ONE / 2)) / ODOMETRY_ONE;
+}
+
+void Odometry_Module_reset() {
+    odometryPose.x = 0;
+    odometryPose.y = 0;
+    odometryPose.heading = 0;
+}
+
+void Odometry_Module_rotate(int16_t angle) {
+    odometryPose.heading = Odometry_Module_normalize((int32_t)odometryPose.heading + angle);
+}
+
+void Odometry_Module_advance(int32_t distance) {
+    odometryPose.x += Odometry_Module_scale(distance, Odometry_Module_cos(odometryPose.heading));
+    odometryPose.y += Odometry_Module_scale(distance, Odometry_Module_sin(odometryPose.heading));
+}
+
+OdometryPose Odometry_Module_getPose() { return odometryPose; }
+
+/*F************************************************************************************************
+ * NAME: int16_t Odometry_Module_sin(int16_t angle)
+ *
+ * DESCRIPTION:
+ *      Returns the sine of an angle in fixed point:
+ *      [1] Reduce the angle to 0-359 degrees
+ *      [2] Read the table of the first quadrant, mirrored in the other ones
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     angle       Any angle (deg)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int16_t
+ *          Value:  Sine, ODOMETRY_ONE is 1
+ *
+ *  NOTE:
+ */
+int16_t Odometry_Module_sin(int16_t angle) {
+    // [1] Full turn
+    angle = Odometry_Module_normalize(angle);
+
+    // [2] Quadrants
+    if (angle <= 90)
+        return odometrySine[angle];
+    if (angle <= 180)
+        return odometrySine[180 - angle];
+    if (angle <= 270)
+        return -odometrySine[angle - 180];
+    return -odometrySine[360 - angle];
+}
+
+int16_t Odometry_Module_cos(int16_t angle) { return Odometry_Module_sin((int32_t)angle + 90); }
+
+/*F************************************************************************************************
+ * NAME: int16_t Odometry_Module_bearing(int32_t dx, int32_t dy)
+ *
+ * DESCRIPTION:
+ *      Returns the direction of a displacement, to the nearest degree:
+ *      [1] Reduce the displacement to the first octant, 0 to 45 degrees
+ *      [2] Bisect the largest angle whose tangent does not exceed the ratio of the components
+ *      [3] Round to the nearest degree, the residual is proportional to the sine of the error
+ *      [4] Unfold the octant
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     dx          Displacement along the x axis
+ *          int32_t     dy          Displacement along the y axis
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int16_t
+ *          Value:  Counterclockwise from the x axis (0-359 deg), 0 for no displacement
+ *
+ *  NOTE:
+ */
+int16_t Odometry_Module_bearing(int32_t dx, int32_t dy) {
+    // [1] First octant
+    int64_t major = dx < 0 ? -(int64_t)dx : dx;
+    int64_t minor = dy < 0 ? -(int64_t)dy : dy;
+    bool isSwapped = minor > major;
+    if (isSwapped) {
+        int64_t swap = major;
+        major = minor;
+        minor = swap;
+    }
+    if (major == 0)
+        return 0;
+
+    // [2] tan(a) <= minor / major, i.e. major * sin(a) <= minor * cos(a)
+    int16_t low = 0;
+    int16_t high = 45;
+    while (low < high) {
+        int16_t middle = (low + high + 1) / 2;
+        if (major * odometrySine[middle] <= minor * odometrySine[90 - middle])
+            low = middle;
+        else
+            high = middle - 1;
+    }
+
+    // [3] Nearest degree
+    int16_t angle = low;
+    if (low < 45) {
+        int64_t below = minor * odometrySine[90 - low] - major * odometrySine[low];
+        int64_t above = major * odometrySine[low + 1] - minor * odometrySine[89 - low];
+        if (above < below)
+            angle = low + 1;
+    }
+
+    // [4] Octant
+    if (isSwapped)
+        angle = 90 - angle;
+    if (dx < 0)
+        angle = 180 - angle;
+    if (dy < 0)
+        angle = -angle;
+    return Odometry_Module_normalize(angle);
+}
@@ -0,0 +1,22 @@
+/*C************************************************************************************************
+ * FILENAME:        parameters.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the tunable constants of the obstacle avoidance.
+ *
+ * PUBLIC FUNCTIONS:
+ *
+ * NOTES:
+ *      The values are read when used, so a change applies from the next movement or sensing; the
+ *      sensing period applies from the next FSM_init().
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include "../../inc/parameters.h"
+
+Parameters parameters = PARAMETERS_DEFAULT;
@@ -14,9 +14,16 @@
  *      void    Powertrain_Module_decreaseSpeed()
  *      void    Powertrain_Module_turnLeft(uint8_t angle)
  *      void    Powertrain_Module_turnRight(uint8_t angle)
+ *      void    Powertrain_Module_backOff()
  *      void    Powertrain_Module_registerTurnCompletedCallback(PowertrainCallback callback)
+ *      void    Powertrain_Module_setTrim(int16_t trim)
+ *      int16_t Powertrain_Module_getTrim()
+ *      uint32_t Powertrain_Module_getTurnTime(uint8_t angle)
+ *      void    Powertrain_Module_steer(int8_t left, int8_t right)
  *
  * NOTES:
+ *      The trim slows down the faster motor on the straight movements only, so that the car does
+ *      not drift; the turns are timed for the untrimmed motors.
  *
  * AUTHOR: Simone Rossi    <simone.rossi-2@studenti.unitn.it>
  *
@@ -26,23 +33,35 @@
  * DATE         AUTHOR          DETAIL
  * 19 Feb 2024  Andrea Piccin   Refactoring, removed busy waiting mechanisms, add speed management
  * 21 Feb 2024  Andrea Piccin   Refactoring, removed hardware dependant instruction
+ * 18 Oct 2026  Maintainers     Timers are mocked in the test build as well
+ * 18 Oct 2026  Maintainers     Forward and turn speeds moved to the tunable parameters
+ * 18 Oct 2026  Maintainers     Timed back off, after a motor stall
+ * 18 Oct 2026  Maintainers     Decay mode of the motors
+ * 18 Oct 2026  Maintainers     Lower minimum speed with calibrated motors
+ * 18 Oct 2026  Maintainers     Left/right trim of the straight movements
+ * 18 Oct 2026  Maintainers     Duration of the turns for the other modules
+ * 19 Oct 2026  Maintainers     Independent speeds of the motors, to follow a curve
  */
 #include <stddef.h>
 
+#include "../../inc/parameters.h"
 #include "../../inc/powertrain_module.h"
 #include "../../inc/telemetry_module.h"
 
 #ifdef TEST
 #include "../../tests/motor_hal.h"
+#include "../../tests/timer_hal.h"
 #else
 #include "../../inc/timer_hal.h"
 #include "../../inc/motor_hal.h"
 #endif
 
 #define PI 3.14159265358979323846  /* PI value                                             */
-#define POWERTRAIN_FWD_SPEED 30    /* Default speed for forward movements                  */
 #define POWERTRAIN_REV_SPEED 20    /* Default speed for backward movements                 */
-#define POWERTRAIN_TURN_SPEED 50   /* Default speed for turns                              */
+#define POWERTRAIN_MIN_SPEED 20    /* Minimum speed, the motors do not spin below          */
+#define POWERTRAIN_MIN_CAL_SPEED 10 /* Minimum speed of a motor with a speed curve          */
+#define POWERTRAIN_BACK_OFF 50000  /* Duration of the back off in ticks (0.5s)                 */
+#define POWERTRAIN_DECAY MOTOR_DECAY_AUTO /* Slow decay at the low speeds, fast decay above    */
 #define WHEEL_DIAMETER 6.5         /* Wheel diameter in centimeters                        */
 #define WHEEL_MAX_ANGULAR_SPEED 45 /* Wheel maximum angular speed in degrees per second    */
 
@@ -50,10 +69,13 @@
 void wait_milliseconds(uint32_t time);
 uint32_t calculate_time_from_angle(uint8_t speedPercentage, uint8_t angle);
 uint32_t calculate_time_from_distance(uint8_t speedPercentage, uint8_t distance);
+static void Powertrain_Module_applyTrim(bool isTrimmed);
+static void Powertrain_Module_drive(Motor *motor, int16_t speed);
 
 //Global variables
 volatile Powertrain powertrain;        /* Store the powertrain struct            */
 PowertrainCallback powertrainCallback = NULL; /* function to invoke on position reached */
+static int16_t powertrainTrim = 0;     /* Trim of the straight movements (‰)     */
 
 /*F************************************************************************************************
  * NAME: void Powertrain_Module_init()
@@ -63,6 +85,7 @@ PowertrainCallback powertrainCallback = NULL; /* function to invoke on position
  *      [1] Initialise motor hal system
  *      [2] Initialise the powertrain and its components
  *      [3] Enable notifications
+ *      [4] Select the decay mode of the motors
  *
  * INPUTS:
  *      PARAMETERS:
@@ -97,6 +120,10 @@ void Powertrain_Module_init() {
                                               Telemetry_Module_notifyLeftMotorDirChange);
     MOTOR_HAL_registerDirectionChangeCallback(&powertrain.right_motor,
                                               Telemetry_Module_notifyRightMotorDirChange);
+
+    // [4] Select the decay mode
+    MOTOR_HAL_setDecayMode(&powertrain.left_motor, POWERTRAIN_DECAY);
+    MOTOR_HAL_setDecayMode(&powertrain.right_motor, POWERTRAIN_DECAY);
 }
 
 /*F************************************************************************************************
@@ -132,7 +159,7 @@ void Powertrain_Module_stop() {
  * DESCRIPTION:
  *      Move the robot forward infinitely
  *      [1] Set motors direction to forward
- *      [2] Set motors speed to default speed
+ *      [2] Set motors speed to default speed, trimmed
  *
  * INPUTS:
  *      PARAMETERS:
@@ -144,9 +171,9 @@ void Powertrain_Module_stop() {
  *      PARAMETERS:
  *          None
  *      GLOBALS:
- *          Motor   powertrain.left_motor   Speed set to POWERTRAIN_FWD_SPEED
+ *          Motor   powertrain.left_motor   Speed set to parameters.forwardSpeed
  *                                          Direction set to MOTOR_DIR_FORWARD
- *          Motor   powertrain.right_motor  Speed set to POWERTRAIN_FWD_SPEED
+ *          Motor   powertrain.right_motor  Speed set to parameters.forwardSpeed
  *                                          Direction set to MOTOR_DIR_FORWARD
  *
  *  NOTE:
@@ -156,8 +183,9 @@ void Powertrain_Module_moveForward() {
     MOTOR_HAL_setDirection(&powertrain.left_motor, MOTOR_DIR_FORWARD);
     MOTOR_HAL_setDirection(&powertrain.right_motor, MOTOR_DIR_FORWARD);
     // [2] Set speed
-    MOTOR_HAL_setSpeed(&powertrain.left_motor, POWERTRAIN_FWD_SPEED);
-    MOTOR_HAL_setSpeed(&powertrain.right_motor, POWERTRAIN_FWD_SPEED);
+    Powertrain_Module_applyTrim(true);
+    MOTOR_HAL_setSpeed(&powertrain.left_motor, parameters.forwardSpeed);
+    MOTOR_HAL_setSpeed(&powertrain.right_motor, parameters.forwardSpeed);
 }
 
 /*F************************************************************************************************
@@ -166,7 +194,7 @@ void Powertrain_Module_moveForward() {
  * DESCRIPTION:
  *      Move the robot backward infinitely
  *      [1] Set motors direction to reverse
- *      [2] Set motors speed to default speed
+ *      [2] Set motors speed to default speed, trimmed
  *
  * INPUTS:
  *      PARAMETERS:
@@ -190,6 +218,7 @@ void Powertrain_Module_moveBackward() {
     MOTOR_HAL_setDirection(&powertrain.left_motor, MOTOR_DIR_REVERSE);
     MOTOR_HAL_setDirection(&powertrain.right_motor, MOTOR_DIR_REVERSE);
     // [2] Set speed
+    Powertrain_Module_applyTrim(true);
     MOTOR_HAL_setSpeed(&powertrain.left_motor, POWERTRAIN_REV_SPEED);
     MOTOR_HAL_setSpeed(&powertrain.right_motor, POWERTRAIN_REV_SPEED);
 }
@@ -228,7 +257,7 @@ void Powertrain_Module_increaseSpeed() {
  * NAME: void Powertrain_Module_decreaseSpeed();
  *
  * DESCRIPTION:
- *      Decreases the speed of the motors by 10% (min 20%);
+ *      Decreases the speed of the motors by 10% (min 20%, 10% with a speed curve);
  *
  * INPUTS:
  *      PARAMETERS:
@@ -248,9 +277,14 @@ void Powertrain_Module_decreaseSpeed() {
     MotorState leftState = powertrain.left_motor.state;
     MotorState rightState = powertrain.right_motor.state;
 
-    if (leftState.direction != MOTOR_DIR_STOP && leftState.speed > 20)
+    uint8_t leftMin =
+        powertrain.left_motor.curve != NULL ? POWERTRAIN_MIN_CAL_SPEED : POWERTRAIN_MIN_SPEED;
+    uint8_t rightMin =
+        powertrain.right_motor.curve != NULL ? POWERTRAIN_MIN_CAL_SPEED : POWERTRAIN_MIN_SPEED;
+
+    if (leftState.direction != MOTOR_DIR_STOP && leftState.speed > leftMin)
         MOTOR_HAL_setSpeed(&powertrain.left_motor, leftState.speed - 10);
-    if (rightState.direction != MOTOR_DIR_STOP && rightState.speed > 20)
+    if (rightState.direction != MOTOR_DIR_STOP && rightState.speed > rightMin)
         MOTOR_HAL_setSpeed(&powertrain.right_motor, rightState.speed - 10);
 }
 
@@ -272,9 +306,9 @@ void Powertrain_Module_decreaseSpeed() {
  *      PARAMETERS:
  *          None
  *      GLOBALS:
- *          Motor   powertrain.left_motor   Speed set to POWERTRAIN_TURN_SPEED
+ *          Motor   powertrain.left_motor   Speed set to parameters.turnSpeed
  *                                          Direction set to MOTOR_DIR_REVERSE
- *          Motor   powertrain.right_motor  Speed set to POWERTRAIN_TURN_SPEED
+ *          Motor   powertrain.right_motor  Speed set to parameters.turnSpeed
  *                                          Direction set to MOTOR_DIR_FORWARD
  *
  *  NOTE:
@@ -283,11 +317,12 @@ void Powertrain_Module_turnLeft(uint8_t angle) {
     // [1] Alternate the motors direction to turn left
     MOTOR_HAL_setDirection(&powertrain.left_motor, MOTOR_DIR_REVERSE);
     MOTOR_HAL_setDirection(&powertrain.right_motor, MOTOR_DIR_FORWARD);
-    MOTOR_HAL_setSpeed(&powertrain.left_motor, POWERTRAIN_TURN_SPEED);
-    MOTOR_HAL_setSpeed(&powertrain.right_motor, POWERTRAIN_TURN_SPEED);
+    Powertrain_Module_applyTrim(false);
+    MOTOR_HAL_setSpeed(&powertrain.left_motor, parameters.turnSpeed);
+    MOTOR_HAL_setSpeed(&powertrain.right_motor, parameters.turnSpeed);
 
     // [2] Wait the required milliseconds to turn by the specified angle
-    uint32_t time = calculate_time_from_angle(POWERTRAIN_TURN_SPEED, angle);
+    uint32_t time = calculate_time_from_angle(parameters.turnSpeed, angle);
     wait_milliseconds(time);
 }
 
@@ -309,9 +344,9 @@ void Powertrain_Module_turnLeft(uint8_t angle) {
  *      PARAMETERS:
  *          None
  *      GLOBALS:
- *          Motor   powertrain.left_motor   Speed set to POWERTRAIN_TURN_SPEED
+ *          Motor   powertrain.left_motor   Speed set to parameters.turnSpeed
  *                                          Direction set to MOTOR_DIR_FORWARD
- *          Motor   powertrain.right_motor  Speed set to POWERTRAIN_TURN_SPEED
+ *          Motor   powertrain.right_motor  Speed set to parameters.turnSpeed
  *                                          Direction set to MOTOR_DIR_REVERSE
  *
  *  NOTE:
@@ -320,14 +355,49 @@ void Powertrain_Module_turnRight(uint8_t angle) {
     // [1] Alternate the motors direction to turn right
     MOTOR_HAL_setDirection(&powertrain.left_motor, MOTOR_DIR_FORWARD);
     MOTOR_HAL_setDirection(&powertrain.right_motor, MOTOR_DIR_REVERSE);
-    MOTOR_HAL_setSpeed(&powertrain.left_motor, POWERTRAIN_TURN_SPEED);
-    MOTOR_HAL_setSpeed(&powertrain.right_motor, POWERTRAIN_TURN_SPEED);
+    Powertrain_Module_applyTrim(false);
+    MOTOR_HAL_setSpeed(&powertrain.left_motor, parameters.turnSpeed);
+    MOTOR_HAL_setSpeed(&powertrain.right_motor, parameters.turnSpeed);
 
     // [2] Wait the required milliseconds to turn by the specified angle
-    uint32_t time = calculate_time_from_angle(POWERTRAIN_TURN_SPEED, angle);
+    uint32_t time = calculate_time_from_angle(parameters.turnSpeed, angle);
     wait_milliseconds(time);
 }
 
+/*F************************************************************************************************
+ * NAME: void Powertrain_Module_backOff()
+ *
+ * DESCRIPTION:
+ *      Move the robot backward for POWERTRAIN_BACK_OFF ticks
+ *      [1] Move backward
+ *      [2] Wait the back off time, then the turn completed callback is called
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Motor   powertrain.left_motor   Speed set to POWERTRAIN_REV_SPEED
+ *                                          Direction set to MOTOR_DIR_REVERSE
+ *          Motor   powertrain.right_motor  Speed set to POWERTRAIN_REV_SPEED
+ *                                          Direction set to MOTOR_DIR_REVERSE
+ *
+ *  NOTE:
+ *      The shared timer is taken over if a turn is in progress.
+ */
+void Powertrain_Module_backOff() {
+    // [1] Move backward
+    Powertrain_Module_moveBackward();
+
+    // [2] Wait the back off time
+    wait_milliseconds(POWERTRAIN_BACK_OFF);
+}
+
 /*F************************************************************************************************
  * NAME: void Powertrain_Module_onTimerEnded()
  *
@@ -356,9 +426,7 @@ void Powertrain_Module_onTimerEnded() {
     MOTOR_HAL_setDirection(&powertrain.right_motor, MOTOR_DIR_STOP);
 
     // [2] release timer
-#ifndef TEST
     TIMER_HAL_releaseSharedTimer();
-#endif
 
     if (powertrainCallback != NULL)
         powertrainCallback();
@@ -387,11 +455,7 @@ void Powertrain_Module_onTimerEnded() {
  */
 void wait_milliseconds(uint32_t time) {
     // [1] Acquire the timer
-#ifdef TEST
-    Powertrain_Module_onTimerEnded();
-#else
     TIMER_HAL_acquireSharedTimer(time, Powertrain_Module_onTimerEnded);
-#endif
 }
 
 /*F************************************************************************************************
@@ -445,3 +509,180 @@ uint32_t calculate_time_from_angle(uint8_t speedPercentage, uint8_t angle) {
 void Powertrain_Module_registerTurnCompletedCallback(PowertrainCallback callback) {
     powertrainCallback = callback;
 }
+
+/*F************************************************************************************************
+ * NAME: void Powertrain_Module_setTrim(int16_t trim)
+ *
+ * DESCRIPTION:
+ *      Sets the trim of the straight movements, applied from the next one.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     trim        Trim (‰), positive slows down the left motor
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int16_t     powertrainTrim  Set to the given trim, within +-POWERTRAIN_MAX_TRIM
+ *
+ *  NOTE:
+ */
+void Powertrain_Module_setTrim(int16_t trim) {
+    if (trim > POWERTRAIN_MAX_TRIM)
+        trim = POWERTRAIN_MAX_TRIM;
+    else if (trim < -POWERTRAIN_MAX_TRIM)
+        trim = -POWERTRAIN_MAX_TRIM;
+    powertrainTrim = trim;
+}
+
+/*F************************************************************************************************
+ * NAME: int16_t Powertrain_Module_getTrim()
+ *
+ * DESCRIPTION:
+ *      Returns the trim of the straight movements.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int16_t     powertrainTrim  Trim of the straight movements
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int16_t
+ *          Value:  Trim (‰), positive slows down the left motor
+ *
+ *  NOTE:
+ */
+int16_t Powertrain_Module_getTrim() {
+    return powertrainTrim;
+}
+
+/*F************************************************************************************************
+ * NAME: uint32_t Powertrain_Module_getTurnTime(uint8_t angle)
+ *
+ * DESCRIPTION:
+ *      Returns the time taken by Powertrain_Module_turnLeft() and Powertrain_Module_turnRight()
+ *      to turn by the given angle, for the modules that drive the motors themselves.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     angle       Specifies the angle to turn.
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Ticks of the shared timer at parameters.turnSpeed
+ *
+ *  NOTE:
+ */
+uint32_t Powertrain_Module_getTurnTime(uint8_t angle) {
+    return calculate_time_from_angle(parameters.turnSpeed, angle);
+}
+
+/*F************************************************************************************************
+ * NAME: void Powertrain_Module_steer(int8_t left, int8_t right)
+ *
+ * DESCRIPTION:
+ *      Drives each motor at its own speed, the car follows a curve towards the slower one
+ *      [1] Remove the trim, the speeds are the requested ones
+ *      [2] Set the direction and the speed of each motor, a motor at 0 is stopped
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t      left        Speed of the left motor (%), negative backward
+ *          int8_t      right       Speed of the right motor (%), negative backward
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Motor   powertrain.left_motor   Speed and direction set
+ *          Motor   powertrain.right_motor  Speed and direction set
+ *
+ *  NOTE:
+ *      The speeds are limited to 100%.
+ */
+void Powertrain_Module_steer(int8_t left, int8_t right) {
+    // [1] No trim
+    Powertrain_Module_applyTrim(false);
+
+    // [2] Motors
+    Powertrain_Module_drive((Motor *)&powertrain.left_motor, left);
+    Powertrain_Module_drive((Motor *)&powertrain.right_motor, right);
+}
+
+/*F************************************************************************************************
+ * NAME: static void Powertrain_Module_applyTrim(bool isTrimmed)
+ *
+ * DESCRIPTION:
+ *      Applies the trim to the faster motor, or removes it from both motors.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          bool        isTrimmed       True for the straight movements
+ *      GLOBALS:
+ *          int16_t     powertrainTrim  Trim of the straight movements
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Motor   powertrain.left_motor   Trim set
+ *          Motor   powertrain.right_motor  Trim set
+ *
+ *  NOTE:
+ */
+static void Powertrain_Module_applyTrim(bool isTrimmed) {
+    int16_t trim = isTrimmed ? powertrainTrim : 0;
+
+    MOTOR_HAL_setTrim(&powertrain.left_motor, MOTOR_TRIM_NONE - (trim > 0 ? trim : 0));
+    MOTOR_HAL_setTrim(&powertrain.right_motor, MOTOR_TRIM_NONE + (trim < 0 ? trim : 0));
+}
+
+/*F************************************************************************************************
+ * NAME: static void Powertrain_Module_drive(Motor *motor, int16_t speed)
+ *
+ * DESCRIPTION:
+ *      Sets the direction and the speed of a motor from a signed speed, or stops it at 0.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor       *motor          Motor to drive
+ *          int16_t     speed           Speed (%), negative backward
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The speed is limited to 100%, the sign only selects the direction.
+ */
+static void Powertrain_Module_drive(Motor *motor, int16_t speed) {
+    if (speed == 0) {
+        MOTOR_HAL_stop(motor);
+        return;
+    }
+    MOTOR_HAL_setDirection(motor, speed > 0 ? MOTOR_DIR_FORWARD : MOTOR_DIR_REVERSE);
+    speed = speed < 0 ? -speed : speed;
+    MOTOR_HAL_setSpeed(motor, speed > 100 ? 100 : speed);
+}
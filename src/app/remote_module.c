@@ -18,13 +18,29 @@
  * CHANGES:
  * DATE         AUTHOR          DETAIL
  * 21 Feb 2024  Andrea Piccin   Refactoring, added test support
+ * 18 Oct 2026  Maintainers     Added the commands of the execution trace
+ * 18 Oct 2026  Maintainers     Added the calibration of the motors, aborted by any command
+ * 18 Oct 2026  Maintainers     Added the calibration of the trim
+ * 18 Oct 2026  Maintainers     Added the sweep of the ultrasonic sensor, stopped by any command
+ * 18 Oct 2026  Maintainers     Added the exploration, aborted by any command
+ * 19 Oct 2026  Maintainers     Added the driving to a goal on the map, aborted by any command
+ * 19 Oct 2026  Maintainers     Added the recording and replay of a route, aborted by any command
+ * 19 Oct 2026  Maintainers     Recording of the route ended by the switch of mode
+ * 19 Oct 2026  Maintainers     Map of the exploration forgotten by the commands moving the car
  */
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "../../inc/remote_module.h"
+#include "../../inc/calibration_module.h"
+#include "../../inc/exploration_module.h"
 #include "../../inc/powertrain_module.h"
+#include "../../inc/route_module.h"
+#include "../../inc/sensing_module.h"
 #include "../../inc/state_machine.h"
+#include "../../inc/telemetry_module.h"
+#include "../../inc/trace.h"
 
 #ifdef TEST
 #include "../../tests/bluetooth_hal.h"
@@ -34,13 +50,54 @@
 #include "../../inc/infrared_hal.h"
 #endif
 
+#define REMOTE_SWEEP_STEP 10 /* Default degrees per echo of the sweep                      */
+
 RemoteCallback remoteCallback;
 
+/* Commands that move the car, or hand it to another module or to the autonomous mode */
+static const IRCommand movingIRCommands[] = {IR_COMMAND_UP, IR_COMMAND_DOWN, IR_COMMAND_LEFT,
+                                             IR_COMMAND_RIGHT, IR_COMMAND_ASTERISK};
+static const char *const movingBTCommands[] = {"FWD", "REV", "LFT", "RGT", "CAL",
+                                               "TRM", "RPL", "AUT", "MAN"};
+
+static bool Remote_Module_isIRMoving(IRCommand command) {
+    for (uint8_t i = 0; i < sizeof(movingIRCommands) / sizeof(movingIRCommands[0]); i++)
+        if (movingIRCommands[i] == command)
+            return true;
+    return false;
+}
+
+static bool Remote_Module_isBTMoving(const char *command) {
+    for (uint8_t i = 0; i < sizeof(movingBTCommands) / sizeof(movingBTCommands[0]); i++)
+        if (strcmp(movingBTCommands[i], command) == 0)
+            return true;
+    return false;
+}
+
 void Remote_Module_onIRMessageReceived(IRCommand command, bool isValid) {
     if (FSM_currentState != STATE_REMOTE && command != IR_COMMAND_ASTERISK)
         return;
+    if (Calibration_Module_isRunning()) { /* Any command gives the motors back         */
+        Calibration_Module_abort();
+        return;
+    }
+    if (Exploration_Module_isRunning()) { /* Any command gives the motors back         */
+        Exploration_Module_abort();
+        return;
+    }
+    if (Sensing_Module_isSweeping()) { /* Any command stops the sweep                 */
+        Sensing_Module_stopSweep();
+        return;
+    }
+    if (Route_Module_isReplaying()) { /* Any command gives the motors back          */
+        Route_Module_abort();
+        return;
+    }
 
+    int16_t turn = 0;
     if (isValid) {
+        if (Remote_Module_isIRMoving(command))
+            Exploration_Module_forgetMap(); /* The car moves out of the dead reckoning  */
         switch (command) {
         case IR_COMMAND_UP: /* Start motors forward at default speed  */
             Powertrain_Module_moveForward();
@@ -50,9 +107,11 @@ void Remote_Module_onIRMessageReceived(IRCommand command, bool isValid) {
             break;
         case IR_COMMAND_LEFT: /* Rotate 45 deg CCW                      */
             Powertrain_Module_turnLeft(45);
+            turn = 45;
             break;
         case IR_COMMAND_RIGHT: /* Rotate 45 deg CW                       */
             Powertrain_Module_turnRight(45);
+            turn = -45;
             break;
         case IR_COMMAND_OK: /* Stop the motors                        */
             Powertrain_Module_stop();
@@ -64,13 +123,15 @@ void Remote_Module_onIRMessageReceived(IRCommand command, bool isValid) {
             Powertrain_Module_decreaseSpeed();
             break;
         case IR_COMMAND_ASTERISK: /* Switch to autonomous mode              */
+            Route_Module_stopRecording(); /* The route ends where the mode changes */
             if (remoteCallback != NULL)
                 remoteCallback();
-            break;
+            return;
         default: /* Nothing to do                          */
             break;
         }
     }
+    Route_Module_update(turn); /* Movement recorded in the route, if any  */
 }
 
 void Remote_Module_onBTMessageReceived(const char *message) {
@@ -78,26 +139,85 @@ void Remote_Module_onBTMessageReceived(const char *message) {
     command[3] = '\0';
     strncpy(command, message, 3);
 
+#ifdef TRACE_ENABLED
+    if (strcmp(command, "TRC") == 0) { /* Start a capture of the execution trace */
+        TRACE_start();
+        TRACE_INSTANT(TRACE_ID_STATE, FSM_currentState);
+        return;
+    } else if (strcmp(command, "TRD") == 0) { /* End the capture and dump it      */
+        TRACE_stop();
+        return;
+    }
+#endif
+
     if (FSM_currentState != STATE_REMOTE && strcmp(command, "MAN") != 0)
         return;
+    if (Calibration_Module_isRunning()) { /* Any command gives the motors back         */
+        Calibration_Module_abort();
+        return;
+    }
+    if (Exploration_Module_isRunning()) { /* Any command gives the motors back         */
+        Exploration_Module_abort();
+        return;
+    }
+    if (Sensing_Module_isSweeping()) { /* Any command stops the sweep                 */
+        Sensing_Module_stopSweep();
+        return;
+    }
+    if (Route_Module_isReplaying()) { /* Any command gives the motors back          */
+        Route_Module_abort();
+        return;
+    }
+
+    if (Remote_Module_isBTMoving(command))
+        Exploration_Module_forgetMap(); /* The car moves out of the dead reckoning      */
 
+    int16_t turn = 0;
     if (strcmp(command, "FWD") == 0) { /* Start motors forward at default speed  */
         Powertrain_Module_moveForward();
     } else if (strcmp(command, "REV") == 0) { /* Start motors backward at default speed */
         Powertrain_Module_moveBackward();
     } else if (strcmp(command, "LFT") == 0) { /* Rotate 45 deg CCW                      */
         Powertrain_Module_turnLeft(45);
+        turn = 45;
     } else if (strcmp(command, "RGT") == 0) { /* Rotate 45 deg CW                       */
         Powertrain_Module_turnRight(45);
+        turn = -45;
     } else if (strcmp(command, "STP") == 0) { /* Stop the motors                        */
         Powertrain_Module_stop();
-    } else if (strcmp(command, "AUT") == 0) { /* Switch to autonomous mode              */
-        if (remoteCallback != NULL)
-            remoteCallback();
-    } else if (strcmp(command, "MAN") == 0) { /* Switch to manual mode                  */
+    } else if (strcmp(command, "CAL") == 0) { /* Calibrate the speed of the motors      */
+        Calibration_Module_startSweep();
+    } else if (strcmp(command, "TRM") == 0) { /* Calibrate the trim of the motors       */
+        Calibration_Module_startTrim();
+    } else if (strcmp(command, "SWP") == 0) { /* Sweep the sensor, degrees per echo     */
+        int step = atoi(message + 3);
+        if (step <= 0 || step > UINT8_MAX)
+            step = REMOTE_SWEEP_STEP;
+        Sensing_Module_startSweep(step, Telemetry_Module_notifySweepPoint);
+    } else if (strcmp(command, "EXP") == 0) { /* Explore the room                       */
+        Exploration_Module_start();
+    } else if (strcmp(command, "GTO") == 0) { /* Drive to a goal on the map, x,y in cm  */
+        char *end;
+        long x = strtol(message + 3, &end, 10);
+        if (end != message + 3 && *end == ',') {
+            const char *field = end + 1;
+            long y = strtol(field, &end, 10);
+            if (end != field)
+                Exploration_Module_goTo(x * 10, y * 10);
+        }
+    } else if (strcmp(command, "REC") == 0) { /* Record a route driven manually         */
+        Route_Module_startRecording();
+    } else if (strcmp(command, "END") == 0) { /* End the route and store it             */
+        Route_Module_stopRecording();
+    } else if (strcmp(command, "RPL") == 0) { /* Replay the stored route                */
+        Route_Module_startReplay();
+    } else if (strcmp(command, "AUT") == 0 || strcmp(command, "MAN") == 0) { /* Switch mode   */
+        Route_Module_stopRecording(); /* The route ends where the mode changes      */
         if (remoteCallback != NULL)
             remoteCallback();
+        return;
     }
+    Route_Module_update(turn); /* Movement recorded in the route, if any      */
 }
 
 void Remote_Module_init() {
@@ -0,0 +1,696 @@
+/*H************************************************************************************************
+ * FILENAME:        route_module.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the teach and repeat of a route: the dead reckoning of the manual
+ *      driving into a list of points, their storage in flash and the pure pursuit follower that
+ *      replays them.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    Route_Module_init()
+ *      void    Route_Module_startRecording()
+ *      void    Route_Module_update(int16_t turn)
+ *      void    Route_Module_stopRecording()
+ *      void    Route_Module_startReplay()
+ *      void    Route_Module_abort()
+ *      bool    Route_Module_isRecording()
+ *      bool    Route_Module_isReplaying()
+ *
+ * NOTES:
+ *      A wheel runs ROUTE_WHEEL_SPEED mm per 1000000 ticks per % of duty, the wheels are
+ *      ROUTE_TRACK mm apart: the turn rate of the powertrain at parameters.turnSpeed. The pose
+ *      is kept in um and millidegrees, so that the short steps of the replay do not lose their
+ *      fractions.
+ *      A point is recorded once the car is ROUTE_SPACING mm from the previous one along x or y,
+ *      as the displacement from the previous point in ROUTE_UNIT mm, rounded against the previous
+ *      point as decoded so that the rounding errors do not add up along the route.
+ *      The replay is paced by the distance measurements: every echo closes a control step, that
+ *      updates the pose with the speeds applied since the previous one, steers towards the point
+ *      of the route ROUTE_LOOKAHEAD mm ahead and waits ROUTE_PERIOD ticks before the next
+ *      measurement. The servo and the shared timer are never in use at the same time.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../inc/route_module.h"
+#include "../../inc/odometry_module.h"
+#include "../../inc/parameters.h"
+#include "../../inc/powertrain_module.h"
+#include "../../inc/sensing_module.h"
+#include "../../inc/telemetry_module.h"
+
+#ifdef TEST
+#include "../../tests/timer_hal.h"
+#include "../../tests/ultrasonic_hal.h"
+#else
+#include "../../inc/driverlib/driverlib.h"
+#include "../../inc/timer_hal.h"
+#include "../../inc/ultrasonic_hal.h"
+#endif
+
+#define ROUTE_WHEEL_SPEED 55          /* Travel of a wheel per % of duty (mm per 1000000 ticks) */
+#define ROUTE_TRACK 140               /* Distance between the wheels (mm)                       */
+#define ROUTE_PERIOD 9375             /* Wait between the control steps in ticks (0.1s)         */
+#define ROUTE_LOOKAHEAD 250           /* Distance of the point pursued (mm)                     */
+#define ROUTE_ARRIVAL 30              /* Distance from the last point that ends the replay (mm) */
+#define ROUTE_MAX_ERROR 60            /* Heading error turned in place (deg)                    */
+#define ROUTE_MIN_SPEED 15            /* Slowest wheel, a slower one is stopped (%)             */
+#define ROUTE_SPEED_STEP 5            /* Resolution of the speeds of the wheels (%)             */
+#define ROUTE_BLOCKED 500000          /* Wait for an obstacle to go away in ticks (5s)          */
+#define ROUTE_NOTIFY 10               /* Points reached between the notifications               */
+
+/*T************************************************************************************************
+ * NAME: RouteStep
+ *
+ * DESCRIPTION:
+ *      Represent the activity of the module.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: ROUTE_IDLE              Nothing recorded or replayed
+ *              ROUTE_RECORDING         Recording the manual commands
+ *              ROUTE_MEASURE           Replaying, measuring the distance in front
+ *              ROUTE_FOLLOW            Replaying, waiting for the next control step
+ */
+typedef enum {
+    ROUTE_IDLE,
+    ROUTE_RECORDING,
+    ROUTE_MEASURE,
+    ROUTE_FOLLOW,
+} RouteStep;
+
+#ifdef TEST
+RouteRecord routeStore; /* Stand-in for the flash sector in the test build              */
+#define ROUTE_STORED (&routeStore)
+#else
+#define ROUTE_STORED ((const RouteRecord *)ROUTE_FLASH_START)
+#endif
+
+RouteRecord route;                 /* Route recorded or replayed, valid if its magic is set    */
+volatile RouteStep routeStep;      /* Activity in progress                                     */
+int32_t routeX;                    /* Pose of the car from the start of the route (um)         */
+int32_t routeY;
+int32_t routeHeading;              /* Counterclockwise from the start (0-359999 mdeg)          */
+uint32_t routeTime;                /* Time of the last update of the pose (ticks)              */
+int8_t routeLeft;                  /* Speeds applied since then (%), negative backward         */
+int8_t routeRight;
+int32_t pointX;                    /* Last point recorded, or point pursued (mm)               */
+int32_t pointY;
+uint16_t pointIndex;               /* Index of the point pursued                               */
+bool isBlocked;                    /* The replay is stopped by an obstacle                     */
+uint32_t blockedTime;              /* Time the obstacle appeared (ticks)                       */
+
+/* Utility function declaration */
+static void Route_Module_onTimerEnded();
+static void Route_Module_onDistance(uint16_t distance);
+
+static uint32_t Route_Module_checksum(const RouteRecord *record) {
+    const uint32_t *words = (const uint32_t *)record;
+    uint32_t sum = 0;
+    for (size_t i = 0; i < offsetof(RouteRecord, checksum) / sizeof(uint32_t); i++)
+        sum += words[i];
+    return ~sum;
+}
+
+static int32_t Route_Module_divide(int32_t value, int32_t divisor) {
+    return (value + (value < 0 ? -divisor / 2 : divisor / 2)) / divisor;
+}
+
+static OdometryPose Route_Module_getPose() {
+    OdometryPose pose = {Route_Module_divide(routeX, 1000), Route_Module_divide(routeY, 1000),
+                         routeHeading / 1000};
+    return pose;
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_load()
+ *
+ * DESCRIPTION:
+ *      Loads the stored route, an empty one without its magic if the record is not valid.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RouteRecord     route       Set to the stored record
+ *
+ *  NOTE:
+ */
+static void Route_Module_load() {
+    route = *ROUTE_STORED;
+    if (route.magic != ROUTE_MAGIC || route.checksum != Route_Module_checksum(&route) ||
+        route.count > ROUTE_POINTS)
+        memset(&route, 0, sizeof(route));
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_store()
+ *
+ * DESCRIPTION:
+ *      Replaces the stored record with the route: the sector is erased, then programmed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RouteRecord     route
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Erasing the sector stalls the CPU for some milliseconds, it is done with the car stopped.
+ */
+static void Route_Module_store() {
+#ifdef TEST
+    routeStore = route;
+#else
+    uint32_t sector = 1 << ((ROUTE_FLASH_START - 0x20000) / ROUTE_FLASH_SIZE);
+    FlashCtl_unprotectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, sector);
+    FlashCtl_eraseSector(ROUTE_FLASH_START);
+    FlashCtl_programMemory(&route, (void *)ROUTE_FLASH_START, sizeof(RouteRecord));
+    FlashCtl_protectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, sector);
+#endif
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_move(int64_t left, int64_t right)
+ *
+ * DESCRIPTION:
+ *      Updates the pose with the travel of the wheels: the car turns by their difference and
+ *      advances by their mean, along the heading halfway through the turn.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int64_t     left        Travel of the left wheel (um), negative backward
+ *          int64_t     right       Travel of the right wheel (um), negative backward
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int32_t     routeX          Updated
+ *          int32_t     routeY          Updated
+ *          int32_t     routeHeading    Updated
+ *
+ *  NOTE:
+ */
+static void Route_Module_move(int64_t left, int64_t right) {
+    // 57296 millidegrees per radian, the track in um
+    int32_t turn = (right - left) * 57296 / (ROUTE_TRACK * 1000);
+    int32_t travel = (left + right) / 2;
+    int16_t heading = (routeHeading + turn / 2 + 500) / 1000;
+    routeX += (int64_t)travel * Odometry_Module_cos(heading) / ODOMETRY_ONE;
+    routeY += (int64_t)travel * Odometry_Module_sin(heading) / ODOMETRY_ONE;
+    routeHeading = (routeHeading + turn) % 360000;
+    if (routeHeading < 0)
+        routeHeading += 360000;
+}
+
+static int64_t Route_Module_travel(int8_t speed, uint32_t ticks) {
+    return (int64_t)speed * ROUTE_WHEEL_SPEED * ticks / 1000;
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_append()
+ *
+ * DESCRIPTION:
+ *      Adds the position of the car to the route, as the displacement from the last point.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int32_t     pointX      Last point recorded
+ *          int32_t     pointY
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RouteRecord route       Point added, unless full
+ *          int32_t     pointX      Set to the point added, as decoded
+ *          int32_t     pointY
+ *
+ *  NOTE:
+ *      The displacement fits in the record as long as the points are less than 635 mm apart.
+ */
+static void Route_Module_append() {
+    if (route.count >= ROUTE_POINTS)
+        return;
+    OdometryPose pose = Route_Module_getPose();
+    int8_t dx = Route_Module_divide(pose.x - pointX, ROUTE_UNIT);
+    int8_t dy = Route_Module_divide(pose.y - pointY, ROUTE_UNIT);
+    route.deltas[route.count][0] = dx;
+    route.deltas[route.count][1] = dy;
+    route.count++;
+    pointX += dx * ROUTE_UNIT;
+    pointY += dy * ROUTE_UNIT;
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_record(int64_t travel)
+ *
+ * DESCRIPTION:
+ *      Advances the car along its heading in steps, a point is recorded at the end of every step
+ *      that takes the car ROUTE_SPACING mm from the last one.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int64_t     travel      Distance driven (um), negative backward
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void Route_Module_record(int64_t travel) {
+    int64_t left = travel < 0 ? -travel : travel;
+    int64_t sign = travel < 0 ? -1 : 1;
+    while (left > 0) {
+        // The rest of the spacing to the next point
+        OdometryPose pose = Route_Module_getPose();
+        int32_t spacing = abs(pose.x - pointX) > abs(pose.y - pointY) ? abs(pose.x - pointX)
+                                                                      : abs(pose.y - pointY);
+        int64_t step = (ROUTE_SPACING - spacing) * 1000;
+        if (step <= 0)
+            step = ROUTE_SPACING * 1000;
+        if (step > left)
+            step = left;
+        Route_Module_move(sign * step, sign * step);
+        left -= step;
+        pose = Route_Module_getPose();
+        if (abs(pose.x - pointX) >= ROUTE_SPACING || abs(pose.y - pointY) >= ROUTE_SPACING)
+            Route_Module_append();
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_finish()
+ *
+ * DESCRIPTION:
+ *      Ends the replay: the car is stopped, the shared timer is released and the position reached
+ *      is notified.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RouteStep   routeStep   Set to ROUTE_IDLE
+ *
+ *  NOTE:
+ */
+static void Route_Module_finish() {
+    routeStep = ROUTE_IDLE;
+    Powertrain_Module_stop();
+    TIMER_HAL_releaseSharedTimer();
+    OdometryPose pose = Route_Module_getPose();
+    Telemetry_Module_notifyRoute(pointIndex + 1, &pose, true);
+}
+
+/*F************************************************************************************************
+ * NAME: bool Route_Module_pursue(int8_t *left, int8_t *right)
+ *
+ * DESCRIPTION:
+ *      Computes the speeds of the wheels towards the route:
+ *      [1] Pursue the first point farther than ROUTE_LOOKAHEAD, or the last one
+ *      [2] The replay ends within ROUTE_ARRIVAL of the last point
+ *      [3] Turn in place if the point is far from the heading
+ *      [4] Otherwise drive along the arc through the point tangent to the heading, its curvature
+ *          is twice the lateral offset of the point over its squared distance, the outer wheel
+ *          is faster by the speed times the curvature times half the track
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t    pointIndex  Point pursued
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          int8_t*     left        Speed of the left wheel (%), negative backward
+ *          int8_t*     right       Speed of the right wheel (%), negative backward
+ *      GLOBALS:
+ *          uint16_t    pointIndex  Moved forward along the route
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False once the last point is reached
+ *
+ *  NOTE:
+ *      The speeds are rounded to ROUTE_SPEED_STEP, so that the motors are not updated at every
+ *      step for a negligible change.
+ */
+static bool Route_Module_pursue(int8_t *left, int8_t *right) {
+    // [1] Point pursued
+    OdometryPose pose = Route_Module_getPose();
+    int64_t dx = pointX - pose.x;
+    int64_t dy = pointY - pose.y;
+    while (pointIndex + 1 < route.count &&
+           dx * dx + dy * dy < (int64_t)ROUTE_LOOKAHEAD * ROUTE_LOOKAHEAD) {
+        pointIndex++;
+        pointX += route.deltas[pointIndex][0] * route.unit;
+        pointY += route.deltas[pointIndex][1] * route.unit;
+        dx = pointX - pose.x;
+        dy = pointY - pose.y;
+        if (pointIndex % ROUTE_NOTIFY == 0)
+            Telemetry_Module_notifyRoute(pointIndex, &pose, false);
+    }
+
+    // [2] End
+    int64_t squared = dx * dx + dy * dy;
+    if (pointIndex + 1 >= route.count && squared <= (int64_t)ROUTE_ARRIVAL * ROUTE_ARRIVAL)
+        return false;
+
+    // [3] Turn in place
+    int16_t error = (Odometry_Module_bearing(dx, dy) - pose.heading + 540) % 360 - 180;
+    int16_t speed = parameters.forwardSpeed;
+    if (abs(error) > ROUTE_MAX_ERROR) {
+        *left = error > 0 ? -speed : speed;
+        *right = -*left;
+        return true;
+    }
+
+    // [4] Arc, the lateral offset is positive on the left
+    int64_t lateral = (dy * Odometry_Module_cos(pose.heading) -
+                       dx * Odometry_Module_sin(pose.heading)) / ODOMETRY_ONE;
+    int64_t delta = speed * lateral * ROUTE_TRACK / (squared > 0 ? squared : 1);
+    if (delta > 2 * speed)
+        delta = 2 * speed;
+    else if (delta < -2 * speed)
+        delta = -2 * speed;
+    int16_t wheels[2] = {speed - delta, speed + delta};
+    for (uint8_t i = 0; i < 2; i++) {
+        if (wheels[i] > 100)
+            wheels[i] = 100;
+        wheels[i] = (wheels[i] + ROUTE_SPEED_STEP / 2) / ROUTE_SPEED_STEP * ROUTE_SPEED_STEP;
+        if (wheels[i] < ROUTE_MIN_SPEED)
+            wheels[i] = 0;
+    }
+    *left = wheels[0];
+    *right = wheels[1];
+    return true;
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_onDistance(uint16_t distance)
+ *
+ * DESCRIPTION:
+ *      Callback of the distance measurements, a control step of the replay:
+ *      [1] Update the pose with the speeds applied since the previous step
+ *      [2] Compute the speeds towards the route, the replay ends at its last point
+ *      [3] Stop if an obstacle is closer than the free threshold while driving forward, give up
+ *          if it is still there after ROUTE_BLOCKED ticks
+ *      [4] Apply the speeds and wait for the next step
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    distance    Distance of the obstacle in front (cm)
+ *      GLOBALS:
+ *          RouteStep   routeStep
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RouteStep   routeStep   Set to ROUTE_FOLLOW
+ *
+ *  NOTE:
+ *      A turn in place is not stopped by an obstacle, it turns the car away from it.
+ */
+static void Route_Module_onDistance(uint16_t distance) {
+    if (routeStep != ROUTE_MEASURE)
+        return;
+
+    // [1] Pose
+    uint32_t now = TIMER_HAL_getTicks();
+    Route_Module_move(Route_Module_travel(routeLeft, now - routeTime),
+                      Route_Module_travel(routeRight, now - routeTime));
+    routeTime = now;
+
+    // [2] Speeds
+    int8_t left, right;
+    if (!Route_Module_pursue(&left, &right)) {
+        Route_Module_finish();
+        return;
+    }
+
+    // [3] Obstacle
+    bool isForward = left >= 0 && right >= 0 && left + right > 0;
+    if (isForward && distance != US_RESULT_NO_OBJECT && distance < parameters.freeThreshold) {
+        if (!isBlocked) {
+            isBlocked = true;
+            blockedTime = now;
+        } else if (now - blockedTime > ROUTE_BLOCKED) {
+            Route_Module_finish();
+            return;
+        }
+        left = 0;
+        right = 0;
+    } else {
+        isBlocked = false;
+    }
+
+    // [4] Next step
+    routeLeft = left;
+    routeRight = right;
+    Powertrain_Module_steer(left, right);
+    routeStep = ROUTE_FOLLOW;
+    TIMER_HAL_acquireSharedTimer(ROUTE_PERIOD, Route_Module_onTimerEnded);
+}
+
+static void Route_Module_onTimerEnded() {
+    TIMER_HAL_releaseSharedTimer();
+    if (routeStep != ROUTE_FOLLOW)
+        return;
+    routeStep = ROUTE_MEASURE;
+    Sensing_Module_measureDistance(0);
+}
+
+void Route_Module_init() {
+    Route_Module_load();
+    routeStep = ROUTE_IDLE;
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_startRecording()
+ *
+ * DESCRIPTION:
+ *      [1] The pose of the car is the start of an empty route
+ *      [2] No movement is accounted yet
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RouteStep   routeStep   Set to ROUTE_RECORDING
+ *
+ *  NOTE:
+ *      The speeds of the motors when the recording starts are accounted by the following
+ *      Route_Module_update().
+ */
+void Route_Module_startRecording() {
+    if (routeStep != ROUTE_IDLE)
+        return;
+
+    // [1] Empty route
+    memset(&route, 0, sizeof(route));
+    routeX = 0;
+    routeY = 0;
+    routeHeading = 0;
+    pointX = 0;
+    pointY = 0;
+    routeStep = ROUTE_RECORDING;
+
+    // [2] Nothing moved yet
+    routeLeft = 0;
+    routeRight = 0;
+    routeTime = TIMER_HAL_getTicks();
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_update(int16_t turn)
+ *
+ * DESCRIPTION:
+ *      [1] Record the movement at the speed kept since the previous command
+ *      [2] Turn by the commanded angle, the car is stopped at the end of the turn
+ *      [3] Keep the speed of a straight movement, none if the motors turn the car or are stopped
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     turn        Counterclockwise turn of the command (deg), 0 if none
+ *      GLOBALS:
+ *          int8_t      routeLeft   Speed since the previous command
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int8_t      routeLeft   Speed of the straight movement set by the command
+ *          int8_t      routeRight
+ *
+ *  NOTE:
+ */
+void Route_Module_update(int16_t turn) {
+    if (routeStep != ROUTE_RECORDING)
+        return;
+
+    // [1] Movement
+    uint32_t now = TIMER_HAL_getTicks();
+    Route_Module_record(Route_Module_travel(routeLeft, now - routeTime));
+    routeTime = now;
+
+    // [2] Turn
+    routeHeading = (routeHeading + turn * 1000 % 360000 + 360000) % 360000;
+
+    // [3] Next movement
+    MotorState left = powertrain.left_motor.state;
+    MotorState right = powertrain.right_motor.state;
+    int8_t speed = 0;
+    if (turn == 0 && left.direction == right.direction && left.direction != MOTOR_DIR_STOP) {
+        speed = (left.speed + right.speed) / 2;
+        if (left.direction == MOTOR_DIR_REVERSE)
+            speed = -speed;
+    }
+    routeLeft = speed;
+    routeRight = speed;
+    OdometryPose pose = Route_Module_getPose();
+    Telemetry_Module_notifyRoute(route.count, &pose, false);
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_stopRecording()
+ *
+ * DESCRIPTION:
+ *      [1] Record the last movement, up to the position of the car
+ *      [2] Stop the car and store the route, or load back the stored one if empty
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RouteRecord route       Sealed with its magic and checksum
+ *          RouteStep   routeStep   Set to ROUTE_IDLE
+ *
+ *  NOTE:
+ */
+void Route_Module_stopRecording() {
+    if (routeStep != ROUTE_RECORDING)
+        return;
+
+    // [1] Last movement
+    Route_Module_update(0);
+    OdometryPose pose = Route_Module_getPose();
+    if (abs(pose.x - pointX) >= ROUTE_UNIT || abs(pose.y - pointY) >= ROUTE_UNIT)
+        Route_Module_append();
+    routeStep = ROUTE_IDLE;
+
+    // [2] Storage
+    Powertrain_Module_stop();
+    if (route.count == 0) {
+        Route_Module_load();
+        return;
+    }
+    route.magic = ROUTE_MAGIC;
+    route.unit = ROUTE_UNIT;
+    route.checksum = Route_Module_checksum(&route);
+    Route_Module_store();
+    Telemetry_Module_notifyRoute(route.count, &pose, true);
+}
+
+/*F************************************************************************************************
+ * NAME: void Route_Module_startReplay()
+ *
+ * DESCRIPTION:
+ *      [1] Stops the car, its pose is the start of the route and the first point is pursued
+ *      [2] Measures the distance in front for the first control step, the measurements are
+ *          taken over from the other modules
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RouteRecord route
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RouteStep   routeStep   Set to ROUTE_MEASURE
+ *
+ *  NOTE:
+ */
+void Route_Module_startReplay() {
+    if (routeStep != ROUTE_IDLE || route.magic != ROUTE_MAGIC || route.count == 0)
+        return;
+
+    // [1] Start of the route
+    Powertrain_Module_stop();
+    routeX = 0;
+    routeY = 0;
+    routeHeading = 0;
+    routeLeft = 0;
+    routeRight = 0;
+    routeTime = TIMER_HAL_getTicks();
+    pointIndex = 0;
+    pointX = route.deltas[0][0] * route.unit;
+    pointY = route.deltas[0][1] * route.unit;
+    isBlocked = false;
+
+    // [2] First step
+    routeStep = ROUTE_MEASURE;
+    Sensing_Module_registerDistanceCallback(Route_Module_onDistance);
+    Sensing_Module_measureDistance(0);
+}
+
+void Route_Module_abort() {
+    if (routeStep == ROUTE_MEASURE || routeStep == ROUTE_FOLLOW)
+        Route_Module_finish();
+}
+
+bool Route_Module_isRecording() { return routeStep == ROUTE_RECORDING; }
+
+bool Route_Module_isReplaying() {
+    return routeStep == ROUTE_MEASURE || routeStep == ROUTE_FOLLOW;
+}
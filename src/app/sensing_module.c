@@ -8,13 +8,26 @@
  *
  * PUBLIC FUNCTIONS:
  *      void    Sensing_Module_init()
+ *      void    Sensing_Module_resume(int8_t servoPosition)
  *      void    Sensing_Module_checkClearance(uint8_t deg)
  *      void    Sensing_Module_checkLateralClearance()
  *      void    Sensing_Module_checkFrontClearance()
+ *      void    Sensing_Module_trackFrontClearance(uint8_t speed)
+ *      void    Sensing_Module_stopTracking()
  *      void    Sensing_Module_registerSingleMeasurementReadyCallback(SensingSingleCallback call)
  *      void    Sensing_Module_registerDoubleMeasurementReadyCallback(SensingDoubleCallback call)
+ *      void    Sensing_Module_measureDistance(int8_t deg)
+ *      void    Sensing_Module_registerDistanceCallback(SensingDistanceCallback call)
+ *      int8_t  Sensing_Module_getServoPosition()
+ *      void    Sensing_Module_startSweep(uint8_t step, SensingSweepCallback callback)
+ *      void    Sensing_Module_stopSweep()
+ *      bool    Sensing_Module_isSweeping()
  *
  * NOTES:
+ *      While the front is tracked, the distance between two periodic checks is dead-reckoned from
+ *      the last echo, its time and the commanded speed: if it would cross the free threshold
+ *      before the next check, the sensor pings again halfway to the crossing, on the shared timer,
+ *      or at once when it is close, so that a faster car does not need a faster period.
  *
  * AUTHOR: Matteo Frizzera    <matteo.frizzera@studenti.unitn.it>
  *
@@ -26,59 +39,85 @@
  * 16 Feb 2024  Andrea Piccin       Refactoring, removed busy waiting mechanism
  * 19 Feb 2024  Andrea Piccin       Single (front) and Double (lateral) measurements callbacks
  * 21 Feb 2024  Andrea Piccin       Refactoring, added test support
+ * 18 Oct 2026  Maintainers         Free threshold moved to the tunable parameters
+ * 18 Oct 2026  Maintainers         Raw distance measurements
+ * 18 Oct 2026  Maintainers         Resume after a warm reset
+ * 18 Oct 2026  Maintainers         Continuous sweep
+ * 19 Oct 2026  Maintainers         Early front pings predicted from the speed
  */
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "../../inc/parameters.h"
 #include "../../inc/sensing_module.h"
 #include "../../inc/telemetry_module.h"
 
 #ifdef TEST
 #include "../../tests/servo_hal.h"
+#include "../../tests/timer_hal.h"
 #include "../../tests/ultrasonic_hal.h"
 #else
 #include "../../inc/servo_hal.h"
+#include "../../inc/timer_hal.h"
 #include "../../inc/ultrasonic_hal.h"
 #endif
 
 #define SERVO_POS_LEFT SERVO_MAX_POSITION  /* Position left                                     */
 #define SERVO_POS_FRONT 0                  /* Position front, meaning in between right and left */
 #define SERVO_POS_RIGHT SERVO_MIN_POSITION /* Position right                                    */
-#define SENSING_FREE_THRESHOLD 20          /* Minimum allowed clearance                         */
+#define SENSING_WHEEL_SPEED 70             /* Fastest travel per % of duty (mm per 10^6 ticks)  */
+#define SENSING_EARLY_MIN_WAIT 200         /* Shorter waits ping at once, in ticks (2ms)        */
 
 /* Utility function declaration */
 void Sensing_Module_onUSMeasurementReady(uint16_t distance);
+static void Sensing_Module_advanceSweep();
 
 /*T************************************************************************************************
  * NAME: SensingMode
  *
  * DESCRIPTION:
- *      Specifies if the next measurement is single (e.g. front) or double (e.g. lateral)
+ *      Specifies if the next measurement is single (e.g. front), double (e.g. lateral), a raw
+ *      distance or part of a sweep
  *
  * SPECIFICATIONS:
  *      Type:   enum
  *      Values: SENSING_SINGLE_SAMPLE_MODE
  *              SENSING_DOUBLE_SAMPLE_MODE
+ *              SENSING_DISTANCE_MODE
+ *              SENSING_SWEEP_MODE
+ *              SENSING_IDLE_MODE           the echo left by a stopped sweep is discarded
  */
 typedef enum {
     SENSING_SINGLE_SAMPLE_MODE,
     SENSING_DOUBLE_SAMPLE_MODE,
+    SENSING_DISTANCE_MODE,
+    SENSING_SWEEP_MODE,
+    SENSING_IDLE_MODE,
 } SensingMode;
 
 Servo servo;                          /* Servo motor on which the ultrasonic sensor is mounted  */
 SensingMode currentSensingMode;       /* Represent the current operating mode                   */
 SensingSingleCallback singleCallback; /* Callback function for single measurement               */
 SensingDoubleCallback doubleCallback; /* Callback function for double measurements              */
+SensingDistanceCallback distanceCallback; /* Callback function for distance measurements        */
+SensingSweepCallback sweepCallback;   /* Callback function for the echoes of the sweep          */
+uint8_t sweepStep;                    /* Degrees travelled by the servo per echo of the sweep   */
+int8_t sweepDirection;                /* 1 while sweeping to the left, -1 to the right          */
 volatile uint16_t previousSample;     /* Value of the last measurement (for double samples)     */
 volatile int8_t nextDirection;        /* Direction of the next measurement (for double samples) */
 volatile uint8_t sampleCount;         /* Count of the taken samples (for double samples)        */
+bool isFrontTracked;                  /* The front checks predict the distance until the next   */
+bool isEarlyPing;                     /* An early front ping is scheduled or waits for its echo */
+bool isEarlyWait;                     /* The early front ping waits for the shared timer        */
+uint8_t frontSpeed;                   /* Commanded speed towards the front (%)                  */
+uint32_t frontDeadline;               /* Time of the next periodic front check                  */
 
 /*F************************************************************************************************
- * NAME: void Sensing_Module_init()
+ * NAME: void Sensing_Module_setUp()
  *
  * DESCRIPTION:
- *      Initializes Servo motor and ultrasonic sensor, set the servo motor callback (notification
- *      of servo in position) to trigger a new ultrasonic measurement.
+ *      Sets the servo motor callback (notification of servo in position) to trigger a new
+ *      ultrasonic measurement and resets the sensing mode, once the hardware is initialised.
  *
  * INPUTS:
  *      PARAMETERS:
@@ -94,15 +133,71 @@ volatile uint8_t sampleCount;         /* Count of the taken samples (for double
  *
  *  NOTE:
  */
-void Sensing_Module_init() {
-    US_HAL_init();
-    SERVO_HAL_init(&servo);
+static void Sensing_Module_setUp() {
     SERVO_HAL_registerPositionReachedCallback(US_HAL_triggerMeasurement);
     US_HAL_registerMeasurementCallback(Sensing_Module_onUSMeasurementReady);
     currentSensingMode = SENSING_SINGLE_SAMPLE_MODE;
     singleCallback = NULL;
     doubleCallback = NULL;
+    distanceCallback = NULL;
     sampleCount = 0;
+    isFrontTracked = false;
+    isEarlyPing = false;
+    isEarlyWait = false;
+}
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_init()
+ *
+ * DESCRIPTION:
+ *      Initializes Servo motor and ultrasonic sensor, set the servo motor callback (notification
+ *      of servo in position) to trigger a new ultrasonic measurement.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void Sensing_Module_init() {
+    US_HAL_init();
+    SERVO_HAL_init(&servo);
+    Sensing_Module_setUp();
+}
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_resume(int8_t servoPosition)
+ *
+ * DESCRIPTION:
+ *      Initializes Servo motor and ultrasonic sensor as Sensing_Module_init(), without the wait for
+ *      the servo to reach its initial position.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t  servoPosition   Position of the servo before the reset
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Servo   servo           Initialised at the given position
+ *
+ *  NOTE:
+ */
+void Sensing_Module_resume(int8_t servoPosition) {
+    US_HAL_init();
+    SERVO_HAL_resume(&servo, servoPosition);
+    Sensing_Module_setUp();
 }
 
 /*F************************************************************************************************
@@ -129,6 +224,7 @@ void Sensing_Module_init() {
  *  NOTE:
  */
 void Sensing_Module_checkSingleClearance(int8_t deg) {
+    Sensing_Module_stopTracking();
     currentSensingMode = SENSING_SINGLE_SAMPLE_MODE;
     SERVO_HAL_setPosition(&servo, deg);
 }
@@ -164,6 +260,34 @@ void Sensing_Module_checkDoubleClearance(int8_t deg1, int8_t deg2) {
     SERVO_HAL_setPosition(&servo, deg1);
 }
 
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_measureDistance(int8_t deg)
+ *
+ * DESCRIPTION:
+ *      Moves motor to the specified direction (from left -90 deg to right 90 deg) then measures
+ *      the distance of the closest object in that direction.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t  deg     direction of the measurement
+ *      GLOBALS:
+ *          Servo   servo   servo motor to rotate
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The servo is left in the measured direction, so that repeated measurements do not wait for
+ *      it.
+ */
+void Sensing_Module_measureDistance(int8_t deg) {
+    currentSensingMode = SENSING_DISTANCE_MODE;
+    SERVO_HAL_setPosition(&servo, deg);
+}
+
 /*F************************************************************************************************
  * NAME: void Sensing_Module_checkLateralClearance
  *
@@ -211,6 +335,162 @@ void Sensing_Module_checkLateralClearance() {
  */
 void Sensing_Module_checkFrontClearance() { Sensing_Module_checkSingleClearance(SERVO_POS_FRONT); }
 
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_trackFrontClearance(uint8_t speed)
+ *
+ * DESCRIPTION:
+ *      Checks whether there is an object in front, as Sensing_Module_checkFrontClearance(), while
+ *      the car approaches it until the next periodic check:
+ *      [1] Account the speed until the next check
+ *      [2] An early ping already scheduled or in flight stands for this check
+ *      [3] Otherwise ping in front
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     speed           Commanded forward speed (%)
+ *      GLOBALS:
+ *          Servo       servo           servo motor to rotate
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          bool        isFrontTracked  Set to true
+ *          uint8_t     frontSpeed      Set to the given speed
+ *          uint32_t    frontDeadline   Set to the next periodic check
+ *
+ *  NOTE:
+ *      Meant for the periodic timer, the early pings stop at the next expected call.
+ */
+void Sensing_Module_trackFrontClearance(uint8_t speed) {
+    // [1] Speed until the next check
+    frontSpeed = speed;
+    frontDeadline = TIMER_HAL_getTicks() + parameters.sensingTimerCount;
+
+    // [2] Early ping
+    if (currentSensingMode == SENSING_SINGLE_SAMPLE_MODE && isFrontTracked && isEarlyPing)
+        return;
+
+    // [3] Front ping
+    currentSensingMode = SENSING_SINGLE_SAMPLE_MODE;
+    isFrontTracked = true;
+    isEarlyPing = false;
+    isEarlyWait = false;
+    SERVO_HAL_setPosition(&servo, SERVO_POS_FRONT);
+}
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_stopTracking()
+ *
+ * DESCRIPTION:
+ *      Stops the early front pings, releasing the shared timer if an early ping is waiting for it.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          bool        isEarlyWait     An early ping is waiting for the shared timer
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          bool        isFrontTracked  Set to false
+ *          bool        isEarlyPing     Set to false
+ *
+ *  NOTE:
+ */
+void Sensing_Module_stopTracking() {
+    if (isEarlyWait)
+        TIMER_HAL_releaseSharedTimer();
+    isEarlyWait = false;
+    isEarlyPing = false;
+    isFrontTracked = false;
+}
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_onEarlyPingTimer()
+ *
+ * DESCRIPTION:
+ *      Releases the shared timer and triggers the early front ping, if the front is still tracked
+ *      and no other measurement took the sensor meanwhile.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SensingMode currentSensingMode  Current measurement mode
+ *          bool        isFrontTracked      The front is tracked
+ *          bool        isEarlyPing         An early ping is scheduled
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          bool        isEarlyWait         Set to false
+ *
+ *  NOTE:
+ *      Called by the shared timer, in its interrupt.
+ */
+static void Sensing_Module_onEarlyPingTimer() {
+    TIMER_HAL_releaseSharedTimer();
+    isEarlyWait = false;
+    if (currentSensingMode == SENSING_SINGLE_SAMPLE_MODE && isFrontTracked && isEarlyPing)
+        US_HAL_triggerMeasurement();
+}
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_scheduleEarlyPing(uint16_t distance, uint32_t ticks)
+ *
+ * DESCRIPTION:
+ *      Dead-reckons the distance of the front obstacle from a free echo, at the commanded speed,
+ *      and pings again before the next periodic check if it would cross the free threshold:
+ *      [1] Time at which the predicted distance crosses the threshold
+ *      [2] Nothing to do if the periodic check comes first
+ *      [3] Ping halfway to the crossing, or at once when it is close
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    distance        Distance of the echo (cm), above the free threshold
+ *          uint32_t    ticks           Time of the echo
+ *      GLOBALS:
+ *          uint8_t     frontSpeed      Commanded speed towards the front (%)
+ *          uint32_t    frontDeadline   Time of the next periodic front check
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          bool        isEarlyPing     Set if an early ping is scheduled
+ *          bool        isEarlyWait     Set if it waits for the shared timer
+ *
+ *  NOTE:
+ *      The speed is an upper bound, above the nominal travel of the route module: every echo
+ *      corrects the prediction, so that the overestimate only adds pings close to the threshold.
+ */
+static void Sensing_Module_scheduleEarlyPing(uint16_t distance, uint32_t ticks) {
+    if (frontSpeed == 0)
+        return;
+
+    // [1] Crossing
+    uint64_t travel = (uint64_t)(distance - parameters.freeThreshold) * 10000000;
+    uint32_t crossing = ticks + travel / (frontSpeed * SENSING_WHEEL_SPEED);
+
+    // [2] Periodic check first
+    if ((int32_t)(crossing - frontDeadline) >= 0)
+        return;
+
+    // [3] Early ping
+    isEarlyPing = true;
+    int32_t wait = (int32_t)(crossing - TIMER_HAL_getTicks()) / 2;
+    if (wait < SENSING_EARLY_MIN_WAIT) {
+        US_HAL_triggerMeasurement();
+    } else {
+        isEarlyWait = true;
+        TIMER_HAL_acquireSharedTimer(wait, Sensing_Module_onEarlyPingTimer);
+    }
+}
+
 /*F************************************************************************************************
  * NAME: void Sensing_Module_registerSingleMeasurementReadyCallback(SensingSingleCallback callback)
  *
@@ -261,6 +541,31 @@ void Sensing_Module_registerDoubleMeasurementReadyCallback(SensingDoubleCallback
     doubleCallback = callback;
 }
 
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_registerDistanceCallback(SensingDistanceCallback callback)
+ *
+ * DESCRIPTION:
+ *      Registers the SensingDistanceCallback as the function to call when a distance measurement
+ *      is ready.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SensingDistanceCallback  callback           The function to register as callback
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SensingDistanceCallback  distanceCallback   Set to the given function
+ *
+ *  NOTE:
+ */
+void Sensing_Module_registerDistanceCallback(SensingDistanceCallback callback) {
+    distanceCallback = callback;
+}
+
 /*F************************************************************************************************
  * NAME: void Sensing_Module_onUSMeasurementReady(uint16_t distance)
  *
@@ -272,6 +577,10 @@ void Sensing_Module_registerDoubleMeasurementReadyCallback(SensingDoubleCallback
  *       - DOUBLE_SAMPLE_MODE: the request is for a double measurement (e.g. left & right) so
  *                            when the first measurement is ready we'll store it and when also
  *                            the second is ready we'll call the double callback function.
+ *      - DISTANCE_MODE: the request is for the raw distance, it is forwarded to the distance
+ *                       callback without moving the servo
+ *      A free front echo while the front is tracked pings again at once, if the distance
+ *      predicted at the next periodic check is within the free threshold.
  *
  * INPUTS:
  *      PARAMETERS:
@@ -288,17 +597,34 @@ void Sensing_Module_registerDoubleMeasurementReadyCallback(SensingDoubleCallback
  *  NOTE:
  */
 void Sensing_Module_onUSMeasurementReady(uint16_t distance) {
-    if (currentSensingMode == SENSING_SINGLE_SAMPLE_MODE) {
+    if (currentSensingMode == SENSING_DISTANCE_MODE) {
+        if (distanceCallback != NULL)
+            distanceCallback(distance);
+    } else if (currentSensingMode == SENSING_SINGLE_SAMPLE_MODE) {
+        isEarlyPing = false;
         if (servo.state.position != 0)
             SERVO_HAL_resetPosition(&servo);
 
-        if (distance <= SENSING_FREE_THRESHOLD)
+        if (distance <= parameters.freeThreshold)
             Telemetry_Module_notifyObjectDetected(0, distance);
 
         if (singleCallback != NULL) {
-            singleCallback(distance > SENSING_FREE_THRESHOLD);
+            singleCallback(distance > parameters.freeThreshold);
+        }
+
+        // The callback may have started another measurement
+        if (isFrontTracked && currentSensingMode == SENSING_SINGLE_SAMPLE_MODE &&
+            distance > parameters.freeThreshold)
+            Sensing_Module_scheduleEarlyPing(distance, US_HAL_getEchoTicks());
+    } else if (currentSensingMode == SENSING_SWEEP_MODE) {
+        int8_t angle = SERVO_HAL_getAngle(&servo, US_HAL_getEchoTicks());
+        if (sweepCallback != NULL)
+            sweepCallback(angle, distance);
+        if (currentSensingMode == SENSING_SWEEP_MODE) {
+            Sensing_Module_advanceSweep();
+            US_HAL_triggerMeasurement();
         }
-    } else { // double sensing mode
+    } else if (currentSensingMode == SENSING_DOUBLE_SAMPLE_MODE) {
         sampleCount++;
         if (sampleCount < 2) {
             previousSample = distance;
@@ -307,10 +633,172 @@ void Sensing_Module_onUSMeasurementReady(uint16_t distance) {
             if (servo.state.position != 0)
                 SERVO_HAL_resetPosition(&servo);
             sampleCount = 0;
-            bool isDir1Free = previousSample > SENSING_FREE_THRESHOLD;
-            bool isDir2Free = distance > SENSING_FREE_THRESHOLD;
+            bool isDir1Free = previousSample > parameters.freeThreshold;
+            bool isDir2Free = distance > parameters.freeThreshold;
             if (doubleCallback != NULL)
                 doubleCallback(isDir1Free, isDir2Free);
         }
     }
 }
+
+/*F************************************************************************************************
+ * NAME: int8_t Sensing_Module_getServoPosition()
+ *
+ * DESCRIPTION:
+ *      Returns the last position commanded to the servo.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Servo       servo           servo motor to rotate
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int8_t
+ *          Value:  Commanded position (deg), the servo may still be travelling towards it
+ *
+ *  NOTE:
+ *      Kept in the retained state, so that a warm restart resumes it without homing the servo.
+ */
+int8_t Sensing_Module_getServoPosition() { return servo.state.position; }
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_startSweep(uint8_t step, SensingSweepCallback callback)
+ *
+ * DESCRIPTION:
+ *      Starts sweeping the servo between the extremes while the ultrasonic sensor pings back to
+ *      back:
+ *      [1] Clamp the step and register the callback
+ *      [2] Start towards the farther extreme
+ *      [3] Command the first step and the first ping
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t                 step        Degrees the servo is let travel per echo
+ *          SensingSweepCallback    callback    The function to call for every echo
+ *      GLOBALS:
+ *          Servo                   servo       servo motor to rotate
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The next ping is triggered as soon as an echo ends, without waiting for the servo.
+ */
+void Sensing_Module_startSweep(uint8_t step, SensingSweepCallback callback) {
+    // [1] Step and callback
+    if (step < 1)
+        step = 1;
+    if (step > SERVO_MAX_POSITION - SERVO_MIN_POSITION)
+        step = SERVO_MAX_POSITION - SERVO_MIN_POSITION;
+    sweepStep = step;
+    sweepCallback = callback;
+
+    // [2] Farther extreme
+    sweepDirection = SERVO_HAL_getAngle(&servo, TIMER_HAL_getTicks()) > 0 ? -1 : 1;
+
+    // [3] First step and ping
+    currentSensingMode = SENSING_SWEEP_MODE;
+    Sensing_Module_advanceSweep();
+    US_HAL_triggerMeasurement();
+}
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_stopSweep()
+ *
+ * DESCRIPTION:
+ *      Stops the sweep and sends the servo back to the front, nothing is done if it is not
+ *      sweeping.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Servo       servo               servo motor to rotate
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SensingMode currentSensingMode  Set to SENSING_IDLE_MODE
+ *
+ *  NOTE:
+ *      When called from the sweep callback no further ping is triggered, otherwise the echo in
+ *      flight ends in the idle mode and is ignored.
+ */
+void Sensing_Module_stopSweep() {
+    if (currentSensingMode != SENSING_SWEEP_MODE)
+        return;
+    currentSensingMode = SENSING_IDLE_MODE;
+    SERVO_HAL_resetPosition(&servo);
+}
+
+/*F************************************************************************************************
+ * NAME: bool Sensing_Module_isSweeping()
+ *
+ * DESCRIPTION:
+ *      Tells whether the servo is sweeping.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SensingMode currentSensingMode  Current measurement mode
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True between Sensing_Module_startSweep() and Sensing_Module_stopSweep()
+ *
+ *  NOTE:
+ */
+bool Sensing_Module_isSweeping() { return currentSensingMode == SENSING_SWEEP_MODE; }
+
+/*F************************************************************************************************
+ * NAME: void Sensing_Module_advanceSweep()
+ *
+ * DESCRIPTION:
+ *      Commands the servo one step further from its current angle, reversing the direction at
+ *      the extremes.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint8_t     sweepStep       Degrees travelled per echo
+ *          Servo       servo           servo motor to rotate
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int8_t      sweepDirection  Reversed at the extremes
+ *
+ *  NOTE:
+ */
+static void Sensing_Module_advanceSweep() {
+    int8_t angle = SERVO_HAL_getAngle(&servo, TIMER_HAL_getTicks());
+    if (angle >= SERVO_MAX_POSITION)
+        sweepDirection = -1;
+    else if (angle <= SERVO_MIN_POSITION)
+        sweepDirection = 1;
+
+    int16_t target = angle + sweepDirection * sweepStep;
+    if (target > SERVO_MAX_POSITION)
+        target = SERVO_MAX_POSITION;
+    if (target < SERVO_MIN_POSITION)
+        target = SERVO_MIN_POSITION;
+    SERVO_HAL_sweepTo(&servo, target);
+}
@@ -0,0 +1,257 @@
+/*H************************************************************************************************
+ * FILENAME:        stall_module.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the detection of a stall or an overcurrent of the motors from the
+ *      current measured on the sense resistors of the L298N, once per PWM period.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        Stall_Module_init()
+ *      void        Stall_Module_updateVoltage()
+ *      void        Stall_Module_raise(StallEvent event, MotorInitTemplate motor, uint16_t current)
+ *      void        Stall_Module_registerStallCallback(StallCallback callback)
+ *
+ * NOTES:
+ *      The detectors use integer arithmetic only, they run in the interrupt of the ADC.
+ *      After every change of speed or direction the samples are ignored for STALL_BLANKING
+ *      periods, the inrush current of a starting motor equals the stall current.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "../../inc/powertrain_module.h"
+#include "../../inc/recorder.h"
+#include "../../inc/stall_module.h"
+#include "../../inc/telemetry_module.h"
+
+#ifdef TEST
+#include "../../tests/battery_hal.h"
+#include "../../tests/motor_hal.h"
+#else
+#include "../../inc/battery_hal.h"
+#include "../../inc/motor_hal.h"
+#endif
+
+#define STALL_CURRENT 1800        /* Current of a blocked channel at full battery (mA)        */
+#define STALL_FULL_VOLTAGE 8400   /* Battery voltage of STALL_CURRENT (mV)                    */
+#define STALL_OVERCURRENT 2500    /* Current above which a channel is stopped at once (mA)    */
+#define STALL_DEAD_ZONE 15        /* Speed under which the motors do not spin (%)             */
+#define STALL_MIN_MOTION 10       /* Expected motion under which stalls are not checked (%)   */
+#define STALL_FILTER_SHIFT 2      /* Weight of a new sample in the filter, 1 / 2^shift        */
+#define STALL_SAMPLES 3           /* Consecutive filtered samples above the threshold         */
+#define STALL_BLANKING 15         /* Samples ignored after a command, 150ms at 100Hz          */
+#define STALL_MAX_CURRENT 0x1FFF  /* Largest current of a recorded event (mA)                 */
+
+/*T************************************************************************************************
+ * NAME: StallDetector
+ *
+ * DESCRIPTION:
+ *      Represent the state of the detector of a channel.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   int32_t         filter      Filtered current, scaled by 2^STALL_FILTER_SHIFT (mA)
+ *              uint8_t         speed       Speed of the samples being filtered
+ *              MotorDirection  direction   Direction of the samples being filtered
+ *              uint8_t         blanking    Samples still to ignore
+ *              uint8_t         count       Consecutive samples above the threshold
+ *              bool            isRaised    True once an event is raised for the current command
+ */
+typedef struct {
+    int32_t filter;
+    uint8_t speed;
+    MotorDirection direction;
+    uint8_t blanking;
+    uint8_t count;
+    bool isRaised;
+} StallDetector;
+
+StallDetector detectors[2];               /* Detectors, by MotorInitTemplate            */
+volatile uint16_t supplyVoltage;          /* Last battery reading (mV)                  */
+StallCallback eventCallback = NULL;       /* Function to call on a detected event       */
+
+/*F************************************************************************************************
+ * NAME: StallEvent Stall_Module_check(StallDetector *detector, MotorState state,
+ *                                     uint16_t current)
+ *
+ * DESCRIPTION:
+ *      Checks a current sample of a channel:
+ *      [1] Restarts the detector on a new command
+ *      [2] Reports an overcurrent at once
+ *      [3] Filters the samples with an exponential moving average
+ *      [4] Computes the threshold, in the middle between the current of the expected motion and
+ *          the stall current at the present supply voltage:
+ *              m = (speed - DEAD_ZONE) / (100 - DEAD_ZONE)
+ *              threshold = STALL_CURRENT * voltage / FULL_VOLTAGE * (1 - m / 2)
+ *      [5] Reports a stall after STALL_SAMPLES consecutive samples above it
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StallDetector*  detector    Detector of the channel
+ *          MotorState      state       Commanded speed and direction of the channel
+ *          uint16_t        current     Sampled current (mA)
+ *      GLOBALS:
+ *          uint16_t        supplyVoltage
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          StallDetector*  detector    Updated
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   StallEvent
+ *          Value:  The detected event, at most one per command
+ *
+ *  NOTE:
+ *      Under STALL_MIN_MOTION the running and the stall currents are too close, only the
+ *      overcurrent is checked.
+ */
+static StallEvent Stall_Module_check(StallDetector *detector, MotorState state, uint16_t current) {
+    // [1] A new command
+    if (state.speed != detector->speed || state.direction != detector->direction) {
+        detector->speed = state.speed;
+        detector->direction = state.direction;
+        detector->filter = (int32_t)current << STALL_FILTER_SHIFT;
+        detector->blanking = STALL_BLANKING;
+        detector->count = 0;
+        detector->isRaised = false;
+    }
+    if (detector->isRaised)
+        return STALL_EVENT_NONE;
+
+    // [2] Overcurrent
+    if (current > STALL_OVERCURRENT) {
+        detector->isRaised = true;
+        return STALL_EVENT_OVERCURRENT;
+    }
+
+    // [3] Filter
+    detector->filter += current - (detector->filter >> STALL_FILTER_SHIFT);
+    if (detector->blanking > 0) {
+        detector->blanking--;
+        return STALL_EVENT_NONE;
+    }
+
+    // [4] Threshold
+    int32_t motion = ((int32_t)state.speed - STALL_DEAD_ZONE) * 100 / (100 - STALL_DEAD_ZONE);
+    if (motion < STALL_MIN_MOTION) {
+        detector->count = 0;
+        return STALL_EVENT_NONE;
+    }
+    if (motion > 100)
+        motion = 100;
+    int32_t stallCurrent = (int32_t)STALL_CURRENT * supplyVoltage / STALL_FULL_VOLTAGE;
+    int32_t threshold = stallCurrent * (200 - motion) / 200;
+
+    // [5] Persistence
+    if ((detector->filter >> STALL_FILTER_SHIFT) <= threshold) {
+        detector->count = 0;
+        return STALL_EVENT_NONE;
+    }
+    if (++detector->count < STALL_SAMPLES)
+        return STALL_EVENT_NONE;
+    detector->isRaised = true;
+    return STALL_EVENT_STALL;
+}
+
+static void Stall_Module_onCurrentSample(Motor *motor, uint16_t current) {
+    MotorInitTemplate side =
+        motor == (Motor *)&powertrain.left_motor ? MOTOR_INIT_LEFT : MOTOR_INIT_RIGHT;
+    StallEvent event = Stall_Module_check(&detectors[side], motor->state, current);
+    if (event != STALL_EVENT_NONE)
+        Stall_Module_raise(event, side, current);
+}
+
+/*F************************************************************************************************
+ * NAME: void Stall_Module_init()
+ *
+ * DESCRIPTION:
+ *      [1] Resets the detectors
+ *      [2] Reads the supply voltage
+ *      [3] Registers the detectors and starts the current sense
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Powertrain      powertrain      Motors to supervise
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          StallDetector[] detectors       Reset
+ *
+ *  NOTE:
+ */
+void Stall_Module_init() {
+    // [1] Detectors, the first sample restarts them
+    for (uint8_t i = 0; i < 2; i++) {
+        detectors[i].speed = 0;
+        detectors[i].direction = MOTOR_DIR_STOP;
+        detectors[i].isRaised = true;
+    }
+
+    // [2] Supply voltage
+    Stall_Module_updateVoltage();
+
+    // [3] Current sense
+    MOTOR_HAL_registerCurrentCallback((Motor *)&powertrain.left_motor,
+                                      Stall_Module_onCurrentSample);
+    MOTOR_HAL_registerCurrentCallback((Motor *)&powertrain.right_motor,
+                                      Stall_Module_onCurrentSample);
+    MOTOR_HAL_enableCurrentSense();
+}
+
+void Stall_Module_updateVoltage() { supplyVoltage = BATTERY_HAL_getVoltage(); }
+
+/*F************************************************************************************************
+ * NAME: void Stall_Module_raise(StallEvent event, MotorInitTemplate motor, uint16_t current)
+ *
+ * DESCRIPTION:
+ *      [1] Records the event, as an input of the application
+ *      [2] Sends the telemetry message
+ *      [3] Calls the registered callback
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StallEvent          event       Detected event, not STALL_EVENT_NONE
+ *          MotorInitTemplate   motor       Channel of the event
+ *          uint16_t            current     Current that caused the event (mA)
+ *      GLOBALS:
+ *          StallCallback       eventCallback
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The recorded current is limited to STALL_MAX_CURRENT, so the replay reports the same one.
+ */
+void Stall_Module_raise(StallEvent event, MotorInitTemplate motor, uint16_t current) {
+    // [1] Record
+    if (current > STALL_MAX_CURRENT)
+        current = STALL_MAX_CURRENT;
+    RECORDER_RECORD(RECORDER_CHANNEL_MOTOR_STALL,
+                    current | (motor == MOTOR_INIT_RIGHT) << 13 |
+                        (event == STALL_EVENT_OVERCURRENT) << 14);
+
+    // [2] Telemetry
+    Telemetry_Module_notifyMotorStall(motor == MOTOR_INIT_RIGHT, current,
+                                      event == STALL_EVENT_OVERCURRENT);
+
+    // [3] Callback
+    if (eventCallback != NULL)
+        eventCallback(event);
+}
+
+void Stall_Module_registerStallCallback(StallCallback callback) { eventCallback = callback; }
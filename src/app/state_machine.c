@@ -10,13 +10,17 @@
  *      void        FSM_sensing()
  *      void        FSM_turning()
  *      void        FSM_remote()
+ *      void        FSM_recovering()
  *      void        obstacleCallback()
  *      void        rotateCallback()
  *      void        sensingCallback()
  *      void        switchModeCallback()
  *      void        timerCallback()
+ *      void        stallCallback(StallEvent event)
  *
  * NOTES:
+ *      With STALL_ENABLED a motor stall in autonomous mode makes the car back off and sense the
+ *      surroundings again, as in front of an obstacle.
  *
  * AUTHOR: Simone Rossi    <simone.rossi-2@studenti.unitn.it>
  *
@@ -26,32 +30,46 @@
  * 19 Feb 2024  Simone Rossi    Updating and refactoring
  * 20 Feb 2024  Simone Rossi    Added periodic sensing of frontal obstacles
  * 20 Feb 2024  Andrea Piccin   Added battery notification
+ * 18 Oct 2026  Maintainers     Timers are mocked in the test build as well
+ * 18 Oct 2026  Maintainers     Sensing period moved to the tunable parameters
+ * 18 Oct 2026  Maintainers     Recovery from a motor stall
+ * 18 Oct 2026  Maintainers     Autonomous mode resumed after a warm reset
+ * 19 Oct 2026  Maintainers     Front checks predicted from the forward speed
+ * 19 Oct 2026  Maintainers     A stall in remote mode aborts the modules driving the car
  */
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "../../inc/state_machine.h"
+#include "../../inc/calibration_module.h"
+#include "../../inc/exploration_module.h"
+#include "../../inc/parameters.h"
 #include "../../inc/powertrain_module.h"
 #include "../../inc/remote_module.h"
+#include "../../inc/retained.h"
+#include "../../inc/route_module.h"
 #include "../../inc/sensing_module.h"
+#include "../../inc/stall_module.h"
 #include "../../inc/telemetry_module.h"
 
-#ifndef TEST
+#ifdef TEST
+#include "../../tests/timer_hal.h"
+#else
 #include "../../inc/timer_hal.h"
 #endif
 
-#define SENSING_TIMER_COUNT 31250 // 24MHz / 256 / 31250 = 3Hz = 0.33s
-
 void obstacleCallback(bool free);
 void turnedCallback();
 void sensingCallback(bool free_left, bool free_right);
 void switchModeCallback();
 void timerCallback();
+void stallCallback(StallEvent event);
 
 FSM_State FSM_currentState = STATE_INIT; // Current FSM state
 FSM_StateMachine FSM_stateMachine[] = {
     // FSM initialization
     {STATE_INIT, FSM_init},       {STATE_RUNNING, FSM_running}, {STATE_SENSING, FSM_sensing},
-    {STATE_TURNING, FSM_turning}, {STATE_REMOTE, FSM_remote},
+    {STATE_TURNING, FSM_turning}, {STATE_REMOTE, FSM_remote},   {STATE_RECOVERING, FSM_recovering},
 };
 
 volatile uint8_t batteryTimer = 1; /* every 33s (100 interrupts) notify the state of the battery */
@@ -66,6 +84,7 @@ volatile uint8_t batteryTimer = 1; /* every 33s (100 interrupts) notify the stat
  *      [3] Initialize timer32 module used for periodically probing for obstacles
  *      [4] Register timer callback
  *      [5] Update current state
+ *      [6] Resume the autonomous mode, if it was running before a warm reset
  *
  * INPUTS:
  *      PARAMETERS:
@@ -87,17 +106,23 @@ void FSM_init() {
     Sensing_Module_registerSingleMeasurementReadyCallback(obstacleCallback);
     Sensing_Module_registerDoubleMeasurementReadyCallback(sensingCallback);
     Powertrain_Module_registerTurnCompletedCallback(turnedCallback);
+#ifdef STALL_ENABLED
+    Stall_Module_registerStallCallback(stallCallback);
+#endif
 
-#ifndef TEST
     // [3] Initialize timer32 module used for periodically probing for obstacles
-    TIMER_HAL_setupPeriodicTimer(SENSING_TIMER_COUNT);
+    TIMER_HAL_setupPeriodicTimer(parameters.sensingTimerCount);
 
     // [4] Register timer callback
     TIMER_HAL_registerPeriodicTimerCallback(timerCallback);
-#endif
 
     // [5] Update current state
     FSM_currentState = STATE_REMOTE;
+
+    // [6] Resume the autonomous mode
+    const RetainedState *restored = RETAINED_getRestored();
+    if (restored != NULL && restored->isAutonomous)
+        switchModeCallback();
 }
 
 /*F************************************************************************************************
@@ -188,6 +213,28 @@ void FSM_turning() {}
  */
 void FSM_remote() {}
 
+/*F************************************************************************************************
+ * NAME: void FSM_recovering()
+ *
+ * DESCRIPTION:
+ *      Handle the STATE_RECOVERING state:
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void FSM_recovering() {}
+
 /*F************************************************************************************************
  * NAME: void obstacleCallback(bool free)
  *
@@ -219,8 +266,9 @@ void obstacleCallback(bool free) {
         // [2] Update current state
         FSM_currentState = STATE_SENSING;
 
-        // [3] Start sensing the surroundings
+        // [3] Start sensing the surroundings, the early pings are not needed anymore
         Powertrain_Module_stop();
+        Sensing_Module_stopTracking();
         Sensing_Module_checkLateralClearance();
     }
 }
@@ -229,7 +277,8 @@ void obstacleCallback(bool free) {
  * NAME: void turnedCallback()
  *
  * DESCRIPTION:
- *      Callback to call when the robot has turned:
+ *      Callback to call when the robot has turned or backed off:
+ *      [1] After a back off sense the surroundings
  *      [2] Update current state
  *
  * INPUTS:
@@ -247,6 +296,12 @@ void obstacleCallback(bool free) {
  *  NOTE:
  */
 void turnedCallback() {
+    // [1] After a back off sense the surroundings
+    if (FSM_currentState == STATE_RECOVERING) {
+        FSM_currentState = STATE_SENSING;
+        Sensing_Module_checkLateralClearance();
+    }
+
     // [2] Update current state
     if (FSM_currentState == STATE_TURNING) {
         FSM_currentState = STATE_RUNNING;
@@ -330,6 +385,7 @@ void switchModeCallback() {
     default: // STATE_RUNNING, STATE_TURNING, STATE_SENSING
         Telemetry_Module_notifyModeSwitch(true);
         Powertrain_Module_stop();
+        Sensing_Module_stopTracking();
         FSM_currentState = STATE_REMOTE;
     }
 }
@@ -339,7 +395,8 @@ void switchModeCallback() {
  *
  * DESCRIPTION:
  *      Callback called periodically by the Timer32 to check for obstacles
- *      [1] Check for frontal obstacles
+ *      [1] Check for frontal obstacles, pinging earlier if the car would reach one before the
+ *          next period
  *
  * INPUTS:
  *      PARAMETERS:
@@ -358,11 +415,67 @@ void switchModeCallback() {
 void timerCallback() {
     // [1] Check for frontal obstacles
     if (FSM_currentState == STATE_RUNNING) {
-        Sensing_Module_checkFrontClearance();
+        Sensing_Module_trackFrontClearance(powertrain.left_motor.state.speed);
     }
     batteryTimer--;
     if (batteryTimer == 0) {
         batteryTimer = 100;
         Telemetry_Module_notifyBatteryStatus();
+#ifdef STALL_ENABLED
+        Stall_Module_updateVoltage();
+#endif
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: void stallCallback(StallEvent event)
+ *
+ * DESCRIPTION:
+ *      Callback to call when a motor stall or an overcurrent is detected:
+ *      [1] Stop the motors
+ *      [2] In autonomous mode back off, the sensing starts when the back off ends
+ *      [3] Update current state
+ *      [4] In remote mode abort the calibration, the exploration and the replay of a route
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StallEvent  event               Detected event
+ *          FSM_State   FSM_currentState    Current state of the FSM
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          FSM_State   FSM_currentState    Current state of the FSM
+ *
+ *  NOTE:
+ *      In remote mode and during the back off the car is only stopped, the stall during the
+ *      back off is caught by the sensing that follows it. A route being recorded goes on, the
+ *      car is driven by the commands.
+ */
+void stallCallback(StallEvent event) {
+    // [1] Stop the motors, and the early pings before the back off takes the shared timer
+    Powertrain_Module_stop();
+    Sensing_Module_stopTracking();
+
+    switch (FSM_currentState) {
+    case STATE_RUNNING:
+    case STATE_TURNING:
+        // [3] Update current state, before the back off since the timer can end it at once
+        FSM_currentState = STATE_RECOVERING;
+
+        // [2] Back off
+        Powertrain_Module_backOff();
+        break;
+    case STATE_REMOTE:
+        // [4] The modules driving the car on their own would drive back into the obstacle
+        Calibration_Module_abort();
+        Exploration_Module_abort();
+        Route_Module_abort();
+        break;
+    default: // STATE_INIT, STATE_SENSING, STATE_RECOVERING
+        break;
     }
 }
@@ -16,14 +16,40 @@
  * CHANGES:
  * DATE         AUTHOR          DETAIL
  * 21 Feb 2024  Andrea Piccin   Ready for testing
+ * 18 Oct 2026  Maintainers     Timers are mocked in the test build as well
+ * 18 Oct 2026  Maintainers     Initialisation of the event recorder
+ * 18 Oct 2026  Maintainers     Initialisation of the profiler
+ * 18 Oct 2026  Maintainers     Crash record of the previous run saved at boot
+ * 18 Oct 2026  Maintainers     Initialisation of the execution trace
+ * 18 Oct 2026  Maintainers     Initialisation of the stall detection
+ * 18 Oct 2026  Maintainers     Calibration of the motors loaded at boot
+ * 18 Oct 2026  Maintainers     Warm restart from the retained state
+ * 18 Oct 2026  Maintainers     Initialisation of the exploration
+ * 19 Oct 2026  Maintainers     Recorded route loaded at boot
  */
+#include <stddef.h>
+
 #include "../../inc/system.h"
 #include "../../inc/battery_hal.h"
+#include "../../inc/calibration_module.h"
+#include "../../inc/crash.h"
+#include "../../inc/exploration_module.h"
 #include "../../inc/powertrain_module.h"
+#include "../../inc/profiler.h"
+#include "../../inc/recorder.h"
 #include "../../inc/remote_module.h"
+#include "../../inc/retained.h"
+#include "../../inc/route_module.h"
 #include "../../inc/sensing_module.h"
+#include "../../inc/stall_module.h"
 #include "../../inc/telemetry_module.h"
+#include "../../inc/trace.h"
+
+#ifdef TEST
+#include "../../tests/timer_hal.h"
+#else
 #include "../../inc/timer_hal.h"
+#endif
 
 #define DCO_FREQUENCY CS_DCO_FREQUENCY_24 // 24MHz
 
@@ -34,8 +60,13 @@
  *      Initializes the system:
  *      [1] Stop the watchdog timer
  *      [2] Configure wait states and voltage level
- *      [3] Set the centered frequency of the Digitally Controlled Oscillator (DCO)
- *      [4] Init all modules
+ *      [3] Set the centered frequency of the Digitally Controlled Oscillator (DCO), save the
+ *          crash record left by the previous run, if any, and read the cause of the reset
+ *      [4] Init the event recorder and the execution trace, if enabled, and all modules, the
+ *          stall detection after the telemetry that initialises the ADC, the sensing without
+ *          the homing of the servo after a warm reset, and the calibration of the motors after
+ *          the powertrain and the sensing
+ *      [5] Start the profiler, if enabled
  *
  * INPUTS:
  *      PARAMETERS:
@@ -64,13 +95,36 @@ void System_init() {
 
     // [3] Set the centered frequency of the Digitally Controlled Oscillator (DCO)
     CS_setDCOCenteredFrequency(DCO_FREQUENCY);
-
-    TIMER_HAL_init();
+    CRASH_init();
 #endif
+    RETAINED_init();
 
-    // [4] Init all modules
+    // [4] Init the event recorder and the trace, before any HAL can produce an event, and all
+    // modules
+#ifdef RECORDER_ENABLED
+    RECORDER_init();
+#endif
+#ifdef TRACE_ENABLED
+    TRACE_init();
+#endif
+    TIMER_HAL_init();
     Powertrain_Module_init();
     Remote_Module_init();
     Telemetry_Module_init();
-    Sensing_Module_init();
+#ifdef STALL_ENABLED
+    Stall_Module_init();
+#endif
+    const RetainedState *restored = RETAINED_getRestored();
+    if (restored != NULL)
+        Sensing_Module_resume(restored->servoPosition);
+    else
+        Sensing_Module_init();
+    Calibration_Module_init();
+    Exploration_Module_init();
+    Route_Module_init();
+
+    // [5] Start the profiler, once the modules run
+#ifdef PROFILER_ENABLED
+    PROFILER_init();
+#endif
 }
\ No newline at end of file
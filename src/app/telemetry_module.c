@@ -16,6 +16,14 @@
  *      void Telemetry_Module_NotifyLeftMotorDirChange(Motor *motor, MotorDirection direction)
  *      void Telemetry_Module_NotifyRightMotorDirChange(Motor *motor, MotorDirection direction)
  *      void Telemetry_Module_NotifyObjectDetected(uint8_t servoDirection, uint16_t objectDistance)
+ *      void Telemetry_Module_notifyMotorStall(bool isRight, uint16_t current, bool isOvercurrent)
+ *      void Telemetry_Module_notifyCalibrationPoint(uint16_t duty, uint16_t speed)
+ *      void Telemetry_Module_notifyCalibrationResult(bool isSaved)
+ *      void Telemetry_Module_notifyTrimPass(int16_t trim, int16_t drift)
+ *      void Telemetry_Module_notifySweepPoint(int8_t angle, uint16_t distance)
+ *      void Telemetry_Module_notifyExploration(uint8_t coverage, const OdometryPose *pose,
+ *                                              bool isDone)
+ *      void Telemetry_Module_notifyRoute(uint16_t points, const OdometryPose *pose, bool isDone)
 
  * NOTES:
  *      Every message contains key value pairs separated by the SEPARATOR defined below.
@@ -27,13 +35,24 @@
  * CHANGES:
  * DATE         AUTHOR          DETAIL
  * 20 Feb 2024  Andrea Piccin   Refactor, removed utility functions from header file; test ready
+ * 18 Oct 2026  Maintainers     Recording of the hash of the notifications
+ * 18 Oct 2026  Maintainers     Tracing of the notifications
+ * 18 Oct 2026  Maintainers     Dropped messages reported with the battery status
+ * 18 Oct 2026  Maintainers     Notification of the motor stalls
+ * 18 Oct 2026  Maintainers     Notification of the calibration of the motors
+ * 18 Oct 2026  Maintainers     Notification of the passes of the trim calibration
+ * 18 Oct 2026  Maintainers     Notification of the echoes of the sweep
+ * 18 Oct 2026  Maintainers     Notification of the progress of the exploration
+ * 19 Oct 2026  Maintainers     Notification of the recording and replay of a route
  */
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
 
 #include "../../inc/powertrain_module.h"
+#include "../../inc/recorder.h"
 #include "../../inc/telemetry_module.h"
+#include "../../inc/trace.h"
 
 #ifdef TEST
 #include "../../tests/battery_hal.h"
@@ -185,8 +204,12 @@ void Telemetry_Module_init() {
  */
 void Telemetry_Module_notify(MessageType messageType, MessageSeverity messageSeverity,
                              const char *msg) {
+    RECORDER_RECORD(RECORDER_CHANNEL_TELEMETRY,
+                    RECORDER_hash(msg, messageType << 8 | messageSeverity));
+    TRACE_BEGIN(TRACE_ID_TELEMETRY, messageType);
     BT_HAL_sendMessage("type:%d%csev:%d%c%s", messageType, SEPARATOR, messageSeverity, SEPARATOR,
                        msg);
+    TRACE_END(TRACE_ID_TELEMETRY);
 }
 
 /*F************************************************************************************************
@@ -194,7 +217,8 @@ void Telemetry_Module_notify(MessageType messageType, MessageSeverity messageSev
  *
  * DESCRIPTION:
  *      This functions reads data from a battery message struct, formats it and puts it into a
- *      string buffer. It then calls Telemetry_Module_Notify to actually send the data over BT
+ *      string buffer together with the number of messages dropped by the Bluetooth HAL. It then
+ *      calls Telemetry_Module_Notify to actually send the data over BT
  *
  * INPUTS:
  *      PARAMETERS:
@@ -216,7 +240,7 @@ void Telemetry_Module_notify(MessageType messageType, MessageSeverity messageSev
 void Telemetry_Module_sendMsgBatteryStatus(const Message_BatteryStatusUpdate *batteryUpdate) {
 
     // prints to buffer the battery information
-    sprintf(buffer, "v:%d", batteryUpdate->voltage);
+    sprintf(buffer, "v:%d%cq:%u", batteryUpdate->voltage, SEPARATOR, BT_HAL_getDroppedMessages());
 
     Telemetry_Module_notify(batteryUpdate->messageInfo.type, batteryUpdate->messageInfo.severity,
                             buffer);
@@ -568,3 +592,224 @@ void Telemetry_Module_notifyModeSwitch(bool controlled) {
     sprintf(buffer, "mode:%s", controlled ? "0" : "1");
     Telemetry_Module_notify(MSG_MODE_SWITCH, MSG_HIGH_SEVERITY, buffer);
 }
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyMotorStall(bool isRight, uint16_t current, bool isOvercurrent)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the channel and the current of a detected
+ *      stall or overcurrent.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          bool        isRight         Whether the event concerns the right motors
+ *          uint16_t    current         Current that caused the event (mA)
+ *          bool        isOvercurrent   Whether the event is an overcurrent rather than a stall
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifyMotorStall(bool isRight, uint16_t current, bool isOvercurrent) {
+    sprintf(buffer, "mot:%d%cmA:%u", isRight, SEPARATOR, current);
+    Telemetry_Module_notify(isOvercurrent ? MSG_MOTOR_OVERCURRENT : MSG_MOTOR_STALL,
+                            MSG_HIGH_SEVERITY, buffer);
+}
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyCalibrationPoint(uint16_t duty, uint16_t speed)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the duty cycle and the measured speed of a
+ *      point of the calibration sweep.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    duty            Duty cycle of the motors (‰)
+ *          uint16_t    speed           Measured speed of the car (mm/s)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifyCalibrationPoint(uint16_t duty, uint16_t speed) {
+    sprintf(buffer, "dty:%u%cv:%u", duty, SEPARATOR, speed);
+    Telemetry_Module_notify(MSG_CALIBRATION_POINT, MSG_LOW_SEVERITY, buffer);
+}
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyCalibrationResult(bool isSaved)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the result of the calibration sweep, or of
+ *      the calibration of the trim.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          bool        isSaved         Whether new curves, or a new trim, have been stored
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifyCalibrationResult(bool isSaved) {
+    sprintf(buffer, "ok:%d", isSaved);
+    Telemetry_Module_notify(MSG_CALIBRATION_RESULT, MSG_MEDIUM_SEVERITY, buffer);
+}
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyTrimPass(int16_t trim, int16_t drift)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the trim and the drift of a pass of the
+ *      calibration of the trim.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     trim            Trim of the pass (‰)
+ *          int16_t     drift           Drift to the right of the car (mm)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifyTrimPass(int16_t trim, int16_t drift) {
+    sprintf(buffer, "t:%d%cd:%d", trim, SEPARATOR, drift);
+    Telemetry_Module_notify(MSG_TRIM_PASS, MSG_LOW_SEVERITY, buffer);
+}
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifySweepPoint(int8_t angle, uint16_t distance)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with an echo of the sweep of the ultrasonic sensor.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int8_t      angle           Angle of the servo when the sound was reflected (deg)
+ *          uint16_t    distance        Distance of the closest object (cm)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ */
+void Telemetry_Module_notifySweepPoint(int8_t angle, uint16_t distance) {
+    sprintf(buffer, "a:%d%cd:%u", angle, SEPARATOR, distance);
+    Telemetry_Module_notify(MSG_SWEEP_POINT, MSG_LOW_SEVERITY, buffer);
+}
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyExploration(uint8_t coverage, const OdometryPose *pose,
+ *                                          bool isDone)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the coverage of the map and the position of
+ *      the car during the exploration.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t             coverage        Coverage of the map (%)
+ *          const OdometryPose* pose            Estimated pose of the car
+ *          bool                isDone          True if no frontier is left to reach
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ *      The position is sent in dm, clamped to two digits to fit the message, the end of the
+ *      exploration is sent with a medium severity.
+ */
+void Telemetry_Module_notifyExploration(uint8_t coverage, const OdometryPose *pose, bool isDone) {
+    int32_t x = pose->x / 100;
+    int32_t y = pose->y / 100;
+    x = x > 99 ? 99 : x < -99 ? -99 : x;
+    y = y > 99 ? 99 : y < -99 ? -99 : y;
+    sprintf(buffer, "c:%u%cx:%d%cy:%d", coverage, SEPARATOR, (int)x, SEPARATOR, (int)y);
+    Telemetry_Module_notify(MSG_EXPLORATION, isDone ? MSG_MEDIUM_SEVERITY : MSG_LOW_SEVERITY,
+                            buffer);
+}
+
+/*F************************************************************************************************
+ * NAME: Telemetry_Module_notifyRoute(uint16_t points, const OdometryPose *pose, bool isDone)
+ *
+ * DESCRIPTION:
+ *      This functions send a bluetooth message with the points of a route and the position of
+ *      the car on it.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t            points          Points recorded, or reached by the replay
+ *          const OdometryPose* pose            Estimated pose of the car from the start
+ *          bool                isDone          True at the end of the recording or the replay
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          None
+ *
+ *  NOTE:
+ *      The points are clamped to three digits and the position, sent in dm, to two to fit the
+ *      message, the end of the recording or the replay is sent with a medium severity.
+ */
+void Telemetry_Module_notifyRoute(uint16_t points, const OdometryPose *pose, bool isDone) {
+    int32_t x = pose->x / 100;
+    int32_t y = pose->y / 100;
+    x = x > 99 ? 99 : x < -99 ? -99 : x;
+    y = y > 99 ? 99 : y < -99 ? -99 : y;
+    points = points > 999 ? 999 : points;
+    snprintf(buffer, sizeof(buffer), "n:%u%cx:%d%cy:%d", points, SEPARATOR, (int)x, SEPARATOR,
+             (int)y);
+    Telemetry_Module_notify(MSG_ROUTE, isDone ? MSG_MEDIUM_SEVERITY : MSG_LOW_SEVERITY, buffer);
+}
@@ -23,9 +23,13 @@
  * DATE         AUTHOR          DETAIL
  * 04 Feb 2024  Andrea Piccin   Refactoring
  * 04 Feb 2024  Andrea Piccin   Removed unnecessary 1.0 multiplication in getPercentage()
+ * 18 Oct 2026  Maintainers     Recording of the readings
+ * 18 Oct 2026  Maintainers     Tracing of the readings
  */
 
 #include "../../inc/battery_hal.h"
+#include "../../inc/recorder.h"
+#include "../../inc/trace.h"
 
 #define BATTERY_ADC_PORT GPIO_PORT_P6   /* Battery input port                                */
 #define BATTERY_ADC_PIN GPIO_PIN1       /* Battery input pin                                 */
@@ -121,8 +125,11 @@ uint16_t BATTERY_HAL_getVoltage() {
     } while (status & BATTERY_ADC_MEM);
     uint16_t result = ADC14_getResult(BATTERY_ADC_MEM);
 
-    /* [3] Rescale the result and return it */
-    return (uint16_t)(((result * 3.3) / 16384) * BATTERY_DIVIDER * 1000);
+    /* [3] Rescale the result, record and return it */
+    uint16_t voltage = (uint16_t)(((result * 3.3) / 16384) * BATTERY_DIVIDER * 1000);
+    RECORDER_RECORD(RECORDER_CHANNEL_BATTERY, voltage);
+    TRACE_INSTANT(TRACE_ID_BATTERY, voltage);
+    return voltage;
 }
 
 /*F************************************************************************************************
@@ -8,6 +8,8 @@
  * PUBLIC FUNCTIONS:
  *      void    BT_HAL_init()
  *      void    BT_HAL_sendMessage(const char* format, ...)
+ *      bool    BT_HAL_canSend()
+ *      uint16_t BT_HAL_getDroppedMessages()
  *      void    BT_HAL_registerMessageCallback(BTCallback callback)
  *
  * NOTES:
@@ -25,12 +27,20 @@
  * 09 Feb 2024  Andrea Piccin   Introduced callback mechanism
  * 10 Feb 2024  Andrea Piccin   Fixed multiple message transmission adding a queue
  * 12 Feb 2024  Andrea Piccin   introduced printf-like sendMessage function
+ * 18 Oct 2026  Maintainers     Recording of the received messages, added canSend()
+ * 18 Oct 2026  Maintainers     Tracing of the callback
+ * 18 Oct 2026  Maintainers     Count of the messages dropped with the queue full
+ * 19 Oct 2026  Maintainers     Lock-free ring in place of the queue, safe for nested producers
+ * 19 Oct 2026  Maintainers     Exclusive increment of the dropped messages
+ * 19 Oct 2026  Maintainers     Transmission not stopped by a message pushed while disabling it
  */
 #include <stdarg.h>
 #include <stdio.h>
 
 #include "../../inc/bluetooth_hal.h"
-#include "../../inc/queue.h"
+#include "../../inc/recorder.h"
+#include "../../inc/ring.h"
+#include "../../inc/trace.h"
 
 #define BT_PORT GPIO_PORT_P3        /* Bluetooth I/O port                          */
 #define BT_RX_PIN GPIO_PIN2         /* Bluetooth RX pin                            */
@@ -57,9 +67,14 @@ typedef enum { TX_IDLE, TX_MESSAGE, TX_CR, TX_LF } TxState;
 BTCallback btCallback;                               /* To call when a new message is ready */
 volatile char incomingMessageBuffer[BT_BUFFER_SIZE]; /* Contains the incoming message       */
 volatile uint16_t currentRxIndex;                    /* Index of the current char to read   */
-volatile StringQueue outgoingMessagesQueue;          /* Queue of the messages to send       */
-volatile char *currentTxPointer;                     /* Pointer to the string to send       */
+StringRing outgoingMessagesRing;                     /* Ring of the messages to send        */
+volatile const char *currentTxPointer;               /* Pointer to the string to send       */
 volatile TxState currentTxState;                     /* State the transmission              */
+#ifdef __arm__
+volatile uint16_t droppedMessages;                   /* Messages lost with the ring full    */
+#else
+_Atomic uint16_t droppedMessages;                    /* Messages lost with the ring full    */
+#endif
 
 /*F************************************************************************************************
  * NAME: void BT_HAL_init()
@@ -82,7 +97,7 @@ volatile TxState currentTxState;                     /* State the transmission
  *          None
  *      GLOBALS:
  *          uint16_t    currentRxIndex              Set to 0
- *          StringQueue outgoingMessagesQueue       Initialised
+ *          StringRing  outgoingMessagesRing        Initialised
  *          char*       currentTxPointer            Set to NULL
  *          TxState     currentTxState              Set to TX_IDLE
  *          BTCallback  btCallback                  Set to NULL
@@ -112,9 +127,10 @@ void BT_HAL_init() {
 
     /* [3] Initialise the global variables */
     currentRxIndex = 0;
-    queue_init(&outgoingMessagesQueue);
+    RING_init(&outgoingMessagesRing);
     currentTxPointer = NULL;
     currentTxState = TX_IDLE;
+    droppedMessages = 0;
     btCallback = NULL;
 
     /* [4] Enable interrupts */
@@ -123,6 +139,51 @@ void BT_HAL_init() {
     Interrupt_enableMaster();
 }
 
+/*F************************************************************************************************
+ * NAME: void BT_HAL_countDropped()
+ *
+ * DESCRIPTION:
+ *      Counts a lost message, saturating at UINT16_MAX:
+ *      [1] Load the counter exclusively, stop if it is saturated
+ *      [2] Store the increment, retry if the exclusive store failed because an interrupt ran in
+ *          between
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t    droppedMessages          Messages lost with the ring full
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t    droppedMessages          Incremented
+ *
+ *  NOTE:
+ *      Nested producers can fail at once, a plain increment would lose their counts. On the host
+ *      the exclusive pair is a compare and swap of the C11 atomics.
+ */
+static void BT_HAL_countDropped() {
+#ifdef __arm__
+    uint16_t count;
+    do {
+        // [1] Exclusive load
+        count = __LDREXH(&droppedMessages);
+        if (count == UINT16_MAX) {
+            __CLREX();
+            return;
+        }
+
+        // [2] Exclusive store
+    } while (__STREXH(count + 1, &droppedMessages) != 0);
+#else
+    uint16_t count = atomic_load(&droppedMessages);
+    while (count < UINT16_MAX && !atomic_compare_exchange_weak(&droppedMessages, &count, count + 1))
+        ;
+#endif
+}
+
 /*F************************************************************************************************
  * NAME: void BT_HAL_sendMessage(const char* data)
  *
@@ -131,7 +192,7 @@ void BT_HAL_init() {
  *      forward it and every connected device will receive it, the procedure goes through the
  *      following steps:
  *      [1] Creates the message using the sprintf
- *      [2] Adds the message to the outgoing messages queue
+ *      [2] Pushes the message to the outgoing messages ring
  *      [3] Enables the transmit interrupt that signals if the transmission buffer is ready
  *      [4] The ISR will send the message
  *
@@ -140,36 +201,48 @@ void BT_HAL_init() {
  *          const char* format              Format of the string in printf style
  *          ...         args                Like in printf
  *      GLOBALS:
- *          StringQueue outgoingMessagesQueue   Queue of the messages to send
+ *          StringRing  outgoingMessagesRing    Ring of the messages to send
  *
  *  OUTPUTS:
  *      PARAMETERS:
  *          None
  *      GLOBALS:
- *          StringQueue outgoingMessagesQueue    A new string is enqueued
+ *          StringRing  outgoingMessagesRing     A new string is pushed
+ *          uint16_t    droppedMessages          Incremented if the ring is full
  *
  *  NOTE:
- *      The queue has a fixed size of 10 elements, every exceeding message will be lost
+ *      The ring has a fixed size of 16 elements, every exceeding message is lost and counted.
+ *      Safe from any interrupt, also preempting another sendMessage(): the ring reserves the
+ *      slots without disabling the interrupts.
  */
 void BT_HAL_sendMessage(const char *format, ...) {
-    if (queue_isFull(&outgoingMessagesQueue))
+    if (RING_isFull(&outgoingMessagesRing)) {
+        BT_HAL_countDropped();
         return;
+    }
 
     // [1] Creates the message using the sprintf
-    char msg[QUEUE_ELEMENT_SIZE];
+    char msg[RING_ELEMENT_SIZE];
     va_list args;
     va_start(args, format);
     vsnprintf(msg, sizeof(msg), format, args);
     va_end(args);
 
-    // [2] Adds the message to the outgoing messages queue
-    queue_enqueue(&outgoingMessagesQueue, msg);
+    // [2] Pushes the message to the outgoing messages ring, it may have been filled meanwhile
+    if (!RING_push(&outgoingMessagesRing, msg)) {
+        BT_HAL_countDropped();
+        return;
+    }
 
     // [3] Enables the transmit interrupt
     UART_enableInterrupt(BT_EUSCI_BASE, EUSCI_A_UART_TRANSMIT_INTERRUPT);
     // [4] The ISR will send the message
 }
 
+bool BT_HAL_canSend() { return !RING_isFull(&outgoingMessagesRing); }
+
+uint16_t BT_HAL_getDroppedMessages() { return droppedMessages; }
+
 /*F************************************************************************************************
  * NAME: void BT_HAL_registerMessageCallback(IRCallback callback)
  *
@@ -216,8 +289,11 @@ void BT_HAL_registerMessageCallback(BTCallback callback) { btCallback = callback
  */
 void BT_HAL_forwardAndReset() {
     UART_disableInterrupt(BT_EUSCI_BASE, EUSCI_A_UART_RECEIVE_INTERRUPT);
+    RECORDER_RECORD_STRING(RECORDER_CHANNEL_BT_RX, (const char *)incomingMessageBuffer);
+    TRACE_BEGIN(TRACE_ID_BT_RX, (uint8_t)incomingMessageBuffer[0]);
     if (btCallback != NULL)
         btCallback(incomingMessageBuffer);
+    TRACE_END(TRACE_ID_BT_RX);
     currentRxIndex = 0;
     UART_enableInterrupt(BT_EUSCI_BASE, EUSCI_A_UART_RECEIVE_INTERRUPT);
 }
@@ -233,14 +309,14 @@ void BT_HAL_forwardAndReset() {
  *                          the end of string is read ('\n', '\r' or '\0') forward the message to
  *                          the callback function.
  *      TRANSMIT_INTERRUPT: the interrupt signals that the TX buffer is ready, the first message on
- *                          the outgoing queue is dequeued and sent followed by \r\n.
+ *                          the outgoing ring is popped and sent followed by \r\n.
  *                          When all the messages are sent disable the transmission interrupt.
  *
  * INPUTS:
  *      GLOBALS:
  *          int             currentRxIndex          Index of the current char to read
  *          char*           currentTxPointer        Current string to send
- *          StringQueue     outgoingMessagesQueue   Queue of the messages to send
+ *          StringRing      outgoingMessagesRing    Ring of the messages to send
  *          TxState         currentTxState          State the transmission
  *
  *  OUTPUTS:
@@ -251,6 +327,9 @@ void BT_HAL_forwardAndReset() {
  *          TxState         currentTxState          Updated
  *
  *  NOTE:
+ *      A producer preempting the routine between the check of the empty ring and the disable
+ *      pushes its message and enables the interrupt, then the disable would leave the message in
+ *      the ring until the next send: the ring is checked again after the disable.
  */
 // cppcheck-suppress unusedFunction
 void EUSCIA2_IRQHandler(void) {
@@ -287,13 +366,15 @@ void EUSCIA2_IRQHandler(void) {
     /* Transmit routine */
     if (status & EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG) {
 
-        /* if the state is TX_IDLE there is no transmission, if there is a message in the queue
-         * load it, otherwise disable the interrupts */
+        /* if the state is TX_IDLE there is no transmission, if there is a message in the ring
+         * load it, otherwise disable the interrupts and check the ring again */
         if (currentTxState == TX_IDLE) {
-            if (queue_isEmpty(&outgoingMessagesQueue)) {
+            if (RING_isEmpty(&outgoingMessagesRing)) {
                 UART_disableInterrupt(BT_EUSCI_BASE, EUSCI_A_UART_TRANSMIT_INTERRUPT);
+                if (!RING_isEmpty(&outgoingMessagesRing))
+                    UART_enableInterrupt(BT_EUSCI_BASE, EUSCI_A_UART_TRANSMIT_INTERRUPT);
             } else {
-                currentTxPointer = queue_front(&outgoingMessagesQueue);
+                currentTxPointer = RING_front(&outgoingMessagesRing);
                 currentTxState = TX_MESSAGE;
             }
         }
@@ -305,7 +386,7 @@ void EUSCIA2_IRQHandler(void) {
                 UART_transmitData(BT_EUSCI_BASE, *currentTxPointer);
                 currentTxPointer++;
             } else {
-                queue_dequeue(&outgoingMessagesQueue);
+                RING_pop(&outgoingMessagesRing);
                 currentTxState = TX_CR;
             }
         }
@@ -31,11 +31,15 @@
  * DATE         AUTHOR          DETAIL
  * 07 Feb 2024  Andrea Piccin   Refactoring
  * 08 Feb 2024  Andrea Piccin   Introduced callback mechanism
+ * 18 Oct 2026  Maintainers     Recording of the received frames
+ * 18 Oct 2026  Maintainers     Tracing of the callback
  */
 #include <stdio.h>
 
 #include "../../inc/driverlib/driverlib.h"
 #include "../../inc/infrared_hal.h"
+#include "../../inc/recorder.h"
+#include "../../inc/trace.h"
 
 #define IR_PORT GPIO_PORT_P2    /* Port of the infrared signal                    */
 #define IR_PIN GPIO_PIN7        /* Pin of the infrared signal                     */
@@ -152,10 +156,13 @@ void IR_HAL_parseAndForward() {
     uint8_t command_inv = message;
     bool isValid = !(address & address_inv) && !(command & command_inv);
 
-    // if there is a registered callback function call it
+    // record and, if there is a registered callback function, call it
+    RECORDER_RECORD(RECORDER_CHANNEL_IR_FRAME, command | isValid << 8);
+    TRACE_BEGIN(TRACE_ID_IR_FRAME, command);
     if (irCallback != NULL) {
         irCallback((IRCommand)command, isValid);
     }
+    TRACE_END(TRACE_ID_IR_FRAME);
 
     // reset counters
     bitIndex = 0;
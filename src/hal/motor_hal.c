@@ -13,10 +13,27 @@
  *      void    MOTOR_HAL_stop(Motor *motor)
  *      void    MOTOR_HAL_registerSpeedChangeCallback(Motor* motor, MotorSpeedCallback callback)
  *      void    MOTOR_HAL_registerDirectionChangeCallback(Motor* motor, MotorDirCallback callback)
+ *      void    MOTOR_HAL_enableCurrentSense()
+ *      void    MOTOR_HAL_registerCurrentCallback(Motor* motor, MotorCurrentCallback callback)
+ *      void    MOTOR_HAL_setDecayMode(Motor* motor, MotorDecay decay)
+ *      void    MOTOR_HAL_setCurve(Motor* motor, const MotorCurve *curve)
+ *      void    MOTOR_HAL_setTrim(Motor* motor, uint16_t trim)
  *
  * NOTES:
  *      In our implementation there are two motors attached to each of the L298N channels, so we
  *      have a total of four motors controlled as left and right pairs.
+ *      With STALL_ENABLED the sense pins of the L298N are connected to ground through 0.5Ω
+ *      resistors, whose voltage is read on A0 (P5.5, left) and A1 (P5.4, right). The CCR3 and
+ *      CCR4 of the PWM timer interrupt in the middle of the on-time of each channel, where the
+ *      current is not affected by the switching: they only trigger the conversion, its result is
+ *      read by the ADC14 interrupt at its end.
+ *      With SLOW_DECAY_ENABLED a motor in slow decay has its enable pin held high by the output
+ *      of its CCR, while its active input pin is raised by the CCR0 interrupt at the start of the
+ *      period and lowered by the CCR1/CCR2 interrupt at the end of the on-time: in the off-time
+ *      both inputs are low and the L298N brakes the motor instead of letting it coast.
+ *      The requested speed is mapped to the duty cycle by the curve of the motor, in integer
+ *      arithmetic: the duty cycles are in tenths of percent (‰) and interpolated between the points
+ *      of the curve, that are 10% of the top speed apart, then scaled by the trim of the motor.
  *
  * AUTHOR: Simone Rossi    <simone.rossi-2@studenti.unitn.it>
  *         Andrea Piccin   <andrea.piccin@studenti.unitn.it>
@@ -27,11 +44,21 @@
  * DATE         AUTHOR          DETAIL
  * 05 Feb 2024  Andrea Piccin   Refactoring
  * 11 Feb 2024  Andrea Piccin   Introduced callback mechanism for state change
+ * 18 Oct 2026  Maintainers     Recording of the commanded speed and direction
+ * 18 Oct 2026  Maintainers     Tracing of the commanded speed and direction
+ * 18 Oct 2026  Maintainers     Current sense phase-aligned with the PWM
+ * 18 Oct 2026  Maintainers     Slow decay drive mode
+ * 18 Oct 2026  Maintainers     Speed to duty cycle curves
+ * 18 Oct 2026  Maintainers     Trim of the duty cycle
+ * 19 Oct 2026  Maintainers     Current samples wait for the battery conversion, skipped if refused
+ * 19 Oct 2026  Maintainers     Current samples read by the ADC14 interrupt, no busy waiting
  */
 #include <stdio.h>
 
 #include "../../inc/motor_hal.h"
+#include "../../inc/recorder.h"
 #include "../../inc/driverlib/driverlib.h"
+#include "../../inc/trace.h"
 
 #define MOTOR_TIMER_PERIOD 5000        /* Max value of the counter           */
 #define MOTOR_ENABLE_PORT GPIO_PORT_P2 /* Port for the PWM signals           */
@@ -42,6 +69,37 @@
 #define MOTOR_R_IN2 GPIO_PIN2          /* Right motor's direction pin 2      */
 #define MOTOR_L_IN1 GPIO_PIN4          /* Left motor's direction pin 1       */
 #define MOTOR_L_IN2 GPIO_PIN3          /* Left motor's direction pin 2       */
+#define MOTOR_DUTY_FULL 1000           /* Duty cycle at full speed (‰)       */
+
+#ifdef STALL_ENABLED
+#define MOTOR_SENSE_PORT GPIO_PORT_P5                        /* Port of the sense inputs     */
+#define MOTOR_L_SENSE GPIO_PIN5                              /* Left sense pin, A0           */
+#define MOTOR_R_SENSE GPIO_PIN4                              /* Right sense pin, A1          */
+#define MOTOR_L_SENSE_INPUT ADC_INPUT_A0                     /* ADC input of the left sense  */
+#define MOTOR_R_SENSE_INPUT ADC_INPUT_A1                     /* ADC input of the right sense */
+#define MOTOR_L_SENSE_MEM ADC_MEM1                           /* Memory of the left samples   */
+#define MOTOR_R_SENSE_MEM ADC_MEM2                           /* Memory of the right samples  */
+#define MOTOR_SENSE_INTS (ADC_INT1 | ADC_INT2)               /* Interrupts of the memories   */
+#define MOTOR_SENSE_NONE 2                                   /* No channel is converted      */
+#define MOTOR_L_SENSE_CCR TIMER_A_CAPTURECOMPARE_REGISTER_3  /* CCR of the left samples      */
+#define MOTOR_R_SENSE_CCR TIMER_A_CAPTURECOMPARE_REGISTER_4  /* CCR of the right samples     */
+#define MOTOR_BATTERY_MEM ADC_MEM0                           /* Memory of the battery HAL    */
+#define MOTOR_SENSE_RESISTOR 500                             /* Sense resistor (mΩ)          */
+#endif
+
+#ifdef SLOW_DECAY_ENABLED
+#define MOTOR_SLOW_DECAY_DUTY 500      /* Duty under which MOTOR_DECAY_AUTO is slow (‰) */
+#endif
+
+#if defined(STALL_ENABLED) || defined(SLOW_DECAY_ENABLED)
+Motor *channelMotors[2] = {NULL, NULL}; /* Initialised motors, left and right */
+#endif
+
+#ifdef STALL_ENABLED
+const uint32_t senseMemories[2] = {MOTOR_L_SENSE_MEM, MOTOR_R_SENSE_MEM}; /* Left and right    */
+uint8_t senseChannel = MOTOR_SENSE_NONE;                                  /* Converted channel */
+bool isSensePending[2] = {false, false};                                  /* Queued channels   */
+#endif
 
 /*F************************************************************************************************
  * NAME: void MOTOR_HAL_init()
@@ -51,6 +109,7 @@
  *      [1] Configure the base timer to output a 100Hz signal that will be used in the generation
  *          of the PWM signal
  *      [2] Start the timer
+ *      [3] With SLOW_DECAY_ENABLED, enable the interrupts that drive the input pins
  *
  * INPUTS:
  *      PARAMETERS:
@@ -75,13 +134,23 @@ void MOTOR_HAL_init() {
         TIMER_A_CLOCKSOURCE_DIVIDER_48,      // SMCLK/48 = 500kHz
         MOTOR_TIMER_PERIOD,                  // SMCLK/48/5000 = 100Hz
         TIMER_A_TAIE_INTERRUPT_DISABLE,      // Disable Timer interrupt
+#ifdef SLOW_DECAY_ENABLED
+        TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE,  // Start of the period of the input pins
+#else
         TIMER_A_CCIE_CCR0_INTERRUPT_DISABLE, // Disable CCR0 interrupt
+#endif
         TIMER_A_DO_CLEAR                     // Clear value
     };
     Timer_A_configureUpMode(TIMER_A0_BASE, &upConfig);
 
     // [2] start timer
     Timer_A_startCounter(TIMER_A0_BASE, TIMER_A_UP_MODE);
+
+#ifdef SLOW_DECAY_ENABLED
+    // [3] Interrupts of the start of the period and of the end of the on-time
+    Interrupt_enableInterrupt(INT_TA0_0);
+    Interrupt_enableInterrupt(INT_TA0_N);
+#endif
 }
 
 /*F************************************************************************************************
@@ -146,6 +215,15 @@ void MOTOR_HAL_motorInit(Motor *motor, MotorInitTemplate initTemplate) {
     motor->state.direction = MOTOR_DIR_STOP;
     motor->speedCallback = NULL;
     motor->dirCallback = NULL;
+    motor->currentCallback = NULL;
+    motor->decay = MOTOR_DECAY_FAST;
+    motor->isSlowDecay = false;
+    motor->curve = NULL;
+    motor->trim = MOTOR_TRIM_NONE;
+    motor->duty = 0;
+#if defined(STALL_ENABLED) || defined(SLOW_DECAY_ENABLED)
+    channelMotors[initTemplate] = motor;
+#endif
 
     // [4] Set up the Capture Compare Register (CCR) for the PWM signal generation
     const Timer_A_CompareModeConfig config = {motor->ccr, TIMER_A_CAPTURECOMPARE_INTERRUPT_DISABLE,
@@ -153,11 +231,188 @@ void MOTOR_HAL_motorInit(Motor *motor, MotorInitTemplate initTemplate) {
     Timer_A_initCompare(TIMER_A0_BASE, &config);
 }
 
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_driveInputs(Motor *motor)
+ *
+ * DESCRIPTION:
+ *      Sets the IN1 and IN2 pins of a motor for its direction: both low to stop it, the pin of
+ *      the direction high otherwise. In slow decay the pin of the direction is left to the
+ *      interrupts of the PWM timer, unless the motor runs at full duty cycle.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*      motor       Target motor
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void MOTOR_HAL_driveInputs(const Motor *motor) {
+    GPIO_setOutputLowOnPin(MOTOR_INPUT_PORT, motor->in1_pin | motor->in2_pin);
+    if (motor->isSlowDecay && motor->duty < MOTOR_DUTY_FULL)
+        return;
+    if (motor->state.direction == MOTOR_DIR_FORWARD)
+        GPIO_setOutputHighOnPin(MOTOR_INPUT_PORT, motor->in1_pin);
+    else if (motor->state.direction == MOTOR_DIR_REVERSE)
+        GPIO_setOutputHighOnPin(MOTOR_INPUT_PORT, motor->in2_pin);
+}
+
+#ifdef SLOW_DECAY_ENABLED
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_updateDecay(Motor *motor)
+ *
+ * DESCRIPTION:
+ *      Applies the decay mode of a motor at its current duty cycle:
+ *      [1] Resolve the automatic mode by duty cycle
+ *      [2] Slow decay: the enable pin is held high, the CCR interrupts at the end of the on-time
+ *      [3] Fast decay: the enable pin outputs the PWM, the CCR does not interrupt
+ *      [4] Set the input pins for the new mode
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*      motor       Target motor
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          bool        motor->isSlowDecay      Set to the applied mode
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The CCR keeps the duty cycle in both modes, only its output mode changes.
+ */
+static void MOTOR_HAL_updateDecay(Motor *motor) {
+    // [1] Mode at this duty cycle
+    bool isSlow = motor->decay == MOTOR_DECAY_SLOW ||
+                  (motor->decay == MOTOR_DECAY_AUTO && motor->duty < MOTOR_SLOW_DECAY_DUTY);
+    if (isSlow == motor->isSlowDecay)
+        return;
+    uint16_t dutyCycle = (uint32_t)motor->duty * MOTOR_TIMER_PERIOD / MOTOR_DUTY_FULL;
+
+    if (isSlow) {
+        // [2] Enable pin high, end of the on-time by interrupt
+        const Timer_A_CompareModeConfig config = {
+            motor->ccr, TIMER_A_CAPTURECOMPARE_INTERRUPT_ENABLE, TIMER_A_OUTPUTMODE_OUTBITVALUE,
+            dutyCycle};
+        Timer_A_initCompare(TIMER_A0_BASE, &config);
+        Timer_A_setOutputForOutputModeOutBitValue(TIMER_A0_BASE, motor->ccr,
+                                                  TIMER_A_OUTPUTMODE_OUTBITVALUE_HIGH);
+    } else {
+        // [3] PWM on the enable pin
+        const Timer_A_CompareModeConfig config = {
+            motor->ccr, TIMER_A_CAPTURECOMPARE_INTERRUPT_DISABLE, TIMER_A_OUTPUTMODE_TOGGLE_SET,
+            dutyCycle};
+        Timer_A_initCompare(TIMER_A0_BASE, &config);
+    }
+
+    // [4] Input pins
+    motor->isSlowDecay = isSlow;
+    MOTOR_HAL_driveInputs(motor);
+}
+#endif
+
+/*F************************************************************************************************
+ * NAME: uint16_t MOTOR_HAL_lookupDuty(const Motor *motor, uint8_t speed)
+ *
+ * DESCRIPTION:
+ *      Maps a requested speed to the duty cycle of a motor, by linear interpolation between the
+ *      two points of its curve around the speed. Without a curve the duty cycle is the speed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const Motor*    motor       Target motor
+ *          uint8_t         speed       Requested speed in percentage 0 to 100
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Duty cycle (‰)
+ *
+ *  NOTE:
+ *      A stopped motor has no duty cycle, even if its curve starts above zero.
+ */
+static uint16_t MOTOR_HAL_lookupDuty(const Motor *motor, uint8_t speed) {
+    if (speed == 0)
+        return 0;
+    if (speed >= 100)
+        return motor->curve == NULL ? MOTOR_DUTY_FULL : motor->curve->duty[MOTOR_CURVE_POINTS - 1];
+    if (motor->curve == NULL)
+        return speed * MOTOR_DUTY_FULL / 100;
+
+    const uint16_t *duty = &motor->curve->duty[speed / 10];
+    return duty[0] + ((int32_t)duty[1] - duty[0]) * (speed % 10) / 10;
+}
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_applyDuty(Motor *motor)
+ *
+ * DESCRIPTION:
+ *      Applies the duty cycle of the current speed of a motor:
+ *      [1] Look up the duty cycle on the curve, trim it and update the PWM signal
+ *      [2] Move the current sample to the middle of the new on-time
+ *      [3] Apply the decay mode at the new duty cycle
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*      motor       Target motor
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          uint16_t    motor->duty     Set to the applied duty cycle
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void MOTOR_HAL_applyDuty(Motor *motor) {
+    // [1] PWM signal
+    uint16_t duty =
+        (uint32_t)MOTOR_HAL_lookupDuty(motor, motor->state.speed) * motor->trim / MOTOR_TRIM_NONE;
+    uint16_t dutyCycle = (uint32_t)duty * MOTOR_TIMER_PERIOD / MOTOR_DUTY_FULL;
+    Timer_A_setCompareValue(TIMER_A0_BASE, motor->ccr, dutyCycle);
+
+    // [2] Current sample
+#ifdef STALL_ENABLED
+    Timer_A_setCompareValue(TIMER_A0_BASE,
+                            motor->in1_pin == MOTOR_R_IN1 ? MOTOR_R_SENSE_CCR : MOTOR_L_SENSE_CCR,
+                            dutyCycle / 2);
+#endif
+
+    // [3] Decay mode, in slow decay the input pin is static at full duty cycle
+#ifdef SLOW_DECAY_ENABLED
+    bool isFullChange =
+        motor->isSlowDecay && (motor->duty == MOTOR_DUTY_FULL || duty == MOTOR_DUTY_FULL);
+#endif
+    motor->duty = duty;
+#ifdef SLOW_DECAY_ENABLED
+    if (isFullChange)
+        MOTOR_HAL_driveInputs(motor);
+    MOTOR_HAL_updateDecay(motor);
+#endif
+}
+
 /*F************************************************************************************************
  * NAME: void MOTOR_HAL_setSpeed(Motor *motor, uint8_t speed);
  *
  * DESCRIPTION:
- *      Set the speed of a motor and updates the motor state
+ *      Set the speed of a motor and updates the motor state, then applies the duty cycle of the
+ *      new speed
  *
  * INPUTS:
  *      PARAMETERS:
@@ -177,13 +432,12 @@ void MOTOR_HAL_motorInit(Motor *motor, MotorInitTemplate initTemplate) {
 void MOTOR_HAL_setSpeed(Motor *motor, uint8_t speed) {
     if (motor->state.speed == speed)
         return;
+    RECORDER_RECORD(RECORDER_CHANNEL_MOTOR_SPEED, speed | (motor->in1_pin == MOTOR_R_IN1) << 8);
+    TRACE_INSTANT(TRACE_ID_MOTOR_SPEED, speed | (motor->in1_pin == MOTOR_R_IN1) << 8);
 
-    // Update PWM signal
-    uint16_t dutyCycle = speed * MOTOR_TIMER_PERIOD / 100;
-    Timer_A_setCompareValue(TIMER_A0_BASE, motor->ccr, dutyCycle);
-
-    // Update motor info
+    // Update motor info and PWM signal
     motor->state.speed = speed;
+    MOTOR_HAL_applyDuty(motor);
 
     // Notify the state change
     if (motor->speedCallback != NULL)
@@ -194,9 +448,8 @@ void MOTOR_HAL_setSpeed(Motor *motor, uint8_t speed) {
  * NAME: void MOTOR_HAL_setDirection(Motor *motor, MotorDirection direction);
  *
  * DESCRIPTION:
- *      Stop the motor by setting its IN1 and IN2 pins to zero, if the direction is different from
- *      MOTOR_DIR_STOP set the correct pin to HIGH output.
- *      Finally, update the motor state.
+ *      Update the motor state, then stop the motor by setting its IN1 and IN2 pins to zero, if the
+ *      direction is different from MOTOR_DIR_STOP set the correct pin to HIGH output.
  *
  * INPUTS:
  *      PARAMETERS:
@@ -216,20 +469,22 @@ void MOTOR_HAL_setSpeed(Motor *motor, uint8_t speed) {
 void MOTOR_HAL_setDirection(Motor *motor, MotorDirection direction) {
     if (motor->state.direction == direction)
         return;
-
-    // Stop the car by clearing the current configuration
-    GPIO_setOutputLowOnPin(MOTOR_INPUT_PORT, motor->in1_pin | motor->in2_pin);
-
-    // Set the new pins
-    if (direction == MOTOR_DIR_FORWARD)
-        GPIO_setOutputHighOnPin(MOTOR_INPUT_PORT, motor->in1_pin);
-    else if (direction == MOTOR_DIR_REVERSE)
-        GPIO_setOutputHighOnPin(MOTOR_INPUT_PORT, motor->in2_pin);
+    RECORDER_RECORD(RECORDER_CHANNEL_MOTOR_DIRECTION,
+                    direction | (motor->in1_pin == MOTOR_R_IN1) << 8);
+    TRACE_INSTANT(TRACE_ID_MOTOR_DIRECTION, direction | (motor->in1_pin == MOTOR_R_IN1) << 8);
 
     // Update direction and speed
     motor->state.direction = direction;
-    if (direction == MOTOR_DIR_STOP)
+    if (direction == MOTOR_DIR_STOP) {
         motor->state.speed = 0;
+        motor->duty = 0;
+    }
+
+    // Set the new pins, a stopped motor has both of them low
+    MOTOR_HAL_driveInputs(motor);
+#ifdef SLOW_DECAY_ENABLED
+    MOTOR_HAL_updateDecay(motor);
+#endif
 
     // Notify the state change
     if (motor->dirCallback != NULL)
@@ -309,4 +564,413 @@ void MOTOR_HAL_registerSpeedChangeCallback(Motor *motor, MotorSpeedCallback call
  */
 void MOTOR_HAL_registerDirectionChangeCallback(Motor *motor, MotorDirCallback callback) {
     motor->dirCallback = callback;
-}
\ No newline at end of file
+}
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_enableCurrentSense()
+ *
+ * DESCRIPTION:
+ *      Starts the sampling of the current of both channels:
+ *      [1] Configure the sense pins as analog inputs
+ *      [2] Assign an ADC memory register to each input, that interrupts at the end of its
+ *          conversion
+ *      [3] Set up the CCRs that interrupt in the middle of the on-time
+ *      [4] Enable the interrupts of the timer and of the ADC
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The ADC is initialised by BATTERY_HAL_init(), that must be called before.
+ */
+void MOTOR_HAL_enableCurrentSense() {
+#ifdef STALL_ENABLED
+    // [1] Sense inputs
+    GPIO_setAsPeripheralModuleFunctionInputPin(MOTOR_SENSE_PORT, MOTOR_L_SENSE | MOTOR_R_SENSE,
+                                               GPIO_TERTIARY_MODULE_FUNCTION);
+
+    // [2] ADC memory registers, the conversion must be disabled to configure them
+    ADC14_disableConversion();
+    ADC14_configureConversionMemory(MOTOR_L_SENSE_MEM, ADC_VREFPOS_AVCC_VREFNEG_VSS,
+                                    MOTOR_L_SENSE_INPUT, false);
+    ADC14_configureConversionMemory(MOTOR_R_SENSE_MEM, ADC_VREFPOS_AVCC_VREFNEG_VSS,
+                                    MOTOR_R_SENSE_INPUT, false);
+    ADC14_clearInterruptFlag(MOTOR_SENSE_INTS);
+    ADC14_enableInterrupt(MOTOR_SENSE_INTS);
+    ADC14_enableConversion();
+
+    // [3] Sampling CCRs, they do not drive any pin
+    const Timer_A_CompareModeConfig leftConfig = {
+        MOTOR_L_SENSE_CCR, TIMER_A_CAPTURECOMPARE_INTERRUPT_ENABLE, TIMER_A_OUTPUTMODE_OUTBITVALUE,
+        0};
+    const Timer_A_CompareModeConfig rightConfig = {
+        MOTOR_R_SENSE_CCR, TIMER_A_CAPTURECOMPARE_INTERRUPT_ENABLE, TIMER_A_OUTPUTMODE_OUTBITVALUE,
+        0};
+    Timer_A_initCompare(TIMER_A0_BASE, &leftConfig);
+    Timer_A_initCompare(TIMER_A0_BASE, &rightConfig);
+
+    // [4] Timer and ADC interrupts
+    Interrupt_enableInterrupt(INT_TA0_N);
+    Interrupt_enableInterrupt(INT_ADC14);
+#endif
+}
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_registerCurrentCallback(Motor* motor, MotorCurrentCallback callback)
+ *
+ * DESCRIPTION:
+ *      Registers the given MotorCurrentCallback as the function to call with every current
+ *      sample of the specified motor.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*                  motor                   Specifies the target motor
+ *          MotorCurrentCallback    callback                The function to register as callback
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          MotorCurrentCallback    motor->currentCallback  Set to the given callback
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void MOTOR_HAL_registerCurrentCallback(Motor *motor, MotorCurrentCallback callback) {
+    motor->currentCallback = callback;
+}
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_setDecayMode(Motor* motor, MotorDecay decay)
+ *
+ * DESCRIPTION:
+ *      Sets the decay mode of a motor and applies it at the current speed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*          motor           Specifies the target motor
+ *          MotorDecay      decay           Decay mode of the motor
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          MotorDecay      motor->decay    Set to the given mode
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Without SLOW_DECAY_ENABLED the mode is stored but the motor stays in fast decay.
+ */
+void MOTOR_HAL_setDecayMode(Motor *motor, MotorDecay decay) {
+    motor->decay = decay;
+#ifdef SLOW_DECAY_ENABLED
+    MOTOR_HAL_updateDecay(motor);
+#endif
+}
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_setCurve(Motor* motor, const MotorCurve *curve)
+ *
+ * DESCRIPTION:
+ *      Sets the speed curve of a motor and applies it at the current speed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*              motor           Specifies the target motor
+ *          const MotorCurve*   curve           Speed curve, NULL to map the speed linearly
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          const MotorCurve*   motor->curve    Set to the given curve
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void MOTOR_HAL_setCurve(Motor *motor, const MotorCurve *curve) {
+    motor->curve = curve;
+    MOTOR_HAL_applyDuty(motor);
+}
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_setTrim(Motor* motor, uint16_t trim)
+ *
+ * DESCRIPTION:
+ *      Sets the trim of a motor and applies it at the current speed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*          motor           Specifies the target motor
+ *          uint16_t        trim            Applied fraction of the duty cycle (‰)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          uint16_t        motor->trim     Set to the given trim, at most MOTOR_TRIM_NONE
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void MOTOR_HAL_setTrim(Motor *motor, uint16_t trim) {
+    if (trim > MOTOR_TRIM_NONE)
+        trim = MOTOR_TRIM_NONE;
+    if (motor->trim == trim)
+        return;
+    motor->trim = trim;
+    MOTOR_HAL_applyDuty(motor);
+}
+
+#ifdef STALL_ENABLED
+/*F************************************************************************************************
+ * NAME: bool MOTOR_HAL_selectMemory(uint32_t memory)
+ *
+ * DESCRIPTION:
+ *      Moves the single sample mode of the ADC to a memory, the conversions are disabled while it
+ *      is configured.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    memory      ADC memory register to convert
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the ADC refused the configuration
+ *
+ *  NOTE:
+ *      The ADC refuses the configuration while it converts, the callers check ADC14_isBusy()
+ *      first.
+ */
+static bool MOTOR_HAL_selectMemory(uint32_t memory) {
+    ADC14_disableConversion();
+    return ADC14_configureSingleSampleMode(memory, true) && ADC14_enableConversion();
+}
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_startCurrent(uint8_t channel)
+ *
+ * DESCRIPTION:
+ *      Starts the conversion of the current of a channel, its result is read by ADC14_IRQHandler():
+ *      [1] Queue it behind the conversion of the other channel
+ *      [2] Skip it while the battery HAL converts
+ *      [3] Move the single sample mode to the memory of the channel and trigger the conversion
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     channel         0 for the left channel, 1 for the right one
+ *      GLOBALS:
+ *          uint32_t[]  senseMemories   ADC memory register of every channel
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint8_t     senseChannel    Set to the channel if its conversion starts
+ *          bool[]      isSensePending  Set for the channel if it is queued
+ *
+ *  NOTE:
+ *      The ADC is shared with the battery HAL, whose readings run in the Timer32 interrupt and
+ *      can return before their conversion ends: a sample that finds it converting is skipped, the
+ *      next one comes a period later.
+ */
+static void MOTOR_HAL_startCurrent(uint8_t channel) {
+    // [1] Conversion of the other channel
+    if (senseChannel != MOTOR_SENSE_NONE) {
+        isSensePending[channel] = true;
+        return;
+    }
+
+    // [2] Conversion of the battery
+    if (ADC14_isBusy())
+        return;
+
+    // [3] Conversion of the channel, about 20µs at 1MHz
+    if (!MOTOR_HAL_selectMemory(senseMemories[channel])) {
+        MOTOR_HAL_selectMemory(MOTOR_BATTERY_MEM);
+        return;
+    }
+    senseChannel = channel;
+    ADC14_toggleConversionTrigger();
+}
+
+/*ISR**********************************************************************************************
+ * NAME: void ADC14_IRQHandler()
+ *
+ * DESCRIPTION:
+ *      Interrupt of the end of a conversion of the current:
+ *      [1] Read the result of the channel and clear the flags
+ *      [2] Start the conversion of the channel queued behind it, or give the single sample mode
+ *          back to the battery
+ *      [3] Rescale the result and pass it to the callback of the motor, the current is given by:
+ *              mA = ((res * 3300) / 16384) * 1000 / SENSE_RESISTOR
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Motor*[]    channelMotors
+ *          uint8_t     senseChannel    Channel whose current is converted
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint8_t     senseChannel    Set to the queued channel or to MOTOR_SENSE_NONE
+ *          bool[]      isSensePending  Cleared for the started channel
+ *
+ *  NOTE:
+ *      The battery memory does not interrupt, its readings poll it. A battery conversion
+ *      triggered while the single sample mode is on a channel memory ends here with no channel:
+ *      its result is discarded and the mode is moved back, if the ADC was busy the first time.
+ */
+void ADC14_IRQHandler() {
+    // [1] Result
+    uint64_t status = ADC14_getEnabledInterruptStatus();
+    ADC14_clearInterruptFlag(status);
+    uint8_t channel = senseChannel;
+    senseChannel = MOTOR_SENSE_NONE;
+    uint32_t result = 0;
+    if (channel != MOTOR_SENSE_NONE && (status & senseMemories[channel]))
+        result = ADC14_getResult(senseMemories[channel]);
+    else
+        channel = MOTOR_SENSE_NONE;
+
+    // [2] Queued channel or battery
+    for (uint8_t i = 0; i < 2 && senseChannel == MOTOR_SENSE_NONE; i++) {
+        if (isSensePending[i]) {
+            isSensePending[i] = false;
+            MOTOR_HAL_startCurrent(i);
+        }
+    }
+    if (senseChannel == MOTOR_SENSE_NONE && !ADC14_isBusy())
+        MOTOR_HAL_selectMemory(MOTOR_BATTERY_MEM);
+
+    // [3] Callback
+    if (channel == MOTOR_SENSE_NONE)
+        return;
+    Motor *motor = channelMotors[channel];
+    if (motor != NULL && motor->currentCallback != NULL)
+        motor->currentCallback(motor, result * 3300 / 16384 * 1000 / MOTOR_SENSE_RESISTOR);
+}
+
+#endif
+
+#ifdef SLOW_DECAY_ENABLED
+/*ISR**********************************************************************************************
+ * NAME: void TA0_0_IRQHandler()
+ *
+ * DESCRIPTION:
+ *      Interrupt of the CCR0 of the PWM timer, at the start of every period it raises the input
+ *      pin of the direction of the motors in slow decay, starting their on-time.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Motor*[]    channelMotors
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      At full duty cycle the pin is static, it is set by MOTOR_HAL_driveInputs().
+ */
+void TA0_0_IRQHandler() {
+    Timer_A_clearCaptureCompareInterrupt(TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_0);
+    for (uint8_t i = 0; i < 2; i++) {
+        const Motor *motor = channelMotors[i];
+        if (motor == NULL || !motor->isSlowDecay || motor->duty == 0 ||
+            motor->duty >= MOTOR_DUTY_FULL)
+            continue;
+        if (motor->state.direction == MOTOR_DIR_FORWARD)
+            GPIO_setOutputHighOnPin(MOTOR_INPUT_PORT, motor->in1_pin);
+        else if (motor->state.direction == MOTOR_DIR_REVERSE)
+            GPIO_setOutputHighOnPin(MOTOR_INPUT_PORT, motor->in2_pin);
+    }
+}
+#endif
+
+#if defined(STALL_ENABLED) || defined(SLOW_DECAY_ENABLED)
+/*ISR**********************************************************************************************
+ * NAME: void TA0_N_IRQHandler()
+ *
+ * DESCRIPTION:
+ *      Interrupt of the CCRs of the PWM timer:
+ *      [1] CCR1 and CCR2: ends the on-time of the motors in slow decay by lowering their input
+ *          pins, the L298N brakes them until the next period
+ *      [2] CCR3 and CCR4: starts the conversion of the current of the channels whose compare has
+ *          matched, ADC14_IRQHandler() passes it to their callback
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Motor*[]    channelMotors
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The CCR1 and CCR2 interrupts are only enabled in slow decay. No sample is taken while a
+ *      channel is stopped, its compare matches at the start of the period. Nothing waits for the
+ *      ADC, the routine takes a few µs whatever the conversions in progress.
+ */
+void TA0_N_IRQHandler() {
+#ifdef SLOW_DECAY_ENABLED
+    // [1] End of the on-time
+    for (uint8_t i = 0; i < 2; i++) {
+        const Motor *motor = channelMotors[i];
+        if (motor == NULL ||
+            !(Timer_A_getCaptureCompareEnabledInterruptStatus(TIMER_A0_BASE, motor->ccr) &
+              TIMER_A_CAPTURECOMPARE_INTERRUPT_FLAG))
+            continue;
+        Timer_A_clearCaptureCompareInterrupt(TIMER_A0_BASE, motor->ccr);
+        if (motor->duty < MOTOR_DUTY_FULL)
+            GPIO_setOutputLowOnPin(MOTOR_INPUT_PORT, motor->in1_pin | motor->in2_pin);
+    }
+#endif
+
+#ifdef STALL_ENABLED
+    // [2] Current samples
+    static const uint_fast16_t ccrs[2] = {MOTOR_L_SENSE_CCR, MOTOR_R_SENSE_CCR};
+    for (uint8_t i = 0; i < 2; i++) {
+        if (!(Timer_A_getCaptureCompareEnabledInterruptStatus(TIMER_A0_BASE, ccrs[i]) &
+              TIMER_A_CAPTURECOMPARE_INTERRUPT_FLAG))
+            continue;
+        Timer_A_clearCaptureCompareInterrupt(TIMER_A0_BASE, ccrs[i]);
+
+        const Motor *motor = channelMotors[i];
+        if (motor == NULL || motor->state.direction == MOTOR_DIR_STOP || motor->state.speed == 0)
+            continue;
+        MOTOR_HAL_startCurrent(i);
+    }
+#endif
+}
+#endif
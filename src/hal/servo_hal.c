@@ -7,8 +7,11 @@
  *
  * PUBLIC FUNCTIONS:
  *      void    SERVO_HAL_init(Servo* servo)
+ *      void    SERVO_HAL_resume(Servo* servo, int8_t position)
  *      void    SERVO_HAL_setPosition(Servo* servo, int8_t position)
  *      void    SERVO_HAL_registerPositionReachedCallback(ServoCallback callback)
+ *      void    SERVO_HAL_sweepTo(Servo* servo, int8_t position)
+ *      int8_t  SERVO_HAL_getAngle(const Servo* servo, uint32_t ticks)
  *
  * NOTES:
  *      The PWM timings are calculated basing on the SG90 datasheet:
@@ -27,12 +30,19 @@
  * 15 Feb 2024  Andrea Piccin       Refactoring, functions using timer A0 now use TIMER32_0
  * 20 Feb 2024  Andrea Piccin       Introduced shared 32-bit timer
  * 21 Feb 2024  Andrea Piccin       Introduced resetPosition() function
+ * 18 Oct 2026  Maintainers         Recording of the commanded position
+ * 18 Oct 2026  Maintainers         Tracing of the commanded position
+ * 18 Oct 2026  Maintainers         Resume without homing after a warm reset
+ * 18 Oct 2026  Maintainers         Continuous sweep and motion model
  */
+#include <stdbool.h>
 #include <stdlib.h>
 
 #include "../../inc/driverlib/driverlib.h"
+#include "../../inc/recorder.h"
 #include "../../inc/servo_hal.h"
 #include "../../inc/timer_hal.h"
+#include "../../inc/trace.h"
 
 #define SERVO_PORT GPIO_PORT_P5    /* Port for the PWM signals                                */
 #define SERVO_PIN GPIO_PIN6        /* Pin for the PWM signals                                 */
@@ -51,23 +61,23 @@ ServoCallback servoCallback; /* function to execute when the servo reaches its f
 
 /* utility function declaration */
 void SERVO_HAL_onTimerEnded();
+uint16_t SERVO_HAL_positionToTicks(int8_t position);
+static void SERVO_HAL_startMotion(Servo *servo, int8_t position);
 
 /*F************************************************************************************************
- * NAME: void SERVO_HAL_init(Servo* servo);
+ * NAME: void SERVO_HAL_configure(Servo* servo, int8_t position);
  *
  * DESCRIPTION:
- *      Initialises a Servo motor instance setting the initial position to the value in between
- *      the min and max position values. The steps of the procedure are:
+ *      Configures the PWM signal of a servo for the given position. The steps of the procedure are:
  *      [1] Initialise servo's values
  *      [2] Configure servo's pin
  *      [3] Configure the  base timer
  *      [4] Set up the Capture Compare Register (CCR) for the PWM signal generation
- *      [5] Wait for the servo to be at 0 deg position
- *      [6] Enable timer interrupts
  *
  * INPUTS:
  *      PARAMETERS:
- *          Servo*              servo           Motor that has to be initialised
+ *          Servo*              servo           Motor that has to be configured
+ *          int8_t              position        Position commanded by the PWM signal
  *      GLOBALS:
  *          None
  *
@@ -79,10 +89,12 @@ void SERVO_HAL_onTimerEnded();
  *
  *  NOTE:
  */
-void SERVO_HAL_init(Servo *servo) {
-    Interrupt_disableMaster();
+static void SERVO_HAL_configure(Servo *servo, int8_t position) {
     // [1] Initialize servo's values
     servo->ccr = TIMER_A_CAPTURECOMPARE_REGISTER_1;
+    servo->state.position = position;
+    servo->state.origin = position;
+    servo->state.startTicks = TIMER_HAL_getTicks();
     servoCallback = NULL;
 
     // [2] Configure servo's pin
@@ -107,20 +119,83 @@ void SERVO_HAL_init(Servo *servo) {
         servo->ccr,
         TIMER_A_CAPTURECOMPARE_INTERRUPT_DISABLE,
         TIMER_A_OUTPUTMODE_TOGGLE_SET,
-        SERVO_MID_POS_TICKS,
+        SERVO_HAL_positionToTicks(position),
     };
     Timer_A_initCompare(TIMER_A2_BASE, &compareConfig);
+}
+
+/*F************************************************************************************************
+ * NAME: void SERVO_HAL_init(Servo* servo);
+ *
+ * DESCRIPTION:
+ *      Initialises a Servo motor instance setting the initial position to the value in between
+ *      the min and max position values. The steps of the procedure are:
+ *      [1] Configure the PWM signal for the 0 deg position
+ *      [2] Wait for the servo to be at 0 deg position
+ *      [3] Enable timer interrupts
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Servo*              servo           Motor that has to be initialised
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          Servo*              servo           All the fields of the struct are set
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SERVO_HAL_init(Servo *servo) {
+    Interrupt_disableMaster();
+    // [1] Configure the PWM signal for the 0 deg position
+    SERVO_HAL_configure(servo, 0);
 
-    // [5] Wait for the servo to be at 0 deg position
+    // [2] Wait for the servo to be at 0 deg position
     TIMER_HAL_acquireSharedTimer(SERVO_ADJ_180DEG_TICKS, SERVO_HAL_onTimerEnded);
     while (Timer32_getValue(TIMER32_0_BASE) != 0)
         ;
     TIMER_HAL_releaseSharedTimer();
-    servo->state.position = 0;
 
+    // [3] Enable timer interrupts
     Interrupt_enableMaster();
 }
 
+/*F************************************************************************************************
+ * NAME: void SERVO_HAL_resume(Servo* servo, int8_t position);
+ *
+ * DESCRIPTION:
+ *      Initialises a Servo motor instance that is already at the given position, without waiting
+ *      for it to travel.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Servo*              servo           Motor that has to be initialised
+ *          int8_t              position        Position commanded before the reset
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          Servo*              servo           All the fields of the struct are set
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The servo receives no pulses during the few ms of a warm reset and does not move, so the
+ *      full travel wait of SERVO_HAL_init() is skipped.
+ */
+void SERVO_HAL_resume(Servo *servo, int8_t position) {
+    if (position < SERVO_MIN_POSITION)
+        position = SERVO_MIN_POSITION;
+
+    if (position > SERVO_MAX_POSITION)
+        position = SERVO_MAX_POSITION;
+    SERVO_HAL_configure(servo, position);
+}
+
 /*F************************************************************************************************
  * NAME: void SERVO_HAL_positionToTicks(int8_t position);
  *
@@ -186,6 +261,8 @@ void SERVO_HAL_setPosition(Servo *servo, int8_t position) {
 
     if (position > SERVO_MAX_POSITION)
         position = SERVO_MAX_POSITION;
+    RECORDER_RECORD(RECORDER_CHANNEL_SERVO, (uint8_t)position);
+    TRACE_INSTANT(TRACE_ID_SERVO, (uint8_t)position);
 
     // calculate duty time ticks
     uint16_t dutyCycleTicks = SERVO_HAL_positionToTicks(position);
@@ -201,7 +278,7 @@ void SERVO_HAL_setPosition(Servo *servo, int8_t position) {
         uint32_t ticks =
             (abs(position - servo->state.position) * 1.0 / 180) * SERVO_ADJ_180DEG_TICKS;
         TIMER_HAL_acquireSharedTimer(ticks, SERVO_HAL_onTimerEnded);
-        servo->state.position = position;
+        SERVO_HAL_startMotion(servo, position);
     }
 }
 /*F************************************************************************************************
@@ -227,7 +304,118 @@ void SERVO_HAL_setPosition(Servo *servo, int8_t position) {
 void SERVO_HAL_resetPosition(Servo *servo) {
     Timer_A_setCompareValue(TIMER_A2_BASE, servo->ccr, SERVO_MID_POS_TICKS);
     Timer_A_clearTimer(TIMER_A2_BASE);
-    servo->state.position = 0;
+    SERVO_HAL_startMotion(servo, 0);
+}
+
+/*F************************************************************************************************
+ * NAME: void SERVO_HAL_sweepTo(Servo* servo, int8_t position);
+ *
+ * DESCRIPTION:
+ *      Set the position of a servo without notifying when it is reached, the servo keeps moving
+ *      while the next position is commanded.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Servo*      servo                      Target servo
+ *          int8_t      position                   Specifies the position to which rotate.
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          ServoState  servo->state               Set on the new motion
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The shared timer is not used, the position reached callback is not invoked.
+ */
+void SERVO_HAL_sweepTo(Servo *servo, int8_t position) {
+    if (position < SERVO_MIN_POSITION)
+        position = SERVO_MIN_POSITION;
+
+    if (position > SERVO_MAX_POSITION)
+        position = SERVO_MAX_POSITION;
+    RECORDER_RECORD(RECORDER_CHANNEL_SERVO, (uint8_t)position);
+    TRACE_INSTANT(TRACE_ID_SERVO, (uint8_t)position);
+
+    Timer_A_setCompareValue(TIMER_A2_BASE, servo->ccr, SERVO_HAL_positionToTicks(position));
+    SERVO_HAL_startMotion(servo, position);
+}
+
+/*F************************************************************************************************
+ * NAME: int8_t SERVO_HAL_getAngle(const Servo* servo, uint32_t ticks);
+ *
+ * DESCRIPTION:
+ *      Returns the angle of a servo at a given time, interpolated by the motion model: the servo
+ *      turns at constant speed from the origin to the commanded position.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const Servo*    servo                  Target servo
+ *          uint32_t        ticks                  Time, in ticks of the timer HAL
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int8_t
+ *          Value:  Angle of the servo (deg), the origin before the command
+ *
+ *  NOTE:
+ *      The speed is the one of the travel times, 180 deg in SERVO_ADJ_180DEG_TICKS.
+ */
+int8_t SERVO_HAL_getAngle(const Servo *servo, uint32_t ticks) {
+    int32_t elapsed = (int32_t)(ticks - servo->state.startTicks);
+    int16_t travel = servo->state.position - servo->state.origin;
+    if (elapsed <= 0)
+        return servo->state.origin;
+    if (elapsed >= SERVO_ADJ_180DEG_TICKS)
+        return servo->state.position;
+
+    int16_t swept = elapsed * 180 / SERVO_ADJ_180DEG_TICKS;
+    if (swept >= abs(travel))
+        return servo->state.position;
+    return servo->state.origin + (travel > 0 ? swept : -swept);
+}
+
+/*F************************************************************************************************
+ * NAME: void SERVO_HAL_startMotion(Servo* servo, int8_t position);
+ *
+ * DESCRIPTION:
+ *      Updates the motion model with a new commanded position, starting from the angle reached
+ *      by the previous motion. A position further in the direction of a motion in progress
+ *      extends it, the servo does not slow down.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Servo*      servo                      Target servo
+ *          int8_t      position                   Commanded position
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          ServoState  servo->state               Set on the new motion
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void SERVO_HAL_startMotion(Servo *servo, int8_t position) {
+    uint32_t now = TIMER_HAL_getTicks();
+    int8_t angle = SERVO_HAL_getAngle(servo, now);
+    int16_t travel = servo->state.position - servo->state.origin;
+    bool isMoving = angle != servo->state.position;
+    if (!isMoving || (position - angle) * travel <= 0) {
+        servo->state.origin = angle;
+        servo->state.startTicks = now;
+    }
+    servo->state.position = position;
 }
 
 /*F************************************************************************************************
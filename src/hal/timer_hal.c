@@ -13,6 +13,7 @@
  *      void    TIMER_HAL_registerPeriodicTimerCallback(TimerCallback callback);
  *      void    TIMER_HAL_acquireSharedTimer(uint32_t count, TimerCallback callback);
  *      void    TIMER_HAL_releaseSharedTimer();
+ *      uint32_t TIMER_HAL_getTicks();
  *
  * NOTES:
  *
@@ -21,14 +22,25 @@
  * START DATE: 20 Feb 2024
  *
  * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Recorded expirations, elapsed time of the periodic timer
+ * 18 Oct 2026  Maintainers     Tracing of the callbacks
  */
 #include <stdbool.h>
 #include <stddef.h>
 
 #include "../../inc/driverlib/driverlib.h"
+#include "../../inc/recorder.h"
 #include "../../inc/timer_hal.h"
+#include "../../inc/trace.h"
 
 TimerCallback periodicCallback;
+TimerCallback sharedCallback;      /* Function of the current owner of the shared timer       */
+volatile uint32_t periodicCount;   /* Ticks of a period of the periodic timer                 */
+volatile uint32_t periodicElapsed; /* Ticks of the completed periods                          */
+
+/* utility function declaration */
+void TIMER_HAL_onSharedTimerEnded();
 
 /*F************************************************************************************************
  * NAME: void TIMER_HAL_init();
@@ -83,12 +95,16 @@ void TIMER_HAL_init() {
  *      PARAMETERS:
  *          None
  *      GLOBALS:
- *          None
+ *          uint32_t          periodicCount     Set to count
+ *          uint32_t          periodicElapsed   Set to the elapsed time
  *
  *  NOTE:
  *      The callback function must clear the TIMER32_1_INTERRUPT flag.
  */
 void TIMER_HAL_setupPeriodicTimer(uint32_t count) {
+    // a new period keeps the elapsed time running
+    periodicElapsed = TIMER_HAL_getTicks();
+    periodicCount = count;
     Timer32_setCount(TIMER32_1_BASE, count);
     Timer32_startTimer(TIMER32_1_BASE, false);
 }
@@ -140,10 +156,13 @@ void TIMER_HAL_registerPeriodicTimerCallback(TimerCallback callback) {
  *
  *  NOTE:
  *      The callback function must clear the TIMER32_0_INTERRUPT flag.
+ *      The callback is invoked through TIMER_HAL_onSharedTimerEnded() so that the expiration can
+ *      be recorded.
  */
 void TIMER_HAL_acquireSharedTimer(uint32_t count, TimerCallback callback) {
     Timer32_setCount(TIMER32_0_BASE, count);
-    Interrupt_registerInterrupt(INT_T32_INT1, callback);
+    sharedCallback = callback;
+    Interrupt_registerInterrupt(INT_T32_INT1, TIMER_HAL_onSharedTimerEnded);
     Timer32_startTimer(TIMER32_0_BASE, true);
 }
 
@@ -172,6 +191,64 @@ void TIMER_HAL_releaseSharedTimer() {
     Timer32_haltTimer(TIMER32_0_BASE);
 }
 
+/*F************************************************************************************************
+ * NAME: uint32_t TIMER_HAL_getTicks()
+ *
+ * DESCRIPTION:
+ *      Returns the time elapsed since the start of the periodic timer, computed from the completed
+ *      periods and the current value of the down counter.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint32_t    periodicCount       Ticks of a period
+ *          uint32_t    periodicElapsed     Ticks of the completed periods
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Ticks at 93750Hz, 0 if the periodic timer has not been started
+ *
+ *  NOTE:
+ *      If it is called while the expiration interrupt is pending the result is one period behind.
+ */
+uint32_t TIMER_HAL_getTicks() {
+    if (periodicCount == 0)
+        return 0;
+    return periodicElapsed + periodicCount - Timer32_getValue(TIMER32_1_BASE);
+}
+
+/*ISR**********************************************************************************************
+ * NAME: void TIMER_HAL_onSharedTimerEnded()
+ *
+ * DESCRIPTION:
+ *      This function is called every time the TIMER32_0 expires, the function records the
+ *      expiration and calls the callback of the owner of the shared timer.
+ *
+ * INPUTS:
+ *      GLOBALS:
+ *          TimerCallback   sharedCallback      Function of the current owner
+ *
+ *  OUTPUTS:
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The callback clears the interrupt flag.
+ */
+void TIMER_HAL_onSharedTimerEnded() {
+    RECORDER_RECORD(RECORDER_CHANNEL_SHARED_TIMER, 0);
+    TRACE_BEGIN(TRACE_ID_SHARED_TIMER, 0);
+    if (sharedCallback != NULL)
+        sharedCallback();
+    TRACE_END(TRACE_ID_SHARED_TIMER);
+}
+
 /*ISR**********************************************************************************************
  * NAME: void T32_INT2_IRQHandler()
  *
@@ -195,6 +272,10 @@ void TIMER_HAL_releaseSharedTimer() {
 // cppcheck-suppress unusedFunction
 void T32_INT2_IRQHandler() {
     Timer32_clearInterruptFlag(TIMER32_1_BASE);
+    periodicElapsed += periodicCount;
+    RECORDER_RECORD(RECORDER_CHANNEL_PERIODIC_TIMER, 0);
+    TRACE_BEGIN(TRACE_ID_PERIODIC_TIMER, 0);
     if (periodicCallback != NULL)
         periodicCallback();
+    TRACE_END(TRACE_ID_PERIODIC_TIMER);
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
  *      void        US_HAL_init()
  *      void        US_HAL_triggerMeasurement()
  *      void        US_HAL_registerMeasurementCallback(USCallback callback);
+ *      uint32_t    US_HAL_getEchoTicks();
  *
  * NOTES:
  *
@@ -19,10 +20,16 @@
  * CHANGES:
  * DATE         AUTHOR          DETAIL
  * 10 Feb 2024  Andrea Piccin   Introduced callback mechanism
+ * 18 Oct 2026  Maintainers     Recording of the measurements
+ * 18 Oct 2026  Maintainers     Tracing of the callback
+ * 18 Oct 2026  Maintainers     Time of the echo
  */
 #include <stdio.h>
 
 #include "../../inc/driverlib/driverlib.h"
+#include "../../inc/recorder.h"
+#include "../../inc/timer_hal.h"
+#include "../../inc/trace.h"
 #include "../../inc/ultrasonic_hal.h"
 
 #define US_PORT GPIO_PORT_P1           /* Sensor's port                                     */
@@ -32,10 +39,12 @@
 #define US_TICKS_TO_USEC_DIVIDER 0.375 /* Fixed value to convert the number of ticks in µs  */
 #define US_TICKS_TO_CM_DIVIDER 21.866  /* Fixed value to convert the number of ticks in cm  */
 #define US_OFFSET_FIX 12               /* Fixed value that fixes a sensor offset error      */
+#define US_TICKS_PER_TIMER_TICK 4      /* 375kHz ticks in a tick of the 93750Hz timer HAL   */
 
 USCallback usCallback;       /* Function to call when a new measurement is ready      */
 volatile uint16_t startTick; /* Value of the counter at the rising edge on echo pin   */
 volatile uint16_t endTick;   /* Value of the counter at the falling edge on echo pin  */
+uint32_t echoTicks;          /* Timer HAL ticks at the midpoint of the last echo      */
 
 /*F************************************************************************************************
  * NAME: void US_HAL_init()
@@ -144,6 +153,8 @@ void US_HAL_triggerMeasurement() {
  */
 void US_HAL_registerMeasurementCallback(USCallback callback) { usCallback = callback; }
 
+uint32_t US_HAL_getEchoTicks() { return echoTicks; }
+
 /*F************************************************************************************************
  * NAME: void US_HAL_convertAndForward()
  *
@@ -163,7 +174,7 @@ void US_HAL_registerMeasurementCallback(USCallback callback) { usCallback = call
  *      PARAMETERS:
  *          None
  *      GLOBALS:
- *          None
+ *          uint32_t    echoTicks              Timer HAL ticks at the midpoint of the echo
  *
  *  NOTE:
  *      [1] The TICKS_TO_CM_DIVIDER conversion divider comes from the following calculation:
@@ -180,6 +191,8 @@ void US_HAL_registerMeasurementCallback(USCallback callback) { usCallback = call
  *      [2] Following the sensor's datasheet the valid result range is between 4cm and 200cm.
  *      [3] Following the sensor's datasheet if after 36ms from the echo rising edge there isn't a
  *          falling edge the result has to be interpreted as nothing is in front of the sensor.
+ *      [4] The sound is reflected at the midpoint of the echo pulse, half of its duration before
+ *          the falling edge.
  */
 void US_HAL_convertAndForward() {
     GPIO_disableInterrupt(US_PORT, US_ECHO_PIN);
@@ -190,10 +203,14 @@ void US_HAL_convertAndForward() {
     uint16_t distance = ((delta * 1.0) / US_TICKS_TO_CM_DIVIDER) - US_OFFSET_FIX;
     if (usec > 36000 || distance > 250)
         distance = US_RESULT_NO_OBJECT;
+    echoTicks = TIMER_HAL_getTicks() - delta / (2 * US_TICKS_PER_TIMER_TICK);
 
-    // invoke the callback function
+    // record and invoke the callback function
+    RECORDER_RECORD(RECORDER_CHANNEL_US_ECHO, distance);
+    TRACE_BEGIN(TRACE_ID_US_ECHO, distance);
     if (usCallback != NULL)
         usCallback(distance);
+    TRACE_END(TRACE_ID_US_ECHO);
     GPIO_enableInterrupt(US_PORT, US_ECHO_PIN);
 }
 
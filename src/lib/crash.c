@@ -0,0 +1,302 @@
+/*H************************************************************************************************
+ * FILENAME:        crash.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the capture of the faults and of the fatal errors and the report
+ *      of the crash records after the reboot.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        CRASH_init()
+ *      void        CRASH_flush()
+ *      void        CRASH_halt(uint32_t code)
+ *
+ * NOTES:
+ *      The fault handlers replace the weak aliases of Default_Handler in the startup code.
+ *      In the test build the capture is left out and the flash log is an array in RAM, so that
+ *      the validation of the records and the log can run on the host.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../inc/crash.h"
+#include "../../inc/ring.h"
+#include "../../inc/state_machine.h"
+
+#ifdef TEST
+#include "../../tests/bluetooth_hal.h"
+#else
+#include "../../inc/bluetooth_hal.h"
+#include "../../inc/driverlib/driverlib.h"
+#include "../../inc/timer_hal.h"
+#endif
+
+#define CRASH_SRAM_START 0x20000000 /* First byte of the SRAM                             */
+#define CRASH_SRAM_END 0x20010000   /* First byte after the SRAM                          */
+#define CRASH_FRAME_PC 6            /* Word of the program counter in the exception frame */
+#define CRASH_EXC_RETURN_FPU 0x10   /* EXC_RETURN bit cleared when the frame holds the FPU */
+#define CRASH_FRAME_FPU_WORDS 26    /* Words of the exception frame with the FPU registers */
+#define CRASH_NUM_SLOTS (CRASH_FLASH_SIZE / sizeof(CrashRecord))
+#define CRASH_REPORT_LINES (9 + CRASH_STACK_WORDS / 2)
+#define CRASH_ERASED 0xFFFFFFFF
+
+CrashRecord crashRecord __attribute__((section(".noinit"))); /* Survives the reset          */
+CrashRecord crashReport;  /* Record found at boot, being reported                              */
+uint8_t crashReportLine;  /* Next line of the report, CRASH_REPORT_LINES if nothing to report */
+uint8_t crashSlot;        /* Slot of the flash log holding the reported record                */
+
+#ifdef TEST
+CrashRecord crashLog[CRASH_NUM_SLOTS]; /* Flash log                                           */
+#define CRASH_LOG crashLog
+#else
+#define CRASH_LOG ((const CrashRecord *)CRASH_FLASH_START)
+#endif
+
+static uint32_t CRASH_checksum(const CrashRecord *record) {
+    const uint32_t *words = (const uint32_t *)record;
+    uint32_t sum = 0;
+    for (size_t i = 0; i < offsetof(CrashRecord, checksum) / sizeof(uint32_t); i++)
+        sum += words[i];
+    return ~sum;
+}
+
+#ifndef TEST
+static bool CRASH_isInSram(uint32_t address, uint32_t size) {
+    return address >= CRASH_SRAM_START && address <= CRASH_SRAM_END - size;
+}
+
+static void __attribute__((noreturn)) CRASH_save(uint32_t exception, uint32_t code) {
+    crashRecord.magic = CRASH_MAGIC;
+    crashRecord.exception = exception;
+    crashRecord.code = code;
+    crashRecord.tick = TIMER_HAL_getTicks();
+    crashRecord.state = FSM_currentState;
+    crashRecord.cfsr = SCB->CFSR;
+    crashRecord.hfsr = SCB->HFSR;
+    crashRecord.mmfar = SCB->MMFAR;
+    crashRecord.bfar = SCB->BFAR;
+    for (uint8_t i = 0; i < CRASH_STACK_WORDS; i++) {
+        uint32_t address = crashRecord.sp + 4 * i;
+        crashRecord.stack[i] = CRASH_isInSram(address, 4) ? *(const uint32_t *)address : 0;
+    }
+    crashRecord.checksum = CRASH_checksum(&crashRecord);
+    NVIC_SystemReset();
+}
+
+static void __attribute__((used, noreturn)) CRASH_onFault(const uint32_t *frame,
+                                                          uint32_t excReturn) {
+    uint32_t address = (uint32_t)frame;
+    bool isValid = CRASH_isInSram(address, 4 * CRASH_FRAME_WORDS);
+    for (uint8_t i = 0; i < CRASH_FRAME_WORDS; i++)
+        crashRecord.registers[i] = isValid ? frame[i] : 0;
+    uint32_t words = excReturn & CRASH_EXC_RETURN_FPU ? CRASH_FRAME_WORDS : CRASH_FRAME_FPU_WORDS;
+    crashRecord.sp = address + 4 * words;
+    CRASH_save(__get_IPSR(), excReturn);
+}
+
+/*F************************************************************************************************
+ * NAME: void CRASH_faultHandler()
+ *
+ * DESCRIPTION:
+ *      Passes the stack frame of the faulting code and the exception return value to
+ *      CRASH_onFault(): bit 2 of the exception return value tells whether the frame has been
+ *      pushed on the main or on the process stack.
+ *
+ * INPUTS:
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      GLOBALS:
+ *          CrashRecord     crashRecord     Filled with the state of the faulting code
+ *
+ *  NOTE:
+ *      Naked, so that the compiler does not push anything before the frame is located. It does
+ *      not return, the device is reset.
+ */
+__attribute__((naked)) void CRASH_faultHandler() {
+    __asm volatile("tst lr, #4            \n"
+                   "ite eq                \n"
+                   "mrseq r0, msp         \n"
+                   "mrsne r0, psp         \n"
+                   "mov r1, lr            \n"
+                   "b CRASH_onFault       \n");
+}
+
+void NMI_Handler() __attribute__((alias("CRASH_faultHandler")));
+void HardFault_Handler() __attribute__((alias("CRASH_faultHandler")));
+void MemManage_Handler() __attribute__((alias("CRASH_faultHandler")));
+void BusFault_Handler() __attribute__((alias("CRASH_faultHandler")));
+void UsageFault_Handler() __attribute__((alias("CRASH_faultHandler")));
+
+void CRASH_halt(uint32_t code) {
+    Interrupt_disableMaster();
+    for (uint8_t i = 0; i < CRASH_FRAME_WORDS; i++)
+        crashRecord.registers[i] = 0;
+    crashRecord.registers[CRASH_FRAME_PC] = (uint32_t)__builtin_return_address(0);
+    crashRecord.sp = __get_MSP();
+    CRASH_save(CRASH_HALT, code);
+}
+#endif
+
+/*F************************************************************************************************
+ * NAME: void CRASH_program(bool isErasing)
+ *
+ * DESCRIPTION:
+ *      Programs the record being reported in its slot of the flash log, erasing the log first if
+ *      requested.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          bool            isErasing           True if the log is full
+ *      GLOBALS:
+ *          CrashRecord     crashReport         Record to program
+ *          uint8_t         crashSlot           Slot of the record in the flash log
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void CRASH_program(bool isErasing) {
+#ifdef TEST
+    if (isErasing)
+        memset(crashLog, 0xFF, sizeof(crashLog));
+    crashLog[crashSlot] = crashReport;
+#else
+    uint32_t sector = 1 << ((CRASH_FLASH_START - 0x20000) / CRASH_FLASH_SIZE);
+    FlashCtl_unprotectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, sector);
+    if (isErasing)
+        FlashCtl_eraseSector(CRASH_FLASH_START);
+    FlashCtl_programMemory(&crashReport, (void *)&CRASH_LOG[crashSlot], sizeof(CrashRecord));
+    FlashCtl_protectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, sector);
+#endif
+}
+
+/*F************************************************************************************************
+ * NAME: void CRASH_init()
+ *
+ * DESCRIPTION:
+ *      [1] Validates the record left in .noinit and invalidates it, so it is reported only once
+ *      [2] Appends it to the first free slot of the flash log, erasing the log when it is full
+ *      [3] Starts its report
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CrashRecord     crashRecord         Record of the previous run, if any
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          CrashRecord     crashRecord         Invalidated
+ *          CrashRecord     crashReport         Copy of the record
+ *          uint8_t         crashReportLine     Set to 0 if there is a record to report
+ *          uint8_t         crashSlot           Slot of the record in the flash log
+ *
+ *  NOTE:
+ *      After a power cycle the content of .noinit is random, the magic and the checksum reject it.
+ */
+void CRASH_init() {
+    // [1] Record
+    crashReportLine = CRASH_REPORT_LINES;
+    if (crashRecord.magic != CRASH_MAGIC || crashRecord.checksum != CRASH_checksum(&crashRecord)) {
+        crashRecord.magic = 0;
+        return;
+    }
+    crashReport = crashRecord;
+    crashRecord.magic = 0;
+
+    // [2] Flash log
+    crashSlot = 0;
+    while (crashSlot < CRASH_NUM_SLOTS && CRASH_LOG[crashSlot].magic != CRASH_ERASED)
+        crashSlot++;
+    bool isFull = crashSlot == CRASH_NUM_SLOTS;
+    if (isFull)
+        crashSlot = 0;
+    CRASH_program(isFull);
+
+    // [3] Report
+    crashReportLine = 0;
+}
+
+static const char *CRASH_exceptionName(uint32_t exception) {
+    switch (exception) {
+    case CRASH_HALT:
+        return "halt";
+    case 2:
+        return "NMI";
+    case 3:
+        return "HardFault";
+    case 4:
+        return "MemManage";
+    case 5:
+        return "BusFault";
+    case 6:
+        return "UsageFault";
+    default:
+        return "exception";
+    }
+}
+
+static void CRASH_formatLine(const CrashRecord *r, uint8_t line, char *text, size_t size) {
+    const uint32_t *regs = r->registers;
+    char prefix = CRASH_STREAM_PREFIX;
+    switch (line) {
+    case 0:
+        snprintf(text, size, "%cCRASH %s ST %" PRIu32 " #%u", prefix,
+                 CRASH_exceptionName(r->exception), r->state, crashSlot);
+        break;
+    case 1:
+        snprintf(text, size, "%cCODE %08" PRIX32 " TICK %08" PRIX32, prefix, r->code, r->tick);
+        break;
+    case 2:
+        snprintf(text, size, "%cPC %08" PRIX32 " LR %08" PRIX32, prefix, regs[6], regs[5]);
+        break;
+    case 3:
+        snprintf(text, size, "%cR0 %08" PRIX32 " R1 %08" PRIX32, prefix, regs[0], regs[1]);
+        break;
+    case 4:
+        snprintf(text, size, "%cR2 %08" PRIX32 " R3 %08" PRIX32, prefix, regs[2], regs[3]);
+        break;
+    case 5:
+        snprintf(text, size, "%cR12 %08" PRIX32 " PSR %08" PRIX32, prefix, regs[4], regs[7]);
+        break;
+    case 6:
+        snprintf(text, size, "%cSP %08" PRIX32 " CFSR %08" PRIX32, prefix, r->sp, r->cfsr);
+        break;
+    case 7:
+        snprintf(text, size, "%cHFSR %08" PRIX32, prefix, r->hfsr);
+        break;
+    case 8:
+        snprintf(text, size, "%cMMFAR %08" PRIX32 " BFAR %08" PRIX32, prefix, r->mmfar, r->bfar);
+        break;
+    default: {
+        uint8_t i = 2 * (line - 9);
+        snprintf(text, size, "%cS%02u %08" PRIX32 " %08" PRIX32, prefix, i, r->stack[i],
+                 r->stack[i + 1]);
+    }
+    }
+}
+
+void CRASH_flush() {
+    char line[RING_ELEMENT_SIZE];
+    while (crashReportLine < CRASH_REPORT_LINES && BT_HAL_canSend()) {
+        CRASH_formatLine(&crashReport, crashReportLine, line, sizeof(line));
+        BT_HAL_sendMessage("%s", line);
+        crashReportLine++;
+    }
+}
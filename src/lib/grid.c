@@ -0,0 +1,215 @@
+/*H************************************************************************************************
+ * FILENAME:        grid.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the occupancy grid built from the echoes of the ultrasonic
+ *      sensor.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        GRID_clear()
+ *      void        GRID_markRay(int32_t x0, int32_t y0, int32_t x1, int32_t y1, bool isHit)
+ *      bool        GRID_toCell(int32_t x, int32_t y, int16_t *cx, int16_t *cy)
+ *      void        GRID_toPoint(int16_t cx, int16_t cy, int32_t *x, int32_t *y)
+ *      GridCell    GRID_getCell(int16_t cx, int16_t cy)
+ *      bool        GRID_isFrontier(int16_t cx, int16_t cy)
+ *      bool        GRID_isVisible(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+ *                                 GridPassable isPassable)
+ *      uint16_t    GRID_countFree()
+ *      uint8_t     GRID_getCoverage()
+ *
+ * NOTES:
+ *      A ray is walked in steps of half a cell, so that it does not skip the cells it crosses
+ *      diagonally by more than a corner. The count of a cell never reached is GRID_UNSEEN, the
+ *      first reading starts it from zero.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 19 Oct 2026  Maintainers     Directions and line of sight shared by the searches
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../inc/grid.h"
+
+#define GRID_UNSEEN INT8_MIN                      /* Count of a cell never reached           */
+#define GRID_ORIGIN (GRID_SIZE / 2 * GRID_CELL + GRID_CELL / 2) /* Origin from the corner (mm) */
+
+static int8_t gridCounts[GRID_SIZE][GRID_SIZE]; /* Counts of the cells, by row and column      */
+
+const int8_t gridDx[GRID_DIRECTIONS] = {1, 0, -1, 0, 1, -1, -1, 1};
+const int8_t gridDy[GRID_DIRECTIONS] = {0, 1, 0, -1, 1, 1, -1, -1};
+
+static bool GRID_isInside(int16_t cx, int16_t cy) {
+    return cx >= 0 && cx < GRID_SIZE && cy >= 0 && cy < GRID_SIZE;
+}
+
+static void GRID_update(int16_t cx, int16_t cy, int8_t delta) {
+    int16_t count = gridCounts[cy][cx] == GRID_UNSEEN ? 0 : gridCounts[cy][cx];
+    count += delta;
+    if (count > GRID_LIMIT)
+        count = GRID_LIMIT;
+    if (count < -GRID_LIMIT)
+        count = -GRID_LIMIT;
+    gridCounts[cy][cx] = count;
+}
+
+void GRID_clear() { memset(gridCounts, GRID_UNSEEN, sizeof(gridCounts)); }
+
+/*F************************************************************************************************
+ * NAME: void GRID_markRay(int32_t x0, int32_t y0, int32_t x1, int32_t y1, bool isHit)
+ *
+ * DESCRIPTION:
+ *      Accounts a reading of the ultrasonic sensor:
+ *      [1] Find the cell at the end of the ray
+ *      [2] Walk the ray in steps of half a cell, every new cell crossed is free
+ *      [3] The cell at the end is occupied if the sound was reflected there
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int32_t     x0          Position of the sensor (mm)
+ *          int32_t     y0
+ *          int32_t     x1          End of the ray (mm)
+ *          int32_t     y1
+ *          bool        isHit       True if the sound was reflected at the end of the ray
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int8_t[][]  gridCounts  Updated along the ray
+ *
+ *  NOTE:
+ */
+void GRID_markRay(int32_t x0, int32_t y0, int32_t x1, int32_t y1, bool isHit) {
+    // [1] End of the ray
+    int16_t endX, endY;
+    bool isEndInside = GRID_toCell(x1, y1, &endX, &endY);
+
+    // [2] Crossed cells
+    int32_t dx = x1 - x0;
+    int32_t dy = y1 - y0;
+    int32_t span = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+    int32_t steps = span / (GRID_CELL / 2) + 1;
+    int16_t lastX = -1, lastY = -1;
+    for (int32_t i = 0; i <= steps; i++) {
+        int16_t cx, cy;
+        if (!GRID_toCell(x0 + dx * i / steps, y0 + dy * i / steps, &cx, &cy))
+            continue;
+        if (cx == lastX && cy == lastY)
+            continue;
+        lastX = cx;
+        lastY = cy;
+        if (isHit && isEndInside && cx == endX && cy == endY)
+            continue;
+        GRID_update(cx, cy, -GRID_FREE_STEP);
+    }
+
+    // [3] Reflection
+    if (isHit && isEndInside)
+        GRID_update(endX, endY, GRID_HIT_STEP);
+}
+
+bool GRID_toCell(int32_t x, int32_t y, int16_t *cx, int16_t *cy) {
+    x += GRID_ORIGIN;
+    y += GRID_ORIGIN;
+    if (x < 0 || y < 0 || x >= GRID_SIZE * GRID_CELL || y >= GRID_SIZE * GRID_CELL)
+        return false;
+    *cx = x / GRID_CELL;
+    *cy = y / GRID_CELL;
+    return true;
+}
+
+void GRID_toPoint(int16_t cx, int16_t cy, int32_t *x, int32_t *y) {
+    *x = (int32_t)cx * GRID_CELL + GRID_CELL / 2 - GRID_ORIGIN;
+    *y = (int32_t)cy * GRID_CELL + GRID_CELL / 2 - GRID_ORIGIN;
+}
+
+GridCell GRID_getCell(int16_t cx, int16_t cy) {
+    if (!GRID_isInside(cx, cy))
+        return GRID_OCCUPIED;
+    int8_t count = gridCounts[cy][cx];
+    if (count == GRID_UNSEEN)
+        return GRID_UNKNOWN;
+    return count > 0 ? GRID_OCCUPIED : GRID_FREE;
+}
+
+bool GRID_isFrontier(int16_t cx, int16_t cy) {
+    return GRID_getCell(cx, cy) == GRID_FREE &&
+           (GRID_getCell(cx + 1, cy) == GRID_UNKNOWN || GRID_getCell(cx - 1, cy) == GRID_UNKNOWN ||
+            GRID_getCell(cx, cy + 1) == GRID_UNKNOWN || GRID_getCell(cx, cy - 1) == GRID_UNKNOWN);
+}
+
+bool GRID_isVisible(int16_t x0, int16_t y0, int16_t x1, int16_t y1, GridPassable isPassable) {
+    int16_t dx = x1 - x0;
+    int16_t dy = y1 - y0;
+    int16_t steps = 2 * (abs(dx) > abs(dy) ? abs(dx) : abs(dy));
+    for (int16_t i = 1; i <= steps; i++) {
+        // Centre of the cell at the origin, rounded to the nearest cell
+        int16_t cx = x0 + (2 * dx * i + (dx < 0 ? -steps : steps)) / (2 * steps);
+        int16_t cy = y0 + (2 * dy * i + (dy < 0 ? -steps : steps)) / (2 * steps);
+        if ((cx != x0 || cy != y0) && !isPassable(cx, cy))
+            return false;
+    }
+    return true;
+}
+
+uint16_t GRID_countFree() {
+    uint16_t count = 0;
+    for (int16_t cy = 0; cy < GRID_SIZE; cy++)
+        for (int16_t cx = 0; cx < GRID_SIZE; cx++)
+            count += GRID_getCell(cx, cy) == GRID_FREE;
+    return count;
+}
+
+/*F************************************************************************************************
+ * NAME: uint8_t GRID_getCoverage()
+ *
+ * DESCRIPTION:
+ *      Returns the share of the free cells among the free cells and the unknown cells next to
+ *      them:
+ *      [1] Count the free cells and the unknown cells with a free neighbour, each once
+ *      [2] Compute the share
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          int8_t[][]  gridCounts  Counts of the cells
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint8_t
+ *          Value:  Coverage (%), 0 for an empty grid
+ *
+ *  NOTE:
+ */
+uint8_t GRID_getCoverage() {
+    // [1] Free cells and unknown cells at their border
+    uint32_t freeCells = 0;
+    uint32_t borderCells = 0;
+    for (int16_t cy = 0; cy < GRID_SIZE; cy++) {
+        for (int16_t cx = 0; cx < GRID_SIZE; cx++) {
+            GridCell cell = GRID_getCell(cx, cy);
+            if (cell == GRID_FREE)
+                freeCells++;
+            else if (cell == GRID_UNKNOWN && (GRID_getCell(cx + 1, cy) == GRID_FREE ||
+                                              GRID_getCell(cx - 1, cy) == GRID_FREE ||
+                                              GRID_getCell(cx, cy + 1) == GRID_FREE ||
+                                              GRID_getCell(cx, cy - 1) == GRID_FREE))
+                borderCells++;
+        }
+    }
+
+    // [2] Share
+    return freeCells == 0 ? 0 : freeCells * 100 / (freeCells + borderCells);
+}
@@ -0,0 +1,356 @@
+/*H************************************************************************************************
+ * FILENAME:        planner.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the A* path planner over the occupancy grid, with its bounded
+ *      open list and the reduction of the path to waypoints.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void            PLANNER_start(int16_t startX, int16_t startY, int16_t goalX,
+ *                                    int16_t goalY, uint8_t clearance)
+ *      PlannerStatus   PLANNER_step(uint16_t budget)
+ *      PlannerStatus   PLANNER_getStatus()
+ *      uint8_t         PLANNER_getWaypoints(int16_t *xs, int16_t *ys, uint8_t max)
+ *      PlannerStats    PLANNER_getStats()
+ *
+ * NOTES:
+ *      The cells are searched in the eight directions with the octile distance as heuristic,
+ *      that never overestimates the cost left, so the first time the goal is popped its path is
+ *      the shortest one. A cell is blocked when an occupied cell is within the clearance: it is
+ *      worked out the first time the search reaches the cell, so that the start of a query does
+ *      not scan the whole grid.
+ *      When the open list is full a new entry replaces its last leaf if cheaper, otherwise it is
+ *      dropped: the path found may be longer, or missed, but the heap never grows.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 19 Oct 2026  Maintainers     Directions and line of sight taken from the grid
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../inc/grid.h"
+#include "../../inc/planner.h"
+
+#define PLANNER_UNREACHED UINT16_MAX  /* Cost of a cell not reached yet                        */
+#define PLANNER_CHECKED 0x80          /* Mark of a cell whose clearance has been worked out    */
+#define PLANNER_BLOCKED 0x40          /* Mark of a cell too close to an occupied one           */
+#define PLANNER_CLOSED 0x20           /* Mark of an expanded cell                              */
+#define PLANNER_PARENT 0x07           /* Direction of the previous cell of the path            */
+
+/*T************************************************************************************************
+ * NAME: PlannerEntry
+ *
+ * DESCRIPTION:
+ *      Represent a cell waiting in the open list.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Fields: uint16_t    cost        Cost from the start plus the estimate to the goal
+ *              uint16_t    cell        Index of the cell, y * GRID_SIZE + x
+ */
+typedef struct {
+    uint16_t cost;
+    uint16_t cell;
+} PlannerEntry;
+
+static PlannerStatus plannerStatus;                   /* Progress of the query                 */
+static PlannerStats plannerStats;                     /* Work done by the query                */
+static int16_t plannerStartX, plannerStartY;          /* Cell of the car                       */
+static int16_t plannerGoalX, plannerGoalY;            /* Cell to reach                         */
+static uint8_t plannerClearance;                      /* Cells kept around the occupied ones   */
+static uint16_t plannerCosts[GRID_SIZE][GRID_SIZE];   /* Costs from the start, by row, column  */
+static uint8_t plannerMarks[GRID_SIZE][GRID_SIZE];    /* Marks of the search, by row, column   */
+static PlannerEntry plannerHeap[PLANNER_HEAP];        /* Open list, cheapest at the root       */
+static uint16_t plannerCount;                         /* Entries in the open list              */
+static uint16_t plannerPath[PLANNER_PATH];            /* First cells of the path, y * 64 + x   */
+
+static bool PLANNER_isInside(int16_t cx, int16_t cy) {
+    return cx >= 0 && cx < GRID_SIZE && cy >= 0 && cy < GRID_SIZE;
+}
+
+static uint16_t PLANNER_estimate(int16_t cx, int16_t cy) {
+    uint16_t dx = abs(plannerGoalX - cx);
+    uint16_t dy = abs(plannerGoalY - cy);
+    uint16_t diagonal = dx < dy ? dx : dy;
+    uint16_t straight = (dx < dy ? dy : dx) - diagonal;
+    return diagonal * PLANNER_DIAGONAL + straight * PLANNER_STRAIGHT;
+}
+
+static bool PLANNER_isPassable(int16_t cx, int16_t cy) {
+    if (!PLANNER_isInside(cx, cy))
+        return false;
+    if (cx == plannerStartX && cy == plannerStartY)
+        return true;
+    if (GRID_getCell(cx, cy) == GRID_OCCUPIED)
+        return false;
+    if (cx == plannerGoalX && cy == plannerGoalY)
+        return true;
+
+    uint8_t *marks = &plannerMarks[cy][cx];
+    if (!(*marks & PLANNER_CHECKED)) {
+        *marks |= PLANNER_CHECKED;
+        for (int16_t dy = -plannerClearance; dy <= plannerClearance; dy++) {
+            for (int16_t dx = -plannerClearance; dx <= plannerClearance; dx++) {
+                if (GRID_getCell(cx + dx, cy + dy) == GRID_OCCUPIED) {
+                    *marks |= PLANNER_BLOCKED;
+                    return false;
+                }
+            }
+        }
+    }
+    return !(*marks & PLANNER_BLOCKED);
+}
+
+static void PLANNER_siftUp(uint16_t i) {
+    PlannerEntry entry = plannerHeap[i];
+    while (i > 0 && plannerHeap[(i - 1) / 2].cost > entry.cost) {
+        plannerHeap[i] = plannerHeap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    plannerHeap[i] = entry;
+}
+
+static void PLANNER_push(uint16_t cost, uint16_t cell) {
+    plannerStats.pushed++;
+    if (plannerCount < PLANNER_HEAP) {
+        plannerHeap[plannerCount].cost = cost;
+        plannerHeap[plannerCount].cell = cell;
+        PLANNER_siftUp(plannerCount++);
+        if (plannerCount > plannerStats.peak)
+            plannerStats.peak = plannerCount;
+        return;
+    }
+
+    // Full: a leaf can be replaced without breaking the heap below it
+    plannerStats.dropped++;
+    if (cost < plannerHeap[PLANNER_HEAP - 1].cost) {
+        plannerHeap[PLANNER_HEAP - 1].cost = cost;
+        plannerHeap[PLANNER_HEAP - 1].cell = cell;
+        PLANNER_siftUp(PLANNER_HEAP - 1);
+    }
+}
+
+static PlannerEntry PLANNER_pop() {
+    PlannerEntry root = plannerHeap[0];
+    PlannerEntry last = plannerHeap[--plannerCount];
+    uint16_t i = 0;
+    while (2 * i + 1 < plannerCount) {
+        uint16_t child = 2 * i + 1;
+        if (child + 1 < plannerCount && plannerHeap[child + 1].cost < plannerHeap[child].cost)
+            child++;
+        if (plannerHeap[child].cost >= last.cost)
+            break;
+        plannerHeap[i] = plannerHeap[child];
+        i = child;
+    }
+    plannerHeap[i] = last;
+    return root;
+}
+
+/*F************************************************************************************************
+ * NAME: void PLANNER_start(int16_t startX, int16_t startY, int16_t goalX, int16_t goalY,
+ *                          uint8_t clearance)
+ *
+ * DESCRIPTION:
+ *      [1] Forget the previous query
+ *      [2] Push the cell of the car in the open list
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int16_t     startX      Cell of the car
+ *          int16_t     startY
+ *          int16_t     goalX       Cell to reach
+ *          int16_t     goalY
+ *          uint8_t     clearance   Cells kept between the path and the occupied ones
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          PlannerStatus   plannerStatus   PLANNER_SEARCHING, PLANNER_FAILED if out of the grid
+ *
+ *  NOTE:
+ */
+void PLANNER_start(int16_t startX, int16_t startY, int16_t goalX, int16_t goalY,
+                   uint8_t clearance) {
+    // [1] Previous query
+    memset(plannerCosts, 0xFF, sizeof(plannerCosts));
+    memset(plannerMarks, 0, sizeof(plannerMarks));
+    memset(&plannerStats, 0, sizeof(plannerStats));
+    plannerCount = 0;
+    plannerStartX = startX;
+    plannerStartY = startY;
+    plannerGoalX = goalX;
+    plannerGoalY = goalY;
+    plannerClearance = clearance;
+    if (!PLANNER_isInside(startX, startY) || !PLANNER_isInside(goalX, goalY)) {
+        plannerStatus = PLANNER_FAILED;
+        return;
+    }
+
+    // [2] Car
+    plannerStatus = PLANNER_SEARCHING;
+    plannerCosts[startY][startX] = 0;
+    PLANNER_push(PLANNER_estimate(startX, startY), startY * GRID_SIZE + startX);
+}
+
+/*F************************************************************************************************
+ * NAME: PlannerStatus PLANNER_step(uint16_t budget)
+ *
+ * DESCRIPTION:
+ *      Expands the cheapest cells of the open list until the budget runs out:
+ *      [1] The query fails once the open list is empty
+ *      [2] Pop the cheapest cell, skipping it if already expanded through a shorter path
+ *      [3] The query ends when the goal is popped
+ *      [4] Push the neighbours reached by a shorter path, a diagonal step needs both the
+ *          orthogonal cells passable so that the path does not cut the corners of the obstacles
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    budget      Cells that can be expanded by this call
+ *      GLOBALS:
+ *          PlannerEntry[]  plannerHeap     Open list
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t[][]    plannerCosts    Costs of the cells reached
+ *          uint8_t[][]     plannerMarks    Expanded cells, with the direction of their parent
+ *      RETURN:
+ *          Type:   PlannerStatus
+ *          Value:  PLANNER_SEARCHING if the budget ran out before the end of the query
+ *
+ *  NOTE:
+ */
+PlannerStatus PLANNER_step(uint16_t budget) {
+    while (plannerStatus == PLANNER_SEARCHING && budget > 0) {
+        // [1] Open list
+        if (plannerCount == 0) {
+            plannerStatus = PLANNER_FAILED;
+            break;
+        }
+
+        // [2] Cheapest cell
+        PlannerEntry entry = PLANNER_pop();
+        int16_t cx = entry.cell % GRID_SIZE;
+        int16_t cy = entry.cell / GRID_SIZE;
+        if (plannerMarks[cy][cx] & PLANNER_CLOSED)
+            continue;
+        plannerMarks[cy][cx] |= PLANNER_CLOSED;
+        plannerStats.expanded++;
+        budget--;
+
+        // [3] Goal
+        if (cx == plannerGoalX && cy == plannerGoalY) {
+            plannerStats.cost = plannerCosts[cy][cx];
+            plannerStatus = PLANNER_FOUND;
+            break;
+        }
+
+        // [4] Neighbours
+        for (uint8_t d = 0; d < GRID_DIRECTIONS; d++) {
+            int16_t nx = cx + gridDx[d];
+            int16_t ny = cy + gridDy[d];
+            if (!PLANNER_isPassable(nx, ny) || plannerMarks[ny][nx] & PLANNER_CLOSED)
+                continue;
+            if (d >= 4 && (!PLANNER_isPassable(nx, cy) || !PLANNER_isPassable(cx, ny)))
+                continue;
+            uint16_t cost = plannerCosts[cy][cx] + (d < 4 ? PLANNER_STRAIGHT : PLANNER_DIAGONAL);
+            if (cost >= plannerCosts[ny][nx])
+                continue;
+            plannerCosts[ny][nx] = cost;
+            plannerMarks[ny][nx] = (plannerMarks[ny][nx] & ~PLANNER_PARENT) | d;
+            PLANNER_push(cost + PLANNER_estimate(nx, ny), ny * GRID_SIZE + nx);
+        }
+    }
+    return plannerStatus;
+}
+
+PlannerStatus PLANNER_getStatus() { return plannerStatus; }
+
+/*F************************************************************************************************
+ * NAME: uint8_t PLANNER_getWaypoints(int16_t *xs, int16_t *ys, uint8_t max)
+ *
+ * DESCRIPTION:
+ *      [1] Count the cells of the path, walking it back from the goal
+ *      [2] Walk it back again, keeping its first PLANNER_PATH cells from the car
+ *      [3] From the car, take the farthest cell in sight as the next waypoint, until the end
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     max         Waypoints that fit in the arrays
+ *      GLOBALS:
+ *          uint8_t[][] plannerMarks    Directions of the parents
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          int16_t*    xs          Columns of the waypoints, from the car to the goal
+ *          int16_t*    ys          Rows of the waypoints
+ *      GLOBALS:
+ *          uint16_t[]  plannerPath     First cells of the path
+ *      RETURN:
+ *          Type:   uint8_t
+ *          Value:  Waypoints written
+ *
+ *  NOTE:
+ *      The path does not include the cell of the car.
+ */
+uint8_t PLANNER_getWaypoints(int16_t *xs, int16_t *ys, uint8_t max) {
+    if (plannerStatus != PLANNER_FOUND)
+        return 0;
+
+    // [1] Length
+    uint16_t length = 0;
+    int16_t cx = plannerGoalX;
+    int16_t cy = plannerGoalY;
+    while (cx != plannerStartX || cy != plannerStartY) {
+        uint8_t d = plannerMarks[cy][cx] & PLANNER_PARENT;
+        cx -= gridDx[d];
+        cy -= gridDy[d];
+        length++;
+    }
+
+    // [2] First cells
+    uint16_t kept = length < PLANNER_PATH ? length : PLANNER_PATH;
+    cx = plannerGoalX;
+    cy = plannerGoalY;
+    for (uint16_t i = length; i > 0; i--) {
+        if (i <= kept)
+            plannerPath[i - 1] = cy * GRID_SIZE + cx;
+        uint8_t d = plannerMarks[cy][cx] & PLANNER_PARENT;
+        cx -= gridDx[d];
+        cy -= gridDy[d];
+    }
+
+    // [3] Waypoints
+    uint8_t count = 0;
+    int16_t fromX = plannerStartX;
+    int16_t fromY = plannerStartY;
+    uint16_t next = 0;
+    while (next < kept && count < max) {
+        uint16_t farthest = next;
+        for (uint16_t k = next + 1; k < kept; k++) {
+            if (!GRID_isVisible(fromX, fromY, plannerPath[k] % GRID_SIZE,
+                                plannerPath[k] / GRID_SIZE, PLANNER_isPassable))
+                break;
+            farthest = k;
+        }
+        fromX = plannerPath[farthest] % GRID_SIZE;
+        fromY = plannerPath[farthest] / GRID_SIZE;
+        xs[count] = fromX;
+        ys[count] = fromY;
+        count++;
+        next = farthest + 1;
+    }
+    return count;
+}
+
+PlannerStats PLANNER_getStats() { return plannerStats; }
@@ -0,0 +1,167 @@
+/*H************************************************************************************************
+ * FILENAME:        profiler.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the statistical profiler driven by SysTick.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        PROFILER_init()
+ *      void        PROFILER_flush()
+ *      void        PROFILER_encode(const ProfilerSample *sample, char *text)
+ *      bool        PROFILER_decode(const char *text, ProfilerSample *sample)
+ *
+ * NOTES:
+ *      The window is written by SysTick_Handler() only while it is not full and read by the main
+ *      loop only when it is full, so the two never access the same sample at the same time.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include "../../inc/profiler.h"
+
+#ifdef PROFILER_ENABLED
+#include "../../inc/bluetooth_hal.h"
+#include "../../inc/driverlib/driverlib.h"
+
+#define PROFILER_FRAME_LR 5   /* Word of the link register in the exception stack frame      */
+#define PROFILER_FRAME_PC 6   /* Word of the program counter in the exception stack frame    */
+#define PROFILER_FRAME_XPSR 7 /* Word of the program status in the exception stack frame     */
+#define PROFILER_IPSR_MASK 0x1FF
+
+ProfilerSample profilerWindow[PROFILER_BUFFER_SIZE]; /* Samples of the current window      */
+volatile uint16_t profilerCount;                     /* Samples taken in the window        */
+uint16_t profilerSent;                               /* Samples of the window already sent */
+#endif
+
+static const char hexDigits[] = "0123456789ABCDEF";
+
+#ifdef PROFILER_ENABLED
+/*F************************************************************************************************
+ * NAME: void PROFILER_init()
+ *
+ * DESCRIPTION:
+ *      [1] Lowers every device interrupt by one priority level
+ *      [2] Gives SysTick the highest priority and starts it at PROFILER_RATE Hz
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t    profilerCount   Set to 0
+ *          uint16_t    profilerSent    Set to 0
+ *
+ *  NOTE:
+ *      The device interrupts keep the same priority among them, the HALs do not rely on nesting.
+ */
+void PROFILER_init() {
+    profilerCount = 0;
+    profilerSent = 0;
+
+    // [1] Device interrupts
+    for (int32_t irq = PSS_IRQn; irq <= PORT6_IRQn; irq++)
+        NVIC_SetPriority((IRQn_Type)irq, 1);
+
+    // [2] SysTick
+    SysTick_Config(CS_getMCLK() / PROFILER_RATE);
+    NVIC_SetPriority(SysTick_IRQn, 0);
+}
+
+static void __attribute__((used)) PROFILER_sample(const uint32_t *frame) {
+    uint16_t count = profilerCount;
+    if (count == PROFILER_BUFFER_SIZE)
+        return;
+    ProfilerSample *sample = &profilerWindow[count];
+    sample->pc = frame[PROFILER_FRAME_PC];
+    sample->lr = frame[PROFILER_FRAME_LR];
+    sample->exception = frame[PROFILER_FRAME_XPSR] & PROFILER_IPSR_MASK;
+    profilerCount = count + 1;
+}
+
+/*F************************************************************************************************
+ * NAME: void SysTick_Handler()
+ *
+ * DESCRIPTION:
+ *      Passes the stack frame of the interrupted code to PROFILER_sample(): bit 2 of the exception
+ *      return value in LR tells whether it has been pushed on the main or on the process stack.
+ *
+ * INPUTS:
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      GLOBALS:
+ *          ProfilerSample[]    profilerWindow  The sample is appended if the window is not full
+ *          uint16_t            profilerCount   Incremented
+ *
+ *  NOTE:
+ *      Naked, so that the compiler does not push anything before the frame is located.
+ */
+// cppcheck-suppress unusedFunction
+__attribute__((naked)) void SysTick_Handler() {
+    __asm volatile("tst lr, #4            \n"
+                   "ite eq                \n"
+                   "mrseq r0, msp         \n"
+                   "mrsne r0, psp         \n"
+                   "b PROFILER_sample     \n");
+}
+
+void PROFILER_flush() {
+    if (profilerCount < PROFILER_BUFFER_SIZE)
+        return;
+
+    char line[PROFILER_SAMPLE_TEXT_LENGTH + 2];
+    while (profilerSent < PROFILER_BUFFER_SIZE && BT_HAL_canSend()) {
+        line[0] = PROFILER_STREAM_PREFIX;
+        PROFILER_encode(&profilerWindow[profilerSent], &line[1]);
+        line[PROFILER_SAMPLE_TEXT_LENGTH + 1] = '\0';
+        BT_HAL_sendMessage("%s", line);
+        profilerSent++;
+    }
+
+    // the window has been sent, SysTick starts filling the next one
+    if (profilerSent == PROFILER_BUFFER_SIZE) {
+        profilerSent = 0;
+        profilerCount = 0;
+    }
+}
+#endif
+
+void PROFILER_encode(const ProfilerSample *sample, char *text) {
+    for (int8_t i = 7; i >= 0; i--)
+        *text++ = hexDigits[(sample->pc >> (4 * i)) & 0xF];
+    for (int8_t i = 7; i >= 0; i--)
+        *text++ = hexDigits[(sample->lr >> (4 * i)) & 0xF];
+    *text++ = hexDigits[(sample->exception >> 4) & 0xF];
+    *text++ = hexDigits[sample->exception & 0xF];
+}
+
+bool PROFILER_decode(const char *text, ProfilerSample *sample) {
+    uint32_t words[3] = {0, 0, 0};
+    for (uint8_t i = 0; i < PROFILER_SAMPLE_TEXT_LENGTH; i++) {
+        char c = text[i];
+        uint8_t digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else
+            return false;
+        words[i / 8] = words[i / 8] << 4 | digit;
+    }
+    sample->pc = words[0];
+    sample->lr = words[1];
+    sample->exception = words[2];
+    return true;
+}
@@ -0,0 +1,277 @@
+/*H************************************************************************************************
+ * FILENAME:        recorder.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the recording of the events crossing the HAL callback boundary.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        RECORDER_init()
+ *      void        RECORDER_record(RecorderChannel channel, uint16_t value)
+ *      void        RECORDER_recordString(RecorderChannel channel, const char *string)
+ *      bool        RECORDER_read(RecorderEvent *event)
+ *      void        RECORDER_flush()
+ *      uint16_t    RECORDER_hash(const char *string, uint16_t seed)
+ *      void        RECORDER_encode(const RecorderEvent *event, char *text)
+ *      bool        RECORDER_decode(const char *text, RecorderEvent *event)
+ *
+ * NOTES:
+ *      The ring is written by the interrupt service routines and read by the main loop, every
+ *      access is done with the interrupts disabled.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stddef.h>
+
+#include "../../inc/recorder.h"
+
+#ifdef TEST
+#include "../../tests/bluetooth_hal.h"
+#include "../../tests/timer_hal.h"
+#else
+#include "../../inc/bluetooth_hal.h"
+#include "../../inc/driverlib/driverlib.h"
+#include "../../inc/timer_hal.h"
+#endif
+
+#define RECORDER_RING_MASK (RECORDER_RING_SIZE - 1)
+#define RECORDER_FLASH_SECTOR_SIZE 4096
+#define RECORDER_FLASH_SIZE (RECORDER_FLASH_SECTORS * RECORDER_FLASH_SECTOR_SIZE)
+#define RECORDER_FLASH_END (RECORDER_FLASH_START + RECORDER_FLASH_SIZE)
+
+RecorderEvent recorderRing[RECORDER_RING_SIZE]; /* Events not yet moved to the sink         */
+volatile uint16_t recorderHead;                 /* Index of the next event to write        */
+volatile uint16_t recorderTail;                 /* Index of the next event to read         */
+volatile uint16_t recorderDropped;              /* Events lost since the last stored one   */
+#ifdef RECORDER_SINK_FLASH
+uint32_t recorderFlashAddress; /* Next free byte of the flash log                           */
+#endif
+
+static const char hexDigits[] = "0123456789ABCDEF";
+
+static bool RECORDER_lock() {
+#ifdef TEST
+    return true;
+#else
+    return Interrupt_disableMaster();
+#endif
+}
+
+static void RECORDER_unlock(bool wasDisabled) {
+#ifndef TEST
+    if (!wasDisabled)
+        Interrupt_enableMaster();
+#endif
+}
+
+static uint16_t RECORDER_count() { return (uint16_t)(recorderHead - recorderTail); }
+
+static void RECORDER_push(uint32_t tick, RecorderChannel channel, uint16_t value) {
+    RecorderEvent *event = &recorderRing[recorderHead & RECORDER_RING_MASK];
+    event->tick = tick;
+    event->value = value;
+    event->channel = channel;
+    recorderHead++;
+}
+
+/*F************************************************************************************************
+ * NAME: void RECORDER_init()
+ *
+ * DESCRIPTION:
+ *      [1] Empties the ring
+ *      [2] With the flash sink, erases the sectors of the flash log
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t    recorderHead            Set to 0
+ *          uint16_t    recorderTail            Set to 0
+ *          uint16_t    recorderDropped         Set to 0
+ *          uint32_t    recorderFlashAddress    Set to the start of the log
+ *
+ *  NOTE:
+ */
+void RECORDER_init() {
+    // [1] Ring
+    recorderHead = 0;
+    recorderTail = 0;
+    recorderDropped = 0;
+
+    // [2] Flash log
+#ifdef RECORDER_SINK_FLASH
+    for (uint32_t address = RECORDER_FLASH_START; address < RECORDER_FLASH_END;
+         address += RECORDER_FLASH_SECTOR_SIZE) {
+        uint32_t sector = 1 << ((address - 0x20000) / RECORDER_FLASH_SECTOR_SIZE);
+        FlashCtl_unprotectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, sector);
+        FlashCtl_eraseSector(address);
+    }
+    recorderFlashAddress = RECORDER_FLASH_START;
+#endif
+}
+
+/*F************************************************************************************************
+ * NAME: void RECORDER_record(RecorderChannel channel, uint16_t value)
+ *
+ * DESCRIPTION:
+ *      [1] Stores the number of lost events, if any, as soon as there is space for it
+ *      [2] Stores the event or drops it if the ring is full
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          RecorderChannel     channel     Source of the event
+ *          uint16_t            value       Payload
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RecorderEvent[]     recorderRing        The event is appended
+ *          uint16_t            recorderDropped     Updated
+ *
+ *  NOTE:
+ */
+void RECORDER_record(RecorderChannel channel, uint16_t value) {
+    uint32_t tick = TIMER_HAL_getTicks();
+    bool wasDisabled = RECORDER_lock();
+
+    // [1] Lost events
+    if (recorderDropped > 0 && RECORDER_count() <= RECORDER_RING_SIZE - 2) {
+        RECORDER_push(tick, RECORDER_CHANNEL_OVERFLOW, recorderDropped);
+        recorderDropped = 0;
+    }
+
+    // [2] New event
+    if (recorderDropped == 0 && RECORDER_count() < RECORDER_RING_SIZE)
+        RECORDER_push(tick, channel, value);
+    else if (recorderDropped < UINT16_MAX)
+        recorderDropped++;
+
+    RECORDER_unlock(wasDisabled);
+}
+
+void RECORDER_recordString(RecorderChannel channel, const char *string) {
+    while (true) {
+        uint8_t first = string[0];
+        uint8_t second = first != '\0' ? string[1] : '\0';
+        RECORDER_record(channel, first | second << 8);
+        if (first == '\0' || second == '\0')
+            break;
+        string += 2;
+    }
+}
+
+bool RECORDER_read(RecorderEvent *event) {
+    bool wasDisabled = RECORDER_lock();
+    bool isAvailable = RECORDER_count() > 0;
+    if (isAvailable) {
+        *event = recorderRing[recorderTail & RECORDER_RING_MASK];
+        recorderTail++;
+    }
+    RECORDER_unlock(wasDisabled);
+    return isAvailable;
+}
+
+/*F************************************************************************************************
+ * NAME: void RECORDER_flush()
+ *
+ * DESCRIPTION:
+ *      Bluetooth sink: sends lines of two events while the outgoing queue has space.
+ *      Flash sink: programs blocks of RECORDER_FLASH_BLOCK events until the log is full.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RecorderEvent[]     recorderRing            Events to move
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint32_t            recorderFlashAddress    Moved after the programmed block
+ *
+ *  NOTE:
+ *      The flash log occupies bank 1 while the code runs from bank 0, so the programming does not
+ *      stall the execution. When the log is full the ring fills up and the events are dropped.
+ */
+void RECORDER_flush() {
+#ifdef RECORDER_SINK_FLASH
+    RecorderEvent block[RECORDER_FLASH_BLOCK];
+    while (RECORDER_count() >= RECORDER_FLASH_BLOCK &&
+           recorderFlashAddress + sizeof(block) <= RECORDER_FLASH_END) {
+        for (uint8_t i = 0; i < RECORDER_FLASH_BLOCK; i++)
+            RECORDER_read(&block[i]);
+        FlashCtl_programMemory(block, (void *)recorderFlashAddress, sizeof(block));
+        recorderFlashAddress += sizeof(block);
+    }
+#else
+    char line[2 * RECORDER_EVENT_TEXT_LENGTH + 2];
+    while (RECORDER_count() > 0 && BT_HAL_canSend()) {
+        uint8_t length = 0;
+        RecorderEvent event;
+        line[length++] = RECORDER_STREAM_PREFIX;
+        for (uint8_t i = 0; i < 2 && RECORDER_read(&event); i++) {
+            RECORDER_encode(&event, &line[length]);
+            length += RECORDER_EVENT_TEXT_LENGTH;
+        }
+        line[length] = '\0';
+        BT_HAL_sendMessage("%s", line);
+    }
+#endif
+}
+
+uint16_t RECORDER_hash(const char *string, uint16_t seed) {
+    uint16_t crc = seed;
+    for (; *string != '\0'; string++) {
+        crc ^= (uint8_t)*string << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+void RECORDER_encode(const RecorderEvent *event, char *text) {
+    for (int8_t i = 7; i >= 0; i--)
+        *text++ = hexDigits[(event->tick >> (4 * i)) & 0xF];
+    *text++ = hexDigits[(event->channel >> 4) & 0xF];
+    *text++ = hexDigits[event->channel & 0xF];
+    for (int8_t i = 3; i >= 0; i--)
+        *text++ = hexDigits[(event->value >> (4 * i)) & 0xF];
+}
+
+bool RECORDER_decode(const char *text, RecorderEvent *event) {
+    uint8_t digits[RECORDER_EVENT_TEXT_LENGTH];
+    for (uint8_t i = 0; i < RECORDER_EVENT_TEXT_LENGTH; i++) {
+        char c = text[i];
+        if (c >= '0' && c <= '9')
+            digits[i] = c - '0';
+        else if (c >= 'A' && c <= 'F')
+            digits[i] = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f')
+            digits[i] = c - 'a' + 10;
+        else
+            return false;
+    }
+
+    event->tick = 0;
+    for (uint8_t i = 0; i < 8; i++)
+        event->tick = event->tick << 4 | digits[i];
+    event->channel = digits[8] << 4 | digits[9];
+    event->value = 0;
+    for (uint8_t i = 10; i < RECORDER_EVENT_TEXT_LENGTH; i++)
+        event->value = event->value << 4 | digits[i];
+    return event->channel < RECORDER_NUM_CHANNELS;
+}
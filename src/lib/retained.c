@@ -0,0 +1,205 @@
+/*H************************************************************************************************
+ * FILENAME:        retained.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the state kept through the warm resets and the detection of
+ *      the cause of the reset.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void                    RETAINED_init()
+ *      const RetainedState*    RETAINED_getRestored()
+ *      void                    RETAINED_update()
+ *      uint32_t                RETAINED_crc(const void *data, uint32_t size)
+ *
+ * NOTES:
+ *      The status registers of the reset controller are sticky, they are cleared at every boot
+ *      so that the next one sees only its own cause.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 19 Oct 2026  Maintainers     CRC of the fields, without the padding
+ */
+#include <stddef.h>
+
+#include "../../inc/retained.h"
+#include "../../inc/sensing_module.h"
+#include "../../inc/state_machine.h"
+
+#ifndef TEST
+#include "../../inc/driverlib/driverlib.h"
+#endif
+
+#define RETAINED_CRC_POLYNOMIAL 0xEDB88320 /* CRC-32, reflected                              */
+#define RETAINED_WDT_SOURCES 0x6           /* Sources 1 and 2: watchdog time-out, password   */
+
+#ifdef TEST
+RetainedState retainedState;                     /* Stand-in for .noinit in the test build  */
+RetainedReset retainedResetCause = RETAINED_RESET_COLD;
+#else
+RetainedState retainedState __attribute__((section(".noinit"))); /* Survives the reset       */
+#endif
+RetainedState retainedRestored; /* State found at boot                                        */
+bool retainedIsRestored;        /* True if the state found at boot is resumed                 */
+
+/*F************************************************************************************************
+ * NAME: RetainedReset RETAINED_readResetCause()
+ *
+ * DESCRIPTION:
+ *      Reads the cause of the last reset from the reset controller and clears it.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   RetainedReset
+ *          Value:  RETAINED_RESET_WARM after a watchdog or brown-out reset
+ *
+ *  NOTE:
+ *      The watchdog raises a hard or a soft reset depending on SYSCTL WDTRESET_CTL, both are
+ *      accepted. A drop below the VCC detector is a power on, the SRAM is lost.
+ */
+static RetainedReset RETAINED_readResetCause() {
+#ifdef TEST
+    RetainedReset cause = retainedResetCause;
+    retainedResetCause = RETAINED_RESET_COLD;
+    return cause;
+#else
+    uint32_t pss = RSTCTL->PSSRESET_STAT;
+    bool isBrownOut = (pss & (RSTCTL_PSSRESET_STAT_SVSMH | RSTCTL_PSSRESET_STAT_BGREF)) &&
+                      !(pss & RSTCTL_PSSRESET_STAT_VCCDET);
+    bool isWarm = (RSTCTL->HARDRESET_STAT & RETAINED_WDT_SOURCES) ||
+                  (RSTCTL->SOFTRESET_STAT & RETAINED_WDT_SOURCES) || isBrownOut;
+    RSTCTL->HARDRESET_CLR = 0xFFFF;
+    RSTCTL->SOFTRESET_CLR = 0xFFFF;
+    RSTCTL->PSSRESET_CLR = RSTCTL_PSSRESET_CLR_CLR;
+    RSTCTL->PCMRESET_CLR = RSTCTL_PCMRESET_CLR_CLR;
+    RSTCTL->PINRESET_CLR = RSTCTL_PINRESET_CLR_CLR;
+    RSTCTL->REBOOTRESET_CLR = RSTCTL_REBOOTRESET_CLR_CLR;
+    RSTCTL->CSRESET_CLR = RSTCTL_CSRESET_CLR_CLR;
+    return isWarm ? RETAINED_RESET_WARM : RETAINED_RESET_COLD;
+#endif
+}
+
+static uint32_t RETAINED_crcAdd(uint32_t crc, const void *data, uint32_t size) {
+    const uint8_t *bytes = data;
+    for (uint32_t i = 0; i < size; i++) {
+        crc ^= bytes[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = crc & 1 ? (crc >> 1) ^ RETAINED_CRC_POLYNOMIAL : crc >> 1;
+    }
+    return crc;
+}
+
+uint32_t RETAINED_crc(const void *data, uint32_t size) {
+    return ~RETAINED_crcAdd(0xFFFFFFFF, data, size);
+}
+
+/*F************************************************************************************************
+ * NAME: uint32_t RETAINED_stateCrc(const RetainedState *state)
+ *
+ * DESCRIPTION:
+ *      Computes the CRC-32 of the fields of the state before the CRC, one after the other.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const RetainedState *state      State to check
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  CRC-32 of the fields
+ *
+ *  NOTE:
+ *      The padding bytes are left out, the struct assignments do not preserve them.
+ */
+static uint32_t RETAINED_stateCrc(const RetainedState *state) {
+    const Parameters *p = &state->parameters;
+    uint32_t crc = RETAINED_crcAdd(0xFFFFFFFF, &state->magic, sizeof(state->magic));
+    crc = RETAINED_crcAdd(crc, &state->isAutonomous, sizeof(state->isAutonomous));
+    crc = RETAINED_crcAdd(crc, &state->servoPosition, sizeof(state->servoPosition));
+    crc = RETAINED_crcAdd(crc, &p->freeThreshold, sizeof(p->freeThreshold));
+    crc = RETAINED_crcAdd(crc, &p->forwardSpeed, sizeof(p->forwardSpeed));
+    crc = RETAINED_crcAdd(crc, &p->turnSpeed, sizeof(p->turnSpeed));
+    crc = RETAINED_crcAdd(crc, &p->sensingTimerCount, sizeof(p->sensingTimerCount));
+    return ~crc;
+}
+
+/*F************************************************************************************************
+ * NAME: void RETAINED_init()
+ *
+ * DESCRIPTION:
+ *      [1] Reads the cause of the reset
+ *      [2] Validates the retained state, after a warm reset only
+ *      [3] Restores the parameters and invalidates the state, it is written again by the main
+ *          loop
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RetainedState   retainedState
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          RetainedState   retainedRestored    Set to the retained state
+ *          bool            retainedIsRestored  True if the state is resumed
+ *          Parameters      parameters          Restored
+ *
+ *  NOTE:
+ */
+void RETAINED_init() {
+    // [1] Cause
+    bool isWarm = RETAINED_readResetCause() == RETAINED_RESET_WARM;
+
+    // [2] Validation
+    retainedRestored = retainedState;
+    retainedIsRestored = isWarm && retainedRestored.magic == RETAINED_MAGIC &&
+                         retainedRestored.crc == RETAINED_stateCrc(&retainedRestored);
+
+    // [3] Parameters
+    if (retainedIsRestored)
+        parameters = retainedRestored.parameters;
+    retainedState.magic = 0;
+}
+
+const RetainedState *RETAINED_getRestored() {
+    return retainedIsRestored ? &retainedRestored : NULL;
+}
+
+void RETAINED_update() {
+    bool isAutonomous = FSM_currentState != STATE_INIT && FSM_currentState != STATE_REMOTE;
+    int8_t servoPosition = Sensing_Module_getServoPosition();
+    if (retainedState.magic == RETAINED_MAGIC && retainedState.isAutonomous == isAutonomous &&
+        retainedState.servoPosition == servoPosition &&
+        retainedState.parameters.freeThreshold == parameters.freeThreshold &&
+        retainedState.parameters.forwardSpeed == parameters.forwardSpeed &&
+        retainedState.parameters.turnSpeed == parameters.turnSpeed &&
+        retainedState.parameters.sensingTimerCount == parameters.sensingTimerCount)
+        return;
+
+    retainedState.magic = RETAINED_MAGIC;
+    retainedState.isAutonomous = isAutonomous;
+    retainedState.servoPosition = servoPosition;
+    retainedState.parameters = parameters;
+    retainedState.crc = RETAINED_stateCrc(&retainedState);
+}
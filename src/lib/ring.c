@@ -0,0 +1,180 @@
+/*H************************************************************************************************
+ * FILENAME:        ring.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the lock-free ring of strings with many producers and one
+ *      consumer, on the exclusive load and store of the Cortex-M4 or on the C11 atomics.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        RING_init(StringRing *ring)
+ *      bool        RING_push(StringRing *ring, const char *string)
+ *      const char* RING_front(StringRing *ring)
+ *      void        RING_pop(StringRing *ring)
+ *      bool        RING_isEmpty(StringRing *ring)
+ *      bool        RING_isFull(StringRing *ring)
+ *
+ * NOTES:
+ *      The loads of the counters acquire and the stores release: the string of a slot is written
+ *      before its sequence is published, and read after it is seen. On the Cortex-M4 the data
+ *      memory barrier orders them and is a barrier for the compiler as well.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <string.h>
+
+#include "../../inc/ring.h"
+
+#ifdef __arm__
+#include "../../inc/msp.h"
+#endif
+
+static uint32_t RING_load(RingCounter *counter) {
+#ifdef __arm__
+    uint32_t value = *counter;
+    __DMB();
+    return value;
+#else
+    return atomic_load_explicit(counter, memory_order_acquire);
+#endif
+}
+
+static void RING_store(RingCounter *counter, uint32_t value) {
+#ifdef __arm__
+    __DMB();
+    *counter = value;
+#else
+    atomic_store_explicit(counter, value, memory_order_release);
+#endif
+}
+
+/*F************************************************************************************************
+ * NAME: bool RING_reserve(RingCounter *head, uint32_t position)
+ *
+ * DESCRIPTION:
+ *      Advances the head past a position, if it is still there (compare and swap):
+ *      [1] Load the head exclusively, another producer got there first if it moved
+ *      [2] Store the next position, retry if the exclusive store failed because an interrupt
+ *          ran in between
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          RingCounter*    head        Next position reserved by a producer
+ *          uint32_t        position    Position to reserve
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the position is reserved
+ *
+ *  NOTE:
+ */
+static bool RING_reserve(RingCounter *head, uint32_t position) {
+#ifdef __arm__
+    do {
+        // [1] Exclusive load
+        if (__LDREXW(head) != position) {
+            __CLREX();
+            return false;
+        }
+
+        // [2] Exclusive store
+    } while (__STREXW(position + 1, head) != 0);
+    __DMB();
+    return true;
+#else
+    return atomic_compare_exchange_strong_explicit(head, &position, position + 1,
+                                                   memory_order_acq_rel, memory_order_relaxed);
+#endif
+}
+
+void RING_init(StringRing *ring) {
+    for (uint32_t i = 0; i < RING_SIZE; i++)
+        RING_store(&ring->slots[i].sequence, i);
+    RING_store(&ring->head, 0);
+    ring->tail = 0;
+}
+
+/*F************************************************************************************************
+ * NAME: bool RING_push(StringRing *ring, const char *string)
+ *
+ * DESCRIPTION:
+ *      [1] Reserve the position at the head, if its slot has been given back by the consumer
+ *      [2] Copy the string in the slot
+ *      [3] Publish it to the consumer
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          StringRing*     ring        Ring of the messages
+ *          const char*     string      String to push, shorter than RING_ELEMENT_SIZE
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the ring is full or the string too long, nothing is pushed
+ *
+ *  NOTE:
+ *      The sequence of the slot behind the position means that the consumer has not popped it
+ *      yet, ahead of it that another producer has reserved the position meanwhile.
+ */
+bool RING_push(StringRing *ring, const char *string) {
+    size_t length = strlen(string);
+    if (length >= RING_ELEMENT_SIZE)
+        return false;
+
+    // [1] Reservation
+    uint32_t position;
+    RingSlot *slot;
+    for (;;) {
+        position = RING_load(&ring->head);
+        slot = &ring->slots[position % RING_SIZE];
+        int32_t lag = (int32_t)(RING_load(&slot->sequence) - position);
+        if (lag < 0)
+            return false;
+        if (lag == 0 && RING_reserve(&ring->head, position))
+            break;
+    }
+
+    // [2] Copy
+    memcpy(slot->data, string, length + 1);
+
+    // [3] Publication
+    RING_store(&slot->sequence, position + 1);
+    return true;
+}
+
+const char *RING_front(StringRing *ring) {
+    RingSlot *slot = &ring->slots[ring->tail % RING_SIZE];
+    return RING_load(&slot->sequence) == ring->tail + 1 ? slot->data : NULL;
+}
+
+void RING_pop(StringRing *ring) {
+    RingSlot *slot = &ring->slots[ring->tail % RING_SIZE];
+    if (RING_load(&slot->sequence) != ring->tail + 1)
+        return;
+    RING_store(&slot->sequence, ring->tail + RING_SIZE);
+    ring->tail++;
+}
+
+bool RING_isEmpty(StringRing *ring) { return RING_front(ring) == NULL; }
+
+bool RING_isFull(StringRing *ring) {
+    uint32_t position = RING_load(&ring->head);
+    return (int32_t)(RING_load(&ring->slots[position % RING_SIZE].sequence) - position) < 0;
+}
@@ -0,0 +1,181 @@
+/*H************************************************************************************************
+ * FILENAME:        scanmatch.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the estimate of the rotations of the car by matching the
+ *      range profiles of the scans taken before and after them.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    SCANMATCH_clear(ScanProfile *profile)
+ *      void    SCANMATCH_add(ScanProfile *profile, int8_t angle, uint16_t distance)
+ *      bool    SCANMATCH_match(const ScanProfile *before, const ScanProfile *after,
+ *                              int16_t expected, uint8_t window, int16_t *rotation)
+ *
+ * NOTES:
+ *      The scores are in 1/256 of cm, the sums of the differences fit in 16 bits: 37 bins of at
+ *      most SCANMATCH_OUTLIER fifths of cm. The differences are clamped so that an edge of an
+ *      obstacle, seen a bin apart in the two scans, does not outweigh the rest of the profile.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <string.h>
+
+#include "../../inc/scanmatch.h"
+
+#define SCANMATCH_UNIT 256          /* Fixed point 1 cm of the scores                            */
+#define SCANMATCH_OUTLIER 20        /* Largest difference of a pair accounted (cm)               */
+#define SCANMATCH_INVALID INT32_MIN /* Score of a rotation with too few pairs                    */
+
+static int16_t SCANMATCH_floorDiv(int16_t value, int16_t divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+void SCANMATCH_clear(ScanProfile *profile) { memset(profile, 0, sizeof(*profile)); }
+
+void SCANMATCH_add(ScanProfile *profile, int8_t angle, uint16_t distance) {
+    int16_t bin = SCANMATCH_floorDiv(angle + 90 + SCANMATCH_STEP / 2, SCANMATCH_STEP);
+    if (bin < 0 || bin >= SCANMATCH_BINS)
+        return;
+    if (distance == 0)
+        distance = 1;
+    profile->ranges[bin] = distance > SCANMATCH_MAX_RANGE ? SCANMATCH_MAX_RANGE : distance;
+}
+
+/*F************************************************************************************************
+ * NAME: int32_t SCANMATCH_score(const ScanProfile *before, const ScanProfile *after,
+ *                               int16_t shift)
+ *
+ * DESCRIPTION:
+ *      Compares the bins of the second profile with the first one rotated by the shift:
+ *      [1] Interpolate the first profile at the angle of each bin of the second one, between the
+ *          two bins around it
+ *      [2] Sum the absolute differences of the pairs with an echo in both profiles, at most
+ *          SCANMATCH_OUTLIER each
+ *      [3] The score is their mean, negated so that the best match has the highest score
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const ScanProfile*  before      First profile
+ *          const ScanProfile*  after       Second profile
+ *          int16_t             shift       Rotation between the profiles (deg), counterclockwise
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int32_t
+ *          Value:  Score, 0 for identical profiles, SCANMATCH_INVALID with less than
+ *                  SCANMATCH_MIN_PAIRS pairs
+ *
+ *  NOTE:
+ *      The differences are in fifths of cm, the weights of the interpolation.
+ */
+static int32_t SCANMATCH_score(const ScanProfile *before, const ScanProfile *after,
+                               int16_t shift) {
+    int32_t n = 0;
+    int32_t sum = 0;
+    for (int16_t i = 0; i < SCANMATCH_BINS; i++) {
+        // [1] Interpolation
+        int16_t position = i * SCANMATCH_STEP + shift;
+        int16_t j = SCANMATCH_floorDiv(position, SCANMATCH_STEP);
+        int16_t weight = position - j * SCANMATCH_STEP;
+        if (j < 0 || j >= SCANMATCH_BINS || (weight != 0 && j + 1 >= SCANMATCH_BINS))
+            continue;
+        int32_t a = before->ranges[j] * (SCANMATCH_STEP - weight);
+        if (weight != 0) {
+            if (before->ranges[j + 1] == 0)
+                continue;
+            a += before->ranges[j + 1] * weight;
+        }
+
+        // [2] Difference
+        int32_t b = after->ranges[i] * SCANMATCH_STEP;
+        if (before->ranges[j] == 0 || b == 0)
+            continue;
+        n++;
+        int32_t difference = a > b ? a - b : b - a;
+        if (difference > SCANMATCH_OUTLIER * SCANMATCH_STEP)
+            difference = SCANMATCH_OUTLIER * SCANMATCH_STEP;
+        sum += difference;
+    }
+    if (n < SCANMATCH_MIN_PAIRS)
+        return SCANMATCH_INVALID;
+
+    // [3] Mean
+    return -(sum * SCANMATCH_UNIT / (n * SCANMATCH_STEP));
+}
+
+/*F************************************************************************************************
+ * NAME: bool SCANMATCH_match(const ScanProfile *before, const ScanProfile *after,
+ *                            int16_t expected, uint8_t window, int16_t *rotation)
+ *
+ * DESCRIPTION:
+ *      [1] Score the rotations within the window around the expected one, a bin apart
+ *      [2] Score the rotations around the best one, a degree apart
+ *      [3] The best rotation must differ by at most SCANMATCH_MAX_ERROR on average
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const ScanProfile*  before      Scan before the rotation
+ *          const ScanProfile*  after       Scan after the rotation
+ *          int16_t             expected    Commanded rotation (deg), counterclockwise
+ *          uint8_t             window      Largest error of the commanded rotation (deg)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          int16_t*            rotation    Estimated rotation (deg), counterclockwise, if matched
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if no rotation matches
+ *
+ *  NOTE:
+ *      The coarse pass assumes that the score does not change much within a bin, which holds for
+ *      the smooth profiles of the walls.
+ */
+bool SCANMATCH_match(const ScanProfile *before, const ScanProfile *after, int16_t expected,
+                     uint8_t window, int16_t *rotation) {
+    // [1] Coarse
+    int16_t best = expected;
+    int32_t bestScore = SCANMATCH_INVALID;
+    for (int16_t shift = expected - window; shift <= expected + window;
+         shift += SCANMATCH_STEP) {
+        int32_t score = SCANMATCH_score(before, after, shift);
+        if (score > bestScore) {
+            bestScore = score;
+            best = shift;
+        }
+    }
+    if (bestScore == SCANMATCH_INVALID)
+        return false;
+
+    // [2] Fine
+    int16_t centre = best;
+    for (int16_t shift = centre - SCANMATCH_STEP + 1; shift < centre + SCANMATCH_STEP; shift++) {
+        if (shift < expected - window || shift > expected + window || shift == centre)
+            continue;
+        int32_t score = SCANMATCH_score(before, after, shift);
+        if (score > bestScore) {
+            bestScore = score;
+            best = shift;
+        }
+    }
+
+    // [3] Match
+    if (bestScore < -SCANMATCH_MAX_ERROR * SCANMATCH_UNIT)
+        return false;
+    *rotation = best;
+    return true;
+}
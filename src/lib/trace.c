@@ -0,0 +1,280 @@
+/*H************************************************************************************************
+ * FILENAME:        trace.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the capture of the execution trace and its dump via Bluetooth.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        TRACE_init()
+ *      void        TRACE_start()
+ *      void        TRACE_stop()
+ *      void        TRACE_event(TraceId id, TracePhase phase, uint16_t arg)
+ *      uint16_t    TRACE_getEvents(const TraceEvent **events)
+ *      uint32_t    TRACE_getClockRate()
+ *      void        TRACE_flush()
+ *      void        TRACE_encode(const TraceEvent *event, char *text)
+ *      bool        TRACE_decode(const char *text, TraceEvent *event)
+ *      TraceLine   TRACE_decodeLine(const char *line, uint32_t *rate, TraceEvent *event)
+ *      uint64_t    TRACE_unwrap(uint64_t previous, uint32_t time)
+ *
+ * NOTES:
+ *      The buffer is written by the interrupt service routines and by the main loop only while a
+ *      capture runs, with the interrupts disabled, and read by TRACE_flush() only after it ended.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../inc/trace.h"
+
+#ifdef TRACE_ENABLED
+#ifdef TEST
+#include "../../tests/bluetooth_hal.h"
+#include "../../tests/timer_hal.h"
+#else
+#include "../../inc/bluetooth_hal.h"
+#include "../../inc/driverlib/driverlib.h"
+#endif
+
+#define TRACE_TEST_CLOCK_RATE 93750 /* Rate of the mocked timer ticks on the host            */
+
+TraceEvent traceBuffer[TRACE_BUFFER_SIZE]; /* Events of the current or of the last capture  */
+volatile uint16_t traceCount;              /* Events stored in the buffer                    */
+volatile bool traceIsCapturing;            /* True while the events are stored               */
+bool traceIsDumpPending;                   /* True from the end of a capture to its dump     */
+uint16_t traceSentLines;                   /* Lines of the dump already sent, header included */
+uint32_t traceClockRate;                   /* Timestamps per second                          */
+#endif
+
+static const char hexDigits[] = "0123456789ABCDEF";
+
+#ifdef TRACE_ENABLED
+static bool TRACE_lock() {
+#ifdef TEST
+    return true;
+#else
+    return Interrupt_disableMaster();
+#endif
+}
+
+static void TRACE_unlock(bool wasDisabled) {
+#ifndef TEST
+    if (!wasDisabled)
+        Interrupt_enableMaster();
+#endif
+}
+
+static uint32_t TRACE_now() {
+#ifdef TEST
+    return TIMER_HAL_getTicks();
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+/*F************************************************************************************************
+ * NAME: void TRACE_init()
+ *
+ * DESCRIPTION:
+ *      [1] Enables the trace unit of the core and starts its cycle counter
+ *      [2] Empties the buffer
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint32_t    traceClockRate      Set to MCLK
+ *          uint16_t    traceCount          Set to 0
+ *          bool        traceIsCapturing    Set to false
+ *          bool        traceIsDumpPending  Set to false
+ *
+ *  NOTE:
+ *      A debugger attached with openocd may use the cycle counter too, it only reads it.
+ */
+void TRACE_init() {
+    // [1] Cycle counter
+#ifdef TEST
+    traceClockRate = TRACE_TEST_CLOCK_RATE;
+#else
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    traceClockRate = CS_getMCLK();
+#endif
+
+    // [2] Buffer
+    traceIsCapturing = false;
+    traceIsDumpPending = false;
+    traceCount = 0;
+}
+
+void TRACE_start() {
+    bool wasDisabled = TRACE_lock();
+    traceCount = 0;
+    traceIsDumpPending = false;
+    traceIsCapturing = true;
+    TRACE_unlock(wasDisabled);
+}
+
+void TRACE_stop() {
+    bool wasDisabled = TRACE_lock();
+    if (traceIsCapturing) {
+        traceIsCapturing = false;
+        traceIsDumpPending = true;
+        traceSentLines = 0;
+    }
+    TRACE_unlock(wasDisabled);
+}
+
+void TRACE_event(TraceId id, TracePhase phase, uint16_t arg) {
+    if (!traceIsCapturing)
+        return;
+    uint32_t time = TRACE_now();
+    bool wasDisabled = TRACE_lock();
+    if (traceIsCapturing) {
+        TraceEvent *event = &traceBuffer[traceCount];
+        event->time = time;
+        event->arg = arg;
+        event->id = id;
+        event->phase = phase;
+        traceCount++;
+
+        // the buffer is full, the capture ends and waits for the dump
+        if (traceCount == TRACE_BUFFER_SIZE) {
+            traceIsCapturing = false;
+            traceIsDumpPending = true;
+            traceSentLines = 0;
+        }
+    }
+    TRACE_unlock(wasDisabled);
+}
+
+uint16_t TRACE_getEvents(const TraceEvent **events) {
+    *events = traceBuffer;
+    return traceCount;
+}
+
+uint32_t TRACE_getClockRate() { return traceClockRate; }
+
+/*F************************************************************************************************
+ * NAME: void TRACE_flush()
+ *
+ * DESCRIPTION:
+ *      [1] Sends the header with the rate of the timestamps
+ *      [2] Sends one event per line while the outgoing queue has space
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          TraceEvent[]    traceBuffer         Events of the ended capture
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t        traceSentLines      Updated
+ *          bool            traceIsDumpPending  Set to false when the whole capture has been sent
+ *
+ *  NOTE:
+ *      A capture of TRACE_BUFFER_SIZE events takes about 9s at 9600 baud.
+ */
+void TRACE_flush() {
+    if (traceIsCapturing || !traceIsDumpPending)
+        return;
+
+    char line[TRACE_EVENT_TEXT_LENGTH + 2];
+    while (traceIsDumpPending && BT_HAL_canSend()) {
+        // [1] Header
+        if (traceSentLines == 0) {
+            BT_HAL_sendMessage("%c%s%lu", TRACE_STREAM_PREFIX, TRACE_CLOCK_TAG,
+                               (unsigned long)traceClockRate);
+        }
+
+        // [2] Events
+        else {
+            line[0] = TRACE_STREAM_PREFIX;
+            TRACE_encode(&traceBuffer[traceSentLines - 1], &line[1]);
+            line[TRACE_EVENT_TEXT_LENGTH + 1] = '\0';
+            BT_HAL_sendMessage("%s", line);
+        }
+        traceSentLines++;
+        if (traceSentLines > traceCount)
+            traceIsDumpPending = false;
+    }
+}
+#endif
+
+void TRACE_encode(const TraceEvent *event, char *text) {
+    for (int8_t i = 7; i >= 0; i--)
+        *text++ = hexDigits[(event->time >> (4 * i)) & 0xF];
+    *text++ = hexDigits[(event->id >> 4) & 0xF];
+    *text++ = hexDigits[event->id & 0xF];
+    *text++ = event->phase;
+    for (int8_t i = 3; i >= 0; i--)
+        *text++ = hexDigits[(event->arg >> (4 * i)) & 0xF];
+}
+
+static bool TRACE_parseHex(const char *text, uint8_t length, uint32_t *value) {
+    *value = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        char c = text[i];
+        uint8_t digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else
+            return false;
+        *value = *value << 4 | digit;
+    }
+    return true;
+}
+
+bool TRACE_decode(const char *text, TraceEvent *event) {
+    uint32_t time, id, arg;
+    char phase = text[10];
+    if (!TRACE_parseHex(text, 8, &time) || !TRACE_parseHex(&text[8], 2, &id) ||
+        !TRACE_parseHex(&text[11], 4, &arg))
+        return false;
+    if (id >= TRACE_NUM_IDS ||
+        (phase != TRACE_PHASE_BEGIN && phase != TRACE_PHASE_END && phase != TRACE_PHASE_INSTANT))
+        return false;
+    event->time = time;
+    event->id = id;
+    event->phase = phase;
+    event->arg = arg;
+    return true;
+}
+
+TraceLine TRACE_decodeLine(const char *line, uint32_t *rate, TraceEvent *event) {
+    const char *text = strchr(line, TRACE_STREAM_PREFIX);
+    if (text == NULL)
+        return TRACE_LINE_OTHER;
+    text++;
+    if (strncmp(text, TRACE_CLOCK_TAG, strlen(TRACE_CLOCK_TAG)) == 0) {
+        *rate = strtoul(text + strlen(TRACE_CLOCK_TAG), NULL, 10);
+        return TRACE_LINE_CLOCK;
+    }
+    if (strlen(text) < TRACE_EVENT_TEXT_LENGTH || !TRACE_decode(text, event))
+        return TRACE_LINE_INVALID;
+    return TRACE_LINE_EVENT;
+}
+
+uint64_t TRACE_unwrap(uint64_t previous, uint32_t time) {
+    return previous + (uint32_t)(time - (uint32_t)previous);
+}
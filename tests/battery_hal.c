@@ -9,6 +9,7 @@
  *      void        BATTERY_HAL_init()
  *      uint16_t    BATTERY_HAL_getVoltage()
  *      uint8_t     BATTERY_HAL_getPercentage()
+ *      void        BATTERY_HAL_registerVoltageHook(BatteryHook hook)
  *
  * NOTES:
  *      The battery pack outputs 8.4V at peak that cannot be handled by the MSP432P401R so a
@@ -21,20 +22,34 @@
  *
  * CHANGES:
  * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Added simulation hook
+ * 18 Oct 2026  Maintainers     Recording of the readings
+ * 18 Oct 2026  Maintainers     Tracing of the readings
  */
 
 #include <stdlib.h>
 
 #include "battery_hal.h"
+#include "../inc/recorder.h"
+#include "../inc/trace.h"
 
 #define BATTERY_MAX_VOLTAGE 8400        /* Fully charged battery voltage (mV)                */
 #define BATTERY_MIN_VOLTAGE 6000        /* Discharged battery voltage (mV)                   */
 
+BatteryHook batteryHook = NULL;         /* Function providing the voltage, if any            */
+
 void BATTERY_HAL_init() {
 }
 
 uint16_t BATTERY_HAL_getVoltage() {
-    return BATTERY_MIN_VOLTAGE + rand() % (BATTERY_MAX_VOLTAGE - BATTERY_MIN_VOLTAGE);
+    uint16_t voltage;
+    if (batteryHook != NULL)
+        voltage = batteryHook();
+    else
+        voltage = BATTERY_MIN_VOLTAGE + rand() % (BATTERY_MAX_VOLTAGE - BATTERY_MIN_VOLTAGE);
+    RECORDER_RECORD(RECORDER_CHANNEL_BATTERY, voltage);
+    TRACE_INSTANT(TRACE_ID_BATTERY, voltage);
+    return voltage;
 }
 
 uint8_t BATTERY_HAL_getPercentage() {
@@ -42,4 +57,6 @@ uint8_t BATTERY_HAL_getPercentage() {
     uint8_t percentage =
         ((voltage - BATTERY_MIN_VOLTAGE) / (BATTERY_MAX_VOLTAGE - BATTERY_MIN_VOLTAGE)) * 100;
     return percentage;
-}
\ No newline at end of file
+}
+
+void BATTERY_HAL_registerVoltageHook(BatteryHook hook) { batteryHook = hook; }
@@ -9,6 +9,7 @@
  *      void        BATTERY_HAL_init()
  *      uint16_t    BATTERY_HAL_getVoltage()
  *      uint8_t     BATTERY_HAL_getPercentage()
+ *      void        BATTERY_HAL_registerVoltageHook(BatteryHook hook)
  *
  * NOTES:
  *
@@ -20,6 +21,7 @@
  * DATE         AUTHOR          DETAIL
  * 04 Feb 2024  Andrea Piccin   Refactoring
  * 04 Feb 2024  Andrea Piccin   Definitions moved to the source file, now hided to the user
+ * 18 Oct 2026  Maintainers     Added simulation hook
  */
 
 #ifndef BATTERY_HAL_H
@@ -27,6 +29,19 @@
 
 #include <stdint.h>
 
+/*T************************************************************************************************
+ * NAME: BatteryHook
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that provides the battery voltage in place of the random
+ *      value, it allows a simulator to model the discharge.
+ *
+ * SPECIFICATIONS:
+ *      Type:   uint16_t*
+ *      Args:   None
+ */
+typedef uint16_t (*BatteryHook)(void);
+
 /*F************************************************************************************************
  * NAME: void BATTERY_HAL_init()
  *
@@ -101,4 +116,26 @@ uint16_t BATTERY_HAL_getVoltage();
  */
 uint8_t BATTERY_HAL_getPercentage();
 
+/*F************************************************************************************************
+ * NAME: void BATTERY_HAL_registerVoltageHook(BatteryHook hook)
+ *
+ * DESCRIPTION:
+ *      Registers the function that provides the voltage of the battery pack.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          BatteryHook     hook            The function to register, NULL to remove it
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void BATTERY_HAL_registerVoltageHook(BatteryHook hook);
+
 #endif // BATTERY_HAL_H
\ No newline at end of file
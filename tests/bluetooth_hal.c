@@ -8,7 +8,11 @@
  * PUBLIC FUNCTIONS:
  *      void    BT_HAL_init()
  *      void    BT_HAL_sendMessage(const char* format, ...)
+ *      bool    BT_HAL_canSend()
+ *      uint16_t BT_HAL_getDroppedMessages()
  *      void    BT_HAL_registerMessageCallback(BTCallback callback)
+ *      void    BT_HAL_triggerMessageReceived(const char* message)
+ *      void    BT_HAL_registerTransmitHook(BTCallback hook)
  *
  * NOTES:
  *      Every time that a reception interrupt is generated by the eUSCI module related to the
@@ -21,30 +25,57 @@
  *
  * CHANGES:
  * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Outgoing messages are formatted and forwarded to the hook
+ * 18 Oct 2026  Maintainers     Recording of the received messages, added canSend()
+ * 18 Oct 2026  Maintainers     Tracing of the callback
+ * 18 Oct 2026  Maintainers     Added the count of the dropped messages, always 0
  */
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "bluetooth_hal.h"
+#include "../inc/recorder.h"
+#include "../inc/trace.h"
 
 #define BT_IN_BUFFER_SIZE 256       /* Max size of the unread message              */
+#define BT_OUT_MESSAGE_SIZE 30      /* Max size of an outgoing message             */
 
 BTCallback btCallback;                                  /* To call when a new message is ready */
 volatile char incomingMessageBuffer[BT_IN_BUFFER_SIZE]; /* Contains the incoming message       */
+BTCallback btTransmitHook = NULL;                       /* To call when a message is sent      */
 
 void BT_HAL_init() {}
 
-void BT_HAL_sendMessage(const char *format, ...) {}
+void BT_HAL_sendMessage(const char *format, ...) {
+    if (btTransmitHook == NULL)
+        return;
+
+    char msg[BT_OUT_MESSAGE_SIZE];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(msg, sizeof(msg), format, args);
+    va_end(args);
+    btTransmitHook(msg);
+}
+
+bool BT_HAL_canSend() { return true; }
+
+uint16_t BT_HAL_getDroppedMessages() { return 0; }
 
 void BT_HAL_registerMessageCallback(BTCallback callback) { btCallback = callback; }
 
 void BT_HAL_forwardAndReset() {
+    RECORDER_RECORD_STRING(RECORDER_CHANNEL_BT_RX, (const char *)incomingMessageBuffer);
+    TRACE_BEGIN(TRACE_ID_BT_RX, (uint8_t)incomingMessageBuffer[0]);
     if (btCallback != NULL)
         btCallback(incomingMessageBuffer);
+    TRACE_END(TRACE_ID_BT_RX);
 }
 
 void BT_HAL_triggerMessageReceived(const char* message) {
     strcpy(incomingMessageBuffer, message);
     BT_HAL_forwardAndReset();
-}
\ No newline at end of file
+}
+
+void BT_HAL_registerTransmitHook(BTCallback hook) { btTransmitHook = hook; }
@@ -8,8 +8,11 @@
  * PUBLIC FUNCTIONS:
  *      void        BT_HAL_init()
  *      void        BT_HAL_sendMessage(const char* format, ...)
+ *      bool        BT_HAL_canSend()
+ *      uint16_t    BT_HAL_getDroppedMessages()
  *      void        BT_HAL_registerMessageCallback(BTCallback callback)
  *      void        BT_HAL_triggerMessageReceived(const char* message)
+ *      void        BT_HAL_registerTransmitHook(BTCallback hook)
  *
  * NOTES:
  *
@@ -22,11 +25,15 @@
  * 04 Feb 2024  Andrea Piccin   Refactoring
  * 09 Feb 2024  Andrea Piccin   Introduced callback mechanism
  * 19 Feb 2024  Simone Rossi    Modified for testing
+ * 18 Oct 2026  Maintainers     Added simulation hook
+ * 18 Oct 2026  Maintainers     Added canSend()
+ * 18 Oct 2026  Maintainers     Added the count of the dropped messages
  */
 
 #ifndef BLUETOOTH_HAL_H
 #define BLUETOOTH_HAL_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -89,6 +96,57 @@ void BT_HAL_init();
  */
 void BT_HAL_sendMessage(const char *format, ...);
 
+/*F************************************************************************************************
+ * NAME: bool BT_HAL_canSend()
+ *
+ * DESCRIPTION:
+ *      Tells whether a new message would be accepted by BT_HAL_sendMessage().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the outgoing ring is full
+ *
+ *  NOTE:
+ */
+bool BT_HAL_canSend();
+
+/*F************************************************************************************************
+ * NAME: uint16_t BT_HAL_getDroppedMessages()
+ *
+ * DESCRIPTION:
+ *      Returns the number of messages dropped by BT_HAL_sendMessage() because the outgoing ring
+ *      was full.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Dropped messages since the init, it stops at UINT16_MAX
+ *
+ *  NOTE:
+ */
+uint16_t BT_HAL_getDroppedMessages();
+
 /*F************************************************************************************************
  * NAME:  void BT_HAL_registerMessageCallback(BTCallback callback)
  *
@@ -133,4 +191,26 @@ void BT_HAL_registerMessageCallback(BTCallback callback);
  */
 void BT_HAL_triggerMessageReceived(const char* message);
 
+/*F************************************************************************************************
+ * NAME: void BT_HAL_registerTransmitHook(BTCallback hook)
+ *
+ * DESCRIPTION:
+ *      Registers the function that receives every formatted outgoing message.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          BTCallback      hook            The function to register, NULL to remove it
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void BT_HAL_registerTransmitHook(BTCallback hook);
+
 #endif // BLUETOOTH_HAL_H
\ No newline at end of file
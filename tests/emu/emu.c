@@ -0,0 +1,332 @@
+/*H************************************************************************************************
+ * FILENAME:        emu.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the core of the host emulation of the MSP432 peripherals and the
+ *      functions of inc/driverlib/interrupt.h used by the HALs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        EMU_init()
+ *      uint64_t    EMU_now()
+ *      uint32_t    EMU_schedule(uint64_t delay, EmuEventCallback callback, uint32_t arg)
+ *      void        EMU_cancel(uint32_t id)
+ *      void        EMU_run(uint64_t duration)
+ *      void        EMU_access()
+ *      EmuIsrStats EMU_getIsrStats(uint32_t interruptNumber)
+ *      uint64_t    EMU_ticksToTime(uint64_t ticks, uint32_t hz)
+ *      uint64_t    EMU_timeToTicks(uint64_t time, uint32_t hz)
+ *
+ * NOTES:
+ *      The dispatcher behaves as the NVIC with all the priorities at their reset value: a request
+ *      is served when it is enabled and the interrupts are globally enabled, the lowest number
+ *      first, and an interrupt service routine is never preempted. The requests are levels, an
+ *      interrupt service routine that does not clear its flag is executed again.
+ *      The interrupts without a routine in the HALs end in a trap, as in the startup code.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "emu.h"
+#include "emu_adc14.h"
+#include "emu_gpio.h"
+#include "emu_timer32.h"
+#include "emu_timer_a.h"
+#include "emu_uart.h"
+#include "../../inc/driverlib/driverlib.h"
+
+/*T************************************************************************************************
+ * NAME: EmuEvent
+ *
+ * DESCRIPTION:
+ *      Represent an event scheduled in virtual time.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t            id          Identifier, EMU_NO_EVENT if the slot is free
+ *              uint64_t            time        Virtual time of the execution (ns)
+ *              EmuEventCallback    callback    Function to execute
+ *              uint32_t            arg         Argument of the function
+ */
+typedef struct {
+    uint32_t id;
+    uint64_t time;
+    EmuEventCallback callback;
+    uint32_t arg;
+} EmuEvent;
+
+typedef void (*EmuHandler)(void);
+
+static EmuEvent events[EMU_MAX_EVENTS];               /* Pending events                       */
+static uint64_t now;                                  /* Current virtual time                 */
+static uint32_t nextId;                               /* Identifier of the next event         */
+static bool isMasterEnabled;                          /* Interrupts globally enabled          */
+static bool isInIsr;                                  /* An interrupt is being served         */
+static bool isEnabled[EMU_NUM_INTERRUPTS];            /* Interrupts enabled in the NVIC       */
+static bool isRequested[EMU_NUM_INTERRUPTS];          /* Requests seen by the dispatcher      */
+static uint64_t requestTime[EMU_NUM_INTERRUPTS];      /* Time of the first sight of a request */
+static EmuHandler handlers[EMU_NUM_INTERRUPTS];       /* Vector table                         */
+static EmuIsrStats isrStats[EMU_NUM_INTERRUPTS];      /* Executions of the routines           */
+
+static void EMU_trap(uint32_t interruptNumber) {
+    fprintf(stderr, "Unhandled interrupt %u at %lluns\n", interruptNumber,
+            (unsigned long long)now);
+    abort();
+}
+
+/* Default routines, the ones of the HALs replace them at link time */
+#define EMU_DEFAULT_HANDLER(name, number)                                                          \
+    __attribute__((weak)) void name(void) { EMU_trap(number); }
+
+EMU_DEFAULT_HANDLER(EUSCIA0_IRQHandler, INT_EUSCIA0)
+EMU_DEFAULT_HANDLER(EUSCIA1_IRQHandler, INT_EUSCIA1)
+EMU_DEFAULT_HANDLER(EUSCIA2_IRQHandler, INT_EUSCIA2)
+EMU_DEFAULT_HANDLER(EUSCIA3_IRQHandler, INT_EUSCIA3)
+EMU_DEFAULT_HANDLER(ADC14_IRQHandler, INT_ADC14)
+EMU_DEFAULT_HANDLER(T32_INT1_IRQHandler, INT_T32_INT1)
+EMU_DEFAULT_HANDLER(T32_INT2_IRQHandler, INT_T32_INT2)
+EMU_DEFAULT_HANDLER(PORT1_IRQHandler, INT_PORT1)
+EMU_DEFAULT_HANDLER(PORT2_IRQHandler, INT_PORT2)
+EMU_DEFAULT_HANDLER(PORT3_IRQHandler, INT_PORT3)
+EMU_DEFAULT_HANDLER(PORT4_IRQHandler, INT_PORT4)
+EMU_DEFAULT_HANDLER(PORT5_IRQHandler, INT_PORT5)
+EMU_DEFAULT_HANDLER(PORT6_IRQHandler, INT_PORT6)
+
+static void EMU_unused() { EMU_trap(0); }
+
+void EMU_init() {
+    for (uint8_t i = 0; i < EMU_MAX_EVENTS; i++)
+        events[i].id = EMU_NO_EVENT;
+    now = 0;
+    nextId = 1;
+    isMasterEnabled = true;
+    isInIsr = false;
+    for (uint8_t i = 0; i < EMU_NUM_INTERRUPTS; i++) {
+        isEnabled[i] = false;
+        isRequested[i] = false;
+        handlers[i] = EMU_unused;
+        isrStats[i] = (EmuIsrStats){0};
+    }
+    handlers[INT_EUSCIA0] = EUSCIA0_IRQHandler;
+    handlers[INT_EUSCIA1] = EUSCIA1_IRQHandler;
+    handlers[INT_EUSCIA2] = EUSCIA2_IRQHandler;
+    handlers[INT_EUSCIA3] = EUSCIA3_IRQHandler;
+    handlers[INT_ADC14] = ADC14_IRQHandler;
+    handlers[INT_T32_INT1] = T32_INT1_IRQHandler;
+    handlers[INT_T32_INT2] = T32_INT2_IRQHandler;
+    handlers[INT_PORT1] = PORT1_IRQHandler;
+    handlers[INT_PORT2] = PORT2_IRQHandler;
+    handlers[INT_PORT3] = PORT3_IRQHandler;
+    handlers[INT_PORT4] = PORT4_IRQHandler;
+    handlers[INT_PORT5] = PORT5_IRQHandler;
+    handlers[INT_PORT6] = PORT6_IRQHandler;
+
+    EMU_GPIO_reset();
+    EMU_TIMER_A_reset();
+    EMU_TIMER32_reset();
+    EMU_UART_reset();
+    EMU_ADC14_reset();
+}
+
+uint64_t EMU_now() { return now; }
+
+uint32_t EMU_schedule(uint64_t delay, EmuEventCallback callback, uint32_t arg) {
+    for (uint8_t i = 0; i < EMU_MAX_EVENTS; i++) {
+        if (events[i].id == EMU_NO_EVENT) {
+            events[i].id = nextId++;
+            events[i].time = now + delay;
+            events[i].callback = callback;
+            events[i].arg = arg;
+            return events[i].id;
+        }
+    }
+    return EMU_NO_EVENT;
+}
+
+void EMU_cancel(uint32_t id) {
+    if (id == EMU_NO_EVENT)
+        return;
+    for (uint8_t i = 0; i < EMU_MAX_EVENTS; i++) {
+        if (events[i].id == id)
+            events[i].id = EMU_NO_EVENT;
+    }
+}
+
+static bool EMU_isRequesting(uint32_t interruptNumber) {
+    if (interruptNumber >= INT_EUSCIA0 && interruptNumber <= INT_EUSCIA3)
+        return EMU_UART_isRequesting(interruptNumber - INT_EUSCIA0);
+    if (interruptNumber == INT_ADC14)
+        return EMU_ADC14_isRequesting();
+    if (interruptNumber == INT_T32_INT1 || interruptNumber == INT_T32_INT2)
+        return EMU_TIMER32_isRequesting(interruptNumber - INT_T32_INT1);
+    if (interruptNumber >= INT_PORT1 && interruptNumber <= INT_PORT6)
+        return EMU_GPIO_isRequesting(interruptNumber - INT_PORT1 + GPIO_PORT_P1);
+    return false;
+}
+
+static uint64_t EMU_hostTime() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * EMU_SECOND + time.tv_nsec;
+}
+
+/*F************************************************************************************************
+ * NAME: void EMU_dispatch()
+ *
+ * DESCRIPTION:
+ *      [1] Timestamps the new requests of the peripherals
+ *      [2] If the interrupts can be served, executes the routine of the enabled request with the
+ *          lowest number and measures it, until there are no more
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          bool        isMasterEnabled
+ *          bool[]      isEnabled
+ *          EmuHandler  handlers
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          bool[]          isRequested     Updated
+ *          uint64_t[]      requestTime     Updated
+ *          EmuIsrStats[]   isrStats        Updated
+ *
+ *  NOTE:
+ *      The requests are seen at the granularity of the driverlib calls and of the events, the
+ *      latency is therefore exact for the requests raised by the events.
+ */
+static void EMU_dispatch() {
+    while (true) {
+        // [1] Requests
+        int32_t next = -1;
+        for (uint32_t i = 0; i < EMU_NUM_INTERRUPTS; i++) {
+            if (!EMU_isRequesting(i)) {
+                isRequested[i] = false;
+                continue;
+            }
+            if (!isRequested[i]) {
+                isRequested[i] = true;
+                requestTime[i] = now;
+            }
+            if (next < 0 && isEnabled[i])
+                next = i;
+        }
+        if (next < 0 || !isMasterEnabled || isInIsr)
+            return;
+
+        // [2] Routine
+        EmuIsrStats *stats = &isrStats[next];
+        uint64_t latency = now - requestTime[next];
+        uint64_t entry = now;
+        uint64_t hostEntry = EMU_hostTime();
+        isInIsr = true;
+        handlers[next]();
+        isInIsr = false;
+        uint64_t hostTime = EMU_hostTime() - hostEntry;
+        uint64_t cpuTime = now - entry;
+        stats->count++;
+        stats->hostTime += hostTime;
+        stats->cpuTime += cpuTime;
+        if (hostTime > stats->maxHostTime)
+            stats->maxHostTime = hostTime;
+        if (cpuTime > stats->maxCpuTime)
+            stats->maxCpuTime = cpuTime;
+        if (latency > stats->maxLatency)
+            stats->maxLatency = latency;
+        isRequested[next] = false; // a request still active after the routine is a new one
+    }
+}
+
+static bool EMU_step(uint64_t limit) {
+    // find the earliest event, the identifiers preserve the scheduling order on ties
+    EmuEvent *next = NULL;
+    for (uint8_t i = 0; i < EMU_MAX_EVENTS; i++) {
+        if (events[i].id == EMU_NO_EVENT)
+            continue;
+        if (next == NULL || events[i].time < next->time ||
+            (events[i].time == next->time && events[i].id < next->id))
+            next = &events[i];
+    }
+    if (next == NULL || next->time > limit)
+        return false;
+    // free the slot before the execution, the callback may schedule new events
+    EmuEventCallback callback = next->callback;
+    uint32_t arg = next->arg;
+    if (next->time > now)
+        now = next->time;
+    next->id = EMU_NO_EVENT;
+    callback(arg);
+    return true;
+}
+
+static void EMU_advance(uint64_t time) {
+    // the requests raised by the last driverlib call are served before the time moves on
+    EMU_dispatch();
+    while (EMU_step(time))
+        EMU_dispatch();
+    if (time > now)
+        now = time;
+    EMU_dispatch();
+}
+
+void EMU_run(uint64_t duration) { EMU_advance(now + duration); }
+
+void EMU_access() { EMU_advance(now + EMU_CALL_TIME); }
+
+EmuIsrStats EMU_getIsrStats(uint32_t interruptNumber) {
+    if (interruptNumber >= EMU_NUM_INTERRUPTS)
+        return (EmuIsrStats){0};
+    return isrStats[interruptNumber];
+}
+
+uint64_t EMU_ticksToTime(uint64_t ticks, uint32_t hz) {
+    return ticks / hz * EMU_SECOND + (ticks % hz * EMU_SECOND + hz - 1) / hz;
+}
+
+uint64_t EMU_timeToTicks(uint64_t time, uint32_t hz) {
+    return time / EMU_SECOND * hz + time % EMU_SECOND * hz / EMU_SECOND;
+}
+
+/* inc/driverlib/interrupt.h */
+
+bool Interrupt_enableMaster(void) {
+    bool wasDisabled = !isMasterEnabled;
+    isMasterEnabled = true;
+    EMU_access();
+    return wasDisabled;
+}
+
+bool Interrupt_disableMaster(void) {
+    bool wasDisabled = !isMasterEnabled;
+    isMasterEnabled = false;
+    EMU_access();
+    return wasDisabled;
+}
+
+void Interrupt_enableInterrupt(uint32_t interruptNumber) {
+    if (interruptNumber < EMU_NUM_INTERRUPTS)
+        isEnabled[interruptNumber] = true;
+    EMU_access();
+}
+
+void Interrupt_disableInterrupt(uint32_t interruptNumber) {
+    if (interruptNumber < EMU_NUM_INTERRUPTS)
+        isEnabled[interruptNumber] = false;
+    EMU_access();
+}
+
+void Interrupt_registerInterrupt(uint32_t interruptNumber, void (*intHandler)(void)) {
+    if (interruptNumber < EMU_NUM_INTERRUPTS)
+        handlers[interruptNumber] = intHandler;
+    EMU_access();
+}
@@ -0,0 +1,312 @@
+/*H************************************************************************************************
+ * FILENAME:        emu.h
+ *
+ * DESCRIPTION:
+ *      This header provides the core of the host emulation of the MSP432 peripherals, which lets
+ *      the real HALs in src/hal run on the host: virtual time, the events of the peripherals and
+ *      an interrupt dispatcher that calls the real interrupt service routines.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        EMU_init()
+ *      uint64_t    EMU_now()
+ *      uint32_t    EMU_schedule(uint64_t delay, EmuEventCallback callback, uint32_t arg)
+ *      void        EMU_cancel(uint32_t id)
+ *      void        EMU_run(uint64_t duration)
+ *      void        EMU_access()
+ *      EmuIsrStats EMU_getIsrStats(uint32_t interruptNumber)
+ *      uint64_t    EMU_ticksToTime(uint64_t ticks, uint32_t hz)
+ *      uint64_t    EMU_timeToTicks(uint64_t time, uint32_t hz)
+ *
+ * NOTES:
+ *      The emulation is at the driverlib call level: the functions of inc/driverlib used by the
+ *      HALs are implemented in tests/emu/emu_*.c on top of a model of the peripheral, so the HALs
+ *      are compiled unmodified and src/drivers is not linked.
+ *      Every driverlib call costs EMU_CALL_TIME of virtual time, the busy waits of the HALs (e.g.
+ *      the trigger of the ultrasonic sensor) therefore end, and the interrupts preempt the main
+ *      code between two calls, as they would between two register accesses on the car.
+ *      The emulated build does not link the mocked HALs in tests, see the emu target of the
+ *      Makefile.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef EMU_H
+#define EMU_H
+
+#define EMU_MAX_EVENTS 32         /* Maximum number of pending events                         */
+#define EMU_NO_EVENT 0            /* Identifier that never corresponds to a scheduled event   */
+#define EMU_CALL_TIME 500         /* Virtual time of a driverlib call (ns)                    */
+#define EMU_NUM_INTERRUPTS 64     /* Interrupt numbers handled by the dispatcher              */
+#define EMU_MCLK 24000000         /* MCLK set by System_init() (Hz)                           */
+#define EMU_SMCLK 24000000        /* SMCLK set by System_init() (Hz)                          */
+#define EMU_ACLK 32768            /* ACLK from the low frequency crystal (Hz)                 */
+#define EMU_SECOND 1000000000ull  /* Virtual time of a second (ns)                            */
+
+/*T************************************************************************************************
+ * NAME: EmuEventCallback
+ *
+ * DESCRIPTION:
+ *      Represent the function executed by the emulator at the time of a scheduled event.
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Vars:   uint32_t    arg     Argument given to EMU_schedule()
+ */
+typedef void (*EmuEventCallback)(uint32_t arg);
+
+/*T************************************************************************************************
+ * NAME: EmuIsrStats
+ *
+ * DESCRIPTION:
+ *      Represent the executions of an interrupt service routine.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    count       Executions
+ *              uint64_t    hostTime    Time spent on the host (ns)
+ *              uint64_t    maxHostTime Longest execution on the host (ns)
+ *              uint64_t    cpuTime     Virtual time spent, EMU_CALL_TIME per driverlib call (ns)
+ *              uint64_t    maxCpuTime  Longest execution in virtual time (ns)
+ *              uint64_t    maxLatency  Longest virtual time from the request to the entry (ns)
+ */
+typedef struct {
+    uint32_t count;
+    uint64_t hostTime;
+    uint64_t maxHostTime;
+    uint64_t cpuTime;
+    uint64_t maxCpuTime;
+    uint64_t maxLatency;
+} EmuIsrStats;
+
+/*F************************************************************************************************
+ * NAME: void EMU_init()
+ *
+ * DESCRIPTION:
+ *      Resets the virtual time, the events, the interrupt controller and all the peripherals.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The interrupts are globally enabled, as after the startup code.
+ */
+void EMU_init();
+
+/*F************************************************************************************************
+ * NAME: uint64_t EMU_now()
+ *
+ * DESCRIPTION:
+ *      Returns the virtual time elapsed since EMU_init().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint64_t
+ *          Value:  Virtual time (ns)
+ *
+ *  NOTE:
+ */
+uint64_t EMU_now();
+
+/*F************************************************************************************************
+ * NAME: uint32_t EMU_schedule(uint64_t delay, EmuEventCallback callback, uint32_t arg)
+ *
+ * DESCRIPTION:
+ *      Schedules the execution of a function after the given virtual time.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t            delay       Virtual time from now (ns)
+ *          EmuEventCallback    callback    Function to execute
+ *          uint32_t            arg         Argument of the function
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Identifier of the event, EMU_NO_EVENT if there are too many pending events
+ *
+ *  NOTE:
+ *      Events at the same time are executed in the order in which they have been scheduled.
+ */
+uint32_t EMU_schedule(uint64_t delay, EmuEventCallback callback, uint32_t arg);
+
+/*F************************************************************************************************
+ * NAME: void EMU_cancel(uint32_t id)
+ *
+ * DESCRIPTION:
+ *      Removes a pending event, nothing happens if it has already been executed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    id      Identifier returned by EMU_schedule()
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void EMU_cancel(uint32_t id);
+
+/*F************************************************************************************************
+ * NAME: void EMU_run(uint64_t duration)
+ *
+ * DESCRIPTION:
+ *      Lets the given virtual time pass with the main code idle, executing the events and the
+ *      interrupt service routines they request.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t    duration    Virtual time (ns)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void EMU_run(uint64_t duration);
+
+/*F************************************************************************************************
+ * NAME: void EMU_access()
+ *
+ * DESCRIPTION:
+ *      Accounts for the execution of a driverlib call: advances the virtual time by EMU_CALL_TIME
+ *      and, outside of the interrupt service routines, executes the pending ones.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Called at the start of every emulated driverlib function, the peripherals use it and the
+ *      test bench must not.
+ */
+void EMU_access();
+
+/*F************************************************************************************************
+ * NAME: EmuIsrStats EMU_getIsrStats(uint32_t interruptNumber)
+ *
+ * DESCRIPTION:
+ *      Returns the executions of the interrupt service routine of an interrupt since EMU_init().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    interruptNumber     INT_* number of inc/driverlib/interrupt.h
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   EmuIsrStats
+ *          Value:  Executions of the routine
+ *
+ *  NOTE:
+ */
+EmuIsrStats EMU_getIsrStats(uint32_t interruptNumber);
+
+/*F************************************************************************************************
+ * NAME: uint64_t EMU_ticksToTime(uint64_t ticks, uint32_t hz)
+ *
+ * DESCRIPTION:
+ *      Converts clock ticks to virtual time without overflow, rounding up so that the ticks are
+ *      complete at the returned time.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t    ticks   Number of ticks
+ *          uint32_t    hz      Frequency of the clock
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint64_t
+ *          Value:  Virtual time (ns)
+ *
+ *  NOTE:
+ */
+uint64_t EMU_ticksToTime(uint64_t ticks, uint32_t hz);
+
+/*F************************************************************************************************
+ * NAME: uint64_t EMU_timeToTicks(uint64_t time, uint32_t hz)
+ *
+ * DESCRIPTION:
+ *      Converts virtual time to clock ticks without overflow.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t    time    Virtual time (ns)
+ *          uint32_t    hz      Frequency of the clock
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint64_t
+ *          Value:  Complete ticks
+ *
+ *  NOTE:
+ */
+uint64_t EMU_timeToTicks(uint64_t time, uint32_t hz);
+
+#endif // EMU_H
@@ -0,0 +1,182 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_adc14.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the emulation of the ADC14 and the functions of
+ *      inc/driverlib/adc14.h used by the HALs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        EMU_ADC14_reset()
+ *      bool        EMU_ADC14_isRequesting()
+ *      void        EMU_ADC14_setInput(uint8_t channel, uint16_t millivolts)
+ *      uint32_t    EMU_ADC14_getConversions()
+ *
+ * NOTES:
+ *      Only the single sample mode with manual trigger is emulated, a trigger during a conversion
+ *      is ignored. The interrupt flag of a memory is cleared by reading its result.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include "emu.h"
+#include "emu_adc14.h"
+#include "../../inc/driverlib/driverlib.h"
+
+/*T************************************************************************************************
+ * NAME: EmuAdc14
+ *
+ * DESCRIPTION:
+ *      Represent the state of the converter.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   bool        isEnabled       The module is on
+ *              bool        isConverting    Conversions enabled
+ *              uint32_t    hz              Conversion clock after the dividers
+ *              uint8_t     memory          Destination of the single sample mode
+ *              uint8_t[]   channels        Input of every memory
+ *              uint16_t[]  results         Result of every memory
+ *              uint16_t[]  inputs          Voltage of every input (mV)
+ *              uint32_t    ifg             Interrupt flags of the memories
+ *              uint32_t    ier             Enabled interrupts of the memories
+ *              uint32_t    event           End of the conversion in progress
+ *              uint32_t    conversions     Completed conversions
+ */
+typedef struct {
+    bool isEnabled;
+    bool isConverting;
+    uint32_t hz;
+    uint8_t memory;
+    uint8_t channels[EMU_ADC14_CHANNELS];
+    uint16_t results[EMU_ADC14_CHANNELS];
+    uint16_t inputs[EMU_ADC14_CHANNELS];
+    uint32_t ifg;
+    uint32_t ier;
+    uint32_t event;
+    uint32_t conversions;
+} EmuAdc14;
+
+static EmuAdc14 adc; /* State of the converter */
+
+static uint8_t EMU_ADC14_memory(uint32_t memorySelect) {
+    return memorySelect != 0 ? __builtin_ctz(memorySelect) : 0;
+}
+
+static void EMU_ADC14_onEnd(uint32_t memory) {
+    adc.event = EMU_NO_EVENT;
+    uint32_t millivolts = adc.inputs[adc.channels[memory]];
+    uint32_t result = millivolts * 16384 / EMU_ADC14_REFERENCE;
+    adc.results[memory] = result > 16383 ? 16383 : result;
+    adc.ifg |= 1u << memory;
+    adc.conversions++;
+}
+
+void EMU_ADC14_reset() {
+    EMU_cancel(adc.event);
+    adc = (EmuAdc14){0};
+    adc.event = EMU_NO_EVENT;
+}
+
+bool EMU_ADC14_isRequesting() { return (adc.ifg & adc.ier) != 0; }
+
+void EMU_ADC14_setInput(uint8_t channel, uint16_t millivolts) {
+    if (channel < EMU_ADC14_CHANNELS)
+        adc.inputs[channel] = millivolts;
+}
+
+uint32_t EMU_ADC14_getConversions() { return adc.conversions; }
+
+/* inc/driverlib/adc14.h */
+
+void ADC14_enableModule(void) {
+    EMU_access();
+    adc.isEnabled = true;
+}
+
+bool ADC14_initModule(uint32_t clockSource, uint32_t clockPredivider, uint32_t clockDivider,
+                      uint32_t internalChannelMask) {
+    EMU_access();
+    switch (clockSource) {
+    case ADC_CLOCKSOURCE_ADCOSC:
+        adc.hz = 25000000;
+        break;
+    case ADC_CLOCKSOURCE_SYSOSC:
+        adc.hz = 5000000;
+        break;
+    case ADC_CLOCKSOURCE_ACLK:
+        adc.hz = EMU_ACLK;
+        break;
+    case ADC_CLOCKSOURCE_MCLK:
+        adc.hz = EMU_MCLK;
+        break;
+    default:
+        adc.hz = EMU_SMCLK;
+    }
+    static const uint8_t predividers[] = {1, 4, 32, 64};
+    adc.hz /= predividers[(clockPredivider & ADC14_CTL0_PDIV_MASK) >> ADC14_CTL0_PDIV_OFS];
+    adc.hz /= ((clockDivider & ADC14_CTL0_DIV_MASK) >> ADC14_CTL0_DIV_OFS) + 1;
+    return true;
+}
+
+bool ADC14_configureSingleSampleMode(uint32_t memoryDestination, bool repeatMode) {
+    EMU_access();
+    adc.memory = EMU_ADC14_memory(memoryDestination);
+    return true;
+}
+
+bool ADC14_configureConversionMemory(uint32_t memorySelect, uint32_t refSelect,
+                                     uint32_t channelSelect, bool differntialMode) {
+    EMU_access();
+    for (uint8_t i = 0; i < EMU_ADC14_CHANNELS; i++) {
+        if (memorySelect & (1u << i))
+            adc.channels[i] = channelSelect & ADC14_MCTLN_INCH_MASK;
+    }
+    return true;
+}
+
+bool ADC14_enableSampleTimer(uint32_t multiSampleConvert) {
+    EMU_access();
+    return true;
+}
+
+bool ADC14_enableConversion(void) {
+    EMU_access();
+    adc.isConverting = adc.isEnabled;
+    return adc.isConverting;
+}
+
+bool ADC14_toggleConversionTrigger(void) {
+    EMU_access();
+    if (!adc.isConverting || adc.hz == 0)
+        return false;
+    if (adc.event == EMU_NO_EVENT)
+        adc.event = EMU_schedule(EMU_ticksToTime(EMU_ADC14_CYCLES, adc.hz), EMU_ADC14_onEnd,
+                                 adc.memory);
+    return true;
+}
+
+uint_fast16_t ADC14_getResult(uint32_t memorySelect) {
+    EMU_access();
+    uint8_t memory = EMU_ADC14_memory(memorySelect);
+    adc.ifg &= ~(1u << memory);
+    return adc.results[memory];
+}
+
+uint_fast64_t ADC14_getEnabledInterruptStatus(void) {
+    EMU_access();
+    return adc.ifg & adc.ier;
+}
+
+void ADC14_enableInterrupt(uint_fast64_t mask) {
+    EMU_access();
+    adc.ier |= mask;
+}
+
+void ADC14_clearInterruptFlag(uint_fast64_t mask) {
+    EMU_access();
+    adc.ifg &= ~mask;
+}
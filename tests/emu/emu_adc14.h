@@ -0,0 +1,132 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_adc14.h
+ *
+ * DESCRIPTION:
+ *      This header provides the emulation of the ADC14 in single sample mode, with the conversion
+ *      time given by its clock, and the function used by the test bench to set the analog inputs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        EMU_ADC14_reset()
+ *      bool        EMU_ADC14_isRequesting()
+ *      void        EMU_ADC14_setInput(uint8_t channel, uint16_t millivolts)
+ *      uint32_t    EMU_ADC14_getConversions()
+ *
+ * NOTES:
+ *      The reference is AVCC (3.3V) and the resolution 14 bits, as configured by the battery HAL.
+ *      The result of a memory is the one of its last completed conversion: reading it before the
+ *      end of the conversion returns the previous value, as on the device.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef EMU_ADC14_H
+#define EMU_ADC14_H
+
+#define EMU_ADC14_CHANNELS 32       /* Analog inputs and conversion memories                 */
+#define EMU_ADC14_REFERENCE 3300    /* Positive reference, AVCC (mV)                         */
+#define EMU_ADC14_CYCLES 20         /* Clock cycles of a 14 bit conversion with its sampling */
+
+/*F************************************************************************************************
+ * NAME: void EMU_ADC14_reset()
+ *
+ * DESCRIPTION:
+ *      Disables the converter and sets all the inputs to 0V.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void EMU_ADC14_reset();
+
+/*F************************************************************************************************
+ * NAME: bool EMU_ADC14_isRequesting()
+ *
+ * DESCRIPTION:
+ *      Tells whether the converter requests its interrupt, i.e. a memory has both the flag and
+ *      the interrupt enabled.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the interrupt is requested
+ *
+ *  NOTE:
+ */
+bool EMU_ADC14_isRequesting();
+
+/*F************************************************************************************************
+ * NAME: void EMU_ADC14_setInput(uint8_t channel, uint16_t millivolts)
+ *
+ * DESCRIPTION:
+ *      Sets the voltage of an analog input, sampled by the next conversions.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     channel     Index of the input, 14 for ADC_INPUT_A14
+ *          uint16_t    millivolts  Voltage on the pin (mV), clipped to the reference
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void EMU_ADC14_setInput(uint8_t channel, uint16_t millivolts);
+
+/*F************************************************************************************************
+ * NAME: uint32_t EMU_ADC14_getConversions()
+ *
+ * DESCRIPTION:
+ *      Returns the number of conversions completed since EMU_init().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Completed conversions
+ *
+ *  NOTE:
+ */
+uint32_t EMU_ADC14_getConversions();
+
+#endif // EMU_ADC14_H
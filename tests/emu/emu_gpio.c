@@ -0,0 +1,206 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_gpio.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the emulation of the digital I/O ports and the functions of
+ *      inc/driverlib/gpio.h used by the HALs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    EMU_GPIO_reset()
+ *      bool    EMU_GPIO_isRequesting(uint8_t port)
+ *      void    EMU_GPIO_setInput(uint8_t port, uint8_t pins, bool isHigh)
+ *      void    EMU_GPIO_scheduleInput(uint64_t delay, uint8_t port, uint8_t pins, bool isHigh)
+ *      bool    EMU_GPIO_getOutput(uint8_t port, uint8_t pin)
+ *      void    EMU_GPIO_registerOutputCallback(EmuGpioCallback callback)
+ *
+ * NOTES:
+ *      Only the ports from P1 to P6 have interrupts. The pull resistors and the module functions
+ *      are recorded but they do not change the levels.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stddef.h>
+
+#include "emu.h"
+#include "emu_gpio.h"
+#include "../../inc/driverlib/driverlib.h"
+
+/*T************************************************************************************************
+ * NAME: EmuGpioPort
+ *
+ * DESCRIPTION:
+ *      Represent the registers of a port.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint8_t     dir     Output pins
+ *              uint8_t     out     Levels driven on the output pins
+ *              uint8_t     in      Levels driven from outside on the input pins
+ *              uint8_t     ren     Pins with a pull resistor
+ *              uint8_t     sel     Pins assigned to a module
+ *              uint8_t     ie      Pins with the interrupt enabled
+ *              uint8_t     ies     Pins interrupting on the falling edge
+ *              uint8_t     iesSet  Pins whose edge has been selected
+ *              uint8_t     ifg     Pins with the interrupt flag set
+ */
+typedef struct {
+    uint8_t dir;
+    uint8_t out;
+    uint8_t in;
+    uint8_t ren;
+    uint8_t sel;
+    uint8_t ie;
+    uint8_t ies;
+    uint8_t iesSet;
+    uint8_t ifg;
+} EmuGpioPort;
+
+static EmuGpioPort ports[EMU_GPIO_PORTS]; /* Registers of the ports, P1 at index 0             */
+static EmuGpioCallback outputCallback;    /* Model of the devices connected to the outputs     */
+
+static EmuGpioPort *EMU_GPIO_port(uint_fast8_t port) {
+    static EmuGpioPort none;
+    if (port < GPIO_PORT_P1 || port > GPIO_PORT_PJ)
+        return &none;
+    return &ports[port - GPIO_PORT_P1];
+}
+
+void EMU_GPIO_reset() {
+    for (uint8_t i = 0; i < EMU_GPIO_PORTS; i++)
+        ports[i] = (EmuGpioPort){0};
+    outputCallback = NULL;
+}
+
+bool EMU_GPIO_isRequesting(uint8_t port) {
+    const EmuGpioPort *p = EMU_GPIO_port(port);
+    return port <= GPIO_PORT_P6 && (p->ifg & p->ie) != 0;
+}
+
+void EMU_GPIO_setInput(uint8_t port, uint8_t pins, bool isHigh) {
+    EmuGpioPort *p = EMU_GPIO_port(port);
+    uint8_t changed = (isHigh ? ~p->in : p->in) & pins & ~p->dir;
+    p->in = isHigh ? p->in | pins : p->in & ~pins;
+    // an edge sets the flag even with the interrupt disabled
+    uint8_t selected = isHigh ? ~p->ies : p->ies;
+    p->ifg |= changed & (selected | ~p->iesSet);
+}
+
+static void EMU_GPIO_onScheduledInput(uint32_t arg) {
+    EMU_GPIO_setInput(arg >> 16, arg >> 8, arg & 1);
+}
+
+void EMU_GPIO_scheduleInput(uint64_t delay, uint8_t port, uint8_t pins, bool isHigh) {
+    EMU_schedule(delay, EMU_GPIO_onScheduledInput, port << 16 | pins << 8 | isHigh);
+}
+
+bool EMU_GPIO_getOutput(uint8_t port, uint8_t pin) {
+    const EmuGpioPort *p = EMU_GPIO_port(port);
+    return (p->dir & p->out & pin) != 0;
+}
+
+void EMU_GPIO_registerOutputCallback(EmuGpioCallback callback) { outputCallback = callback; }
+
+static void EMU_GPIO_drive(uint_fast8_t port, uint_fast16_t pins, bool isHigh) {
+    EmuGpioPort *p = EMU_GPIO_port(port);
+    uint8_t changed = (isHigh ? ~p->out : p->out) & pins;
+    p->out = isHigh ? p->out | pins : p->out & ~pins;
+    if (outputCallback != NULL && (changed & p->dir) != 0)
+        outputCallback(port, changed & p->dir, isHigh);
+}
+
+/* inc/driverlib/gpio.h */
+
+void GPIO_setAsOutputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins) {
+    EMU_access();
+    EmuGpioPort *p = EMU_GPIO_port(selectedPort);
+    p->sel &= ~selectedPins;
+    p->dir |= selectedPins;
+}
+
+void GPIO_setAsInputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins) {
+    EMU_access();
+    EmuGpioPort *p = EMU_GPIO_port(selectedPort);
+    p->sel &= ~selectedPins;
+    p->dir &= ~selectedPins;
+    p->ren &= ~selectedPins;
+}
+
+void GPIO_setAsInputPinWithPullDownResistor(uint_fast8_t selectedPort,
+                                            uint_fast16_t selectedPins) {
+    EMU_access();
+    EmuGpioPort *p = EMU_GPIO_port(selectedPort);
+    p->sel &= ~selectedPins;
+    p->dir &= ~selectedPins;
+    p->ren |= selectedPins;
+    p->out &= ~selectedPins;
+}
+
+void GPIO_setAsPeripheralModuleFunctionOutputPin(uint_fast8_t selectedPort,
+                                                 uint_fast16_t selectedPins, uint_fast8_t mode) {
+    EMU_access();
+    EmuGpioPort *p = EMU_GPIO_port(selectedPort);
+    p->sel |= selectedPins;
+    p->dir |= selectedPins;
+}
+
+void GPIO_setAsPeripheralModuleFunctionInputPin(uint_fast8_t selectedPort,
+                                                uint_fast16_t selectedPins, uint_fast8_t mode) {
+    EMU_access();
+    EmuGpioPort *p = EMU_GPIO_port(selectedPort);
+    p->sel |= selectedPins;
+    p->dir &= ~selectedPins;
+}
+
+void GPIO_setOutputHighOnPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins) {
+    EMU_access();
+    EMU_GPIO_drive(selectedPort, selectedPins, true);
+}
+
+void GPIO_setOutputLowOnPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins) {
+    EMU_access();
+    EMU_GPIO_drive(selectedPort, selectedPins, false);
+}
+
+uint8_t GPIO_getInputPinValue(uint_fast8_t selectedPort, uint_fast16_t selectedPins) {
+    EMU_access();
+    const EmuGpioPort *p = EMU_GPIO_port(selectedPort);
+    uint8_t levels = (p->in & ~p->dir) | (p->out & p->dir);
+    return (levels & selectedPins) ? GPIO_INPUT_PIN_HIGH : GPIO_INPUT_PIN_LOW;
+}
+
+void GPIO_enableInterrupt(uint_fast8_t selectedPort, uint_fast16_t selectedPins) {
+    EMU_access();
+    EMU_GPIO_port(selectedPort)->ie |= selectedPins;
+}
+
+void GPIO_disableInterrupt(uint_fast8_t selectedPort, uint_fast16_t selectedPins) {
+    EMU_access();
+    EMU_GPIO_port(selectedPort)->ie &= ~selectedPins;
+}
+
+void GPIO_clearInterruptFlag(uint_fast8_t selectedPort, uint_fast16_t selectedPins) {
+    EMU_access();
+    EMU_GPIO_port(selectedPort)->ifg &= ~selectedPins;
+}
+
+void GPIO_interruptEdgeSelect(uint_fast8_t selectedPort, uint_fast16_t selectedPins,
+                              uint_fast8_t edgeSelect) {
+    EMU_access();
+    EmuGpioPort *p = EMU_GPIO_port(selectedPort);
+    p->iesSet |= selectedPins;
+    if (edgeSelect == GPIO_HIGH_TO_LOW_TRANSITION)
+        p->ies |= selectedPins;
+    else
+        p->ies &= ~selectedPins;
+}
+
+uint_fast16_t GPIO_getEnabledInterruptStatus(uint_fast8_t selectedPort) {
+    EMU_access();
+    const EmuGpioPort *p = EMU_GPIO_port(selectedPort);
+    return p->ifg & p->ie;
+}
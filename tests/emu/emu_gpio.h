@@ -0,0 +1,204 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_gpio.h
+ *
+ * DESCRIPTION:
+ *      This header provides the emulation of the digital I/O ports, with the edge interrupts of the
+ *      ports from P1 to P6, and the functions used by the test bench to drive the inputs and watch
+ *      the outputs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    EMU_GPIO_reset()
+ *      bool    EMU_GPIO_isRequesting(uint8_t port)
+ *      void    EMU_GPIO_setInput(uint8_t port, uint8_t pins, bool isHigh)
+ *      void    EMU_GPIO_scheduleInput(uint64_t delay, uint8_t port, uint8_t pins, bool isHigh)
+ *      bool    EMU_GPIO_getOutput(uint8_t port, uint8_t pin)
+ *      void    EMU_GPIO_registerOutputCallback(EmuGpioCallback callback)
+ *
+ * NOTES:
+ *      The edge select register is undefined after a reset and the HALs never write it: until
+ *      GPIO_interruptEdgeSelect() is called on a pin, the emulator raises its flag on both edges,
+ *      which is what the interrupt service routines expect as they read the pin to tell the edges
+ *      apart.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef EMU_GPIO_H
+#define EMU_GPIO_H
+
+#define EMU_GPIO_PORTS 11 /* Ports from P1 to P10 and PJ */
+
+/*T************************************************************************************************
+ * NAME: EmuGpioCallback
+ *
+ * DESCRIPTION:
+ *      Represent the function called when the firmware changes the level of output pins.
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Vars:   uint8_t     port        GPIO_PORT_* of the pins
+ *              uint8_t     pins        Pins that changed
+ *              bool        isHigh      New level
+ */
+typedef void (*EmuGpioCallback)(uint8_t port, uint8_t pins, bool isHigh);
+
+/*F************************************************************************************************
+ * NAME: void EMU_GPIO_reset()
+ *
+ * DESCRIPTION:
+ *      Configures all the pins as inputs at the low level, without interrupts and without the
+ *      output callback.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void EMU_GPIO_reset();
+
+/*F************************************************************************************************
+ * NAME: bool EMU_GPIO_isRequesting(uint8_t port)
+ *
+ * DESCRIPTION:
+ *      Tells whether a port requests its interrupt, i.e. a pin has both the flag and the interrupt
+ *      enabled.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     port    GPIO_PORT_*
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the interrupt is requested
+ *
+ *  NOTE:
+ */
+bool EMU_GPIO_isRequesting(uint8_t port);
+
+/*F************************************************************************************************
+ * NAME: void EMU_GPIO_setInput(uint8_t port, uint8_t pins, bool isHigh)
+ *
+ * DESCRIPTION:
+ *      Drives the level of input pins from outside the microcontroller, setting the interrupt
+ *      flags of the pins whose level changes.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     port    GPIO_PORT_*
+ *          uint8_t     pins    GPIO_PIN* mask
+ *          bool        isHigh  New level
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Called by the test bench outside of the events, the requests are served at the next
+ *      driverlib call or EMU_run().
+ */
+void EMU_GPIO_setInput(uint8_t port, uint8_t pins, bool isHigh);
+
+/*F************************************************************************************************
+ * NAME: void EMU_GPIO_scheduleInput(uint64_t delay, uint8_t port, uint8_t pins, bool isHigh)
+ *
+ * DESCRIPTION:
+ *      Drives the level of input pins after the given virtual time.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t    delay   Virtual time from now (ns)
+ *          uint8_t     port    GPIO_PORT_*
+ *          uint8_t     pins    GPIO_PIN* mask
+ *          bool        isHigh  New level
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void EMU_GPIO_scheduleInput(uint64_t delay, uint8_t port, uint8_t pins, bool isHigh);
+
+/*F************************************************************************************************
+ * NAME: bool EMU_GPIO_getOutput(uint8_t port, uint8_t pin)
+ *
+ * DESCRIPTION:
+ *      Returns the level driven by the firmware on a pin.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     port    GPIO_PORT_*
+ *          uint8_t     pin     GPIO_PIN*
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the pin is an output at the high level
+ *
+ *  NOTE:
+ */
+bool EMU_GPIO_getOutput(uint8_t port, uint8_t pin);
+
+/*F************************************************************************************************
+ * NAME: void EMU_GPIO_registerOutputCallback(EmuGpioCallback callback)
+ *
+ * DESCRIPTION:
+ *      Registers the function of the test bench called when the firmware changes the level of
+ *      output pins, e.g. to model the sensor connected to them.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          EmuGpioCallback     callback    Function to call, NULL to remove it
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The callback runs inside the driverlib call, it can schedule events but it must not call
+ *      the HALs.
+ */
+void EMU_GPIO_registerOutputCallback(EmuGpioCallback callback);
+
+#endif // EMU_GPIO_H
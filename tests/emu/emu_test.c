@@ -0,0 +1,385 @@
+/*C************************************************************************************************
+ * FILENAME:        emu_test.c
+ *
+ * DESCRIPTION:
+ *      This source file contains the test program of the real HALs in src/hal, executed on the
+ *      host on top of the emulated peripherals: every HAL is driven through its pins and lines as
+ *      the devices of the car would do, then the execution of the interrupt service routines is
+ *      reported.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main()
+ *
+ * NOTES:
+ *      Built by make emu as build/emu_test, separately from build/test that links the mocked HALs.
+ *      The host times of the report include the emulated driverlib calls, which are slower than
+ *      the register accesses of the car: compare them between two builds, not with the car.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 19 Oct 2026  Maintainers     Bluetooth message sent while the transmission is being disabled
+ */
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "emu.h"
+#include "emu_adc14.h"
+#include "emu_gpio.h"
+#include "emu_timer_a.h"
+#include "emu_uart.h"
+#include "../../inc/battery_hal.h"
+#include "../../inc/bluetooth_hal.h"
+#include "../../inc/infrared_hal.h"
+#include "../../inc/motor_hal.h"
+#include "../../inc/servo_hal.h"
+#include "../../inc/timer_hal.h"
+#include "../../inc/ultrasonic_hal.h"
+
+#define EMU_TEST_MS 1000000ull /* Virtual time of a millisecond (ns) */
+#define EMU_TEST_US 1000ull    /* Virtual time of a microsecond (ns) */
+
+static uint32_t callbacks;   /* Calls of the last registered callback         */
+static uint64_t callbackTime; /* Virtual time of the last call (ns)           */
+static uint16_t distance;    /* Last ultrasonic measurement                   */
+static IRCommand command;    /* Last infrared command                         */
+static bool isCommandValid;  /* Validity of the last infrared command         */
+static char message[64];     /* Last Bluetooth message                        */
+static uint64_t echoWidth;   /* Width of the echo of the modelled sensor (ns) */
+
+static void onCallback() {
+    callbacks++;
+    callbackTime = EMU_now();
+}
+
+/* The shared timer keeps its flag until released: the users release it from their callback */
+static void onSharedTimer() {
+    TIMER_HAL_releaseSharedTimer();
+    onCallback();
+}
+
+static void onDistance(uint16_t value) {
+    distance = value;
+    onCallback();
+}
+
+static void onCommand(IRCommand value, bool isValid) {
+    command = value;
+    isCommandValid = isValid;
+    onCallback();
+}
+
+static void onMessage(const char *value) {
+    snprintf(message, sizeof(message), "%s", value);
+    onCallback();
+}
+
+/* HC-SR04: the echo starts 450µs after the end of the trigger and lasts 58µs per cm */
+static void onTrigger(uint8_t port, uint8_t pins, bool isHigh) {
+    if (port != GPIO_PORT_P1 || !(pins & GPIO_PIN6) || isHigh)
+        return;
+    EMU_GPIO_scheduleInput(450 * EMU_TEST_US, GPIO_PORT_P1, GPIO_PIN7, true);
+    EMU_GPIO_scheduleInput(450 * EMU_TEST_US + echoWidth, GPIO_PORT_P1, GPIO_PIN7, false);
+}
+
+/* NEC frame, the HAL times the falling edges of the receiver output, i.e. the ends of the bursts */
+static uint64_t scheduleBurst(uint64_t time, uint64_t length) {
+    EMU_GPIO_scheduleInput(time - EMU_now(), GPIO_PORT_P2, GPIO_PIN7, true);
+    EMU_GPIO_scheduleInput(time + length - EMU_now(), GPIO_PORT_P2, GPIO_PIN7, false);
+    return time + length;
+}
+
+static void scheduleNecFrame(uint8_t address, uint8_t code) {
+    uint32_t frame = address | (uint8_t)~address << 8 | code << 16 | (uint32_t)(uint8_t)~code << 24;
+    uint64_t time = scheduleBurst(EMU_now() + EMU_TEST_MS, 9000 * EMU_TEST_US) + 4500 * EMU_TEST_US;
+    for (uint8_t bit = 0; bit < 32; bit++) {
+        time = scheduleBurst(time, 562 * EMU_TEST_US);
+        time += (frame >> bit & 1 ? 1688 : 563) * EMU_TEST_US;
+        EMU_run(time - EMU_now() - 100 * EMU_TEST_US); // the events of a frame do not fit at once
+    }
+    scheduleBurst(time, 562 * EMU_TEST_US);
+}
+
+static void testTimer() {
+    EMU_init();
+    TIMER_HAL_init();
+
+    // periodic timer, the counter reaches 0 after count ticks then reloads, one tick per period
+    callbacks = 0;
+    TIMER_HAL_registerPeriodicTimerCallback(onCallback);
+    TIMER_HAL_setupPeriodicTimer(9374);
+    uint64_t start = EMU_now();
+    EMU_run(EMU_SECOND);
+    assert(callbacks == 10 && "The periodic timer has not expired every 100ms");
+    int64_t drift = callbackTime - start - EMU_ticksToTime(9374 + 9 * 9375, EMU_MCLK / 256);
+    assert(llabs(drift) < 10 * EMU_TEST_US && "The periodic timer has drifted");
+
+    // the HAL adds count ticks per period while the counter lasts count + 1 ticks
+    uint32_t ticks = TIMER_HAL_getTicks();
+    assert(abs((int32_t)(ticks - EMU_timeToTicks(EMU_now() - start, EMU_MCLK / 256))) <= 11 &&
+           "The ticks do not follow the periodic timer");
+
+    // shared timer, one shot
+    TIMER_HAL_registerPeriodicTimerCallback(NULL);
+    callbacks = 0;
+    start = EMU_now();
+    TIMER_HAL_acquireSharedTimer(938, onSharedTimer);
+    EMU_run(100 * EMU_TEST_MS);
+    assert(callbacks == 1 && "The shared timer has not expired once");
+    assert(fabs((callbackTime - start) / 1e6 - 10.0) < 0.05 && "The shared timer took not 10ms");
+
+    // a request raised with the interrupts disabled is served when they are enabled again
+    EmuIsrStats before = EMU_getIsrStats(INT_T32_INT2);
+    assert(before.maxLatency == 0 && "The periodic timer interrupt has been delayed");
+    Interrupt_disableMaster();
+    EMU_run(150 * EMU_TEST_MS);
+    Interrupt_enableMaster();
+    EmuIsrStats after = EMU_getIsrStats(INT_T32_INT2);
+    assert(after.count == before.count + 1 && "The masked interrupt has not been served once");
+    assert(after.maxLatency > 40 * EMU_TEST_MS && "The latency of the masked interrupt is lost");
+}
+
+static void testUltrasonic() {
+    EMU_init();
+    US_HAL_init();
+    US_HAL_registerMeasurementCallback(onDistance);
+    EMU_GPIO_registerOutputCallback(onTrigger);
+
+    // 100cm, the HAL subtracts its fixed offset
+    callbacks = 0;
+    echoWidth = 5800 * EMU_TEST_US;
+    US_HAL_triggerMeasurement();
+    assert(!EMU_GPIO_getOutput(GPIO_PORT_P1, GPIO_PIN6) && "The trigger has not been released");
+    EMU_run(50 * EMU_TEST_MS);
+    assert(callbacks == 1 && "The echo has not been measured");
+    double expected = echoWidth / 1e3 * 0.375 / 21.866 - 12;
+    assert(fabs(distance - expected) <= 1 && "The echo has not been converted to the distance");
+
+    // no object
+    echoWidth = 38 * EMU_TEST_MS;
+    US_HAL_triggerMeasurement();
+    EMU_run(50 * EMU_TEST_MS);
+    assert(callbacks == 2 && distance == US_RESULT_NO_OBJECT && "A missing echo is a distance");
+}
+
+static void testInfrared() {
+    EMU_init();
+    IR_HAL_init();
+    IR_HAL_registerMessageCallback(onCommand);
+
+    callbacks = 0;
+    scheduleNecFrame(0x00, IR_COMMAND_ASTERISK);
+    EMU_run(10 * EMU_TEST_MS);
+    assert(callbacks == 1 && "The frame has not been decoded");
+    assert(command == IR_COMMAND_ASTERISK && isCommandValid && "The frame has been misread");
+}
+
+static void testBluetooth() {
+    EMU_init();
+    BT_HAL_init();
+    BT_HAL_registerMessageCallback(onMessage);
+    uint64_t byteTime = EMU_UART_getByteTime(EUSCI_A2_BASE);
+    assert(fabs(byteTime - 10 * 1e9 / 9600) < 1e9 / 9600 * 0.01 && "The baud rate is not 9600");
+
+    // reception, the leading terminators are skipped
+    callbacks = 0;
+    uint64_t start = EMU_now();
+    EMU_UART_send(EUSCI_A2_BASE, "\nAUT\r\n", 6);
+    EMU_run(10 * byteTime);
+    assert(callbacks == 1 && strcmp(message, "AUT") == 0 && "The command has not been received");
+    assert(callbackTime - start - 5 * byteTime < 10 * EMU_TEST_US &&
+           "The command has not been delivered at the end of its terminator");
+
+    // transmission, back to back bytes
+    start = EMU_now();
+    BT_HAL_sendMessage("SPEED %d", 42);
+    EMU_run(20 * byteTime);
+    char line[32] = {0};
+    uint16_t n = EMU_UART_read(EUSCI_A2_BASE, line, sizeof(line) - 1);
+    assert(n == 10 && strcmp(line, "SPEED 42\r\n") == 0 && "The message has not been transmitted");
+    EmuUartStats stats = EMU_UART_getStats(EUSCI_A2_BASE);
+    assert(stats.overruns == 0 && stats.txBytes == 10 && "The UART lost bytes");
+    assert(EMU_now() - start >= 10 * byteTime && "The message has been sent faster than the line");
+}
+
+static void onLateMessage(uint32_t arg) { BT_HAL_sendMessage("LATE %u", arg); }
+
+static void testBluetoothWakeup() {
+    EMU_init();
+    BT_HAL_init();
+    uint64_t byteTime = EMU_UART_getByteTime(EUSCI_A2_BASE);
+
+    // the last routine of a transmission finds the ring empty and disables the interrupt
+    uint64_t start = EMU_now();
+    uint64_t idle = start;
+    uint32_t count = 0;
+    BT_HAL_sendMessage("A");
+    while (EMU_now() - start < 10 * byteTime) {
+        EMU_run(EMU_TEST_US / 10);
+        uint32_t routines = EMU_getIsrStats(INT_EUSCIA2).count;
+        if (routines != count) {
+            count = routines;
+            idle = EMU_now() - start;
+        }
+    }
+
+    // a message sent by a preempting routine around then is transmitted without further sends
+    for (uint64_t delay = idle - 3 * EMU_TEST_US; delay <= idle + EMU_TEST_US; delay += 50) {
+        EMU_init();
+        BT_HAL_init();
+        BT_HAL_sendMessage("A");
+        EMU_schedule(delay, onLateMessage, 1);
+        EMU_run(20 * byteTime);
+        char line[32] = {0};
+        EMU_UART_read(EUSCI_A2_BASE, line, sizeof(line) - 1);
+        assert(strcmp(line, "A\r\nLATE 1\r\n") == 0 && "The late message has not been transmitted");
+    }
+}
+
+static void testBattery() {
+    EMU_init();
+    BATTERY_HAL_init();
+    EMU_ADC14_setInput(14, 7400 / 2.6);
+
+    // the HAL does not wait for the conversion: it reads the result of the previous one
+    uint16_t first = BATTERY_HAL_getVoltage();
+    EMU_run(EMU_TEST_MS);
+    uint16_t second = BATTERY_HAL_getVoltage();
+    assert(first == 0 && "The first reading is not the reset value of the memory");
+    assert(abs(second - 7400) <= 5 && "The voltage has not been converted");
+    assert(EMU_ADC14_getConversions() == 1 && "The conversions have not been triggered");
+}
+
+static void testMotor() {
+    EMU_init();
+    MOTOR_HAL_init();
+    Motor motor;
+    MOTOR_HAL_motorInit(&motor, MOTOR_INIT_LEFT);
+    MOTOR_HAL_setSpeed(&motor, 50);
+    MOTOR_HAL_setDirection(&motor, MOTOR_DIR_FORWARD);
+    assert(EMU_TIMER_A_getCompareValue(TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_0) == 5000 &&
+           EMU_TIMER_A_getFrequency(TIMER_A0_BASE) == 500000 && "The PWM is not at 100Hz");
+    assert(EMU_TIMER_A_getCompareValue(TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1) == 2500 &&
+           "The duty cycle is not 50%");
+    assert(EMU_GPIO_getOutput(GPIO_PORT_P4, GPIO_PIN4) &&
+           !EMU_GPIO_getOutput(GPIO_PORT_P4, GPIO_PIN3) && "The motor is not driven forward");
+
+    // The speed curve is interpolated between its points
+    static const MotorCurve curve = {{150, 250, 350, 450, 550, 600, 650, 700, 800, 900, 1000}};
+    MOTOR_HAL_setCurve(&motor, &curve);
+    assert(EMU_TIMER_A_getCompareValue(TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1) == 3000 &&
+           "The speed curve is not applied");
+    MOTOR_HAL_setSpeed(&motor, 55);
+    assert(EMU_TIMER_A_getCompareValue(TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1) == 3125 &&
+           "The speed curve is not interpolated");
+    MOTOR_HAL_stop(&motor);
+    assert(!EMU_GPIO_getOutput(GPIO_PORT_P4, GPIO_PIN4) &&
+           !EMU_GPIO_getOutput(GPIO_PORT_P4, GPIO_PIN3) && "The motor has not been stopped");
+}
+
+static void testServo() {
+    EMU_init();
+    TIMER_HAL_init();
+    Servo servo;
+    SERVO_HAL_init(&servo); // busy waits for the servo to center
+    assert(EMU_now() > 600 * EMU_TEST_MS && "The initialisation has not waited for the servo");
+
+    callbacks = 0;
+    SERVO_HAL_registerPositionReachedCallback(onCallback);
+    uint64_t start = EMU_now();
+    SERVO_HAL_setPosition(&servo, SERVO_MAX_POSITION);
+    EMU_run(EMU_SECOND);
+    assert(callbacks == 1 && "The servo has not reached the position");
+    assert(fabs((callbackTime - start) / 1e6 - 330) < 1 && "The servo travel is not 330ms");
+    assert(EMU_TIMER_A_getCompareValue(TIMER_A2_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1) == 2300 &&
+           "The PWM is not at +90deg");
+
+    start = EMU_now();
+    SERVO_HAL_resume(&servo, SERVO_MIN_POSITION); // warm restart, no wait
+    assert(EMU_now() - start < EMU_TEST_MS && "The resume has waited for the servo");
+    assert(servo.state.position == SERVO_MIN_POSITION && "The position is not resumed");
+    assert(EMU_TIMER_A_getCompareValue(TIMER_A2_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1) == 680 &&
+           "The PWM is not at -90deg");
+}
+
+static void printIsr(const char *name, uint32_t interruptNumber) {
+    EmuIsrStats stats = EMU_getIsrStats(interruptNumber);
+    if (stats.count == 0)
+        return;
+    printf("    %-10s %6u %9.0fns %9lluns %8.1fus %8.1fus %9.1fus\n", name, stats.count,
+           (double)stats.hostTime / stats.count, (unsigned long long)stats.maxHostTime,
+           stats.cpuTime / 1e3 / stats.count, stats.maxCpuTime / 1e3, stats.maxLatency / 1e3);
+}
+
+/*F************************************************************************************************
+ * NAME: void testIsrs()
+ *
+ * DESCRIPTION:
+ *      Runs all the HALs together for one second of car activity and prints the executions of
+ *      every interrupt service routine: host time, virtual time and worst latency.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void testIsrs() {
+    EMU_init();
+    TIMER_HAL_init();
+    US_HAL_init();
+    IR_HAL_init();
+    BT_HAL_init();
+    US_HAL_registerMeasurementCallback(onDistance);
+    IR_HAL_registerMessageCallback(onCommand);
+    BT_HAL_registerMessageCallback(onMessage);
+    EMU_GPIO_registerOutputCallback(onTrigger);
+    echoWidth = 2900 * EMU_TEST_US;
+
+    // a measurement and a telemetry line every 100ms, a command in the middle
+    TIMER_HAL_registerPeriodicTimerCallback(US_HAL_triggerMeasurement);
+    TIMER_HAL_setupPeriodicTimer(9374);
+    EMU_UART_send(EUSCI_A2_BASE, "FWD\r\n", 5);
+    scheduleNecFrame(0x00, IR_COMMAND_ASTERISK);
+    for (uint8_t i = 0; i < 10; i++) {
+        BT_HAL_sendMessage("DST %u", distance);
+        EMU_run(100 * EMU_TEST_MS);
+    }
+    assert(strcmp(message, "FWD") == 0 && command == IR_COMMAND_ASTERISK && "Inputs were lost");
+
+    printf("    %-10s %6s %11s %11s %10s %10s %11s\n", "isr", "count", "host mean", "host max",
+           "cpu mean", "cpu max", "max latency");
+    printIsr("PORT1", INT_PORT1);
+    printIsr("PORT2", INT_PORT2);
+    printIsr("EUSCIA2", INT_EUSCIA2);
+    printIsr("T32_INT1", INT_T32_INT1);
+    printIsr("T32_INT2", INT_T32_INT2);
+}
+
+int main() {
+    printf("Starting emulated HAL test ...\n");
+    testTimer();
+    testUltrasonic();
+    testInfrared();
+    testBluetooth();
+    testBluetoothWakeup();
+    testBattery();
+    testMotor();
+    testServo();
+    testIsrs();
+    printf("Emulated HAL test PASSED\n");
+}
@@ -0,0 +1,208 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_timer32.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the emulation of the Timer32 modules and the functions of
+ *      inc/driverlib/timer32.h used by the HALs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    EMU_TIMER32_reset()
+ *      bool    EMU_TIMER32_isRequesting(uint8_t index)
+ *
+ * NOTES:
+ *      As on the device, the counter stays at 0 for one tick before the reload, so a period lasts
+ *      the loaded count plus one tick. The one shot mode stops the counter at 0.
+ *      The ends of the count are computed from the virtual time of the start, so they do not drift
+ *      when a tick is not an integer number of nanoseconds.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include "emu.h"
+#include "emu_timer32.h"
+#include "../../inc/driverlib/driverlib.h"
+
+/*T************************************************************************************************
+ * NAME: EmuTimer32
+ *
+ * DESCRIPTION:
+ *      Represent the state of a module.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    hz          Counting frequency
+ *              uint32_t    max         Largest value of the counter
+ *              bool        isPeriodic  Reload from load instead of max
+ *              bool        isOneShot   Stop at the end of the count
+ *              bool        isRunning   The module counts
+ *              bool        isIntEnabled Interrupt enabled
+ *              bool        isFlagSet   Count ended since the last clear
+ *              uint32_t    load        Reload value
+ *              uint32_t    value       Counter at the start
+ *              uint64_t    start       Virtual time of the start (ns)
+ *              uint32_t    ends        Ends of the count since the start
+ *              uint32_t    event       Next end of the count
+ */
+typedef struct {
+    uint32_t hz;
+    uint32_t max;
+    bool isPeriodic;
+    bool isOneShot;
+    bool isRunning;
+    bool isIntEnabled;
+    bool isFlagSet;
+    uint32_t load;
+    uint32_t value;
+    uint64_t start;
+    uint32_t ends;
+    uint32_t event;
+} EmuTimer32;
+
+static EmuTimer32 timers[EMU_TIMER32_MODULES]; /* State of the modules                       */
+
+static uint8_t EMU_TIMER32_index(uint32_t timer) { return timer == TIMER32_1_BASE ? 1 : 0; }
+
+static uint64_t EMU_TIMER32_reload(const EmuTimer32 *t) {
+    return (t->isPeriodic ? t->load : t->max) + 1ull;
+}
+
+static uint32_t EMU_TIMER32_value(const EmuTimer32 *t) {
+    if (!t->isRunning)
+        return t->value;
+    uint64_t ticks = EMU_timeToTicks(EMU_now() - t->start, t->hz);
+    if (ticks <= t->value)
+        return t->value - ticks;
+    if (t->isOneShot)
+        return 0;
+    uint64_t reload = EMU_TIMER32_reload(t);
+    return reload - 1 - (ticks - t->value - 1) % reload;
+}
+
+/*F************************************************************************************************
+ * NAME: void EMU_TIMER32_schedule(EmuTimer32 *t, uint8_t index)
+ *
+ * DESCRIPTION:
+ *      Schedules the next end of the count of a running module.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          EmuTimer32* t       Module
+ *          uint8_t     index   Index of the module, argument of the event
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          EmuTimer32* t       event updated
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void EMU_TIMER32_onEnd(uint32_t index);
+
+static void EMU_TIMER32_schedule(EmuTimer32 *t, uint8_t index) {
+    EMU_cancel(t->event);
+    t->event = EMU_NO_EVENT;
+    if (!t->isRunning || (t->isOneShot && t->ends > 0))
+        return;
+    uint64_t ticks = t->value + t->ends * EMU_TIMER32_reload(t);
+    uint64_t time = t->start + EMU_ticksToTime(ticks, t->hz);
+    t->event = EMU_schedule(time - EMU_now(), EMU_TIMER32_onEnd, index);
+}
+
+static void EMU_TIMER32_onEnd(uint32_t index) {
+    EmuTimer32 *t = &timers[index];
+    t->event = EMU_NO_EVENT;
+    t->isFlagSet = true;
+    t->ends++;
+    EMU_TIMER32_schedule(t, index);
+}
+
+static void EMU_TIMER32_restart(EmuTimer32 *t, uint8_t index) {
+    t->start = EMU_now();
+    t->ends = 0;
+    EMU_TIMER32_schedule(t, index);
+}
+
+void EMU_TIMER32_reset() {
+    for (uint8_t i = 0; i < EMU_TIMER32_MODULES; i++) {
+        EMU_cancel(timers[i].event);
+        timers[i] = (EmuTimer32){0};
+        timers[i].hz = EMU_MCLK;
+        timers[i].max = 0xFFFFFFFF;
+        timers[i].load = 0xFFFFFFFF;
+        timers[i].value = 0xFFFFFFFF;
+        timers[i].event = EMU_NO_EVENT;
+    }
+}
+
+bool EMU_TIMER32_isRequesting(uint8_t index) {
+    return index < EMU_TIMER32_MODULES && timers[index].isIntEnabled && timers[index].isFlagSet;
+}
+
+/* inc/driverlib/timer32.h */
+
+void Timer32_initModule(uint32_t timer, uint32_t preScaler, uint32_t resolution, uint32_t mode) {
+    EMU_access();
+    uint8_t index = EMU_TIMER32_index(timer);
+    EmuTimer32 *t = &timers[index];
+    t->value = EMU_TIMER32_value(t);
+    t->isRunning = false;
+    EMU_TIMER32_schedule(t, index);
+    t->hz = EMU_MCLK;
+    if (preScaler == TIMER32_PRESCALER_16)
+        t->hz = EMU_MCLK / 16;
+    else if (preScaler == TIMER32_PRESCALER_256)
+        t->hz = EMU_MCLK / 256;
+    t->max = resolution == TIMER32_32BIT ? 0xFFFFFFFF : 0xFFFF;
+    t->isPeriodic = mode == TIMER32_PERIODIC_MODE;
+    t->value &= t->max;
+}
+
+void Timer32_setCount(uint32_t timer, uint32_t count) {
+    EMU_access();
+    uint8_t index = EMU_TIMER32_index(timer);
+    EmuTimer32 *t = &timers[index];
+    t->load = count & t->max;
+    t->value = t->load;
+    EMU_TIMER32_restart(t, index);
+}
+
+void Timer32_startTimer(uint32_t timer, bool oneShot) {
+    EMU_access();
+    uint8_t index = EMU_TIMER32_index(timer);
+    EmuTimer32 *t = &timers[index];
+    t->value = EMU_TIMER32_value(t);
+    t->isOneShot = oneShot;
+    t->isRunning = true;
+    EMU_TIMER32_restart(t, index);
+}
+
+void Timer32_haltTimer(uint32_t timer) {
+    EMU_access();
+    uint8_t index = EMU_TIMER32_index(timer);
+    EmuTimer32 *t = &timers[index];
+    t->value = EMU_TIMER32_value(t);
+    t->isRunning = false;
+    EMU_TIMER32_schedule(t, index);
+}
+
+uint32_t Timer32_getValue(uint32_t timer) {
+    EMU_access();
+    return EMU_TIMER32_value(&timers[EMU_TIMER32_index(timer)]);
+}
+
+void Timer32_enableInterrupt(uint32_t timer) {
+    EMU_access();
+    timers[EMU_TIMER32_index(timer)].isIntEnabled = true;
+}
+
+void Timer32_clearInterruptFlag(uint32_t timer) {
+    EMU_access();
+    timers[EMU_TIMER32_index(timer)].isFlagSet = false;
+}
@@ -0,0 +1,78 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_timer32.h
+ *
+ * DESCRIPTION:
+ *      This header provides the emulation of the two Timer32 modules: the down counter in
+ *      periodic, free running and one shot mode, and the interrupt at the end of the count.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    EMU_TIMER32_reset()
+ *      bool    EMU_TIMER32_isRequesting(uint8_t index)
+ *
+ * NOTES:
+ *      TIMER32_0_BASE requests INT_T32_INT1 and TIMER32_1_BASE requests INT_T32_INT2.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef EMU_TIMER32_H
+#define EMU_TIMER32_H
+
+#define EMU_TIMER32_MODULES 2 /* Modules TIMER32_0 and TIMER32_1 */
+
+/*F************************************************************************************************
+ * NAME: void EMU_TIMER32_reset()
+ *
+ * DESCRIPTION:
+ *      Halts both modules and clears their interrupts.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void EMU_TIMER32_reset();
+
+/*F************************************************************************************************
+ * NAME: bool EMU_TIMER32_isRequesting(uint8_t index)
+ *
+ * DESCRIPTION:
+ *      Tells whether a module requests its interrupt, i.e. the count ended with the interrupt
+ *      enabled and the flag has not been cleared.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     index   0 for TIMER32_0, 1 for TIMER32_1
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the interrupt is requested
+ *
+ *  NOTE:
+ */
+bool EMU_TIMER32_isRequesting(uint8_t index);
+
+#endif // EMU_TIMER32_H
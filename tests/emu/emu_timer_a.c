@@ -0,0 +1,205 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_timer_a.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the emulation of the Timer_A modules and the functions of
+ *      inc/driverlib/timer_a.h used by the HALs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        EMU_TIMER_A_reset()
+ *      uint16_t    EMU_TIMER_A_getCompareValue(uint32_t timer, uint_fast16_t compareRegister)
+ *      uint32_t    EMU_TIMER_A_getFrequency(uint32_t timer)
+ *
+ * NOTES:
+ *      The counter is not stored while the module runs: it is computed from the virtual time of
+ *      the last start, so reading it costs nothing and it is exact at every call.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include "emu.h"
+#include "emu_timer_a.h"
+#include "../../inc/driverlib/driverlib.h"
+
+/*T************************************************************************************************
+ * NAME: EmuTimerA
+ *
+ * DESCRIPTION:
+ *      Represent the state of a module.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint_fast16_t   mode    TIMER_A_*_MODE
+ *              uint32_t        hz      Counting frequency
+ *              uint16_t        counter Value of the counter at the start
+ *              uint64_t        start   Virtual time of the start (ns)
+ *              uint16_t[]      ccr     Capture/compare registers
+ */
+typedef struct {
+    uint_fast16_t mode;
+    uint32_t hz;
+    uint16_t counter;
+    uint64_t start;
+    uint16_t ccr[EMU_TIMER_A_REGISTERS];
+} EmuTimerA;
+
+static EmuTimerA timers[EMU_TIMER_A_MODULES]; /* State of the modules                        */
+
+static EmuTimerA *EMU_TIMER_A_module(uint32_t timer) {
+    static EmuTimerA none;
+    switch (timer) {
+    case TIMER_A0_BASE:
+        return &timers[0];
+    case TIMER_A1_BASE:
+        return &timers[1];
+    case TIMER_A2_BASE:
+        return &timers[2];
+    case TIMER_A3_BASE:
+        return &timers[3];
+    default:
+        return &none;
+    }
+}
+
+static uint8_t EMU_TIMER_A_index(uint_fast16_t compareRegister) {
+    uint8_t index = (compareRegister - TIMER_A_CAPTURECOMPARE_REGISTER_0) / 2;
+    return index < EMU_TIMER_A_REGISTERS ? index : 0;
+}
+
+/*F************************************************************************************************
+ * NAME: uint16_t EMU_TIMER_A_counter(const EmuTimerA *t)
+ *
+ * DESCRIPTION:
+ *      Computes the value of the counter at the current virtual time:
+ *      - up mode           from 0 to CCR0, then back to 0
+ *      - continuous mode   from 0 to 0xFFFF, then back to 0
+ *      - up/down mode      from 0 to CCR0, then down to 0
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const EmuTimerA*    t       Module
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Counter
+ *
+ *  NOTE:
+ *      A counter above CCR0 when the up mode starts first counts up to 0xFFFF, as on the device.
+ */
+static uint16_t EMU_TIMER_A_counter(const EmuTimerA *t) {
+    if (t->mode == TIMER_A_STOP_MODE || t->hz == 0)
+        return t->counter;
+    uint64_t ticks = EMU_timeToTicks(EMU_now() - t->start, t->hz);
+    uint64_t top = t->ccr[0];
+    switch (t->mode) {
+    case TIMER_A_UP_MODE:
+        if (t->counter > top) {
+            uint64_t toWrap = 0x10000 - t->counter;
+            if (ticks < toWrap)
+                return t->counter + ticks;
+            ticks -= toWrap;
+            return ticks % (top + 1);
+        }
+        return (t->counter + ticks) % (top + 1);
+    case TIMER_A_UPDOWN_MODE: {
+        if (top == 0)
+            return 0;
+        uint64_t phase = (t->counter + ticks) % (2 * top);
+        return phase <= top ? phase : 2 * top - phase;
+    }
+    default:
+        return (t->counter + ticks) & 0xFFFF;
+    }
+}
+
+static void EMU_TIMER_A_configure(EmuTimerA *t, uint_fast16_t clockSource,
+                                  uint_fast16_t clockSourceDivider, uint_fast16_t timerClear) {
+    t->counter = EMU_TIMER_A_counter(t);
+    t->start = EMU_now();
+    uint32_t hz = clockSource == TIMER_A_CLOCKSOURCE_ACLK ? EMU_ACLK : EMU_SMCLK;
+    t->hz = clockSourceDivider > 0 ? hz / clockSourceDivider : hz;
+    if (timerClear == TIMER_A_DO_CLEAR)
+        t->counter = 0;
+}
+
+void EMU_TIMER_A_reset() {
+    for (uint8_t i = 0; i < EMU_TIMER_A_MODULES; i++)
+        timers[i] = (EmuTimerA){0};
+}
+
+uint16_t EMU_TIMER_A_getCompareValue(uint32_t timer, uint_fast16_t compareRegister) {
+    return EMU_TIMER_A_module(timer)->ccr[EMU_TIMER_A_index(compareRegister)];
+}
+
+uint32_t EMU_TIMER_A_getFrequency(uint32_t timer) { return EMU_TIMER_A_module(timer)->hz; }
+
+/* inc/driverlib/timer_a.h */
+
+void Timer_A_configureUpMode(uint32_t timer, const Timer_A_UpModeConfig *config) {
+    EMU_access();
+    EmuTimerA *t = EMU_TIMER_A_module(timer);
+    EMU_TIMER_A_configure(t, config->clockSource, config->clockSourceDivider, config->timerClear);
+    t->ccr[0] = config->timerPeriod;
+}
+
+void Timer_A_configureContinuousMode(uint32_t timer, const Timer_A_ContinuousModeConfig *config) {
+    EMU_access();
+    EMU_TIMER_A_configure(EMU_TIMER_A_module(timer), config->clockSource,
+                          config->clockSourceDivider, config->timerClear);
+}
+
+void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode) {
+    EMU_access();
+    EmuTimerA *t = EMU_TIMER_A_module(timer);
+    t->counter = EMU_TIMER_A_counter(t);
+    t->start = EMU_now();
+    t->mode = timerMode;
+}
+
+void Timer_A_stopTimer(uint32_t timer) {
+    EMU_access();
+    EmuTimerA *t = EMU_TIMER_A_module(timer);
+    t->counter = EMU_TIMER_A_counter(t);
+    t->mode = TIMER_A_STOP_MODE;
+}
+
+void Timer_A_clearTimer(uint32_t timer) {
+    EMU_access();
+    EmuTimerA *t = EMU_TIMER_A_module(timer);
+    t->counter = 0;
+    t->start = EMU_now();
+}
+
+uint16_t Timer_A_getCounterValue(uint32_t timer) {
+    EMU_access();
+    return EMU_TIMER_A_counter(EMU_TIMER_A_module(timer));
+}
+
+void Timer_A_initCompare(uint32_t timer, const Timer_A_CompareModeConfig *config) {
+    EMU_access();
+    EmuTimerA *t = EMU_TIMER_A_module(timer);
+    t->ccr[EMU_TIMER_A_index(config->compareRegister)] = config->compareValue;
+}
+
+void Timer_A_setCompareValue(uint32_t timer, uint_fast16_t compareRegister,
+                             uint_fast16_t compareValue) {
+    EMU_access();
+    EmuTimerA *t = EMU_TIMER_A_module(timer);
+    // a new period changes the wrap of the counter, keep the value reached with the old one
+    if (compareRegister == TIMER_A_CAPTURECOMPARE_REGISTER_0) {
+        t->counter = EMU_TIMER_A_counter(t);
+        t->start = EMU_now();
+    }
+    t->ccr[EMU_TIMER_A_index(compareRegister)] = compareValue;
+}
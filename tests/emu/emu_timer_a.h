@@ -0,0 +1,105 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_timer_a.h
+ *
+ * DESCRIPTION:
+ *      This header provides the emulation of the four Timer_A modules: the counter in up,
+ *      continuous and up/down mode and the compare registers that set the PWM signals.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        EMU_TIMER_A_reset()
+ *      uint16_t    EMU_TIMER_A_getCompareValue(uint32_t timer, uint_fast16_t compareRegister)
+ *      uint32_t    EMU_TIMER_A_getFrequency(uint32_t timer)
+ *
+ * NOTES:
+ *      The HALs do not use the Timer_A interrupts nor the capture mode, they are not emulated.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdint.h>
+
+#ifndef EMU_TIMER_A_H
+#define EMU_TIMER_A_H
+
+#define EMU_TIMER_A_MODULES 4   /* Modules from TIMER_A0 to TIMER_A3              */
+#define EMU_TIMER_A_REGISTERS 7 /* Capture/compare registers of every module      */
+
+/*F************************************************************************************************
+ * NAME: void EMU_TIMER_A_reset()
+ *
+ * DESCRIPTION:
+ *      Stops and clears all the modules.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void EMU_TIMER_A_reset();
+
+/*F************************************************************************************************
+ * NAME: uint16_t EMU_TIMER_A_getCompareValue(uint32_t timer, uint_fast16_t compareRegister)
+ *
+ * DESCRIPTION:
+ *      Returns the value of a compare register, e.g. the period (register 0) or the duty cycle
+ *      (registers 1 to 6) of a PWM signal in up mode.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t        timer               TIMER_A*_BASE
+ *          uint_fast16_t   compareRegister     TIMER_A_CAPTURECOMPARE_REGISTER_*
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Value of the register
+ *
+ *  NOTE:
+ */
+uint16_t EMU_TIMER_A_getCompareValue(uint32_t timer, uint_fast16_t compareRegister);
+
+/*F************************************************************************************************
+ * NAME: uint32_t EMU_TIMER_A_getFrequency(uint32_t timer)
+ *
+ * DESCRIPTION:
+ *      Returns the counting frequency of a module, after the divider.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    timer   TIMER_A*_BASE
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Frequency (Hz), 0 if the module has not been configured
+ *
+ *  NOTE:
+ */
+uint32_t EMU_TIMER_A_getFrequency(uint32_t timer);
+
+#endif // EMU_TIMER_A_H
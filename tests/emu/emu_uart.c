@@ -0,0 +1,255 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_uart.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the emulation of the eUSCI_A modules in UART mode and the
+ *      functions of inc/driverlib/uart.h used by the HALs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void            EMU_UART_reset()
+ *      bool            EMU_UART_isRequesting(uint8_t index)
+ *      void            EMU_UART_send(uint32_t module, const char *data, uint16_t length)
+ *      uint16_t        EMU_UART_read(uint32_t module, char *data, uint16_t max)
+ *      uint64_t        EMU_UART_getByteTime(uint32_t module)
+ *      EmuUartStats    EMU_UART_getStats(uint32_t module)
+ *
+ * NOTES:
+ *      The baud rate is derived from the clock divider of the configuration, with oversampling
+ *      BRCLK / (16 * UCBRx + UCBRFx), so a wrong divider in a HAL shows up as a wrong byte time.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include "emu.h"
+#include "emu_uart.h"
+#include "../../inc/driverlib/driverlib.h"
+
+/*T************************************************************************************************
+ * NAME: EmuUartQueue
+ *
+ * DESCRIPTION:
+ *      Represent the bytes exchanged with the test bench in one direction.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   char[]      data        Circular buffer
+ *              uint16_t    head        Index of the oldest byte
+ *              uint16_t    count       Number of bytes
+ */
+typedef struct {
+    char data[EMU_UART_BUFFER_SIZE];
+    uint16_t head;
+    uint16_t count;
+} EmuUartQueue;
+
+/*T************************************************************************************************
+ * NAME: EmuUart
+ *
+ * DESCRIPTION:
+ *      Represent the state of a module.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   bool            isEnabled       The module is out of reset
+ *              uint64_t        byteTime        Time of a byte on the line (ns)
+ *              uint8_t         ie              Enabled interrupts
+ *              uint8_t         ifg             Interrupt flags
+ *              uint8_t         rxBuf           Last received byte
+ *              uint8_t         txBuf           Byte waiting for the shift register
+ *              bool            isTxBufFull     txBuf holds a byte
+ *              uint8_t         shift           Byte being transmitted
+ *              uint32_t        txEvent         End of the transmitted byte
+ *              uint32_t        rxEvent         End of the received byte
+ *              EmuUartQueue    input           Bytes sent by the test bench
+ *              EmuUartQueue    output          Bytes transmitted, for the test bench
+ *              EmuUartStats    stats           Traffic
+ */
+typedef struct {
+    bool isEnabled;
+    uint64_t byteTime;
+    uint8_t ie;
+    uint8_t ifg;
+    uint8_t rxBuf;
+    uint8_t txBuf;
+    bool isTxBufFull;
+    uint8_t shift;
+    uint32_t txEvent;
+    uint32_t rxEvent;
+    EmuUartQueue input;
+    EmuUartQueue output;
+    EmuUartStats stats;
+} EmuUart;
+
+static EmuUart uarts[EMU_UART_MODULES]; /* State of the modules                              */
+
+static uint8_t EMU_UART_index(uint32_t module) {
+    switch (module) {
+    case EUSCI_A1_BASE:
+        return 1;
+    case EUSCI_A2_BASE:
+        return 2;
+    case EUSCI_A3_BASE:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+static bool EMU_UART_push(EmuUartQueue *queue, char c) {
+    if (queue->count == EMU_UART_BUFFER_SIZE)
+        return false;
+    queue->data[(queue->head + queue->count) % EMU_UART_BUFFER_SIZE] = c;
+    queue->count++;
+    return true;
+}
+
+static char EMU_UART_pop(EmuUartQueue *queue) {
+    char c = queue->data[queue->head];
+    queue->head = (queue->head + 1) % EMU_UART_BUFFER_SIZE;
+    queue->count--;
+    return c;
+}
+
+static void EMU_UART_onTxEnd(uint32_t index) {
+    EmuUart *u = &uarts[index];
+    u->txEvent = EMU_NO_EVENT;
+    u->stats.txBytes++;
+    if (!EMU_UART_push(&u->output, u->shift))
+        u->stats.lostBytes++;
+    if (u->isTxBufFull) {
+        u->shift = u->txBuf;
+        u->isTxBufFull = false;
+        u->ifg |= EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+        u->txEvent = EMU_schedule(u->byteTime, EMU_UART_onTxEnd, index);
+    }
+}
+
+static void EMU_UART_onRxEnd(uint32_t index) {
+    EmuUart *u = &uarts[index];
+    u->rxEvent = EMU_NO_EVENT;
+    if (u->ifg & EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG)
+        u->stats.overruns++;
+    u->rxBuf = EMU_UART_pop(&u->input);
+    u->ifg |= EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG;
+    u->stats.rxBytes++;
+    if (u->input.count > 0)
+        u->rxEvent = EMU_schedule(u->byteTime, EMU_UART_onRxEnd, index);
+}
+
+void EMU_UART_reset() {
+    for (uint8_t i = 0; i < EMU_UART_MODULES; i++) {
+        EMU_cancel(uarts[i].txEvent);
+        EMU_cancel(uarts[i].rxEvent);
+        uarts[i] = (EmuUart){0};
+        uarts[i].txEvent = EMU_NO_EVENT;
+        uarts[i].rxEvent = EMU_NO_EVENT;
+    }
+}
+
+bool EMU_UART_isRequesting(uint8_t index) {
+    return index < EMU_UART_MODULES && (uarts[index].ifg & uarts[index].ie) != 0;
+}
+
+void EMU_UART_send(uint32_t module, const char *data, uint16_t length) {
+    uint8_t index = EMU_UART_index(module);
+    EmuUart *u = &uarts[index];
+    for (uint16_t i = 0; i < length; i++)
+        EMU_UART_push(&u->input, data[i]);
+    if (u->isEnabled && u->rxEvent == EMU_NO_EVENT && u->input.count > 0)
+        u->rxEvent = EMU_schedule(u->byteTime, EMU_UART_onRxEnd, index);
+}
+
+uint16_t EMU_UART_read(uint32_t module, char *data, uint16_t max) {
+    EmuUart *u = &uarts[EMU_UART_index(module)];
+    uint16_t n = 0;
+    while (n < max && u->output.count > 0)
+        data[n++] = EMU_UART_pop(&u->output);
+    return n;
+}
+
+uint64_t EMU_UART_getByteTime(uint32_t module) { return uarts[EMU_UART_index(module)].byteTime; }
+
+EmuUartStats EMU_UART_getStats(uint32_t module) { return uarts[EMU_UART_index(module)].stats; }
+
+/* inc/driverlib/uart.h */
+
+bool UART_initModule(uint32_t moduleInstance, const eUSCI_UART_ConfigV1 *config) {
+    EMU_access();
+    EmuUart *u = &uarts[EMU_UART_index(moduleInstance)];
+    EMU_cancel(u->txEvent);
+    EMU_cancel(u->rxEvent);
+    u->txEvent = EMU_NO_EVENT;
+    u->rxEvent = EMU_NO_EVENT;
+    u->isEnabled = false;
+    u->isTxBufFull = false;
+    u->ie = 0;
+    u->ifg = 0;
+
+    // start, data, parity and stop bits, each lasting the divider of the baud rate generator
+    uint32_t hz = config->selectClockSource == EUSCI_A_UART_CLOCKSOURCE_ACLK ? EMU_ACLK : EMU_SMCLK;
+    uint64_t divider = config->clockPrescalar;
+    if (config->overSampling == EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION)
+        divider = 16 * divider + config->firstModReg;
+    uint8_t bits = 1 + (config->dataLength == EUSCI_A_UART_7_BIT_LEN ? 7 : 8);
+    bits += config->parity != EUSCI_A_UART_NO_PARITY;
+    bits += config->numberofStopBits == EUSCI_A_UART_TWO_STOP_BITS ? 2 : 1;
+    u->byteTime = EMU_ticksToTime(bits * divider, hz);
+    return true;
+}
+
+void UART_enableModule(uint32_t moduleInstance) {
+    EMU_access();
+    uint8_t index = EMU_UART_index(moduleInstance);
+    EmuUart *u = &uarts[index];
+    if (u->isEnabled)
+        return;
+    u->isEnabled = true;
+    u->ifg |= EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+    if (u->input.count > 0)
+        u->rxEvent = EMU_schedule(u->byteTime, EMU_UART_onRxEnd, index);
+}
+
+void UART_transmitData(uint32_t moduleInstance, uint_fast8_t transmitData) {
+    EMU_access();
+    uint8_t index = EMU_UART_index(moduleInstance);
+    EmuUart *u = &uarts[index];
+    if (!u->isEnabled)
+        return;
+    u->ifg &= ~EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+    if (u->txEvent == EMU_NO_EVENT) {
+        // the shift register is idle, the byte leaves the buffer at once
+        u->shift = transmitData;
+        u->ifg |= EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+        u->txEvent = EMU_schedule(u->byteTime, EMU_UART_onTxEnd, index);
+    } else {
+        u->txBuf = transmitData;
+        u->isTxBufFull = true;
+    }
+}
+
+uint8_t UART_receiveData(uint32_t moduleInstance) {
+    EMU_access();
+    EmuUart *u = &uarts[EMU_UART_index(moduleInstance)];
+    u->ifg &= ~EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG;
+    return u->rxBuf;
+}
+
+void UART_enableInterrupt(uint32_t moduleInstance, uint_fast8_t mask) {
+    EMU_access();
+    uarts[EMU_UART_index(moduleInstance)].ie |= mask;
+}
+
+void UART_disableInterrupt(uint32_t moduleInstance, uint_fast8_t mask) {
+    EMU_access();
+    uarts[EMU_UART_index(moduleInstance)].ie &= ~mask;
+}
+
+uint_fast8_t UART_getEnabledInterruptStatus(uint32_t moduleInstance) {
+    EMU_access();
+    const EmuUart *u = &uarts[EMU_UART_index(moduleInstance)];
+    return u->ifg & u->ie;
+}
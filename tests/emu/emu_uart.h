@@ -0,0 +1,209 @@
+/*H************************************************************************************************
+ * FILENAME:        emu_uart.h
+ *
+ * DESCRIPTION:
+ *      This header provides the emulation of the four eUSCI_A modules in UART mode, with the line
+ *      timed by the configured baud rate, and the functions used by the test bench to play the
+ *      device at the other end of the line.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void            EMU_UART_reset()
+ *      bool            EMU_UART_isRequesting(uint8_t index)
+ *      void            EMU_UART_send(uint32_t module, const char *data, uint16_t length)
+ *      uint16_t        EMU_UART_read(uint32_t module, char *data, uint16_t max)
+ *      uint64_t        EMU_UART_getByteTime(uint32_t module)
+ *      EmuUartStats    EMU_UART_getStats(uint32_t module)
+ *
+ * NOTES:
+ *      The transmitter is double buffered as on the device: the transmit flag is set again as soon
+ *      as a byte moves from the buffer to the shift register, one byte time before the end of the
+ *      previous one. A byte received while the previous one has not been read overwrites it.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef EMU_UART_H
+#define EMU_UART_H
+
+#define EMU_UART_MODULES 4        /* Modules from EUSCI_A0 to EUSCI_A3                      */
+#define EMU_UART_BUFFER_SIZE 4096 /* Bytes queued in every direction for the test bench     */
+
+/*T************************************************************************************************
+ * NAME: EmuUartStats
+ *
+ * DESCRIPTION:
+ *      Represent the traffic of a module.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    txBytes     Bytes transmitted on the line
+ *              uint32_t    rxBytes     Bytes received from the line
+ *              uint32_t    overruns    Received bytes overwritten before being read
+ *              uint32_t    lostBytes   Transmitted bytes not read by the test bench in time
+ */
+typedef struct {
+    uint32_t txBytes;
+    uint32_t rxBytes;
+    uint32_t overruns;
+    uint32_t lostBytes;
+} EmuUartStats;
+
+/*F************************************************************************************************
+ * NAME: void EMU_UART_reset()
+ *
+ * DESCRIPTION:
+ *      Puts all the modules in reset, with empty lines and statistics.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void EMU_UART_reset();
+
+/*F************************************************************************************************
+ * NAME: bool EMU_UART_isRequesting(uint8_t index)
+ *
+ * DESCRIPTION:
+ *      Tells whether a module requests its interrupt, i.e. a flag is set with its interrupt
+ *      enabled.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint8_t     index   Index of the module, 0 for EUSCI_A0
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the interrupt is requested
+ *
+ *  NOTE:
+ */
+bool EMU_UART_isRequesting(uint8_t index);
+
+/*F************************************************************************************************
+ * NAME: void EMU_UART_send(uint32_t module, const char *data, uint16_t length)
+ *
+ * DESCRIPTION:
+ *      Queues bytes on the receiving line of a module, they arrive one byte time apart.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t        module      EUSCI_A*_BASE
+ *          const char*     data        Bytes to send
+ *          uint16_t        length      Number of bytes
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The bytes that do not fit in EMU_UART_BUFFER_SIZE are discarded, nothing is received while
+ *      the module is in reset.
+ */
+void EMU_UART_send(uint32_t module, const char *data, uint16_t length);
+
+/*F************************************************************************************************
+ * NAME: uint16_t EMU_UART_read(uint32_t module, char *data, uint16_t max)
+ *
+ * DESCRIPTION:
+ *      Reads the bytes transmitted on the line by a module.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    module      EUSCI_A*_BASE
+ *          uint16_t    max         Maximum number of bytes to read
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          char*       data        Bytes read
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Number of bytes read
+ *
+ *  NOTE:
+ *      The bytes are available at the end of their stop bit.
+ */
+uint16_t EMU_UART_read(uint32_t module, char *data, uint16_t max);
+
+/*F************************************************************************************************
+ * NAME: uint64_t EMU_UART_getByteTime(uint32_t module)
+ *
+ * DESCRIPTION:
+ *      Returns the time of a byte on the line, start, data, parity and stop bits included.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    module      EUSCI_A*_BASE
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint64_t
+ *          Value:  Virtual time (ns), 0 if the module has not been configured
+ *
+ *  NOTE:
+ */
+uint64_t EMU_UART_getByteTime(uint32_t module);
+
+/*F************************************************************************************************
+ * NAME: EmuUartStats EMU_UART_getStats(uint32_t module)
+ *
+ * DESCRIPTION:
+ *      Returns the traffic of a module since EMU_init().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    module      EUSCI_A*_BASE
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   EmuUartStats
+ *          Value:  Traffic of the module
+ *
+ *  NOTE:
+ */
+EmuUartStats EMU_UART_getStats(uint32_t module);
+
+#endif // EMU_UART_H
@@ -8,6 +8,8 @@
  * PUBLIC FUNCTIONS:
  *      void    IR_HAL_init()
  *      void    IR_HAL_registerMessageCallback(IRCallback callback);
+ *      void    IR_HAL_triggerCommandReceived(const IRCommand command);
+ *      void    IR_HAL_triggerFrameReceived(uint32_t frame);
  *
  * NOTES:
  *      Due to the nature of the sensor's output a falling edge on the pin corresponds to a rising
@@ -29,10 +31,14 @@
  *
  * CHANGES:
  * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Recording and injection of raw frames
+ * 18 Oct 2026  Maintainers     Tracing of the callback
  */
 #include <stdio.h>
 
 #include "infrared_hal.h"
+#include "../inc/recorder.h"
+#include "../inc/trace.h"
 
 IRCallback irCallback = NULL;      /* Function to call after the reception of a message */
 volatile uint32_t message;         /* Entire 32 bit IR message                          */
@@ -49,13 +55,21 @@ void IR_HAL_parseAndForward() {
     uint8_t command_inv = message;
     bool isValid = !(address & address_inv) && !(command & command_inv);
 
-    // if there is a registered callback function call it
+    // record and, if there is a registered callback function, call it
+    RECORDER_RECORD(RECORDER_CHANNEL_IR_FRAME, command | isValid << 8);
+    TRACE_BEGIN(TRACE_ID_IR_FRAME, command);
     if (irCallback != NULL) {
         irCallback((IRCommand)command, isValid);
     }
+    TRACE_END(TRACE_ID_IR_FRAME);
 }
 
 void IR_HAL_triggerCommandReceived(const IRCommand command) {
     message = command << 8;
     IR_HAL_parseAndForward();
+}
+
+void IR_HAL_triggerFrameReceived(uint32_t frame) {
+    message = frame;
+    IR_HAL_parseAndForward();
 }
\ No newline at end of file
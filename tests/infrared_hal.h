@@ -9,6 +9,7 @@
  *      void    IR_HAL_init()
  *      void    IR_HAL_registerMessageCallback(IRCallback callback)
  *      void    IR_HAL_triggerCommandReceived(const IRCommand command)
+ *      void    IR_HAL_triggerFrameReceived(uint32_t frame)
  *
  * NOTES:
  *      The infrared HAL contains the Interrupt Service Routine (ISR) associated with the signal
@@ -24,6 +25,7 @@
  * 07 Feb 2024  Andrea Piccin   Refactoring
  * 08 Feb 2024  Andrea Piccin   Introduced callback mechanism
  * 19 Feb 2024  Simone Rossi    Modified for testing
+ * 18 Oct 2026  Maintainers     Injection of raw frames
  */
 #include <stdbool.h>
 #include <stdint.h>
@@ -140,4 +142,27 @@ void IR_HAL_registerMessageCallback(IRCallback callback);
  */
 void IR_HAL_triggerCommandReceived(const IRCommand command);
 
+/*F************************************************************************************************
+ * NAME: void IR_HAL_triggerFrameReceived(uint32_t frame);
+ *
+ * DESCRIPTION:
+ *      Simulate the reception of a raw NEC frame: address, inverted address, command and inverted
+ *      command from the most significant byte.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    frame           Received frame, it can be invalid
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void IR_HAL_triggerFrameReceived(uint32_t frame);
+
 #endif // INFRARED_HAL_H
\ No newline at end of file
@@ -0,0 +1,898 @@
+/*C************************************************************************************************
+ * FILENAME:        it_simulation.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the test functions to verify the behavior of the whole
+ *      application inside the simulated world.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    IT_Simulation_test()
+ *      void    IT_Simulation_testBatch()
+ *      void    IT_Simulation_testReplay()
+ *      void    IT_Simulation_testFaults()
+ *      void    IT_Simulation_testUart()
+ *      void    IT_Simulation_testHc08()
+ *      void    IT_Simulation_testReaction()
+ *      void    IT_Simulation_testStall()
+ *      void    IT_Simulation_testDecay()
+ *      void    IT_Simulation_testCalibration()
+ *      void    IT_Simulation_testTrim()
+ *      void    IT_Simulation_testWarmRestart()
+ *      void    IT_Simulation_testSweep()
+ *      void    IT_Simulation_testExploration()
+ *      void    IT_Simulation_testGoTo()
+ *      void    IT_Simulation_testRoute()
+ *      void    IT_Simulation_testScanMatch()
+ *      void    IT_Simulation_testApproach()
+ *
+ * NOTES:
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Added the record and replay test
+ * 18 Oct 2026  Maintainers     Added the fault injection test
+ * 18 Oct 2026  Maintainers     Added the pseudo-terminal test
+ * 18 Oct 2026  Maintainers     Added the HC-08 emulator test
+ * 18 Oct 2026  Maintainers     Added the reaction latency test
+ * 18 Oct 2026  Maintainers     Added the motor stall test
+ * 18 Oct 2026  Maintainers     Added the slow decay test
+ * 18 Oct 2026  Maintainers     Added the speed calibration test
+ * 18 Oct 2026  Maintainers     Added the trim calibration test
+ * 18 Oct 2026  Maintainers     Added the warm restart test
+ * 18 Oct 2026  Maintainers     Added the continuous sweep test
+ * 18 Oct 2026  Maintainers     Added the exploration test
+ * 19 Oct 2026  Maintainers     Added the drive to a goal test
+ * 19 Oct 2026  Maintainers     Added the teach and repeat test
+ * 19 Oct 2026  Maintainers     Added the scan matching test
+ * 19 Oct 2026  Maintainers     Added the early ping test
+ */
+#include <assert.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../inc/calibration_module.h"
+#include "../../inc/exploration_module.h"
+#include "../../inc/grid.h"
+#include "../../inc/odometry_module.h"
+#include "../../inc/planner.h"
+#include "../../inc/powertrain_module.h"
+#include "../../inc/recorder.h"
+#include "../../inc/retained.h"
+#include "../../inc/route_module.h"
+#include "../../inc/sensing_module.h"
+#include "../../inc/state_machine.h"
+#include "../bluetooth_hal.h"
+#include "../infrared_hal.h"
+#include "../servo_hal.h"
+#include "../sim/sim_batch.h"
+#include "../sim/sim_car.h"
+#include "../sim/sim_clock.h"
+#include "../sim/sim_fault.h"
+#include "../sim/sim_hc08.h"
+#include "../sim/sim_reaction.h"
+#include "../sim/sim_replay.h"
+#include "../sim/sim_uart.h"
+
+#define IT_SIMULATION_DURATION 60000000 /* Simulated time in autonomous mode (µs) */
+#define IT_SIMULATION_SEED 1
+#define IT_SIMULATION_BATCH 6           /* Scenarios of the batch test            */
+#define IT_SIMULATION_EVENTS 20000      /* Capacity of the recordings             */
+#define IT_SIMULATION_STEP 10000        /* Recorder drain period (µs)             */
+#define IT_SIMULATION_SCAN 10           /* Angular step of the scans (deg)        */
+#define IT_SIMULATION_SCAN_TIME 6000000 /* Duration of the scans (µs)             */
+#define IT_SIMULATION_EXPLORATION 300000000 /* Longest exploration (µs)            */
+#define IT_SIMULATION_GOAL_TIME 120000000   /* Longest drive to a goal (µs)         */
+#define IT_SIMULATION_ROUTE_TIME 60000000    /* Longest replay of a route (µs)       */
+
+static SimWorld world; /* 3m x 2m room with a box in the middle */
+static RecorderEvent recording[IT_SIMULATION_EVENTS];
+static RecorderEvent replayed[IT_SIMULATION_EVENTS];
+static uint32_t recorded;
+
+static void IT_Simulation_buildWorld() {
+    const double room[] = {0, 0, 300, 0, 300, 200, 0, 200};
+    const double box[] = {130, 80, 170, 80, 170, 120, 130, 120};
+    SIM_WORLD_init(&world);
+    bool isAdded = SIM_WORLD_addPolygon(&world, room, 4);
+    assert(isAdded && "Unexpected full world");
+    isAdded = SIM_WORLD_addPolygon(&world, box, 4);
+    assert(isAdded && "Unexpected full world");
+    world.start.x = 50;
+    world.start.y = 50;
+}
+
+void IT_Simulation_test() {
+    IT_Simulation_buildWorld();
+
+    // The car stays still until the '*' command
+    SimCarParams params = SIM_CAR_defaultParams();
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    assert(FSM_currentState == STATE_REMOTE && "Unexpected state");
+    SIM_CAR_run(1000000);
+    assert(SIM_CAR_getStats().distance == 0 && "Unexpected movement");
+
+    // The car drives around avoiding the walls
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    SIM_CAR_run(IT_SIMULATION_DURATION);
+    SimStats stats = SIM_CAR_getStats();
+    assert(stats.distance > 300 && "The car got stuck");
+    assert(stats.collisions == 0 && "The car hit a wall");
+    assert(stats.timeInState[STATE_TURNING] > 0 && "The car never turned");
+    assert(FSM_currentState != STATE_REMOTE && "Unexpected state");
+
+    // Back to the remote state the car stops
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    assert(FSM_currentState == STATE_REMOTE && "Unexpected state");
+    SimPose pose = SIM_CAR_getPose();
+    SIM_CAR_run(1000000);
+    assert(SIM_CAR_getPose().x == pose.x && SIM_CAR_getPose().y == pose.y && "Unexpected movement");
+}
+
+void IT_Simulation_testBatch() {
+    IT_Simulation_buildWorld();
+
+    SimScenario scenarios[IT_SIMULATION_BATCH];
+    SimResult results[IT_SIMULATION_BATCH];
+    for (uint8_t i = 0; i < IT_SIMULATION_BATCH; i++) {
+        scenarios[i].world = &world;
+        scenarios[i].obstacles = i;
+        scenarios[i].startHeading = i;
+        scenarios[i].params = SIM_CAR_defaultParams();
+        scenarios[i].parameters = parameters;
+        scenarios[i].seed = IT_SIMULATION_SEED + i;
+        scenarios[i].duration = 10000000;
+        scenarios[i].faults = NULL;
+    }
+
+    // Every scenario is executed in a separate copy of the application
+    uint32_t completed = SIM_BATCH_run(scenarios, IT_SIMULATION_BATCH, 2, results);
+    assert(completed == IT_SIMULATION_BATCH && "Unexpected failed scenario");
+
+    // The results do not depend on the process that executed the scenario
+    for (uint8_t i = 0; i < IT_SIMULATION_BATCH; i++) {
+        SimStats stats;
+        SIM_BATCH_runScenario(&scenarios[i], &stats);
+        assert(stats.distance == results[i].stats.distance && "Not reproducible");
+        assert(stats.collisions == results[i].stats.collisions && "Not reproducible");
+        assert(stats.pings == results[i].stats.pings && "Not reproducible");
+        assert(stats.decisionTime == results[i].stats.decisionTime && "Not reproducible");
+    }
+
+    SimSummary summary = SIM_BATCH_summarise(results, IT_SIMULATION_BATCH);
+    assert(summary.runs == IT_SIMULATION_BATCH && summary.failures == 0 && "Unexpected failure");
+    assert(summary.speed.mean > 0 && "The cars got stuck");
+}
+
+static void IT_Simulation_drain() {
+    RecorderEvent event;
+    while (RECORDER_read(&event)) {
+        assert(event.channel != RECORDER_CHANNEL_OVERFLOW && "Unexpected lost events");
+        assert(recorded < IT_SIMULATION_EVENTS && "Unexpected long recording");
+        recording[recorded++] = event;
+    }
+}
+
+static void IT_Simulation_record(uint64_t duration) {
+    for (uint64_t elapsed = 0; elapsed < duration; elapsed += IT_SIMULATION_STEP) {
+        SIM_CAR_run(IT_SIMULATION_STEP);
+        IT_Simulation_drain();
+    }
+}
+
+void IT_Simulation_testReplay() {
+    IT_Simulation_buildWorld();
+
+    // Record a drive with remote commands and some autonomous time
+    SimCarParams params = SIM_CAR_defaultParams();
+    recorded = 0;
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    IT_Simulation_drain();
+    BT_HAL_triggerMessageReceived("FWD");
+    IT_Simulation_record(500000);
+    BT_HAL_triggerMessageReceived("STP");
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    IT_Simulation_record(30000000);
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    IT_Simulation_drain();
+    assert(recorded > 0 && "Nothing recorded");
+
+    // The replay reproduces every event at the same tick
+    uint32_t count = SIM_REPLAY_run(recording, recorded, replayed, IT_SIMULATION_EVENTS);
+    SimReplayDiff diff = SIM_REPLAY_compare(recording, recorded, replayed, count, 0);
+    assert(diff.isEqual && "Replay differs from the recording");
+
+    // A different output is detected where it happens
+    uint32_t changed = recorded - 1;
+    while (recording[changed].channel != RECORDER_CHANNEL_MOTOR_SPEED)
+        changed--;
+    recording[changed].value ^= 1;
+    diff = SIM_REPLAY_compare(recording, recorded, replayed, count, 0);
+    assert(!diff.isEqual && diff.matched == changed && "Difference not detected");
+}
+
+void IT_Simulation_testFaults() {
+    IT_Simulation_buildWorld();
+
+    SimScenario scenario = {
+        .world = &world,
+        .obstacles = 2,
+        .params = SIM_CAR_defaultParams(),
+        .parameters = parameters,
+        .seed = IT_SIMULATION_SEED,
+        .duration = 10000000,
+        .faults = NULL,
+    };
+    SimStats clean;
+    SIM_BATCH_runScenario(&scenario, &clean);
+    assert(clean.commandLatency == 0 && clean.faults == 0 && "Unexpected fault");
+
+    // The remote is not received for a second, the command is sent again until it arrives
+    SimFaultConfig faults = {
+        .script = {{SIM_FAULT_IR, SIM_FAULT_DROP, 0, 1000000}},
+        .scripted = 1,
+    };
+    faults.probability[SIM_FAULT_ECHO][SIM_FAULT_CORRUPT] = 0.5;
+    scenario.faults = &faults;
+    SimStats faulty;
+    SIM_BATCH_runScenario(&scenario, &faulty);
+    assert(faulty.commandLatency >= 1000000 && "Lost command executed");
+    assert(faulty.commandLatency < SIM_BATCH_COMMAND_TIMEOUT && "Command never executed");
+    assert(faulty.faults > 4 && "Faults not injected");
+    assert(faulty.distance != clean.distance && "Faults without effect");
+
+    // The faults are reproducible
+    SimStats again;
+    SIM_BATCH_runScenario(&scenario, &again);
+    assert(again.distance == faulty.distance && again.faults == faulty.faults &&
+           "Not reproducible");
+}
+
+void IT_Simulation_testUart() {
+    IT_Simulation_buildWorld();
+
+    SimCarParams params = SIM_CAR_defaultParams();
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    char name[64];
+    bool isOpen = SIM_UART_open(SIM_UART_BAUD, name, sizeof(name));
+    assert(isOpen && "Cannot create the terminal");
+    int fd = open(name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    assert(fd >= 0 && "Cannot open the terminal");
+
+    // The command reaches the application with its terminator, 6 bytes at 9600 baud (6.25ms)
+    ssize_t written = write(fd, "\r\nAUT\n", 6);
+    assert(written == 6 && "Cannot write the terminal");
+    SIM_UART_poll(100000);
+    SIM_CAR_run(6000);
+    assert(FSM_currentState == STATE_REMOTE && "Command received too early");
+    SIM_CAR_run(500);
+    assert(FSM_currentState != STATE_REMOTE && "Command not received");
+
+    // The telemetry leaves the car at 960 bytes per second
+    char received[512];
+    SIM_CAR_run(100000);
+    ssize_t n = read(fd, received, sizeof(received) - 1);
+    assert(n > 0 && n <= 106 && "Unexpected transmission rate");
+    received[n] = '\0';
+    assert(strstr(received, "\r\n") != NULL && "Missing terminator");
+
+    SimUartStats stats = SIM_UART_getStats();
+    assert(stats.rxBytes == 6 && stats.rxMessages == 1 && "Unexpected reception");
+    close(fd);
+    SIM_UART_close();
+}
+
+void IT_Simulation_testHc08() {
+    IT_Simulation_buildWorld();
+
+    SimCarParams params = SIM_CAR_defaultParams();
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    char name[64];
+    bool isOpen = SIM_UART_open(SIM_UART_BAUD, name, sizeof(name));
+    assert(isOpen && "Cannot create the terminal");
+    SimHc08Config config = SIM_HC08_defaultConfig(); // events every 30ms
+    config.connectDelay = 50000;
+    SIM_HC08_init(&config);
+    int fd = open(name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    assert(fd >= 0 && "Cannot open the terminal");
+
+    // Before the connection the module answers the AT commands of the microcontroller
+    for (const char *c = "AT\r\n"; *c != '\0'; c++)
+        SIM_HC08_fromUart(*c);
+    SIM_CAR_run(20000);
+    assert(SIM_UART_getStats().rxMessages == 1 && "AT command not answered");
+    assert(!SIM_HC08_isConnected() && "Connected too early");
+    SIM_CAR_run(40000);
+    assert(SIM_HC08_isConnected() && "Not connected");
+
+    // A command written at 60ms waits for the event at 80ms, then 4 bytes at 9600 baud
+    ssize_t written = write(fd, "AUT\n", 4);
+    assert(written == 4 && "Cannot write the terminal");
+    SIM_CAR_run(19000);
+    assert(FSM_currentState == STATE_REMOTE && "Command received before the connection event");
+    SIM_CAR_run(11000);
+    assert(FSM_currentState != STATE_REMOTE && "Command not received");
+
+    // The bytes reach the central only at the connection events (290ms, 320ms)
+    char received[512];
+    SIM_CAR_run(220000);
+    while (read(fd, received, sizeof(received)) > 0)
+        ;
+    for (uint8_t i = 0; i < 50; i++)
+        SIM_HC08_fromUart('x');
+    SIM_CAR_run(5000);
+    ssize_t n = read(fd, received, sizeof(received));
+    assert(n <= 0 && "Notification between the events");
+    SIM_CAR_run(10000);
+    n = read(fd, received, sizeof(received));
+    assert(n >= 50 && n <= config.packets * SIM_HC08_PAYLOAD && "Unexpected connection event");
+
+    SimHc08Stats stats = SIM_HC08_getStats();
+    assert(stats.notifications > 0 &&
+           stats.uplinkBytes <= stats.notifications * SIM_HC08_PAYLOAD &&
+           "Notifications larger than the payload");
+    assert(stats.maxUplinkLatency <= config.interval * SIM_HC08_UNIT && "Late notification");
+    assert(stats.writes == 1 && stats.downlinkBytes == 4 && stats.atCommands == 1 &&
+           "Unexpected traffic");
+    close(fd);
+    SIM_HC08_init(NULL);
+    SIM_UART_close();
+}
+
+void IT_Simulation_testReaction() {
+    // The sensor looks ahead: the first probe detects the obstacle
+    SimReactionSetup setup = SIM_REACTION_defaultSetup();
+    SimReaction reaction;
+    SIM_REACTION_run(&setup, &reaction);
+    assert(reaction.isStopped && reaction.collisions == 0 && reaction.clearance > 0 &&
+           "The car did not stop in time");
+    assert(reaction.probes == 1 && "Obstacle missed by a probe");
+    assert(reaction.stages[SIM_REACTION_PROBE] <=
+               SIM_CLOCK_TICKS_TO_US(setup.parameters.sensingTimerCount) &&
+           reaction.stages[SIM_REACTION_SERVO] == 0 && "Unexpected probe");
+    uint64_t echo = 450 + 58 * reaction.clearance; // HC-SR04 timing at the detection
+    assert(reaction.stages[SIM_REACTION_ECHO] > echo - 200 &&
+           reaction.stages[SIM_REACTION_ECHO] < echo + 200 && "Unexpected echo");
+    assert(reaction.stages[SIM_REACTION_DECISION] == 0 && "The stop is not immediate");
+    uint64_t sum = 0;
+    for (uint8_t s = 0; s < SIM_REACTION_TOTAL; s++)
+        sum += reaction.stages[s];
+    assert(reaction.stages[SIM_REACTION_TOTAL] == sum && "Stages do not add up");
+
+    // The sensor looks aside: the first probe waits for the servo
+    setup.servoPosition = SERVO_MAX_POSITION;
+    SIM_REACTION_run(&setup, &reaction);
+    assert(reaction.isStopped && reaction.stages[SIM_REACTION_SERVO] > 0 && "Servo not timed");
+}
+
+void IT_Simulation_testStall() {
+    // A box under the sight of the ultrasonic sensor, right ahead of the car
+    const double low[] = {110, 20, 150, 20, 150, 80, 110, 80};
+    IT_Simulation_buildWorld();
+    bool isAdded = SIM_WORLD_addLowPolygon(&world, low, 4);
+    assert(isAdded && "Unexpected full world");
+
+    // The car pushes against the box until the stall is detected, then backs off
+    SimCarParams params = SIM_CAR_defaultParams();
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    SIM_CAR_run(IT_SIMULATION_DURATION);
+    SimStats stats = SIM_CAR_getStats();
+    assert(stats.collisions > 0 && "The car never touched the box");
+    assert(stats.stalls > 0 && "Stall not detected");
+    assert(stats.maxStallLatency < 100000 && "Late stall detection");
+    assert(stats.timeInState[STATE_TURNING] > 0 && "The car did not resume");
+    assert(stats.distance > 300 && "The car got stuck");
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+}
+
+static double IT_Simulation_crawl(MotorDecay decay) {
+    SimCarParams params = SIM_CAR_defaultParams();
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    MOTOR_HAL_setDecayMode((Motor *)&powertrain.left_motor, decay);
+    MOTOR_HAL_setDecayMode((Motor *)&powertrain.right_motor, decay);
+    Powertrain_Module_moveBackward();
+    SIM_CAR_run(1000000);
+    Powertrain_Module_stop();
+    return SIM_CAR_getStats().distance;
+}
+
+void IT_Simulation_testDecay() {
+    IT_Simulation_buildWorld();
+
+    // At the reverse speed the slow decay drive moves the car much further
+    double fast = IT_Simulation_crawl(MOTOR_DECAY_FAST);
+    double slow = IT_Simulation_crawl(MOTOR_DECAY_SLOW);
+    assert(fast > 0 && slow > 2 * fast && "The slow decay does not crawl");
+
+    // The automatic mode is slow at low speed and fast above
+    double automatic = IT_Simulation_crawl(MOTOR_DECAY_AUTO);
+    assert(automatic == slow && "Unexpected automatic decay");
+    MOTOR_HAL_setSpeed((Motor *)&powertrain.left_motor, 80);
+    assert(!powertrain.left_motor.isSlowDecay && "Unexpected automatic decay");
+}
+
+static double IT_Simulation_drive(uint8_t speed) {
+    SimPose start = SIM_CAR_getPose();
+    Powertrain_Module_moveForward();
+    MOTOR_HAL_setSpeed((Motor *)&powertrain.left_motor, speed);
+    MOTOR_HAL_setSpeed((Motor *)&powertrain.right_motor, speed);
+    SIM_CAR_run(1000000);
+    Powertrain_Module_stop();
+    SimPose end = SIM_CAR_getPose();
+    Powertrain_Module_moveBackward();
+    MOTOR_HAL_setSpeed((Motor *)&powertrain.left_motor, speed);
+    MOTOR_HAL_setSpeed((Motor *)&powertrain.right_motor, speed);
+    SIM_CAR_run(1000000);
+    Powertrain_Module_stop();
+    return end.x - start.x;
+}
+
+void IT_Simulation_testCalibration() {
+    const double room[] = {0, 0, 300, 0, 300, 200, 0, 200};
+    SIM_WORLD_init(&world);
+    bool isAdded = SIM_WORLD_addPolygon(&world, room, 4);
+    assert(isAdded && "Unexpected full world");
+    world.start.x = 50;
+    world.start.y = 100;
+    SimCarParams params = SIM_CAR_defaultParams();
+    params.slowDeadZone = 12; // the motors do not spin at 10%
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+
+    // Any command aborts the sweep
+    BT_HAL_triggerMessageReceived("CAL");
+    SIM_CAR_run(2000000);
+    assert(Calibration_Module_isRunning() && "The sweep has not started");
+    BT_HAL_triggerMessageReceived("STP");
+    assert(!Calibration_Module_isRunning() && powertrain.left_motor.state.speed == 0 &&
+           "The sweep has not been aborted");
+    assert(powertrain.left_motor.curve == NULL && "Unexpected curve");
+
+    // The sweep solves a non decreasing curve, with the dead zone at its start
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("CAL");
+    SIM_CAR_run(40000000);
+    assert(!Calibration_Module_isRunning() && "The sweep has not ended");
+    const MotorCurve *curve = powertrain.left_motor.curve;
+    assert(curve != NULL && powertrain.right_motor.curve != NULL && "No curve");
+    for (uint8_t i = 1; i < MOTOR_CURVE_POINTS; i++)
+        assert(curve->duty[i] >= curve->duty[i - 1] && "The curve decreases");
+    assert(curve->duty[0] == 100 && "Unexpected dead zone");
+    assert(fabs(SIM_CAR_getPose().x - world.start.x) < 10 && "The sweep does not come back");
+
+    // The speed is proportional to the requested one, even under the former minimum of 20%
+    double full = IT_Simulation_drive(100);
+    assert(full > 50 && "Unexpected top speed");
+    for (uint8_t speed = 10; speed < 100; speed += 30) {
+        double ratio = IT_Simulation_drive(speed) / full;
+        assert(fabs(ratio - speed / 100.0) < 0.05 && "The speed is not proportional");
+    }
+
+    // The curves survive a reboot until they are cleared
+    MotorCurve stored = *curve;
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    assert(powertrain.left_motor.curve != NULL &&
+           memcmp(powertrain.left_motor.curve, &stored, sizeof(stored)) == 0 &&
+           "The curves have not been stored");
+    Calibration_Module_clear();
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    assert(powertrain.left_motor.curve == NULL && "The curves have not been cleared");
+}
+
+static double IT_Simulation_turn() {
+    double heading = SIM_CAR_getPose().heading;
+    Powertrain_Module_moveForward();
+    SIM_CAR_run(4000000);
+    Powertrain_Module_stop();
+    return SIM_CAR_getPose().heading - heading;
+}
+
+void IT_Simulation_testTrim() {
+    const double room[] = {0, 0, 300, 0, 300, 200, 0, 200};
+    SIM_WORLD_init(&world);
+    bool isAdded = SIM_WORLD_addPolygon(&world, room, 4);
+    assert(isAdded && "Unexpected full world");
+    world.start.x = 50;
+    world.start.y = 40;
+    SimCarParams params = SIM_CAR_defaultParams();
+    params.leftGain = 1.05; // the left motors are faster
+
+    // Without trim the car curves to the right
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    double untrimmed = IT_Simulation_turn();
+    assert(untrimmed < -0.1 && "Unexpected straight run");
+
+    // Any command aborts the calibration
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("TRM");
+    SIM_CAR_run(3000000);
+    assert(Calibration_Module_isRunning() && "The calibration has not started");
+    BT_HAL_triggerMessageReceived("STP");
+    assert(!Calibration_Module_isRunning() && powertrain.left_motor.state.speed == 0 &&
+           "The calibration has not been aborted");
+    assert(Powertrain_Module_getTrim() == 0 && "Unexpected trim");
+
+    // The calibration follows the wall at the right and slows down the left motors
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("TRM");
+    SIM_CAR_run(45000000);
+    assert(!Calibration_Module_isRunning() && "The calibration has not ended");
+    int16_t trim = Powertrain_Module_getTrim();
+    assert(trim > 25 && trim < 55 && "Unexpected trim");
+    assert(SIM_CAR_getStats().collisions == 0 && "The car hit the wall");
+    assert(fabs(SIM_CAR_getPose().x - world.start.x) < 10 && "The calibration does not come back");
+
+    // The trim survives a reboot and the car runs straight, the turns are not trimmed
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    assert(Powertrain_Module_getTrim() == trim && "The trim has not been stored");
+    assert(powertrain.left_motor.curve == NULL && "Unexpected curve");
+    double trimmed = IT_Simulation_turn();
+    assert(fabs(trimmed) < fabs(untrimmed) / 4 && "The car does not run straight");
+    Powertrain_Module_turnLeft(45);
+    assert(powertrain.left_motor.trim == MOTOR_TRIM_NONE && "Unexpected trimmed turn");
+
+    Calibration_Module_clear();
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    assert(Powertrain_Module_getTrim() == 0 && "The trim has not been cleared");
+}
+
+void IT_Simulation_testWarmRestart() {
+    IT_Simulation_buildWorld();
+    SimCarParams params = SIM_CAR_defaultParams();
+    uint16_t freeThreshold = parameters.freeThreshold;
+
+    // The car drives around until the servo looks aside, with a tuned threshold
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    parameters.freeThreshold = freeThreshold + 5;
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    for (uint32_t t = 0; t < IT_SIMULATION_DURATION && Sensing_Module_getServoPosition() == 0;
+         t += 10000)
+        SIM_CAR_run(10000);
+    int8_t servoPosition = Sensing_Module_getServoPosition();
+    assert(servoPosition != 0 && "The servo never looked aside");
+    RETAINED_update();
+
+    // A warm boot resumes the autonomous mode, the servo position and the parameters
+    parameters.freeThreshold = freeThreshold;
+    retainedResetCause = RETAINED_RESET_WARM;
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    assert(FSM_currentState == STATE_RUNNING && "The autonomous mode has not been resumed");
+    assert(Sensing_Module_getServoPosition() == servoPosition && "The servo has been homed");
+    assert(parameters.freeThreshold == freeThreshold + 5 && "The parameters have not been kept");
+    SIM_CAR_run(IT_SIMULATION_DURATION);
+    assert(SIM_CAR_getStats().distance > 100 && "The car got stuck");
+    assert(SIM_CAR_getStats().collisions == 0 && "The car hit a wall");
+
+    // A cold boot starts from scratch
+    RETAINED_update();
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    assert(RETAINED_getRestored() == NULL && "State resumed after a cold boot");
+    assert(FSM_currentState == STATE_REMOTE && "Unexpected resume");
+    assert(Sensing_Module_getServoPosition() == 0 && "The servo has not been homed");
+
+    // A corrupted state is not resumed
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    SIM_CAR_run(1000000);
+    RETAINED_update();
+    retainedState.servoPosition++;
+    retainedResetCause = RETAINED_RESET_WARM;
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    assert(RETAINED_getRestored() == NULL && "Corrupted state resumed");
+    assert(FSM_currentState == STATE_REMOTE && "Unexpected resume");
+    parameters.freeThreshold = freeThreshold;
+}
+
+static uint32_t scanEchoes;   /* Echoes of the current scan                         */
+static uint32_t scanPasses;   /* Passes from an extreme to the other one            */
+static int8_t scanAngle;      /* Angle of the last echo                             */
+static int8_t scanDirection;  /* Direction of the last echoes, 0 before the first   */
+static double scanMaxError;   /* Worst error of the interpolated angles (deg)       */
+static int8_t stepAngle;      /* Angle of the step and settle scan                  */
+static int8_t stepDirection;  /* Direction of the step and settle scan              */
+
+static void IT_Simulation_onScanAngle(int8_t angle) {
+    int8_t direction = angle > scanAngle ? 1 : angle < scanAngle ? -1 : scanDirection;
+    if (scanEchoes > 0 && scanDirection != 0 && direction != scanDirection)
+        scanPasses++;
+    scanDirection = scanEchoes > 0 ? direction : 0;
+    scanAngle = angle;
+    scanEchoes++;
+}
+
+static void IT_Simulation_onSweepEcho(int8_t angle, uint16_t distance) {
+    (void)distance;
+    double error = fabs(angle - SIM_CAR_getEchoAngle());
+    if (error > scanMaxError)
+        scanMaxError = error;
+    IT_Simulation_onScanAngle(angle);
+}
+
+static void IT_Simulation_onStepEcho(uint16_t distance) {
+    (void)distance;
+    IT_Simulation_onScanAngle(stepAngle);
+    if (stepAngle + stepDirection * IT_SIMULATION_SCAN > SERVO_MAX_POSITION ||
+        stepAngle + stepDirection * IT_SIMULATION_SCAN < SERVO_MIN_POSITION)
+        stepDirection = -stepDirection;
+    stepAngle += stepDirection * IT_SIMULATION_SCAN;
+    Sensing_Module_measureDistance(stepAngle);
+}
+
+static void IT_Simulation_resetScan() {
+    scanEchoes = 0;
+    scanPasses = 0;
+    scanAngle = 0;
+    scanDirection = 0;
+    scanMaxError = 0;
+}
+
+void IT_Simulation_testSweep() {
+    IT_Simulation_buildWorld();
+    SimCarParams params = SIM_CAR_defaultParams();
+    params.servoSpeed = 180 / 0.66; // the speed of the motion model of the servo HAL
+
+    // Step and settle scan: the servo stops at every angle before the ping
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    IT_Simulation_resetScan();
+    Sensing_Module_registerDistanceCallback(IT_Simulation_onStepEcho);
+    stepAngle = SERVO_MIN_POSITION;
+    stepDirection = 1;
+    Sensing_Module_measureDistance(stepAngle);
+    SIM_CAR_run(IT_SIMULATION_SCAN_TIME);
+    uint32_t stepEchoes = scanEchoes;
+    uint32_t stepPasses = scanPasses;
+    Sensing_Module_registerDistanceCallback(NULL);
+
+    // Sweep with the same angular step
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    IT_Simulation_resetScan();
+    Sensing_Module_startSweep(IT_SIMULATION_SCAN, IT_Simulation_onSweepEcho);
+    SIM_CAR_run(IT_SIMULATION_SCAN_TIME);
+    Sensing_Module_stopSweep();
+    assert(!Sensing_Module_isSweeping() && "Unexpected sweep");
+    assert(scanEchoes > 3 * stepEchoes && "The sweep is not denser");
+    assert(scanPasses > stepPasses && "The sweep is not faster");
+    assert(scanMaxError <= 3 && "Inaccurate sweep angles");
+    uint32_t sweepPasses = scanPasses;
+
+    // Smaller steps slow the servo down to the echoes
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    IT_Simulation_resetScan();
+    Sensing_Module_startSweep(1, IT_Simulation_onSweepEcho);
+    SIM_CAR_run(IT_SIMULATION_SCAN_TIME);
+    Sensing_Module_stopSweep();
+    assert(scanPasses < sweepPasses && "Unexpected full speed sweep");
+    assert(scanMaxError <= 3 && "Inaccurate sweep angles");
+}
+
+void IT_Simulation_testExploration() {
+    IT_Simulation_buildWorld();
+    SimCarParams params = SIM_CAR_defaultParams();
+
+    // Any command aborts the exploration
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("EXP");
+    SIM_CAR_run(3000000);
+    assert(Exploration_Module_isRunning() && "The exploration has not started");
+    BT_HAL_triggerMessageReceived("STP");
+    assert(!Exploration_Module_isRunning() && powertrain.left_motor.state.speed == 0 &&
+           "The exploration has not been aborted");
+
+    // The car maps the room until no frontier is left
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("EXP");
+    for (uint64_t t = 0; t < IT_SIMULATION_EXPLORATION && Exploration_Module_isRunning();
+         t += 1000000)
+        SIM_CAR_run(1000000);
+    SimStats stats = SIM_CAR_getStats();
+    assert(!Exploration_Module_isRunning() && "The exploration has not ended");
+    assert(stats.collisions == 0 && "The car hit a wall");
+    assert(stats.charge > 0 && "No battery consumed");
+
+    // The free cells are in the room, around the box
+    uint16_t inside = 0;
+    uint16_t outside = 0;
+    for (int16_t cy = 0; cy < GRID_SIZE; cy++) {
+        for (int16_t cx = 0; cx < GRID_SIZE; cx++) {
+            if (GRID_getCell(cx, cy) != GRID_FREE)
+                continue;
+            int32_t x, y;
+            GRID_toPoint(cx, cy, &x, &y);
+            double wx = world.start.x + x / 10.0;
+            double wy = world.start.y + y / 10.0;
+            bool isInRoom = wx > -5 && wx < 305 && wy > -5 && wy < 205;
+            bool isInBox = wx > 135 && wx < 165 && wy > 85 && wy < 115;
+            if (isInRoom && !isInBox)
+                inside++;
+            else
+                outside++;
+        }
+    }
+    assert(GRID_getCoverage() >= 80 && "Unexpected low coverage");
+    assert(inside >= 300 && "The room has not been mapped");
+    assert(outside * 10 < inside && "The map does not match the room");
+}
+
+void IT_Simulation_testGoTo() {
+    IT_Simulation_buildWorld();
+    SimCarParams params = SIM_CAR_defaultParams();
+
+    // Any command aborts the drive
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("GTO180,100");
+    SIM_CAR_run(3000000);
+    assert(Exploration_Module_isRunning() && "The drive has not started");
+    BT_HAL_triggerMessageReceived("STP");
+    assert(!Exploration_Module_isRunning() && powertrain.left_motor.state.speed == 0 &&
+           "The drive has not been aborted");
+
+    // The aborted drive leaves the pose out of date, the next drive starts a new map
+    uint16_t mapped = GRID_countFree();
+    BT_HAL_triggerMessageReceived("GTO180,100");
+    OdometryPose restarted = Odometry_Module_getPose();
+    assert(restarted.x == 0 && restarted.y == 0 && restarted.heading == 0 &&
+           GRID_countFree() < mapped && "The map of the aborted drive has been kept");
+    BT_HAL_triggerMessageReceived("STP");
+
+    // A goal outside the grid is ignored
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("GTO1000,0");
+    assert(!Exploration_Module_isRunning() && "Unexpected drive");
+
+    // The straight line to the goal crosses the box, the car drives around it
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("GTO180,100");
+    for (uint64_t t = 0; t < IT_SIMULATION_GOAL_TIME && Exploration_Module_isRunning();
+         t += 1000000)
+        SIM_CAR_run(1000000);
+    SimStats stats = SIM_CAR_getStats();
+    SimPose pose = SIM_CAR_getPose();
+    assert(!Exploration_Module_isRunning() && "The drive has not ended");
+    assert(stats.collisions == 0 && "The car hit a wall");
+    OdometryPose estimate = Odometry_Module_getPose();
+    assert(abs(estimate.x - 1800) <= GRID_CELL && abs(estimate.y - 1000) <= GRID_CELL &&
+           "The drive ended away from the goal");
+    // Dead reckoning without encoders drifts by a few cells over the drive
+    assert(fabs(pose.x - (world.start.x + 180)) < 40 && fabs(pose.y - (world.start.y + 100)) < 40 &&
+           "The car has not reached the goal");
+    assert(PLANNER_getStatus() == PLANNER_FOUND && "Unexpected failed plan");
+}
+
+static void IT_Simulation_teach() {
+    // Straight, 45 degrees clockwise, straight again parallel to the first leg
+    BT_HAL_triggerMessageReceived("REC");
+    BT_HAL_triggerMessageReceived("FWD");
+    SIM_CAR_run(3000000);
+    BT_HAL_triggerMessageReceived("RGT");
+    SIM_CAR_run(1000000);
+    BT_HAL_triggerMessageReceived("FWD");
+    SIM_CAR_run(2000000);
+    BT_HAL_triggerMessageReceived("LFT");
+    SIM_CAR_run(1000000);
+    BT_HAL_triggerMessageReceived("FWD");
+    SIM_CAR_run(2000000);
+    assert(Route_Module_isRecording() && "The recording has not started");
+    BT_HAL_triggerMessageReceived("END");
+    assert(!Route_Module_isRecording() && powertrain.left_motor.state.speed == 0 &&
+           "The recording has not ended");
+}
+
+static void IT_Simulation_repeat() {
+    BT_HAL_triggerMessageReceived("RPL");
+    assert(Route_Module_isReplaying() && "The replay has not started");
+    for (uint64_t t = 0; t < IT_SIMULATION_ROUTE_TIME && Route_Module_isReplaying();
+         t += 1000000)
+        SIM_CAR_run(1000000);
+    assert(!Route_Module_isReplaying() && "The replay has not ended");
+}
+
+void IT_Simulation_testRoute() {
+    IT_Simulation_buildWorld();
+    SimCarParams params = SIM_CAR_defaultParams();
+
+    // No route is stored at first
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("RPL");
+    assert(!Route_Module_isReplaying() && "Unexpected replay");
+
+    // The route is driven manually
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    IT_Simulation_teach();
+    SimPose end = SIM_CAR_getPose();
+    assert(SIM_CAR_getStats().collisions == 0 && "The car hit a wall");
+
+    // Any command aborts the replay, the route survives the reinitialisation of the modules
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("RPL");
+    SIM_CAR_run(1000000);
+    assert(Route_Module_isReplaying() && "The replay has not started");
+    BT_HAL_triggerMessageReceived("STP");
+    assert(!Route_Module_isReplaying() && powertrain.left_motor.state.speed == 0 &&
+           "The replay has not been aborted");
+
+    // From the same start, the car ends where the route was recorded
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    IT_Simulation_repeat();
+    SimPose pose = SIM_CAR_getPose();
+    assert(SIM_CAR_getStats().collisions == 0 && "The car hit a wall");
+    assert(hypot(pose.x - end.x, pose.y - end.y) < 15 && "The replay ended off the route");
+
+    // An obstacle on the route stops the car, that gives up once it stays there
+    const double block[] = {95, 35, 105, 35, 105, 65, 95, 65};
+    bool isAdded = SIM_WORLD_addPolygon(&world, block, 4);
+    assert(isAdded && "Unexpected full world");
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    IT_Simulation_repeat();
+    pose = SIM_CAR_getPose();
+    assert(SIM_CAR_getStats().collisions == 0 && "The car hit the obstacle");
+    assert(pose.x < 95 && "The car has not stopped before the obstacle");
+
+    // The switch of mode ends the recording, the autonomous drive is not recorded
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("REC");
+    BT_HAL_triggerMessageReceived("FWD");
+    SIM_CAR_run(1000000);
+    BT_HAL_triggerMessageReceived("AUT");
+    assert(!Route_Module_isRecording() && FSM_currentState != STATE_REMOTE &&
+           "The recording has not ended with the switch of mode");
+    BT_HAL_triggerMessageReceived("MAN");
+    assert(FSM_currentState == STATE_REMOTE && "Manual mode not restored");
+}
+
+void IT_Simulation_testScanMatch() {
+    IT_Simulation_buildWorld();
+    SimCarParams params = SIM_CAR_defaultParams();
+    params.trackWidth = 18; // The turns stop about a fifth short of the commanded angle
+
+    // The scans after the turns keep the heading right, it is checked while running forward
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+    BT_HAL_triggerMessageReceived("GTO180,100");
+    double maxError = 0;
+    for (uint64_t t = 0; t < IT_SIMULATION_GOAL_TIME && Exploration_Module_isRunning();
+         t += 100000) {
+        SIM_CAR_run(100000);
+        if (powertrain.left_motor.state.speed == 0 ||
+            powertrain.left_motor.state.direction != powertrain.right_motor.state.direction)
+            continue;
+        double error = Odometry_Module_getPose().heading - SIM_CAR_getPose().heading * 180 / M_PI;
+        error = fabs(remainder(error, 360));
+        if (error > maxError)
+            maxError = error;
+    }
+    assert(!Exploration_Module_isRunning() && "The drive has not ended");
+    assert(SIM_CAR_getStats().collisions == 0 && "The car hit a wall");
+    // Uncorrected, the heading drifts by 20 degrees over the drive
+    assert(maxError < 12 && "The heading has not been corrected");
+}
+
+void IT_Simulation_testApproach() {
+    // A wall 2m ahead, approached at full speed: 20cm between the periodic checks
+    const double room[] = {0, 0, 250, 0, 250, 100, 0, 100};
+    SIM_WORLD_init(&world);
+    bool isAdded = SIM_WORLD_addPolygon(&world, room, 4);
+    assert(isAdded && "Unexpected full world");
+    world.start.x = 40;
+    world.start.y = 50;
+    world.start.heading = 0;
+    SimCarParams params = SIM_CAR_defaultParams();
+    uint8_t forwardSpeed = parameters.forwardSpeed;
+    parameters.forwardSpeed = 100;
+    SIM_CAR_init(&world, &params, IT_SIMULATION_SEED);
+
+    // The early pings stop the car as it crosses the free threshold
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    for (uint32_t t = 0; t < IT_SIMULATION_DURATION && FSM_currentState == STATE_RUNNING;
+         t += 1000)
+        SIM_CAR_run(1000);
+    assert(FSM_currentState == STATE_SENSING && "The car did not stop at the wall");
+    double clearance = 250 - SIM_CAR_getPose().x - params.sensorOffset;
+    assert(clearance > parameters.freeThreshold - 2 && "The car stopped late");
+    assert(SIM_CAR_getStats().collisions == 0 && "The car hit the wall");
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    parameters.forwardSpeed = forwardSpeed;
+}
@@ -0,0 +1,75 @@
+/*H************************************************************************************************
+ * FILENAME:        it_simulation.h
+ *
+ * DESCRIPTION:
+ *      This header file provides the test functions to verify the behavior of the whole
+ *      application inside the simulated world.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    IT_Simulation_test()
+ *      void    IT_Simulation_testBatch()
+ *      void    IT_Simulation_testReplay()
+ *      void    IT_Simulation_testFaults()
+ *      void    IT_Simulation_testUart()
+ *      void    IT_Simulation_testHc08()
+ *      void    IT_Simulation_testReaction()
+ *      void    IT_Simulation_testStall()
+ *      void    IT_Simulation_testDecay()
+ *      void    IT_Simulation_testCalibration()
+ *      void    IT_Simulation_testTrim()
+ *      void    IT_Simulation_testWarmRestart()
+ *      void    IT_Simulation_testSweep()
+ *      void    IT_Simulation_testExploration()
+ *      void    IT_Simulation_testGoTo()
+ *      void    IT_Simulation_testRoute()
+ *      void    IT_Simulation_testScanMatch()
+ *      void    IT_Simulation_testApproach()
+ *
+ * NOTES:
+ *      The test registers the simulator hooks on the mocked HALs, so it has to be the last one.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Added the record and replay test
+ * 18 Oct 2026  Maintainers     Added the fault injection test
+ * 18 Oct 2026  Maintainers     Added the pseudo-terminal test
+ * 18 Oct 2026  Maintainers     Added the HC-08 emulator test
+ * 18 Oct 2026  Maintainers     Added the reaction latency test
+ * 18 Oct 2026  Maintainers     Added the motor stall test
+ * 18 Oct 2026  Maintainers     Added the slow decay test
+ * 18 Oct 2026  Maintainers     Added the speed calibration test
+ * 18 Oct 2026  Maintainers     Added the trim calibration test
+ * 18 Oct 2026  Maintainers     Added the warm restart test
+ * 18 Oct 2026  Maintainers     Added the continuous sweep test
+ * 18 Oct 2026  Maintainers     Added the exploration test
+ * 19 Oct 2026  Maintainers     Added the drive to a goal test
+ * 19 Oct 2026  Maintainers     Added the teach and repeat test
+ * 19 Oct 2026  Maintainers     Added the scan matching test
+ */
+#ifndef TESTING_IT_SIMULATION_H
+#define TESTING_IT_SIMULATION_H
+
+void IT_Simulation_test();
+void IT_Simulation_testBatch();
+void IT_Simulation_testReplay();
+void IT_Simulation_testFaults();
+void IT_Simulation_testUart();
+void IT_Simulation_testHc08();
+void IT_Simulation_testReaction();
+void IT_Simulation_testStall();
+void IT_Simulation_testDecay();
+void IT_Simulation_testCalibration();
+void IT_Simulation_testTrim();
+void IT_Simulation_testWarmRestart();
+void IT_Simulation_testSweep();
+void IT_Simulation_testExploration();
+void IT_Simulation_testGoTo();
+void IT_Simulation_testRoute();
+void IT_Simulation_testScanMatch();
+void IT_Simulation_testApproach();
+
+#endif //TESTING_IT_SIMULATION_H
@@ -13,6 +13,13 @@
  *      void    MOTOR_HAL_stop(Motor *motor)
  *      void    MOTOR_HAL_registerSpeedChangeCallback(Motor* motor, MotorSpeedCallback callback)
  *      void    MOTOR_HAL_registerDirectionChangeCallback(Motor* motor, MotorDirCallback callback)
+ *      void    MOTOR_HAL_enableCurrentSense()
+ *      void    MOTOR_HAL_registerCurrentCallback(Motor* motor, MotorCurrentCallback callback)
+ *      void    MOTOR_HAL_setDecayMode(Motor* motor, MotorDecay decay)
+ *      void    MOTOR_HAL_setCurve(Motor* motor, const MotorCurve *curve)
+ *      void    MOTOR_HAL_setTrim(Motor* motor, uint16_t trim)
+ *      void    MOTOR_HAL_triggerCurrentSample(MotorInitTemplate initTemplate, uint16_t current)
+ *      Motor*  MOTOR_HAL_getMotor(MotorInitTemplate initTemplate)
  *
  * NOTES:
  *
@@ -22,10 +29,19 @@
  *
  * CHANGES:
  * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Added access to the initialised motors for simulation
+ * 18 Oct 2026  Maintainers     Recording of the commanded speed and direction
+ * 18 Oct 2026  Maintainers     Tracing of the commanded speed and direction
+ * 18 Oct 2026  Maintainers     Current samples provided by the simulator
+ * 18 Oct 2026  Maintainers     Decay mode applied as by the firmware
+ * 18 Oct 2026  Maintainers     Speed to duty cycle curves
+ * 18 Oct 2026  Maintainers     Trim of the duty cycle
  */
 #include <stdio.h>
 
 #include "motor_hal.h"
+#include "../inc/recorder.h"
+#include "../inc/trace.h"
 
 #define MOTOR_TIMER_PERIOD 5000         /* Max value of the counter           */
 #define MOTOR_ENABLE_PORT 1             /* Port for the PWM signals           */
@@ -36,6 +52,33 @@
 #define MOTOR_R_IN2 2                   /* Right motor's direction pin 2      */
 #define MOTOR_L_IN1 3                   /* Left motor's direction pin 1       */
 #define MOTOR_L_IN2 4                   /* Left motor's direction pin 2       */
+#define MOTOR_DUTY_FULL 1000            /* Duty cycle at full speed (‰)       */
+#define MOTOR_SLOW_DECAY_DUTY 500       /* Duty under which MOTOR_DECAY_AUTO is slow (‰) */
+
+const Motor *motors[2] = {NULL, NULL};  /* Initialised motors, by template    */
+
+static void MOTOR_HAL_updateDecay(Motor *motor) {
+    motor->isSlowDecay =
+        motor->decay == MOTOR_DECAY_SLOW ||
+        (motor->decay == MOTOR_DECAY_AUTO && motor->duty < MOTOR_SLOW_DECAY_DUTY);
+}
+
+static void MOTOR_HAL_applyDuty(Motor *motor) {
+    uint8_t speed = motor->state.speed;
+    if (speed == 0) {
+        motor->duty = 0;
+    } else if (speed >= 100) {
+        motor->duty =
+            motor->curve == NULL ? MOTOR_DUTY_FULL : motor->curve->duty[MOTOR_CURVE_POINTS - 1];
+    } else if (motor->curve == NULL) {
+        motor->duty = speed * MOTOR_DUTY_FULL / 100;
+    } else {
+        const uint16_t *duty = &motor->curve->duty[speed / 10];
+        motor->duty = duty[0] + ((int32_t)duty[1] - duty[0]) * (speed % 10) / 10;
+    }
+    motor->duty = (uint32_t)motor->duty * motor->trim / MOTOR_TRIM_NONE;
+    MOTOR_HAL_updateDecay(motor);
+}
 
 void MOTOR_HAL_init() {
 }
@@ -54,14 +97,24 @@ void MOTOR_HAL_motorInit(Motor *motor, MotorInitTemplate initTemplate) {
     motor->state.direction = MOTOR_DIR_STOP;
     motor->speedCallback = NULL;
     motor->dirCallback = NULL;
+    motor->currentCallback = NULL;
+    motor->decay = MOTOR_DECAY_FAST;
+    motor->isSlowDecay = false;
+    motor->curve = NULL;
+    motor->trim = MOTOR_TRIM_NONE;
+    motor->duty = 0;
+    motors[initTemplate] = motor;
 }
 
 void MOTOR_HAL_setSpeed(Motor *motor, uint8_t speed) {
     if (motor->state.speed == speed)
         return;
+    RECORDER_RECORD(RECORDER_CHANNEL_MOTOR_SPEED, speed | (motor->in1_pin == MOTOR_R_IN1) << 8);
+    TRACE_INSTANT(TRACE_ID_MOTOR_SPEED, speed | (motor->in1_pin == MOTOR_R_IN1) << 8);
 
     // Update motor info
     motor->state.speed = speed;
+    MOTOR_HAL_applyDuty(motor);
 
     // Notify the state change
     if (motor->speedCallback != NULL)
@@ -71,11 +124,15 @@ void MOTOR_HAL_setSpeed(Motor *motor, uint8_t speed) {
 void MOTOR_HAL_setDirection(Motor *motor, MotorDirection direction) {
     if (motor->state.direction == direction)
         return;
+    RECORDER_RECORD(RECORDER_CHANNEL_MOTOR_DIRECTION,
+                    direction | (motor->in1_pin == MOTOR_R_IN1) << 8);
+    TRACE_INSTANT(TRACE_ID_MOTOR_DIRECTION, direction | (motor->in1_pin == MOTOR_R_IN1) << 8);
 
     // Update direction and speed
     motor->state.direction = direction;
     if (direction == MOTOR_DIR_STOP)
         motor->state.speed = 0;
+    MOTOR_HAL_applyDuty(motor);
 
     // Notify the state change
     if (motor->dirCallback != NULL)
@@ -90,4 +147,33 @@ void MOTOR_HAL_registerSpeedChangeCallback(Motor *motor, MotorSpeedCallback call
 
 void MOTOR_HAL_registerDirectionChangeCallback(Motor *motor, MotorDirCallback callback) {
     motor->dirCallback = callback;
-}
\ No newline at end of file
+}
+
+void MOTOR_HAL_enableCurrentSense() {}
+
+void MOTOR_HAL_registerCurrentCallback(Motor *motor, MotorCurrentCallback callback) {
+    motor->currentCallback = callback;
+}
+
+void MOTOR_HAL_setDecayMode(Motor *motor, MotorDecay decay) {
+    motor->decay = decay;
+    MOTOR_HAL_updateDecay(motor);
+}
+
+void MOTOR_HAL_setCurve(Motor *motor, const MotorCurve *curve) {
+    motor->curve = curve;
+    MOTOR_HAL_applyDuty(motor);
+}
+
+void MOTOR_HAL_setTrim(Motor *motor, uint16_t trim) {
+    motor->trim = trim > MOTOR_TRIM_NONE ? MOTOR_TRIM_NONE : trim;
+    MOTOR_HAL_applyDuty(motor);
+}
+
+void MOTOR_HAL_triggerCurrentSample(MotorInitTemplate initTemplate, uint16_t current) {
+    Motor *motor = (Motor *)motors[initTemplate];
+    if (motor != NULL && motor->currentCallback != NULL)
+        motor->currentCallback(motor, current);
+}
+
+const Motor *MOTOR_HAL_getMotor(MotorInitTemplate initTemplate) { return motors[initTemplate]; }
@@ -13,6 +13,13 @@
  *      void    MOTOR_HAL_stop(Motor *motor)
  *      void    MOTOR_HAL_registerSpeedChangeCallback(Motor* motor, MotorSpeedCallback callback)
  *      void    MOTOR_HAL_registerDirectionChangeCallback(Motor* motor, MotorDirCallback callback)
+ *      void    MOTOR_HAL_enableCurrentSense()
+ *      void    MOTOR_HAL_registerCurrentCallback(Motor* motor, MotorCurrentCallback callback)
+ *      void    MOTOR_HAL_setDecayMode(Motor* motor, MotorDecay decay)
+ *      void    MOTOR_HAL_setCurve(Motor* motor, const MotorCurve *curve)
+ *      void    MOTOR_HAL_setTrim(Motor* motor, uint16_t trim)
+ *      void    MOTOR_HAL_triggerCurrentSample(MotorInitTemplate initTemplate, uint16_t current)
+ *      Motor*  MOTOR_HAL_getMotor(MotorInitTemplate initTemplate)
  *
  * NOTES:
  *      In our implementation there are two motors attached to each of the L298N channels, so we
@@ -27,7 +34,13 @@
  * 04 Feb 2024  Andrea Piccin   Refactoring
  * 04 Feb 2024  Andrea Piccin   Definitions moved to the source file, hidden to the user
  * 11 Feb 2024  Andrea Piccin   Introduced callback mechanism for state change notification
+ * 18 Oct 2026  Maintainers     Added access to the initialised motors for simulation
+ * 18 Oct 2026  Maintainers     Added the current sense of the channels
+ * 18 Oct 2026  Maintainers     Added the slow decay drive mode
+ * 18 Oct 2026  Maintainers     Added the speed to duty cycle curves
+ * 18 Oct 2026  Maintainers     Added the trim of the duty cycle
  */
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifndef MOTOR_HAL_H
@@ -61,6 +74,39 @@ typedef enum { MOTOR_DIR_FORWARD, MOTOR_DIR_REVERSE, MOTOR_DIR_STOP } MotorDirec
  */
 typedef enum { MOTOR_INIT_LEFT, MOTOR_INIT_RIGHT } MotorInitTemplate;
 
+/*T************************************************************************************************
+ * NAME: MotorDecay
+ *
+ * DESCRIPTION:
+ *      Represent the way the current of a motor decays during the off-time of the PWM.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: MOTOR_DECAY_FAST    PWM on the enable pin, the motor coasts in the off-time
+ *              MOTOR_DECAY_SLOW    PWM on the input pin, the motor is braked in the off-time
+ *              MOTOR_DECAY_AUTO    Slow decay at low speed, fast decay above
+ */
+typedef enum { MOTOR_DECAY_FAST, MOTOR_DECAY_SLOW, MOTOR_DECAY_AUTO } MotorDecay;
+
+#define MOTOR_CURVE_POINTS 11 /* Points of a speed curve, every 10% from 0% to 100% */
+#define MOTOR_TRIM_NONE 1000  /* Trim that applies the whole duty cycle (‰)          */
+
+/*T************************************************************************************************
+ * NAME: MotorCurve
+ *
+ * DESCRIPTION:
+ *      Represent the piecewise-linear mapping from the requested speed to the duty cycle of a
+ *      motor, the point i gives the duty cycle at which the motor turns at i * 10% of its top
+ *      speed. The first point is the duty cycle at which the motor starts to turn.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint16_t[]      duty        Duty cycle of each point (‰), non decreasing
+ */
+typedef struct {
+    uint16_t duty[MOTOR_CURVE_POINTS];
+} MotorCurve;
+
 /*T************************************************************************************************
  * NAME: MotorState
  *
@@ -111,6 +157,19 @@ typedef void (*MotorSpeedCallback)(Motor *motor, uint8_t speed);
  */
 typedef void (*MotorDirCallback)(Motor *motor, MotorDirection direction);
 
+/*T************************************************************************************************
+ * NAME: MotorCurrentCallback
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that it's invoked with every current sample of the motor.
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Args:   Motor*      motor       Sampled motor
+ *              uint16_t    current     Current drawn during the on-time of the PWM (mA)
+ */
+typedef void (*MotorCurrentCallback)(Motor *motor, uint16_t current);
+
 /*S************************************************************************************************
  * NAME: MotorStruct
  *
@@ -132,6 +191,12 @@ struct MotorStruct {
     MotorState state;
     MotorSpeedCallback speedCallback;
     MotorDirCallback dirCallback;
+    MotorCurrentCallback currentCallback;
+    MotorDecay decay;
+    bool isSlowDecay;
+    const MotorCurve *curve;
+    uint16_t trim;
+    uint16_t duty;
 };
 
 /*F************************************************************************************************
@@ -297,4 +362,180 @@ void MOTOR_HAL_registerSpeedChangeCallback(Motor *motor, MotorSpeedCallback call
  */
 void MOTOR_HAL_registerDirectionChangeCallback(Motor *motor, MotorDirCallback callback);
 
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_enableCurrentSense()
+ *
+ * DESCRIPTION:
+ *      Starts the sampling of the current of both channels, once per PWM period in the middle of
+ *      the on-time, on the ADC inputs wired to the sense resistors of the L298N.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The ADC is shared with the battery, so it must be called after BATTERY_HAL_init. It has
+ *      no effect unless the firmware is built with STALL_ENABLED.
+ */
+void MOTOR_HAL_enableCurrentSense();
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_registerCurrentCallback(Motor* motor, MotorCurrentCallback callback)
+ *
+ * DESCRIPTION:
+ *      Registers the given MotorCurrentCallback as the function to call with every current
+ *      sample of the specified motor.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*                  motor       Specifies the target motor
+ *          MotorCurrentCallback    callback    The function to register as callback
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The callback runs in interrupt context, while the motor is stopped no sample is taken.
+ */
+void MOTOR_HAL_registerCurrentCallback(Motor *motor, MotorCurrentCallback callback);
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_setDecayMode(Motor* motor, MotorDecay decay)
+ *
+ * DESCRIPTION:
+ *      Selects how the L298N drives the motor during the off-time of the PWM: fast decay lets the
+ *      current collapse through the diodes, slow decay keeps it circulating in the bridge.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*          motor           Specifies the target motor
+ *          MotorDecay      decay           Decay mode of the motor
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          MotorDecay      motor->decay    Set to the given mode
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The mock always applies the mode, as the firmware built with SLOW_DECAY_ENABLED.
+ */
+void MOTOR_HAL_setDecayMode(Motor *motor, MotorDecay decay);
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_setCurve(Motor* motor, const MotorCurve *curve)
+ *
+ * DESCRIPTION:
+ *      Sets the curve that maps the requested speed of a motor to its duty cycle, so that the
+ *      speed of the wheels is proportional to the requested one, and applies it at the current
+ *      speed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*              motor           Specifies the target motor
+ *          const MotorCurve*   curve           Speed curve, NULL to map the speed linearly
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          const MotorCurve*   motor->curve    Set to the given curve
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The mock keeps the duty cycle in the motor, a simulator reads it to move the car.
+ */
+void MOTOR_HAL_setCurve(Motor *motor, const MotorCurve *curve);
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_setTrim(Motor* motor, uint16_t trim)
+ *
+ * DESCRIPTION:
+ *      Sets the fraction of the duty cycle of the curve that is applied to a motor, so that a
+ *      faster motor can be slowed down to match the other one, and applies it at the current
+ *      speed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Motor*          motor           Specifies the target motor
+ *          uint16_t        trim            Applied fraction (‰), MOTOR_TRIM_NONE for the whole
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          uint16_t        motor->trim     Set to the given trim
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void MOTOR_HAL_setTrim(Motor *motor, uint16_t trim);
+
+/*F************************************************************************************************
+ * NAME: void MOTOR_HAL_triggerCurrentSample(MotorInitTemplate initTemplate, uint16_t current)
+ *
+ * DESCRIPTION:
+ *      Delivers a current sample to the callback of the last motor initialised with the given
+ *      template, as the interrupt of the ADC would do.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          MotorInitTemplate   initTemplate    Channel of the sampled motor
+ *          uint16_t            current         Simulated current (mA)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void MOTOR_HAL_triggerCurrentSample(MotorInitTemplate initTemplate, uint16_t current);
+
+/*F************************************************************************************************
+ * NAME: const Motor *MOTOR_HAL_getMotor(MotorInitTemplate initTemplate)
+ *
+ * DESCRIPTION:
+ *      Returns the last motor initialised with the given template, it allows a simulator to read
+ *      the speed and direction applied to each channel.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          MotorInitTemplate   initTemplate    Channel of the wanted motor
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   const Motor*
+ *          Value:  The motor of the given channel, NULL if not initialised yet
+ *
+ *  NOTE:
+ */
+const Motor *MOTOR_HAL_getMotor(MotorInitTemplate initTemplate);
+
 #endif // MOTOR_HAL_H
\ No newline at end of file
@@ -7,9 +7,13 @@
  *
  * PUBLIC FUNCTIONS:
  *      void    SERVO_HAL_init(Servo* servo)
+ *      void    SERVO_HAL_resume(Servo* servo, int8_t position)
  *      void    SERVO_HAL_setPosition(Servo* servo, int8_t position)
  *      void    SERVO_HAL_registerPositionReachedCallback(ServoCallback callback)
  *      void    SERVO_HAL_triggerPositionReached()
+ *      void    SERVO_HAL_registerPositionHook(ServoHook hook)
+ *      void    SERVO_HAL_sweepTo(Servo* servo, int8_t position)
+ *      int8_t  SERVO_HAL_getAngle(const Servo* servo, uint32_t ticks)
  *
  * NOTES:
  *      The PWM timings are calculated basing on the SG90 datasheet:
@@ -22,10 +26,19 @@
  *
  * CHANGES:
  * DATE         AUTHOR              DETAIL
+ * 18 Oct 2026  Maintainers         Travel time through the shared timer, simulation hook
+ * 18 Oct 2026  Maintainers         Recording of the commanded position
+ * 18 Oct 2026  Maintainers         Tracing of the commanded position
+ * 18 Oct 2026  Maintainers         Resume without homing after a warm reset
+ * 18 Oct 2026  Maintainers         Continuous sweep and motion model
  */
+#include <stdbool.h>
 #include <stdlib.h>
 
 #include "servo_hal.h"
+#include "timer_hal.h"
+#include "../inc/recorder.h"
+#include "../inc/trace.h"
 
 #define SERVO_PORT GPIO_PORT_P5    /* Port for the PWM signals                                */
 #define SERVO_PIN GPIO_PIN6        /* Pin for the PWM signals                                 */
@@ -40,12 +53,35 @@
  * a full rotation in which the correction coefficient is already applied */
 #define SERVO_ADJ_180DEG_TICKS (SERVO_180DEG_TICKS * SERVO_LOAD_COEFFICIENT)
 
-ServoCallback servoCallback; /* function to execute when the servo reaches its final position */
+ServoCallback servoCallback;   /* function to execute when the servo reaches its final position */
+ServoHook servoHook = NULL;    /* function to execute when a new position is commanded         */
+
+void SERVO_HAL_onTimerEnded();
+static void SERVO_HAL_startMotion(Servo *servo, int8_t position);
 
 void SERVO_HAL_init(Servo *servo) {
     servo->ccr = 1;
     servoCallback = NULL;
     servo->state.position = 0;
+    servo->state.origin = 0;
+    servo->state.startTicks = TIMER_HAL_getTicks();
+    if (servoHook != NULL)
+        servoHook(0);
+}
+
+void SERVO_HAL_resume(Servo *servo, int8_t position) {
+    if (position < SERVO_MIN_POSITION)
+        position = SERVO_MIN_POSITION;
+
+    if (position > SERVO_MAX_POSITION)
+        position = SERVO_MAX_POSITION;
+    servo->ccr = 1;
+    servoCallback = NULL;
+    servo->state.position = position;
+    servo->state.origin = position;
+    servo->state.startTicks = TIMER_HAL_getTicks();
+    if (servoHook != NULL)
+        servoHook(position);
 }
 
 uint16_t SERVO_HAL_positionToTicks(int8_t position) {
@@ -64,8 +100,20 @@ void SERVO_HAL_setPosition(Servo *servo, int8_t position) {
 
     if (position > SERVO_MAX_POSITION)
         position = SERVO_MAX_POSITION;
+    RECORDER_RECORD(RECORDER_CHANNEL_SERVO, (uint8_t)position);
+    TRACE_INSTANT(TRACE_ID_SERVO, (uint8_t)position);
 
-    servo->state.position = position;
+    if (servoHook != NULL)
+        servoHook(position);
+
+    if (servo->state.position == position && servoCallback != NULL) {
+        servoCallback();
+    } else {
+        uint32_t ticks =
+            (abs(position - servo->state.position) * 1.0 / 180) * SERVO_ADJ_180DEG_TICKS;
+        SERVO_HAL_startMotion(servo, position);
+        TIMER_HAL_acquireSharedTimer(ticks, SERVO_HAL_onTimerEnded);
+    }
 }
 
 void SERVO_HAL_registerPositionReachedCallback(ServoCallback callback) { servoCallback = callback; }
@@ -76,5 +124,55 @@ void SERVO_HAL_triggerPositionReached() {
 }
 
 void SERVO_HAL_resetPosition(Servo* servo){
-    servo->state.position = 0;
-}
\ No newline at end of file
+    SERVO_HAL_startMotion(servo, 0);
+    if (servoHook != NULL)
+        servoHook(0);
+}
+
+void SERVO_HAL_registerPositionHook(ServoHook hook) { servoHook = hook; }
+
+void SERVO_HAL_onTimerEnded() {
+    TIMER_HAL_releaseSharedTimer();
+    if (servoCallback != NULL)
+        servoCallback();
+}
+
+void SERVO_HAL_sweepTo(Servo *servo, int8_t position) {
+    if (position < SERVO_MIN_POSITION)
+        position = SERVO_MIN_POSITION;
+
+    if (position > SERVO_MAX_POSITION)
+        position = SERVO_MAX_POSITION;
+    RECORDER_RECORD(RECORDER_CHANNEL_SERVO, (uint8_t)position);
+    TRACE_INSTANT(TRACE_ID_SERVO, (uint8_t)position);
+
+    if (servoHook != NULL)
+        servoHook(position);
+    SERVO_HAL_startMotion(servo, position);
+}
+
+int8_t SERVO_HAL_getAngle(const Servo *servo, uint32_t ticks) {
+    int32_t elapsed = (int32_t)(ticks - servo->state.startTicks);
+    int16_t travel = servo->state.position - servo->state.origin;
+    if (elapsed <= 0)
+        return servo->state.origin;
+    if (elapsed >= SERVO_ADJ_180DEG_TICKS)
+        return servo->state.position;
+
+    int16_t swept = elapsed * 180 / SERVO_ADJ_180DEG_TICKS;
+    if (swept >= abs(travel))
+        return servo->state.position;
+    return servo->state.origin + (travel > 0 ? swept : -swept);
+}
+
+static void SERVO_HAL_startMotion(Servo *servo, int8_t position) {
+    uint32_t now = TIMER_HAL_getTicks();
+    int8_t angle = SERVO_HAL_getAngle(servo, now);
+    int16_t travel = servo->state.position - servo->state.origin;
+    bool isMoving = angle != servo->state.position;
+    if (!isMoving || (position - angle) * travel <= 0) {
+        servo->state.origin = angle;
+        servo->state.startTicks = now;
+    }
+    servo->state.position = position;
+}
@@ -6,9 +6,13 @@
  *
  * PUBLIC FUNCTIONS:
  *      void    SERVO_HAL_init(Servo* servo);
+ *      void    SERVO_HAL_resume(Servo* servo, int8_t position);
  *      void    SERVO_HAL_setPosition(Servo* servo, int8_t position);
  *      void    SERVO_HAL_registerPositionReachedCallback(ServoCallback callback);
+ *      void    SERVO_HAL_sweepTo(Servo* servo, int8_t position);
+ *      int8_t  SERVO_HAL_getAngle(const Servo* servo, uint32_t ticks);
  *      void    SERVO_HAL_triggerPositionReached();
+ *      void    SERVO_HAL_registerPositionHook(ServoHook hook);
  *
  * NOTES:
  *
@@ -22,6 +26,9 @@
  * 15 Feb 2024  Matteo Frizzera     Added functions to wait for servo to finish moving
  * 16 Feb 2024  Andrea Piccin       Refactoring, MIN and MAX position moved to header file
  * 19 Feb 2024  Simone Rossi        Changed for testing
+ * 18 Oct 2026  Maintainers         Travel time through the shared timer, simulation hook
+ * 18 Oct 2026  Maintainers         Resume without homing after a warm reset
+ * 18 Oct 2026  Maintainers         Continuous sweep and motion model
  */
 #include <stdint.h>
 
@@ -43,6 +50,19 @@
  */
 typedef void (*ServoCallback)();
 
+/*T************************************************************************************************
+ * NAME: ServoHook
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that executes every time a new position is commanded, it
+ *      allows a simulator to follow the servo.
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Args:   int8_t      position    Commanded position in deg
+ */
+typedef void (*ServoHook)(int8_t position);
+
 /*T************************************************************************************************
  * NAME: ServoState
  *
@@ -52,9 +72,13 @@ typedef void (*ServoCallback)();
  * SPECIFICATIONS:
  *      Type:   struct
  *      Vars:   uint8_t         position    Current position of the servo
+ *              int8_t          origin      Position of the servo when the position was commanded
+ *              uint32_t        startTicks  Ticks of the timer HAL when the position was commanded
  */
 typedef struct {
     int8_t position;
+    int8_t origin;
+    uint32_t startTicks;
 } ServoState;
 
 /*T************************************************************************************************
@@ -96,6 +120,30 @@ typedef struct {
  */
 void SERVO_HAL_init(Servo *servo);
 
+/*F************************************************************************************************
+ * NAME: void SERVO_HAL_resume(Servo* servo, int8_t position);
+ *
+ * DESCRIPTION:
+ *      Initialises a Servo motor instance that is already at the given position, after a warm
+ *      reset, without waiting for it to travel.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Servo*              servo           Motor that has to be initialised
+ *          int8_t              position        Position commanded before the reset
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          Servo*              servo           All the fields of the struct are set
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SERVO_HAL_resume(Servo *servo, int8_t position);
+
 /*F************************************************************************************************
  * NAME: void SERVO_HAL_setPosition(Servo* servo, int8_t position);
  *
@@ -119,6 +167,57 @@ void SERVO_HAL_init(Servo *servo);
  */
 void SERVO_HAL_setPosition(Servo *servo, int8_t position);
 
+/*F************************************************************************************************
+ * NAME: void SERVO_HAL_sweepTo(Servo* servo, int8_t position);
+ *
+ * DESCRIPTION:
+ *      Set the position of a servo without notifying when it is reached, the servo keeps moving
+ *      while the next position is commanded.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Servo*      servo                   Target servo
+ *          int8_t      position                Specifies the position to which rotate.
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          ServoState  servo->state            Set on the new motion
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SERVO_HAL_sweepTo(Servo *servo, int8_t position);
+
+/*F************************************************************************************************
+ * NAME: int8_t SERVO_HAL_getAngle(const Servo* servo, uint32_t ticks);
+ *
+ * DESCRIPTION:
+ *      Returns the angle of a servo at a given time, interpolated by the motion model: the servo
+ *      turns at constant speed from the origin to the commanded position.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const Servo*    servo               Target servo
+ *          uint32_t        ticks               Time, in ticks of the timer HAL
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int8_t
+ *          Value:  Angle of the servo (deg), the origin before the command
+ *
+ *  NOTE:
+ */
+int8_t SERVO_HAL_getAngle(const Servo *servo, uint32_t ticks);
+
 /*F************************************************************************************************
  * NAME: void SERVO_HAL_registerPositionReachedCallback(ServoCallback callback)
  *
@@ -145,4 +244,26 @@ void SERVO_HAL_triggerPositionReached();
 
 void SERVO_HAL_resetPosition(Servo* servo);
 
+/*F************************************************************************************************
+ * NAME: void SERVO_HAL_registerPositionHook(ServoHook hook)
+ *
+ * DESCRIPTION:
+ *      Registers the function to call every time a new position is commanded.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          ServoHook       hook            The function to register, NULL to remove it
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SERVO_HAL_registerPositionHook(ServoHook hook);
+
 #endif // SERVO_HAL_H
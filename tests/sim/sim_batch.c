@@ -0,0 +1,301 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_batch.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the execution of many independent simulations on all the cores
+ *      of the host and the aggregation of their metrics.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        SIM_BATCH_runScenario(const SimScenario *scenario, SimStats *stats)
+ *      uint32_t    SIM_BATCH_run(const SimScenario *scenarios, uint32_t count,
+ *                                uint16_t workers, SimResult *results)
+ *      SimSummary  SIM_BATCH_summarise(const SimResult *results, uint32_t count)
+ *      uint16_t    SIM_BATCH_defaultWorkers()
+ *
+ * NOTES:
+ *      The records sent through the pipes are smaller than PIPE_BUF, so every write is atomic.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Faults and command latency
+ */
+#include <math.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "sim_batch.h"
+#include "sim_clock.h"
+#include "../infrared_hal.h"
+
+/*T************************************************************************************************
+ * NAME: SimRecord
+ *
+ * DESCRIPTION:
+ *      Represent the message sent by a worker process for every completed scenario.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    index       Position of the scenario in the batch
+ *              SimStats    stats       Metrics of the simulation
+ */
+typedef struct {
+    uint32_t index;
+    SimStats stats;
+} SimRecord;
+
+/*T************************************************************************************************
+ * NAME: SimWorker
+ *
+ * DESCRIPTION:
+ *      Represent a running worker process.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   pid_t       pid         Process identifier, 0 if the slot is free
+ *              int         fd          Read end of the pipe
+ */
+typedef struct {
+    pid_t pid;
+    int fd;
+} SimWorker;
+
+void SIM_BATCH_runScenario(const SimScenario *scenario, SimStats *stats) {
+    // [1] Room and random obstacles, static because a world is too large for the stack
+    static SimWorld world;
+    SimRandom random;
+    world = *scenario->world;
+    world.start.heading = scenario->startHeading;
+    SIM_RANDOM_seed(&random, scenario->seed);
+    SIM_WORLD_addRandomBoxes(&world, scenario->obstacles, SIM_BATCH_OBSTACLE_MARGIN, &random);
+
+    // [2] Parameters, boot and faults
+    parameters = scenario->parameters;
+    SIM_CAR_init(&world, &scenario->params, SIM_RANDOM_next(&random));
+    SIM_FAULT_init(scenario->faults, SIM_RANDOM_next(&random));
+
+    // [3] Autonomous mode, the command can be lost or late like the one of a real remote
+    uint64_t sent = SIM_CLOCK_now();
+    uint64_t lastSent = sent;
+    SIM_FAULT_sendIRCommand(IR_COMMAND_ASTERISK);
+    while (FSM_currentState == STATE_REMOTE && SIM_CLOCK_now() - sent < SIM_BATCH_COMMAND_TIMEOUT) {
+        SIM_CAR_run(SIM_BATCH_COMMAND_STEP);
+        if (FSM_currentState == STATE_REMOTE &&
+            SIM_CLOCK_now() - lastSent >= SIM_BATCH_COMMAND_RETRY) {
+            lastSent = SIM_CLOCK_now();
+            SIM_FAULT_sendIRCommand(IR_COMMAND_ASTERISK);
+        }
+    }
+    uint64_t commandLatency = SIM_CLOCK_now() - sent;
+
+    // [4] Simulation
+    SIM_CAR_run(scenario->duration);
+    *stats = SIM_CAR_getStats();
+    stats->commandLatency = commandLatency;
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_BATCH_worker(const SimScenario *scenarios, uint32_t first, uint32_t last, int fd)
+ *
+ * DESCRIPTION:
+ *      Body of a worker process, executes a range of scenarios and sends a record for each one.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimScenario*  scenarios   Scenarios of the batch
+ *          uint32_t            first       First scenario to execute
+ *          uint32_t            last        Scenario after the last one to execute
+ *          int                 fd          Write end of the pipe
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It never returns.
+ */
+static void SIM_BATCH_worker(const SimScenario *scenarios, uint32_t first, uint32_t last, int fd) {
+    for (uint32_t i = first; i < last; i++) {
+        SimRecord record;
+        record.index = i;
+        SIM_BATCH_runScenario(&scenarios[i], &record.stats);
+        if (write(fd, &record, sizeof(record)) != sizeof(record))
+            _exit(EXIT_FAILURE);
+    }
+    _exit(EXIT_SUCCESS);
+}
+
+static bool SIM_BATCH_readRecord(int fd, SimRecord *record) {
+    size_t received = 0;
+    while (received < sizeof(*record)) {
+        ssize_t n = read(fd, (char *)record + received, sizeof(*record) - received);
+        if (n <= 0)
+            return false;
+        received += n;
+    }
+    return true;
+}
+
+uint32_t SIM_BATCH_run(const SimScenario *scenarios, uint32_t count, uint16_t workers,
+                       SimResult *results) {
+    if (workers == 0)
+        workers = 1;
+
+    SimWorker pool[workers];
+    struct pollfd fds[workers];
+    for (uint16_t w = 0; w < workers; w++)
+        pool[w].pid = 0;
+    for (uint32_t i = 0; i < count; i++)
+        results[i].isValid = false;
+
+    uint32_t next = 0;
+    uint32_t valid = 0;
+    uint16_t active = 0;
+    fflush(NULL); // the children must not flush the buffers of the parent
+    while (next < count || active > 0) {
+        // [1] Fork a worker for the next chunk in every free slot
+        for (uint16_t w = 0; w < workers && next < count; w++) {
+            int pipeFds[2];
+            if (pool[w].pid != 0 || pipe(pipeFds) != 0)
+                continue;
+
+            uint32_t last = next + SIM_BATCH_CHUNK < count ? next + SIM_BATCH_CHUNK : count;
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(pipeFds[0]);
+                SIM_BATCH_worker(scenarios, next, last, pipeFds[1]);
+            }
+            close(pipeFds[1]);
+            if (pid < 0) {
+                close(pipeFds[0]);
+                break;
+            }
+            pool[w].pid = pid;
+            pool[w].fd = pipeFds[0];
+            next = last;
+            active++;
+        }
+        if (active == 0)
+            break; // fork is failing, nothing more can be done
+
+        // [2] Wait for records or terminations
+        for (uint16_t w = 0; w < workers; w++) {
+            fds[w].fd = pool[w].pid != 0 ? pool[w].fd : -1;
+            fds[w].events = POLLIN;
+            fds[w].revents = 0;
+        }
+        if (poll(fds, workers, -1) < 0)
+            continue;
+
+        // [3] Collect the results, a closed pipe means that the worker has terminated
+        for (uint16_t w = 0; w < workers; w++) {
+            if (pool[w].pid == 0 || fds[w].revents == 0)
+                continue;
+
+            SimRecord record;
+            if (SIM_BATCH_readRecord(pool[w].fd, &record)) {
+                if (record.index < count && !results[record.index].isValid) {
+                    results[record.index].isValid = true;
+                    results[record.index].stats = record.stats;
+                    valid++;
+                }
+            } else {
+                close(pool[w].fd);
+                waitpid(pool[w].pid, NULL, 0);
+                pool[w].pid = 0;
+                active--;
+            }
+        }
+    }
+    return valid;
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_BATCH_addSample(SimMetric *metric, double sample, double *squares)
+ *
+ * DESCRIPTION:
+ *      Updates a metric with a new sample using the Welford algorithm.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimMetric*  metric      Metric to update
+ *          double      sample      New sample
+ *          double*     squares     Running sum of the squared differences from the mean
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimMetric*  metric      Count, mean and max are updated
+ *          double*     squares     Updated sum
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The standard deviation is computed from the squares at the end.
+ */
+static void SIM_BATCH_addSample(SimMetric *metric, double sample, double *squares) {
+    double delta = sample - metric->mean;
+    metric->count++;
+    metric->mean += delta / metric->count;
+    *squares += delta * (sample - metric->mean);
+    if (metric->count == 1 || sample > metric->max)
+        metric->max = sample;
+}
+
+static void SIM_BATCH_finalise(SimMetric *metric, double squares) {
+    metric->stddev = metric->count > 1 ? sqrt(squares / (metric->count - 1)) : 0;
+}
+
+SimSummary SIM_BATCH_summarise(const SimResult *results, uint32_t count) {
+    SimSummary summary = {0};
+    double squares[8] = {0};
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (!results[i].isValid) {
+            summary.failures++;
+            continue;
+        }
+
+        const SimStats *stats = &results[i].stats;
+        double elapsed = stats->elapsed > 0 ? stats->elapsed : 1;
+        summary.runs++;
+        SIM_BATCH_addSample(&summary.speed, stats->distance * 1e6 / elapsed, &squares[0]);
+        SIM_BATCH_addSample(&summary.distance, stats->distance, &squares[1]);
+        SIM_BATCH_addSample(&summary.collisions, stats->collisions, &squares[2]);
+        SIM_BATCH_addSample(&summary.sensing, stats->timeInState[STATE_SENSING] * 100 / elapsed,
+                            &squares[3]);
+        SIM_BATCH_addSample(&summary.turning, stats->timeInState[STATE_TURNING] * 100 / elapsed,
+                            &squares[4]);
+        if (stats->decisions > 0)
+            SIM_BATCH_addSample(&summary.latency,
+                                stats->decisionTime / 1e3 / stats->decisions, &squares[5]);
+        SIM_BATCH_addSample(&summary.command, stats->commandLatency / 1e3, &squares[6]);
+        SIM_BATCH_addSample(&summary.faults, stats->faults, &squares[7]);
+    }
+
+    SIM_BATCH_finalise(&summary.speed, squares[0]);
+    SIM_BATCH_finalise(&summary.distance, squares[1]);
+    SIM_BATCH_finalise(&summary.collisions, squares[2]);
+    SIM_BATCH_finalise(&summary.sensing, squares[3]);
+    SIM_BATCH_finalise(&summary.turning, squares[4]);
+    SIM_BATCH_finalise(&summary.latency, squares[5]);
+    SIM_BATCH_finalise(&summary.command, squares[6]);
+    SIM_BATCH_finalise(&summary.faults, squares[7]);
+    return summary;
+}
+
+uint16_t SIM_BATCH_defaultWorkers() {
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    return processors > 0 ? processors : 1;
+}
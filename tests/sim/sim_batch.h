@@ -0,0 +1,251 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_batch.h
+ *
+ * DESCRIPTION:
+ *      This header provides the execution of many independent simulations on all the cores of the
+ *      host and the aggregation of their metrics.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        SIM_BATCH_runScenario(const SimScenario *scenario, SimStats *stats)
+ *      uint32_t    SIM_BATCH_run(const SimScenario *scenarios, uint32_t count,
+ *                                uint16_t workers, SimResult *results)
+ *      SimSummary  SIM_BATCH_summarise(const SimResult *results, uint32_t count)
+ *      uint16_t    SIM_BATCH_defaultWorkers()
+ *
+ * NOTES:
+ *      The application modules keep their state in global variables, so a simulation cannot share
+ *      the address space with another one. Every batch of scenarios is executed by a forked
+ *      process that owns a private copy of the globals and sends the metrics back through a pipe;
+ *      a scenario that crashes (e.g. a failed assert) only invalidates its own results.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Faults in the scenarios and command latency in the summary
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sim_car.h"
+#include "sim_fault.h"
+#include "sim_world.h"
+#include "../../inc/parameters.h"
+
+#ifndef SIM_BATCH_H
+#define SIM_BATCH_H
+
+#define SIM_BATCH_CHUNK 8                 /* Scenarios executed by a single forked process     */
+#define SIM_BATCH_OBSTACLE_MARGIN 30      /* Free space around the random obstacles (cm)       */
+#define SIM_BATCH_COMMAND_STEP 1000       /* Checks of the autonomous command (µs)             */
+#define SIM_BATCH_COMMAND_RETRY 300000    /* Time before the command is sent again (µs)        */
+#define SIM_BATCH_COMMAND_TIMEOUT 5000000 /* Time after which the command is given up (µs)     */
+
+/*T************************************************************************************************
+ * NAME: SimScenario
+ *
+ * DESCRIPTION:
+ *      Represent a simulated course: the room, the random obstacles and the car.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   const SimWorld*     world           Room, the obstacles are added to a copy of it
+ *              uint16_t            obstacles       Number of random boxes to scatter in the room
+ *              double              startHeading    Initial heading of the car (rad)
+ *              SimCarParams        params          Physical characteristics of the car
+ *              Parameters          parameters      Tunable constants of the application
+ *              uint64_t            seed            Seed of obstacles and measurement noise
+ *              uint64_t            duration        Simulated time in autonomous mode (µs)
+ *              const SimFaultConfig* faults        Injected faults, NULL for none
+ */
+typedef struct {
+    const SimWorld *world;
+    uint16_t obstacles;
+    double startHeading;
+    SimCarParams params;
+    Parameters parameters;
+    uint64_t seed;
+    uint64_t duration;
+    const SimFaultConfig *faults;
+} SimScenario;
+
+/*T************************************************************************************************
+ * NAME: SimResult
+ *
+ * DESCRIPTION:
+ *      Represent the outcome of a scenario.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   bool        isValid     False if the simulation crashed
+ *              SimStats    stats       Metrics of the simulation
+ */
+typedef struct {
+    bool isValid;
+    SimStats stats;
+} SimResult;
+
+/*T************************************************************************************************
+ * NAME: SimMetric
+ *
+ * DESCRIPTION:
+ *      Represent the statistics of a metric over a set of scenarios.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    count       Number of samples
+ *              double      mean        Sample mean
+ *              double      stddev      Sample standard deviation
+ *              double      max         Largest sample
+ */
+typedef struct {
+    uint32_t count;
+    double mean;
+    double stddev;
+    double max;
+} SimMetric;
+
+/*T************************************************************************************************
+ * NAME: SimSummary
+ *
+ * DESCRIPTION:
+ *      Represent the key performance indicators of a batch.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    runs            Valid scenarios
+ *              uint32_t    failures        Crashed scenarios
+ *              SimMetric   speed           Mean speed (cm/s)
+ *              SimMetric   distance        Distance covered (cm)
+ *              SimMetric   collisions      Collisions per scenario
+ *              SimMetric   sensing         Share of time in STATE_SENSING (%)
+ *              SimMetric   turning         Share of time in STATE_TURNING (%)
+ *              SimMetric   latency         Mean decision latency of a scenario (ms)
+ *              SimMetric   command         Time to execute the autonomous command (ms)
+ *              SimMetric   faults          Injected faults per scenario
+ */
+typedef struct {
+    uint32_t runs;
+    uint32_t failures;
+    SimMetric speed;
+    SimMetric distance;
+    SimMetric collisions;
+    SimMetric sensing;
+    SimMetric turning;
+    SimMetric latency;
+    SimMetric command;
+    SimMetric faults;
+} SimSummary;
+
+/*F************************************************************************************************
+ * NAME: void SIM_BATCH_runScenario(const SimScenario *scenario, SimStats *stats)
+ *
+ * DESCRIPTION:
+ *      Executes a scenario in the calling process:
+ *      [1] Copies the room and scatters the random obstacles
+ *      [2] Loads the parameters, boots the application and enables the faults
+ *      [3] Sends the autonomous command, again every SIM_BATCH_COMMAND_RETRY until it is executed
+ *      [4] Simulates for the requested time
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimScenario*  scenario    Scenario to execute
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimStats*           stats       Metrics of the simulation
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      Without faults the command is executed at once and the course is the same as before.
+ */
+void SIM_BATCH_runScenario(const SimScenario *scenario, SimStats *stats);
+
+/*F************************************************************************************************
+ * NAME: uint32_t SIM_BATCH_run(const SimScenario *scenarios, uint32_t count, uint16_t workers,
+ *                              SimResult *results)
+ *
+ * DESCRIPTION:
+ *      Executes the scenarios in parallel, every process executes SIM_BATCH_CHUNK scenarios and a
+ *      new one is forked as soon as a previous one terminates.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimScenario*  scenarios   Scenarios to execute
+ *          uint32_t            count       Number of scenarios
+ *          uint16_t            workers     Maximum number of concurrent processes
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimResult*          results     One result per scenario, in the same order
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Number of valid results
+ *
+ *  NOTE:
+ */
+uint32_t SIM_BATCH_run(const SimScenario *scenarios, uint32_t count, uint16_t workers,
+                       SimResult *results);
+
+/*F************************************************************************************************
+ * NAME: SimSummary SIM_BATCH_summarise(const SimResult *results, uint32_t count)
+ *
+ * DESCRIPTION:
+ *      Aggregates the metrics of the valid results.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimResult*    results     Results of a batch
+ *          uint32_t            count       Number of results
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   SimSummary
+ *          Value:  Key performance indicators
+ *
+ *  NOTE:
+ *      The decision latency only considers the scenarios in which at least a decision is taken.
+ */
+SimSummary SIM_BATCH_summarise(const SimResult *results, uint32_t count);
+
+/*F************************************************************************************************
+ * NAME: uint16_t SIM_BATCH_defaultWorkers()
+ *
+ * DESCRIPTION:
+ *      Returns the number of processors available on the host.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Number of online processors, at least 1
+ *
+ *  NOTE:
+ */
+uint16_t SIM_BATCH_defaultWorkers();
+
+#endif // SIM_BATCH_H
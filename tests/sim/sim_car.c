@@ -0,0 +1,545 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_car.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the physical model of the car, it drives the mocked HALs so that
+ *      the unmodified application modules can be executed on the host inside a simulated world.
+ *
+ * PUBLIC FUNCTIONS:
+ *      SimCarParams    SIM_CAR_defaultParams()
+ *      void            SIM_CAR_init(const SimWorld *world, const SimCarParams *params,
+ *                                   uint64_t seed)
+ *      void            SIM_CAR_run(uint64_t duration)
+ *      SimStats        SIM_CAR_getStats()
+ *      SimPose         SIM_CAR_getPose()
+ *      double          SIM_CAR_getEchoAngle()
+ *
+ * NOTES:
+ *      In the middle of the on-time the current of a channel is the stall current, scaled by the
+ *      battery voltage, reduced by the back electromotive force of the wheels, proportional to
+ *      their actual speed. Against a wall only the rotation of the car moves the wheels.
+ *      The HC-SR04 raises the echo pin about 450µs after the trigger and keeps it high for 58µs
+ *      per centimeter, when nothing is hit the pulse lasts about 38ms.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     The echoes and the battery readings go through the fault injector
+ * 18 Oct 2026  Maintainers     The sent messages go through the simulated UART
+ * 18 Oct 2026  Maintainers     The HC-08 emulator is removed at the init
+ * 18 Oct 2026  Maintainers     Tracing of the changes of state, as done by main()
+ * 18 Oct 2026  Maintainers     Current samples of the motors and stall latency
+ * 18 Oct 2026  Maintainers     Dead zone of the slow decay drive
+ * 18 Oct 2026  Maintainers     Wheel speed from the duty cycle applied by the motor HAL
+ * 18 Oct 2026  Maintainers     Echo reflected at the servo angle in the middle of the pulse
+ * 18 Oct 2026  Maintainers     Charge of the battery consumed in the metrics
+ */
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sim_car.h"
+#include "sim_clock.h"
+#include "sim_fault.h"
+#include "sim_hc08.h"
+#include "sim_random.h"
+#include "sim_uart.h"
+#include "../battery_hal.h"
+#include "../bluetooth_hal.h"
+#include "../motor_hal.h"
+#include "../servo_hal.h"
+#include "../ultrasonic_hal.h"
+#include "../../inc/system.h"
+#include "../../inc/trace.h"
+
+#define SIM_CAR_DEG_TO_RAD(deg) ((deg) * M_PI / 180)
+#define SIM_CAR_BEAM_RAYS 9          /* Rays cast to approximate the ultrasonic cone          */
+#define SIM_CAR_US_MIN_RANGE 2       /* Closest distance measured by the HC-SR04 (cm)         */
+#define SIM_CAR_US_MAX_RESULT 250    /* Farthest distance accepted by the ultrasonic HAL (cm) */
+#define SIM_CAR_US_ECHO_DELAY 450    /* Time between trigger and rising edge of the echo (µs) */
+#define SIM_CAR_US_US_PER_CM 58      /* Echo duration per centimeter (µs)                     */
+#define SIM_CAR_US_TIMEOUT 38000     /* Echo duration when nothing is hit (µs)                */
+#define SIM_CAR_MIN_VOLTAGE 6000     /* Discharged battery voltage (mV)                       */
+#define SIM_CAR_MAX_VOLTAGE 8400     /* Fully charged battery voltage (mV)                    */
+
+extern volatile uint8_t batteryTimer; /* Battery notification countdown of the state machine */
+
+const SimWorld *simWorld;       /* World in which the car moves                             */
+const SimCarParams *simParams;  /* Physical characteristics of the car                      */
+SimPose simPose;                /* Current pose of the car                                  */
+SimStats simStats;              /* Metrics of the current simulation                        */
+double servoAngle;              /* Physical position of the servo (deg)                     */
+double servoTarget;             /* Commanded position of the servo (deg)                    */
+double batteryLevel;            /* Current charge of the battery (0 to 1)                   */
+bool isColliding;               /* True while the car touches a wall                        */
+uint16_t pendingEcho;           /* Distance that will be returned by the pending echo       */
+double pendingAngle;            /* Servo angle at the reflection of the pending echo        */
+double echoAngle;               /* Servo angle at the reflection of the last delivered echo */
+uint32_t echoEvent;             /* Event of the pending echo                                */
+SimRandom noise;                /* Generator of the measurement noise                       */
+FSM_State lastState;            /* State of the application at the last check               */
+uint64_t stateSince;            /* Time of the last state change                            */
+uint64_t lastTrigger;           /* Time of the last ultrasonic trigger                      */
+uint64_t detectionTime;         /* Trigger of the measurement that stopped the car          */
+uint64_t contactTime;           /* Time of the last contact with a wall                     */
+double wheelSpeeds[2];          /* Actual ground speed of the left and right wheels (cm/s)  */
+SimRandom currentNoise;         /* Generator of the noise of the current samples            */
+
+static double SIM_CAR_voltage() {
+    return SIM_CAR_MIN_VOLTAGE + batteryLevel * (SIM_CAR_MAX_VOLTAGE - SIM_CAR_MIN_VOLTAGE);
+}
+
+/*F************************************************************************************************
+ * NAME: double SIM_CAR_wheelSpeed(const Motor *motor, double gain)
+ *
+ * DESCRIPTION:
+ *      Computes the ground speed produced by a channel of the motor driver:
+ *      [1] The duty cycle under the dead zone does not move the car, the dead zone of the slow
+ *          decay is smaller
+ *      [2] The remaining range is mapped linearly up to the maximum speed
+ *      [3] The speed is scaled by the battery voltage and the efficiency of the motors
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const Motor*    motor       Channel of the motor driver
+ *          double          gain        Efficiency of the motors of the channel
+ *      GLOBALS:
+ *          const SimCarParams*     simParams
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   double
+ *          Value:  Signed speed in cm/s, positive forward
+ *
+ *  NOTE:
+ */
+static double SIM_CAR_wheelSpeed(const Motor *motor, double gain) {
+    if (motor == NULL || motor->state.direction == MOTOR_DIR_STOP)
+        return 0;
+
+    // [1] Dead zone, smaller when the current does not collapse in the off-time
+    double duty = motor->duty / 10.0;
+    double deadZone = motor->isSlowDecay ? simParams->slowDeadZone : simParams->deadZone;
+    if (duty <= deadZone)
+        return 0;
+
+    // [2] Linear mapping of the remaining range
+    double speed = (duty - deadZone) / (100 - deadZone);
+    speed *= simParams->maxWheelSpeed;
+
+    // [3] Battery and efficiency
+    speed *= gain * SIM_CAR_voltage() / SIM_CAR_MAX_VOLTAGE;
+    return motor->state.direction == MOTOR_DIR_FORWARD ? speed : -speed;
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_CAR_step()
+ *
+ * DESCRIPTION:
+ *      Integrates the physics over a step:
+ *      [1] Moves the car with the differential drive kinematics
+ *      [2] Cancels the translation if the car would overlap a wall and counts the collision, the
+ *          wheels are left with the rotation only
+ *      [3] Moves the servo towards the commanded position
+ *      [4] Discharges the battery
+ *      [5] Schedules the next step
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimPose     simPose
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimPose     simPose
+ *          SimStats    simStats
+ *          double[]    wheelSpeeds
+ *          double      batteryLevel
+ *
+ *  NOTE:
+ */
+static void SIM_CAR_step() {
+    const double dt = SIM_CAR_PHYSICS_STEP / 1e6;
+    const Motor *left = MOTOR_HAL_getMotor(MOTOR_INIT_LEFT);
+    const Motor *right = MOTOR_HAL_getMotor(MOTOR_INIT_RIGHT);
+
+    // [1] Differential drive kinematics
+    double vl = SIM_CAR_wheelSpeed(left, simParams->leftGain);
+    double vr = SIM_CAR_wheelSpeed(right, simParams->rightGain);
+    double v = (vl + vr) / 2;
+    double omega = (vr - vl) / simParams->trackWidth;
+    double heading = simPose.heading + omega * dt / 2;
+    double x = simPose.x + v * cos(heading) * dt;
+    double y = simPose.y + v * sin(heading) * dt;
+    simPose.heading = fmod(simPose.heading + omega * dt, 2 * M_PI);
+
+    // [2] Collisions, the car can still rotate while touching a wall
+    wheelSpeeds[MOTOR_INIT_LEFT] = vl;
+    wheelSpeeds[MOTOR_INIT_RIGHT] = vr;
+    if (SIM_WORLD_clearance(simWorld, x, y) < simParams->bodyRadius) {
+        if (!isColliding) {
+            simStats.collisions++;
+            contactTime = SIM_CLOCK_now();
+        }
+        isColliding = true;
+        wheelSpeeds[MOTOR_INIT_LEFT] = -omega * simParams->trackWidth / 2;
+        wheelSpeeds[MOTOR_INIT_RIGHT] = omega * simParams->trackWidth / 2;
+    } else {
+        isColliding = false;
+        simStats.distance += hypot(x - simPose.x, y - simPose.y);
+        simPose.x = x;
+        simPose.y = y;
+    }
+
+    // [3] Servo travel
+    double servoDelta = simParams->servoSpeed * dt;
+    if (fabs(servoTarget - servoAngle) <= servoDelta)
+        servoAngle = servoTarget;
+    else
+        servoAngle += servoTarget > servoAngle ? servoDelta : -servoDelta;
+
+    // [4] Battery discharge
+    double load = (left != NULL ? left->duty : 0) + (right != NULL ? right->duty : 0);
+    double charge = simParams->batteryDrain * load / 2000 * dt;
+    simStats.charge += charge < batteryLevel ? charge : batteryLevel;
+    batteryLevel -= charge;
+    if (batteryLevel < 0)
+        batteryLevel = 0;
+
+    // [5] Next step
+    SIM_CLOCK_schedule(SIM_CAR_PHYSICS_STEP, SIM_CAR_step);
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_CAR_sampleCurrent()
+ *
+ * DESCRIPTION:
+ *      Delivers the current of the moving channels, once per PWM period:
+ *      [1] Computes the fraction of the no-load speed at which the wheels actually turn
+ *      [2] Reduces the stall current by the back electromotive force and adds the noise
+ *      [3] Schedules the next samples
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          double[]    wheelSpeeds
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      A wheel pushed against its commanded direction has no back electromotive force.
+ */
+static void SIM_CAR_sampleCurrent() {
+    double scale = SIM_CAR_voltage() / SIM_CAR_MAX_VOLTAGE;
+    for (uint8_t side = MOTOR_INIT_LEFT; side <= MOTOR_INIT_RIGHT; side++) {
+        const Motor *motor = MOTOR_HAL_getMotor(side);
+        if (motor == NULL || motor->state.direction == MOTOR_DIR_STOP || motor->state.speed == 0)
+            continue;
+
+        // [1] Fraction of the no-load speed
+        double gain = side == MOTOR_INIT_LEFT ? simParams->leftGain : simParams->rightGain;
+        double speed = wheelSpeeds[side];
+        if (motor->state.direction == MOTOR_DIR_REVERSE)
+            speed = -speed;
+        double fraction = speed / (simParams->maxWheelSpeed * gain * scale);
+        fraction = fraction < 0 ? 0 : fraction > 1 ? 1 : fraction;
+
+        // [2] Current
+        double current = simParams->stallCurrent * scale * (1 - fraction);
+        current += simParams->currentNoise * SIM_RANDOM_gaussian(&currentNoise);
+        MOTOR_HAL_triggerCurrentSample(side, current > 0 ? lround(current) : 0);
+    }
+
+    // [3] Next samples
+    SIM_CLOCK_schedule(SIM_CAR_CURRENT_STEP, SIM_CAR_sampleCurrent);
+}
+
+static void SIM_CAR_deliverEcho(uint32_t distance) {
+    echoAngle = pendingAngle;
+    US_HAL_triggerNextAction(distance);
+}
+
+static void SIM_CAR_onEcho() {
+    echoEvent = SIM_CLOCK_NO_EVENT;
+    SIM_FAULT_deliver(SIM_FAULT_ECHO, pendingEcho, SIM_CAR_deliverEcho);
+}
+
+/*F************************************************************************************************
+ * NAME: double SIM_CAR_castBeam(double servo)
+ *
+ * DESCRIPTION:
+ *      Casts a cone of rays from the sensor, oriented as the given servo position.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          double      servo       Angle of the servo (deg)
+ *      GLOBALS:
+ *          SimPose     simPose
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   double
+ *          Value:  Distance of the closest hit (cm), the maximum range if nothing is hit
+ *
+ *  NOTE:
+ */
+static double SIM_CAR_castBeam(double servo) {
+    double sensorX = simPose.x + simParams->sensorOffset * cos(simPose.heading);
+    double sensorY = simPose.y + simParams->sensorOffset * sin(simPose.heading);
+    double axis = simPose.heading + SIM_CAR_DEG_TO_RAD(servo);
+    double halfAngle = SIM_CAR_DEG_TO_RAD(simParams->beamHalfAngle);
+    double closest = simParams->maxRange;
+    for (uint8_t i = 0; i < SIM_CAR_BEAM_RAYS; i++) {
+        double angle = axis - halfAngle + 2 * halfAngle * i / (SIM_CAR_BEAM_RAYS - 1);
+        double hit = SIM_WORLD_castRay(simWorld, sensorX, sensorY, angle, simParams->maxRange);
+        if (hit < closest)
+            closest = hit;
+    }
+    return closest;
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_CAR_onTrigger()
+ *
+ * DESCRIPTION:
+ *      Computes the echo of a new ultrasonic measurement:
+ *      [1] Casts a cone of rays from the sensor, oriented as the physical servo position, then
+ *          again as the servo will be at the reflection, in the middle of the echo pulse
+ *      [2] Adds the noise to the closest hit and applies the range limits of the HAL
+ *      [3] Schedules the end of the echo pulse
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimPose     simPose
+ *          double      servoAngle
+ *          double      servoTarget
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint16_t    pendingEcho
+ *          double      pendingAngle
+ *          uint32_t    echoEvent
+ *
+ *  NOTE:
+ *      A new trigger discards the pending echo, as the sensor restarts the measurement.
+ *      The car does not move noticeably during the flight of the sound.
+ */
+static void SIM_CAR_onTrigger() {
+    simStats.pings++;
+    lastTrigger = SIM_CLOCK_now();
+
+    // [1] Cone of rays, at the servo angle of the reflection
+    double closest = SIM_CAR_castBeam(servoAngle);
+    double flight = closest >= simParams->maxRange ? SIM_CAR_US_TIMEOUT
+                                                   : closest * SIM_CAR_US_US_PER_CM;
+    double sweep = simParams->servoSpeed * (SIM_CAR_US_ECHO_DELAY + flight / 2) / 1e6;
+    if (fabs(servoTarget - servoAngle) <= sweep)
+        pendingAngle = servoTarget;
+    else
+        pendingAngle = servoAngle + (servoTarget > servoAngle ? sweep : -sweep);
+    if (pendingAngle != servoAngle)
+        closest = SIM_CAR_castBeam(pendingAngle);
+
+    // [2] Noise and range limits
+    uint64_t duration;
+    if (closest >= simParams->maxRange) {
+        pendingEcho = US_RESULT_NO_OBJECT;
+        duration = SIM_CAR_US_TIMEOUT;
+    } else {
+        double distance = closest + simParams->noiseSigma * SIM_RANDOM_gaussian(&noise);
+        if (distance < SIM_CAR_US_MIN_RANGE)
+            distance = SIM_CAR_US_MIN_RANGE;
+        duration = distance * SIM_CAR_US_US_PER_CM;
+        pendingEcho = distance > SIM_CAR_US_MAX_RESULT ? US_RESULT_NO_OBJECT : lround(distance);
+    }
+
+    // [3] End of the echo pulse
+    SIM_CLOCK_cancel(echoEvent);
+    echoEvent = SIM_CLOCK_schedule(SIM_CAR_US_ECHO_DELAY + duration, SIM_CAR_onEcho);
+}
+
+static void SIM_CAR_onServoCommand(int8_t position) { servoTarget = position; }
+
+static uint16_t SIM_CAR_onVoltageRead() {
+    return SIM_FAULT_filter(SIM_FAULT_BATTERY, SIM_CAR_voltage());
+}
+
+static void SIM_CAR_onMessageSent(const char *message) {
+    simStats.messages++;
+    SIM_UART_transmit(message);
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_CAR_updateState()
+ *
+ * DESCRIPTION:
+ *      Follows the state of the application, it is called after every event so that the changes
+ *      are timed exactly:
+ *      [1] Accounts the time spent in the previous state
+ *      [2] On a stop for an obstacle remembers the trigger of the measurement that detected it
+ *      [3] On the following turn accounts the decision latency
+ *      [4] On a back off accounts the stall latency
+ *      [5] Traces the change of state
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          FSM_State   lastState
+ *          uint64_t    stateSince
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          FSM_State   lastState
+ *          uint64_t    stateSince
+ *          SimStats    simStats
+ *
+ *  NOTE:
+ */
+static void SIM_CAR_updateState() {
+    uint64_t now = SIM_CLOCK_now();
+
+    // [1] Time in the previous state
+    simStats.timeInState[lastState] += now - stateSince;
+    stateSince = now;
+    if (FSM_currentState == lastState)
+        return;
+
+    // [2] Stop for an obstacle, after a back off the sensing starts at once
+    if (lastState == STATE_RUNNING && FSM_currentState == STATE_SENSING)
+        detectionTime = lastTrigger;
+    if (lastState == STATE_RECOVERING && FSM_currentState == STATE_SENSING)
+        detectionTime = now;
+
+    // [3] Decision taken
+    if (lastState == STATE_SENSING && FSM_currentState == STATE_TURNING) {
+        uint64_t latency = now - detectionTime;
+        simStats.decisions++;
+        simStats.decisionTime += latency;
+        if (latency > simStats.maxDecisionLatency)
+            simStats.maxDecisionLatency = latency;
+    }
+
+    // [4] Stall detected
+    if (FSM_currentState == STATE_RECOVERING) {
+        uint64_t latency = now - contactTime;
+        simStats.stalls++;
+        if (latency > simStats.maxStallLatency)
+            simStats.maxStallLatency = latency;
+    }
+
+    // [5] Trace
+    TRACE_INSTANT(TRACE_ID_STATE, FSM_currentState);
+    lastState = FSM_currentState;
+}
+
+SimCarParams SIM_CAR_defaultParams() {
+    // The turning time computed by the powertrain module assumes about 210 deg/s at 50% duty
+    SimCarParams params = {
+        .maxWheelSpeed = 62,
+        .deadZone = 15,
+        .slowDeadZone = 5,
+        .trackWidth = 14,
+        .leftGain = 1,
+        .rightGain = 1,
+        .bodyRadius = 10,
+        .sensorOffset = 8,
+        .servoSpeed = 300,
+        .beamHalfAngle = 15,
+        .maxRange = 400,
+        .noiseSigma = 0.5,
+        .batteryLevel = 1,
+        .batteryDrain = 1.0 / 3600,
+        .stallCurrent = 1800,
+        .currentNoise = 20,
+    };
+    return params;
+}
+
+void SIM_CAR_init(const SimWorld *world, const SimCarParams *params, uint64_t seed) {
+    // [1] Virtual clock
+    SIM_CLOCK_init();
+    SIM_CLOCK_attachTimerHal();
+    SIM_FAULT_init(NULL, 0);
+    SIM_HC08_init(NULL);
+
+    // [2] HAL hooks
+    SERVO_HAL_registerPositionHook(SIM_CAR_onServoCommand);
+    US_HAL_registerTriggerHook(SIM_CAR_onTrigger);
+    BATTERY_HAL_registerVoltageHook(SIM_CAR_onVoltageRead);
+    BT_HAL_registerTransmitHook(SIM_CAR_onMessageSent);
+
+    // [3] Car state
+    simWorld = world;
+    simParams = params;
+    simPose = world->start;
+    memset(&simStats, 0, sizeof(simStats));
+    servoAngle = 0;
+    servoTarget = 0;
+    pendingAngle = 0;
+    echoAngle = 0;
+    batteryLevel = params->batteryLevel;
+    isColliding = false;
+    echoEvent = SIM_CLOCK_NO_EVENT;
+    SIM_RANDOM_seed(&noise, seed);
+    SIM_RANDOM_seed(&currentNoise, ~seed);
+    lastTrigger = 0;
+    detectionTime = 0;
+    contactTime = 0;
+    wheelSpeeds[MOTOR_INIT_LEFT] = 0;
+    wheelSpeeds[MOTOR_INIT_RIGHT] = 0;
+    SIM_CLOCK_schedule(SIM_CAR_PHYSICS_STEP, SIM_CAR_step);
+    SIM_CLOCK_schedule(SIM_CAR_CURRENT_STEP, SIM_CAR_sampleCurrent);
+
+    // [4] Boot, as done by main()
+    FSM_currentState = STATE_INIT;
+    batteryTimer = 1;
+    System_init();
+    FSM_stateMachine[FSM_currentState].function();
+    lastState = FSM_currentState;
+    stateSince = 0;
+}
+
+void SIM_CAR_run(uint64_t duration) {
+    uint64_t start = SIM_CLOCK_now();
+    SIM_CAR_updateState(); // catch the changes caused outside the simulation, e.g. IR commands
+    while (SIM_CLOCK_step(start + duration))
+        SIM_CAR_updateState();
+    SIM_CLOCK_runUntil(start + duration);
+    SIM_CAR_updateState();
+    simStats.elapsed += SIM_CLOCK_now() - start;
+}
+
+SimStats SIM_CAR_getStats() {
+    simStats.faults = SIM_FAULT_getInjected();
+    return simStats;
+}
+
+SimPose SIM_CAR_getPose() { return simPose; }
+
+double SIM_CAR_getEchoAngle() { return echoAngle; }
@@ -0,0 +1,293 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_car.h
+ *
+ * DESCRIPTION:
+ *      This header provides the physical model of the car, it drives the mocked HALs so that the
+ *      unmodified application modules can be executed on the host inside a simulated world:
+ *      - differential drive kinematics computed from the speed and direction of the motors
+ *      - travel time of the servo motor
+ *      - HC-SR04 echoes computed by casting a cone of rays, with maximum range and noise
+ *      - battery discharge
+ *      - current of the motors, sampled once per PWM period as the current sense does
+ *
+ * PUBLIC FUNCTIONS:
+ *      SimCarParams    SIM_CAR_defaultParams()
+ *      void            SIM_CAR_init(const SimWorld *world, const SimCarParams *params,
+ *                                   uint64_t seed)
+ *      void            SIM_CAR_run(uint64_t duration)
+ *      SimStats        SIM_CAR_getStats()
+ *      SimPose         SIM_CAR_getPose()
+ *      double          SIM_CAR_getEchoAngle()
+ *
+ * NOTES:
+ *      The simulation runs in virtual time (see sim_clock.h), so it is deterministic for a given
+ *      seed and as fast as the host allows.
+ *      After SIM_CAR_init() the application is in STATE_REMOTE, as after the real boot.
+ *      The decision latency goes from the trigger of the measurement that stops the car in front
+ *      of an obstacle to the start of the avoidance turn.
+ *      The stall latency goes from the contact with a wall to the start of the back off.
+ *      The echo is computed with the servo where it is when the sound is reflected, at the middle
+ *      of the echo pulse, so that a moving servo is measured as by the real sensor.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Command latency and injected faults in the metrics
+ * 18 Oct 2026  Maintainers     Current of the motors, stalls in the metrics
+ * 18 Oct 2026  Maintainers     Dead zone of the slow decay drive
+ * 18 Oct 2026  Maintainers     Echo reflected at the servo angle in the middle of the pulse
+ * 18 Oct 2026  Maintainers     Charge of the battery consumed in the metrics
+ */
+#include <stdint.h>
+
+#include "sim_world.h"
+#include "../../inc/state_machine.h"
+
+#ifndef SIM_CAR_H
+#define SIM_CAR_H
+
+#define SIM_CAR_PHYSICS_STEP 1000  /* Period of the physics integration in µs                 */
+#define SIM_CAR_CURRENT_STEP 10000 /* Period of the current samples, the PWM period in µs      */
+
+/*T************************************************************************************************
+ * NAME: SimCarParams
+ *
+ * DESCRIPTION:
+ *      Represent the physical characteristics of the simulated car.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   double  maxWheelSpeed   Ground speed of a wheel at 100% duty, full battery (cm/s)
+ *              double  deadZone        Duty cycle under which the motors do not spin (%)
+ *              double  slowDeadZone    Dead zone of the motors driven with slow decay (%)
+ *              double  trackWidth      Distance between left and right wheels (cm)
+ *              double  leftGain        Efficiency of the left motors (1 is nominal)
+ *              double  rightGain       Efficiency of the right motors (1 is nominal)
+ *              double  bodyRadius      Radius of the circle that contains the car (cm)
+ *              double  sensorOffset    Distance of the ultrasonic sensor from the center (cm)
+ *              double  servoSpeed      Angular speed of the loaded servo motor (deg/s)
+ *              double  beamHalfAngle   Half aperture of the ultrasonic cone (deg)
+ *              double  maxRange        Maximum distance at which an echo is received (cm)
+ *              double  noiseSigma      Standard deviation of the measurement noise (cm)
+ *              double  batteryLevel    Initial charge of the battery (0 to 1)
+ *              double  batteryDrain    Charge consumed per second at 100% duty on both sides
+ *              double  stallCurrent    Current of a blocked channel at full battery (mA)
+ *              double  currentNoise    Standard deviation of the current samples (mA)
+ */
+typedef struct {
+    double maxWheelSpeed;
+    double deadZone;
+    double slowDeadZone;
+    double trackWidth;
+    double leftGain;
+    double rightGain;
+    double bodyRadius;
+    double sensorOffset;
+    double servoSpeed;
+    double beamHalfAngle;
+    double maxRange;
+    double noiseSigma;
+    double batteryLevel;
+    double batteryDrain;
+    double stallCurrent;
+    double currentNoise;
+} SimCarParams;
+
+/*T************************************************************************************************
+ * NAME: SimStats
+ *
+ * DESCRIPTION:
+ *      Represent the metrics collected during a simulation.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint64_t    elapsed                 Simulated time (µs)
+ *              double      distance                Distance travelled by the center (cm)
+ *              uint32_t    collisions              Number of contacts with a wall
+ *              uint64_t    timeInState[]           Simulated time spent in each FSM state (µs)
+ *              uint32_t    pings                   Number of ultrasonic measurements
+ *              uint32_t    messages                Number of Bluetooth messages sent
+ *              uint32_t    decisions               Number of avoidance decisions taken
+ *              uint64_t    decisionTime            Sum of the decision latencies (µs)
+ *              uint64_t    maxDecisionLatency      Worst decision latency (µs)
+ *              uint64_t    commandLatency          Time to execute the autonomous command (µs)
+ *              uint32_t    faults                  Number of faults injected (see sim_fault.h)
+ *              uint32_t    stalls                  Number of back offs after a motor stall
+ *              uint64_t    maxStallLatency         Worst stall latency (µs)
+ *              double      charge                  Charge of the battery consumed (0 to 1)
+ */
+typedef struct {
+    uint64_t elapsed;
+    double distance;
+    uint32_t collisions;
+    uint64_t timeInState[NUM_STATES];
+    uint32_t pings;
+    uint32_t messages;
+    uint32_t decisions;
+    uint64_t decisionTime;
+    uint64_t maxDecisionLatency;
+    uint64_t commandLatency;
+    uint32_t faults;
+    uint32_t stalls;
+    uint64_t maxStallLatency;
+    double charge;
+} SimStats;
+
+/*F************************************************************************************************
+ * NAME: SimCarParams SIM_CAR_defaultParams()
+ *
+ * DESCRIPTION:
+ *      Returns the parameters of the reference car, they are consistent with the constants used
+ *      by the powertrain and sensing modules.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   SimCarParams
+ *          Value:  The reference parameters
+ *
+ *  NOTE:
+ */
+SimCarParams SIM_CAR_defaultParams();
+
+/*F************************************************************************************************
+ * NAME: void SIM_CAR_init(const SimWorld *world, const SimCarParams *params, uint64_t seed)
+ *
+ * DESCRIPTION:
+ *      Prepares a new simulation:
+ *      [1] Resets the virtual clock and attaches the timer HAL
+ *      [2] Registers the hooks of the mocked HALs
+ *      [3] Places the car in the start pose of the world
+ *      [4] Boots the application as the real firmware does
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimWorld*         world       World in which the car moves
+ *          const SimCarParams*     params      Physical characteristics of the car
+ *          uint64_t                seed        Seed of the measurement noise
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The world and the parameters are referenced, not copied, they must outlive the simulation.
+ *      The fault injector is reset to no faults, SIM_FAULT_init() must be called after it.
+ */
+void SIM_CAR_init(const SimWorld *world, const SimCarParams *params, uint64_t seed);
+
+/*F************************************************************************************************
+ * NAME: void SIM_CAR_run(uint64_t duration)
+ *
+ * DESCRIPTION:
+ *      Advances the simulation by the given amount of virtual time.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t    duration    Microseconds to simulate
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_CAR_run(uint64_t duration);
+
+/*F************************************************************************************************
+ * NAME: SimStats SIM_CAR_getStats()
+ *
+ * DESCRIPTION:
+ *      Returns the metrics collected since the last SIM_CAR_init().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   SimStats
+ *          Value:  Current metrics
+ *
+ *  NOTE:
+ */
+SimStats SIM_CAR_getStats();
+
+/*F************************************************************************************************
+ * NAME: SimPose SIM_CAR_getPose()
+ *
+ * DESCRIPTION:
+ *      Returns the current pose of the car.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   SimPose
+ *          Value:  Current pose
+ *
+ *  NOTE:
+ */
+SimPose SIM_CAR_getPose();
+
+/*F************************************************************************************************
+ * NAME: double SIM_CAR_getEchoAngle()
+ *
+ * DESCRIPTION:
+ *      Returns the physical angle of the servo when the sound of the last delivered echo was
+ *      reflected.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   double
+ *          Value:  Angle of the servo (deg)
+ *
+ *  NOTE:
+ */
+double SIM_CAR_getEchoAngle();
+
+#endif // SIM_CAR_H
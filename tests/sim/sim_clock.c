@@ -0,0 +1,185 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_clock.c
+ *
+ * DESCRIPTION:
+ *      This source file provides a virtual clock with a small event scheduler, it replaces the
+ *      hardware timers when the application modules are executed on the host.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        SIM_CLOCK_init()
+ *      uint64_t    SIM_CLOCK_now()
+ *      uint32_t    SIM_CLOCK_schedule(uint64_t delay, SimEventCallback callback)
+ *      void        SIM_CLOCK_cancel(uint32_t id)
+ *      bool        SIM_CLOCK_step(uint64_t limit)
+ *      void        SIM_CLOCK_runUntil(uint64_t time)
+ *      void        SIM_CLOCK_attachTimerHal()
+ *
+ * NOTES:
+ *      The number of pending events is always small (physics, timers, echoes) so they are kept in
+ *      a fixed array and the next one is found with a linear search.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     The timer HAL reads the ticks from the virtual clock
+ * 18 Oct 2026  Maintainers     The expirations go through the fault injector
+ */
+#include <stddef.h>
+
+#include "sim_clock.h"
+#include "sim_fault.h"
+#include "../timer_hal.h"
+
+/*T************************************************************************************************
+ * NAME: SimEvent
+ *
+ * DESCRIPTION:
+ *      Represent a pending event.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t            id          Unique identifier, SIM_CLOCK_NO_EVENT if free
+ *              uint64_t            time        Absolute time at which the event is due
+ *              SimEventCallback    callback    Function to execute
+ */
+typedef struct {
+    uint32_t id;
+    uint64_t time;
+    SimEventCallback callback;
+} SimEvent;
+
+static SimEvent events[SIM_CLOCK_MAX_EVENTS]; /* Pending events                              */
+static uint64_t now;                          /* Current virtual time                        */
+static uint32_t nextId;                       /* Identifier of the next scheduled event      */
+static uint64_t periodicPeriod;               /* Period of the periodic timer, 0 if stopped  */
+static uint32_t periodicEvent;                /* Next expiration of the periodic timer       */
+static uint32_t sharedEvent;                  /* Expiration of the shared timer              */
+
+void SIM_CLOCK_init() {
+    for (uint8_t i = 0; i < SIM_CLOCK_MAX_EVENTS; i++)
+        events[i].id = SIM_CLOCK_NO_EVENT;
+    now = 0;
+    nextId = 1;
+    periodicPeriod = 0;
+    periodicEvent = SIM_CLOCK_NO_EVENT;
+    sharedEvent = SIM_CLOCK_NO_EVENT;
+}
+
+uint64_t SIM_CLOCK_now() { return now; }
+
+uint32_t SIM_CLOCK_schedule(uint64_t delay, SimEventCallback callback) {
+    for (uint8_t i = 0; i < SIM_CLOCK_MAX_EVENTS; i++) {
+        if (events[i].id == SIM_CLOCK_NO_EVENT) {
+            events[i].id = nextId++;
+            events[i].time = now + delay;
+            events[i].callback = callback;
+            return events[i].id;
+        }
+    }
+    return SIM_CLOCK_NO_EVENT;
+}
+
+void SIM_CLOCK_cancel(uint32_t id) {
+    if (id == SIM_CLOCK_NO_EVENT)
+        return;
+    for (uint8_t i = 0; i < SIM_CLOCK_MAX_EVENTS; i++) {
+        if (events[i].id == id)
+            events[i].id = SIM_CLOCK_NO_EVENT;
+    }
+}
+
+bool SIM_CLOCK_step(uint64_t limit) {
+    // find the earliest event, the identifiers preserve the scheduling order on ties
+    SimEvent *next = NULL;
+    for (uint8_t i = 0; i < SIM_CLOCK_MAX_EVENTS; i++) {
+        if (events[i].id == SIM_CLOCK_NO_EVENT)
+            continue;
+        if (next == NULL || events[i].time < next->time ||
+            (events[i].time == next->time && events[i].id < next->id))
+            next = &events[i];
+    }
+    if (next == NULL || next->time > limit)
+        return false;
+
+    // free the slot before the execution, the callback may schedule new events
+    SimEventCallback callback = next->callback;
+    if (next->time > now)
+        now = next->time;
+    next->id = SIM_CLOCK_NO_EVENT;
+    callback();
+    return true;
+}
+
+void SIM_CLOCK_runUntil(uint64_t time) {
+    while (SIM_CLOCK_step(time))
+        ;
+    if (time > now)
+        now = time;
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_CLOCK_onPeriodicExpired()
+ *
+ * DESCRIPTION:
+ *      Reloads the periodic timer and invokes the registered timer callback.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint64_t    periodicPeriod      Period of the timer
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint32_t    periodicEvent       Next expiration
+ *
+ *  NOTE:
+ */
+static void SIM_CLOCK_triggerPeriodic(uint32_t value) { TIMER_HAL_triggerPeriodicTimer(); }
+
+static void SIM_CLOCK_triggerShared(uint32_t value) { TIMER_HAL_triggerSharedTimer(); }
+
+static void SIM_CLOCK_onPeriodicExpired() {
+    periodicEvent = SIM_CLOCK_schedule(periodicPeriod, SIM_CLOCK_onPeriodicExpired);
+    SIM_FAULT_deliver(SIM_FAULT_PERIODIC, 0, SIM_CLOCK_triggerPeriodic);
+}
+
+static void SIM_CLOCK_onSharedExpired() {
+    sharedEvent = SIM_CLOCK_NO_EVENT;
+    SIM_FAULT_deliver(SIM_FAULT_SHARED, 0, SIM_CLOCK_triggerShared);
+}
+
+static void SIM_CLOCK_setupPeriodic(uint32_t count) {
+    SIM_CLOCK_cancel(periodicEvent);
+    periodicPeriod = SIM_CLOCK_TICKS_TO_US(count);
+    if (periodicPeriod == 0)
+        periodicPeriod = 1;
+    periodicEvent = SIM_CLOCK_schedule(periodicPeriod, SIM_CLOCK_onPeriodicExpired);
+}
+
+static void SIM_CLOCK_acquireShared(uint32_t count) {
+    // a new acquisition restarts the countdown, like reloading the Timer32 counter
+    SIM_CLOCK_cancel(sharedEvent);
+    sharedEvent = SIM_CLOCK_schedule(SIM_CLOCK_TICKS_TO_US(count), SIM_CLOCK_onSharedExpired);
+}
+
+static void SIM_CLOCK_releaseShared() {
+    SIM_CLOCK_cancel(sharedEvent);
+    sharedEvent = SIM_CLOCK_NO_EVENT;
+}
+
+static uint32_t SIM_CLOCK_getTicks() { return SIM_CLOCK_US_TO_TICKS(SIM_CLOCK_now()); }
+
+static const TimerHooks simTimerHooks = {
+    SIM_CLOCK_setupPeriodic,
+    SIM_CLOCK_acquireShared,
+    SIM_CLOCK_releaseShared,
+    SIM_CLOCK_getTicks,
+};
+
+void SIM_CLOCK_attachTimerHal() { TIMER_HAL_registerHooks(&simTimerHooks); }
@@ -0,0 +1,221 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_clock.h
+ *
+ * DESCRIPTION:
+ *      This header provides a virtual clock with a small event scheduler, it replaces the
+ *      hardware timers when the application modules are executed on the host.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        SIM_CLOCK_init()
+ *      uint64_t    SIM_CLOCK_now()
+ *      uint32_t    SIM_CLOCK_schedule(uint64_t delay, SimEventCallback callback)
+ *      void        SIM_CLOCK_cancel(uint32_t id)
+ *      bool        SIM_CLOCK_step(uint64_t limit)
+ *      void        SIM_CLOCK_runUntil(uint64_t time)
+ *      void        SIM_CLOCK_attachTimerHal()
+ *
+ * NOTES:
+ *      Time is expressed in microseconds since the last SIM_CLOCK_init().
+ *      Events scheduled for the same instant are executed in the order they were scheduled.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     The timer HAL reads the ticks from the virtual clock
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#define SIM_CLOCK_MAX_EVENTS 16 /* Maximum number of pending events                          */
+#define SIM_CLOCK_NO_EVENT 0    /* Identifier that never corresponds to a scheduled event    */
+
+/* Timer32 runs at 24MHz / 256 = 93750Hz, so one tick lasts 32/3 µs */
+#define SIM_CLOCK_TICKS_TO_US(ticks) (((uint64_t)(ticks) * 32) / 3)
+#define SIM_CLOCK_US_TO_TICKS(us) (((uint64_t)(us) * 3) / 32)
+
+/*T************************************************************************************************
+ * NAME: SimEventCallback
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that executes when a scheduled event is due.
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Args:   None
+ */
+typedef void (*SimEventCallback)(void);
+
+/*F************************************************************************************************
+ * NAME: void SIM_CLOCK_init()
+ *
+ * DESCRIPTION:
+ *      Resets the virtual time to zero and discards every pending event.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_CLOCK_init();
+
+/*F************************************************************************************************
+ * NAME: uint64_t SIM_CLOCK_now()
+ *
+ * DESCRIPTION:
+ *      Returns the current virtual time.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint64_t
+ *          Value:  Microseconds elapsed since the initialisation
+ *
+ *  NOTE:
+ */
+uint64_t SIM_CLOCK_now();
+
+/*F************************************************************************************************
+ * NAME: uint32_t SIM_CLOCK_schedule(uint64_t delay, SimEventCallback callback)
+ *
+ * DESCRIPTION:
+ *      Schedules the execution of the given function after the given delay.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t            delay       Microseconds from now
+ *          SimEventCallback    callback    Function to execute
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Identifier of the event, SIM_CLOCK_NO_EVENT if the scheduler is full
+ *
+ *  NOTE:
+ */
+uint32_t SIM_CLOCK_schedule(uint64_t delay, SimEventCallback callback);
+
+/*F************************************************************************************************
+ * NAME: void SIM_CLOCK_cancel(uint32_t id)
+ *
+ * DESCRIPTION:
+ *      Removes a pending event, nothing happens if the event has already been executed.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    id      Identifier returned by SIM_CLOCK_schedule()
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_CLOCK_cancel(uint32_t id);
+
+/*F************************************************************************************************
+ * NAME: bool SIM_CLOCK_step(uint64_t limit)
+ *
+ * DESCRIPTION:
+ *      Advances the virtual time to the first pending event and executes it, as long as it is not
+ *      due after the given limit.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t    limit       Latest time at which the event can be executed
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if an event has been executed
+ *
+ *  NOTE:
+ */
+bool SIM_CLOCK_step(uint64_t limit);
+
+/*F************************************************************************************************
+ * NAME: void SIM_CLOCK_runUntil(uint64_t time)
+ *
+ * DESCRIPTION:
+ *      Executes every event due before the given time, then sets the current time to it.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t    time        Absolute virtual time to reach
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_CLOCK_runUntil(uint64_t time);
+
+/*F************************************************************************************************
+ * NAME: void SIM_CLOCK_attachTimerHal()
+ *
+ * DESCRIPTION:
+ *      Registers the timer HAL hooks so that the periodic and the shared timers expire in virtual
+ *      time, with the same resolution of the Timer32 modules, and TIMER_HAL_getTicks() reads the
+ *      virtual clock.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_CLOCK_attachTimerHal();
+
+#endif // SIM_CLOCK_H
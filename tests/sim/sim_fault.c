@@ -0,0 +1,374 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_fault.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the injection of faults between the simulated hardware and the
+ *      mocked HALs.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        SIM_FAULT_init(const SimFaultConfig *config, uint64_t seed)
+ *      void        SIM_FAULT_deliver(SimFaultChannel channel, uint32_t value,
+ *                                    SimFaultHandler handler)
+ *      uint32_t    SIM_FAULT_filter(SimFaultChannel channel, uint32_t value)
+ *      void        SIM_FAULT_sendIRCommand(IRCommand command)
+ *      void        SIM_FAULT_sendBTMessage(const char *message)
+ *      uint32_t    SIM_FAULT_getInjected()
+ *      bool        SIM_FAULT_parseChannel(const char *name, SimFaultChannel *channel)
+ *      bool        SIM_FAULT_parseKind(const char *name, SimFaultKind *kind)
+ *      bool        SIM_FAULT_isApplicable(SimFaultChannel channel, SimFaultKind kind)
+ *
+ * NOTES:
+ *      The late inputs wait in a small array, a single event of the virtual clock is scheduled for
+ *      the earliest of them so that the faults never exhaust the events of the clock.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stddef.h>
+#include <string.h>
+
+#include "sim_clock.h"
+#include "sim_fault.h"
+#include "sim_random.h"
+#include "../bluetooth_hal.h"
+
+#define SIM_FAULT_BIT(kind) (1 << (kind))
+#define SIM_FAULT_ALL_KINDS (SIM_FAULT_BIT(SIM_FAULT_NUM_KINDS) - 1)
+#define SIM_FAULT_TIMING_KINDS                                                                     \
+    (SIM_FAULT_BIT(SIM_FAULT_DROP) | SIM_FAULT_BIT(SIM_FAULT_DELAY) |                              \
+     SIM_FAULT_BIT(SIM_FAULT_DUPLICATE))
+#define SIM_FAULT_VALUE_KINDS (SIM_FAULT_BIT(SIM_FAULT_CORRUPT) | SIM_FAULT_BIT(SIM_FAULT_STUCK))
+#define SIM_FAULT_BATTERY_BITS 14 /* Bits of a battery reading that can be flipped           */
+
+/*T************************************************************************************************
+ * NAME: SimFaultPending
+ *
+ * DESCRIPTION:
+ *      Represent a late input.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   bool                isUsed      True if the slot contains an input
+ *              uint64_t            due         Delivery time (µs)
+ *              uint32_t            value       Payload
+ *              SimFaultHandler     handler     Delivery function, NULL for a Bluetooth message
+ *              char[]              message     Bluetooth message
+ */
+typedef struct {
+    bool isUsed;
+    uint64_t due;
+    uint32_t value;
+    SimFaultHandler handler;
+    char message[SIM_FAULT_MESSAGE_SIZE];
+} SimFaultPending;
+
+const char *const simFaultChannelNames[SIM_FAULT_NUM_CHANNELS] = {
+    "echo", "ir", "bt", "periodic", "shared", "battery",
+};
+const char *const simFaultKindNames[SIM_FAULT_NUM_KINDS] = {
+    "drop", "delay", "duplicate", "corrupt", "stuck",
+};
+
+static const uint8_t applicableKinds[SIM_FAULT_NUM_CHANNELS] = {
+    SIM_FAULT_ALL_KINDS,    SIM_FAULT_ALL_KINDS,    SIM_FAULT_ALL_KINDS,
+    SIM_FAULT_TIMING_KINDS, SIM_FAULT_TIMING_KINDS, SIM_FAULT_VALUE_KINDS,
+};
+
+const SimFaultConfig *faultConfig;                  /* Faults of the simulation, NULL if none */
+SimRandom faultRandom;                              /* Generator of the random faults         */
+SimFaultPending faultPending[SIM_FAULT_MAX_PENDING]; /* Late inputs                           */
+uint32_t faultEvent;                                /* Event of the earliest late input       */
+uint32_t faultLastValue[SIM_FAULT_NUM_CHANNELS];    /* Last delivered value of each channel   */
+bool faultHasLast[SIM_FAULT_NUM_CHANNELS];          /* True if a value has been delivered     */
+char faultLastMessage[SIM_FAULT_MESSAGE_SIZE];      /* Last delivered Bluetooth message       */
+uint32_t faultInjected;                             /* Faults injected since the init         */
+
+void SIM_FAULT_init(const SimFaultConfig *config, uint64_t seed) {
+    faultConfig = config;
+    SIM_RANDOM_seed(&faultRandom, seed);
+    for (uint16_t i = 0; i < SIM_FAULT_MAX_PENDING; i++)
+        faultPending[i].isUsed = false;
+    faultEvent = SIM_CLOCK_NO_EVENT;
+    for (uint8_t c = 0; c < SIM_FAULT_NUM_CHANNELS; c++)
+        faultHasLast[c] = false;
+    faultInjected = 0;
+}
+
+/*F************************************************************************************************
+ * NAME: bool SIM_FAULT_occurs(SimFaultChannel channel, SimFaultKind kind)
+ *
+ * DESCRIPTION:
+ *      Decides whether a fault affects the current input: always inside a scripted window,
+ *      otherwise with the configured probability.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimFaultChannel     channel     Channel of the input
+ *          SimFaultKind        kind        Kind of fault
+ *      GLOBALS:
+ *          SimFaultConfig*     faultConfig
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint32_t            faultInjected   Incremented if the fault occurs
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the fault occurs
+ *
+ *  NOTE:
+ *      The generator is used only by the channels with a probability, so adding a fault to a
+ *      channel does not change the faults of the others.
+ */
+static bool SIM_FAULT_occurs(SimFaultChannel channel, SimFaultKind kind) {
+    if (faultConfig == NULL || !SIM_FAULT_isApplicable(channel, kind))
+        return false;
+
+    bool occurs = false;
+    uint64_t now = SIM_CLOCK_now();
+    for (uint16_t i = 0; i < faultConfig->scripted && !occurs; i++) {
+        const SimFaultScript *script = &faultConfig->script[i];
+        occurs = script->channel == channel && script->kind == kind && now >= script->start &&
+                 now < script->end;
+    }
+
+    double probability = faultConfig->probability[channel][kind];
+    if (!occurs && probability > 0)
+        occurs = SIM_RANDOM_uniform(&faultRandom, 0, 1) < probability;
+
+    if (occurs)
+        faultInjected++;
+    return occurs;
+}
+
+static uint32_t SIM_FAULT_corrupt(SimFaultChannel channel, uint32_t value) {
+    uint64_t random = SIM_RANDOM_next(&faultRandom);
+    switch (channel) {
+    case SIM_FAULT_ECHO:
+        return random % (SIM_FAULT_ECHO_RANGE + 1);
+    case SIM_FAULT_IR:
+        return value ^ (1u << (random % 32));
+    case SIM_FAULT_BT:
+        return value ^ (1u << (random % 8));
+    case SIM_FAULT_BATTERY:
+        return value ^ (1u << (random % SIM_FAULT_BATTERY_BITS));
+    default:
+        return value;
+    }
+}
+
+static void SIM_FAULT_onDue();
+
+static int16_t SIM_FAULT_earliest() {
+    int16_t earliest = -1;
+    for (int16_t i = 0; i < SIM_FAULT_MAX_PENDING; i++)
+        if (faultPending[i].isUsed &&
+            (earliest < 0 || faultPending[i].due < faultPending[earliest].due))
+            earliest = i;
+    return earliest;
+}
+
+static void SIM_FAULT_reschedule() {
+    SIM_CLOCK_cancel(faultEvent);
+    faultEvent = SIM_CLOCK_NO_EVENT;
+    int16_t earliest = SIM_FAULT_earliest();
+    if (earliest >= 0)
+        faultEvent =
+            SIM_CLOCK_schedule(faultPending[earliest].due - SIM_CLOCK_now(), SIM_FAULT_onDue);
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_FAULT_onDue()
+ *
+ * DESCRIPTION:
+ *      Delivers the late inputs whose time has come, in order of delivery time, then schedules
+ *      the next one.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimFaultPending[]   faultPending
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimFaultPending[]   faultPending    The delivered inputs are removed
+ *          uint32_t            faultEvent      Event of the next late input
+ *
+ *  NOTE:
+ *      A delivery can add new late inputs, so the earliest one is searched every time.
+ */
+static void SIM_FAULT_onDue() {
+    faultEvent = SIM_CLOCK_NO_EVENT;
+    int16_t earliest;
+    while ((earliest = SIM_FAULT_earliest()) >= 0 &&
+           faultPending[earliest].due <= SIM_CLOCK_now()) {
+        SimFaultPending input = faultPending[earliest];
+        faultPending[earliest].isUsed = false;
+        if (input.handler != NULL)
+            input.handler(input.value);
+        else
+            BT_HAL_triggerMessageReceived(input.message);
+    }
+    SIM_FAULT_reschedule();
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_FAULT_postpone(SimFaultChannel channel, uint32_t value, SimFaultHandler handler,
+ *                               const char *message)
+ *
+ * DESCRIPTION:
+ *      Stores a late input with a random delay up to the maximum of the channel.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimFaultChannel     channel     Channel of the input
+ *          uint32_t            value       Payload
+ *          SimFaultHandler     handler     Delivery function, NULL for a Bluetooth message
+ *          const char*         message     Bluetooth message
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimFaultPending[]   faultPending    The input is added
+ *
+ *  NOTE:
+ *      If there is no free slot the input is delivered immediately.
+ */
+static void SIM_FAULT_postpone(SimFaultChannel channel, uint32_t value, SimFaultHandler handler,
+                               const char *message) {
+    for (uint16_t i = 0; i < SIM_FAULT_MAX_PENDING; i++) {
+        SimFaultPending *input = &faultPending[i];
+        if (input->isUsed)
+            continue;
+
+        uint64_t maxDelay = faultConfig->maxDelay[channel];
+        input->isUsed = true;
+        uint64_t delay = maxDelay > 0 ? SIM_RANDOM_next(&faultRandom) % maxDelay : 0;
+        input->due = SIM_CLOCK_now() + 1 + delay;
+        input->value = value;
+        input->handler = handler;
+        if (message != NULL)
+            strcpy(input->message, message);
+        SIM_FAULT_reschedule();
+        return;
+    }
+
+    if (handler != NULL)
+        handler(value);
+    else
+        BT_HAL_triggerMessageReceived(message);
+}
+
+void SIM_FAULT_deliver(SimFaultChannel channel, uint32_t value, SimFaultHandler handler) {
+    // [1] Lost input
+    if (SIM_FAULT_occurs(channel, SIM_FAULT_DROP))
+        return;
+
+    // [2] Wrong value
+    if (SIM_FAULT_occurs(channel, SIM_FAULT_CORRUPT))
+        value = SIM_FAULT_corrupt(channel, value);
+    else if (SIM_FAULT_occurs(channel, SIM_FAULT_STUCK) && faultHasLast[channel])
+        value = faultLastValue[channel];
+    faultLastValue[channel] = value;
+    faultHasLast[channel] = true;
+
+    // [3] Delivery of one or two copies, each of them can be late
+    uint8_t copies = SIM_FAULT_occurs(channel, SIM_FAULT_DUPLICATE) ? 2 : 1;
+    for (uint8_t i = 0; i < copies; i++) {
+        if (SIM_FAULT_occurs(channel, SIM_FAULT_DELAY))
+            SIM_FAULT_postpone(channel, value, handler, NULL);
+        else
+            handler(value);
+    }
+}
+
+uint32_t SIM_FAULT_filter(SimFaultChannel channel, uint32_t value) {
+    if (SIM_FAULT_occurs(channel, SIM_FAULT_CORRUPT))
+        value = SIM_FAULT_corrupt(channel, value);
+    else if (SIM_FAULT_occurs(channel, SIM_FAULT_STUCK) && faultHasLast[channel])
+        value = faultLastValue[channel];
+    faultLastValue[channel] = value;
+    faultHasLast[channel] = true;
+    return value;
+}
+
+static void SIM_FAULT_deliverFrame(uint32_t frame) { IR_HAL_triggerFrameReceived(frame); }
+
+void SIM_FAULT_sendIRCommand(IRCommand command) {
+    uint8_t code = command;
+    uint32_t frame = 0x00FF0000 | code << 8 | (uint8_t)~code;
+    SIM_FAULT_deliver(SIM_FAULT_IR, frame, SIM_FAULT_deliverFrame);
+}
+
+void SIM_FAULT_sendBTMessage(const char *message) {
+    char received[SIM_FAULT_MESSAGE_SIZE];
+    uint16_t length = 0;
+
+    // [1] Repeated message or faulty bytes
+    if (SIM_FAULT_occurs(SIM_FAULT_BT, SIM_FAULT_STUCK) && faultHasLast[SIM_FAULT_BT]) {
+        strcpy(received, faultLastMessage);
+        length = strlen(received);
+    } else {
+        for (; *message != '\0' && length < sizeof(received) - 1; message++) {
+            char c = *message;
+            if (SIM_FAULT_occurs(SIM_FAULT_BT, SIM_FAULT_DROP))
+                continue;
+            if (SIM_FAULT_occurs(SIM_FAULT_BT, SIM_FAULT_CORRUPT)) {
+                char corrupted = SIM_FAULT_corrupt(SIM_FAULT_BT, (uint8_t)c);
+                if (corrupted != '\0') // a terminator would truncate the message
+                    c = corrupted;
+            }
+            received[length++] = c;
+            bool isDuplicated = SIM_FAULT_occurs(SIM_FAULT_BT, SIM_FAULT_DUPLICATE);
+            if (isDuplicated && length < sizeof(received) - 1)
+                received[length++] = c;
+        }
+        received[length] = '\0';
+    }
+    strcpy(faultLastMessage, received);
+    faultHasLast[SIM_FAULT_BT] = true;
+
+    // [2] Delivery
+    if (SIM_FAULT_occurs(SIM_FAULT_BT, SIM_FAULT_DELAY))
+        SIM_FAULT_postpone(SIM_FAULT_BT, 0, NULL, received);
+    else
+        BT_HAL_triggerMessageReceived(received);
+}
+
+uint32_t SIM_FAULT_getInjected() { return faultInjected; }
+
+bool SIM_FAULT_parseChannel(const char *name, SimFaultChannel *channel) {
+    for (uint8_t c = 0; c < SIM_FAULT_NUM_CHANNELS; c++) {
+        if (strcmp(name, simFaultChannelNames[c]) == 0) {
+            *channel = c;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SIM_FAULT_parseKind(const char *name, SimFaultKind *kind) {
+    for (uint8_t k = 0; k < SIM_FAULT_NUM_KINDS; k++) {
+        if (strcmp(name, simFaultKindNames[k]) == 0) {
+            *kind = k;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SIM_FAULT_isApplicable(SimFaultChannel channel, SimFaultKind kind) {
+    return channel < SIM_FAULT_NUM_CHANNELS && kind < SIM_FAULT_NUM_KINDS &&
+           (applicableKinds[channel] & SIM_FAULT_BIT(kind));
+}
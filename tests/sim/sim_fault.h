@@ -0,0 +1,357 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_fault.h
+ *
+ * DESCRIPTION:
+ *      This header provides the injection of faults between the simulated hardware and the mocked
+ *      HALs: lost, late, repeated, corrupted and stuck inputs, either at random or in scripted time
+ *      windows.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        SIM_FAULT_init(const SimFaultConfig *config, uint64_t seed)
+ *      void        SIM_FAULT_deliver(SimFaultChannel channel, uint32_t value,
+ *                                    SimFaultHandler handler)
+ *      uint32_t    SIM_FAULT_filter(SimFaultChannel channel, uint32_t value)
+ *      void        SIM_FAULT_sendIRCommand(IRCommand command)
+ *      void        SIM_FAULT_sendBTMessage(const char *message)
+ *      uint32_t    SIM_FAULT_getInjected()
+ *      bool        SIM_FAULT_parseChannel(const char *name, SimFaultChannel *channel)
+ *      bool        SIM_FAULT_parseKind(const char *name, SimFaultKind *kind)
+ *      bool        SIM_FAULT_isApplicable(SimFaultChannel channel, SimFaultKind kind)
+ *
+ * NOTES:
+ *      Not every fault makes sense on every channel:
+ *                  drop    delay   duplicate   corrupt             stuck
+ *      echo        yes     yes     yes         random distance     last distance
+ *      ir          yes     yes     yes         flipped frame bit   last frame
+ *      bt          bytes   message bytes       flipped byte bit    last message
+ *      periodic    yes     yes     yes         -                   -
+ *      shared      yes     yes     yes         -                   -
+ *      battery     -       -       -           flipped bit         last reading
+ *      The faults use their own generator, so the same seed produces the same courses with and
+ *      without faults. Without SIM_FAULT_init(), or with a NULL configuration, every input is
+ *      delivered immediately and unchanged.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Bluetooth messages as long as the buffer of the HAL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../infrared_hal.h"
+
+#ifndef SIM_FAULT_H
+#define SIM_FAULT_H
+
+#define SIM_FAULT_MAX_SCRIPTED 16    /* Maximum number of scripted faults                     */
+#define SIM_FAULT_MAX_PENDING 16     /* Maximum number of delayed inputs                      */
+#define SIM_FAULT_MESSAGE_SIZE 256   /* Max length of a faulty Bluetooth message              */
+#define SIM_FAULT_ECHO_RANGE 400     /* Largest random distance of a corrupted echo (cm)      */
+
+/*T************************************************************************************************
+ * NAME: SimFaultChannel
+ *
+ * DESCRIPTION:
+ *      Represent an input of the application that can be affected by faults.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: SIM_FAULT_ECHO          Ultrasonic measurements
+ *              SIM_FAULT_IR            Infrared frames
+ *              SIM_FAULT_BT            Bluetooth messages
+ *              SIM_FAULT_PERIODIC      Expirations of the periodic timer
+ *              SIM_FAULT_SHARED        Expirations of the shared timer
+ *              SIM_FAULT_BATTERY       Battery readings
+ */
+typedef enum {
+    SIM_FAULT_ECHO,
+    SIM_FAULT_IR,
+    SIM_FAULT_BT,
+    SIM_FAULT_PERIODIC,
+    SIM_FAULT_SHARED,
+    SIM_FAULT_BATTERY,
+    SIM_FAULT_NUM_CHANNELS
+} SimFaultChannel;
+
+/*T************************************************************************************************
+ * NAME: SimFaultKind
+ *
+ * DESCRIPTION:
+ *      Represent the effect of a fault on an input.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: SIM_FAULT_DROP          The input is lost
+ *              SIM_FAULT_DELAY         The input arrives up to maxDelay later
+ *              SIM_FAULT_DUPLICATE     The input arrives twice
+ *              SIM_FAULT_CORRUPT       The value of the input is altered
+ *              SIM_FAULT_STUCK         The input repeats the previous value
+ */
+typedef enum {
+    SIM_FAULT_DROP,
+    SIM_FAULT_DELAY,
+    SIM_FAULT_DUPLICATE,
+    SIM_FAULT_CORRUPT,
+    SIM_FAULT_STUCK,
+    SIM_FAULT_NUM_KINDS
+} SimFaultKind;
+
+/*T************************************************************************************************
+ * NAME: SimFaultScript
+ *
+ * DESCRIPTION:
+ *      Represent a fault that affects every input of a channel in a time window.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   SimFaultChannel     channel     Affected channel
+ *              SimFaultKind        kind        Effect
+ *              uint64_t            start       Start of the window (µs since the boot)
+ *              uint64_t            end         End of the window, excluded (µs since the boot)
+ */
+typedef struct {
+    SimFaultChannel channel;
+    SimFaultKind kind;
+    uint64_t start;
+    uint64_t end;
+} SimFaultScript;
+
+/*T************************************************************************************************
+ * NAME: SimFaultConfig
+ *
+ * DESCRIPTION:
+ *      Represent the faults of a simulation.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   double          probability[][]     Chance of each kind of fault per input
+ *              uint64_t        maxDelay[]          Largest delay of a late input (µs)
+ *              SimFaultScript  script[]            Scripted faults
+ *              uint16_t        scripted            Number of scripted faults
+ */
+typedef struct {
+    double probability[SIM_FAULT_NUM_CHANNELS][SIM_FAULT_NUM_KINDS];
+    uint64_t maxDelay[SIM_FAULT_NUM_CHANNELS];
+    SimFaultScript script[SIM_FAULT_MAX_SCRIPTED];
+    uint16_t scripted;
+} SimFaultConfig;
+
+/*T************************************************************************************************
+ * NAME: SimFaultHandler
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that delivers an input to the mocked HAL.
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Args:   uint32_t    value       Payload of the input
+ */
+typedef void (*SimFaultHandler)(uint32_t value);
+
+/*F************************************************************************************************
+ * NAME: void SIM_FAULT_init(const SimFaultConfig *config, uint64_t seed)
+ *
+ * DESCRIPTION:
+ *      Sets the faults of the next simulation and forgets the pending inputs.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimFaultConfig*   config      Faults, NULL to disable them
+ *          uint64_t                seed        Seed of the fault generator
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The configuration is not copied, it must stay valid during the simulation.
+ *      It must be called after SIM_CAR_init(), that resets the injector to no faults.
+ */
+void SIM_FAULT_init(const SimFaultConfig *config, uint64_t seed);
+
+/*F************************************************************************************************
+ * NAME: void SIM_FAULT_deliver(SimFaultChannel channel, uint32_t value, SimFaultHandler handler)
+ *
+ * DESCRIPTION:
+ *      Delivers an asynchronous input through the handler, after applying the faults.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimFaultChannel     channel     Channel of the input
+ *          uint32_t            value       Payload of the input
+ *          SimFaultHandler     handler     Function that delivers the input to the HAL
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      A late input is delivered by the virtual clock.
+ */
+void SIM_FAULT_deliver(SimFaultChannel channel, uint32_t value, SimFaultHandler handler);
+
+/*F************************************************************************************************
+ * NAME: uint32_t SIM_FAULT_filter(SimFaultChannel channel, uint32_t value)
+ *
+ * DESCRIPTION:
+ *      Applies the corrupt and stuck faults to a value read synchronously by the application.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimFaultChannel     channel     Channel of the value
+ *          uint32_t            value       Correct value
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Value seen by the application
+ *
+ *  NOTE:
+ */
+uint32_t SIM_FAULT_filter(SimFaultChannel channel, uint32_t value);
+
+/*F************************************************************************************************
+ * NAME: void SIM_FAULT_sendIRCommand(IRCommand command)
+ *
+ * DESCRIPTION:
+ *      Sends the NEC frame of a remote command through the infrared channel.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          IRCommand   command     Command of the pressed key
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_FAULT_sendIRCommand(IRCommand command);
+
+/*F************************************************************************************************
+ * NAME: void SIM_FAULT_sendBTMessage(const char *message)
+ *
+ * DESCRIPTION:
+ *      Sends a message through the Bluetooth channel, drop, duplicate and corrupt faults apply to
+ *      every byte, delay and stuck to the whole message.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*     message     Message, longer ones are truncated
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_FAULT_sendBTMessage(const char *message);
+
+/*F************************************************************************************************
+ * NAME: uint32_t SIM_FAULT_getInjected()
+ *
+ * DESCRIPTION:
+ *      Returns the number of faults injected since SIM_FAULT_init().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Number of faults
+ *
+ *  NOTE:
+ */
+uint32_t SIM_FAULT_getInjected();
+
+/*F************************************************************************************************
+ * NAME: bool SIM_FAULT_parseChannel(const char *name, SimFaultChannel *channel)
+ *
+ * DESCRIPTION:
+ *      Converts the name of a channel (echo, ir, bt, periodic, shared, battery).
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*         name        Name of the channel
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimFaultChannel*    channel     Parsed channel
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the name is unknown
+ *
+ *  NOTE:
+ *      SIM_FAULT_parseKind() does the same for drop, delay, duplicate, corrupt and stuck.
+ */
+bool SIM_FAULT_parseChannel(const char *name, SimFaultChannel *channel);
+bool SIM_FAULT_parseKind(const char *name, SimFaultKind *kind);
+
+/*F************************************************************************************************
+ * NAME: bool SIM_FAULT_isApplicable(SimFaultChannel channel, SimFaultKind kind)
+ *
+ * DESCRIPTION:
+ *      Tells whether a kind of fault has an effect on a channel, see the table in the notes.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimFaultChannel     channel     Channel
+ *          SimFaultKind        kind        Kind of fault
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the fault can be injected
+ *
+ *  NOTE:
+ */
+bool SIM_FAULT_isApplicable(SimFaultChannel channel, SimFaultKind kind);
+
+extern const char *const simFaultChannelNames[SIM_FAULT_NUM_CHANNELS];
+extern const char *const simFaultKindNames[SIM_FAULT_NUM_KINDS];
+
+#endif // SIM_FAULT_H
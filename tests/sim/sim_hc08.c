@@ -0,0 +1,244 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_hc08.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the emulation of the HC-08 Bluetooth Low Energy module.
+ *
+ * PUBLIC FUNCTIONS:
+ *      SimHc08Config   SIM_HC08_defaultConfig()
+ *      void            SIM_HC08_init(const SimHc08Config *config)
+ *      bool            SIM_HC08_isEnabled()
+ *      bool            SIM_HC08_isConnected()
+ *      void            SIM_HC08_fromUart(char c)
+ *      SimHc08Stats    SIM_HC08_getStats()
+ *
+ * NOTES:
+ *      Every byte of the uplink buffer keeps its arrival time, so the wait in the module is
+ *      measured per byte and does not include the time spent on the UART.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sim_clock.h"
+#include "sim_hc08.h"
+#include "sim_uart.h"
+
+#define SIM_HC08_VERSION "HC-08V2.2"
+#define SIM_HC08_DEFAULT_NAME "HC-08"
+
+const SimHc08Config *hc08Config;              /* Characteristics, NULL without the module      */
+bool hc08IsConnected;                         /* True after the connection of the central      */
+uint32_t hc08Event;                           /* Next connection event                         */
+char hc08Uplink[SIM_HC08_BUFFER_SIZE];        /* Bytes waiting for a notification (circular)   */
+uint64_t hc08Arrival[SIM_HC08_BUFFER_SIZE];   /* Arrival time of every uplink byte (µs)        */
+uint16_t hc08UplinkHead;                      /* Index of the oldest uplink byte               */
+uint16_t hc08UplinkCount;                     /* Number of uplink bytes                        */
+char hc08Downlink[SIM_HC08_BUFFER_SIZE];      /* Bytes written by the central (circular)       */
+uint16_t hc08DownlinkHead;                    /* Index of the oldest downlink byte             */
+uint16_t hc08DownlinkCount;                   /* Number of downlink bytes                      */
+char hc08Command[SIM_HC08_AT_SIZE];           /* AT command being received                     */
+uint8_t hc08CommandLength;                    /* Length of hc08Command                         */
+char hc08Name[SIM_HC08_NAME_SIZE];            /* Name advertised by the module                 */
+SimHc08Stats hc08Stats;                       /* Traffic of the link                           */
+
+SimHc08Config SIM_HC08_defaultConfig() {
+    SimHc08Config config = {
+        .interval = 24,
+        .packets = 4,
+        .uplinkBuffer = 256,
+        .downlinkBuffer = 256,
+        .connectDelay = 0,
+    };
+    return config;
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_HC08_onConnectionEvent()
+ *
+ * DESCRIPTION:
+ *      Exchanges the packets of a connection event and schedules the next one:
+ *      [1] Notifications with the oldest bytes of the uplink buffer
+ *      [2] Writes of the central, only if the downlink buffer can hold them
+ *      [3] Downlink bytes to the UART, as long as the UART accepts them
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimHc08Config*  hc08Config
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          char[]          hc08Uplink      The notified bytes are removed
+ *          char[]          hc08Downlink    Updated
+ *          SimHc08Stats    hc08Stats       Updated
+ *
+ *  NOTE:
+ *      The central never writes more than the module can store, as with the flow control of the
+ *      Bluetooth link layer.
+ */
+static void SIM_HC08_onConnectionEvent() {
+    hc08IsConnected = true;
+    hc08Stats.events++;
+    uint64_t now = SIM_CLOCK_now();
+
+    // [1] Notifications
+    for (uint8_t p = 0; p < hc08Config->packets && hc08UplinkCount > 0; p++) {
+        char packet[SIM_HC08_PAYLOAD];
+        uint16_t length = hc08UplinkCount < SIM_HC08_PAYLOAD ? hc08UplinkCount : SIM_HC08_PAYLOAD;
+        for (uint16_t i = 0; i < length; i++) {
+            uint64_t latency = now - hc08Arrival[hc08UplinkHead];
+            hc08Stats.uplinkLatency += latency;
+            if (latency > hc08Stats.maxUplinkLatency)
+                hc08Stats.maxUplinkLatency = latency;
+            packet[i] = hc08Uplink[hc08UplinkHead];
+            hc08UplinkHead = (hc08UplinkHead + 1) % SIM_HC08_BUFFER_SIZE;
+        }
+        hc08UplinkCount -= length;
+        SIM_UART_writeTerminal(packet, length);
+        hc08Stats.notifications++;
+        hc08Stats.uplinkBytes += length;
+    }
+
+    // [2] Writes
+    for (uint8_t p = 0; p < hc08Config->packets; p++) {
+        if (hc08Config->downlinkBuffer - hc08DownlinkCount < SIM_HC08_PAYLOAD)
+            break;
+        char packet[SIM_HC08_PAYLOAD];
+        uint16_t length = SIM_UART_readTerminal(packet, SIM_HC08_PAYLOAD);
+        if (length == 0)
+            break;
+        for (uint16_t i = 0; i < length; i++) {
+            uint16_t tail = (hc08DownlinkHead + hc08DownlinkCount) % SIM_HC08_BUFFER_SIZE;
+            hc08Downlink[tail] = packet[i];
+            hc08DownlinkCount++;
+        }
+        hc08Stats.writes++;
+        hc08Stats.downlinkBytes += length;
+    }
+
+    // [3] UART
+    while (hc08DownlinkCount > 0 && SIM_UART_receive(hc08Downlink[hc08DownlinkHead])) {
+        hc08DownlinkHead = (hc08DownlinkHead + 1) % SIM_HC08_BUFFER_SIZE;
+        hc08DownlinkCount--;
+    }
+
+    uint64_t interval = (uint64_t)hc08Config->interval * SIM_HC08_UNIT;
+    hc08Event = SIM_CLOCK_schedule(interval, SIM_HC08_onConnectionEvent);
+}
+
+static void SIM_HC08_reply(const char *reply) {
+    const char *c = reply;
+    for (; *c != '\0'; c++)
+        SIM_UART_receive(*c);
+    SIM_UART_receive('\r');
+    SIM_UART_receive('\n');
+    hc08Stats.atCommands++;
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_HC08_execute(const char *command)
+ *
+ * DESCRIPTION:
+ *      Answers an AT command received before the connection.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*     command     Command without terminator
+ *      GLOBALS:
+ *          SimHc08Config*  hc08Config
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          char[]          hc08Name    Changed by AT+NAME=
+ *
+ *  NOTE:
+ *      Any other line is dropped, nobody is connected to receive it.
+ */
+static void SIM_HC08_execute(const char *command) {
+    char reply[SIM_HC08_AT_SIZE + SIM_HC08_NAME_SIZE];
+    if (strncmp(command, "AT", 2) != 0) {
+        hc08Stats.droppedBytes += strlen(command);
+    } else if (strcmp(command, "AT") == 0 || strcmp(command, "AT+RESET") == 0) {
+        SIM_HC08_reply("OK");
+    } else if (strcmp(command, "AT+VERSION") == 0) {
+        SIM_HC08_reply(SIM_HC08_VERSION);
+    } else if (strncmp(command, "AT+NAME=", 8) == 0 && command[8] != '\0') {
+        snprintf(hc08Name, sizeof(hc08Name), "%s", command + 8);
+        snprintf(reply, sizeof(reply), "OK+Name:%s", hc08Name);
+        SIM_HC08_reply(reply);
+    } else if (strcmp(command, "AT+NAME") == 0) {
+        snprintf(reply, sizeof(reply), "OK+Name:%s", hc08Name);
+        SIM_HC08_reply(reply);
+    } else if (strcmp(command, "AT+BAUD") == 0) {
+        snprintf(reply, sizeof(reply), "OK+Baud:%u", SIM_UART_getBaud());
+        SIM_HC08_reply(reply);
+    } else if (strcmp(command, "AT+CINT") == 0) {
+        snprintf(reply, sizeof(reply), "OK+Cint:%u", hc08Config->interval);
+        SIM_HC08_reply(reply);
+    } else {
+        SIM_HC08_reply("ERROR");
+    }
+}
+
+void SIM_HC08_init(const SimHc08Config *config) {
+    if (hc08Config != NULL)
+        SIM_CLOCK_cancel(hc08Event);
+    hc08Config = config;
+    hc08Event = SIM_CLOCK_NO_EVENT;
+    hc08IsConnected = false;
+    hc08UplinkHead = 0;
+    hc08UplinkCount = 0;
+    hc08DownlinkHead = 0;
+    hc08DownlinkCount = 0;
+    hc08CommandLength = 0;
+    snprintf(hc08Name, sizeof(hc08Name), "%s", SIM_HC08_DEFAULT_NAME);
+    memset(&hc08Stats, 0, sizeof(hc08Stats));
+    if (config != NULL)
+        hc08Event = SIM_CLOCK_schedule(config->connectDelay, SIM_HC08_onConnectionEvent);
+}
+
+bool SIM_HC08_isEnabled() { return hc08Config != NULL; }
+
+bool SIM_HC08_isConnected() { return hc08Config != NULL && hc08IsConnected; }
+
+void SIM_HC08_fromUart(char c) {
+    // [1] Before the connection the bytes are AT commands
+    if (!hc08IsConnected) {
+        if (c == '\r' || c == '\n') {
+            hc08Command[hc08CommandLength] = '\0';
+            if (hc08CommandLength > 0)
+                SIM_HC08_execute(hc08Command);
+            hc08CommandLength = 0;
+        } else if (hc08CommandLength < SIM_HC08_AT_SIZE - 1) {
+            hc08Command[hc08CommandLength++] = c;
+        } else {
+            hc08Stats.droppedBytes++;
+        }
+        return;
+    }
+
+    // [2] After the connection they wait for a notification
+    if (hc08UplinkCount >= hc08Config->uplinkBuffer) {
+        hc08Stats.droppedBytes++;
+        return;
+    }
+    uint16_t tail = (hc08UplinkHead + hc08UplinkCount) % SIM_HC08_BUFFER_SIZE;
+    hc08Uplink[tail] = c;
+    hc08Arrival[tail] = SIM_CLOCK_now();
+    hc08UplinkCount++;
+}
+
+SimHc08Stats SIM_HC08_getStats() { return hc08Stats; }
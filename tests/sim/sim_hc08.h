@@ -0,0 +1,255 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_hc08.h
+ *
+ * DESCRIPTION:
+ *      This header provides the emulation of the HC-08 Bluetooth Low Energy module between the
+ *      simulated UART and the pseudo-terminal, that plays the role of the central (phone or PC):
+ *      - the bytes received from the UART wait in the buffer of the module and leave it only at
+ *        the connection events, in notifications of at most 20 bytes
+ *      - the central writes at most 20 bytes per packet, at the connection events too
+ *      - a limited number of packets per direction fits in a connection event
+ *      - before the connection the module answers the AT commands and drops the other bytes
+ *
+ * PUBLIC FUNCTIONS:
+ *      SimHc08Config   SIM_HC08_defaultConfig()
+ *      void            SIM_HC08_init(const SimHc08Config *config)
+ *      bool            SIM_HC08_isEnabled()
+ *      bool            SIM_HC08_isConnected()
+ *      void            SIM_HC08_fromUart(char c)
+ *      SimHc08Stats    SIM_HC08_getStats()
+ *
+ * NOTES:
+ *      The connection interval is a multiple of 1.25ms between 7.5ms and 4s, the central chooses
+ *      it: phones usually pick 7.5 to 50ms. The uplink buffer of the module is not documented,
+ *      the default is an estimate and a full buffer drops the new bytes like the module does
+ *      without hardware flow control.
+ *      Supported AT commands, answered followed by "\r\n" so that the HAL sees a message:
+ *          AT              OK
+ *          AT+VERSION      HC-08V2.2
+ *          AT+NAME         OK+Name:<name>      AT+NAME=<name> sets it
+ *          AT+BAUD         OK+Baud:<baud>
+ *          AT+CINT         OK+Cint:<interval in 1.25ms units>
+ *          AT+RESET        OK
+ *          other           ERROR
+ *      After the connection the module is transparent, AT commands included.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SIM_HC08_H
+#define SIM_HC08_H
+
+#define SIM_HC08_PAYLOAD 20        /* Bytes of a notification or of a write (ATT MTU 23)     */
+#define SIM_HC08_UNIT 1250         /* Granularity of the connection interval (µs)            */
+#define SIM_HC08_BUFFER_SIZE 1024  /* Capacity of the buffers of the emulator                */
+#define SIM_HC08_NAME_SIZE 16      /* Max length of the name of the module                   */
+#define SIM_HC08_AT_SIZE 32        /* Max length of an AT command                            */
+
+/*T************************************************************************************************
+ * NAME: SimHc08Config
+ *
+ * DESCRIPTION:
+ *      Represent the characteristics of the module and of the connection.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint16_t    interval        Connection interval (1.25ms units, 6 to 3200)
+ *              uint8_t     packets         Packets per direction in a connection event
+ *              uint16_t    uplinkBuffer    Bytes waiting for a notification, at most BUFFER_SIZE
+ *              uint16_t    downlinkBuffer  Bytes written by the central and not yet sent on the
+ *                                          UART, at most BUFFER_SIZE
+ *              uint64_t    connectDelay    Time before the central connects (µs)
+ */
+typedef struct {
+    uint16_t interval;
+    uint8_t packets;
+    uint16_t uplinkBuffer;
+    uint16_t downlinkBuffer;
+    uint64_t connectDelay;
+} SimHc08Config;
+
+/*T************************************************************************************************
+ * NAME: SimHc08Stats
+ *
+ * DESCRIPTION:
+ *      Represent the traffic of the emulated link.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    notifications   Packets sent to the central
+ *              uint32_t    uplinkBytes     Bytes sent to the central
+ *              uint64_t    uplinkLatency   Sum of the waits of the bytes in the module (µs)
+ *              uint64_t    maxUplinkLatency    Longest wait of a byte in the module (µs)
+ *              uint32_t    writes          Packets received from the central
+ *              uint32_t    downlinkBytes   Bytes received from the central
+ *              uint32_t    droppedBytes    Bytes lost because the uplink buffer was full or
+ *                                          because nobody was connected
+ *              uint32_t    atCommands      AT commands answered
+ *              uint32_t    events          Connection events
+ */
+typedef struct {
+    uint32_t notifications;
+    uint32_t uplinkBytes;
+    uint64_t uplinkLatency;
+    uint64_t maxUplinkLatency;
+    uint32_t writes;
+    uint32_t downlinkBytes;
+    uint32_t droppedBytes;
+    uint32_t atCommands;
+    uint32_t events;
+} SimHc08Stats;
+
+/*F************************************************************************************************
+ * NAME: SimHc08Config SIM_HC08_defaultConfig()
+ *
+ * DESCRIPTION:
+ *      Returns a connection with a phone: 30ms interval, 4 packets per event.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   SimHc08Config
+ *          Value:  Default characteristics
+ *
+ *  NOTE:
+ */
+SimHc08Config SIM_HC08_defaultConfig();
+
+/*F************************************************************************************************
+ * NAME: void SIM_HC08_init(const SimHc08Config *config)
+ *
+ * DESCRIPTION:
+ *      Places the module between the simulated UART and the pseudo-terminal.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimHc08Config*    config      Characteristics, NULL to remove the module
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It uses the virtual clock, it must be called after SIM_CAR_init(), that removes the module.
+ *      Without the module the UART is connected directly to the pseudo-terminal.
+ */
+void SIM_HC08_init(const SimHc08Config *config);
+
+/*F************************************************************************************************
+ * NAME: bool SIM_HC08_isEnabled()
+ *
+ * DESCRIPTION:
+ *      Tells whether the module is placed between the UART and the pseudo-terminal.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True if the module is emulated
+ *
+ *  NOTE:
+ */
+bool SIM_HC08_isEnabled();
+
+/*F************************************************************************************************
+ * NAME: bool SIM_HC08_isConnected()
+ *
+ * DESCRIPTION:
+ *      Tells whether the central is connected.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  True after the connection delay
+ *
+ *  NOTE:
+ */
+bool SIM_HC08_isConnected();
+
+/*F************************************************************************************************
+ * NAME: void SIM_HC08_fromUart(char c)
+ *
+ * DESCRIPTION:
+ *      Receives a byte transmitted by the microcontroller.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          char        c           Byte at the end of its transmission on the UART
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_HC08_fromUart(char c);
+
+/*F************************************************************************************************
+ * NAME: SimHc08Stats SIM_HC08_getStats()
+ *
+ * DESCRIPTION:
+ *      Returns the traffic since SIM_HC08_init().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   SimHc08Stats
+ *          Value:  Counters of the link
+ *
+ *  NOTE:
+ */
+SimHc08Stats SIM_HC08_getStats();
+
+#endif // SIM_HC08_H
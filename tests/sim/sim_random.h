@@ -0,0 +1,143 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_random.h
+ *
+ * DESCRIPTION:
+ *      This header provides a small seeded pseudo random generator, so that every simulation can
+ *      be reproduced from its seed regardless of the C library in use.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void        SIM_RANDOM_seed(SimRandom *random, uint64_t seed)
+ *      uint64_t    SIM_RANDOM_next(SimRandom *random)
+ *      double      SIM_RANDOM_uniform(SimRandom *random, double min, double max)
+ *      double      SIM_RANDOM_gaussian(SimRandom *random)
+ *
+ * NOTES:
+ *      The generator is a xorshift64*, the normal samples use the Box-Muller transform.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdint.h>
+
+#ifndef SIM_RANDOM_H
+#define SIM_RANDOM_H
+
+/*T************************************************************************************************
+ * NAME: SimRandom
+ *
+ * DESCRIPTION:
+ *      Represent the state of a generator.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint64_t    state       Current state, never zero
+ */
+typedef struct {
+    uint64_t state;
+} SimRandom;
+
+/*F************************************************************************************************
+ * NAME: void SIM_RANDOM_seed(SimRandom *random, uint64_t seed)
+ *
+ * DESCRIPTION:
+ *      Initialises a generator, different seeds produce unrelated sequences.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimRandom*  random      Generator to initialise
+ *          uint64_t    seed        Any value, zero included
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimRandom*  random      State is set
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_RANDOM_seed(SimRandom *random, uint64_t seed);
+
+/*F************************************************************************************************
+ * NAME: uint64_t SIM_RANDOM_next(SimRandom *random)
+ *
+ * DESCRIPTION:
+ *      Returns the next 64 bit value of the sequence.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimRandom*  random      Generator
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimRandom*  random      State is advanced
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint64_t
+ *          Value:  Pseudo random value
+ *
+ *  NOTE:
+ */
+uint64_t SIM_RANDOM_next(SimRandom *random);
+
+/*F************************************************************************************************
+ * NAME: double SIM_RANDOM_uniform(SimRandom *random, double min, double max)
+ *
+ * DESCRIPTION:
+ *      Returns a sample uniformly distributed in [min, max).
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimRandom*  random      Generator
+ *          double      min         Lower bound, included
+ *          double      max         Upper bound, excluded
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimRandom*  random      State is advanced
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   double
+ *          Value:  Pseudo random sample
+ *
+ *  NOTE:
+ */
+double SIM_RANDOM_uniform(SimRandom *random, double min, double max);
+
+/*F************************************************************************************************
+ * NAME: double SIM_RANDOM_gaussian(SimRandom *random)
+ *
+ * DESCRIPTION:
+ *      Returns a sample of a standard normal distribution.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimRandom*  random      Generator
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimRandom*  random      State is advanced
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   double
+ *          Value:  Pseudo random sample
+ *
+ *  NOTE:
+ */
+double SIM_RANDOM_gaussian(SimRandom *random);
+
+#endif // SIM_RANDOM_H
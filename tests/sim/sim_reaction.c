@@ -0,0 +1,215 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_reaction.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the measurement of the reaction of the car to an obstacle.
+ *
+ * PUBLIC FUNCTIONS:
+ *      SimReactionSetup    SIM_REACTION_defaultSetup()
+ *      void                SIM_REACTION_run(const SimReactionSetup *setup, SimReaction *reaction)
+ *
+ * NOTES:
+ *      The car is released in front of the obstacle, as the simulated motors reach their speed at
+ *      once it is the same as an obstacle entering the free threshold while the car is running.
+ *      The detecting measurement is the one whose echo is followed by the stop of the motors: it
+ *      was triggered by the last expiration of the periodic timer, or by the following expiration
+ *      of the shared timer when the servo had to move before the trigger.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <math.h>
+#include <stddef.h>
+
+#include "sim_car.h"
+#include "sim_clock.h"
+#include "sim_random.h"
+#include "sim_reaction.h"
+#include "sim_world.h"
+#include "../infrared_hal.h"
+#include "../motor_hal.h"
+#include "../servo_hal.h"
+#include "../timer_hal.h"
+#include "../ultrasonic_hal.h"
+#include "../../inc/recorder.h"
+
+extern Servo servo; /* Servo of the sensing module */
+
+/*T************************************************************************************************
+ * NAME: SimReactionTrace
+ *
+ * DESCRIPTION:
+ *      Represent the last HAL events of the chain seen after the appearance of the obstacle.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    probe       Last expiration of the periodic timer (ticks)
+ *              uint32_t    servo       Last expiration of the shared timer (ticks)
+ *              uint32_t    echo        Last echo (ticks)
+ *              uint32_t    stop        Stop of the motors (ticks)
+ *              uint16_t    probes      Expirations of the periodic timer
+ *              bool        isStopped   True once the motors stopped
+ */
+typedef struct {
+    uint32_t probe;
+    uint32_t servo;
+    uint32_t echo;
+    uint32_t stop;
+    uint16_t probes;
+    bool isStopped;
+} SimReactionTrace;
+
+SimReactionSetup SIM_REACTION_defaultSetup() {
+    SimReactionSetup setup = {
+        .parameters = PARAMETERS_DEFAULT,
+        .servoPosition = 0,
+        .distance = SENSING_FREE_THRESHOLD - 2,
+        .seed = 1,
+    };
+    return setup;
+}
+
+static void SIM_REACTION_drain(SimReactionTrace *trace) {
+    RecorderEvent event;
+    while (RECORDER_read(&event)) {
+        if (trace->isStopped)
+            continue;
+        switch (event.channel) {
+        case RECORDER_CHANNEL_PERIODIC_TIMER:
+            trace->probe = event.tick;
+            trace->probes++;
+            break;
+        case RECORDER_CHANNEL_SHARED_TIMER:
+            trace->servo = event.tick;
+            break;
+        case RECORDER_CHANNEL_US_ECHO:
+            trace->echo = event.tick;
+            break;
+        case RECORDER_CHANNEL_MOTOR_DIRECTION:
+            if ((event.value & 0xFF) == MOTOR_DIR_STOP) {
+                trace->stop = event.tick;
+                trace->isStopped = true;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_REACTION_placeObstacle(SimWorld *world, const SimCarParams *params,
+ *                                        double distance)
+ *
+ * DESCRIPTION:
+ *      Adds a wall across the path of the car at the given distance from the sensor.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimCarParams* params      Position of the sensor on the car
+ *          double              distance    Distance from the sensor (cm)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimWorld*           world       World in which the car moves
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void SIM_REACTION_placeObstacle(SimWorld *world, const SimCarParams *params,
+                                       double distance) {
+    SimPose pose = SIM_CAR_getPose();
+    double reach = params->sensorOffset + distance;
+    double x = pose.x + reach * cos(pose.heading);
+    double y = pose.y + reach * sin(pose.heading);
+    double dx = SIM_REACTION_OBSTACLE_WIDTH / 2 * -sin(pose.heading);
+    double dy = SIM_REACTION_OBSTACLE_WIDTH / 2 * cos(pose.heading);
+    SIM_WORLD_addSegment(world, x - dx, y - dy, x + dx, y + dy);
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_REACTION_run(const SimReactionSetup *setup, SimReaction *reaction)
+ *
+ * DESCRIPTION:
+ *      [1] Boots the car in an empty room
+ *      [2] Turns the sensor to the servo position and waits for it and for a random part of a
+ *          probe period, so that the phase of the periodic timer changes at every seed
+ *      [3] Places the obstacle, switches to the autonomous mode and follows the HAL events until
+ *          the motors stop
+ *      [4] Splits the reaction in stages
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimReactionSetup* setup       Conditions of the measurement
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimReaction*            reaction    Duration of the stages
+ *      GLOBALS:
+ *          Parameters              parameters  Set to setup->parameters
+ *
+ *  NOTE:
+ */
+void SIM_REACTION_run(const SimReactionSetup *setup, SimReaction *reaction) {
+    // [1] Empty room, the world is static because it is too large for the stack
+    static SimWorld world;
+    SIM_WORLD_init(&world);
+    world.start.x = 0;
+    world.start.y = 0;
+    world.start.heading = 0;
+    SimRandom random;
+    SIM_RANDOM_seed(&random, setup->seed);
+    SimCarParams params = SIM_CAR_defaultParams();
+    parameters = setup->parameters;
+    SIM_CAR_init(&world, &params, SIM_RANDOM_next(&random));
+
+    // [2] Sensor turned without measuring, the remote state does not probe
+    SERVO_HAL_registerPositionReachedCallback(NULL);
+    SERVO_HAL_setPosition(&servo, setup->servoPosition);
+    double period = SIM_CLOCK_TICKS_TO_US(parameters.sensingTimerCount);
+    SIM_CAR_run(SIM_REACTION_PARKING + SIM_RANDOM_uniform(&random, 0, period));
+    SERVO_HAL_registerPositionReachedCallback(US_HAL_triggerMeasurement); // as the sensing module
+
+    // [3] Obstacle and chain
+    SIM_REACTION_placeObstacle(&world, &params, setup->distance);
+    SimReactionTrace trace = {0};
+    SIM_REACTION_drain(&trace);
+    trace.probes = 0;
+    uint32_t appearance = TIMER_HAL_getTicks();
+    IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    SimPose startPose = SIM_CAR_getPose();
+    uint32_t startCollisions = SIM_CAR_getStats().collisions;
+    for (uint64_t t = 0; t < SIM_REACTION_TIMEOUT && !trace.isStopped; t += SIM_REACTION_STEP) {
+        SIM_CAR_run(SIM_REACTION_STEP);
+        SIM_REACTION_drain(&trace);
+    }
+
+    // [4] Stages, the probe is the appearance itself if the detecting measurement started before
+    reaction->isStopped = trace.isStopped;
+    reaction->probes = trace.probes;
+    SimPose pose = SIM_CAR_getPose();
+    reaction->clearance = setup->distance - hypot(pose.x - startPose.x, pose.y - startPose.y);
+    reaction->collisions = SIM_CAR_getStats().collisions - startCollisions;
+    for (uint8_t i = 0; i < SIM_REACTION_NUM_STAGES; i++)
+        reaction->stages[i] = 0;
+    if (!trace.isStopped)
+        return;
+    uint32_t start = trace.probes > 0 ? trace.probe : appearance;
+    uint32_t trigger = start;
+    if ((int32_t)(trace.servo - start) > 0 && (int32_t)(trace.echo - trace.servo) >= 0)
+        trigger = trace.servo;
+    reaction->stages[SIM_REACTION_PROBE] = SIM_CLOCK_TICKS_TO_US(start - appearance);
+    reaction->stages[SIM_REACTION_SERVO] = SIM_CLOCK_TICKS_TO_US(trigger - start);
+    reaction->stages[SIM_REACTION_ECHO] = SIM_CLOCK_TICKS_TO_US(trace.echo - trigger);
+    reaction->stages[SIM_REACTION_DECISION] = SIM_CLOCK_TICKS_TO_US(trace.stop - trace.echo);
+    reaction->stages[SIM_REACTION_TOTAL] = SIM_CLOCK_TICKS_TO_US(trace.stop - appearance);
+}
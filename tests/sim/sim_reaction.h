@@ -0,0 +1,163 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_reaction.h
+ *
+ * DESCRIPTION:
+ *      This header provides the measurement of the reaction of the car to an obstacle, from the
+ *      moment it enters the free threshold to the stop of the motors, split in the stages of the
+ *      chain executed by the application:
+ *      - probe     wait for the periodic timer that starts the detecting measurement
+ *      - servo     travel of the servo to the front, before the trigger
+ *      - echo      ultrasonic measurement, from the trigger to the end of the echo
+ *      - decision  Sensing_Module_onUSMeasurementReady() -> obstacleCallback() ->
+ *                  Powertrain_Module_stop() -> motor HAL
+ *
+ * PUBLIC FUNCTIONS:
+ *      SimReactionSetup    SIM_REACTION_defaultSetup()
+ *      void                SIM_REACTION_run(const SimReactionSetup *setup, SimReaction *reaction)
+ *
+ * NOTES:
+ *      The stages are timed with the HAL events of the recorder, so they follow the unmodified
+ *      application and not a model of it. The decision stage is only code, it takes no virtual
+ *      time on the host: on the car it is the execution time of the callbacks.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../../inc/parameters.h"
+
+#ifndef SIM_REACTION_H
+#define SIM_REACTION_H
+
+#define SIM_REACTION_PARKING 400000     /* Time for the servo to reach its position (µs)     */
+#define SIM_REACTION_TIMEOUT 3000000    /* Time after which the obstacle is missed (µs)      */
+#define SIM_REACTION_STEP 1000          /* Period of the reads of the recorder (µs)          */
+#define SIM_REACTION_OBSTACLE_WIDTH 60  /* Width of the obstacle across the path (cm)        */
+
+/*T************************************************************************************************
+ * NAME: SimReactionStage
+ *
+ * DESCRIPTION:
+ *      Stages of the reaction, SIM_REACTION_TOTAL is their sum.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: SIM_REACTION_PROBE
+ *              SIM_REACTION_SERVO
+ *              SIM_REACTION_ECHO
+ *              SIM_REACTION_DECISION
+ *              SIM_REACTION_TOTAL
+ *              SIM_REACTION_NUM_STAGES
+ */
+typedef enum {
+    SIM_REACTION_PROBE,
+    SIM_REACTION_SERVO,
+    SIM_REACTION_ECHO,
+    SIM_REACTION_DECISION,
+    SIM_REACTION_TOTAL,
+    SIM_REACTION_NUM_STAGES
+} SimReactionStage;
+
+/*T************************************************************************************************
+ * NAME: SimReactionSetup
+ *
+ * DESCRIPTION:
+ *      Represent the conditions of a reaction measurement.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   Parameters  parameters      Probe period (sensingTimerCount), speed (forwardSpeed)
+ *                                          and free threshold of the application
+ *              int8_t      servoPosition   Position of the sensor when the obstacle appears (deg)
+ *              double      distance        Distance of the obstacle from the sensor when it
+ *                                          appears (cm)
+ *              uint64_t    seed            Seed of the noise and of the time of the appearance
+ */
+typedef struct {
+    Parameters parameters;
+    int8_t servoPosition;
+    double distance;
+    uint64_t seed;
+} SimReactionSetup;
+
+/*T************************************************************************************************
+ * NAME: SimReaction
+ *
+ * DESCRIPTION:
+ *      Represent the outcome of a reaction measurement.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   bool        isStopped       False if the car did not stop within TIMEOUT
+ *              uint64_t[]  stages          Duration of every stage (µs)
+ *              uint16_t    probes          Periodic probes started after the appearance
+ *              double      clearance       Distance between the sensor and the obstacle at the
+ *                                          stop (cm)
+ *              uint32_t    collisions      Collisions during the measurement
+ */
+typedef struct {
+    bool isStopped;
+    uint64_t stages[SIM_REACTION_NUM_STAGES];
+    uint16_t probes;
+    double clearance;
+    uint32_t collisions;
+} SimReaction;
+
+/*F************************************************************************************************
+ * NAME: SimReactionSetup SIM_REACTION_defaultSetup()
+ *
+ * DESCRIPTION:
+ *      Returns the build time parameters, the sensor looking ahead and an obstacle appearing 2cm
+ *      inside the free threshold, so that the noise of the sensor rarely hides it.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   SimReactionSetup
+ *          Value:  Default conditions
+ *
+ *  NOTE:
+ */
+SimReactionSetup SIM_REACTION_defaultSetup();
+
+/*F************************************************************************************************
+ * NAME: void SIM_REACTION_run(const SimReactionSetup *setup, SimReaction *reaction)
+ *
+ * DESCRIPTION:
+ *      Releases the car in autonomous mode in front of an obstacle in an empty room, at a random
+ *      phase of the probe period, then times the stages until the motors stop.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimReactionSetup* setup       Conditions of the measurement
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimReaction*            reaction    Duration of the stages
+ *      GLOBALS:
+ *          Parameters              parameters  Set to setup->parameters
+ *
+ *  NOTE:
+ *      With a servo position other than 0 the first probe waits for the servo to turn to the front,
+ *      as after an interrupted lateral check.
+ */
+void SIM_REACTION_run(const SimReactionSetup *setup, SimReaction *reaction);
+
+#endif // SIM_REACTION_H
@@ -0,0 +1,263 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_replay.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the replay of a recording made by the event recorder.
+ *
+ * PUBLIC FUNCTIONS:
+ *      bool            SIM_REPLAY_load(const char *path, bool isBinary, RecorderEvent *events,
+ *                                      uint32_t max, uint32_t *count)
+ *      bool            SIM_REPLAY_save(const char *path, const RecorderEvent *events,
+ *                                      uint32_t count)
+ *      uint32_t        SIM_REPLAY_run(const RecorderEvent *recording, uint32_t count,
+ *                                     RecorderEvent *replayed, uint32_t max)
+ *      SimReplayDiff   SIM_REPLAY_compare(const RecorderEvent *expected, uint32_t expectedCount,
+ *                                         const RecorderEvent *actual, uint32_t actualCount,
+ *                                         uint32_t tolerance)
+ *
+ * NOTES:
+ *      The ring of the recorder is drained after every injected input, a single input never
+ *      produces enough events to fill it.
+ *      The current samples of the motors are not recorded, the detected stalls are injected in
+ *      the stall module instead.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Replay of the detected motor stalls
+ */
+#include <ctype.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sim_replay.h"
+#include "../battery_hal.h"
+#include "../bluetooth_hal.h"
+#include "../infrared_hal.h"
+#include "../servo_hal.h"
+#include "../timer_hal.h"
+#include "../ultrasonic_hal.h"
+#include "../../inc/stall_module.h"
+#include "../../inc/state_machine.h"
+#include "../../inc/system.h"
+
+extern volatile uint8_t batteryTimer; /* Battery notification countdown of the state machine */
+
+uint32_t replayTick;                  /* Current time of the replay clock (ticks)            */
+const RecorderEvent *replayRecording; /* Recording being replayed                            */
+uint32_t replayCount;                 /* Number of recorded events                           */
+uint32_t replayBatteryIndex;          /* Index of the next recorded battery reading          */
+uint16_t replayVoltage;               /* Last recorded battery reading (mV)                  */
+
+bool SIM_REPLAY_load(const char *path, bool isBinary, RecorderEvent *events, uint32_t max,
+                     uint32_t *count) {
+    FILE *file = fopen(path, isBinary ? "rb" : "r");
+    if (file == NULL)
+        return false;
+
+    bool isValid = true;
+    *count = 0;
+    if (isBinary) {
+        // [1] Flash log, up to the first erased slot
+        RecorderEvent event;
+        while (fread(&event, sizeof(event), 1, file) == 1 && event.tick != SIM_REPLAY_ERASED) {
+            if (*count >= max || event.channel >= RECORDER_NUM_CHANNELS) {
+                isValid = false;
+                break;
+            }
+            events[(*count)++] = event;
+        }
+    } else {
+        // [2] Bluetooth stream, the other lines are telemetry
+        char line[SIM_REPLAY_LINE_SIZE];
+        while (isValid && fgets(line, sizeof(line), file) != NULL) {
+            const char *text = strchr(line, RECORDER_STREAM_PREFIX);
+            if (text == NULL)
+                continue;
+
+            for (text++; isxdigit((unsigned char)*text); text += RECORDER_EVENT_TEXT_LENGTH) {
+                if (*count >= max || !RECORDER_decode(text, &events[*count])) {
+                    isValid = false;
+                    break;
+                }
+                (*count)++;
+            }
+        }
+    }
+
+    fclose(file);
+    return isValid;
+}
+
+bool SIM_REPLAY_save(const char *path, const RecorderEvent *events, uint32_t count) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+        return false;
+
+    char text[RECORDER_EVENT_TEXT_LENGTH + 1];
+    text[RECORDER_EVENT_TEXT_LENGTH] = '\0';
+    for (uint32_t i = 0; i < count; i++) {
+        if (i % 2 == 0)
+            fputc(RECORDER_STREAM_PREFIX, file);
+        RECORDER_encode(&events[i], text);
+        fputs(text, file);
+        if (i % 2 == 1 || i == count - 1)
+            fputc('\n', file);
+    }
+    return fclose(file) == 0;
+}
+
+static void SIM_REPLAY_setupPeriodic(uint32_t count) {}
+
+static void SIM_REPLAY_acquireShared(uint32_t count) {}
+
+static void SIM_REPLAY_releaseShared() {}
+
+static uint32_t SIM_REPLAY_getTicks() { return replayTick; }
+
+static const TimerHooks replayTimerHooks = {
+    SIM_REPLAY_setupPeriodic,
+    SIM_REPLAY_acquireShared,
+    SIM_REPLAY_releaseShared,
+    SIM_REPLAY_getTicks,
+};
+
+/*F************************************************************************************************
+ * NAME: uint16_t SIM_REPLAY_onVoltageRead()
+ *
+ * DESCRIPTION:
+ *      Battery hook, returns the recorded readings in order.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          const RecorderEvent*    replayRecording
+ *          uint32_t                replayBatteryIndex
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          uint32_t                replayBatteryIndex  Moved after the returned reading
+ *          uint16_t                replayVoltage       Returned reading
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Voltage (mV)
+ *
+ *  NOTE:
+ *      When the application reads the battery more times than recorded, the last reading is
+ *      repeated and the comparison reports the extra event.
+ */
+static uint16_t SIM_REPLAY_onVoltageRead() {
+    while (replayBatteryIndex < replayCount &&
+           replayRecording[replayBatteryIndex].channel != RECORDER_CHANNEL_BATTERY)
+        replayBatteryIndex++;
+    if (replayBatteryIndex < replayCount)
+        replayVoltage = replayRecording[replayBatteryIndex++].value;
+    return replayVoltage;
+}
+
+static uint32_t SIM_REPLAY_irFrame(uint16_t value) {
+    uint8_t command = value;
+    if (value >> 8)
+        return 0x00FF0000 | command << 8 | (uint8_t)~command;
+    return 0xFFFF0000 | command << 8 | 0xFF;
+}
+
+static uint32_t SIM_REPLAY_drain(RecorderEvent *replayed, uint32_t length, uint32_t max) {
+    RecorderEvent event;
+    while (RECORDER_read(&event))
+        if (length < max)
+            replayed[length++] = event;
+    return length;
+}
+
+uint32_t SIM_REPLAY_run(const RecorderEvent *recording, uint32_t count, RecorderEvent *replayed,
+                        uint32_t max) {
+    // [1] Replay clock and HAL hooks
+    replayTick = 0;
+    replayRecording = recording;
+    replayCount = count;
+    replayBatteryIndex = 0;
+    replayVoltage = 0;
+    TIMER_HAL_registerHooks(&replayTimerHooks);
+    SERVO_HAL_registerPositionHook(NULL);
+    US_HAL_registerTriggerHook(NULL);
+    BATTERY_HAL_registerVoltageHook(SIM_REPLAY_onVoltageRead);
+    BT_HAL_registerTransmitHook(NULL);
+
+    // [2] Boot, as done by main()
+    FSM_currentState = STATE_INIT;
+    batteryTimer = 1;
+    System_init();
+    FSM_stateMachine[FSM_currentState].function();
+    uint32_t length = SIM_REPLAY_drain(replayed, 0, max);
+
+    // [3] Inputs, the outputs and the battery readings are produced by the application
+    char message[SIM_REPLAY_MESSAGE_SIZE];
+    uint16_t messageLength = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const RecorderEvent *event = &recording[i];
+        replayTick = event->tick;
+        switch (event->channel) {
+        case RECORDER_CHANNEL_PERIODIC_TIMER:
+            TIMER_HAL_triggerPeriodicTimer();
+            break;
+        case RECORDER_CHANNEL_SHARED_TIMER:
+            TIMER_HAL_triggerSharedTimer();
+            break;
+        case RECORDER_CHANNEL_US_ECHO:
+            US_HAL_triggerNextAction(event->value);
+            break;
+        case RECORDER_CHANNEL_IR_FRAME:
+            IR_HAL_triggerFrameReceived(SIM_REPLAY_irFrame(event->value));
+            break;
+        case RECORDER_CHANNEL_BT_RX:
+            // two chars per event, the message is complete at the terminator
+            for (uint8_t shift = 0; shift <= 8; shift += 8) {
+                char c = event->value >> shift;
+                if (messageLength < sizeof(message) - 1 && c != '\0')
+                    message[messageLength++] = c;
+                if (c == '\0') {
+                    message[messageLength] = '\0';
+                    BT_HAL_triggerMessageReceived(message);
+                    messageLength = 0;
+                    break;
+                }
+            }
+            break;
+        case RECORDER_CHANNEL_MOTOR_STALL:
+            Stall_Module_raise(event->value >> 14 & 1 ? STALL_EVENT_OVERCURRENT : STALL_EVENT_STALL,
+                               event->value >> 13 & 1 ? MOTOR_INIT_RIGHT : MOTOR_INIT_LEFT,
+                               event->value & 0x1FFF);
+            break;
+        default:
+            break;
+        }
+        length = SIM_REPLAY_drain(replayed, length, max);
+    }
+    return length;
+}
+
+SimReplayDiff SIM_REPLAY_compare(const RecorderEvent *expected, uint32_t expectedCount,
+                                 const RecorderEvent *actual, uint32_t actualCount,
+                                 uint32_t tolerance) {
+    SimReplayDiff diff = {false, 0, 0};
+    uint32_t count = expectedCount < actualCount ? expectedCount : actualCount;
+    for (; diff.matched < count; diff.matched++) {
+        const RecorderEvent *a = &expected[diff.matched];
+        const RecorderEvent *b = &actual[diff.matched];
+        uint32_t drift = a->tick > b->tick ? a->tick - b->tick : b->tick - a->tick;
+        if (a->channel != b->channel || a->value != b->value || drift > tolerance)
+            break;
+        if (drift > diff.maxDrift)
+            diff.maxDrift = drift;
+    }
+    diff.isEqual = diff.matched == expectedCount && diff.matched == actualCount;
+    return diff;
+}
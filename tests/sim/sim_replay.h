@@ -0,0 +1,189 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_replay.h
+ *
+ * DESCRIPTION:
+ *      This header provides the replay of a recording made by the event recorder: the recorded
+ *      inputs are injected into the application at their original time and the outputs produced
+ *      by the application are compared with the recorded ones.
+ *
+ * PUBLIC FUNCTIONS:
+ *      bool            SIM_REPLAY_load(const char *path, bool isBinary, RecorderEvent *events,
+ *                                      uint32_t max, uint32_t *count)
+ *      bool            SIM_REPLAY_save(const char *path, const RecorderEvent *events,
+ *                                      uint32_t count)
+ *      uint32_t        SIM_REPLAY_run(const RecorderEvent *recording, uint32_t count,
+ *                                     RecorderEvent *replayed, uint32_t max)
+ *      SimReplayDiff   SIM_REPLAY_compare(const RecorderEvent *expected, uint32_t expectedCount,
+ *                                         const RecorderEvent *actual, uint32_t actualCount,
+ *                                         uint32_t tolerance)
+ *
+ * NOTES:
+ *      A recording is either the text received via Bluetooth (every line that contains
+ *      RECORDER_STREAM_PREFIX, whatever precedes it) or the binary dump of the flash log.
+ *      The replay uses a virtual clock that jumps to the tick of every recorded input, the
+ *      periodic and shared timers expire only when the recording says so and the battery returns
+ *      the recorded readings. Since the mocked HALs record the injected inputs again, the replayed
+ *      stream is expected to be identical to the recording, ticks included.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../../inc/recorder.h"
+
+#ifndef SIM_REPLAY_H
+#define SIM_REPLAY_H
+
+#define SIM_REPLAY_LINE_SIZE 256     /* Max length of a line of a text recording             */
+#define SIM_REPLAY_MESSAGE_SIZE 256  /* Max length of a replayed Bluetooth message           */
+#define SIM_REPLAY_ERASED 0xFFFFFFFF /* Tick of an erased slot of the flash log              */
+
+/*T************************************************************************************************
+ * NAME: SimReplayDiff
+ *
+ * DESCRIPTION:
+ *      Represent the outcome of the comparison between two streams of events.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   bool        isEqual     True if the streams match within the tolerance
+ *              uint32_t    matched     Events that match before the first difference
+ *              uint32_t    maxDrift    Largest time difference among the matched events (ticks)
+ */
+typedef struct {
+    bool isEqual;
+    uint32_t matched;
+    uint32_t maxDrift;
+} SimReplayDiff;
+
+/*F************************************************************************************************
+ * NAME: bool SIM_REPLAY_load(const char *path, bool isBinary, RecorderEvent *events, uint32_t max,
+ *                            uint32_t *count)
+ *
+ * DESCRIPTION:
+ *      Reads a recording from a file.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*     path        Path of the recording
+ *          bool            isBinary    True for a dump of the flash log, false for the text stream
+ *          uint32_t        max         Capacity of events
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          RecorderEvent*  events      Recorded events
+ *          uint32_t*       count       Number of recorded events
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the file cannot be read, contains an invalid event or more than max
+ *
+ *  NOTE:
+ *      A binary dump ends at the first erased slot.
+ */
+bool SIM_REPLAY_load(const char *path, bool isBinary, RecorderEvent *events, uint32_t max,
+                     uint32_t *count);
+
+/*F************************************************************************************************
+ * NAME: bool SIM_REPLAY_save(const char *path, const RecorderEvent *events, uint32_t count)
+ *
+ * DESCRIPTION:
+ *      Writes a stream of events with the same format used by the Bluetooth sink.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*             path        Path of the file
+ *          const RecorderEvent*    events      Events to write
+ *          uint32_t                count       Number of events
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the file cannot be written
+ *
+ *  NOTE:
+ */
+bool SIM_REPLAY_save(const char *path, const RecorderEvent *events, uint32_t count);
+
+/*F************************************************************************************************
+ * NAME: uint32_t SIM_REPLAY_run(const RecorderEvent *recording, uint32_t count,
+ *                               RecorderEvent *replayed, uint32_t max)
+ *
+ * DESCRIPTION:
+ *      Boots the application on the replay clock, injects the recorded inputs in order and
+ *      collects every event recorded in the meantime.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const RecorderEvent*    recording   Recorded events, outputs are ignored
+ *          uint32_t                count       Number of recorded events
+ *          uint32_t                max         Capacity of replayed
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          RecorderEvent*          replayed    Events recorded during the replay
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Number of replayed events, at most max
+ *
+ *  NOTE:
+ *      It replaces the hooks of the mocked HALs, a simulation must call SIM_CAR_init() again.
+ */
+uint32_t SIM_REPLAY_run(const RecorderEvent *recording, uint32_t count, RecorderEvent *replayed,
+                        uint32_t max);
+
+/*F************************************************************************************************
+ * NAME: SimReplayDiff SIM_REPLAY_compare(const RecorderEvent *expected, uint32_t expectedCount,
+ *                                        const RecorderEvent *actual, uint32_t actualCount,
+ *                                        uint32_t tolerance)
+ *
+ * DESCRIPTION:
+ *      Compares two streams event by event: channel and value must be equal and the ticks must not
+ *      differ more than the tolerance.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const RecorderEvent*    expected        Reference stream, usually the recording
+ *          uint32_t                expectedCount   Number of reference events
+ *          const RecorderEvent*    actual          Stream to check, usually the replay
+ *          uint32_t                actualCount     Number of events to check
+ *          uint32_t                tolerance       Accepted time difference (ticks)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   SimReplayDiff
+ *          Value:  Result of the comparison
+ *
+ *  NOTE:
+ *      The comparison stops at the first difference, after it the streams are no longer aligned.
+ */
+SimReplayDiff SIM_REPLAY_compare(const RecorderEvent *expected, uint32_t expectedCount,
+                                 const RecorderEvent *actual, uint32_t actualCount,
+                                 uint32_t tolerance);
+
+#endif // SIM_REPLAY_H
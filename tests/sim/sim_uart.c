@@ -0,0 +1,325 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_uart.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the UART of the simulated Bluetooth module, exposed on the host as
+ *      a pseudo-terminal.
+ *
+ * PUBLIC FUNCTIONS:
+ *      bool            SIM_UART_open(uint32_t baud, char *name, size_t size)
+ *      void            SIM_UART_close()
+ *      void            SIM_UART_transmit(const char *message)
+ *      void            SIM_UART_poll(uint64_t timeout)
+ *      SimUartStats    SIM_UART_getStats()
+ *      uint32_t        SIM_UART_getBaud()
+ *      bool            SIM_UART_receive(char c)
+ *      uint16_t        SIM_UART_readTerminal(char *data, uint16_t max)
+ *      void            SIM_UART_writeTerminal(const char *data, uint16_t length)
+ *
+ * NOTES:
+ *      The slave side of the pseudo-terminal is kept open by the simulator as well, so the host
+ *      tools can connect and disconnect at any time without hanging up the master side.
+ *      The bit times are accumulated as fractions of a microsecond, so the long term rate is exact
+ *      even when the byte time is not an integer (1041.67µs at 9600 baud).
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     The HC-08 emulator can sit between the UART and the terminal
+ */
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "sim_clock.h"
+#include "sim_fault.h"
+#include "sim_hc08.h"
+#include "sim_uart.h"
+
+/*T************************************************************************************************
+ * NAME: SimUartBuffer
+ *
+ * DESCRIPTION:
+ *      Represent the bytes waiting for the line in one direction.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   char[]      data        Circular buffer
+ *              uint16_t    head        Index of the oldest byte
+ *              uint16_t    count       Number of bytes
+ */
+typedef struct {
+    char data[SIM_UART_BUFFER_SIZE];
+    uint16_t head;
+    uint16_t count;
+} SimUartBuffer;
+
+int masterFd = -1;                     /* Side of the pseudo-terminal used by the simulator     */
+int slaveFd = -1;                      /* Side of the pseudo-terminal used by the host tools    */
+uint32_t uartBaud;                     /* Baud rate of the link                                 */
+SimUartBuffer txBuffer;                /* Bytes sent by the application                         */
+SimUartBuffer rxBuffer;                /* Bytes sent by the host tools                          */
+uint16_t txMessages;                   /* Messages in txBuffer                                  */
+uint32_t txEvent;                      /* End of the byte being transmitted                     */
+uint32_t rxEvent;                      /* End of the byte being received                        */
+uint64_t txResidual;                   /* Bit times not yet converted to µs (µs * baud)         */
+uint64_t rxResidual;                   /* Same for the reception                                */
+char rxMessage[SIM_UART_MESSAGE_SIZE]; /* Message being received                                */
+uint16_t rxLength;                     /* Length of rxMessage                                   */
+SimUartStats uartStats;                /* Traffic of the link                                   */
+
+static void SIM_UART_push(SimUartBuffer *buffer, char c) {
+    buffer->data[(buffer->head + buffer->count) % SIM_UART_BUFFER_SIZE] = c;
+    buffer->count++;
+}
+
+static char SIM_UART_pop(SimUartBuffer *buffer) {
+    char c = buffer->data[buffer->head];
+    buffer->head = (buffer->head + 1) % SIM_UART_BUFFER_SIZE;
+    buffer->count--;
+    return c;
+}
+
+static uint64_t SIM_UART_byteTime(uint64_t *residual) {
+    *residual += SIM_UART_BITS_PER_BYTE * 1000000ull;
+    uint64_t time = *residual / uartBaud;
+    *residual %= uartBaud;
+    return time;
+}
+
+static speed_t SIM_UART_speed(uint32_t baud) {
+    switch (baud) {
+    case 1200:
+        return B1200;
+    case 2400:
+        return B2400;
+    case 4800:
+        return B4800;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+    case 115200:
+        return B115200;
+    default:
+        return B9600;
+    }
+}
+
+bool SIM_UART_open(uint32_t baud, char *name, size_t size) {
+    if (baud == 0)
+        return false;
+
+    // [1] Pseudo-terminal
+    masterFd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (masterFd < 0)
+        return false;
+    const char *path = NULL;
+    if (grantpt(masterFd) != 0 || unlockpt(masterFd) != 0 || (path = ptsname(masterFd)) == NULL ||
+        (slaveFd = open(path, O_RDWR | O_NOCTTY)) < 0) {
+        close(masterFd);
+        masterFd = -1;
+        return false;
+    }
+    snprintf(name, size, "%s", path);
+
+    // [2] Raw bytes, as on a serial port
+    struct termios attributes;
+    if (tcgetattr(slaveFd, &attributes) == 0) {
+        cfmakeraw(&attributes);
+        cfsetspeed(&attributes, SIM_UART_speed(baud));
+        tcsetattr(slaveFd, TCSANOW, &attributes);
+    }
+
+    // [3] Link state
+    uartBaud = baud;
+    memset(&txBuffer, 0, sizeof(txBuffer));
+    memset(&rxBuffer, 0, sizeof(rxBuffer));
+    txMessages = 0;
+    txEvent = SIM_CLOCK_NO_EVENT;
+    rxEvent = SIM_CLOCK_NO_EVENT;
+    txResidual = 0;
+    rxResidual = 0;
+    rxLength = 0;
+    memset(&uartStats, 0, sizeof(uartStats));
+    return true;
+}
+
+void SIM_UART_close() {
+    if (masterFd < 0)
+        return;
+    SIM_CLOCK_cancel(txEvent);
+    SIM_CLOCK_cancel(rxEvent);
+    close(slaveFd);
+    close(masterFd);
+    slaveFd = -1;
+    masterFd = -1;
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_UART_onTxByte()
+ *
+ * DESCRIPTION:
+ *      End of the transmission of a byte: passes it to the Bluetooth module, or writes it to the
+ *      pseudo-terminal without the module, and starts the next.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimUartBuffer   txBuffer
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimUartBuffer   txBuffer        The byte is removed
+ *          uint16_t        txMessages      Decremented at the end of a message
+ *          uint32_t        txEvent         End of the next byte
+ *          SimUartStats    uartStats       Updated
+ *
+ *  NOTE:
+ *      A byte that the pseudo-terminal cannot accept is lost, the line does not wait.
+ */
+static void SIM_UART_onTxByte() {
+    char c = SIM_UART_pop(&txBuffer);
+    if (SIM_HC08_isEnabled())
+        SIM_HC08_fromUart(c);
+    else
+        SIM_UART_writeTerminal(&c, 1);
+    if (c == '\n')
+        txMessages--;
+
+    txEvent = SIM_CLOCK_NO_EVENT;
+    if (txBuffer.count > 0)
+        txEvent = SIM_CLOCK_schedule(SIM_UART_byteTime(&txResidual), SIM_UART_onTxByte);
+}
+
+void SIM_UART_transmit(const char *message) {
+    if (masterFd < 0)
+        return;
+
+    size_t length = strlen(message);
+    if (txMessages >= SIM_UART_TX_MESSAGES || txBuffer.count + length + 2 > SIM_UART_BUFFER_SIZE) {
+        uartStats.droppedMessages++;
+        return;
+    }
+    for (size_t i = 0; i < length; i++)
+        SIM_UART_push(&txBuffer, message[i]);
+    SIM_UART_push(&txBuffer, '\r');
+    SIM_UART_push(&txBuffer, '\n');
+    txMessages++;
+
+    if (txEvent == SIM_CLOCK_NO_EVENT)
+        txEvent = SIM_CLOCK_schedule(SIM_UART_byteTime(&txResidual), SIM_UART_onTxByte);
+}
+
+/*F************************************************************************************************
+ * NAME: void SIM_UART_onRxByte()
+ *
+ * DESCRIPTION:
+ *      End of the reception of a byte, as done by the reception interrupt of the firmware HAL:
+ *      [1] Leading terminators are ignored
+ *      [2] A full buffer delivers the partial message, the byte is lost
+ *      [3] A terminator delivers the message, any other byte is appended
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimUartBuffer   rxBuffer
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          SimUartBuffer   rxBuffer        The byte is removed
+ *          char[]          rxMessage       Updated
+ *          uint32_t        rxEvent         End of the next byte
+ *          SimUartStats    uartStats       Updated
+ *
+ *  NOTE:
+ */
+static void SIM_UART_onRxByte() {
+    char c = SIM_UART_pop(&rxBuffer);
+    bool isTerminator = c == '\r' || c == '\n' || c == '\0';
+
+    rxEvent = SIM_CLOCK_NO_EVENT;
+    if (rxBuffer.count > 0)
+        rxEvent = SIM_CLOCK_schedule(SIM_UART_byteTime(&rxResidual), SIM_UART_onRxByte);
+
+    // [1] Leading terminators
+    if (rxLength == 0 && isTerminator)
+        return;
+
+    // [2] and [3] Complete message
+    if (rxLength == SIM_UART_MESSAGE_SIZE - 1 || isTerminator) {
+        rxMessage[rxLength] = '\0';
+        rxLength = 0;
+        uartStats.rxMessages++;
+        SIM_FAULT_sendBTMessage(rxMessage);
+    } else {
+        rxMessage[rxLength++] = c;
+    }
+}
+
+void SIM_UART_poll(uint64_t timeout) {
+    if (masterFd < 0)
+        return;
+
+    // the Bluetooth module reads the terminal only at the connection events
+    struct pollfd fd = {masterFd, POLLIN, 0};
+    struct timespec time = {timeout / 1000000, timeout % 1000000 * 1000};
+    if (rxBuffer.count == SIM_UART_BUFFER_SIZE || SIM_HC08_isEnabled())
+        fd.fd = -1; // wait without reading
+    if (ppoll(&fd, 1, &time, NULL) <= 0 || !(fd.revents & POLLIN))
+        return;
+
+    char bytes[SIM_UART_BUFFER_SIZE];
+    uint16_t n = SIM_UART_readTerminal(bytes, SIM_UART_BUFFER_SIZE - rxBuffer.count);
+    for (uint16_t i = 0; i < n; i++)
+        SIM_UART_receive(bytes[i]);
+}
+
+SimUartStats SIM_UART_getStats() { return uartStats; }
+
+uint32_t SIM_UART_getBaud() { return uartBaud; }
+
+bool SIM_UART_receive(char c) {
+    if (rxBuffer.count == SIM_UART_BUFFER_SIZE)
+        return false;
+    SIM_UART_push(&rxBuffer, c);
+    if (rxEvent == SIM_CLOCK_NO_EVENT)
+        rxEvent = SIM_CLOCK_schedule(SIM_UART_byteTime(&rxResidual), SIM_UART_onRxByte);
+    return true;
+}
+
+uint16_t SIM_UART_readTerminal(char *data, uint16_t max) {
+    if (masterFd < 0)
+        return 0;
+    ssize_t n = read(masterFd, data, max);
+    if (n <= 0)
+        return 0;
+    uartStats.rxBytes += n;
+    return n;
+}
+
+void SIM_UART_writeTerminal(const char *data, uint16_t length) {
+    if (masterFd < 0)
+        return;
+    ssize_t n = write(masterFd, data, length);
+    if (n < 0)
+        n = 0;
+    uartStats.txBytes += n;
+    uartStats.droppedBytes += length - n;
+}
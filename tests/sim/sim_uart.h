@@ -0,0 +1,297 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_uart.h
+ *
+ * DESCRIPTION:
+ *      This header provides the UART between the application and the HC-08 Bluetooth module of
+ *      the simulated car, exposed on the host as a pseudo-terminal: any serial tool (screen, the
+ *      telemetry decoders, scripted command senders) can open it as it opens the serial port of
+ *      the module paired with a real car.
+ *
+ * PUBLIC FUNCTIONS:
+ *      bool            SIM_UART_open(uint32_t baud, char *name, size_t size)
+ *      void            SIM_UART_close()
+ *      void            SIM_UART_transmit(const char *message)
+ *      void            SIM_UART_poll(uint64_t timeout)
+ *      SimUartStats    SIM_UART_getStats()
+ *      uint32_t        SIM_UART_getBaud()
+ *      bool            SIM_UART_receive(char c)
+ *      uint16_t        SIM_UART_readTerminal(char *data, uint16_t max)
+ *      void            SIM_UART_writeTerminal(const char *data, uint16_t length)
+ *
+ * NOTES:
+ *      Every byte takes 10 bit times (start, 8 data, stop) in both directions, so at 9600 baud the
+ *      link carries 960 bytes per second of virtual time like the real one. The transmitted
+ *      messages are followed by "\r\n" and at most SIM_UART_TX_MESSAGES can wait for the line,
+ *      as in the queue of the firmware HAL; the received bytes are split into messages at '\r',
+ *      '\n' or '\0' like the reception interrupt does and go through the fault injector.
+ *      The pseudo-terminal does not slow the simulation down, the caller must keep the virtual
+ *      clock in step with the wall clock (see the simulator tool) while polling the input.
+ *      When the HC-08 emulator is enabled (see sim_hc08.h) it sits between the UART and the
+ *      pseudo-terminal and uses the last three functions, otherwise the UART is connected to the
+ *      pseudo-terminal directly, as through an ideal module.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Interface for the HC-08 emulator
+ * 19 Oct 2026  Maintainers     Room for 16 messages, as the ring of the HAL
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef SIM_UART_H
+#define SIM_UART_H
+
+#define SIM_UART_BAUD 9600         /* Baud rate configured by the firmware HAL               */
+#define SIM_UART_BITS_PER_BYTE 10  /* Start, 8 data and stop bits                            */
+#define SIM_UART_TX_MESSAGES 16    /* Messages waiting for the line, as RING_SIZE            */
+#define SIM_UART_BUFFER_SIZE 512   /* Bytes waiting for the line in each direction           */
+#define SIM_UART_MESSAGE_SIZE 256  /* Max length of a received message, as the firmware HAL  */
+
+/*T************************************************************************************************
+ * NAME: SimUartStats
+ *
+ * DESCRIPTION:
+ *      Represent the traffic of the simulated UART.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    txBytes         Bytes written to the pseudo-terminal
+ *              uint32_t    rxBytes         Bytes read from the pseudo-terminal
+ *              uint32_t    rxMessages      Messages delivered to the application
+ *              uint32_t    droppedMessages Messages lost because the transmission queue was full
+ *              uint32_t    droppedBytes    Bytes lost because nobody reads the pseudo-terminal
+ */
+typedef struct {
+    uint32_t txBytes;
+    uint32_t rxBytes;
+    uint32_t rxMessages;
+    uint32_t droppedMessages;
+    uint32_t droppedBytes;
+} SimUartStats;
+
+/*F************************************************************************************************
+ * NAME: bool SIM_UART_open(uint32_t baud, char *name, size_t size)
+ *
+ * DESCRIPTION:
+ *      Creates the pseudo-terminal in raw mode and starts forwarding the Bluetooth traffic.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t    baud        Baud rate of the link
+ *          size_t      size        Capacity of name
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          char*       name        Path of the device to open, e.g. /dev/pts/3
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the pseudo-terminal cannot be created
+ *
+ *  NOTE:
+ *      It uses the virtual clock, it must be called after SIM_CAR_init().
+ */
+bool SIM_UART_open(uint32_t baud, char *name, size_t size);
+
+/*F************************************************************************************************
+ * NAME: void SIM_UART_close()
+ *
+ * DESCRIPTION:
+ *      Closes the pseudo-terminal, the bytes not yet transmitted are lost.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_UART_close();
+
+/*F************************************************************************************************
+ * NAME: void SIM_UART_transmit(const char *message)
+ *
+ * DESCRIPTION:
+ *      Queues a message sent by the application, followed by "\r\n".
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char* message     Message sent through the Bluetooth HAL
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      It does nothing when the pseudo-terminal is closed.
+ */
+void SIM_UART_transmit(const char *message);
+
+/*F************************************************************************************************
+ * NAME: void SIM_UART_poll(uint64_t timeout)
+ *
+ * DESCRIPTION:
+ *      Waits up to timeout for bytes written by the host tools and queues them for the reception.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t    timeout     Maximum wall time to wait (µs), 0 to only check
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The bytes reach the application at the baud rate as the virtual clock advances. When the
+ *      reception buffer is full the bytes stay in the pseudo-terminal, like with flow control.
+ */
+void SIM_UART_poll(uint64_t timeout);
+
+/*F************************************************************************************************
+ * NAME: SimUartStats SIM_UART_getStats()
+ *
+ * DESCRIPTION:
+ *      Returns the traffic since SIM_UART_open().
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   SimUartStats
+ *          Value:  Counters of the link
+ *
+ *  NOTE:
+ */
+SimUartStats SIM_UART_getStats();
+
+/*F************************************************************************************************
+ * NAME: uint32_t SIM_UART_getBaud()
+ *
+ * DESCRIPTION:
+ *      Returns the baud rate of the link.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Baud rate given to SIM_UART_open()
+ *
+ *  NOTE:
+ */
+uint32_t SIM_UART_getBaud();
+
+/*F************************************************************************************************
+ * NAME: bool SIM_UART_receive(char c)
+ *
+ * DESCRIPTION:
+ *      Queues a byte for the microcontroller, it is delivered at the baud rate.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          char        c           Byte sent by the Bluetooth module
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the reception buffer is full, the byte is not queued
+ *
+ *  NOTE:
+ */
+bool SIM_UART_receive(char c);
+
+/*F************************************************************************************************
+ * NAME: uint16_t SIM_UART_readTerminal(char *data, uint16_t max)
+ *
+ * DESCRIPTION:
+ *      Reads the bytes written by the host tools without waiting.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint16_t    max         Capacity of data
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          char*       data        Bytes read
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Number of bytes read, 0 if there are none or the terminal is closed
+ *
+ *  NOTE:
+ */
+uint16_t SIM_UART_readTerminal(char *data, uint16_t max);
+
+/*F************************************************************************************************
+ * NAME: void SIM_UART_writeTerminal(const char *data, uint16_t length)
+ *
+ * DESCRIPTION:
+ *      Writes bytes for the host tools.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char* data        Bytes to write
+ *          uint16_t    length      Number of bytes
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The bytes that the terminal cannot accept are counted as dropped.
+ */
+void SIM_UART_writeTerminal(const char *data, uint16_t length);
+
+#endif // SIM_UART_H
@@ -0,0 +1,260 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_world.c
+ *
+ * DESCRIPTION:
+ *      This source file provides a 2-D world made of wall segments, used by the simulator to
+ *      detect collisions and to compute the echoes of the ultrasonic sensor.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    SIM_WORLD_init(SimWorld *world)
+ *      bool    SIM_WORLD_addSegment(SimWorld *world, double x1, double y1, double x2, double y2)
+ *      bool    SIM_WORLD_addPolygon(SimWorld *world, const double *points, uint16_t count)
+ *      bool    SIM_WORLD_addLowPolygon(SimWorld *world, const double *points, uint16_t count)
+ *      bool    SIM_WORLD_load(SimWorld *world, const char *path)
+ *      double  SIM_WORLD_castRay(const SimWorld *world, double x, double y, double angle,
+ *                                double maxRange)
+ *      double  SIM_WORLD_clearance(const SimWorld *world, double x, double y)
+ *      uint16_t SIM_WORLD_addRandomBoxes(SimWorld *world, uint16_t count, double margin,
+ *                                        SimRandom *random)
+ *
+ * NOTES:
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Low obstacles, under the ultrasonic beam
+ */
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_world.h"
+
+#define SIM_WORLD_LINE_SIZE 1024 /* Max length of a line of a map file                       */
+#define SIM_WORLD_BOX_ATTEMPTS 100 /* Random positions tried for every box                    */
+
+void SIM_WORLD_init(SimWorld *world) {
+    world->segmentCount = 0;
+    world->start.x = 0;
+    world->start.y = 0;
+    world->start.heading = 0;
+}
+
+bool SIM_WORLD_addSegment(SimWorld *world, double x1, double y1, double x2, double y2) {
+    if (world->segmentCount >= SIM_WORLD_MAX_SEGMENTS)
+        return false;
+
+    SimSegment *segment = &world->segments[world->segmentCount++];
+    segment->x1 = x1;
+    segment->y1 = y1;
+    segment->x2 = x2;
+    segment->y2 = y2;
+    segment->isLow = false;
+    return true;
+}
+
+/*F************************************************************************************************
+ * NAME: bool SIM_WORLD_addPolyline(SimWorld *world, const double *points, uint16_t count,
+ *                                  bool closed)
+ *
+ * DESCRIPTION:
+ *      Adds a sequence of connected walls to the world.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       Target world
+ *          const double*   points      Vertices as consecutive (x, y) couples
+ *          uint16_t        count       Number of vertices
+ *          bool            closed      If true the last vertex is connected to the first one
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       The walls are appended
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the world is full
+ *
+ *  NOTE:
+ */
+static bool SIM_WORLD_addPolyline(SimWorld *world, const double *points, uint16_t count,
+                                  bool closed) {
+    for (uint16_t i = 0; i + 1 < count; i++) {
+        if (!SIM_WORLD_addSegment(world, points[2 * i], points[2 * i + 1], points[2 * i + 2],
+                                  points[2 * i + 3]))
+            return false;
+    }
+    if (closed && count > 2)
+        return SIM_WORLD_addSegment(world, points[2 * count - 2], points[2 * count - 1],
+                                    points[0], points[1]);
+    return true;
+}
+
+bool SIM_WORLD_addPolygon(SimWorld *world, const double *points, uint16_t count) {
+    return SIM_WORLD_addPolyline(world, points, count, true);
+}
+
+bool SIM_WORLD_addLowPolygon(SimWorld *world, const double *points, uint16_t count) {
+    uint16_t first = world->segmentCount;
+    bool isAdded = SIM_WORLD_addPolyline(world, points, count, true);
+    for (uint16_t i = first; i < world->segmentCount; i++)
+        world->segments[i].isLow = true;
+    return isAdded;
+}
+
+bool SIM_WORLD_load(SimWorld *world, const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return false;
+
+    SIM_WORLD_init(world);
+
+    char line[SIM_WORLD_LINE_SIZE];
+    bool isValid = true;
+    while (isValid && fgets(line, sizeof(line), file) != NULL) {
+        // [1] Strip the comments
+        char *comment = strchr(line, '#');
+        if (comment != NULL)
+            *comment = '\0';
+
+        // [2] Read the directive
+        char *token = strtok(line, " \t\r\n");
+        if (token == NULL)
+            continue;
+
+        // [3] Read the numeric arguments
+        double values[2 * SIM_WORLD_MAX_POINTS];
+        uint16_t count = 0;
+        char *argument;
+        while ((argument = strtok(NULL, " \t\r\n")) != NULL) {
+            char *end;
+            if (count >= 2 * SIM_WORLD_MAX_POINTS) {
+                isValid = false;
+                break;
+            }
+            values[count++] = strtod(argument, &end);
+            if (*end != '\0')
+                isValid = false;
+        }
+        if (!isValid)
+            break;
+
+        // [4] Apply the directive
+        if (strcmp(token, "start") == 0 && count == 3) {
+            world->start.x = values[0];
+            world->start.y = values[1];
+            world->start.heading = values[2] * M_PI / 180;
+        } else if (strcmp(token, "poly") == 0 && count >= 6 && count % 2 == 0) {
+            isValid = SIM_WORLD_addPolyline(world, values, count / 2, true);
+        } else if (strcmp(token, "line") == 0 && count >= 4 && count % 2 == 0) {
+            isValid = SIM_WORLD_addPolyline(world, values, count / 2, false);
+        } else if (strcmp(token, "low") == 0 && count >= 6 && count % 2 == 0) {
+            isValid = SIM_WORLD_addLowPolygon(world, values, count / 2);
+        } else {
+            isValid = false;
+        }
+    }
+
+    fclose(file);
+    return isValid;
+}
+
+double SIM_WORLD_castRay(const SimWorld *world, double x, double y, double angle,
+                         double maxRange) {
+    double dx = cos(angle);
+    double dy = sin(angle);
+    double closest = maxRange;
+
+    for (uint16_t i = 0; i < world->segmentCount; i++) {
+        const SimSegment *s = &world->segments[i];
+        if (s->isLow)
+            continue; // under the beam
+        double ex = s->x2 - s->x1;
+        double ey = s->y2 - s->y1;
+
+        // solve origin + t * direction = start + u * edge
+        double denominator = dx * ey - dy * ex;
+        if (fabs(denominator) < 1e-12)
+            continue; // parallel
+
+        double qx = s->x1 - x;
+        double qy = s->y1 - y;
+        double t = (qx * ey - qy * ex) / denominator;
+        double u = (qx * dy - qy * dx) / denominator;
+        if (t >= 0 && u >= 0 && u <= 1 && t < closest)
+            closest = t;
+    }
+    return closest;
+}
+
+double SIM_WORLD_clearance(const SimWorld *world, double x, double y) {
+    double closest = DBL_MAX;
+
+    for (uint16_t i = 0; i < world->segmentCount; i++) {
+        const SimSegment *s = &world->segments[i];
+        double ex = s->x2 - s->x1;
+        double ey = s->y2 - s->y1;
+        double length = ex * ex + ey * ey;
+
+        // project the point on the wall, clamping to its ends
+        double t = length > 0 ? ((x - s->x1) * ex + (y - s->y1) * ey) / length : 0;
+        if (t < 0)
+            t = 0;
+        if (t > 1)
+            t = 1;
+
+        double distance = hypot(x - (s->x1 + t * ex), y - (s->y1 + t * ey));
+        if (distance < closest)
+            closest = distance;
+    }
+    return closest;
+}
+
+uint16_t SIM_WORLD_addRandomBoxes(SimWorld *world, uint16_t count, double margin,
+                                  SimRandom *random) {
+    if (world->segmentCount == 0)
+        return 0;
+
+    // [1] Bounds of the existing walls
+    double minX = DBL_MAX, minY = DBL_MAX, maxX = -DBL_MAX, maxY = -DBL_MAX;
+    for (uint16_t i = 0; i < world->segmentCount; i++) {
+        const SimSegment *s = &world->segments[i];
+        minX = fmin(minX, fmin(s->x1, s->x2));
+        maxX = fmax(maxX, fmax(s->x1, s->x2));
+        minY = fmin(minY, fmin(s->y1, s->y2));
+        maxY = fmax(maxY, fmax(s->y1, s->y2));
+    }
+
+    // [2] Place the boxes where there is enough room around them
+    uint16_t placed = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        for (uint16_t attempt = 0; attempt < SIM_WORLD_BOX_ATTEMPTS; attempt++) {
+            double width =
+                SIM_RANDOM_uniform(random, SIM_WORLD_BOX_MIN_SIZE, SIM_WORLD_BOX_MAX_SIZE);
+            double height =
+                SIM_RANDOM_uniform(random, SIM_WORLD_BOX_MIN_SIZE, SIM_WORLD_BOX_MAX_SIZE);
+            double x = SIM_RANDOM_uniform(random, minX, maxX);
+            double y = SIM_RANDOM_uniform(random, minY, maxY);
+            double radius = hypot(width, height) / 2;
+            if (SIM_WORLD_clearance(world, x, y) < radius + margin ||
+                hypot(x - world->start.x, y - world->start.y) < radius + margin ||
+                SIM_WORLD_castRay(world, x, y, 0, DBL_MAX) == DBL_MAX)
+                continue; // too close to something, or outside of the room
+
+            const double box[] = {x - width / 2, y - height / 2, x + width / 2, y - height / 2,
+                                  x + width / 2, y + height / 2, x - width / 2, y + height / 2};
+            if (SIM_WORLD_addPolygon(world, box, 4))
+                placed++;
+            break;
+        }
+    }
+    return placed;
+}
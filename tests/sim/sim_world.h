@@ -0,0 +1,321 @@
+/*H************************************************************************************************
+ * FILENAME:        sim_world.h
+ *
+ * DESCRIPTION:
+ *      This header provides a 2-D world made of wall segments, used by the simulator to detect
+ *      collisions and to compute the echoes of the ultrasonic sensor.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    SIM_WORLD_init(SimWorld *world)
+ *      bool    SIM_WORLD_addSegment(SimWorld *world, double x1, double y1, double x2, double y2)
+ *      bool    SIM_WORLD_addPolygon(SimWorld *world, const double *points, uint16_t count)
+ *      bool    SIM_WORLD_addLowPolygon(SimWorld *world, const double *points, uint16_t count)
+ *      bool    SIM_WORLD_load(SimWorld *world, const char *path)
+ *      double  SIM_WORLD_castRay(const SimWorld *world, double x, double y, double angle,
+ *                                double maxRange)
+ *      double  SIM_WORLD_clearance(const SimWorld *world, double x, double y)
+ *      uint16_t SIM_WORLD_addRandomBoxes(SimWorld *world, uint16_t count, double margin,
+ *                                        SimRandom *random)
+ *
+ * NOTES:
+ *      Distances are expressed in centimeters and angles in radians, counterclockwise from the
+ *      x axis.
+ *      A map file is a text file with one directive per line, '#' starts a comment:
+ *          start   x y heading         Initial pose of the car, heading in degrees
+ *          poly    x1 y1 x2 y2 ...     Closed polygon (room boundary or obstacle)
+ *          line    x1 y1 x2 y2 ...     Open polyline (thin wall)
+ *          low     x1 y1 x2 y2 ...     Closed polygon lower than the ultrasonic sensor
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Low obstacles, under the ultrasonic beam
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sim_random.h"
+
+#ifndef SIM_WORLD_H
+#define SIM_WORLD_H
+
+#define SIM_WORLD_MAX_SEGMENTS 512 /* Maximum number of walls in a world                      */
+#define SIM_WORLD_MAX_POINTS 64    /* Maximum number of vertices of a polygon in a map file    */
+#define SIM_WORLD_BOX_MIN_SIZE 15  /* Minimum side of a random box (cm)                        */
+#define SIM_WORLD_BOX_MAX_SIZE 60  /* Maximum side of a random box (cm)                        */
+
+/*T************************************************************************************************
+ * NAME: SimSegment
+ *
+ * DESCRIPTION:
+ *      Represent a wall between two points.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   double      x1, y1      First end of the wall
+ *              double      x2, y2      Second end of the wall
+ *              bool        isLow       True if the ultrasonic beam passes over the wall
+ */
+typedef struct {
+    double x1, y1;
+    double x2, y2;
+    bool isLow;
+} SimSegment;
+
+/*T************************************************************************************************
+ * NAME: SimPose
+ *
+ * DESCRIPTION:
+ *      Represent the position and orientation of the car.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   double      x, y        Position of the center of the car
+ *              double      heading     Orientation in radians, 0 faces the x axis
+ */
+typedef struct {
+    double x, y;
+    double heading;
+} SimPose;
+
+/*T************************************************************************************************
+ * NAME: SimWorld
+ *
+ * DESCRIPTION:
+ *      Represent the environment in which the car moves.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   SimSegment  segments[]      Walls of the world
+ *              uint16_t    segmentCount    Number of valid walls
+ *              SimPose     start           Initial pose of the car
+ */
+typedef struct {
+    SimSegment segments[SIM_WORLD_MAX_SEGMENTS];
+    uint16_t segmentCount;
+    SimPose start;
+} SimWorld;
+
+/*F************************************************************************************************
+ * NAME: void SIM_WORLD_init(SimWorld *world)
+ *
+ * DESCRIPTION:
+ *      Initialises an empty world with the car in the origin facing the x axis.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimWorld*   world       World to initialise
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimWorld*   world       All the fields of the struct are set
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void SIM_WORLD_init(SimWorld *world);
+
+/*F************************************************************************************************
+ * NAME: bool SIM_WORLD_addSegment(SimWorld *world, double x1, double y1, double x2, double y2)
+ *
+ * DESCRIPTION:
+ *      Adds a wall to the world.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimWorld*   world       Target world
+ *          double      x1, y1      First end of the wall
+ *          double      x2, y2      Second end of the wall
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimWorld*   world       The wall is appended
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the world is full
+ *
+ *  NOTE:
+ */
+bool SIM_WORLD_addSegment(SimWorld *world, double x1, double y1, double x2, double y2);
+
+/*F************************************************************************************************
+ * NAME: bool SIM_WORLD_addPolygon(SimWorld *world, const double *points, uint16_t count)
+ *
+ * DESCRIPTION:
+ *      Adds a closed polygon to the world, the last vertex is connected to the first one.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       Target world
+ *          const double*   points      Vertices as consecutive (x, y) couples
+ *          uint16_t        count       Number of vertices
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       The walls are appended
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the world is full
+ *
+ *  NOTE:
+ */
+bool SIM_WORLD_addPolygon(SimWorld *world, const double *points, uint16_t count);
+
+/*F************************************************************************************************
+ * NAME: bool SIM_WORLD_addLowPolygon(SimWorld *world, const double *points, uint16_t count)
+ *
+ * DESCRIPTION:
+ *      Adds a closed polygon that the car hits but the ultrasonic sensor does not see, such as a
+ *      step or a threshold, so that the car can only notice it by the stall of the motors.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       Target world
+ *          const double*   points      Vertices as consecutive (x, y) couples
+ *          uint16_t        count       Number of vertices
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       The walls are appended
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the world is full
+ *
+ *  NOTE:
+ */
+bool SIM_WORLD_addLowPolygon(SimWorld *world, const double *points, uint16_t count);
+
+/*F************************************************************************************************
+ * NAME: bool SIM_WORLD_load(SimWorld *world, const char *path)
+ *
+ * DESCRIPTION:
+ *      Initialises the world and fills it with the content of a map file.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       Target world
+ *          const char*     path        Path of the map file
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       Walls and start pose are set
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the file cannot be read or contains an invalid directive
+ *
+ *  NOTE:
+ *      The syntax of the map file is described in the header notes.
+ */
+bool SIM_WORLD_load(SimWorld *world, const char *path);
+
+/*F************************************************************************************************
+ * NAME: double SIM_WORLD_castRay(const SimWorld *world, double x, double y, double angle,
+ *                                double maxRange)
+ *
+ * DESCRIPTION:
+ *      Computes the distance of the first wall hit by a ray.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimWorld*     world       Target world
+ *          double              x, y        Origin of the ray
+ *          double              angle       Direction of the ray in radians
+ *          double              maxRange    Maximum length of the ray
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   double
+ *          Value:  Distance of the closest hit, maxRange if nothing is hit
+ *
+ *  NOTE:
+ *      The low walls are ignored.
+ */
+double SIM_WORLD_castRay(const SimWorld *world, double x, double y, double angle,
+                         double maxRange);
+
+/*F************************************************************************************************
+ * NAME: double SIM_WORLD_clearance(const SimWorld *world, double x, double y)
+ *
+ * DESCRIPTION:
+ *      Computes the distance between a point and the closest wall.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimWorld*     world       Target world
+ *          double              x, y        Point to check
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   double
+ *          Value:  Distance of the closest wall, a very large value if the world is empty
+ *
+ *  NOTE:
+ */
+double SIM_WORLD_clearance(const SimWorld *world, double x, double y);
+
+/*F************************************************************************************************
+ * NAME: uint16_t SIM_WORLD_addRandomBoxes(SimWorld *world, uint16_t count, double margin,
+ *                                         SimRandom *random)
+ *
+ * DESCRIPTION:
+ *      Scatters rectangular obstacles inside the area covered by the existing walls, every box
+ *      keeps the given margin from the walls, from the other boxes and from the start pose.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       Target world, it should already contain the room
+ *          uint16_t        count       Number of boxes wanted
+ *          double          margin      Minimum free space around every box (cm)
+ *          SimRandom*      random      Generator for sizes and positions
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimWorld*       world       The boxes are appended
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Number of boxes actually placed, it can be less than requested in crowded worlds
+ *
+ *  NOTE:
+ */
+uint16_t SIM_WORLD_addRandomBoxes(SimWorld *world, uint16_t count, double margin,
+                                  SimRandom *random);
+
+#endif // SIM_WORLD_H
@@ -1,8 +1,14 @@
 #include <stdio.h>
 
+#include "integration-tests/it_simulation.h"
 #include "integration-tests/it_state_machine.h"
+#include "unit-tests/ut_crash.h"
 #include "unit-tests/ut_sensing_module.h"
 #include "unit-tests/ut_powertrain_module.h"
+#include "unit-tests/ut_profiler.h"
+#include "unit-tests/ut_retained.h"
+#include "unit-tests/ut_ring.h"
+#include "unit-tests/ut_trace.h"
 #include "../inc/system.h"
 
 int main() {
@@ -22,8 +28,59 @@ int main() {
     UT_Sensing_Module_checkDoubleClearance();
     printf("Sensing module test PASSED\n");
 
+    // Starting profiler test
+    printf("Starting profiler test ...\n");
+    UT_Profiler_testRoundTrip();
+    UT_Profiler_testInvalid();
+    printf("Profiler test PASSED\n");
+
+    // Starting retained state test
+    printf("Starting retained state test ...\n");
+    UT_Retained_testRoundTrip();
+    printf("Retained state test PASSED\n");
+
+    // Starting crash test
+    printf("Starting crash test ...\n");
+    UT_Crash_testRecord();
+    UT_Crash_testLog();
+    printf("Crash test PASSED\n");
+
+    // Starting trace test
+    printf("Starting trace test ...\n");
+    UT_Trace_testDump();
+    UT_Trace_testFull();
+    printf("Trace test PASSED\n");
+
+    // Starting ring test
+    printf("Starting ring test ...\n");
+    UT_Ring_testSequential();
+    UT_Ring_testProducers();
+    printf("Ring test PASSED\n");
+
     // Starting state machine test
     printf("Starting state machine test ...\n");
     IT_State_Machine_test();
     printf("State machine test PASSED\n");
+
+    // Starting simulation test
+    printf("Starting simulation test ...\n");
+    IT_Simulation_test();
+    IT_Simulation_testBatch();
+    IT_Simulation_testReplay();
+    IT_Simulation_testFaults();
+    IT_Simulation_testUart();
+    IT_Simulation_testHc08();
+    IT_Simulation_testReaction();
+    IT_Simulation_testStall();
+    IT_Simulation_testDecay();
+    IT_Simulation_testCalibration();
+    IT_Simulation_testTrim();
+    IT_Simulation_testWarmRestart();
+    IT_Simulation_testSweep();
+    IT_Simulation_testExploration();
+    IT_Simulation_testGoTo();
+    IT_Simulation_testRoute();
+    IT_Simulation_testScanMatch();
+    IT_Simulation_testApproach();
+    printf("Simulation test PASSED\n");
 }
\ No newline at end of file
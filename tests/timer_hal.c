@@ -0,0 +1,89 @@
+/*H************************************************************************************************
+ * FILENAME:        timer_hal.c
+ *
+ * DESCRIPTION:
+ *      Timer(s) Hardware Abstraction Layer (HAL), this source file provides an abstraction over
+ *      the usage of two 32-bit timers:
+ *      - Periodic Timer: a timer continuously running at 93750Hz.
+ *      - Shared Timer: a timer working in one shot mode that can be activated on request
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    TIMER_HAL_init()
+ *      void    TIMER_HAL_setupPeriodicTimer(uint32_t count);
+ *      void    TIMER_HAL_registerPeriodicTimerCallback(TimerCallback callback);
+ *      void    TIMER_HAL_acquireSharedTimer(uint32_t count, TimerCallback callback);
+ *      void    TIMER_HAL_releaseSharedTimer();
+ *      uint32_t TIMER_HAL_getTicks();
+ *      void    TIMER_HAL_registerHooks(const TimerHooks *hooks);
+ *      void    TIMER_HAL_triggerPeriodicTimer();
+ *      void    TIMER_HAL_triggerSharedTimer();
+ *
+ * NOTES:
+ *
+ * AUTHOR: Andrea Piccin    <andrea.piccin@studenti.unitn.it>
+ *
+ * START DATE: 20 Feb 2024
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Modified for testing, added simulation hooks
+ * 18 Oct 2026  Maintainers     Added the elapsed time and the recording of the expirations
+ * 18 Oct 2026  Maintainers     Tracing of the callbacks
+ */
+#include <stddef.h>
+
+#include "timer_hal.h"
+#include "../inc/recorder.h"
+#include "../inc/trace.h"
+
+TimerCallback periodicCallback = NULL; /* Function to call when the periodic timer expires */
+TimerCallback sharedCallback = NULL;   /* Function of the current owner of the shared timer */
+const TimerHooks *timerHooks = NULL;   /* Functions provided by the simulator, if any        */
+
+void TIMER_HAL_init() {}
+
+void TIMER_HAL_setupPeriodicTimer(uint32_t count) {
+    if (timerHooks != NULL && timerHooks->setupPeriodic != NULL)
+        timerHooks->setupPeriodic(count);
+}
+
+void TIMER_HAL_registerPeriodicTimerCallback(TimerCallback callback) {
+    periodicCallback = callback;
+}
+
+void TIMER_HAL_acquireSharedTimer(uint32_t count, TimerCallback callback) {
+    sharedCallback = callback;
+    if (timerHooks != NULL && timerHooks->acquireShared != NULL)
+        timerHooks->acquireShared(count);
+    else
+        TIMER_HAL_triggerSharedTimer();
+}
+
+void TIMER_HAL_releaseSharedTimer() {
+    if (timerHooks != NULL && timerHooks->releaseShared != NULL)
+        timerHooks->releaseShared();
+}
+
+uint32_t TIMER_HAL_getTicks() {
+    if (timerHooks != NULL && timerHooks->getTicks != NULL)
+        return timerHooks->getTicks();
+    return 0;
+}
+
+void TIMER_HAL_registerHooks(const TimerHooks *hooks) { timerHooks = hooks; }
+
+void TIMER_HAL_triggerPeriodicTimer() {
+    RECORDER_RECORD(RECORDER_CHANNEL_PERIODIC_TIMER, 0);
+    TRACE_BEGIN(TRACE_ID_PERIODIC_TIMER, 0);
+    if (periodicCallback != NULL)
+        periodicCallback();
+    TRACE_END(TRACE_ID_PERIODIC_TIMER);
+}
+
+void TIMER_HAL_triggerSharedTimer() {
+    RECORDER_RECORD(RECORDER_CHANNEL_SHARED_TIMER, 0);
+    TRACE_BEGIN(TRACE_ID_SHARED_TIMER, 0);
+    if (sharedCallback != NULL)
+        sharedCallback();
+    TRACE_END(TRACE_ID_SHARED_TIMER);
+}
@@ -0,0 +1,281 @@
+/*H************************************************************************************************
+ * FILENAME:        timer_hal.h
+ *
+ * DESCRIPTION:
+ *      Timer(s) Hardware Abstraction Layer (HAL), this header file provides an abstraction over
+ *      the usage of two 32-bit timers:
+ *      - Periodic Timer: a timer continuously running at 93750Hz.
+ *      - Shared Timer: a timer working in one shot mode that can be activated on request
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    TIMER_HAL_init()
+ *      void    TIMER_HAL_setupPeriodicTimer(uint32_t count);
+ *      void    TIMER_HAL_registerPeriodicTimerCallback(TimerCallback callback);
+ *      void    TIMER_HAL_acquireSharedTimer(uint32_t count, TimerCallback callback);
+ *      void    TIMER_HAL_releaseSharedTimer();
+ *      uint32_t TIMER_HAL_getTicks();
+ *      void    TIMER_HAL_registerHooks(const TimerHooks *hooks);
+ *      void    TIMER_HAL_triggerPeriodicTimer();
+ *      void    TIMER_HAL_triggerSharedTimer();
+ *
+ * NOTES:
+ *      Without registered hooks the shared timer expires as soon as it is acquired and the
+ *      periodic timer never fires, so the modules behave as if every wait was instantaneous.
+ *      A simulator can register hooks in order to schedule the expirations in virtual time.
+ *
+ * AUTHOR: Andrea Piccin    <andrea.piccin@studenti.unitn.it>
+ *
+ * START DATE: 20 Feb 2024
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Modified for testing, added simulation hooks
+ * 18 Oct 2026  Maintainers     Added the elapsed time and the recording of the expirations
+ */
+#include <stdint.h>
+
+#ifndef TIMER_HAL_H
+#define TIMER_HAL_H
+
+/*T************************************************************************************************
+ * NAME: TimerCallback
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that executes when the timer reaches zero.
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Args:   None
+ */
+typedef void (*TimerCallback)(void);
+
+/*T************************************************************************************************
+ * NAME: TimerHooks
+ *
+ * DESCRIPTION:
+ *      Set of functions invoked by the mocked timer HAL, they allow a simulator to decide when the
+ *      timers expire.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   void (*)(uint32_t)  setupPeriodic   Called when the periodic timer is started
+ *              void (*)(uint32_t)  acquireShared   Called when the shared timer is acquired
+ *              void (*)(void)      releaseShared   Called when the shared timer is released
+ *              uint32_t (*)(void)  getTicks        Returns the elapsed time in ticks
+ */
+typedef struct {
+    void (*setupPeriodic)(uint32_t count);
+    void (*acquireShared)(uint32_t count);
+    void (*releaseShared)(void);
+    uint32_t (*getTicks)(void);
+} TimerHooks;
+
+/*F************************************************************************************************
+ * NAME: void TIMER_HAL_init();
+ *
+ * DESCRIPTION:
+ *      Initialises the timer's hardware.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void TIMER_HAL_init();
+
+/*F************************************************************************************************
+ * NAME: void TIMER_HAL_setupPeriodicTimer(uint32_t count, TimerCallback callback)
+ *
+ * DESCRIPTION:
+ *      Set up a 32-bit timer in order to perform a countdown from the given count to zero, trigger
+ *      an interrupt and restart.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t          count           Number of ticks of the period (1 tick = 0.01ms)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The callback function must clear the TIMER32_1_INTERRUPT flag.
+ */
+void TIMER_HAL_setupPeriodicTimer(uint32_t count);
+
+/*F************************************************************************************************
+ * NAME: void TTIMER_HAL_registerPeriodicTimerCallback(TimerCallback callback);
+ *
+ * DESCRIPTION:
+ *      Registers the given function as ISR for the TIMER32_1_INTERRUPT interrupt.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          TimerCallback     callback        Function to call on timer expiration
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The callback function must clear the TIMER32_1_INTERRUPT flag.
+ */
+void TIMER_HAL_registerPeriodicTimerCallback(TimerCallback callback);
+
+/*F************************************************************************************************
+ * NAME: void TIMER_HAL_acquireSharedTimer(uint32_t count, TimerCallback callback)
+ *
+ * DESCRIPTION:
+ *      Set up the shared 32-bit timer in order to perform a countdown from the given count to
+ *      zero and then call the given callback function.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint32_t          count           Number of ticks to wait (1 tick = 0.01ms)
+ *          TimerCallback     callback        Function to call on timer expiration
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      The callback function must clear the TIMER32_0_INTERRUPT flag.
+ */
+void TIMER_HAL_acquireSharedTimer(uint32_t count, TimerCallback callback);
+
+/*F************************************************************************************************
+ * NAME: void TIMER_HAL_releaseSharedTimer()
+ *
+ * DESCRIPTION:
+ *      Stops the shared timer and unregisters the callback.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void TIMER_HAL_releaseSharedTimer();
+
+/*F************************************************************************************************
+ * NAME: uint32_t TIMER_HAL_getTicks()
+ *
+ * DESCRIPTION:
+ *      Returns the time elapsed since the start of the periodic timer.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Ticks at 93750Hz provided by the hooks, 0 without hooks
+ *
+ *  NOTE:
+ */
+uint32_t TIMER_HAL_getTicks();
+
+/*F************************************************************************************************
+ * NAME: void TIMER_HAL_registerHooks(const TimerHooks *hooks)
+ *
+ * DESCRIPTION:
+ *      Registers the functions to call when the timers are configured, NULL restores the default
+ *      behaviour.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const TimerHooks*   hooks       Functions to register, the struct is not copied
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void TIMER_HAL_registerHooks(const TimerHooks *hooks);
+
+/*F************************************************************************************************
+ * NAME: void TIMER_HAL_triggerPeriodicTimer()
+ *
+ * DESCRIPTION:
+ *      Simulate the expiration of the periodic timer.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void TIMER_HAL_triggerPeriodicTimer();
+
+/*F************************************************************************************************
+ * NAME: void TIMER_HAL_triggerSharedTimer()
+ *
+ * DESCRIPTION:
+ *      Simulate the expiration of the shared timer, the callback of the current owner is invoked.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void TIMER_HAL_triggerSharedTimer();
+
+#endif // TIMER_HAL_H
\ No newline at end of file
@@ -9,7 +9,9 @@
  *      void        US_HAL_init()
  *      void        US_HAL_triggerMeasurement()
  *      void        US_HAL_registerMeasurementCallback(USCallback callback);
- *      void        US_HAL_setDefaultDistance(uint16_t distance);
+ *      uint32_t    US_HAL_getEchoTicks();
+ *      void        US_HAL_triggerNextAction(uint16_t distance);
+ *      void        US_HAL_registerTriggerHook(USTriggerHook hook);
  *
  * NOTES:
  *
@@ -19,22 +21,48 @@
  *
  * CHANGES:
  * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Added simulation hook
+ * 18 Oct 2026  Maintainers     Recording of the measurements
+ * 18 Oct 2026  Maintainers     Time of the echo
+ * 18 Oct 2026  Maintainers     Tracing of the callback
  */
 #include <stdio.h>
+#include "timer_hal.h"
 #include "ultrasonic_hal.h"
+#include "../inc/recorder.h"
+#include "../inc/trace.h"
 
-USCallback usCallback;       /* Function to call when a new measurement is ready      */
+#define US_HALF_ECHO_TICKS_PER_32CM 87 /* Half of 58µs per cm, at 3/32 timer ticks per µs  */
+#define US_HALF_TIMEOUT_TICKS 1781      /* Half of the 38ms pulse when nothing is hit        */
+
+USCallback usCallback;            /* Function to call when a new measurement is ready */
+USTriggerHook usTriggerHook = NULL; /* Function to call when a measurement is triggered */
+uint32_t echoTicks;                 /* Timer HAL ticks at the midpoint of the last echo   */
 
 void US_HAL_init() {
     usCallback = NULL;
 }
 
 void US_HAL_triggerMeasurement() {
+    if (usTriggerHook != NULL)
+        usTriggerHook();
 }
 
 void US_HAL_registerMeasurementCallback(USCallback callback) { usCallback = callback; }
 
+uint32_t US_HAL_getEchoTicks() { return echoTicks; }
+
 void US_HAL_triggerNextAction(uint16_t distance){
+    // the pulse the HC-SR04 would produce for the distance ends now
+    if (distance == US_RESULT_NO_OBJECT)
+        echoTicks = TIMER_HAL_getTicks() - US_HALF_TIMEOUT_TICKS;
+    else
+        echoTicks = TIMER_HAL_getTicks() - distance * US_HALF_ECHO_TICKS_PER_32CM / 32;
+    RECORDER_RECORD(RECORDER_CHANNEL_US_ECHO, distance);
+    TRACE_BEGIN(TRACE_ID_US_ECHO, distance);
     if(usCallback!=NULL)
         usCallback(distance);
-}
\ No newline at end of file
+    TRACE_END(TRACE_ID_US_ECHO);
+}
+
+void US_HAL_registerTriggerHook(USTriggerHook hook) { usTriggerHook = hook; }
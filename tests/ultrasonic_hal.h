@@ -9,6 +9,9 @@
  *      void        US_HAL_init()
  *      void        US_HAL_triggerMeasurement(uint16_t distance)
  *      void        US_HAL_registerMeasurementCallback(USCallback callback);
+ *      uint32_t    US_HAL_getEchoTicks();
+ *      void        US_HAL_triggerNextAction(uint16_t distance);
+ *      void        US_HAL_registerTriggerHook(USTriggerHook hook);
  *
  * NOTES:
  *
@@ -20,6 +23,8 @@
  * DATE         AUTHOR          DETAIL
  * 10 Feb 2024  Andrea Piccin   Introduced callback mechanism
  * 19 Feb 2024  Simone Rossi
+ * 18 Oct 2026  Maintainers     Added simulation hook
+ * 18 Oct 2026  Maintainers     Time of the echo
  */
 #include <stdint.h>
 
@@ -40,6 +45,19 @@
  */
 typedef void (*USCallback)(uint16_t distance);
 
+/*T************************************************************************************************
+ * NAME: USTriggerHook
+ *
+ * DESCRIPTION:
+ *      It's a pointer to a function that executes when a new measurement is triggered, it allows
+ *      a simulator to produce the echo.
+ *
+ * SPECIFICATIONS:
+ *      Type:   void*
+ *      Args:   None
+ */
+typedef void (*USTriggerHook)(void);
+
 /*F************************************************************************************************
  * NAME: void US_HAL_init()
  *
@@ -106,6 +124,54 @@ void US_HAL_triggerMeasurement();
  */
 void US_HAL_registerMeasurementCallback(USCallback callback);
 
+/*F************************************************************************************************
+ * NAME: uint32_t US_HAL_getEchoTicks()
+ *
+ * DESCRIPTION:
+ *      Returns the time of the midpoint of the last echo pulse, when the sound was reflected.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint32_t
+ *          Value:  Ticks of the timer HAL
+ *
+ *  NOTE:
+ *      It is valid inside the measurement callback.
+ */
+uint32_t US_HAL_getEchoTicks();
+
 void US_HAL_triggerNextAction(uint16_t distance);
 
+/*F************************************************************************************************
+ * NAME: void US_HAL_registerTriggerHook(USTriggerHook hook)
+ *
+ * DESCRIPTION:
+ *      Registers the function to call every time a new measurement is triggered.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          USTriggerHook   hook            The function to register, NULL to remove it
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+void US_HAL_registerTriggerHook(USTriggerHook hook);
+
 #endif // ULTRASONIC_HAL_H
\ No newline at end of file
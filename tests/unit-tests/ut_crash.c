@@ -0,0 +1,160 @@
+/*C************************************************************************************************
+ * FILENAME:        ut_crash.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the test functions to verify the validation of the crash records
+ *      at boot and their flash log:
+ *      [1] The record left by the previous run is reported once if its magic and checksum are
+ *          right, a corrupted one is rejected
+ *      [2] The records are appended to the log after the previous ones, a torn slot is skipped
+ *          and a full log is erased
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    UT_Crash_testRecord()
+ *      void    UT_Crash_testLog()
+ *
+ * NOTES:
+ *      In the test build the flash log is an array in RAM, erased as the flash to all ones.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../inc/crash.h"
+#include "../bluetooth_hal.h"
+#include "ut_crash.h"
+
+#define UT_CRASH_SLOTS (CRASH_FLASH_SIZE / sizeof(CrashRecord))
+#define UT_CRASH_HARDFAULT 3
+
+extern CrashRecord crashRecord;             /* Record of the previous run, in .noinit            */
+extern CrashRecord crashLog[UT_CRASH_SLOTS]; /* Flash log of the crash module                    */
+
+static char firstLine[32]; /* First line of the report sent */
+
+static void UT_Crash_onTransmit(const char *message) {
+    if (firstLine[0] == '\0')
+        snprintf(firstLine, sizeof(firstLine), "%s", message);
+}
+
+static void UT_Crash_seal(CrashRecord *record) {
+    const uint32_t *words = (const uint32_t *)record;
+    uint32_t sum = 0;
+    for (size_t i = 0; i < offsetof(CrashRecord, checksum) / sizeof(uint32_t); i++)
+        sum += words[i];
+    record->checksum = ~sum;
+}
+
+static void UT_Crash_leave(uint32_t exception, uint32_t code) {
+    memset(&crashRecord, 0, sizeof(crashRecord));
+    crashRecord.magic = CRASH_MAGIC;
+    crashRecord.exception = exception;
+    crashRecord.code = code;
+    crashRecord.state = 2;
+    crashRecord.registers[6] = 0x1234;
+    UT_Crash_seal(&crashRecord);
+}
+
+static void UT_Crash_boot() {
+    firstLine[0] = '\0';
+    CRASH_init();
+    CRASH_flush();
+}
+
+static bool UT_Crash_isErased(uint8_t slot) {
+    const uint8_t *bytes = (const uint8_t *)&crashLog[slot];
+    for (size_t i = 0; i < sizeof(CrashRecord); i++)
+        if (bytes[i] != 0xFF)
+            return false;
+    return true;
+}
+
+void UT_Crash_testRecord() {
+    BT_HAL_registerTransmitHook(UT_Crash_onTransmit);
+    memset(crashLog, 0xFF, sizeof(crashLog));
+
+    // Nothing left by the previous run, or random content after a power cycle
+    memset(&crashRecord, 0, sizeof(crashRecord));
+    UT_Crash_boot();
+    assert(firstLine[0] == '\0' && UT_Crash_isErased(0) && "Report without a record");
+    memset(&crashRecord, 0xA5, sizeof(crashRecord));
+    UT_Crash_boot();
+    assert(firstLine[0] == '\0' && UT_Crash_isErased(0) && "Random record accepted");
+
+    // A valid record is logged and reported once
+    UT_Crash_leave(UT_CRASH_HARDFAULT, 0xFFFFFFF9);
+    CrashRecord left = crashRecord;
+    UT_Crash_boot();
+    assert(strcmp(firstLine, "!CRASH HardFault ST 2 #0") == 0 && "Record not reported");
+    assert(memcmp(&crashLog[0], &left, sizeof(left)) == 0 && "Record not logged");
+    assert(crashRecord.magic != CRASH_MAGIC && "Record not invalidated");
+    UT_Crash_boot();
+    assert(firstLine[0] == '\0' && UT_Crash_isErased(1) && "Record reported twice");
+
+    // A corrupted word or checksum is rejected, the next valid record is accepted
+    UT_Crash_leave(CRASH_HALT, 7);
+    crashRecord.stack[3] ^= 0x100;
+    UT_Crash_boot();
+    assert(firstLine[0] == '\0' && UT_Crash_isErased(1) && "Corrupted record accepted");
+    assert(crashRecord.magic != CRASH_MAGIC && "Corrupted record not invalidated");
+    UT_Crash_leave(CRASH_HALT, 7);
+    crashRecord.checksum++;
+    UT_Crash_boot();
+    assert(firstLine[0] == '\0' && UT_Crash_isErased(1) && "Wrong checksum accepted");
+    UT_Crash_leave(CRASH_HALT, 7);
+    UT_Crash_boot();
+    assert(strcmp(firstLine, "!CRASH halt ST 2 #1") == 0 && crashLog[1].code == 7 &&
+           "Valid record after a corrupted one not accepted");
+
+    BT_HAL_registerTransmitHook(NULL);
+}
+
+void UT_Crash_testLog() {
+    BT_HAL_registerTransmitHook(UT_Crash_onTransmit);
+
+    // Erased sector, the record goes in the first slot
+    memset(crashLog, 0xFF, sizeof(crashLog));
+    UT_Crash_leave(UT_CRASH_HARDFAULT, 1);
+    UT_Crash_boot();
+    assert(crashLog[0].code == 1 && UT_Crash_isErased(1) && "Record not in the first slot");
+
+    // The previous record is kept, the next one follows it
+    CrashRecord previous = crashLog[0];
+    UT_Crash_leave(UT_CRASH_HARDFAULT, 2);
+    UT_Crash_boot();
+    assert(memcmp(&crashLog[0], &previous, sizeof(previous)) == 0 && "Previous record lost");
+    assert(crashLog[1].code == 2 && strcmp(firstLine, "!CRASH HardFault ST 2 #1") == 0 &&
+           "Record not after the previous one");
+
+    // A slot torn by a reset while programming is not overwritten
+    memset(&crashLog[2], 0xFF, sizeof(CrashRecord));
+    crashLog[2].magic = CRASH_MAGIC;
+    crashLog[2].exception = UT_CRASH_HARDFAULT;
+    CrashRecord torn = crashLog[2];
+    UT_Crash_leave(UT_CRASH_HARDFAULT, 3);
+    UT_Crash_boot();
+    assert(memcmp(&crashLog[2], &torn, sizeof(torn)) == 0 && crashLog[3].code == 3 &&
+           "Torn slot overwritten");
+
+    // A full log is erased, the record goes in the first slot
+    for (uint8_t slot = 4; slot < UT_CRASH_SLOTS; slot++) {
+        UT_Crash_leave(UT_CRASH_HARDFAULT, slot);
+        UT_Crash_boot();
+        assert(crashLog[slot].code == slot && "Record not appended");
+    }
+    UT_Crash_leave(UT_CRASH_HARDFAULT, 99);
+    UT_Crash_boot();
+    assert(crashLog[0].code == 99 && UT_Crash_isErased(1) &&
+           UT_Crash_isErased(UT_CRASH_SLOTS - 1) && "Full log not erased");
+    assert(strcmp(firstLine, "!CRASH HardFault ST 2 #0") == 0 && "Record not in the erased log");
+
+    BT_HAL_registerTransmitHook(NULL);
+}
@@ -0,0 +1,27 @@
+/*H************************************************************************************************
+ * FILENAME:        ut_crash.h
+ *
+ * DESCRIPTION:
+ *      This header file provides the test functions to verify the validation of the crash records
+ *      at boot and their flash log.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    UT_Crash_testRecord()
+ *      void    UT_Crash_testLog()
+ *
+ * NOTES:
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#ifndef UT_CRASH_H_
+#define UT_CRASH_H_
+
+void UT_Crash_testRecord();
+void UT_Crash_testLog();
+
+#endif // UT_CRASH_H_
@@ -0,0 +1,87 @@
+/*C************************************************************************************************
+ * FILENAME:        ut_profiler.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the test functions to verify the text encoding of the samples of
+ *      the statistical profiler, shared by the firmware and tools/profiler:
+ *      [1] A sample decoded from its encoding is the sample encoded, at the limits of every field
+ *      [2] A text that is not made of hex digits is rejected
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    UT_Profiler_testRoundTrip()
+ *      void    UT_Profiler_testInvalid()
+ *
+ * NOTES:
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../../inc/profiler.h"
+#include "ut_profiler.h"
+
+#define UT_PROFILER_GUARD '#' /* Char after the text, never written by the encoding */
+
+static const ProfilerSample samples[] = {
+    {0x00000000, 0x00000000, PROFILER_THREAD},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFF},
+    {0x00001A2B, 0x00001A01, 15},      /* SysTick, a Thumb return address                  */
+    {0x0003C4D5, 0xFFFFFFF9, 16 + 25}, /* Device interrupt, EXC_RETURN in the link register */
+    {0x80000001, 0x7FFFFFFE, 0x80},
+};
+
+void UT_Profiler_testRoundTrip() {
+    char text[PROFILER_SAMPLE_TEXT_LENGTH + 1];
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        text[PROFILER_SAMPLE_TEXT_LENGTH] = UT_PROFILER_GUARD;
+        PROFILER_encode(&samples[i], text);
+        assert(text[PROFILER_SAMPLE_TEXT_LENGTH] == UT_PROFILER_GUARD && "Encoding too long");
+
+        ProfilerSample decoded = {0x12345678, 0x12345678, 0x12};
+        bool isDecoded = PROFILER_decode(text, &decoded);
+        assert(isDecoded && "Encoded sample not decoded");
+        assert(decoded.pc == samples[i].pc && decoded.lr == samples[i].lr &&
+               decoded.exception == samples[i].exception && "Decoded sample not the encoded one");
+    }
+
+    // Fixed layout read by the host tools: pc, lr and exception, most significant digit first
+    text[PROFILER_SAMPLE_TEXT_LENGTH] = '\0';
+    PROFILER_encode(&samples[3], text);
+    assert(strcmp(text, "0003C4D5FFFFFFF929") == 0 && "Unexpected encoding");
+
+    // Lower case digits are accepted as well
+    ProfilerSample decoded;
+    bool isDecoded = PROFILER_decode("0003c4d5fffffff929", &decoded);
+    assert(isDecoded && decoded.pc == 0x0003C4D5 && decoded.lr == 0xFFFFFFF9 &&
+           decoded.exception == 41 && "Lower case sample not decoded");
+}
+
+void UT_Profiler_testInvalid() {
+    char text[PROFILER_SAMPLE_TEXT_LENGTH + 1];
+    ProfilerSample decoded;
+    PROFILER_encode(&samples[2], text);
+    text[PROFILER_SAMPLE_TEXT_LENGTH] = '\0';
+
+    // Every position checked, including the last digit of the exception
+    const char invalid[] = {'G', 'g', ' ', '\0', '\n', '%', '@', '`'};
+    for (uint8_t i = 0; i < PROFILER_SAMPLE_TEXT_LENGTH; i++) {
+        for (size_t c = 0; c < sizeof(invalid); c++) {
+            char corrupted[PROFILER_SAMPLE_TEXT_LENGTH + 1];
+            memcpy(corrupted, text, sizeof(corrupted));
+            corrupted[i] = invalid[c];
+            bool isDecoded = PROFILER_decode(corrupted, &decoded);
+            assert(!isDecoded && "Invalid digit decoded");
+        }
+    }
+
+    // A truncated line ends with its terminator, rejected before the end of the sample
+    bool isDecoded = PROFILER_decode("0003C4D5FFFF", &decoded);
+    assert(!isDecoded && "Truncated sample decoded");
+}
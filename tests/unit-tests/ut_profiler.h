@@ -0,0 +1,27 @@
+/*H************************************************************************************************
+ * FILENAME:        ut_profiler.h
+ *
+ * DESCRIPTION:
+ *      This header file provides the test functions to verify the text encoding of the samples of
+ *      the statistical profiler.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    UT_Profiler_testRoundTrip()
+ *      void    UT_Profiler_testInvalid()
+ *
+ * NOTES:
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#ifndef UT_PROFILER_H_
+#define UT_PROFILER_H_
+
+void UT_Profiler_testRoundTrip();
+void UT_Profiler_testInvalid();
+
+#endif // UT_PROFILER_H_
@@ -0,0 +1,25 @@
+/*H************************************************************************************************
+ * FILENAME:        ut_retained.h
+ *
+ * DESCRIPTION:
+ *      This header file provides the test functions to verify the validation of the state kept
+ *      through the warm resets.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    UT_Retained_testRoundTrip()
+ *
+ * NOTES:
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#ifndef UT_RETAINED_H_
+#define UT_RETAINED_H_
+
+void UT_Retained_testRoundTrip();
+
+#endif // UT_RETAINED_H_
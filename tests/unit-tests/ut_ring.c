@@ -0,0 +1,124 @@
+/*C************************************************************************************************
+ * FILENAME:        ut_ring.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the test functions to verify the lock-free ring of the outgoing
+ *      Bluetooth messages:
+ *      [1] Sequentially: order, full and empty ring, too long strings, wrap of the slots
+ *      [2] With several producer threads pushing at once while the consumer pops, as the
+ *          interrupts preempting each other in the firmware
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    UT_Ring_testSequential()
+ *      void    UT_Ring_testProducers()
+ *
+ * NOTES:
+ *      The threads stress the host implementation on the C11 atomics, the algorithm is the same
+ *      of the exclusive load and store of the Cortex-M4.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../inc/ring.h"
+#include "ut_ring.h"
+
+#define UT_RING_PRODUCERS 4       /* Threads pushing at once                                    */
+#define UT_RING_MESSAGES 20000    /* Messages pushed by every thread                            */
+
+static StringRing ring;
+
+void UT_Ring_testSequential() {
+    char message[RING_ELEMENT_SIZE];
+    RING_init(&ring);
+    assert(RING_isEmpty(&ring) && RING_front(&ring) == NULL && "New ring not empty");
+
+    // Fill, then the next push fails
+    for (int i = 0; i < RING_SIZE; i++) {
+        snprintf(message, sizeof(message), "M%d", i);
+        bool isPushed = RING_push(&ring, message);
+        assert(isPushed && "Push failed with free slots");
+    }
+    bool isPushed = RING_push(&ring, "X");
+    assert(RING_isFull(&ring) && !isPushed && "Push succeeded on a full ring");
+
+    // Popped in order, several times around the slots
+    for (int i = 0; i < 5 * RING_SIZE; i++) {
+        snprintf(message, sizeof(message), "M%d", i);
+        assert(RING_front(&ring) != NULL && strcmp(RING_front(&ring), message) == 0
+               && "Messages out of order");
+        RING_pop(&ring);
+        snprintf(message, sizeof(message), "M%d", i + RING_SIZE);
+        isPushed = RING_push(&ring, message);
+        assert(isPushed && "Push failed after a pop");
+    }
+    for (int i = 0; i < RING_SIZE; i++)
+        RING_pop(&ring);
+    assert(RING_isEmpty(&ring) && !RING_isFull(&ring) && "Ring not empty after the pops");
+
+    // Nothing to pop on an empty ring, too long strings are rejected
+    RING_pop(&ring);
+    assert(RING_isEmpty(&ring) && "Pop of an empty ring");
+    char longest[RING_ELEMENT_SIZE + 1];
+    memset(longest, 'a', RING_ELEMENT_SIZE);
+    longest[RING_ELEMENT_SIZE] = '\0';
+    isPushed = RING_push(&ring, longest);
+    assert(!isPushed && RING_isEmpty(&ring) && "Too long string pushed");
+    longest[RING_ELEMENT_SIZE - 1] = '\0';
+    isPushed = RING_push(&ring, longest);
+    assert(isPushed && strcmp(RING_front(&ring), longest) == 0 && "Longest string not pushed");
+}
+
+static void *UT_Ring_produce(void *argument) {
+    int producer = *(int *)argument;
+    char message[RING_ELEMENT_SIZE];
+    for (int i = 0; i < UT_RING_MESSAGES; i++) {
+        snprintf(message, sizeof(message), "%d %d", producer, i);
+        while (!RING_push(&ring, message))
+            sched_yield();
+    }
+    return NULL;
+}
+
+void UT_Ring_testProducers() {
+    pthread_t threads[UT_RING_PRODUCERS];
+    int producers[UT_RING_PRODUCERS];
+    int next[UT_RING_PRODUCERS] = {0};
+    RING_init(&ring);
+    for (int p = 0; p < UT_RING_PRODUCERS; p++) {
+        producers[p] = p;
+        int error = pthread_create(&threads[p], NULL, UT_Ring_produce, &producers[p]);
+        assert(error == 0 && "Producer not started");
+    }
+
+    // Every message once, in the order of its producer
+    for (int n = 0; n < UT_RING_PRODUCERS * UT_RING_MESSAGES;) {
+        const char *message = RING_front(&ring);
+        if (message == NULL) {
+            sched_yield();
+            continue;
+        }
+        int producer = -1, i = -1;
+        int fields = sscanf(message, "%d %d", &producer, &i);
+        assert(fields == 2 && "Corrupted message");
+        assert(producer >= 0 && producer < UT_RING_PRODUCERS && "Corrupted message");
+        assert(i == next[producer] && "Message lost, duplicated or out of order");
+        next[producer]++;
+        RING_pop(&ring);
+        n++;
+    }
+
+    for (int p = 0; p < UT_RING_PRODUCERS; p++)
+        pthread_join(threads[p], NULL);
+    assert(RING_isEmpty(&ring) && "Messages left in the ring");
+}
@@ -0,0 +1,27 @@
+/*H************************************************************************************************
+ * FILENAME:        ut_ring.h
+ *
+ * DESCRIPTION:
+ *      This header file provides the test functions to verify the lock-free ring of the outgoing
+ *      Bluetooth messages.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    UT_Ring_testSequential()
+ *      void    UT_Ring_testProducers()
+ *
+ * NOTES:
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#ifndef UT_RING_H_
+#define UT_RING_H_
+
+void UT_Ring_testSequential();
+void UT_Ring_testProducers();
+
+#endif // UT_RING_H_
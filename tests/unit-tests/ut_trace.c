@@ -0,0 +1,169 @@
+/*C************************************************************************************************
+ * FILENAME:        ut_trace.c
+ *
+ * DESCRIPTION:
+ *      This source file provides the test functions to verify the capture of the execution trace
+ *      and the decoding of its dump, as done by tools/tracer:
+ *      [1] The events recorded are decoded from the dump with their timestamps, unwrapped across
+ *          the wrap of the counter, and the lines that are not part of the dump are told apart
+ *      [2] A full buffer ends the capture and is dumped whole
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    UT_Trace_testDump()
+ *      void    UT_Trace_testFull()
+ *
+ * NOTES:
+ *      The timestamps are the ticks of the mocked timer, set by the test through its hooks.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../inc/trace.h"
+#include "../bluetooth_hal.h"
+#include "../timer_hal.h"
+#include "ut_trace.h"
+
+#define UT_TRACE_CLOCK_RATE 93750  /* Rate of the mocked timer ticks                          */
+#define UT_TRACE_START 0xFFFFFF00U /* Ticks at the start of the capture, before the wrap      */
+#define UT_TRACE_LINES (TRACE_BUFFER_SIZE + 1)
+
+static uint32_t ticks;
+static char lines[UT_TRACE_LINES][TRACE_EVENT_TEXT_LENGTH + 2]; /* Dump sent via Bluetooth   */
+static uint16_t lineCount;
+
+static uint32_t UT_Trace_getTicks() { return ticks; }
+
+static const TimerHooks traceTimerHooks = {
+    .setupPeriodic = NULL,
+    .acquireShared = NULL,
+    .releaseShared = NULL,
+    .getTicks = UT_Trace_getTicks,
+};
+
+static void UT_Trace_onTransmit(const char *message) {
+    if (lineCount < UT_TRACE_LINES)
+        snprintf(lines[lineCount], sizeof(lines[0]), "%s", message);
+    lineCount++;
+}
+
+static void UT_Trace_dump() {
+    lineCount = 0;
+    TRACE_flush();
+}
+
+void UT_Trace_testDump() {
+    static const struct {
+        uint32_t delay;
+        TraceId id;
+        TracePhase phase;
+        uint16_t arg;
+    } recorded[] = {
+        {0, TRACE_ID_STATE, TRACE_PHASE_INSTANT, 1},
+        {0x10, TRACE_ID_US_ECHO, TRACE_PHASE_BEGIN, 42},
+        {0x80, TRACE_ID_MOTOR_SPEED, TRACE_PHASE_INSTANT, 70 | 1 << 8},
+        {0x70, TRACE_ID_US_ECHO, TRACE_PHASE_END, 0}, /* Wraps to 0x00000000 */
+        {0x1234, TRACE_ID_SERVO, TRACE_PHASE_INSTANT, (uint8_t)-45},
+        {0xFFFFFF, TRACE_ID_BATTERY, TRACE_PHASE_INSTANT, 7400},
+    };
+    const uint8_t numRecorded = sizeof(recorded) / sizeof(recorded[0]);
+    TIMER_HAL_registerHooks(&traceTimerHooks);
+    BT_HAL_registerTransmitHook(UT_Trace_onTransmit);
+    TRACE_init();
+
+    // Nothing recorded nor dumped before the start
+    ticks = UT_TRACE_START;
+    TRACE_event(TRACE_ID_BT_RX, TRACE_PHASE_BEGIN, 'F');
+    UT_Trace_dump();
+    assert(lineCount == 0 && "Dump without a capture");
+
+    TRACE_start();
+    for (uint8_t i = 0; i < numRecorded; i++) {
+        ticks += recorded[i].delay;
+        TRACE_event(recorded[i].id, recorded[i].phase, recorded[i].arg);
+    }
+    TRACE_stop();
+    TRACE_event(TRACE_ID_BT_RX, TRACE_PHASE_BEGIN, 'F');
+    UT_Trace_dump();
+    assert(lineCount == numRecorded + 1 && "Events recorded after the stop or lost");
+
+    // The clock line, then the events with their unwrapped timestamps
+    uint32_t rate = 0;
+    TraceEvent event;
+    TraceLine line = TRACE_decodeLine(lines[0], &rate, &event);
+    assert(line == TRACE_LINE_CLOCK && rate == UT_TRACE_CLOCK_RATE && "Clock line not decoded");
+    uint64_t time = UT_TRACE_START;
+    uint64_t decodedTime = 0;
+    for (uint8_t i = 0; i < numRecorded; i++) {
+        line = TRACE_decodeLine(lines[i + 1], &rate, &event);
+        assert(line == TRACE_LINE_EVENT && "Event line not decoded");
+        assert(event.id == recorded[i].id && event.phase == recorded[i].phase &&
+               event.arg == recorded[i].arg && "Decoded event not the recorded one");
+        time += recorded[i].delay;
+        decodedTime = i == 0 ? event.time : TRACE_unwrap(decodedTime, event.time);
+        assert(event.time == (uint32_t)time && decodedTime == time && "Wrong timestamp");
+    }
+    assert(decodedTime > 0xFFFFFFFFU && "Timestamps not unwrapped");
+
+    // Once dumped, the capture is not sent again
+    UT_Trace_dump();
+    assert(lineCount == 0 && "Capture dumped twice");
+
+    // The prefix is searched in the whole line, the others are told apart
+    line = TRACE_decodeLine("12:00:01 &CLOCK 24000000\n", &rate, &event);
+    assert(line == TRACE_LINE_CLOCK && rate == 24000000 && "Clock line in the log not decoded");
+    line = TRACE_decodeLine("12:00:01 &0000ABCD03B002A\n", &rate, &event);
+    assert(line == TRACE_LINE_EVENT && event.time == 0xABCD && event.id == TRACE_ID_US_ECHO &&
+           event.arg == 42 && "Event line in the log not decoded");
+    line = TRACE_decodeLine("12:00:01 B 20 -3\n", &rate, &event);
+    assert(line == TRACE_LINE_OTHER && "Telemetry line taken for the dump");
+    line = TRACE_decodeLine("&0000ABCD03B00", &rate, &event);
+    assert(line == TRACE_LINE_INVALID && "Truncated event decoded");
+    line = TRACE_decodeLine("&0000ABCD0FB002A", &rate, &event);
+    assert(line == TRACE_LINE_INVALID && "Unknown id decoded");
+    line = TRACE_decodeLine("&0000ABCD03X002A", &rate, &event);
+    assert(line == TRACE_LINE_INVALID && "Unknown phase decoded");
+
+    BT_HAL_registerTransmitHook(NULL);
+    TIMER_HAL_registerHooks(NULL);
+}
+
+void UT_Trace_testFull() {
+    TIMER_HAL_registerHooks(&traceTimerHooks);
+    BT_HAL_registerTransmitHook(UT_Trace_onTransmit);
+    TRACE_init();
+
+    // The capture ends when the buffer is full, the next events are dropped
+    ticks = 0;
+    TRACE_start();
+    for (uint16_t i = 0; i < TRACE_BUFFER_SIZE + 10; i++) {
+        ticks += 3;
+        TRACE_event(TRACE_ID_TELEMETRY, TRACE_PHASE_INSTANT, i);
+    }
+    const TraceEvent *events;
+    uint16_t count = TRACE_getEvents(&events);
+    assert(count == TRACE_BUFFER_SIZE && "Capture not ended by the full buffer");
+
+    // The whole buffer is dumped in order
+    UT_Trace_dump();
+    assert(lineCount == UT_TRACE_LINES && "Full capture not dumped whole");
+    uint32_t rate;
+    TraceEvent event;
+    for (uint16_t i = 0; i < TRACE_BUFFER_SIZE; i++) {
+        TraceLine line = TRACE_decodeLine(lines[i + 1], &rate, &event);
+        assert(line == TRACE_LINE_EVENT && event.arg == i && event.time == 3U * (i + 1) &&
+               "Event of a full capture lost or out of order");
+    }
+
+    TRACE_init();
+    BT_HAL_registerTransmitHook(NULL);
+    TIMER_HAL_registerHooks(NULL);
+}
@@ -0,0 +1,27 @@
+/*H************************************************************************************************
+ * FILENAME:        ut_trace.h
+ *
+ * DESCRIPTION:
+ *      This header file provides the test functions to verify the capture of the execution trace
+ *      and the decoding of its dump.
+ *
+ * PUBLIC FUNCTIONS:
+ *      void    UT_Trace_testDump()
+ *      void    UT_Trace_testFull()
+ *
+ * NOTES:
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#ifndef UT_TRACE_H_
+#define UT_TRACE_H_
+
+void UT_Trace_testDump();
+void UT_Trace_testFull();
+
+#endif // UT_TRACE_H_
@@ -0,0 +1,268 @@
+/*C************************************************************************************************
+ * FILENAME:        blelink.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that benchmarks the Bluetooth link of the car
+ *      through the HC-08 emulator: telemetry throughput, wait in the module and command latency
+ *      for a range of connection intervals.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: blelink [-i intervals] [-k packets] [-t seconds] [-b baud] [-s seed] <map>
+ *      -i is a comma separated list of connection intervals in ms (default 7.5,15,30,50), -k the
+ *      packets per connection event (default 4). The tool plays the central on the
+ *      pseudo-terminal in virtual time: it switches the car between autonomous and manual mode
+ *      every SWITCH_PERIOD, measuring the time from the write of the command to the change of
+ *      state, and collects the telemetry in the meantime.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../inc/state_machine.h"
+#include "../../tests/sim/sim_car.h"
+#include "../../tests/sim/sim_hc08.h"
+#include "../../tests/sim/sim_uart.h"
+
+#define BLELINK_SECONDS 60              /* Default simulated time of every interval          */
+#define BLELINK_STEP 100                /* Time between two reads of the central (µs)        */
+#define BLELINK_SWITCH_PERIOD 2000000   /* Time between two mode commands (µs)               */
+#define BLELINK_COMMAND_TIMEOUT 1000000 /* Time after which a command is considered lost (µs) */
+
+/*T************************************************************************************************
+ * NAME: Result
+ *
+ * DESCRIPTION:
+ *      Represent the outcome of the benchmark of a connection interval.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t        received        Bytes received by the central
+ *              uint32_t        lines           Telemetry lines received by the central
+ *              uint32_t        commands        Commands executed
+ *              uint32_t        lostCommands    Commands not executed within the timeout
+ *              uint64_t        commandTime     Sum of the command latencies (µs)
+ *              uint64_t        maxCommandTime  Worst command latency (µs)
+ *              SimHc08Stats    module          Counters of the module
+ *              SimUartStats    uart            Counters of the UART
+ */
+typedef struct {
+    uint32_t received;
+    uint32_t lines;
+    uint32_t commands;
+    uint32_t lostCommands;
+    uint64_t commandTime;
+    uint64_t maxCommandTime;
+    SimHc08Stats module;
+    SimUartStats uart;
+} Result;
+
+static void readCentral(int fd, Result *result) {
+    char data[256];
+    ssize_t n;
+    while ((n = read(fd, data, sizeof(data))) > 0) {
+        result->received += n;
+        for (ssize_t i = 0; i < n; i++)
+            result->lines += data[i] == '\n';
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: bool benchmark(const SimWorld *world, const SimHc08Config *config, uint32_t baud,
+ *                      uint64_t duration, uint64_t seed, Result *result)
+ *
+ * DESCRIPTION:
+ *      Runs the car with the emulated module and plays the central:
+ *      [1] Boots the car, opens the pseudo-terminal and connects to it
+ *      [2] Alternates AUT and MAN, measuring when the state of the application changes
+ *      [3] Collects the counters of the link
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimWorld*         world       Room of the car
+ *          const SimHc08Config*    config      Module and connection
+ *          uint32_t                baud        Baud rate of the UART
+ *          uint64_t                duration    Simulated time (µs)
+ *          uint64_t                seed        Seed of the simulation
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          Result*                 result      Outcome of the benchmark
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the pseudo-terminal cannot be used
+ *
+ *  NOTE:
+ */
+static bool benchmark(const SimWorld *world, const SimHc08Config *config, uint32_t baud,
+                      uint64_t duration, uint64_t seed, Result *result) {
+    // [1] Car, module and central
+    SimCarParams params = SIM_CAR_defaultParams();
+    SIM_CAR_init(world, &params, seed);
+    char name[64];
+    if (!SIM_UART_open(baud, name, sizeof(name)))
+        return false;
+    SIM_HC08_init(config);
+    int fd = open(name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) {
+        SIM_UART_close();
+        return false;
+    }
+    memset(result, 0, sizeof(*result));
+
+    // [2] Commands
+    uint64_t elapsed = 0;
+    while (elapsed < duration) {
+        bool isAutonomous = FSM_currentState != STATE_REMOTE;
+        const char *command = isAutonomous ? "MAN\n" : "AUT\n";
+        if (write(fd, command, strlen(command)) < 0)
+            break;
+
+        uint64_t latency = 0;
+        while (latency < BLELINK_COMMAND_TIMEOUT &&
+               (FSM_currentState != STATE_REMOTE) == isAutonomous) {
+            SIM_CAR_run(BLELINK_STEP);
+            readCentral(fd, result);
+            latency += BLELINK_STEP;
+        }
+        if ((FSM_currentState != STATE_REMOTE) == isAutonomous) {
+            result->lostCommands++;
+        } else {
+            result->commands++;
+            result->commandTime += latency;
+            if (latency > result->maxCommandTime)
+                result->maxCommandTime = latency;
+        }
+
+        for (uint64_t t = latency; t < BLELINK_SWITCH_PERIOD; t += BLELINK_STEP) {
+            SIM_CAR_run(BLELINK_STEP);
+            readCentral(fd, result);
+        }
+        elapsed += latency > BLELINK_SWITCH_PERIOD ? latency : BLELINK_SWITCH_PERIOD;
+    }
+
+    // [3] Counters
+    result->module = SIM_HC08_getStats();
+    result->uart = SIM_UART_getStats();
+    close(fd);
+    SIM_UART_close();
+    return true;
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options and load the room
+ *      [2] Benchmark every connection interval
+ *      [3] Print a row per interval
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options and map
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS, EXIT_FAILURE on invalid arguments or unusable terminal
+ *
+ *  NOTE:
+ *      The intervals are rounded to the 1.25ms granularity of Bluetooth Low Energy.
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options and room
+    char intervalList[128] = "7.5,15,30,50";
+    uint8_t packets = SIM_HC08_defaultConfig().packets;
+    double seconds = BLELINK_SECONDS;
+    uint32_t baud = SIM_UART_BAUD;
+    uint64_t seed = 1;
+    int option;
+    while ((option = getopt(argc, argv, "i:k:t:b:s:")) != -1) {
+        switch (option) {
+        case 'i':
+            snprintf(intervalList, sizeof(intervalList), "%s", optarg);
+            break;
+        case 'k':
+            packets = strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            seconds = atof(optarg);
+            break;
+        case 'b':
+            baud = strtoul(optarg, NULL, 10);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind != argc - 1 || packets == 0) {
+        fprintf(stderr,
+                "Usage: %s [-i intervals] [-k packets] [-t seconds] [-b baud] [-s seed] <map>\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static SimWorld world;
+    if (!SIM_WORLD_load(&world, argv[optind])) {
+        fprintf(stderr, "Cannot load the map %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    // [2] and [3] Benchmarks
+    printf("%8s %9s %9s %8s %9s %9s %8s %9s %9s %6s\n", "interval", "capacity", "telemetry",
+           "lines/s", "wait", "max wait", "notif/s", "command", "max cmd", "lost");
+    for (char *token = strtok(intervalList, ","); token != NULL; token = strtok(NULL, ",")) {
+        SimHc08Config config = SIM_HC08_defaultConfig();
+        config.interval = lround(atof(token) * 1000 / SIM_HC08_UNIT);
+        config.packets = packets;
+        if (config.interval < 6)
+            config.interval = 6;
+
+        Result result;
+        if (!benchmark(&world, &config, baud, seconds * 1e6, seed, &result)) {
+            fprintf(stderr, "Cannot use a pseudo-terminal\n");
+            return EXIT_FAILURE;
+        }
+
+        double interval = config.interval * SIM_HC08_UNIT / 1e3;
+        double capacity = packets * SIM_HC08_PAYLOAD * 1e3 / interval;
+        double bytes = result.module.uplinkBytes > 0 ? result.module.uplinkBytes : 1;
+        double commands = result.commands > 0 ? result.commands : 1;
+        printf("%6.2fms %7.0fB/s %7.1fB/s %8.2f %7.2fms %7.2fms %8.1f %7.2fms %7.2fms %3u/%u\n",
+               interval, capacity, result.received / seconds, result.lines / seconds,
+               result.module.uplinkLatency / 1e3 / bytes, result.module.maxUplinkLatency / 1e3,
+               result.module.notifications / seconds, result.commandTime / 1e3 / commands,
+               result.maxCommandTime / 1e3, result.lostCommands,
+               result.commands + result.lostCommands);
+        if (result.module.droppedBytes > 0 || result.uart.droppedMessages > 0)
+            printf("%8s %u bytes dropped by the module, %u messages by the firmware queue\n", "",
+                   result.module.droppedBytes, result.uart.droppedMessages);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,918 @@
+/*C************************************************************************************************
+ * FILENAME:        dashboard.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a terminal dashboard that decodes the Bluetooth stream of the
+ *      car, live from a serial device or a pseudo-terminal or offline from a capture, and shows
+ *      mode, motors, battery, obstacles, link statistics and command latency.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: dashboard [-b baud] [-w capture.txt] [-r lines] [-B] <device|capture>
+ *      A tty (the HC-08 serial adapter, the pseudo-terminal of simulator -p) is read live at the
+ *      given baud rate (default 9600): the keys send the BLE commands and the time to the first
+ *      telemetry message that follows is the host latency, -w saves the received lines. A file
+ *      is a capture: it is decoded at once and the final dashboard is printed, or replayed at
+ *      -r lines per second. -B reads a binary dump of the flash log of the recorder instead.
+ *      The text stream holds the telemetry messages (type:..,sev:..,key:value) and the binary
+ *      events of the recorder (lines starting with '#', see recorder.h): the servo positions
+ *      and the echoes build the distance map, the received commands and the following outputs
+ *      give the latency on the car. The screen is redrawn at most every DASHBOARD_REFRESH, in
+ *      place, so a high message rate costs only the decoding.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Distance map from the points of the sensor sweep
+ */
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../inc/crash.h"
+#include "../../inc/profiler.h"
+#include "../../inc/recorder.h"
+#include "../../inc/ring.h"
+#include "../../inc/telemetry_module.h"
+#include "../../inc/trace.h"
+#include "../../tests/sim/sim_clock.h"
+#include "../../tests/sim/sim_replay.h"
+
+#define DASHBOARD_BAUD 9600              /* Default baud rate of the serial device            */
+#define DASHBOARD_LINE_SIZE 256          /* Longest line accepted, longer ones are split      */
+#define DASHBOARD_REFRESH 100000         /* Minimum time between two redraws (µs)             */
+#define DASHBOARD_BUCKET 100000          /* Duration of a bucket of the throughput (µs)       */
+#define DASHBOARD_BUCKETS 10             /* Buckets of the throughput window                  */
+#define DASHBOARD_HISTORY 64             /* Battery readings kept for the trend               */
+#define DASHBOARD_LATENCIES 4096         /* Latencies kept for the percentiles                */
+#define DASHBOARD_COMMAND_TIMEOUT 2000000 /* Time after which a command had no reaction (µs)  */
+#define DASHBOARD_ANGLE_STEP 15          /* Width of a sector of the distance map (deg)       */
+#define DASHBOARD_SECTORS (180 / DASHBOARD_ANGLE_STEP + 1)
+#define DASHBOARD_MAX_RANGE 250          /* Distance of a full bar of the map (cm)            */
+#define DASHBOARD_BAR_WIDTH 40           /* Chars of a full bar                               */
+#define DASHBOARD_MIN_VOLTAGE 6000       /* Empty battery (mV), as in battery_hal.c           */
+#define DASHBOARD_MAX_VOLTAGE 8400       /* Full battery (mV), as in battery_hal.c            */
+#define DASHBOARD_FRAME_SIZE 16384
+#define DASHBOARD_MAX_EVENTS 1000000     /* Capacity of a binary dump                         */
+#define DASHBOARD_UNKNOWN -1
+
+/*T************************************************************************************************
+ * NAME: Stream
+ *
+ * DESCRIPTION:
+ *      Represent the kind of a received line, told by its first char.
+ *
+ * SPECIFICATIONS:
+ *      Type:   enum
+ *      Values: STREAM_TELEMETRY    Telemetry message
+ *              STREAM_RECORDER     Recorded events
+ *              STREAM_PROFILER     Profiler samples
+ *              STREAM_TRACE        Execution trace dump
+ *              STREAM_CRASH        Crash report
+ *              STREAM_OTHER        Anything else, e.g. the answers of the HC-08
+ */
+typedef enum {
+    STREAM_TELEMETRY,
+    STREAM_RECORDER,
+    STREAM_PROFILER,
+    STREAM_TRACE,
+    STREAM_CRASH,
+    STREAM_OTHER,
+    NUM_STREAMS
+} Stream;
+
+static const char *streamNames[NUM_STREAMS] = {"telemetry", "recorder", "profiler",
+                                               "trace",     "crash",    "other"};
+
+/*T************************************************************************************************
+ * NAME: Latencies
+ *
+ * DESCRIPTION:
+ *      Represent the last DASHBOARD_LATENCIES latencies of a kind.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint64_t[]  samples     Latencies (µs), circular
+ *              uint32_t    count       Latencies measured so far
+ *              uint32_t    missed      Commands without reaction
+ */
+typedef struct {
+    uint64_t samples[DASHBOARD_LATENCIES];
+    uint32_t count;
+    uint32_t missed;
+} Latencies;
+
+/*T************************************************************************************************
+ * NAME: Dashboard
+ *
+ * DESCRIPTION:
+ *      Represent everything known about the car and the link.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   int32_t     mode            1 autonomous, 0 remote, DASHBOARD_UNKNOWN
+ *              int32_t[]   speed           Speed of the left and right motor (%)
+ *              int32_t[]   direction       MotorDirection of the left and right motor
+ *              uint16_t[]  voltages        Last battery readings (mV), circular
+ *              uint32_t    readings        Battery readings so far
+ *              int32_t     queueDrops      Messages dropped by the car, from the battery status
+ *              uint32_t    recorderDrops   Events lost by the recorder
+ *              int32_t     obstacle        Distance of the last detected obstacle (cm)
+ *              int32_t     servo           Last commanded servo position (deg)
+ *              int32_t[]   sectors         Last echo of every sector of the map (cm)
+ *              uint32_t[]  lines           Lines received per stream
+ *              uint32_t    badLines        Lines that cannot be decoded
+ *              uint64_t    bytes           Bytes received
+ *              uint32_t[]  bucketBytes     Bytes of the buckets of the throughput window
+ *              uint32_t[]  bucketLines     Lines of the buckets of the throughput window
+ *              uint64_t    bucket          Index of the current bucket
+ *              Latencies   host            From a key to the first telemetry message after it
+ *              Latencies   car             From a received command to the first output
+ *              char[]      pending         Command waiting for its reaction, empty if none
+ *              uint64_t    pendingSince    Time of the command (µs)
+ *              bool        isRxPending     A command has been recorded, waiting for an output
+ *              uint32_t    rxTick          Tick of the recorded command
+ *              char[]      crash           First line of the last crash report
+ *              uint64_t    start           Time of the first line (µs)
+ *              uint64_t    now             Time of the last line (µs)
+ */
+typedef struct {
+    int32_t mode;
+    int32_t speed[2];
+    int32_t direction[2];
+    uint16_t voltages[DASHBOARD_HISTORY];
+    uint32_t readings;
+    int32_t queueDrops;
+    uint32_t recorderDrops;
+    int32_t obstacle;
+    int32_t servo;
+    int32_t sectors[DASHBOARD_SECTORS];
+    uint32_t lines[NUM_STREAMS];
+    uint32_t badLines;
+    uint64_t bytes;
+    uint32_t bucketBytes[DASHBOARD_BUCKETS];
+    uint32_t bucketLines[DASHBOARD_BUCKETS];
+    uint64_t bucket;
+    Latencies host;
+    Latencies car;
+    char pending[4];
+    uint64_t pendingSince;
+    bool isRxPending;
+    uint32_t rxTick;
+    char crash[RING_ELEMENT_SIZE];
+    uint64_t start;
+    uint64_t now;
+} Dashboard;
+
+/*T************************************************************************************************
+ * NAME: Key
+ *
+ * DESCRIPTION:
+ *      Represent a key of the live mode and the BLE command it sends.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   char            key         Key pressed
+ *              const char*     command     Command sent to the car
+ *              const char*     label       Shown in the help line
+ */
+typedef struct {
+    char key;
+    const char *command;
+    const char *label;
+} Key;
+
+static const Key keys[] = {
+    {'f', "FWD", "fwd"},    {'b', "REV", "rev"},  {'l', "LFT", "left"},
+    {'r', "RGT", "right"},  {'s', "STP", "stop"}, {'a', "AUT", "auto"},
+    {'m', "MAN", "manual"}, {'t', "TRC", "trace"}, {'d', "TRD", "dump"},
+};
+
+static Dashboard dashboard;
+static struct termios stdinAttributes;
+static bool isStdinRaw = false;
+static volatile sig_atomic_t isInterrupted = 0;
+
+static uint64_t nowUs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static void onSignal(int signal) { isInterrupted = 1; }
+
+static void restoreStdin() {
+    if (isStdinRaw)
+        tcsetattr(STDIN_FILENO, TCSANOW, &stdinAttributes);
+    isStdinRaw = false;
+}
+
+static void addLatency(Latencies *latencies, uint64_t latency) {
+    latencies->samples[latencies->count % DASHBOARD_LATENCIES] = latency;
+    latencies->count++;
+}
+
+static void advanceBuckets(Dashboard *d, uint64_t now) {
+    uint64_t bucket = now / DASHBOARD_BUCKET;
+    for (uint64_t b = d->bucket + 1; b <= bucket && b <= d->bucket + DASHBOARD_BUCKETS; b++) {
+        d->bucketBytes[b % DASHBOARD_BUCKETS] = 0;
+        d->bucketLines[b % DASHBOARD_BUCKETS] = 0;
+    }
+    if (bucket > d->bucket)
+        d->bucket = bucket;
+}
+
+static void onReaction(Dashboard *d) {
+    if (d->pending[0] != '\0') {
+        addLatency(&d->host, d->now - d->pendingSince);
+        d->pending[0] = '\0';
+    }
+}
+
+static void onEvent(Dashboard *d, const RecorderEvent *event) {
+    uint8_t side = event->value >> 8 ? 1 : 0;
+    switch (event->channel) {
+    case RECORDER_CHANNEL_BT_RX:
+        // the string is split in pairs of chars, the pair with a '\0' ends the command
+        if ((event->value & 0xFF) == 0 || (event->value >> 8) == 0) {
+            d->isRxPending = true;
+            d->rxTick = event->tick;
+        }
+        return;
+    case RECORDER_CHANNEL_US_ECHO:
+        if (d->servo != DASHBOARD_UNKNOWN)
+            d->sectors[(d->servo + 90 + DASHBOARD_ANGLE_STEP / 2) / DASHBOARD_ANGLE_STEP] =
+                event->value;
+        return;
+    case RECORDER_CHANNEL_BATTERY:
+        d->voltages[d->readings++ % DASHBOARD_HISTORY] = event->value;
+        return;
+    case RECORDER_CHANNEL_OVERFLOW:
+        d->recorderDrops += event->value;
+        return;
+    case RECORDER_CHANNEL_MOTOR_SPEED:
+        d->speed[side] = event->value & 0xFF;
+        break;
+    case RECORDER_CHANNEL_MOTOR_DIRECTION:
+        d->direction[side] = event->value & 0xFF;
+        break;
+    case RECORDER_CHANNEL_SERVO:
+        d->servo = (int8_t)event->value;
+        break;
+    case RECORDER_CHANNEL_TELEMETRY:
+        break;
+    default:
+        return;
+    }
+
+    // an output, the reaction to the last command if any
+    if (d->isRxPending) {
+        addLatency(&d->car, SIM_CLOCK_TICKS_TO_US(event->tick - d->rxTick));
+        d->isRxPending = false;
+    }
+}
+
+static bool onTelemetry(Dashboard *d, char *text) {
+    int type, severity, length;
+    if (sscanf(text, "type:%d,sev:%d%n", &type, &severity, &length) != 2)
+        return false;
+    onReaction(d);
+    int32_t angle = 0;
+    bool hasAngle = false;
+    for (char *pair = strtok(text + length, ","); pair != NULL; pair = strtok(NULL, ",")) {
+        char *colon = strchr(pair, ':');
+        if (colon == NULL)
+            return false;
+        *colon = '\0';
+        int32_t value = strtol(colon + 1, NULL, 10);
+        if (strcmp(pair, "v") == 0 && type == MSG_BATTERY_STATUS_UPDATE)
+            d->voltages[d->readings++ % DASHBOARD_HISTORY] = value;
+        else if (strcmp(pair, "q") == 0)
+            d->queueDrops = value;
+        else if (strcmp(pair, "sp") == 0)
+            d->speed[type == MSG_R_MOTOR_SPEED_UPDATE] = value;
+        else if (strcmp(pair, "dir") == 0)
+            d->direction[type == MSG_R_MOTOR_DIR_UPDATE] = value;
+        else if (strcmp(pair, "dst") == 0)
+            d->obstacle = value;
+        else if (strcmp(pair, "mode") == 0)
+            d->mode = value;
+        else if (strcmp(pair, "a") == 0 && type == MSG_SWEEP_POINT) {
+            angle = value;
+            hasAngle = angle >= -90 && angle <= 90;
+        } else if (strcmp(pair, "d") == 0 && type == MSG_SWEEP_POINT && hasAngle)
+            d->sectors[(angle + 90 + DASHBOARD_ANGLE_STEP / 2) / DASHBOARD_ANGLE_STEP] = value;
+    }
+    return true;
+}
+
+/*F************************************************************************************************
+ * NAME: void feedLine(Dashboard *d, char *line, uint64_t now)
+ *
+ * DESCRIPTION:
+ *      [1] Updates the counters of the link
+ *      [2] Decodes the line according to its first char
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Dashboard*  d           State to update
+ *          char*       line        Received line without the line terminator, modified
+ *          uint64_t    now         Time of the reception (µs)
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          Dashboard*  d           Updated
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void feedLine(Dashboard *d, char *line, uint64_t now) {
+    size_t length = strlen(line);
+    if (length == 0)
+        return;
+
+    // [1] Link
+    if (d->start == 0)
+        d->start = now;
+    d->now = now;
+    advanceBuckets(d, now);
+    d->bytes += length + 2;
+    d->bucketBytes[d->bucket % DASHBOARD_BUCKETS] += length + 2;
+    d->bucketLines[d->bucket % DASHBOARD_BUCKETS]++;
+
+    // [2] Decoding
+    Stream stream;
+    bool isValid = true;
+    switch (line[0]) {
+    case RECORDER_STREAM_PREFIX: {
+        stream = STREAM_RECORDER;
+        const char *text = line + 1;
+        for (; *text != '\0' && isValid; text += RECORDER_EVENT_TEXT_LENGTH) {
+            RecorderEvent event;
+            isValid = strlen(text) >= RECORDER_EVENT_TEXT_LENGTH && RECORDER_decode(text, &event);
+            if (isValid)
+                onEvent(d, &event);
+        }
+        break;
+    }
+    case PROFILER_STREAM_PREFIX:
+        stream = STREAM_PROFILER;
+        break;
+    case TRACE_STREAM_PREFIX:
+        stream = STREAM_TRACE;
+        break;
+    case CRASH_STREAM_PREFIX:
+        stream = STREAM_CRASH;
+        if (strncmp(line + 1, "CRASH", 5) == 0)
+            snprintf(d->crash, sizeof(d->crash), "%s", line + 1);
+        break;
+    default:
+        stream = strncmp(line, "type:", 5) == 0 ? STREAM_TELEMETRY : STREAM_OTHER;
+        if (stream == STREAM_TELEMETRY)
+            isValid = onTelemetry(d, line);
+    }
+    d->lines[stream]++;
+    if (!isValid)
+        d->badLines++;
+}
+
+static int compareLatencies(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static const char *directionName(int32_t direction) {
+    switch (direction) {
+    case MOTOR_DIR_FORWARD:
+        return "FWD";
+    case MOTOR_DIR_REVERSE:
+        return "REV";
+    case MOTOR_DIR_STOP:
+        return "STOP";
+    default:
+        return "?";
+    }
+}
+
+static const char *motionName(const Dashboard *d) {
+    bool isMoving[2];
+    for (uint8_t i = 0; i < 2; i++) {
+        if (d->direction[i] == DASHBOARD_UNKNOWN)
+            return "?";
+        isMoving[i] = d->direction[i] != MOTOR_DIR_STOP && d->speed[i] != 0;
+    }
+    if (!isMoving[0] && !isMoving[1])
+        return "stopped";
+    if (d->direction[0] == d->direction[1])
+        return d->direction[0] == MOTOR_DIR_FORWARD ? "forward" : "backward";
+    return d->direction[0] == MOTOR_DIR_FORWARD ? "turning right" : "turning left";
+}
+
+static int32_t toPercentage(uint16_t voltage) {
+    int32_t percentage = (voltage - DASHBOARD_MIN_VOLTAGE) * 100 /
+                         (DASHBOARD_MAX_VOLTAGE - DASHBOARD_MIN_VOLTAGE);
+    return percentage < 0 ? 0 : percentage > 100 ? 100 : percentage;
+}
+
+/*T************************************************************************************************
+ * NAME: Frame
+ *
+ * DESCRIPTION:
+ *      Represent the text of a redraw, written to the terminal at once.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   char[]      text        Content
+ *              size_t      length      Chars written
+ *              bool        isLive      Lines end with the erase of the rest of the line
+ */
+typedef struct {
+    char text[DASHBOARD_FRAME_SIZE];
+    size_t length;
+    bool isLive;
+} Frame;
+
+static void __attribute__((format(printf, 2, 3))) printLine(Frame *frame, const char *format, ...) {
+    size_t space = sizeof(frame->text) - frame->length;
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(frame->text + frame->length, space, format, args);
+    va_end(args);
+    if (written > 0)
+        frame->length += (size_t)written < space ? (size_t)written : space - 1;
+    const char *end = frame->isLive ? "\033[K\n" : "\n";
+    space = sizeof(frame->text) - frame->length;
+    frame->length += snprintf(frame->text + frame->length, space, "%s", end) < (int)space
+                         ? strlen(end)
+                         : 0;
+}
+
+static void printLatencies(Frame *frame, const char *name, const Latencies *latencies) {
+    static uint64_t sorted[DASHBOARD_LATENCIES];
+    uint32_t count = latencies->count;
+    if (count > DASHBOARD_LATENCIES)
+        count = DASHBOARD_LATENCIES;
+    if (count == 0) {
+        printLine(frame, "  %-6s n=0       missed %u", name, latencies->missed);
+        return;
+    }
+    memcpy(sorted, latencies->samples, count * sizeof(uint64_t));
+    qsort(sorted, count, sizeof(uint64_t), compareLatencies);
+    printLine(frame, "  %-6s n=%-7u p50 %7.1f  p90 %7.1f  p99 %7.1f  max %7.1f ms  missed %u",
+              name, latencies->count, sorted[count / 2] / 1e3, sorted[count * 9 / 10] / 1e3,
+              sorted[count * 99 / 100] / 1e3, sorted[count - 1] / 1e3, latencies->missed);
+}
+
+/*F************************************************************************************************
+ * NAME: void render(const Dashboard *d, Frame *frame, const char *source, bool hasRates)
+ *
+ * DESCRIPTION:
+ *      [1] Mode, motion and motors
+ *      [2] Battery with the trend of the last readings
+ *      [3] Distance map
+ *      [4] Link: throughput, bad lines, drops, streams
+ *      [5] Command latency and last crash
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const Dashboard*    d           State to show
+ *          const char*         source      Device or capture
+ *          bool                hasRates    False if the lines have no meaningful time
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          Frame*              frame       Text of the dashboard
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void render(const Dashboard *d, Frame *frame, const char *source, bool hasRates) {
+    frame->length = 0;
+    if (frame->isLive)
+        printLine(frame, "\033[H\033[1mmsp432car\033[0m  %s  %.1f s", source,
+                  (d->now - d->start) / 1e6);
+    else
+        printLine(frame, "msp432car  %s", source);
+
+    // [1] Mode and motors
+    printLine(frame, "MODE      %-12s MOTION  %s",
+              d->mode == DASHBOARD_UNKNOWN ? "?" : d->mode ? "autonomous" : "remote",
+              motionName(d));
+    printLine(frame, "MOTORS    left %-4s %3d%%   right %-4s %3d%%", directionName(d->direction[0]),
+              d->speed[0] == DASHBOARD_UNKNOWN ? 0 : d->speed[0], directionName(d->direction[1]),
+              d->speed[1] == DASHBOARD_UNKNOWN ? 0 : d->speed[1]);
+
+    // [2] Battery
+    if (d->readings == 0) {
+        printLine(frame, "BATTERY   ?");
+    } else {
+        static const char levels[] = " .:-=+*#%@";
+        uint32_t count = d->readings < DASHBOARD_HISTORY ? d->readings : DASHBOARD_HISTORY;
+        char trend[DASHBOARD_HISTORY + 1];
+        for (uint32_t i = 0; i < count; i++) {
+            uint16_t voltage = d->voltages[(d->readings - count + i) % DASHBOARD_HISTORY];
+            trend[i] = levels[toPercentage(voltage) * (sizeof(levels) - 2) / 100];
+        }
+        trend[count] = '\0';
+        uint16_t last = d->voltages[(d->readings - 1) % DASHBOARD_HISTORY];
+        uint16_t first = d->voltages[(d->readings - count) % DASHBOARD_HISTORY];
+        printLine(frame, "BATTERY   %5.2f V %3d%%  %+d%% over %u readings  [%s]", last / 1e3,
+                  toPercentage(last), toPercentage(last) - toPercentage(first), count, trend);
+    }
+
+    // [3] Distance map
+    char obstacle[16] = "?", servo[16] = "?";
+    if (d->obstacle != DASHBOARD_UNKNOWN)
+        snprintf(obstacle, sizeof(obstacle), "%d cm", d->obstacle);
+    if (d->servo != DASHBOARD_UNKNOWN)
+        snprintf(servo, sizeof(servo), "%d deg", d->servo);
+    printLine(frame, "OBSTACLE  %-12s SERVO   %s", obstacle, servo);
+    for (int8_t i = DASHBOARD_SECTORS - 1; i >= 0; i--) {
+        char bar[DASHBOARD_BAR_WIDTH + 1];
+        int32_t distance = d->sectors[i];
+        int32_t width = distance == DASHBOARD_UNKNOWN ? 0 : distance * DASHBOARD_BAR_WIDTH /
+                                                                DASHBOARD_MAX_RANGE;
+        if (width > DASHBOARD_BAR_WIDTH)
+            width = DASHBOARD_BAR_WIDTH;
+        memset(bar, '#', width);
+        memset(bar + width, distance == DASHBOARD_UNKNOWN ? ' ' : '.', DASHBOARD_BAR_WIDTH - width);
+        bar[DASHBOARD_BAR_WIDTH] = '\0';
+        char value[16] = "";
+        if (distance != DASHBOARD_UNKNOWN)
+            snprintf(value, sizeof(value), "%d cm", distance);
+        printLine(frame, "  %+4d %c|%s| %s", i * DASHBOARD_ANGLE_STEP - 90,
+                  d->servo != DASHBOARD_UNKNOWN &&
+                          (d->servo + 90 + DASHBOARD_ANGLE_STEP / 2) / DASHBOARD_ANGLE_STEP == i
+                      ? '>'
+                      : ' ',
+                  bar, value);
+    }
+
+    // [4] Link
+    uint32_t totalLines = 0;
+    for (uint8_t i = 0; i < NUM_STREAMS; i++)
+        totalLines += d->lines[i];
+    if (hasRates) {
+        uint64_t bytes = 0, lines = 0;
+        for (uint8_t i = 0; i < DASHBOARD_BUCKETS; i++) {
+            bytes += d->bucketBytes[i];
+            lines += d->bucketLines[i];
+        }
+        double window = DASHBOARD_BUCKETS * DASHBOARD_BUCKET / 1e6;
+        printLine(frame, "LINK      %6.0f B/s %6.1f lines/s   total %llu B %u lines",
+                  bytes / window, lines / window, (unsigned long long)d->bytes, totalLines);
+    } else {
+        printLine(frame, "LINK      total %llu B %u lines", (unsigned long long)d->bytes,
+                  totalLines);
+    }
+    char queueDrops[16] = "?";
+    if (d->queueDrops != DASHBOARD_UNKNOWN)
+        snprintf(queueDrops, sizeof(queueDrops), "%d", d->queueDrops);
+    printLine(frame, "LOSS      bad lines %u (%.2f%%)   car queue drops %s   recorder drops %u",
+              d->badLines, totalLines > 0 ? 100.0 * d->badLines / totalLines : 0, queueDrops,
+              d->recorderDrops);
+    char streams[128];
+    size_t length = 0;
+    for (uint8_t i = 0; i < NUM_STREAMS; i++)
+        length += snprintf(streams + length, sizeof(streams) - length, " %s %u", streamNames[i],
+                           d->lines[i]);
+    printLine(frame, "STREAMS  %s", streams);
+
+    // [5] Latency and crash
+    printLine(frame, "LATENCY");
+    printLatencies(frame, "host", &d->host);
+    printLatencies(frame, "car", &d->car);
+    printLine(frame, "CRASH     %s", d->crash[0] != '\0' ? d->crash : "none");
+    if (frame->isLive) {
+        char help[160];
+        length = 0;
+        for (uint8_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+            length += snprintf(help + length, sizeof(help) - length, "%c %s  ", keys[i].key,
+                               keys[i].label);
+        printLine(frame, "KEYS      %sq quit%s%s", help, d->pending[0] != '\0' ? "   sent " : "",
+                  d->pending);
+        frame->length += snprintf(frame->text + frame->length,
+                                  sizeof(frame->text) - frame->length, "\033[J");
+    }
+}
+
+static void initDashboard(Dashboard *d) {
+    memset(d, 0, sizeof(*d));
+    d->mode = DASHBOARD_UNKNOWN;
+    d->obstacle = DASHBOARD_UNKNOWN;
+    d->servo = DASHBOARD_UNKNOWN;
+    d->queueDrops = DASHBOARD_UNKNOWN;
+    for (uint8_t i = 0; i < 2; i++) {
+        d->speed[i] = DASHBOARD_UNKNOWN;
+        d->direction[i] = DASHBOARD_UNKNOWN;
+    }
+    for (uint8_t i = 0; i < DASHBOARD_SECTORS; i++)
+        d->sectors[i] = DASHBOARD_UNKNOWN;
+}
+
+static bool openDevice(const char *path, uint32_t baud, int *fd) {
+    static const struct {
+        uint32_t baud;
+        speed_t speed;
+    } speeds[] = {{9600, B9600},   {19200, B19200},   {38400, B38400},
+                  {57600, B57600}, {115200, B115200}, {230400, B230400}};
+    *fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (*fd < 0)
+        return false;
+    struct termios attributes;
+    if (tcgetattr(*fd, &attributes) != 0)
+        return true; // not a tty
+    cfmakeraw(&attributes);
+    for (uint8_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++) {
+        if (speeds[i].baud == baud) {
+            cfsetispeed(&attributes, speeds[i].speed);
+            cfsetospeed(&attributes, speeds[i].speed);
+        }
+    }
+    return tcsetattr(*fd, TCSANOW, &attributes) == 0;
+}
+
+static void sendCommand(Dashboard *d, int fd, char key, uint64_t now) {
+    for (uint8_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        if (keys[i].key != key)
+            continue;
+        char line[8];
+        int length = snprintf(line, sizeof(line), "%s\n", keys[i].command);
+        if (write(fd, line, length) != length)
+            return;
+        if (d->pending[0] != '\0')
+            d->host.missed++;
+        snprintf(d->pending, sizeof(d->pending), "%s", keys[i].command);
+        d->pendingSince = now;
+    }
+}
+
+static void writeFrame(const Frame *frame) {
+    size_t written = 0;
+    while (written < frame->length) {
+        ssize_t n = write(STDOUT_FILENO, frame->text + written, frame->length - written);
+        if (n <= 0)
+            break;
+        written += n;
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: int runLive(int fd, const char *source, FILE *capture, double replayRate)
+ *
+ * DESCRIPTION:
+ *      [1] Puts the keyboard in raw mode and clears the screen
+ *      [2] Reads the lines of the device, or of the capture at replayRate lines per second,
+ *          and the keys until q, the end of the stream or an interrupt
+ *      [3] Redraws the dashboard in place when something changed, at most every
+ *          DASHBOARD_REFRESH, and at least every second for the rates
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         fd          Device, or -1 to replay the capture
+ *          const char* source      Name shown in the title
+ *          FILE*       capture     Saves the lines of the device, or the capture to replay
+ *          double      replayRate  Lines per second of the replay
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Dashboard   dashboard   Updated
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS
+ *
+ *  NOTE:
+ */
+static int runLive(int fd, const char *source, FILE *capture, double replayRate) {
+    // [1] Terminal
+    static Frame frame = {.isLive = true};
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &stdinAttributes) == 0) {
+        struct termios raw = stdinAttributes;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        isStdinRaw = tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+        atexit(restoreStdin);
+    }
+    printf("\033[2J\033[?25l");
+    fflush(stdout);
+
+    // [2] Lines and keys
+    char line[DASHBOARD_LINE_SIZE];
+    size_t length = 0;
+    uint64_t lastDraw = 0, start = nowUs();
+    uint64_t replayed = 0;
+    bool isDirty = true, isOver = false;
+    while (!isOver && !isInterrupted) {
+        uint64_t now = nowUs();
+        struct pollfd fds[2] = {{.fd = STDIN_FILENO, .events = POLLIN},
+                                {.fd = fd, .events = POLLIN}};
+        int timeout = DASHBOARD_REFRESH / 1000;
+        if (fd < 0)
+            timeout = 1000 / replayRate < timeout ? 1000 / replayRate : timeout;
+        if (poll(fds, fd < 0 ? 1 : 2, timeout) < 0 && !isInterrupted)
+            break;
+        now = nowUs();
+
+        char key;
+        if ((fds[0].revents & POLLIN) && read(STDIN_FILENO, &key, 1) == 1) {
+            if (key == 'q')
+                isOver = true;
+            else if (fd >= 0)
+                sendCommand(&dashboard, fd, key, now);
+            isDirty = true;
+        }
+
+        if (fd >= 0 && (fds[1].revents & (POLLIN | POLLHUP))) {
+            char buffer[4096];
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n <= 0 && (fds[1].revents & POLLHUP))
+                isOver = true;
+            for (ssize_t i = 0; i < n; i++) {
+                char c = buffer[i];
+                if (c != '\n' && c != '\r' && length < sizeof(line) - 1) {
+                    line[length++] = c;
+                    continue;
+                }
+                line[length] = '\0';
+                if (length > 0 && capture != NULL)
+                    fprintf(capture, "%s\n", line);
+                feedLine(&dashboard, line, now);
+                length = 0;
+                if (c != '\n' && c != '\r')
+                    line[length++] = c;
+                isDirty = true;
+            }
+        } else if (fd < 0) {
+            while (replayed < (now - start) * replayRate / 1e6) {
+                if (fgets(line, sizeof(line), capture) == NULL) {
+                    isOver = true;
+                    break;
+                }
+                line[strcspn(line, "\r\n")] = '\0';
+                feedLine(&dashboard, line, now);
+                replayed++;
+                isDirty = true;
+            }
+        }
+
+        // a command without reaction is given up
+        if (dashboard.pending[0] != '\0' &&
+            now - dashboard.pendingSince > DASHBOARD_COMMAND_TIMEOUT) {
+            dashboard.pending[0] = '\0';
+            dashboard.host.missed++;
+            isDirty = true;
+        }
+
+        // [3] Redraw
+        if ((isDirty && now - lastDraw >= DASHBOARD_REFRESH) || now - lastDraw >= 1000000) {
+            dashboard.now = now;
+            if (dashboard.start == 0)
+                dashboard.start = now;
+            advanceBuckets(&dashboard, now);
+            render(&dashboard, &frame, source, true);
+            writeFrame(&frame);
+            lastDraw = now;
+            isDirty = false;
+        }
+    }
+    render(&dashboard, &frame, source, true);
+    writeFrame(&frame);
+    printf("\033[?25h\n");
+    return EXIT_SUCCESS;
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options
+ *      [2] Binary dump or text capture decoded at once: print the final dashboard
+ *      [3] Device or replayed capture: run the live dashboard
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options and device or capture
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS, EXIT_FAILURE on invalid arguments
+ *
+ *  NOTE:
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options
+    uint32_t baud = DASHBOARD_BAUD;
+    const char *captureName = NULL;
+    double replayRate = 0;
+    bool isBinary = false;
+    int option;
+    while ((option = getopt(argc, argv, "b:w:r:B")) != -1) {
+        switch (option) {
+        case 'b':
+            baud = strtoul(optarg, NULL, 10);
+            break;
+        case 'w':
+            captureName = optarg;
+            break;
+        case 'r':
+            replayRate = atof(optarg);
+            break;
+        case 'B':
+            isBinary = true;
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "Usage: %s [-b baud] [-w capture.txt] [-r lines] [-B] <device|capture>\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char *source = argv[optind];
+    initDashboard(&dashboard);
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    // [2] Offline
+    static Frame frame = {.isLive = false};
+    if (isBinary) {
+        static RecorderEvent events[DASHBOARD_MAX_EVENTS];
+        uint32_t count;
+        if (!SIM_REPLAY_load(source, true, events, DASHBOARD_MAX_EVENTS, &count)) {
+            fprintf(stderr, "Cannot load the dump %s\n", source);
+            return EXIT_FAILURE;
+        }
+        for (uint32_t i = 0; i < count; i++)
+            onEvent(&dashboard, &events[i]);
+        dashboard.lines[STREAM_RECORDER] = count;
+        render(&dashboard, &frame, source, false);
+        writeFrame(&frame);
+        return EXIT_SUCCESS;
+    }
+    int fd;
+    if (!openDevice(source, baud, &fd)) {
+        fprintf(stderr, "Cannot open %s\n", source);
+        return EXIT_FAILURE;
+    }
+    if (!isatty(fd)) {
+        FILE *file = fdopen(fd, "r");
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+        if (replayRate > 0)
+            return runLive(-1, source, file, replayRate);
+        char line[DASHBOARD_LINE_SIZE];
+        while (fgets(line, sizeof(line), file) != NULL) {
+            line[strcspn(line, "\r\n")] = '\0';
+            feedLine(&dashboard, line, 1);
+        }
+        fclose(file);
+        render(&dashboard, &frame, source, false);
+        writeFrame(&frame);
+        return EXIT_SUCCESS;
+    }
+
+    // [3] Live
+    FILE *capture = NULL;
+    if (captureName != NULL && (capture = fopen(captureName, "w")) == NULL) {
+        fprintf(stderr, "Cannot write %s\n", captureName);
+        return EXIT_FAILURE;
+    }
+    int result = runLive(fd, source, capture, 0);
+    if (capture != NULL)
+        fclose(capture);
+    close(fd);
+    return result;
+}
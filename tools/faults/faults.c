@@ -0,0 +1,310 @@
+/*C************************************************************************************************
+ * FILENAME:        faults.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that measures how the obstacle avoidance
+ *      degrades when the inputs of the application are lost, late, repeated or corrupted.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: faults [-n runs] [-t seconds] [-j workers] [-s seed] [-p probability]
+ *                    [-d delay] [-f profile] <map>
+ *      The same randomised courses of montecarlo are executed without faults and then once for
+ *      every fault profile. Without -f there is a profile for every applicable pair of channel
+ *      and fault (see sim_fault.h) with the probability -p (default 5%) and the maximum delay -d
+ *      (default 50 ms). With -f the only profile is read from a file, one fault per line:
+ *          <channel> <fault> <probability>
+ *          <channel> <fault> at <start s> <end s>
+ *      The profiles are printed from the most harmful, first by collisions then by speed.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../tests/sim/sim_batch.h"
+
+#define FAULTS_RUNS 200           /* Default number of courses per profile              */
+#define FAULTS_SECONDS 60         /* Default simulated time of a course                 */
+#define FAULTS_OBSTACLES 6        /* Maximum number of random boxes                     */
+#define FAULTS_PROBABILITY 0.05   /* Default probability of every fault                 */
+#define FAULTS_DELAY 50           /* Default maximum delay of a late input (ms)         */
+#define FAULTS_NOISE_MIN 0.2      /* Range of the sensor noise (cm)                     */
+#define FAULTS_NOISE_MAX 2.0
+#define FAULTS_BATTERY_MIN 0.3    /* Range of the initial battery charge                */
+#define FAULTS_BATTERY_MAX 1.0
+#define FAULTS_GAIN_SPREAD 0.08   /* Maximum mismatch of the motor efficiency           */
+#define FAULTS_MAX_PROFILES (SIM_FAULT_NUM_CHANNELS * SIM_FAULT_NUM_KINDS)
+#define FAULTS_NAME_SIZE 32
+
+/*T************************************************************************************************
+ * NAME: Profile
+ *
+ * DESCRIPTION:
+ *      Represent a set of faults and its outcome.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   char[]          name        Printed name
+ *              SimFaultConfig  config      Injected faults
+ *              SimSummary      summary     KPIs of the courses
+ */
+typedef struct {
+    char name[FAULTS_NAME_SIZE];
+    SimFaultConfig config;
+    SimSummary summary;
+} Profile;
+
+static Profile profiles[FAULTS_MAX_PROFILES];
+
+/*F************************************************************************************************
+ * NAME: bool readProfile(const char *path, SimFaultConfig *config)
+ *
+ * DESCRIPTION:
+ *      Reads a fault profile, empty lines and lines starting with '#' are ignored.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*         path        Profile file
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          SimFaultConfig*     config      Faults of the profile, the delays are not changed
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the file cannot be read or contains an invalid line
+ *
+ *  NOTE:
+ */
+static bool readProfile(const char *path, SimFaultConfig *config) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return false;
+
+    char line[256];
+    uint32_t number = 0;
+    bool isValid = true;
+    while (isValid && fgets(line, sizeof(line), file) != NULL) {
+        number++;
+        char channelName[16], kindName[16], value[16];
+        double start, end;
+        int fields = sscanf(line, "%15s %15s %15s %lf %lf", channelName, kindName, value, &start,
+                            &end);
+        if (fields <= 0 || channelName[0] == '#')
+            continue;
+
+        SimFaultChannel channel;
+        SimFaultKind kind;
+        isValid = fields >= 3 && SIM_FAULT_parseChannel(channelName, &channel) &&
+                  SIM_FAULT_parseKind(kindName, &kind) && SIM_FAULT_isApplicable(channel, kind);
+        if (isValid && strcmp(value, "at") == 0) {
+            isValid = fields == 5 && start < end && config->scripted < SIM_FAULT_MAX_SCRIPTED;
+            if (isValid) {
+                SimFaultScript *script = &config->script[config->scripted++];
+                script->channel = channel;
+                script->kind = kind;
+                script->start = start * 1e6;
+                script->end = end * 1e6;
+            }
+        } else if (isValid) {
+            config->probability[channel][kind] = atof(value);
+            isValid = fields == 3 && config->probability[channel][kind] >= 0;
+        }
+        if (!isValid)
+            fprintf(stderr, "%s:%u: invalid fault\n", path, number);
+    }
+    fclose(file);
+    return isValid;
+}
+
+static double change(double value, double reference) {
+    return reference != 0 ? (value - reference) * 100 / reference : 0;
+}
+
+static int compareProfiles(const void *a, const void *b) {
+    const SimSummary *x = &((const Profile *)a)->summary;
+    const SimSummary *y = &((const Profile *)b)->summary;
+    if (x->collisions.mean != y->collisions.mean)
+        return x->collisions.mean < y->collisions.mean ? 1 : -1;
+    if (x->speed.mean != y->speed.mean)
+        return x->speed.mean > y->speed.mean ? 1 : -1;
+    return 0;
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options, load the room and build the fault profiles
+ *      [2] Generate the randomised courses
+ *      [3] Run them without faults and with every profile
+ *      [4] Print the degradation of the KPIs
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options and map
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Profile[]   profiles    Fault profiles and their KPIs
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS, EXIT_FAILURE on invalid arguments or crashed scenarios
+ *
+ *  NOTE:
+ *      A crash caused by a fault is a bug of the application, so it makes the tool fail.
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options, room and profiles
+    uint32_t runs = FAULTS_RUNS;
+    double seconds = FAULTS_SECONDS;
+    uint16_t workers = SIM_BATCH_defaultWorkers();
+    uint64_t seed = 1;
+    double probability = FAULTS_PROBABILITY;
+    double delay = FAULTS_DELAY;
+    const char *profilePath = NULL;
+    int option;
+    while ((option = getopt(argc, argv, "n:t:j:s:p:d:f:")) != -1) {
+        switch (option) {
+        case 'n':
+            runs = strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            seconds = atof(optarg);
+            break;
+        case 'j':
+            workers = strtoul(optarg, NULL, 10);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'p':
+            probability = atof(optarg);
+            break;
+        case 'd':
+            delay = atof(optarg);
+            break;
+        case 'f':
+            profilePath = optarg;
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind != argc - 1 || runs == 0) {
+        fprintf(stderr,
+                "Usage: %s [-n runs] [-t seconds] [-j workers] [-s seed] [-p probability]\n"
+                "          [-d delay] [-f profile] <map>\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static SimWorld room;
+    if (!SIM_WORLD_load(&room, argv[optind])) {
+        fprintf(stderr, "Cannot load the map %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    uint16_t count = 0;
+    if (profilePath != NULL) {
+        Profile *profile = &profiles[count++];
+        snprintf(profile->name, sizeof(profile->name), "%s", profilePath);
+        if (!readProfile(profilePath, &profile->config))
+            return EXIT_FAILURE;
+    } else {
+        for (uint8_t c = 0; c < SIM_FAULT_NUM_CHANNELS; c++) {
+            for (uint8_t k = 0; k < SIM_FAULT_NUM_KINDS; k++) {
+                if (!SIM_FAULT_isApplicable(c, k))
+                    continue;
+                Profile *profile = &profiles[count++];
+                snprintf(profile->name, sizeof(profile->name), "%s %s", simFaultChannelNames[c],
+                         simFaultKindNames[k]);
+                profile->config.probability[c][k] = probability;
+            }
+        }
+    }
+    for (uint16_t i = 0; i < count; i++)
+        for (uint8_t c = 0; c < SIM_FAULT_NUM_CHANNELS; c++)
+            profiles[i].config.maxDelay[c] = delay * 1e3;
+
+    // [2] Randomised courses, as in montecarlo
+    SimScenario *scenarios = malloc(runs * sizeof(SimScenario));
+    SimResult *results = malloc(runs * sizeof(SimResult));
+    if (scenarios == NULL || results == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    SimRandom random;
+    SIM_RANDOM_seed(&random, seed);
+    for (uint32_t i = 0; i < runs; i++) {
+        SimScenario *scenario = &scenarios[i];
+        scenario->world = &room;
+        scenario->obstacles = SIM_RANDOM_next(&random) % (FAULTS_OBSTACLES + 1);
+        scenario->startHeading = SIM_RANDOM_uniform(&random, 0, 2 * M_PI);
+        scenario->params = SIM_CAR_defaultParams();
+        scenario->params.noiseSigma =
+            SIM_RANDOM_uniform(&random, FAULTS_NOISE_MIN, FAULTS_NOISE_MAX);
+        scenario->params.batteryLevel =
+            SIM_RANDOM_uniform(&random, FAULTS_BATTERY_MIN, FAULTS_BATTERY_MAX);
+        scenario->params.leftGain = 1 - SIM_RANDOM_uniform(&random, 0, FAULTS_GAIN_SPREAD);
+        scenario->params.rightGain = 1 - SIM_RANDOM_uniform(&random, 0, FAULTS_GAIN_SPREAD);
+        scenario->parameters = parameters;
+        scenario->seed = SIM_RANDOM_next(&random);
+        scenario->duration = seconds * 1e6;
+        scenario->faults = NULL;
+    }
+
+    // [3] Baseline and profiles on the same courses
+    SIM_BATCH_run(scenarios, runs, workers, results);
+    SimSummary baseline = SIM_BATCH_summarise(results, runs);
+    uint32_t failures = baseline.failures;
+    for (uint16_t i = 0; i < count; i++) {
+        for (uint32_t r = 0; r < runs; r++)
+            scenarios[r].faults = &profiles[i].config;
+        SIM_BATCH_run(scenarios, runs, workers, results);
+        profiles[i].summary = SIM_BATCH_summarise(results, runs);
+        failures += profiles[i].summary.failures;
+    }
+    qsort(profiles, count, sizeof(Profile), compareProfiles);
+
+    // [4] Degradation
+    printf("%u courses of %.0f s per profile, %u failed\n", runs, seconds, failures);
+    printf("%-20s %10s %10s %10s %10s %10s %8s %8s\n", "profile", "speed", "collisions",
+           "latency", "command", "faults", "speed%", "latency%");
+    printf("%-20s %10.2f %10.3f %10.2f %10.2f %10.1f\n", "none", baseline.speed.mean,
+           baseline.collisions.mean, baseline.latency.mean, baseline.command.mean,
+           baseline.faults.mean);
+    for (uint16_t i = 0; i < count; i++) {
+        const SimSummary *summary = &profiles[i].summary;
+        printf("%-20s %10.2f %10.3f %10.2f %10.2f %10.1f %+7.1f%% %+7.1f%%%s\n", profiles[i].name,
+               summary->speed.mean, summary->collisions.mean, summary->latency.mean,
+               summary->command.mean, summary->faults.mean,
+               change(summary->speed.mean, baseline.speed.mean),
+               change(summary->latency.mean, baseline.latency.mean),
+               summary->failures > 0 ? "  CRASHED" : "");
+    }
+    printf("(cm/s, per course, ms, ms, per course, change from none)\n");
+
+    free(scenarios);
+    free(results);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,310 @@
+/*C************************************************************************************************
+ * FILENAME:        montecarlo.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that benchmarks the obstacle avoidance: it
+ *      runs thousands of randomised simulated courses on all the cores of the host and aggregates
+ *      the key performance indicators of the build.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: montecarlo [-n runs] [-t seconds] [-j workers] [-s seed] [-o obstacles]
+ *                        [-l label] [-c results.csv] [-b baseline.csv] <map>
+ *      Every course randomises obstacle layout, start heading, sensor noise, battery level and
+ *      motor efficiency. The same seed always produces the same courses, so two builds can be
+ *      compared on identical conditions: the summary is appended to the -c file and compared
+ *      with the last summary of the -b file using Welch's t-test.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../tests/sim/sim_batch.h"
+
+#define MONTECARLO_RUNS 1000         /* Default number of courses                          */
+#define MONTECARLO_SECONDS 120       /* Default simulated time of a course                 */
+#define MONTECARLO_OBSTACLES 6       /* Default maximum number of random boxes             */
+#define MONTECARLO_NOISE_MIN 0.2     /* Range of the sensor noise (cm)                     */
+#define MONTECARLO_NOISE_MAX 2.0
+#define MONTECARLO_BATTERY_MIN 0.3   /* Range of the initial battery charge                */
+#define MONTECARLO_BATTERY_MAX 1.0
+#define MONTECARLO_GAIN_SPREAD 0.08  /* Maximum mismatch of the motor efficiency           */
+#define MONTECARLO_SIGNIFICANCE 1.96 /* Two-sided 95% threshold of the t statistic         */
+#define MONTECARLO_KPIS 6
+
+/*T************************************************************************************************
+ * NAME: Kpi
+ *
+ * DESCRIPTION:
+ *      Represent the description of a key performance indicator.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   const char*     name            Column name in the CSV file
+ *              const char*     unit            Unit of measure
+ *              bool            higherIsBetter  Direction of the improvement
+ */
+typedef struct {
+    const char *name;
+    const char *unit;
+    bool higherIsBetter;
+} Kpi;
+
+static const Kpi kpis[MONTECARLO_KPIS] = {
+    {"speed", "cm/s", true},     {"distance", "cm", true}, {"collisions", "", false},
+    {"sensing", "% time", false}, {"turning", "% time", false}, {"latency", "ms", false},
+};
+
+static void getMetrics(const SimSummary *summary, SimMetric metrics[MONTECARLO_KPIS]) {
+    metrics[0] = summary->speed;
+    metrics[1] = summary->distance;
+    metrics[2] = summary->collisions;
+    metrics[3] = summary->sensing;
+    metrics[4] = summary->turning;
+    metrics[5] = summary->latency;
+}
+
+/*F************************************************************************************************
+ * NAME: bool readBaseline(const char *path, char *label, SimMetric metrics[])
+ *
+ * DESCRIPTION:
+ *      Reads the last summary stored in a CSV file written by this tool.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*     path        CSV file
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          char*           label       Label of the summary, at least 64 chars
+ *          SimMetric[]     metrics     Mean, standard deviation and samples of every KPI
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the file does not contain a valid summary
+ *
+ *  NOTE:
+ */
+static bool readBaseline(const char *path, char *label, SimMetric metrics[MONTECARLO_KPIS]) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return false;
+
+    char line[1024], last[1024] = "";
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strncmp(line, "label,", 6) != 0)
+            strcpy(last, line);
+    }
+    fclose(file);
+
+    char *token = strtok(last, ",\n");
+    if (token == NULL)
+        return false;
+    snprintf(label, 64, "%s", token);
+    strtok(NULL, ","); // runs
+    strtok(NULL, ","); // failures
+    for (uint8_t i = 0; i < MONTECARLO_KPIS; i++) {
+        char *mean = strtok(NULL, ",");
+        char *stddev = strtok(NULL, ",");
+        char *count = strtok(NULL, ",\n");
+        if (count == NULL)
+            return false;
+        metrics[i].mean = atof(mean);
+        metrics[i].stddev = atof(stddev);
+        metrics[i].count = atoi(count);
+    }
+    return true;
+}
+
+static void appendResults(const char *path, const char *label, const SimSummary *summary) {
+    FILE *file = fopen(path, "a");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return;
+    }
+
+    SimMetric metrics[MONTECARLO_KPIS];
+    getMetrics(summary, metrics);
+    if (ftell(file) == 0) {
+        fprintf(file, "label,runs,failures");
+        for (uint8_t i = 0; i < MONTECARLO_KPIS; i++)
+            fprintf(file, ",%s_mean,%s_sd,%s_n", kpis[i].name, kpis[i].name, kpis[i].name);
+        fprintf(file, "\n");
+    }
+    fprintf(file, "%s,%u,%u", label, summary->runs, summary->failures);
+    for (uint8_t i = 0; i < MONTECARLO_KPIS; i++)
+        fprintf(file, ",%.6f,%.6f,%u", metrics[i].mean, metrics[i].stddev, metrics[i].count);
+    fprintf(file, "\n");
+    fclose(file);
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options and load the room
+ *      [2] Generate the randomised courses
+ *      [3] Run them in parallel
+ *      [4] Print the KPIs, store them and compare them with the baseline
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options and map
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS, EXIT_FAILURE on invalid arguments or crashed scenarios
+ *
+ *  NOTE:
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options and room
+    uint32_t runs = MONTECARLO_RUNS;
+    double seconds = MONTECARLO_SECONDS;
+    uint16_t workers = SIM_BATCH_defaultWorkers();
+    uint64_t seed = 1;
+    uint16_t obstacles = MONTECARLO_OBSTACLES;
+    const char *label = "current", *csv = NULL, *baseline = NULL;
+    int option;
+    while ((option = getopt(argc, argv, "n:t:j:s:o:l:c:b:")) != -1) {
+        switch (option) {
+        case 'n':
+            runs = strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            seconds = atof(optarg);
+            break;
+        case 'j':
+            workers = strtoul(optarg, NULL, 10);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'o':
+            obstacles = strtoul(optarg, NULL, 10);
+            break;
+        case 'l':
+            label = optarg;
+            break;
+        case 'c':
+            csv = optarg;
+            break;
+        case 'b':
+            baseline = optarg;
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind != argc - 1 || runs == 0) {
+        fprintf(stderr,
+                "Usage: %s [-n runs] [-t seconds] [-j workers] [-s seed] [-o obstacles]\n"
+                "          [-l label] [-c results.csv] [-b baseline.csv] <map>\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static SimWorld room;
+    if (!SIM_WORLD_load(&room, argv[optind])) {
+        fprintf(stderr, "Cannot load the map %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    // [2] Randomised courses
+    SimScenario *scenarios = malloc(runs * sizeof(SimScenario));
+    SimResult *results = malloc(runs * sizeof(SimResult));
+    if (scenarios == NULL || results == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    SimRandom random;
+    SIM_RANDOM_seed(&random, seed);
+    for (uint32_t i = 0; i < runs; i++) {
+        SimScenario *scenario = &scenarios[i];
+        scenario->world = &room;
+        scenario->obstacles = SIM_RANDOM_next(&random) % (obstacles + 1);
+        scenario->startHeading = SIM_RANDOM_uniform(&random, 0, 2 * M_PI);
+        scenario->params = SIM_CAR_defaultParams();
+        scenario->params.noiseSigma =
+            SIM_RANDOM_uniform(&random, MONTECARLO_NOISE_MIN, MONTECARLO_NOISE_MAX);
+        scenario->params.batteryLevel =
+            SIM_RANDOM_uniform(&random, MONTECARLO_BATTERY_MIN, MONTECARLO_BATTERY_MAX);
+        scenario->params.leftGain = 1 - SIM_RANDOM_uniform(&random, 0, MONTECARLO_GAIN_SPREAD);
+        scenario->params.rightGain = 1 - SIM_RANDOM_uniform(&random, 0, MONTECARLO_GAIN_SPREAD);
+        scenario->parameters = parameters;
+        scenario->seed = SIM_RANDOM_next(&random);
+        scenario->duration = seconds * 1e6;
+        scenario->faults = NULL;
+    }
+
+    // [3] Parallel execution
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    SIM_BATCH_run(scenarios, runs, workers, results);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double wall = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    // [4] KPIs
+    SimSummary summary = SIM_BATCH_summarise(results, runs);
+    SimMetric metrics[MONTECARLO_KPIS];
+    getMetrics(&summary, metrics);
+    printf("%s: %u courses of %.0f s on %u workers in %.2f s, %u failed\n", label, runs, seconds,
+           workers, wall, summary.failures);
+    printf("%-12s %12s %12s %12s %12s\n", "kpi", "mean", "95% ci", "stddev", "max");
+    for (uint8_t i = 0; i < MONTECARLO_KPIS; i++) {
+        double ci = metrics[i].count > 0 ? 1.96 * metrics[i].stddev / sqrt(metrics[i].count) : 0;
+        printf("%-12s %12.3f %12.3f %12.3f %12.3f %s\n", kpis[i].name, metrics[i].mean, ci,
+               metrics[i].stddev, metrics[i].max, kpis[i].unit);
+    }
+
+    char baselineLabel[64];
+    SimMetric reference[MONTECARLO_KPIS];
+    if (baseline != NULL && readBaseline(baseline, baselineLabel, reference)) {
+        printf("\ncompared with %s (Welch's t-test, 95%%)\n", baselineLabel);
+        for (uint8_t i = 0; i < MONTECARLO_KPIS; i++) {
+            double variance = 0;
+            if (metrics[i].count > 0)
+                variance += metrics[i].stddev * metrics[i].stddev / metrics[i].count;
+            if (reference[i].count > 0)
+                variance += reference[i].stddev * reference[i].stddev / reference[i].count;
+            double delta = metrics[i].mean - reference[i].mean;
+            double t = variance > 0 ? delta / sqrt(variance) : 0;
+            const char *verdict = "no significant change";
+            if (fabs(t) > MONTECARLO_SIGNIFICANCE)
+                verdict = (delta > 0) == kpis[i].higherIsBetter ? "BETTER" : "WORSE";
+            printf("%-12s %+12.3f  t=%+7.2f  %s\n", kpis[i].name, delta, t, verdict);
+        }
+    } else if (baseline != NULL) {
+        fprintf(stderr, "Cannot read the baseline %s\n", baseline);
+    }
+
+    if (csv != NULL)
+        appendResults(csv, label, &summary);
+
+    free(scenarios);
+    free(results);
+    return summary.failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,256 @@
+/*C************************************************************************************************
+ * FILENAME:        pathbench.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that benchmarks the A* path planner of the
+ *      firmware on the host: it rasterises a map into the occupancy grid, runs random queries on
+ *      it in slices like the firmware does, and prints the planning time per query and per slice.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: pathbench [-n queries] [-b budget] [-c clearance] [-o obstacles] [-u unknown%]
+ *                       [-s seed] <map>
+ *      The grid is centred on the start pose of the map, like the map built by the exploration.
+ *      The times are those of the host: the cells expanded per query and per slice carry over
+ *      to the car, the time per cell scales them to its clock.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 19 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../inc/grid.h"
+#include "../../inc/planner.h"
+#include "../../tests/sim/sim_random.h"
+#include "../../tests/sim/sim_world.h"
+
+#define PATHBENCH_QUERIES 1000      /* Default number of queries                          */
+#define PATHBENCH_BUDGET 32         /* Default cells expanded per slice, as the firmware  */
+#define PATHBENCH_CLEARANCE 2       /* Default cells kept from the obstacles              */
+#define PATHBENCH_MARGIN 30         /* Margin of the random boxes (cm)                    */
+
+static double elapsed(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * 1e6 + (end->tv_nsec - start->tv_nsec) / 1e3;
+}
+
+static int compareTimes(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/*F************************************************************************************************
+ * NAME: uint16_t rasterise(const SimWorld *room, uint8_t unknown, SimRandom *random)
+ *
+ * DESCRIPTION:
+ *      Fills the grid from the walls of the map: a cell is occupied if a wall crosses it, free
+ *      otherwise, unknown with the given probability.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const SimWorld*     room        Walls and start pose
+ *          uint8_t             unknown     Share of the cells left unknown (%)
+ *          SimRandom*          random      Generator of the unknown cells
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   uint16_t
+ *          Value:  Occupied cells
+ *
+ *  NOTE:
+ */
+static uint16_t rasterise(const SimWorld *room, uint8_t unknown, SimRandom *random) {
+    uint16_t occupied = 0;
+    double c = cos(room->start.heading);
+    double s = sin(room->start.heading);
+    GRID_clear();
+    for (int16_t cy = 0; cy < GRID_SIZE; cy++) {
+        for (int16_t cx = 0; cx < GRID_SIZE; cx++) {
+            int32_t x, y;
+            GRID_toPoint(cx, cy, &x, &y);
+            double wx = room->start.x + (x * c - y * s) / 10;
+            double wy = room->start.y + (x * s + y * c) / 10;
+            if (SIM_WORLD_clearance(room, wx, wy) < GRID_CELL / 20.0) {
+                GRID_markRay(x, y, x, y, true);
+                occupied++;
+            } else if (SIM_RANDOM_next(random) % 100 >= unknown) {
+                GRID_markRay(x, y, x, y, false);
+            }
+        }
+    }
+    return occupied;
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options, load the map and rasterise it into the grid
+ *      [2] Run the random queries slice by slice, timing every slice
+ *      [3] Print the statistics of the found and of the failed queries
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options and map
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS, EXIT_FAILURE on invalid arguments
+ *
+ *  NOTE:
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options and grid
+    uint32_t queries = PATHBENCH_QUERIES;
+    uint16_t budget = PATHBENCH_BUDGET;
+    uint8_t clearance = PATHBENCH_CLEARANCE;
+    uint16_t obstacles = 0;
+    uint8_t unknown = 0;
+    uint64_t seed = 1;
+    int option;
+    while ((option = getopt(argc, argv, "n:b:c:o:u:s:")) != -1) {
+        switch (option) {
+        case 'n':
+            queries = strtoul(optarg, NULL, 10);
+            break;
+        case 'b':
+            budget = strtoul(optarg, NULL, 10);
+            break;
+        case 'c':
+            clearance = strtoul(optarg, NULL, 10);
+            break;
+        case 'o':
+            obstacles = strtoul(optarg, NULL, 10);
+            break;
+        case 'u':
+            unknown = strtoul(optarg, NULL, 10);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind != argc - 1 || queries == 0 || budget == 0 || unknown > 100) {
+        fprintf(stderr,
+                "Usage: %s [-n queries] [-b budget] [-c clearance] [-o obstacles] [-u unknown%%]\n"
+                "          [-s seed] <map>\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static SimWorld room;
+    if (!SIM_WORLD_load(&room, argv[optind])) {
+        fprintf(stderr, "Cannot load the map %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    SimRandom random;
+    SIM_RANDOM_seed(&random, seed);
+    obstacles = SIM_WORLD_addRandomBoxes(&room, obstacles, PATHBENCH_MARGIN, &random);
+    uint16_t occupied = rasterise(&room, unknown, &random);
+    printf("grid of %ux%u cells of %u mm: %u free, %u occupied, %u random boxes\n", GRID_SIZE,
+           GRID_SIZE, GRID_CELL, GRID_countFree(), occupied, obstacles);
+
+    // [2] Queries
+    double *times = malloc(queries * sizeof(double));
+    if (times == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    uint32_t found = 0, failed = 0, slices = 0, maxSlices = 0;
+    uint64_t expanded = 0, dropped = 0, waypoints = 0;
+    uint16_t maxExpanded = 0, peak = 0;
+    double foundTime = 0, failedTime = 0, maxSlice = 0, total = 0;
+    for (uint32_t i = 0; i < queries; i++) {
+        int16_t startX, startY, goalX, goalY;
+        do {
+            startX = SIM_RANDOM_next(&random) % GRID_SIZE;
+            startY = SIM_RANDOM_next(&random) % GRID_SIZE;
+        } while (GRID_getCell(startX, startY) == GRID_OCCUPIED);
+        do {
+            goalX = SIM_RANDOM_next(&random) % GRID_SIZE;
+            goalY = SIM_RANDOM_next(&random) % GRID_SIZE;
+        } while (GRID_getCell(goalX, goalY) == GRID_OCCUPIED);
+
+        struct timespec start, end;
+        times[i] = 0;
+        uint32_t count = 0;
+        PLANNER_start(startX, startY, goalX, goalY, clearance);
+        PlannerStatus status = PLANNER_SEARCHING;
+        while (status == PLANNER_SEARCHING) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            status = PLANNER_step(budget);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double slice = elapsed(&start, &end);
+            times[i] += slice;
+            if (slice > maxSlice)
+                maxSlice = slice;
+            count++;
+        }
+        int16_t xs[UINT8_MAX], ys[UINT8_MAX];
+        waypoints += PLANNER_getWaypoints(xs, ys, UINT8_MAX);
+
+        PlannerStats stats = PLANNER_getStats();
+        expanded += stats.expanded;
+        dropped += stats.dropped;
+        if (stats.expanded > maxExpanded)
+            maxExpanded = stats.expanded;
+        if (stats.peak > peak)
+            peak = stats.peak;
+        slices += count;
+        if (count > maxSlices)
+            maxSlices = count;
+        total += times[i];
+        if (status == PLANNER_FOUND) {
+            found++;
+            foundTime += times[i];
+        } else {
+            failed++;
+            failedTime += times[i];
+        }
+    }
+
+    // [3] Statistics
+    qsort(times, queries, sizeof(double), compareTimes);
+    printf("%u queries, budget %u cells per slice, clearance %u cells\n", queries, budget,
+           clearance);
+    printf("found %u (mean %.1f us), failed %u (mean %.1f us)\n", found,
+           found > 0 ? foundTime / found : 0, failed, failed > 0 ? failedTime / failed : 0);
+    printf("query time: p50 %.1f us, p99 %.1f us, max %.1f us\n", times[queries / 2],
+           times[queries * 99 / 100], times[queries - 1]);
+    printf("slices per query: mean %.1f, max %u, worst slice %.1f us\n", (double)slices / queries,
+           maxSlices, maxSlice);
+    printf("expanded cells: mean %.1f, max %u, %.1f ns per cell\n", (double)expanded / queries,
+           maxExpanded, expanded > 0 ? total * 1e3 / expanded : 0);
+    printf("open list: peak %u of %u entries, %lu dropped, %.1f waypoints per path\n", peak,
+           PLANNER_HEAP, (unsigned long)dropped, found > 0 ? (double)waypoints / found : 0);
+
+    free(times);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,388 @@
+/*C************************************************************************************************
+ * FILENAME:        profiler.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that symbolises the samples of the profiler
+ *      received from the car against the firmware image and prints where the cycles go.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: profiler [-e build/msp432car.elf] [-n functions] [-c callers] <bt_log.txt>
+ *      The log is the text received via Bluetooth from a build made with make PROFILER=1, the
+ *      other lines are ignored. -e sets the image the car runs, -n the number of functions of the
+ *      flat profile (default 20) and -c the number of callers printed for each of them (default
+ *      3).
+ *      The flat profile counts the samples whose program counter falls in every function, split
+ *      between the main code and the interrupt service routines. The caller of a sample is the
+ *      function holding its link register: it is exact for the leaf functions, that keep the
+ *      return address in LR, and only indicative for the others, that may have reused it.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../inc/profiler.h"
+
+#define PROFILER_IMAGE "build/msp432car.elf" /* Default firmware image                       */
+#define PROFILER_FUNCTIONS 20                /* Default functions of the flat profile        */
+#define PROFILER_CALLERS 3                   /* Default callers printed for every function   */
+#define PROFILER_LINE_LENGTH 256             /* Longest line of the log                      */
+#define PROFILER_EXC_RETURN 0xF0000000       /* LR values from this one are exception returns */
+#define PROFILER_EXCEPTIONS 64               /* Entries of the vector table                  */
+
+/*T************************************************************************************************
+ * NAME: Symbol
+ *
+ * DESCRIPTION:
+ *      Represent a function of the image and its samples.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   const char*     name        Name in the symbol table
+ *              uint32_t        address     First instruction, without the Thumb bit
+ *              uint32_t        size        Bytes of code, 0 if unknown
+ *              bool            isWeak      Weak binding, the other names at the same address win
+ *              uint32_t        samples     Samples of the function
+ *              uint32_t        isrSamples  Samples taken while serving an exception
+ */
+typedef struct {
+    const char *name;
+    uint32_t address;
+    uint32_t size;
+    bool isWeak;
+    uint32_t samples;
+    uint32_t isrSamples;
+} Symbol;
+
+/*T************************************************************************************************
+ * NAME: Call
+ *
+ * DESCRIPTION:
+ *      Represent a sample reduced to its function and the function of its link register.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   int32_t     callee      Index of the symbol of the pc, -1 if unknown
+ *              int32_t     caller      Index of the symbol of the lr, -1 if unknown or interrupted
+ */
+typedef struct {
+    int32_t callee;
+    int32_t caller;
+} Call;
+
+static uint8_t *image;     /* Content of the ELF file                           */
+static size_t imageSize;   /* Bytes of the ELF file                             */
+static Symbol *symbols;    /* Functions sorted by address                       */
+static uint32_t numSymbols;
+static uint32_t vectors[PROFILER_EXCEPTIONS]; /* Handlers of the vector table, 0 if unknown */
+static uint32_t contexts[PROFILER_EXCEPTIONS]; /* Samples of every exception number         */
+
+static int compareSymbols(const void *a, const void *b) {
+    const Symbol *x = a, *y = b;
+    if (x->address != y->address)
+        return x->address < y->address ? -1 : 1;
+    return x->isWeak - y->isWeak;
+}
+
+static int compareSamples(const void *a, const void *b) {
+    const Symbol *x = *(Symbol *const *)a, *y = *(Symbol *const *)b;
+    return x->samples < y->samples ? 1 : x->samples > y->samples ? -1 : 0;
+}
+
+static int compareCalls(const void *a, const void *b) {
+    const Call *x = a, *y = b;
+    if (x->callee != y->callee)
+        return x->callee < y->callee ? -1 : 1;
+    return x->caller < y->caller ? -1 : x->caller > y->caller;
+}
+
+static bool isInImage(uint64_t offset, uint64_t size) {
+    return offset <= imageSize && size <= imageSize - offset;
+}
+
+/*F************************************************************************************************
+ * NAME: bool loadImage(const char *path)
+ *
+ * DESCRIPTION:
+ *      [1] Reads the ELF file and checks that it is a 32 bit little endian ARM image
+ *      [2] Collects the functions of its symbol table, sorted by address
+ *      [3] Reads the vector table from the section loaded at address 0
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          const char*     path        Firmware image
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          Symbol*         symbols     Functions of the image
+ *          uint32_t[]      vectors     Handlers of the exceptions
+ *      RETURN:
+ *          Type:   bool
+ *          Value:  False if the file cannot be read or is not an ARM image with symbols
+ *
+ *  NOTE:
+ */
+static bool loadImage(const char *path) {
+    // [1] File
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return false;
+    fseek(file, 0, SEEK_END);
+    imageSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    image = malloc(imageSize);
+    bool isRead = image != NULL && fread(image, 1, imageSize, file) == imageSize;
+    fclose(file);
+    const Elf32_Ehdr *header = (const Elf32_Ehdr *)image;
+    if (!isRead || imageSize < sizeof(*header) || memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 ||
+        header->e_ident[EI_CLASS] != ELFCLASS32 || header->e_ident[EI_DATA] != ELFDATA2LSB ||
+        header->e_machine != EM_ARM ||
+        !isInImage(header->e_shoff, (uint64_t)header->e_shnum * sizeof(Elf32_Shdr)))
+        return false;
+    const Elf32_Shdr *sections = (const Elf32_Shdr *)(image + header->e_shoff);
+
+    // [2] Functions
+    for (uint16_t i = 0; i < header->e_shnum; i++) {
+        const Elf32_Shdr *table = &sections[i];
+        if (table->sh_type != SHT_SYMTAB || table->sh_link >= header->e_shnum)
+            continue;
+        const Elf32_Shdr *strings = &sections[table->sh_link];
+        if (!isInImage(table->sh_offset, table->sh_size) ||
+            !isInImage(strings->sh_offset, strings->sh_size))
+            continue;
+        uint32_t count = table->sh_size / sizeof(Elf32_Sym);
+        symbols = realloc(symbols, (numSymbols + count) * sizeof(Symbol));
+        for (uint32_t j = 0; j < count; j++) {
+            const Elf32_Sym *sym = (const Elf32_Sym *)(image + table->sh_offset) + j;
+            if (ELF32_ST_TYPE(sym->st_info) != STT_FUNC || sym->st_shndx == SHN_UNDEF ||
+                sym->st_name >= strings->sh_size)
+                continue;
+            symbols[numSymbols++] = (Symbol){
+                .name = (const char *)image + strings->sh_offset + sym->st_name,
+                .address = sym->st_value & ~1u,
+                .size = sym->st_size,
+                .isWeak = ELF32_ST_BIND(sym->st_info) == STB_WEAK,
+            };
+        }
+    }
+    qsort(symbols, numSymbols, sizeof(Symbol), compareSymbols);
+
+    // [3] Vector table
+    for (uint16_t i = 0; i < header->e_shnum; i++) {
+        const Elf32_Shdr *section = &sections[i];
+        if (section->sh_type != SHT_PROGBITS || section->sh_addr != 0 ||
+            !isInImage(section->sh_offset, section->sh_size))
+            continue;
+        for (uint32_t j = 1; j < PROFILER_EXCEPTIONS && 4 * j + 4 <= section->sh_size; j++) {
+            memcpy(&vectors[j], image + section->sh_offset + 4 * j, 4);
+            vectors[j] &= ~1u;
+        }
+    }
+    return numSymbols > 0;
+}
+
+static int32_t findSymbol(uint32_t address) {
+    address &= ~1u;
+    // last symbol starting at or before the address, then the first name at that address
+    int32_t low = 0, high = (int32_t)numSymbols - 1, found = -1;
+    while (low <= high) {
+        int32_t middle = (low + high) / 2;
+        if (symbols[middle].address <= address) {
+            found = middle;
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    if (found < 0)
+        return -1;
+    while (found > 0 && symbols[found - 1].address == symbols[found].address)
+        found--;
+    const Symbol *symbol = &symbols[found];
+    if (symbol->size != 0 && address >= symbol->address + symbol->size)
+        return -1;
+    return found;
+}
+
+static const char *symbolName(int32_t index) { return index >= 0 ? symbols[index].name : "?"; }
+
+static void printContext(uint32_t exception, uint32_t samples, uint32_t total) {
+    char name[64];
+    if (exception == PROFILER_THREAD)
+        snprintf(name, sizeof(name), "main");
+    else if (vectors[exception] != 0 && findSymbol(vectors[exception]) >= 0)
+        snprintf(name, sizeof(name), "%s", symbolName(findSymbol(vectors[exception])));
+    else
+        snprintf(name, sizeof(name), "exception %u", exception);
+    printf("  %-32s %8u %6.2f%%\n", name, samples, 100.0 * samples / total);
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options and load the image
+ *      [2] Read the samples of the log and symbolise them
+ *      [3] Print the time spent in every context
+ *      [4] Print the flat profile with the callers of every function
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options and log
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS if the log contains samples, EXIT_FAILURE otherwise
+ *
+ *  NOTE:
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options and image
+    const char *path = PROFILER_IMAGE;
+    uint32_t maxFunctions = PROFILER_FUNCTIONS;
+    uint32_t maxCallers = PROFILER_CALLERS;
+    int option;
+    while ((option = getopt(argc, argv, "e:n:c:")) != -1) {
+        switch (option) {
+        case 'e':
+            path = optarg;
+            break;
+        case 'n':
+            maxFunctions = strtoul(optarg, NULL, 10);
+            break;
+        case 'c':
+            maxCallers = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "Usage: %s [-e image.elf] [-n functions] [-c callers] <bt_log.txt>\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!loadImage(path)) {
+        fprintf(stderr, "Cannot read the functions of the ARM image %s\n", path);
+        return EXIT_FAILURE;
+    }
+
+    // [2] Samples
+    FILE *log = fopen(argv[optind], "r");
+    if (log == NULL) {
+        fprintf(stderr, "Cannot read the log %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    Call *calls = NULL;
+    uint32_t total = 0, unknown = 0, capacity = 0;
+    char line[PROFILER_LINE_LENGTH];
+    while (fgets(line, sizeof(line), log) != NULL) {
+        const char *text = strchr(line, PROFILER_STREAM_PREFIX);
+        ProfilerSample sample;
+        if (text == NULL || strlen(text + 1) < PROFILER_SAMPLE_TEXT_LENGTH ||
+            !PROFILER_decode(text + 1, &sample) || sample.exception >= PROFILER_EXCEPTIONS)
+            continue;
+        if (total == capacity) {
+            capacity = capacity == 0 ? 4096 : 2 * capacity;
+            calls = realloc(calls, capacity * sizeof(Call));
+        }
+        Call *call = &calls[total++];
+        call->callee = findSymbol(sample.pc);
+        call->caller = sample.lr < PROFILER_EXC_RETURN ? findSymbol(sample.lr) : -1;
+        contexts[sample.exception]++;
+        if (call->callee < 0) {
+            unknown++;
+            continue;
+        }
+        symbols[call->callee].samples++;
+        if (sample.exception != PROFILER_THREAD)
+            symbols[call->callee].isrSamples++;
+    }
+    fclose(log);
+    if (total == 0) {
+        fprintf(stderr, "No samples in %s, was the firmware built with make PROFILER=1?\n",
+                argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    // [3] Contexts
+    printf("%u samples (%.1fs at %dHz), %u outside the functions of %s\n\n", total,
+           (double)total / PROFILER_RATE, PROFILER_RATE, unknown, path);
+    printf("  %-32s %8s %7s\n", "context", "samples", "share");
+    for (uint32_t i = 0; i < PROFILER_EXCEPTIONS; i++) {
+        if (contexts[i] > 0)
+            printContext(i, contexts[i], total);
+    }
+
+    // [4] Flat profile and callers
+    Symbol **ranking = malloc(numSymbols * sizeof(Symbol *));
+    for (uint32_t i = 0; i < numSymbols; i++)
+        ranking[i] = &symbols[i];
+    qsort(ranking, numSymbols, sizeof(Symbol *), compareSamples);
+    qsort(calls, total, sizeof(Call), compareCalls);
+
+    printf("\n  %-32s %8s %7s %7s %8s\n", "function", "samples", "self", "cumul", "in isr");
+    double cumulative = 0;
+    for (uint32_t i = 0; i < maxFunctions && i < numSymbols && ranking[i]->samples > 0; i++) {
+        const Symbol *symbol = ranking[i];
+        double share = 100.0 * symbol->samples / total;
+        cumulative += share;
+        printf("  %-32s %8u %6.2f%% %6.2f%% %7.1f%%\n", symbol->name, symbol->samples, share,
+               cumulative, 100.0 * symbol->isrSamples / symbol->samples);
+
+        // the calls of the function are contiguous, sorted by caller: pick the largest runs
+        int32_t index = symbol - symbols;
+        uint32_t first = 0;
+        while (first < total && calls[first].callee < index)
+            first++;
+        for (uint32_t printed = 0; printed < maxCallers; printed++) {
+            uint32_t bestCount = 0, bestStart = 0;
+            for (uint32_t j = first; j < total && calls[j].callee == index;) {
+                uint32_t k = j;
+                while (k < total && calls[k].callee == index && calls[k].caller == calls[j].caller)
+                    k++;
+                if (k - j > bestCount && calls[j].caller != INT32_MIN) {
+                    bestCount = k - j;
+                    bestStart = j;
+                }
+                j = k;
+            }
+            if (bestCount == 0)
+                break;
+            int32_t caller = calls[bestStart].caller;
+            printf("      <- %-27s %8u %6.2f%%\n", caller >= 0 ? symbolName(caller) : "(none)",
+                   bestCount, 100.0 * bestCount / symbol->samples);
+            for (uint32_t j = bestStart; j < bestStart + bestCount; j++)
+                calls[j].caller = INT32_MIN; // printed
+        }
+    }
+
+    free(ranking);
+    free(calls);
+    free(symbols);
+    free(image);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+/*C************************************************************************************************
+ * FILENAME:        reaction.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that benchmarks the reaction of the car to an
+ *      obstacle, from its appearance inside the free threshold to the stop of the motors, for a
+ *      range of probe periods, speeds and servo positions, with the distribution of every stage.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: reaction [-n trials] [-p periods] [-v speeds] [-a positions] [-d distance]
+ *                      [-s seed] [-c trials.csv]
+ *      -p is a comma separated list of probe periods in ms (default 100,333), -v of forward
+ *      speeds in % (default 30,50,80), -a of servo positions in deg (default 0,45,90). The same
+ *      seed always produces the same appearance times, so the output of two builds can be
+ *      compared; -c writes every trial for a finer analysis.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../tests/sim/sim_clock.h"
+#include "../../tests/sim/sim_reaction.h"
+
+#define REACTION_TRIALS 100     /* Default number of trials of every configuration       */
+#define REACTION_MAX_VALUES 16  /* Maximum number of values of a swept variable          */
+
+static const char *stageNames[SIM_REACTION_NUM_STAGES] = {"probe", "servo", "echo", "decision",
+                                                          "total"};
+
+static uint8_t parseList(const char *text, double values[REACTION_MAX_VALUES]) {
+    char copy[256];
+    snprintf(copy, sizeof(copy), "%s", text);
+    uint8_t count = 0;
+    for (char *token = strtok(copy, ","); token != NULL && count < REACTION_MAX_VALUES;
+         token = strtok(NULL, ","))
+        values[count++] = atof(token);
+    return count;
+}
+
+static int compare(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const uint64_t *sorted, uint32_t count, double p) {
+    uint32_t rank = ceil(p * count);
+    return sorted[rank > 0 ? rank - 1 : 0] / 1e3;
+}
+
+/*F************************************************************************************************
+ * NAME: void printStages(uint64_t *samples[], uint32_t count)
+ *
+ * DESCRIPTION:
+ *      Prints mean, median, 95th and 99th percentile and maximum of every stage.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          uint64_t*[] samples     Durations of every stage (µs), sorted in place
+ *          uint32_t    count       Number of durations of every stage
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ */
+static void printStages(uint64_t *samples[SIM_REACTION_NUM_STAGES], uint32_t count) {
+    printf("    %-9s %9s %9s %9s %9s %9s\n", "stage", "mean", "p50", "p95", "p99", "max");
+    for (uint8_t s = 0; s < SIM_REACTION_NUM_STAGES; s++) {
+        qsort(samples[s], count, sizeof(uint64_t), compare);
+        double sum = 0;
+        for (uint32_t i = 0; i < count; i++)
+            sum += samples[s][i];
+        printf("    %-9s %7.2fms %7.2fms %7.2fms %7.2fms %7.2fms\n", stageNames[s],
+               sum / count / 1e3, percentile(samples[s], count, 0.5),
+               percentile(samples[s], count, 0.95), percentile(samples[s], count, 0.99),
+               samples[s][count - 1] / 1e3);
+    }
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options
+ *      [2] Run the trials of every combination of probe period, speed and servo position
+ *      [3] Print the outcome and the distribution of the stages of every combination
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS, EXIT_FAILURE on invalid arguments
+ *
+ *  NOTE:
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options
+    SimReactionSetup setup = SIM_REACTION_defaultSetup();
+    uint32_t trials = REACTION_TRIALS;
+    double periods[REACTION_MAX_VALUES], speeds[REACTION_MAX_VALUES];
+    double positions[REACTION_MAX_VALUES];
+    uint8_t periodCount = parseList("100,333", periods);
+    uint8_t speedCount = parseList("30,50,80", speeds);
+    uint8_t positionCount = parseList("0,45,90", positions);
+    uint64_t seed = 1;
+    FILE *csv = NULL;
+    int option;
+    while ((option = getopt(argc, argv, "n:p:v:a:d:s:c:")) != -1) {
+        switch (option) {
+        case 'n':
+            trials = strtoul(optarg, NULL, 10);
+            break;
+        case 'p':
+            periodCount = parseList(optarg, periods);
+            break;
+        case 'v':
+            speedCount = parseList(optarg, speeds);
+            break;
+        case 'a':
+            positionCount = parseList(optarg, positions);
+            break;
+        case 'd':
+            setup.distance = atof(optarg);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'c':
+            if ((csv = fopen(optarg, "w")) == NULL) {
+                fprintf(stderr, "Cannot open %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind != argc || trials == 0 || periodCount == 0 || speedCount == 0 ||
+        positionCount == 0) {
+        fprintf(stderr,
+                "Usage: %s [-n trials] [-p periods] [-v speeds] [-a positions] [-d distance] "
+                "[-s seed] [-c trials.csv]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (csv != NULL)
+        fprintf(csv, "period_ms,speed,servo_deg,trial,stopped,probe_us,servo_us,echo_us,"
+                     "decision_us,total_us,probes,clearance_cm,collisions\n");
+
+    uint64_t *samples[SIM_REACTION_NUM_STAGES];
+    for (uint8_t s = 0; s < SIM_REACTION_NUM_STAGES; s++)
+        samples[s] = malloc(trials * sizeof(uint64_t));
+
+    // [2] and [3] Combinations
+    for (uint8_t p = 0; p < periodCount; p++)
+        for (uint8_t v = 0; v < speedCount; v++)
+            for (uint8_t a = 0; a < positionCount; a++) {
+                setup.parameters.sensingTimerCount = SIM_CLOCK_US_TO_TICKS(periods[p] * 1e3);
+                setup.parameters.forwardSpeed = speeds[v];
+                setup.servoPosition = positions[a];
+                uint32_t stopped = 0, collisions = 0;
+                double minClearance = INFINITY, clearance = 0;
+                for (uint32_t i = 0; i < trials; i++) {
+                    SimReaction reaction;
+                    setup.seed = seed + i;
+                    SIM_REACTION_run(&setup, &reaction);
+                    collisions += reaction.collisions;
+                    if (csv != NULL) {
+                        fprintf(csv, "%g,%g,%g,%u,%d", periods[p], speeds[v], positions[a], i,
+                                reaction.isStopped);
+                        for (uint8_t s = 0; s < SIM_REACTION_NUM_STAGES; s++)
+                            fprintf(csv, ",%llu", (unsigned long long)reaction.stages[s]);
+                        fprintf(csv, ",%u,%.2f,%u\n", reaction.probes, reaction.clearance,
+                                reaction.collisions);
+                    }
+                    if (!reaction.isStopped)
+                        continue;
+                    for (uint8_t s = 0; s < SIM_REACTION_NUM_STAGES; s++)
+                        samples[s][stopped] = reaction.stages[s];
+                    stopped++;
+                    clearance += reaction.clearance;
+                    if (reaction.clearance < minClearance)
+                        minClearance = reaction.clearance;
+                }
+
+                printf("probe %gms, speed %g%%, servo %gdeg: %u/%u stopped, %u collisions",
+                       periods[p], speeds[v], positions[a], stopped, trials, collisions);
+                if (stopped == 0) {
+                    printf("\n");
+                    continue;
+                }
+                printf(", clearance %.1fcm (min %.1fcm)\n", clearance / stopped, minClearance);
+                printStages(samples, stopped);
+            }
+
+    for (uint8_t s = 0; s < SIM_REACTION_NUM_STAGES; s++)
+        free(samples[s]);
+    if (csv != NULL)
+        fclose(csv);
+    return EXIT_SUCCESS;
+}
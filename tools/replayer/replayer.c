@@ -0,0 +1,156 @@
+/*C************************************************************************************************
+ * FILENAME:        replayer.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that replays a recording of the HAL events
+ *      made on the car and reports where the host build behaves differently.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: replayer [-b] [-t ticks] [-c events] [-o replayed.txt] <recording>
+ *      -b reads a binary dump of the flash log instead of the text received via Bluetooth, -t sets
+ *      the accepted time difference of every event (default 10 ticks, about 0.1ms), -c the number
+ *      of events printed around the first difference and -o writes the replayed stream, that can
+ *      be replayed in turn.
+ *      The recording is truncated at the first overflow, the events after it cannot be replayed.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Name of the stall channel
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../../tests/sim/sim_clock.h"
+#include "../../tests/sim/sim_replay.h"
+
+#define REPLAYER_MAX_EVENTS 1000000 /* Capacity of the recording and of the replay          */
+#define REPLAYER_TOLERANCE 10       /* Default accepted time difference (ticks)             */
+#define REPLAYER_CONTEXT 5          /* Default events printed around the first difference   */
+#define REPLAYER_COLUMN_WIDTH 36    /* Width of the columns of the printed events           */
+
+static const char *channelNames[RECORDER_NUM_CHANNELS] = {
+    "periodic", "shared", "echo",  "ir",        "bt-rx",    "battery",
+    "speed",    "dir",    "servo", "telemetry", "overflow", "stall",
+};
+
+static RecorderEvent recording[REPLAYER_MAX_EVENTS];
+static RecorderEvent replayed[REPLAYER_MAX_EVENTS];
+
+static void printEvent(const RecorderEvent *events, uint32_t count, uint32_t index) {
+    char text[REPLAYER_COLUMN_WIDTH] = "-";
+    if (index < count) {
+        const RecorderEvent *event = &events[index];
+        snprintf(text, sizeof(text), "%10.3fms %-10s 0x%04X",
+                 SIM_CLOCK_TICKS_TO_US(event->tick) / 1e3, channelNames[event->channel],
+                 event->value);
+    }
+    printf("%-*s", REPLAYER_COLUMN_WIDTH, text);
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options and load the recording
+ *      [2] Replay the recorded inputs
+ *      [3] Compare the streams and print the first difference
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options and recording
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS if the replay matches, EXIT_FAILURE otherwise
+ *
+ *  NOTE:
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options and recording
+    bool isBinary = false;
+    uint32_t tolerance = REPLAYER_TOLERANCE;
+    uint32_t context = REPLAYER_CONTEXT;
+    const char *output = NULL;
+    int option;
+    while ((option = getopt(argc, argv, "bt:c:o:")) != -1) {
+        switch (option) {
+        case 'b':
+            isBinary = true;
+            break;
+        case 't':
+            tolerance = strtoul(optarg, NULL, 10);
+            break;
+        case 'c':
+            context = strtoul(optarg, NULL, 10);
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "Usage: %s [-b] [-t ticks] [-c events] [-o replayed.txt] <recording>\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t count;
+    if (!SIM_REPLAY_load(argv[optind], isBinary, recording, REPLAYER_MAX_EVENTS, &count)) {
+        fprintf(stderr, "Cannot load the recording %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (recording[i].channel == RECORDER_CHANNEL_OVERFLOW) {
+            printf("%u events lost after event %u, the rest of the recording is ignored\n",
+                   recording[i].value, i);
+            count = i;
+            break;
+        }
+    }
+
+    // [2] Replay
+    uint32_t length = SIM_REPLAY_run(recording, count, replayed, REPLAYER_MAX_EVENTS);
+    if (output != NULL && !SIM_REPLAY_save(output, replayed, length)) {
+        fprintf(stderr, "Cannot write %s\n", output);
+        return EXIT_FAILURE;
+    }
+
+    // [3] Comparison
+    SimReplayDiff diff = SIM_REPLAY_compare(recording, count, replayed, length, tolerance);
+    printf("Recorded %u events, replayed %u, max drift %.3fms\n", count, length,
+           SIM_CLOCK_TICKS_TO_US(diff.maxDrift) / 1e3);
+    if (diff.isEqual) {
+        printf("Replay matches the recording\n");
+        return EXIT_SUCCESS;
+    }
+
+    printf("First difference at event %u\n\n", diff.matched);
+    printf("%8s  %-*s%-*s\n", "event", REPLAYER_COLUMN_WIDTH, "recorded", REPLAYER_COLUMN_WIDTH,
+           "replayed");
+    uint32_t first = diff.matched > context ? diff.matched - context : 0;
+    for (uint32_t i = first; i <= diff.matched + context && (i < count || i < length); i++) {
+        printf("%c%7u  ", i == diff.matched ? '>' : ' ', i);
+        printEvent(recording, count, i);
+        printEvent(replayed, length, i);
+        printf("\n");
+    }
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,281 @@
+/*C************************************************************************************************
+ * FILENAME:        simulator.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that runs the application in autonomous
+ *      mode inside a simulated world and prints the collected metrics.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: simulator [-p] [-x] [-b baud] [-m interval] [-e events] <map> [seconds] [seed]
+ *                       [trace.csv]
+ *      The optional trace contains the pose of the car every 100ms of simulated time.
+ *      With -e the execution trace (see trace.h) is written to the events file in the format of
+ *      the Bluetooth dump, ready for tools/tracer.
+ *      With -p the Bluetooth UART of the car is exposed as a pseudo-terminal (see sim_uart.h) and
+ *      the simulation runs in real time; the car waits in remote mode for the commands of the
+ *      host tools and 0 seconds means until interrupted. With -m the HC-08 emulator (see
+ *      sim_hc08.h) sits between the UART and the pseudo-terminal, with the given connection
+ *      interval in ms.
+ *      With -x the car explores the map (see exploration_module.h) instead of the autonomous
+ *      mode, the simulation ends with the exploration and the coverage of the map is printed
+ *      with the coverage per percent of battery consumed.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Added decision latency
+ * 18 Oct 2026  Maintainers     Added the real time mode with the Bluetooth pseudo-terminal
+ * 18 Oct 2026  Maintainers     Added the HC-08 emulator
+ * 18 Oct 2026  Maintainers     Added the execution trace
+ * 18 Oct 2026  Maintainers     Added the motor stalls
+ * 18 Oct 2026  Maintainers     Added the exploration and the battery consumed
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../inc/exploration_module.h"
+#include "../../inc/grid.h"
+#include "../../inc/state_machine.h"
+#include "../../inc/trace.h"
+#include "../../tests/bluetooth_hal.h"
+#include "../../tests/infrared_hal.h"
+#include "../../tests/sim/sim_car.h"
+#include "../../tests/sim/sim_hc08.h"
+#include "../../tests/sim/sim_uart.h"
+
+#define SIMULATOR_DEFAULT_SECONDS 60 /* Default simulated time in autonomous mode         */
+#define SIMULATOR_TRACE_PERIOD 100000 /* Period of the pose trace (µs)                     */
+#define SIMULATOR_REAL_TIME_STEP 1000 /* Simulated time between two polls of the terminal (µs) */
+#define SIMULATOR_EVENTS_PERIOD 10000 /* Simulated time between two dumps of the trace (µs) */
+#define SIMULATOR_PTY_NAME_SIZE 64
+
+static const char *stateNames[NUM_STATES] = {"INIT",    "RUNNING", "SENSING",
+                                             "TURNING", "REMOTE",  "RECOVERING"};
+
+static double wallSeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static bool dumpEvents(FILE *file) {
+    const TraceEvent *events;
+    uint16_t count = TRACE_getEvents(&events);
+    char line[TRACE_EVENT_TEXT_LENGTH + 1];
+    line[TRACE_EVENT_TEXT_LENGTH] = '\0';
+    for (uint16_t i = 0; i < count; i++) {
+        TRACE_encode(&events[i], line);
+        fprintf(file, "%c%s\n", TRACE_STREAM_PREFIX, line);
+    }
+    TRACE_start();
+    return count < TRACE_BUFFER_SIZE;
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Load the map and prepare the simulation
+ *      [2] Switch to autonomous mode, start the exploration, or open the pseudo-terminal and
+ *          wait for the commands
+ *      [3] Simulate, tracing the pose and dumping the execution trace if requested and keeping
+ *          pace with the wall clock with -p, until the end of the exploration with -x
+ *      [4] Print the metrics and the speed with respect to real time
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options, map, simulated seconds, seed and trace file
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS, EXIT_FAILURE on invalid arguments
+ *
+ *  NOTE:
+ */
+int main(int argc, char *argv[]) {
+    bool isRealTime = false;
+    bool isExploring = false;
+    uint32_t baud = SIM_UART_BAUD;
+    SimHc08Config hc08 = SIM_HC08_defaultConfig();
+    bool hasHc08 = false;
+    const char *eventsName = NULL;
+    int option;
+    while ((option = getopt(argc, argv, "pxb:m:e:")) != -1) {
+        switch (option) {
+        case 'p':
+            isRealTime = true;
+            break;
+        case 'x':
+            isExploring = true;
+            break;
+        case 'b':
+            baud = strtoul(optarg, NULL, 10);
+            break;
+        case 'm':
+            hc08.interval = lround(atof(optarg) * 1000 / SIM_HC08_UNIT);
+            hasHc08 = hc08.interval > 0;
+            break;
+        case 'e':
+            eventsName = optarg;
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind >= argc || argc - optind > 4) {
+        fprintf(stderr,
+                "Usage: %s [-p] [-x] [-b baud] [-m interval] [-e events] <map> [seconds] [seed] "
+                "[trace.csv]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    argv += optind - 1;
+    argc -= optind - 1;
+
+    // [1] Load the map and prepare the simulation
+    static SimWorld world;
+    if (!SIM_WORLD_load(&world, argv[1])) {
+        fprintf(stderr, "Cannot load the map %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    double seconds = argc > 2 ? atof(argv[2]) : SIMULATOR_DEFAULT_SECONDS;
+    uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : 1;
+    FILE *trace = NULL;
+    if (argc > 4 && (trace = fopen(argv[4], "w")) == NULL) {
+        fprintf(stderr, "Cannot open the trace %s\n", argv[4]);
+        return EXIT_FAILURE;
+    }
+    FILE *events = NULL;
+    if (eventsName != NULL && (events = fopen(eventsName, "w")) == NULL) {
+        fprintf(stderr, "Cannot open the events %s\n", eventsName);
+        return EXIT_FAILURE;
+    }
+
+    SimCarParams params = SIM_CAR_defaultParams();
+    SIM_CAR_init(&world, &params, seed);
+    if (events != NULL) {
+        fprintf(events, "%c%s%lu\n", TRACE_STREAM_PREFIX, TRACE_CLOCK_TAG,
+                (unsigned long)TRACE_getClockRate());
+        TRACE_start();
+        TRACE_INSTANT(TRACE_ID_STATE, FSM_currentState);
+    }
+
+    // [2] Autonomous mode or remote commands
+    double start = wallSeconds();
+    uint64_t duration = seconds * 1e6;
+    if (isRealTime) {
+        char name[SIMULATOR_PTY_NAME_SIZE];
+        if (!SIM_UART_open(baud, name, sizeof(name))) {
+            fprintf(stderr, "Cannot create the pseudo-terminal\n");
+            return EXIT_FAILURE;
+        }
+        if (hasHc08)
+            SIM_HC08_init(&hc08);
+        printf("Bluetooth %s on %s at %u baud\n", hasHc08 ? "HC-08" : "UART", name, baud);
+        fflush(stdout);
+        if (duration == 0)
+            duration = UINT64_MAX;
+    } else if (isExploring) {
+        BT_HAL_triggerMessageReceived("EXP");
+    } else {
+        IR_HAL_triggerCommandReceived(IR_COMMAND_ASTERISK);
+    }
+
+    // [3] Simulation
+    uint64_t step = duration;
+    uint32_t truncated = 0;
+    if (isRealTime)
+        step = SIMULATOR_REAL_TIME_STEP;
+    else if (events != NULL)
+        step = SIMULATOR_EVENTS_PERIOD;
+    else if (trace != NULL || isExploring)
+        step = SIMULATOR_TRACE_PERIOD;
+    if (trace != NULL)
+        fprintf(trace, "time_us,x_cm,y_cm,heading_rad,state\n");
+    for (uint64_t t = 0; t < duration; t += step) {
+        if (trace != NULL && t % SIMULATOR_TRACE_PERIOD == 0) {
+            SimPose pose = SIM_CAR_getPose();
+            fprintf(trace, "%llu,%.2f,%.2f,%.4f,%s\n", (unsigned long long)t, pose.x, pose.y,
+                    pose.heading, stateNames[FSM_currentState]);
+        }
+        SIM_CAR_run(step);
+        if (events != NULL && !dumpEvents(events))
+            truncated++;
+        if (isRealTime) {
+            double ahead = (t + step) / 1e6 - (wallSeconds() - start);
+            SIM_UART_poll(ahead > 0 ? ahead * 1e6 : 0);
+        }
+        if (isExploring && !Exploration_Module_isRunning())
+            break;
+    }
+    if (trace != NULL)
+        fclose(trace);
+    if (events != NULL)
+        fclose(events);
+    double wall = wallSeconds() - start;
+
+    // [4] Print the metrics
+    SimStats stats = SIM_CAR_getStats();
+    double simulated = stats.elapsed / 1e6;
+    printf("simulated time   %10.2f s\n", simulated);
+    printf("wall time        %10.4f s (%.0fx real time)\n", wall,
+           wall > 0 ? simulated / wall : 0);
+    printf("distance         %10.1f cm\n", stats.distance);
+    printf("mean speed       %10.2f cm/s\n", simulated > 0 ? stats.distance / simulated : 0);
+    printf("collisions       %10u\n", stats.collisions);
+    printf("pings            %10u\n", stats.pings);
+    printf("messages         %10u\n", stats.messages);
+    printf("decisions        %10u\n", stats.decisions);
+    if (stats.decisions > 0)
+        printf("decision latency %10.1f ms (max %.1f ms)\n",
+               stats.decisionTime / 1e3 / stats.decisions, stats.maxDecisionLatency / 1e3);
+    printf("battery used     %10.3f %%\n", stats.charge * 100);
+    if (isExploring) {
+        uint8_t coverage = GRID_getCoverage();
+        printf("coverage         %10u %% (%u free cells)\n", coverage, GRID_countFree());
+        if (stats.charge > 0)
+            printf("coverage/battery %10.1f\n", coverage / (stats.charge * 100));
+    }
+    printf("stalls           %10u\n", stats.stalls);
+    if (stats.stalls > 0)
+        printf("stall latency    %10.1f ms (max)\n", stats.maxStallLatency / 1e3);
+    for (uint8_t i = 0; i < NUM_STATES; i++)
+        printf("time %-11s %10.2f s\n", stateNames[i], stats.timeInState[i] / 1e6);
+    if (truncated > 0)
+        printf("trace truncated  %10u times, the buffer filled up\n", truncated);
+    if (isRealTime) {
+        SimUartStats uart = SIM_UART_getStats();
+        printf("uart tx/rx       %10u / %u bytes, %u messages received\n", uart.txBytes,
+               uart.rxBytes, uart.rxMessages);
+        printf("uart lost        %10u messages, %u bytes\n", uart.droppedMessages,
+               uart.droppedBytes);
+        if (hasHc08) {
+            SimHc08Stats link = SIM_HC08_getStats();
+            printf("hc-08 up/down    %10u / %u bytes in %u / %u packets\n", link.uplinkBytes,
+                   link.downlinkBytes, link.notifications, link.writes);
+            if (link.uplinkBytes > 0)
+                printf("hc-08 wait       %10.2f ms (max %.2f ms)\n",
+                       link.uplinkLatency / 1e3 / link.uplinkBytes, link.maxUplinkLatency / 1e3);
+            printf("hc-08 lost       %10u bytes\n", link.droppedBytes);
+        }
+        SIM_UART_close();
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,301 @@
+/*C************************************************************************************************
+ * FILENAME:        tracer.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that converts the dumps of the execution
+ *      trace, received via Bluetooth or written by the simulator, into the Chrome trace event
+ *      format, viewable in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: tracer [-o trace.json] <dump>
+ *      The lines without TRACE_STREAM_PREFIX are ignored, so the whole Bluetooth log can be
+ *      given. Every capture becomes a process with two threads: the state of the application, as
+ *      consecutive slices, and the callbacks with the outputs they produce. The slices still open
+ *      at the end of a capture are closed at its last event, the ends of the slices begun before
+ *      its start are dropped.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ * 18 Oct 2026  Maintainers     Added the recovering state
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../../inc/state_machine.h"
+#include "../../inc/trace.h"
+
+#define TRACER_LINE_SIZE 256
+#define TRACER_MAX_DEPTH 64    /* Nesting of the callback slices kept track of             */
+#define TRACER_STATE_TID 1     /* Thread of the state slices                               */
+#define TRACER_CALLBACK_TID 2  /* Thread of the callback slices and of the instants        */
+
+static const char *idNames[TRACE_NUM_IDS] = {
+    "state",     "periodic timer", "shared timer",    "echo",  "ir frame", "bt rx",
+    "telemetry", "motor speed",    "motor direction", "servo", "battery",
+};
+
+static const char *stateNames[NUM_STATES] = {"INIT",    "RUNNING", "SENSING",
+                                             "TURNING", "REMOTE",  "RECOVERING"};
+
+/*T************************************************************************************************
+ * NAME: Capture
+ *
+ * DESCRIPTION:
+ *      Represent the conversion of a capture, from its CLOCK line to the next one.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t    pid         Process of the capture in the output
+ *              uint32_t    rate        Timestamps per second
+ *              uint64_t    first       Unwrapped timestamp of the first event
+ *              uint64_t    last        Unwrapped timestamp of the last event
+ *              uint32_t    events      Converted events
+ *              int32_t     state       State slice being open, -1 if none
+ *              uint8_t[]   stack       Ids of the open callback slices
+ *              uint8_t     depth       Number of open callback slices
+ */
+typedef struct {
+    uint32_t pid;
+    uint32_t rate;
+    uint64_t first;
+    uint64_t last;
+    uint32_t events;
+    int32_t state;
+    uint8_t stack[TRACER_MAX_DEPTH];
+    uint8_t depth;
+} Capture;
+
+static FILE *output;
+static bool isFirstRecord = true;
+
+static void beginRecord() {
+    fputs(isFirstRecord ? "\n" : ",\n", output);
+    isFirstRecord = false;
+}
+
+static double toUs(const Capture *capture, uint64_t time) {
+    return (double)(time - capture->first) * 1e6 / capture->rate;
+}
+
+static void printMetadata(const Capture *capture) {
+    beginRecord();
+    fprintf(output,
+            "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%u,\"args\":{\"name\":"
+            "\"capture %u (%u Hz)\"}}",
+            capture->pid, capture->pid, capture->rate);
+    beginRecord();
+    fprintf(output,
+            "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":"
+            "\"state\"}}",
+            capture->pid, TRACER_STATE_TID);
+    beginRecord();
+    fprintf(output,
+            "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":"
+            "\"callbacks\"}}",
+            capture->pid, TRACER_CALLBACK_TID);
+}
+
+static void printArgs(const TraceEvent *event) {
+    const char *side = event->arg >> 8 ? "right" : "left";
+    switch (event->id) {
+    case TRACE_ID_US_ECHO:
+        fprintf(output, "{\"distance_cm\":%u}", event->arg);
+        break;
+    case TRACE_ID_IR_FRAME:
+        fprintf(output, "{\"command\":%u}", event->arg);
+        break;
+    case TRACE_ID_BT_RX:
+        fprintf(output, "{\"first_char\":%u}", event->arg);
+        break;
+    case TRACE_ID_TELEMETRY:
+        fprintf(output, "{\"type\":%u}", event->arg);
+        break;
+    case TRACE_ID_MOTOR_SPEED:
+        fprintf(output, "{\"speed\":%u,\"side\":\"%s\"}", event->arg & 0xFF, side);
+        break;
+    case TRACE_ID_MOTOR_DIRECTION:
+        fprintf(output, "{\"direction\":%u,\"side\":\"%s\"}", event->arg & 0xFF, side);
+        break;
+    case TRACE_ID_SERVO:
+        fprintf(output, "{\"position\":%d}", (int8_t)event->arg);
+        break;
+    case TRACE_ID_BATTERY:
+        fprintf(output, "{\"voltage_mv\":%u}", event->arg);
+        break;
+    default:
+        fprintf(output, "{}");
+    }
+}
+
+static void printSlice(const Capture *capture, char phase, uint32_t tid, const char *name,
+                       uint64_t time) {
+    beginRecord();
+    fprintf(output, "{\"ph\":\"%c\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f", phase, capture->pid, tid,
+            toUs(capture, time));
+    if (name != NULL)
+        fprintf(output, ",\"name\":\"%s\"", name);
+    fputc('}', output);
+}
+
+static void closeCapture(Capture *capture) {
+    if (capture->pid == 0)
+        return;
+    while (capture->depth > 0) {
+        capture->depth--;
+        printSlice(capture, 'E', TRACER_CALLBACK_TID, NULL, capture->last);
+    }
+    if (capture->state >= 0)
+        printSlice(capture, 'E', TRACER_STATE_TID, NULL, capture->last);
+    capture->state = -1;
+}
+
+static void convertEvent(Capture *capture, const TraceEvent *event, uint64_t time) {
+    // the state thread holds a slice per state, each one ends when the next begins
+    if (event->id == TRACE_ID_STATE) {
+        if (capture->state >= 0)
+            printSlice(capture, 'E', TRACER_STATE_TID, NULL, time);
+        capture->state = event->arg;
+        printSlice(capture, 'B', TRACER_STATE_TID,
+                   event->arg < NUM_STATES ? stateNames[event->arg] : "unknown", time);
+        return;
+    }
+
+    switch (event->phase) {
+    case TRACE_PHASE_BEGIN:
+        if (capture->depth == TRACER_MAX_DEPTH)
+            return;
+        capture->stack[capture->depth++] = event->id;
+        break;
+    case TRACE_PHASE_END:
+        if (capture->depth == 0 || capture->stack[capture->depth - 1] != event->id)
+            return; // begun before the capture
+        capture->depth--;
+        printSlice(capture, 'E', TRACER_CALLBACK_TID, NULL, time);
+        return;
+    default:
+        break;
+    }
+
+    beginRecord();
+    fprintf(output, "{\"ph\":\"%c\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"name\":\"%s\",",
+            event->phase, capture->pid, TRACER_CALLBACK_TID, toUs(capture, time),
+            idNames[event->id]);
+    if (event->phase == TRACE_PHASE_INSTANT)
+        fprintf(output, "\"s\":\"t\",");
+    fprintf(output, "\"args\":");
+    printArgs(event);
+    fputc('}', output);
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options and open the files
+ *      [2] Convert the events of every capture, unwrapping the 32 bit timestamps
+ *      [3] Close the JSON document and print a summary
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options and dump
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS, EXIT_FAILURE on invalid arguments or if there is no capture
+ *
+ *  NOTE:
+ *      The events before the first CLOCK line cannot be timed and are ignored.
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options and files
+    const char *outputName = NULL;
+    int option;
+    while ((option = getopt(argc, argv, "o:")) != -1) {
+        switch (option) {
+        case 'o':
+            outputName = optarg;
+            break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "Usage: %s [-o trace.json] <dump>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    FILE *input = fopen(argv[optind], "r");
+    if (input == NULL) {
+        fprintf(stderr, "Cannot open the dump %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    output = stdout;
+    if (outputName != NULL && (output = fopen(outputName, "w")) == NULL) {
+        fprintf(stderr, "Cannot write %s\n", outputName);
+        return EXIT_FAILURE;
+    }
+    fprintf(output, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    // [2] Captures
+    Capture capture = {.pid = 0, .state = -1};
+    uint32_t captures = 0, events = 0, invalid = 0;
+    char line[TRACER_LINE_SIZE];
+    while (fgets(line, sizeof(line), input) != NULL) {
+        uint32_t rate;
+        TraceEvent event;
+        switch (TRACE_decodeLine(line, &rate, &event)) {
+        case TRACE_LINE_CLOCK:
+            // a new capture
+            closeCapture(&capture);
+            captures++;
+            capture = (Capture){.pid = captures, .rate = rate > 0 ? rate : 1, .state = -1};
+            printMetadata(&capture);
+            break;
+        case TRACE_LINE_EVENT:
+            if (capture.pid == 0) {
+                invalid++;
+                break;
+            }
+            if (capture.events == 0)
+                capture.first = capture.last = event.time;
+            else
+                capture.last = TRACE_unwrap(capture.last, event.time);
+            capture.events++;
+            convertEvent(&capture, &event, capture.last);
+            events++;
+            break;
+        case TRACE_LINE_INVALID:
+            invalid++;
+            break;
+        default:
+            break;
+        }
+    }
+    closeCapture(&capture);
+    fclose(input);
+
+    // [3] Summary
+    fprintf(output, "\n]}\n");
+    if (output != stdout)
+        fclose(output);
+    fprintf(stderr, "Converted %u events of %u captures, %u lines ignored\n", events, captures,
+            invalid);
+    return captures > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,423 @@
+/*C************************************************************************************************
+ * FILENAME:        tuner.c
+ *
+ * DESCRIPTION:
+ *      This source file contains a command line tool that searches the parameters of the obstacle
+ *      avoidance with the best trade-off between mean speed and collision rate, evaluating every
+ *      candidate on randomised simulated courses executed on all the cores of the host.
+ *
+ * PUBLIC FUNCTIONS:
+ *      int         main(int argc, char *argv[])
+ *
+ * NOTES:
+ *      Usage: tuner [-m grid|random|descent] [-n courses] [-t seconds] [-j workers] [-s seed]
+ *                   [-k samples] [-w weight] [-r rows] [-p parameters.h] <map>
+ *      Score = mean speed (cm/s) - weight * collisions per minute.
+ *      All the candidates are evaluated on the same courses (common random numbers), so the
+ *      differences between their scores are not hidden by the differences between the courses.
+ *      The best candidate is written as a header that can be loaded with make PARAMS=<file>.
+ *
+ * AUTHOR: Maintainers
+ *
+ * START DATE: 18 Oct 2026
+ *
+ * CHANGES:
+ * DATE         AUTHOR          DETAIL
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../tests/sim/sim_batch.h"
+
+#define TUNER_COURSES 40            /* Default number of courses per candidate                */
+#define TUNER_SECONDS 60            /* Default simulated time of a course                     */
+#define TUNER_OBSTACLES 6           /* Maximum number of random boxes                         */
+#define TUNER_SAMPLES 64            /* Default number of candidates of the random search      */
+#define TUNER_WEIGHT 2.0            /* Default cost of a collision per minute (cm/s)          */
+#define TUNER_ROWS 10               /* Default number of rows of the ranking                  */
+#define TUNER_MAX_ITERATIONS 20     /* Maximum number of moves of the coordinate descent      */
+#define TUNER_NOISE_MIN 0.2         /* Range of the sensor noise (cm)                         */
+#define TUNER_NOISE_MAX 2.0
+#define TUNER_BATTERY_MIN 0.3       /* Range of the initial battery charge                    */
+#define TUNER_BATTERY_MAX 1.0
+#define TUNER_GAIN_SPREAD 0.08      /* Maximum mismatch of the motor efficiency               */
+#define TUNER_DIMENSIONS 4
+#define TUNER_OUTPUT "build/tuned_parameters.h"
+
+typedef enum { MODE_GRID, MODE_RANDOM, MODE_DESCENT } Mode;
+
+/*T************************************************************************************************
+ * NAME: Dimension
+ *
+ * DESCRIPTION:
+ *      Represent a parameter explored by the search.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   const char*     name        Column name of the ranking
+ *              const char*     macro       Build time define of the parameter
+ *              uint32_t        min         Smallest value
+ *              uint32_t        max         Largest value
+ *              uint32_t        step        Distance between two values of the grid
+ */
+typedef struct {
+    const char *name;
+    const char *macro;
+    uint32_t min;
+    uint32_t max;
+    uint32_t step;
+} Dimension;
+
+/* The sensing period moves by 1/30 s, i.e. 3125 ticks of Timer32 */
+static const Dimension dimensions[TUNER_DIMENSIONS] = {
+    {"free_cm", "SENSING_FREE_THRESHOLD", 10, 50, 5},
+    {"fwd_%", "POWERTRAIN_FWD_SPEED", 20, 80, 10},
+    {"turn_%", "POWERTRAIN_TURN_SPEED", 30, 90, 10},
+    {"period_tk", "SENSING_TIMER_COUNT", 9375, 46875, 3125},
+};
+
+/*T************************************************************************************************
+ * NAME: Candidate
+ *
+ * DESCRIPTION:
+ *      Represent an evaluated parameter set.
+ *
+ * SPECIFICATIONS:
+ *      Type:   struct
+ *      Vars:   uint32_t        values[]    Value of every dimension
+ *              SimSummary      summary     KPIs over the courses
+ *              double          score       Objective, higher is better
+ */
+typedef struct {
+    uint32_t values[TUNER_DIMENSIONS];
+    SimSummary summary;
+    double score;
+} Candidate;
+
+static Parameters toParameters(const uint32_t values[TUNER_DIMENSIONS]) {
+    Parameters candidate;
+    candidate.freeThreshold = values[0];
+    candidate.forwardSpeed = values[1];
+    candidate.turnSpeed = values[2];
+    candidate.sensingTimerCount = values[3];
+    return candidate;
+}
+
+static uint32_t gridSize(uint8_t dimension) {
+    return (dimensions[dimension].max - dimensions[dimension].min) / dimensions[dimension].step + 1;
+}
+
+static int compareScores(const void *a, const void *b) {
+    double delta = ((const Candidate *)b)->score - ((const Candidate *)a)->score;
+    return (delta > 0) - (delta < 0);
+}
+
+/*F************************************************************************************************
+ * NAME: void evaluate(Candidate *candidates, uint32_t count, const SimScenario *courses,
+ *                     uint32_t runs, uint16_t workers, double weight)
+ *
+ * DESCRIPTION:
+ *      Runs every candidate on every course in a single parallel batch and computes the scores.
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          Candidate*          candidates  Candidates to evaluate, only the values are used
+ *          uint32_t            count       Number of candidates
+ *          const SimScenario*  courses     Courses shared by all the candidates
+ *          uint32_t            runs        Number of courses
+ *          uint16_t            workers     Maximum number of concurrent processes
+ *          double              weight      Cost of a collision per minute
+ *      GLOBALS:
+ *          None
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          Candidate*          candidates  Summary and score are set
+ *      GLOBALS:
+ *          None
+ *
+ *  NOTE:
+ *      A candidate with a crashed course gets a score of -INFINITY.
+ */
+static void evaluate(Candidate *candidates, uint32_t count, const SimScenario *courses,
+                     uint32_t runs, uint16_t workers, double weight) {
+    SimScenario *scenarios = malloc((size_t)count * runs * sizeof(SimScenario));
+    SimResult *results = malloc((size_t)count * runs * sizeof(SimResult));
+    if (scenarios == NULL || results == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (uint32_t c = 0; c < count; c++) {
+        for (uint32_t i = 0; i < runs; i++) {
+            scenarios[c * runs + i] = courses[i];
+            scenarios[c * runs + i].parameters = toParameters(candidates[c].values);
+        }
+    }
+    SIM_BATCH_run(scenarios, count * runs, workers, results);
+
+    for (uint32_t c = 0; c < count; c++) {
+        SimSummary *summary = &candidates[c].summary;
+        *summary = SIM_BATCH_summarise(&results[c * runs], runs);
+        double collisionRate = summary->collisions.mean / (courses[0].duration / 60e6);
+        candidates[c].score =
+            summary->failures > 0 ? -INFINITY : summary->speed.mean - weight * collisionRate;
+    }
+    free(scenarios);
+    free(results);
+}
+
+static void printRanking(const Candidate *ranking, uint32_t count, uint32_t rows, double minutes) {
+    printf("%4s", "rank");
+    for (uint8_t d = 0; d < TUNER_DIMENSIONS; d++)
+        printf(" %10s", dimensions[d].name);
+    printf(" %10s %10s %10s %10s\n", "score", "speed", "coll/min", "latency");
+    for (uint32_t r = 0; r < count && r < rows; r++) {
+        printf("%4u", r + 1);
+        for (uint8_t d = 0; d < TUNER_DIMENSIONS; d++)
+            printf(" %10u", ranking[r].values[d]);
+        printf(" %10.3f %10.3f %10.3f %10.1f\n", ranking[r].score, ranking[r].summary.speed.mean,
+               ranking[r].summary.collisions.mean / minutes, ranking[r].summary.latency.mean);
+    }
+}
+
+static bool writeParameters(const char *path, const Candidate *best, double weight) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+        return false;
+
+    Parameters tuned = toParameters(best->values);
+    fprintf(file, "/* Generated by tools/tuner, score %.3f with weight %.2f: */\n", best->score,
+            weight);
+    fprintf(file, "/* %.3f cm/s, %.3f collisions per course */\n", best->summary.speed.mean,
+            best->summary.collisions.mean);
+    fprintf(file, "#define %s %u\n", dimensions[0].macro, tuned.freeThreshold);
+    fprintf(file, "#define %s %u\n", dimensions[1].macro, tuned.forwardSpeed);
+    fprintf(file, "#define %s %u\n", dimensions[2].macro, tuned.turnSpeed);
+    fprintf(file, "#define %s %lu\n", dimensions[3].macro, (unsigned long)tuned.sensingTimerCount);
+    fclose(file);
+    return true;
+}
+
+/*F************************************************************************************************
+ * NAME: int main(int argc, char *argv[])
+ *
+ * DESCRIPTION:
+ *      [1] Parse the options and load the room
+ *      [2] Generate the courses shared by all the candidates
+ *      [3] Search the parameter space, the build time defaults are always evaluated as reference
+ *      [4] Print the ranking and write the best parameter set
+ *
+ * INPUTS:
+ *      PARAMETERS:
+ *          int         argc        Number of arguments
+ *          char*[]     argv        Options and map
+ *      GLOBALS:
+ *          parameters  Build time defaults, starting point of the descent
+ *
+ *  OUTPUTS:
+ *      PARAMETERS:
+ *          None
+ *      GLOBALS:
+ *          None
+ *      RETURN:
+ *          Type:   int
+ *          Value:  EXIT_SUCCESS, EXIT_FAILURE on invalid arguments or if the output is not written
+ *
+ *  NOTE:
+ *      The grid search evaluates every combination, choose the number of courses accordingly.
+ */
+int main(int argc, char *argv[]) {
+    // [1] Options and room
+    Mode mode = MODE_DESCENT;
+    uint32_t runs = TUNER_COURSES;
+    double seconds = TUNER_SECONDS;
+    uint16_t workers = SIM_BATCH_defaultWorkers();
+    uint64_t seed = 1;
+    uint32_t samples = TUNER_SAMPLES;
+    double weight = TUNER_WEIGHT;
+    uint32_t rows = TUNER_ROWS;
+    const char *output = TUNER_OUTPUT;
+    bool isValid = true;
+    int option;
+    while ((option = getopt(argc, argv, "m:n:t:j:s:k:w:r:p:")) != -1) {
+        switch (option) {
+        case 'm':
+            if (strcmp(optarg, "grid") == 0)
+                mode = MODE_GRID;
+            else if (strcmp(optarg, "random") == 0)
+                mode = MODE_RANDOM;
+            else if (strcmp(optarg, "descent") == 0)
+                mode = MODE_DESCENT;
+            else
+                isValid = false;
+            break;
+        case 'n':
+            runs = strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            seconds = atof(optarg);
+            break;
+        case 'j':
+            workers = strtoul(optarg, NULL, 10);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'k':
+            samples = strtoul(optarg, NULL, 10);
+            break;
+        case 'w':
+            weight = atof(optarg);
+            break;
+        case 'r':
+            rows = strtoul(optarg, NULL, 10);
+            break;
+        case 'p':
+            output = optarg;
+            break;
+        default:
+            isValid = false;
+        }
+    }
+    if (!isValid || optind != argc - 1 || runs == 0 || seconds <= 0) {
+        fprintf(stderr,
+                "Usage: %s [-m grid|random|descent] [-n courses] [-t seconds] [-j workers]\n"
+                "          [-s seed] [-k samples] [-w weight] [-r rows] [-p parameters.h] <map>\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static SimWorld room;
+    if (!SIM_WORLD_load(&room, argv[optind])) {
+        fprintf(stderr, "Cannot load the map %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    // [2] Common courses
+    SimScenario *courses = malloc(runs * sizeof(SimScenario));
+    if (courses == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    SimRandom random;
+    SIM_RANDOM_seed(&random, seed);
+    for (uint32_t i = 0; i < runs; i++) {
+        SimScenario *course = &courses[i];
+        course->world = &room;
+        course->obstacles = SIM_RANDOM_next(&random) % (TUNER_OBSTACLES + 1);
+        course->startHeading = SIM_RANDOM_uniform(&random, 0, 2 * M_PI);
+        course->params = SIM_CAR_defaultParams();
+        course->params.noiseSigma = SIM_RANDOM_uniform(&random, TUNER_NOISE_MIN, TUNER_NOISE_MAX);
+        course->params.batteryLevel =
+            SIM_RANDOM_uniform(&random, TUNER_BATTERY_MIN, TUNER_BATTERY_MAX);
+        course->params.leftGain = 1 - SIM_RANDOM_uniform(&random, 0, TUNER_GAIN_SPREAD);
+        course->params.rightGain = 1 - SIM_RANDOM_uniform(&random, 0, TUNER_GAIN_SPREAD);
+        course->parameters = parameters;
+        course->seed = SIM_RANDOM_next(&random);
+        course->duration = seconds * 1e6;
+        course->faults = NULL;
+    }
+
+    // [3] Search, the first candidate is always the current build
+    uint32_t capacity = 1;
+    if (mode == MODE_GRID) {
+        for (uint8_t d = 0; d < TUNER_DIMENSIONS; d++)
+            capacity *= gridSize(d);
+        capacity++;
+    } else if (mode == MODE_RANDOM) {
+        capacity += samples;
+    } else {
+        capacity += TUNER_MAX_ITERATIONS * 2 * TUNER_DIMENSIONS;
+    }
+    Candidate *candidates = calloc(capacity, sizeof(Candidate));
+    if (candidates == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    candidates[0].values[0] = parameters.freeThreshold;
+    candidates[0].values[1] = parameters.forwardSpeed;
+    candidates[0].values[2] = parameters.turnSpeed;
+    candidates[0].values[3] = parameters.sensingTimerCount;
+    uint32_t count = 1;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (mode == MODE_GRID || mode == MODE_RANDOM) {
+        for (; count < capacity; count++) {
+            uint32_t index = count - 1;
+            for (uint8_t d = 0; d < TUNER_DIMENSIONS; d++) {
+                uint32_t position = mode == MODE_GRID ? index % gridSize(d)
+                                                      : SIM_RANDOM_next(&random) % gridSize(d);
+                index /= gridSize(d);
+                candidates[count].values[d] = dimensions[d].min + position * dimensions[d].step;
+            }
+        }
+        evaluate(candidates, count, courses, runs, workers, weight);
+    } else {
+        // Coordinate descent: all the neighbours of the current point are evaluated in one batch
+        // and the best one becomes the new point until no neighbour improves the score
+        evaluate(candidates, 1, courses, runs, workers, weight);
+        uint32_t current = 0;
+        for (uint8_t iteration = 0; iteration < TUNER_MAX_ITERATIONS; iteration++) {
+            uint32_t first = count;
+            for (uint8_t d = 0; d < TUNER_DIMENSIONS; d++) {
+                for (int8_t direction = -1; direction <= 1; direction += 2) {
+                    int64_t value = candidates[current].values[d];
+                    value += direction * (int64_t)dimensions[d].step;
+                    if (value < dimensions[d].min || value > dimensions[d].max)
+                        continue;
+
+                    Candidate *neighbour = &candidates[count];
+                    memcpy(neighbour->values, candidates[current].values,
+                           sizeof(neighbour->values));
+                    neighbour->values[d] = value;
+                    bool isKnown = false;
+                    for (uint32_t c = 0; c < count && !isKnown; c++)
+                        isKnown = memcmp(candidates[c].values, neighbour->values,
+                                         sizeof(neighbour->values)) == 0;
+                    if (!isKnown)
+                        count++;
+                }
+            }
+            if (count == first)
+                break;
+
+            evaluate(&candidates[first], count - first, courses, runs, workers, weight);
+            uint32_t best = current;
+            for (uint32_t c = first; c < count; c++) {
+                if (candidates[c].score > candidates[best].score)
+                    best = c;
+            }
+            printf("iteration %2u: %u neighbours, best score %.3f\n", iteration + 1,
+                   count - first, candidates[best].score);
+            if (best == current)
+                break;
+            current = best;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double wall = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    // [4] Ranking and best parameter set
+    double reference = candidates[0].score;
+    qsort(candidates, count, sizeof(Candidate), compareScores);
+    printf("%u candidates x %u courses of %.0f s on %u workers in %.2f s\n", count, runs, seconds,
+           workers, wall);
+    printRanking(candidates, count, rows, seconds / 60);
+    printf("current build score %.3f\n", reference);
+
+    bool isWritten = writeParameters(output, &candidates[0], weight);
+    if (isWritten)
+        printf("best parameters written to %s\n", output);
+    else
+        fprintf(stderr, "Cannot write %s\n", output);
+
+    free(courses);
+    free(candidates);
+    return isWritten ? EXIT_SUCCESS : EXIT_FAILURE;
+}